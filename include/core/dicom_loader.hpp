@@ -37,8 +37,12 @@
  *
  * ## Thread Safety
  * - Directory scanning may be called from background threads
+ * - Header-only directory scanning fans files out over internal worker
+ *   threads; each worker uses its own GDCM reader
  * - DicomMetadata structs are safe to read from any thread after construction
  * - Individual file loading operations are not thread-safe
+ * - Series loading decodes slices on internal worker threads; the progress
+ *   callback is serialized but may be invoked from any worker
  *
  * @author kcenon
  * @since 1.0.0
@@ -47,8 +51,10 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <expected>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -60,6 +66,9 @@
 
 namespace dicom_viewer::core {
 
+/// Progress callback for long-running loading and building operations
+using ProgressCallback = std::function<void(size_t current, size_t total, const std::string& message)>;
+
 /// DICOM metadata extracted from files
 struct DicomMetadata {
     // Patient Module
@@ -93,6 +102,20 @@ struct DicomMetadata {
     // Rescale parameters for HU conversion
     double rescaleSlope = 1.0;
     double rescaleIntercept = 0.0;
+
+    // Acquisition attributes used for series classification, kept as the
+    // raw trimmed strings so classifiers can run without re-reading files
+    std::string imageType;                ///< (0008,0008)
+    std::string scanningSequence;         ///< (0018,0020)
+    std::string phaseContrast;            ///< (0018,9014)
+    std::string velocityEncoding;         ///< (0018,9197)
+    std::string numberOfFrames;           ///< (0028,0008)
+    std::string siemensFlowDirection;     ///< (0051,1014) private
+    std::string philipsVelocityEncoding;  ///< (2001,101A) private
+    std::string geVelocityEncoding;       ///< (0019,10CC) private
+
+    /// True when the acquisition attributes above were read from the header
+    bool hasAcquisitionAttributes = false;
 };
 
 /// Slice information for sorting
@@ -104,6 +127,40 @@ struct SliceInfo {
     std::array<double, 6> imageOrientation = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0};
 };
 
+/// Header attributes of a single DICOM file, read without decoding pixels
+struct DicomFileHeader {
+    /// Series grouping key (Series Instance UID plus series detail tags)
+    std::string seriesKey;
+    SliceInfo slice;
+    DicomMetadata metadata;
+};
+
+/// Options for directory scanning
+struct ScanOptions {
+    /// Worker threads used for header parsing (0 = hardware concurrency)
+    size_t threadCount = 0;
+
+    /// Stop parsing at Pixel Data instead of decoding every file.
+    /// When false, the legacy ITK series reader path is used.
+    bool headerOnly = true;
+};
+
+/**
+ * @brief Already-decoded slices a series load may copy instead of decoding
+ *
+ * Used by progressive (coarse-to-fine) building: each finer pass copies the
+ * slices the previous pass decoded and only decodes the new ones.
+ */
+template <typename TImage>
+struct DecodedSliceSource {
+    /// Earlier volume with the same in-plane size as the series being loaded
+    typename TImage::ConstPointer volume;
+
+    /// For each z of the series being loaded: z index into @c volume,
+    /// or -1 if the slice must be decoded
+    std::vector<std::ptrdiff_t> sourceIndex;
+};
+
 /// Error types for DICOM loading
 enum class DicomError {
     FileNotFound,
@@ -144,6 +201,19 @@ public:
     DicomLoader(DicomLoader&&) noexcept;
     DicomLoader& operator=(DicomLoader&&) noexcept;
 
+    /**
+     * @brief Set progress callback for series loading
+     *
+     * Invoked once per decoded slice with (slicesDone, sliceCount, message).
+     */
+    void setProgressCallback(ProgressCallback callback);
+
+    /**
+     * @brief Set worker thread count for series decoding
+     * @param threadCount Number of decode threads (0 = hardware concurrency)
+     */
+    void setDecodeThreadCount(size_t threadCount);
+
     /**
      * @brief Load a single DICOM file and extract metadata
      * @param filePath Path to the DICOM file
@@ -160,8 +230,42 @@ public:
     std::expected<std::map<std::string, std::vector<SliceInfo>>, DicomErrorInfo>
     scanDirectory(const std::filesystem::path& directoryPath);
 
+    /**
+     * @brief Scan directory for DICOM files with explicit scan options
+     *
+     * In header-only mode each file is parsed up to the Pixel Data element
+     * on a worker pool, so no pixel data is read or decompressed. The
+     * returned map has the same keys and slice ordering as the legacy path.
+     *
+     * @param directoryPath Path to directory containing DICOM files
+     * @param options Threading and parsing options
+     * @return Map of series key to sorted slice information
+     */
+    std::expected<std::map<std::string, std::vector<SliceInfo>>, DicomErrorInfo>
+    scanDirectory(const std::filesystem::path& directoryPath,
+                  const ScanOptions& options);
+
+    /**
+     * @brief Read header attributes of a DICOM file without decoding pixels
+     *
+     * Parses the data set up to (but not including) Pixel Data and fills
+     * slice geometry, patient/study/series metadata, and the series key
+     * used for grouping. Safe to call concurrently from multiple threads.
+     *
+     * @param filePath Path to the DICOM file
+     * @return Header attributes on success, error info for non-image files
+     */
+    [[nodiscard]] static std::expected<DicomFileHeader, DicomErrorInfo>
+    readHeader(const std::filesystem::path& filePath);
+
     /**
      * @brief Load a complete CT series as 3D volume
+     *
+     * The output buffer is allocated once from the first slice's header and
+     * every slice is decoded on a worker pool directly into its z-offset,
+     * with Rescale Slope/Intercept applied in the same pass. Series with
+     * multi-sample pixels fall back to itk::ImageSeriesReader.
+     *
      * @param slices Sorted slice information
      * @return ITK 3D image on success
      */
@@ -170,12 +274,25 @@ public:
 
     /**
      * @brief Load a complete MR series as 3D volume
+     *
+     * Uses the same parallel direct-to-buffer decode as loadCTSeries().
+     *
      * @param slices Sorted slice information
      * @return ITK 3D image on success
      */
     std::expected<MRImageType::Pointer, DicomErrorInfo>
     loadMRSeries(const std::vector<SliceInfo>& slices);
 
+    /**
+     * @brief Load a CT series, copying slices already decoded elsewhere
+     * @param slices Sorted slice information
+     * @param reuse Previously decoded slices to copy instead of decoding
+     * @return ITK 3D image on success
+     */
+    std::expected<CTImageType::Pointer, DicomErrorInfo>
+    loadCTSeries(const std::vector<SliceInfo>& slices,
+                 const DecodedSliceSource<CTImageType>& reuse);
+
     /**
      * @brief Check if a DICOM file is an Enhanced multi-frame IOD
      *
@@ -204,13 +321,24 @@ public:
      */
     static std::vector<std::string> getSupportedTransferSyntaxes();
 
+    /**
+     * @brief Sort slices by position along the slice normal
+     *
+     * Falls back to Instance Number and then file path when Image Position
+     * Patient does not vary across the series.
+     */
+    static void sortSlices(std::vector<SliceInfo>& slices);
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
     DicomMetadata metadata_;
 
-    /// Sort slices by spatial location
-    static void sortSlices(std::vector<SliceInfo>& slices);
+    /// Shared implementation of loadCTSeries() / loadMRSeries()
+    template <typename TImage>
+    std::expected<typename TImage::Pointer, DicomErrorInfo>
+    loadSeries(const std::vector<SliceInfo>& slices, const char* label,
+               const DecodedSliceSource<TImage>* reuse = nullptr);
 
     /// Calculate Z position from image position and orientation
     static double calculateSlicePosition(const SliceInfo& slice);
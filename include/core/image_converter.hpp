@@ -35,6 +35,14 @@
  *          mapping and coordinate system alignment between ITK LPS and
  *          VTK coordinate conventions.
  *
+ * ## Buffer Sharing
+ * By default conversions deep-copy the pixel buffer. With
+ * ConversionMode::SharedBuffer the output aliases the input's pixels and
+ * holds a reference that keeps the source buffer alive for as long as the
+ * output exists, so a volume is held in memory only once. Writes through
+ * either image are visible in the other; call Modified() on the VTK image
+ * after editing the ITK pixels so pipelines re-execute.
+ *
  * @author kcenon
  * @since 1.0.0
  */
@@ -64,45 +72,73 @@ public:
     using FloatImageType = itk::Image<float, 3>;
     using MaskImageType = itk::Image<unsigned char, 3>;
 
+    /// Relationship between a converted image and its source pixel buffer
+    enum class ConversionMode {
+        DeepCopy,     ///< Output owns an independent copy of the pixels
+        SharedBuffer  ///< Output aliases the source pixels (no copy)
+    };
+
     /**
      * @brief Convert ITK CT image to VTK image data
      * @param itkImage ITK image pointer
+     * @param mode Copy the pixels or share the ITK pixel container
      * @return VTK image data
      */
     static vtkSmartPointer<vtkImageData>
-    itkToVtk(CTImageType::Pointer itkImage);
+    itkToVtk(CTImageType::Pointer itkImage, ConversionMode mode = ConversionMode::DeepCopy);
 
     /**
      * @brief Convert ITK MR image to VTK image data
      * @param itkImage ITK image pointer
+     * @param mode Copy the pixels or share the ITK pixel container
      * @return VTK image data
      */
     static vtkSmartPointer<vtkImageData>
-    itkToVtk(MRImageType::Pointer itkImage);
+    itkToVtk(MRImageType::Pointer itkImage, ConversionMode mode = ConversionMode::DeepCopy);
 
     /**
      * @brief Convert ITK float image to VTK image data
      * @param itkImage ITK image pointer
+     * @param mode Copy the pixels or share the ITK pixel container
+     * @return VTK image data
+     */
+    static vtkSmartPointer<vtkImageData>
+    itkToVtk(FloatImageType::Pointer itkImage, ConversionMode mode = ConversionMode::DeepCopy);
+
+    /**
+     * @brief Convert ITK mask / label map image to VTK image data
+     * @param itkImage ITK image pointer
+     * @param mode Copy the pixels or share the ITK pixel container
      * @return VTK image data
      */
     static vtkSmartPointer<vtkImageData>
-    itkToVtk(FloatImageType::Pointer itkImage);
+    itkToVtk(MaskImageType::Pointer itkImage, ConversionMode mode = ConversionMode::DeepCopy);
 
     /**
      * @brief Convert VTK image data to ITK CT image
+     *
+     * SharedBuffer requires single-component scalars of the matching type
+     * in a contiguous array; other inputs fall back to a copy.
+     *
      * @param vtkImage VTK image data
+     * @param mode Copy the pixels or share the VTK scalar array
      * @return ITK image pointer
      */
     static CTImageType::Pointer
-    vtkToItkCT(vtkSmartPointer<vtkImageData> vtkImage);
+    vtkToItkCT(vtkSmartPointer<vtkImageData> vtkImage, ConversionMode mode = ConversionMode::DeepCopy);
 
     /**
      * @brief Convert VTK image data to ITK float image
+     *
+     * SharedBuffer requires single-component scalars of the matching type
+     * in a contiguous array; other inputs fall back to a copy.
+     *
      * @param vtkImage VTK image data
+     * @param mode Copy the pixels or share the VTK scalar array
      * @return ITK image pointer
      */
     static FloatImageType::Pointer
-    vtkToItkFloat(vtkSmartPointer<vtkImageData> vtkImage);
+    vtkToItkFloat(vtkSmartPointer<vtkImageData> vtkImage, ConversionMode mode = ConversionMode::DeepCopy);
 
     /**
      * @brief Apply Hounsfield Unit conversion to image
@@ -0,0 +1,137 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file parallel_for.hpp
+ * @brief Minimal fork-join helper for index-parallel loops
+ * @details Spawns a fixed number of std::thread workers that pull indices
+ *          from a shared atomic counter until the range is exhausted.
+ *          Intended for coarse-grained work items (one DICOM file, one
+ *          slice, one phase) where per-item cost dominates scheduling cost.
+ *
+ * ## Thread Safety
+ * - The callable is invoked concurrently from multiple threads and must
+ *   only write to state owned by its index (or synchronize otherwise)
+ * - The first exception thrown by any worker is rethrown on the caller
+ *   after all workers have joined
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dicom_viewer::core {
+
+/**
+ * @brief Resolve a requested worker count against hardware and work size
+ * @param requested Requested thread count (0 = hardware concurrency)
+ * @param workItems Number of items to process
+ * @return Thread count in [1, max(workItems, 1)]
+ */
+inline size_t resolveThreadCount(size_t requested, size_t workItems)
+{
+    size_t threads = requested;
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    return std::clamp<size_t>(threads, 1, std::max<size_t>(1, workItems));
+}
+
+/**
+ * @brief Invoke func(i) for every i in [0, count) across worker threads
+ *
+ * With a resolved thread count of 1 the loop runs inline on the calling
+ * thread, so single-threaded callers pay no thread creation cost.
+ *
+ * @param count Number of indices to process
+ * @param threadCount Requested worker count (0 = hardware concurrency)
+ * @param func Callable with signature void(size_t)
+ */
+template <typename Func>
+void parallelFor(size_t count, size_t threadCount, Func&& func)
+{
+    if (count == 0) {
+        return;
+    }
+
+    const size_t workers = resolveThreadCount(threadCount, count);
+    if (workers == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed);
+             i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                func(i);
+            } catch (...) {
+                std::lock_guard lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+                // Drain remaining indices so other workers stop early
+                next.store(count, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t t = 1; t < workers; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+} // namespace dicom_viewer::core
@@ -37,7 +37,8 @@
  *
  * ## Thread Safety
  * - Volume building returns std::future and may execute on a background thread
- * - Progress callbacks are invoked from the building thread
+ * - Progress callbacks are serialized but may be invoked from slice decode
+ *   worker threads during volume building
  * - The returned SeriesInfo is safe to access after the future resolves
  *
  * @author kcenon
@@ -60,8 +61,23 @@
 
 namespace dicom_viewer::core {
 
-/// Progress callback for series building operations
-using ProgressCallback = std::function<void(size_t current, size_t total, const std::string& message)>;
+/**
+ * @brief Receives each refinement of a progressively built volume
+ * @param volume Volume for this pass; never modified after being published
+ * @param pass Zero-based refinement pass
+ * @param passCount Total number of passes (the last pass is full resolution)
+ */
+using VolumeRefinementCallback = std::function<void(
+    const CTImageType::Pointer& volume, size_t pass, size_t passCount)>;
+
+/// Options for progressive (coarse-to-fine) volume building
+struct ProgressiveBuildOptions {
+    /// Slice stride of the first pass (every Nth slice); halved each pass
+    size_t initialStride = 8;
+
+    /// Minimum slices a coarse pass must contain to be published
+    size_t minimumSlicesPerPass = 2;
+};
 
 /// Series information with metadata summary
 struct SeriesInfo {
@@ -78,6 +94,9 @@ struct SeriesInfo {
 
     // Volume dimensions
     std::array<size_t, 3> dimensions = {0, 0, 0};
+
+    /// Header metadata of the first slice, captured during scanning
+    DicomMetadata metadata;
 };
 
 /**
@@ -104,8 +123,33 @@ public:
      */
     void setProgressCallback(ProgressCallback callback);
 
+    /**
+     * @brief Enable the persistent on-disk scan index
+     *
+     * When enabled, scanForSeries() keeps a SeriesIndex file in each scanned
+     * directory and only parses files that are new or changed since the
+     * previous scan. Disabled by default so scanning never writes into
+     * the source directory unless asked to.
+     */
+    void setScanIndexEnabled(bool enabled);
+
+    /**
+     * @brief Enable the memory-mapped decoded-volume cache
+     *
+     * When set, buildCTVolume() and buildMRVolume() map a previously
+     * stored volume for an unchanged series instead of decoding it, and
+     * store every freshly decoded volume in @p directory (see VolumeCache).
+     *
+     * @param directory Cache directory; an empty path disables the cache
+     */
+    void setVolumeCacheDirectory(const std::filesystem::path& directory);
+
     /**
      * @brief Scan directory and return available series
+     *
+     * Headers are parsed without decoding pixel data; series metadata is
+     * taken from the parsed headers instead of re-reading the first slice.
+     *
      * @param directoryPath Path to directory containing DICOM files
      * @return Vector of series information on success
      */
@@ -136,6 +180,26 @@ public:
     std::future<std::expected<CTImageType::Pointer, DicomErrorInfo>>
     buildCTVolumeAsync(const SeriesInfo& series);
 
+    /**
+     * @brief Build a CT volume coarse-to-fine on a background thread
+     *
+     * The first pass decodes every Nth slice and publishes a volume with
+     * N-times coarser z spacing; each following pass halves the stride,
+     * copies the slices already decoded and decodes only the new ones.
+     * Every pass produces a new image so consumers (e.g. RenderSession::
+     * setInputData via ImageConverter, MPRRenderer) can keep using an
+     * earlier pass while the next one is decoded.
+     *
+     * @param series Series information with sorted slices
+     * @param onRefinement Invoked on the build thread after every pass
+     * @param options Stride and pass configuration
+     * @return Future containing the full-resolution result
+     */
+    std::future<std::expected<CTImageType::Pointer, DicomErrorInfo>>
+    buildCTVolumeProgressive(const SeriesInfo& series,
+                             VolumeRefinementCallback onRefinement,
+                             ProgressiveBuildOptions options = {});
+
     /**
      * @brief Get metadata for the last processed series
      */
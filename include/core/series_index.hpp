@@ -0,0 +1,155 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file series_index.hpp
+ * @brief Persistent per-directory index of parsed DICOM headers
+ * @details Caches the header attributes of every file in a directory
+ *          (slice geometry and DicomMetadata) in a compact binary file
+ *          stored next to the data. Entries are keyed by file name and
+ *          validated against file size and modification time, so a rescan
+ *          only parses files that are new or have changed.
+ *
+ * ## Index File Format (version 1)
+ * - Magic "DVSI", uint32 format version, uint64 entry count
+ * - Per entry: file name, size, mtime, image flag, then (for images) the
+ *   series key, SliceInfo fields and DicomMetadata fields
+ * - Strings are uint32 length-prefixed; numbers are written in host byte
+ *   order since the index is a local cache, not an interchange format
+ *
+ * ## Thread Safety
+ * - A SeriesIndex instance is not thread-safe; refresh() parses changed
+ *   files on internal worker threads
+ * - Two processes indexing the same directory may race on save(); the
+ *   file is replaced atomically so readers never see a partial index
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+
+#pragma once
+
+#include "dicom_loader.hpp"
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dicom_viewer::core {
+
+/// Cached header state of one file in an indexed directory
+struct SeriesIndexEntry {
+    std::uintmax_t fileSize = 0;
+    std::int64_t modifiedTime = 0;  ///< file_time_type ticks since epoch
+
+    /// False for files that failed header parsing (cached negative result)
+    bool isImage = false;
+    DicomFileHeader header;
+};
+
+/// Outcome of a SeriesIndex::refresh() call
+struct SeriesIndexStats {
+    size_t reused = 0;   ///< Entries whose size and mtime were unchanged
+    size_t parsed = 0;   ///< New or modified files whose headers were read
+    size_t removed = 0;  ///< Entries for files no longer in the directory
+
+    [[nodiscard]] bool changed() const { return parsed > 0 || removed > 0; }
+};
+
+/**
+ * @brief Incremental header index for a single DICOM directory
+ *
+ * Typical use:
+ * @code
+ * SeriesIndex index(directory);
+ * index.load();           // ignore failure: start from an empty index
+ * auto stats = index.refresh();
+ * if (stats.changed()) {
+ *     index.save();
+ * }
+ * @endcode
+ *
+ * @trace SRS-FR-002
+ */
+class SeriesIndex {
+public:
+    /// Name of the index file written inside the indexed directory
+    static constexpr const char* kIndexFileName = ".dicom_viewer_index";
+
+    /// Current on-disk format version; older files are discarded on load
+    static constexpr std::uint32_t kFormatVersion = 2;
+
+    explicit SeriesIndex(std::filesystem::path rootDirectory);
+
+    /**
+     * @brief Load the index file of the root directory
+     * @return true if a valid index was read; false if missing, corrupt
+     *         or written by an incompatible version (index is left empty)
+     */
+    bool load();
+
+    /**
+     * @brief Write the index file (temporary file + atomic rename)
+     * @return void on success, error info if the directory is not writable
+     */
+    std::expected<void, DicomErrorInfo> save() const;
+
+    /**
+     * @brief Synchronize the index with the directory contents
+     *
+     * Lists regular files (non-recursive), reuses entries whose size and
+     * modification time match, and reads headers of the remaining files
+     * in parallel with DicomLoader::readHeader().
+     *
+     * @param threadCount Worker threads for header parsing (0 = hardware)
+     * @return Counts of reused, parsed and removed entries
+     */
+    SeriesIndexStats refresh(size_t threadCount = 0);
+
+    /// Indexed entries keyed by file name relative to the root directory
+    [[nodiscard]] const std::map<std::string, SeriesIndexEntry>& entries() const {
+        return entries_;
+    }
+
+    /// Headers of all image entries grouped by series key (file name order)
+    [[nodiscard]] std::map<std::string, std::vector<const DicomFileHeader*>>
+    groupBySeries() const;
+
+    [[nodiscard]] const std::filesystem::path& rootDirectory() const { return root_; }
+    [[nodiscard]] std::filesystem::path indexPath() const;
+
+private:
+    std::filesystem::path root_;
+    std::map<std::string, SeriesIndexEntry> entries_;
+};
+
+} // namespace dicom_viewer::core
@@ -0,0 +1,140 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file volume_cache.hpp
+ * @brief Memory-mappable cache of decoded DICOM volumes
+ * @details Stores a decoded volume as a fixed-size header followed by the
+ *          raw voxel buffer, page-aligned so that a later open can map the
+ *          file and hand the mapping to ITK without decoding or copying.
+ *          Cache files are keyed by a fingerprint of the series' slice
+ *          files (path, size and modification time), so any change to the
+ *          source data selects a different cache file.
+ *
+ * ## Cache File Format (version 1)
+ * - 4096-byte header: magic "DVVC", format version, pixel type, image
+ *   size, spacing, origin, direction, rescale slope/intercept applied at
+ *   decode time, series fingerprint, data offset and data size
+ * - Raw voxel data in ITK buffer order (x fastest) starting at the data
+ *   offset; numbers use host byte order since the cache is machine-local
+ *
+ * ## Thread Safety
+ * - VolumeCache holds no mutable state; concurrent store() and open()
+ *   calls are safe, and store() replaces files atomically
+ * - Opened images are backed by a private (copy-on-write) mapping;
+ *   modifying their pixels never writes back to the cache file
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+
+#pragma once
+
+#include "dicom_loader.hpp"
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace dicom_viewer::core {
+
+/**
+ * @brief Directory of memory-mapped decoded-volume cache files
+ *
+ * Typical use:
+ * @code
+ * VolumeCache cache(cacheDirectory);
+ * auto key = VolumeCache::fingerprint(series.slices);
+ * if (auto cached = cache.openCT(*key)) {
+ *     return *cached;                   // mapped, no decode
+ * }
+ * auto volume = loader.loadCTSeries(series.slices);
+ * cache.store(*key, *volume.value(), loader.getMetadata());
+ * @endcode
+ *
+ * @trace SRS-FR-002
+ */
+class VolumeCache {
+public:
+    /// Extension of cache files inside the cache directory
+    static constexpr const char* kFileExtension = ".dvvol";
+
+    /// Current on-disk format version; other versions are treated as misses
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    /// Byte offset of the voxel data (one page, keeps the mapping aligned)
+    static constexpr std::uint64_t kDataOffset = 4096;
+
+    explicit VolumeCache(std::filesystem::path cacheDirectory);
+
+    /**
+     * @brief Compute the cache key of a series from its slice files
+     * @param slices Sorted slices of the series
+     * @return Fingerprint, or std::nullopt if a slice file cannot be stat'ed
+     */
+    [[nodiscard]] static std::optional<std::uint64_t>
+    fingerprint(const std::vector<SliceInfo>& slices);
+
+    /**
+     * @brief Write a decoded volume to the cache (temporary file + rename)
+     * @param key Series fingerprint
+     * @param image Decoded volume
+     * @param metadata Series metadata; its rescale values are recorded
+     * @return void on success, error info if the cache cannot be written
+     */
+    std::expected<void, DicomErrorInfo>
+    store(std::uint64_t key, const CTImageType& image, const DicomMetadata& metadata) const;
+
+    /// @copydoc store(std::uint64_t, const CTImageType&, const DicomMetadata&) const
+    std::expected<void, DicomErrorInfo>
+    store(std::uint64_t key, const MRImageType& image, const DicomMetadata& metadata) const;
+
+    /**
+     * @brief Map a cached CT volume
+     * @return Image backed by the file mapping, or std::nullopt if the
+     *         entry is missing, truncated or of a different version/type
+     */
+    [[nodiscard]] std::optional<CTImageType::Pointer> openCT(std::uint64_t key) const;
+
+    /// Map a cached MR volume (see openCT())
+    [[nodiscard]] std::optional<MRImageType::Pointer> openMR(std::uint64_t key) const;
+
+    /// Path of the cache file for @p key and pixel type tag ("i16"/"u16")
+    [[nodiscard]] std::filesystem::path cachePath(std::uint64_t key,
+                                                  const char* pixelTag) const;
+
+    [[nodiscard]] const std::filesystem::path& cacheDirectory() const { return directory_; }
+
+private:
+    std::filesystem::path directory_;
+};
+
+} // namespace dicom_viewer::core
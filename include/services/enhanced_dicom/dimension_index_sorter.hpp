@@ -87,7 +87,8 @@ public:
      *
      * Reads the top-level DimensionIndexSequence to determine the
      * multi-dimensional organization of frames. Each item defines
-     * one dimension axis.
+     * one dimension axis. The sequence is located by a header-only
+     * streaming scan that stops before the functional group sequences.
      *
      * @param filePath Path to the Enhanced DICOM file
      * @return DimensionOrganization on success, error if parsing fails
@@ -100,7 +101,9 @@ public:
      *
      * Uses lexicographic comparison on the dimension indices in the order
      * specified by DimensionOrganization. Frames are sorted in ascending
-     * order along each dimension (outermost first).
+     * order along each dimension (outermost first). Sort keys are
+     * extracted into a flat array once, so the comparator never touches
+     * the per-frame index maps.
      *
      * @param frames Frames to sort (modified in place)
      * @param dimOrg Dimension organization from parseDimensionIndex()
@@ -123,9 +123,11 @@ public:
     /**
      * @brief Parse an Enhanced DICOM file and extract all metadata
      *
-     * Reads the entire Enhanced DICOM file, parses shared and per-frame
-     * functional groups, DimensionIndexSequence, and returns complete
-     * series metadata with frames sorted by dimension indices.
+     * Reads the top-level attributes, then collects shared and per-frame
+     * functional groups and the DimensionIndexSequence in a single
+     * streaming pass (FunctionalGroupParser::scanFrameTable()), and returns
+     * complete series metadata with frames sorted by dimension indices.
+     * Pixel Data is not read.
      *
      * @param filePath Path to the Enhanced DICOM file
      * @return EnhancedSeriesInfo on success, error on failure
@@ -35,6 +35,30 @@
  *          data extraction. Uses Basic Offset Table or Extended Offset
  *          Table to locate frame boundaries within pixel data element.
  *
+ * ## Frame-Level Random Access
+ * extractFrame() reads and decodes only the requested frame. The first
+ * request for a file parses its header and records where each frame lives:
+ * - Native data: the byte offset of the pixel data value; frame N is a
+ *   direct seek to offset + N * frameBytes
+ * - Encapsulated data: the fragment list, grouped into frames through the
+ *   Extended Offset Table, the Basic Offset Table, or one fragment per
+ *   frame when neither table is present
+ *
+ * The index is cached per file (invalidated when its size or modification
+ * time changes), so scrubbing an enhanced cine series costs one frame read
+ * per request. Files whose layout cannot be indexed (deflated or big-endian
+ * transfer syntaxes, bit-packed pixels, multi-fragment frames without an
+ * offset table) fall back to decoding the whole pixel data element.
+ *
+ * ## Multi-Volume Assembly
+ * assembleVolumesFromFrameGroups() builds every phase of a multi-phase
+ * file from one pass over the pixel data; assembleVolume() and
+ * assembleVolumeFromFrames() are its single-group cases.
+ *
+ * ## Thread Safety
+ * - extractFrame() and the assembly methods may be called concurrently;
+ *   the index cache is guarded by an internal mutex
+ *
  * @author kcenon
  * @since 1.0.0
  */
@@ -75,6 +99,9 @@ public:
     /**
      * @brief Extract a single frame's raw pixel data
      *
+     * Only the requested frame is read from disk and decoded (see
+     * "Frame-Level Random Access" above).
+     *
      * @param filePath Path to the Enhanced DICOM file
      * @param frameIndex 0-based frame index
      * @param info Series metadata for pixel format information
@@ -117,6 +144,25 @@ public:
                              const EnhancedSeriesInfo& info,
                              const std::vector<int>& frameIndices);
 
+    /**
+     * @brief Assemble several frame subsets (e.g., all cardiac phases) at once
+     *
+     * Each frame referenced by any group is read and decoded exactly once,
+     * in parallel, into a single 4D buffer holding every group's slices
+     * back to back. The returned volumes are zero-copy views of their slice
+     * range of that buffer, which is released with the last volume.
+     *
+     * @param filePath Path to the Enhanced DICOM file
+     * @param info Series metadata
+     * @param frameGroups Frame indices per volume (each sorted spatially)
+     * @return One 3D ITK image per group, in group order
+     */
+    [[nodiscard]] std::expected<std::vector<itk::Image<short, 3>::Pointer>,
+                                EnhancedDicomError>
+    assembleVolumesFromFrameGroups(const std::string& filePath,
+                                   const EnhancedSeriesInfo& info,
+                                   const std::vector<std::vector<int>>& frameGroups);
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
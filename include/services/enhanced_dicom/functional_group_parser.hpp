@@ -36,12 +36,28 @@
  *          values override shared values for metadata that varies by
  *          frame (pixel spacing, position, orientation).
  *
+ * ## Streaming Header Scan
+ * Vendor 4D flow and diffusion objects carry 10,000+ per-frame items.
+ * Instead of materializing the whole dataset as a GDCM DOM, the parser
+ * walks the encoded elements once, keeps only the attributes
+ * EnhancedFrameInfo needs in a FrameMetadataTable, and stops before
+ * Pixel Data. Files the walker cannot handle (deflated or big-endian
+ * transfer syntax, missing DICM preamble) fall back to the GDCM reader.
+ *
+ * ## Thread Safety
+ * - Stateless apart from the pimpl; separate instances may parse
+ *   concurrently, a single instance must not be shared across threads
+ *
  * @author kcenon
  * @since 1.0.0
  */
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <expected>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -49,6 +65,68 @@
 
 namespace dicom_viewer::services {
 
+/**
+ * @brief Flat per-frame metadata produced by the streaming header scan
+ *
+ * Holds the PerFrameFunctionalGroupsSequence attributes as
+ * struct-of-arrays columns indexed by frame number, so a 20k-frame header
+ * costs a handful of contiguous allocations rather than one DOM node per
+ * attribute. The SharedFunctionalGroupsSequence values and the
+ * DimensionIndexSequence found in the same pass are kept alongside.
+ *
+ * @trace SRS-FR-049
+ */
+struct FrameMetadataTable {
+    /// Presence bits for optional per-frame columns
+    enum Field : uint8_t {
+        HasTriggerTime = 1 << 0,
+        HasTemporalPosition = 1 << 1,
+        HasInStackPosition = 1 << 2
+    };
+
+    /// Values from the first SharedFunctionalGroupsSequence item
+    struct SharedGroups {
+        bool present = false;
+        std::optional<std::array<double, 2>> pixelSpacing;
+        std::optional<double> sliceThickness;
+        bool hasPixelValueTransformation = false;
+        double rescaleSlope = 1.0;
+        double rescaleIntercept = 0.0;
+        std::optional<std::array<double, 6>> imageOrientation;
+    };
+
+    int numberOfFrames = 0;      ///< Rows in every per-frame column
+    int perFrameItemCount = 0;   ///< Items parsed from (5200,9230)
+
+    std::vector<double> imagePositions;     ///< 3 values per frame
+    std::vector<double> imageOrientations;  ///< 6 values per frame
+    std::vector<double> rescaleSlopes;
+    std::vector<double> rescaleIntercepts;
+    std::vector<double> triggerTimes;
+    std::vector<int> temporalPositionIndices;
+    std::vector<int> inStackPositions;
+    std::vector<uint8_t> fields;            ///< Field bits per frame
+
+    /// DimensionIndexValues (0020,9157) of frame i are
+    /// dimensionIndexValues[dimensionValueOffsets[i] .. dimensionValueOffsets[i + 1])
+    std::vector<uint32_t> dimensionValueOffsets;
+    std::vector<uint32_t> dimensionIndexValues;
+
+    SharedGroups shared;
+    DimensionOrganization dimensions;
+
+    /// Expand the table into per-frame structs (shared values not applied)
+    [[nodiscard]] std::vector<EnhancedFrameInfo> toFrameInfos() const;
+
+    /**
+     * @brief Apply shared group values to a series
+     *
+     * Same semantics as FunctionalGroupParser::parseSharedGroups(): shared
+     * values overwrite the corresponding fields of every frame in info.
+     */
+    void applySharedGroups(EnhancedSeriesInfo& info) const;
+};
+
 /**
  * @brief Parser for DICOM Functional Group Sequences
  *
@@ -102,6 +180,23 @@ public:
         int numberOfFrames,
         const EnhancedSeriesInfo& sharedInfo);
 
+    /**
+     * @brief Stream the functional group headers into a flat table
+     *
+     * Walks the encoded dataset once without building a DOM, collecting
+     * DimensionIndexSequence, SharedFunctionalGroupsSequence and the first
+     * numberOfFrames items of PerFrameFunctionalGroupsSequence. Pixel Data
+     * is never read. With numberOfFrames == 0 the scan stops before the
+     * per-frame sequence.
+     *
+     * @param filePath Path to the Enhanced DICOM file
+     * @param numberOfFrames Number of per-frame rows to collect
+     * @return Metadata table, or ParseFailed if the file cannot be read or
+     *         its encoding is not supported by the streaming walker
+     */
+    [[nodiscard]] std::expected<FrameMetadataTable, EnhancedDicomError>
+    scanFrameTable(const std::string& filePath, int numberOfFrames);
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
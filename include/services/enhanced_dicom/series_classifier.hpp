@@ -36,17 +36,29 @@
  *          VENC), and CT. Returns SeriesType enum and ClassifiedSeries
  *          metadata.
  *
+ * ## Header-Only Classification
+ * Files are parsed only up to Pixel Data, and series produced by
+ * SeriesBuilder::scanForSeries() are classified from the acquisition
+ * attributes already captured in their scan metadata without any I/O.
+ * Study-level calls classify series concurrently.
+ *
+ * ## Thread Safety
+ * - All methods are static and reentrant
+ * - classifyStudy() and classifyScannedSeries() use internal worker threads
+ *
  * @author kcenon
  * @since 1.0.0
  */
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
 #include <itkMetaDataDictionary.h>
 
 namespace dicom_viewer::core {
+struct DicomMetadata;
 struct SeriesInfo;
 }  // namespace dicom_viewer::core
 
@@ -125,7 +137,7 @@ public:
     /**
      * @brief Classify a single DICOM series from a file path
      *
-     * Reads the first file's metadata and classifies the series.
+     * Reads the file's header (up to Pixel Data) and classifies the series.
      *
      * @param filePath Path to one DICOM file from the series
      * @return Classification result
@@ -145,30 +157,48 @@ public:
     [[nodiscard]] static ClassifiedSeries classify(
         const itk::MetaDataDictionary& metadata);
 
+    /**
+     * @brief Classify from header attributes captured during scanning
+     *
+     * Applies the same rules as classify() to the acquisition attributes
+     * stored in DicomMetadata by DicomLoader::readHeader().
+     *
+     * @param metadata Header metadata of one file from the series
+     * @return Classification result
+     */
+    [[nodiscard]] static ClassifiedSeries classifyMetadata(
+        const core::DicomMetadata& metadata);
+
     /**
      * @brief Classify all series in a study
      *
      * Takes a list of representative file paths (one per series)
-     * and returns the classification for each.
+     * and returns the classification for each. Headers are read
+     * concurrently, one file per worker.
      *
      * @param seriesFiles One DICOM file path per series
+     * @param threadCount Worker threads (0 = hardware concurrency)
      * @return Vector of classification results (same order)
      */
     [[nodiscard]] static std::vector<ClassifiedSeries> classifyStudy(
-        const std::vector<std::string>& seriesFiles);
+        const std::vector<std::string>& seriesFiles, size_t threadCount = 0);
 
     /**
      * @brief Classify series from scan results
      *
      * Bridge between SeriesBuilder::scanForSeries() and classification.
-     * Reads the first DICOM file from each series to classify its type.
-     * Series with no slices are classified as Unknown.
+     * Series whose metadata carries the acquisition attributes read during
+     * scanning are classified without touching disk; otherwise the header
+     * of the first slice is read. Series with neither are classified as
+     * Unknown.
      *
      * @param scannedSeries Results from SeriesBuilder::scanForSeries()
+     * @param threadCount Worker threads (0 = hardware concurrency)
      * @return Classification for each series (same order and size)
      */
     [[nodiscard]] static std::vector<ClassifiedSeries> classifyScannedSeries(
-        const std::vector<core::SeriesInfo>& scannedSeries);
+        const std::vector<core::SeriesInfo>& scannedSeries,
+        size_t threadCount = 0);
 
     /**
      * @brief Check if a SeriesType is a 4D Flow component
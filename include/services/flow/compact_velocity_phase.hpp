@@ -0,0 +1,178 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file compact_velocity_phase.hpp
+ * @brief Quantized in-memory representation of a cached velocity phase
+ * @details Stores the velocity field and magnitude image of a VelocityPhase
+ *          either as int16 quantized against a per-phase scale (derived
+ *          from VENC and the phase's peak speed) or as IEEE float16. Both
+ *          halve the float32 footprint so PhaseCache can hold a whole
+ *          cardiac cycle. Kernels may sample the compact buffers directly
+ *          through velocityAt() / magnitudeAt(), or expand the phase back
+ *          to ITK images with decompressPhase().
+ *
+ * ## Thread Safety
+ * - CompactVelocityPhase is immutable after compressPhase() returns and
+ *   may be read concurrently
+ * - All free functions are reentrant
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "services/flow/velocity_field_assembler.hpp"
+
+namespace dicom_viewer::services {
+
+/**
+ * @brief Storage format of cached velocity phases
+ *
+ * @trace SRS-FR-048
+ */
+enum class PhaseStorageFormat {
+    Float32,         ///< Full precision ITK images (no compression)
+    QuantizedInt16,  ///< int16 with a per-phase scale; error <= scale / 2
+    Float16          ///< IEEE half precision; ~0.05% relative error
+};
+
+/**
+ * @brief Geometry of a stored image (enough to rebuild the ITK image)
+ */
+struct CompactImageGeometry {
+    std::array<size_t, 3> size = {0, 0, 0};
+    std::array<double, 3> spacing = {1.0, 1.0, 1.0};
+    std::array<double, 3> origin = {0.0, 0.0, 0.0};
+    std::array<double, 9> direction = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+
+    [[nodiscard]] size_t voxelCount() const noexcept {
+        return size[0] * size[1] * size[2];
+    }
+};
+
+/**
+ * @brief Velocity phase held in 16-bit storage
+ *
+ * Velocity values are interleaved (Vx, Vy, Vz) per voxel exactly like
+ * VectorImage3D. For QuantizedInt16 a stored value q decodes to
+ * q * scale; for Float16 the 16-bit pattern is an IEEE half multiplied by
+ * scale, a power of two that is 1 unless the peak exceeds the half range.
+ *
+ * @trace SRS-FR-048
+ */
+struct CompactVelocityPhase {
+    PhaseStorageFormat format = PhaseStorageFormat::QuantizedInt16;
+    int phaseIndex = 0;
+    double triggerTime = 0.0;
+
+    bool hasVelocity = false;
+    CompactImageGeometry velocityGeometry;
+    std::vector<uint16_t> velocity;  ///< 3 values per voxel
+    float velocityScale = 0.0f;      ///< cm/s per quantization step (int16) or half multiplier
+    float velocityPeak = 0.0f;       ///< Largest |component| when encoded
+
+    bool hasMagnitude = false;
+    CompactImageGeometry magnitudeGeometry;
+    std::vector<uint16_t> magnitude;
+    float magnitudeScale = 0.0f;
+
+    /// Bytes held by the compact buffers
+    [[nodiscard]] size_t memoryBytes() const noexcept {
+        return sizeof(*this) + (velocity.size() + magnitude.size()) * sizeof(uint16_t);
+    }
+
+    /// Decode the velocity vector of one voxel (linear index)
+    [[nodiscard]] std::array<float, 3> velocityAt(size_t voxel) const noexcept;
+
+    /// Decode the magnitude of one voxel (linear index)
+    [[nodiscard]] float magnitudeAt(size_t voxel) const noexcept;
+
+    /// Largest absolute decode error of any velocity component (cm/s)
+    [[nodiscard]] double velocityErrorBound() const noexcept;
+
+private:
+    [[nodiscard]] float decode(uint16_t stored, float scale) const noexcept;
+};
+
+/**
+ * @brief Round-trip error of a compact encoding, for tuning the tradeoff
+ */
+struct QuantizationError {
+    double maxAbsError = 0.0;  ///< Largest |decoded - original| (cm/s)
+    double rmsError = 0.0;     ///< Root-mean-square error (cm/s)
+    double compressionRatio = 1.0;  ///< float32 bytes / compact bytes
+};
+
+/// Convert a float to IEEE half precision (round to nearest even)
+[[nodiscard]] uint16_t floatToHalf(float value) noexcept;
+
+/// Convert an IEEE half precision bit pattern to float
+[[nodiscard]] float halfToFloat(uint16_t bits) noexcept;
+
+/**
+ * @brief Encode a phase into 16-bit storage
+ *
+ * For QuantizedInt16 the velocity scale is max(venc, peak |v|) / 32767, so
+ * the full VENC range is representable and unwrapped values beyond VENC
+ * are not clipped.
+ *
+ * @param phase Phase with float32 images (null images are skipped)
+ * @param format QuantizedInt16 or Float16; Float32 is not a compact format
+ *        and is encoded as Float16
+ * @param venc Largest VENC of the series in cm/s (0 = use the peak only)
+ */
+[[nodiscard]] CompactVelocityPhase compressPhase(
+    const VelocityPhase& phase, PhaseStorageFormat format, double venc = 0.0);
+
+/**
+ * @brief Expand a compact phase back into float32 ITK images
+ */
+[[nodiscard]] VelocityPhase decompressPhase(const CompactVelocityPhase& compact);
+
+/**
+ * @brief Measure the velocity error introduced by a storage format
+ * @param phase Reference phase with a float32 velocity field
+ * @param format Format to evaluate
+ * @param venc Series VENC in cm/s passed to compressPhase()
+ */
+[[nodiscard]] QuantizationError measureQuantizationError(
+    const VelocityPhase& phase, PhaseStorageFormat format, double venc = 0.0);
+
+/**
+ * @brief Bytes held by the float32 images of a phase
+ */
+[[nodiscard]] size_t phaseMemoryBytes(const VelocityPhase& phase) noexcept;
+
+}  // namespace dicom_viewer::services
@@ -34,7 +34,12 @@
  * @details Provides flow measurement results and time-velocity curves for
  *          flow quantification analysis. Defines MeasurementPlane for
  *          specifying sampling geometry with center, normal, radius,
- *          and spacing parameters.
+ *          and spacing parameters. Several planes can be quantified in a
+ *          single parallel sweep over the phases.
+ *
+ * ## Thread Safety
+ * - Const member functions may be called concurrently
+ * - computeTimeVelocityCurves() uses internal worker threads
  *
  * @author kcenon
  * @since 1.0.0
@@ -42,6 +47,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <expected>
 #include <memory>
 #include <string>
@@ -180,6 +186,28 @@ public:
         const std::vector<VelocityPhase>& phases,
         double temporalResolution) const;
 
+    /**
+     * @brief Compute time-velocity curves for several planes in one pass
+     *
+     * Each plane's sample voxels are resolved once on the first phase's
+     * grid (phases on a different grid are resampled individually). Phases
+     * are then processed on worker threads, sampling every plane while the
+     * phase is in cache, so the velocity data is read once for all planes.
+     * The current measurementPlane() is not used.
+     *
+     * @param planes Measurement planes (normals need not be unit length)
+     * @param phases All cardiac phases in temporal order
+     * @param temporalResolution Time between phases in ms
+     * @param threadCount Worker threads (0 = hardware concurrency)
+     * @return One TimeVelocityCurve per plane, in input order
+     */
+    [[nodiscard]] std::expected<std::vector<TimeVelocityCurve>, FlowError>
+    computeTimeVelocityCurves(
+        const std::vector<MeasurementPlane>& planes,
+        const std::vector<VelocityPhase>& phases,
+        double temporalResolution,
+        size_t threadCount = 0) const;
+
     /**
      * @brief Estimate pressure gradient using simplified Bernoulli
      *
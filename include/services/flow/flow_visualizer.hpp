@@ -35,6 +35,9 @@
  *          and color modes (VelocityMagnitude, VelocityComponent,
  *          FlowDirection, TriggerTime). Contains StreamlineParams for
  *          configuring integration, step length, and tube rendering.
+ *          Streamlines and pathlines are integrated natively on worker
+ *          threads (see streamline_integrator.hpp); the vtkStreamTracer
+ *          path remains available for comparison.
  *
  * @author kcenon
  * @since 1.0.0
@@ -42,6 +45,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <expected>
 #include <memory>
 #include <vector>
@@ -57,6 +61,8 @@ class vtkLookupTable;
 
 namespace dicom_viewer::services {
 
+class PhaseCache;
+
 /**
  * @brief Visualization type for velocity field rendering
  *
@@ -80,6 +86,14 @@ enum class ColorMode {
     TriggerTime         ///< Time from R-wave with sequential colormap
 };
 
+/**
+ * @brief Streamline integration backend
+ */
+enum class StreamlineEngine {
+    Native,  ///< Multithreaded RK45/RK4 on a flat copy of the field
+    VTK      ///< vtkStreamTracer with vtkRungeKutta45 (single-threaded)
+};
+
 /**
  * @brief Parameters for streamline generation
  */
@@ -90,6 +104,9 @@ struct StreamlineParams {
     double terminalSpeed = 0.1;      ///< Stop threshold in cm/s
     double tubeRadius = 0.5;         ///< Tube filter radius in mm
     int tubeSides = 8;
+    StreamlineEngine engine = StreamlineEngine::Native;
+    bool adaptiveStep = true;        ///< Native only: RK45 error control (false = fixed RK4)
+    size_t threadCount = 0;          ///< Native only: worker threads (0 = hardware concurrency)
 };
 
 /**
@@ -110,6 +127,7 @@ struct PathlineParams {
     double terminalSpeed = 0.1;      ///< cm/s
     double tubeRadius = 0.5;         ///< mm
     int tubeSides = 8;
+    size_t threadCount = 0;          ///< Worker threads (0 = hardware concurrency)
 };
 
 /**
@@ -141,7 +159,7 @@ struct SeedRegion {
  *                        ↓
  *         ┌──────────────┼──────────────┐
  *     Streamlines    Pathlines     VectorGlyphs
- *   (vtkStreamTracer) (RK4 manual)  (vtkGlyph3D)
+ *   (native RK45)   (native RK4)   (vtkGlyph3D)
  *         ↓              ↓              ↓
  *    vtkTubeFilter    vtkPolyLine   vtkArrowSource
  *         ↓              ↓              ↓
@@ -177,8 +195,10 @@ public:
     /**
      * @brief Generate streamlines from current velocity field
      *
-     * Uses vtkStreamTracer with RK45 integrator and vtkTubeFilter
-     * for 3D tube rendering of flow trajectories.
+     * The native engine integrates all seeds in parallel with adaptive
+     * Cash-Karp RK45 on a trilinearly sampled copy of the field; the VTK
+     * engine uses vtkStreamTracer with vtkRungeKutta45. Both feed
+     * vtkTubeFilter for 3D tube rendering of flow trajectories.
      *
      * @param params Streamline generation parameters
      * @return PolyData with streamline geometry, or FlowError
@@ -190,8 +210,9 @@ public:
      * @brief Generate pathlines across multiple cardiac phases
      *
      * Traces particle motion through temporal velocity fields using
-     * Euler integration across phases. Each seed point produces one
-     * polyline connecting positions across time.
+     * RK4 in time with linear interpolation between adjacent phases.
+     * Each seed point produces one polyline connecting positions across
+     * time, with TriggerTime and VelocityMagnitude point arrays.
      *
      * @param allPhases Vector of all cardiac phases
      * @param params Pathline generation parameters
@@ -201,6 +222,22 @@ public:
     generatePathlines(const std::vector<VelocityPhase>& allPhases,
                       const PathlineParams& params = {}) const;
 
+    /**
+     * @brief Generate pathlines streaming phases from a PhaseCache
+     *
+     * Phases are fetched in order and only the two bounding the current
+     * time interval are held as sampled fields; the next phase is
+     * prefetched while the current interval is integrated.
+     *
+     * @param cache Phase cache with a configured loader
+     * @param phaseCount Number of phases to integrate across
+     * @param params Pathline generation parameters
+     * @return PolyData with pathline geometry, or FlowError
+     */
+    [[nodiscard]] std::expected<vtkSmartPointer<vtkPolyData>, FlowError>
+    generatePathlines(PhaseCache& cache, int phaseCount,
+                      const PathlineParams& params = {}) const;
+
     /**
      * @brief Generate vector glyphs from current velocity field
      *
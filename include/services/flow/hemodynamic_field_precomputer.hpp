@@ -0,0 +1,295 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file hemodynamic_field_precomputer.hpp
+ * @brief Background precomputation of per-phase hemodynamic overlay fields
+ * @details Once a flow study is loaded, computes the selected overlay
+ *          field (velocity magnitude, vorticity magnitude or viscous
+ *          dissipation) for every cardiac phase on a background thread.
+ *          Results are quantized to 8 or 16 bits against a per-phase
+ *          value range and held in memory, so scrolling phases with an
+ *          overlay visible decodes a stored field instead of recomputing
+ *          derivatives. Decoded fields are scalar vtkImageData ready for
+ *          HemodynamicOverlayRenderer::setScalarField().
+ *
+ * ## Thread Safety
+ * - All public methods are thread-safe (internal mutex)
+ * - The phase loader runs on worker threads and, for phases not yet
+ *   computed, on the caller of getField(); it must be thread-safe
+ *   (PhaseCache::getPhase() is)
+ * - The status callback is invoked from the background thread
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+
+#include "services/flow/compact_velocity_phase.hpp"
+#include "services/flow/flow_dicom_types.hpp"
+#include "services/flow/velocity_field_assembler.hpp"
+
+class vtkImageData;
+
+namespace dicom_viewer::services {
+
+/**
+ * @brief Overlay field derived from a velocity phase
+ *
+ * Matches the scalar OverlayType values of HemodynamicOverlayRenderer.
+ *
+ * @trace SRS-FR-046
+ */
+enum class HemodynamicFieldType {
+    VelocityMagnitude,  ///< |V| in cm/s
+    Vorticity,          ///< |curl(V)| in 1/s
+    EnergyLoss          ///< Viscous dissipation rate in W/m^3
+};
+
+/**
+ * @brief Bit depth of stored overlay fields
+ */
+enum class FieldQuantization {
+    UInt8,   ///< 255 steps over the phase range; 1/4 of float32
+    UInt16   ///< 65535 steps over the phase range; 1/2 of float32
+};
+
+/**
+ * @brief Scalar field quantized against its own value range
+ *
+ * A stored value q decodes to minValue + q * step(), where step() spans
+ * [minValue, maxValue] in 255 (UInt8) or 65535 (UInt16) steps.
+ */
+struct QuantizedScalarField {
+    FieldQuantization format = FieldQuantization::UInt16;
+    int phaseIndex = 0;
+    CompactImageGeometry geometry;
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    std::vector<uint8_t> values8;    ///< Used when format is UInt8
+    std::vector<uint16_t> values16;  ///< Used when format is UInt16
+
+    /// Value represented by one quantization step
+    [[nodiscard]] double step() const noexcept;
+
+    /// Decode one voxel (linear index)
+    [[nodiscard]] float valueAt(size_t voxel) const noexcept;
+
+    /// Largest absolute decode error (half a step)
+    [[nodiscard]] double errorBound() const noexcept { return step() / 2.0; }
+
+    /// Bytes held by the quantized buffer
+    [[nodiscard]] size_t memoryBytes() const noexcept {
+        return sizeof(*this) + values8.size() + values16.size() * sizeof(uint16_t);
+    }
+};
+
+/**
+ * @brief Quantize a float field against its own min/max
+ * @param values Voxel values in ITK buffer order
+ * @param geometry Geometry of the field (voxel count must match)
+ * @param format Target bit depth
+ */
+[[nodiscard]] QuantizedScalarField quantizeScalarField(
+    const std::vector<float>& values, const CompactImageGeometry& geometry,
+    FieldQuantization format);
+
+/**
+ * @brief Decode a quantized field into single-component float vtkImageData
+ */
+[[nodiscard]] vtkSmartPointer<vtkImageData>
+dequantizeScalarField(const QuantizedScalarField& field);
+
+/**
+ * @brief Progress of the background precomputation
+ *
+ * Mirrors CacheStatus so the UI can report both the same way.
+ *
+ * @trace SRS-FR-048
+ */
+struct FieldPrecomputeStatus {
+    HemodynamicFieldType fieldType = HemodynamicFieldType::VelocityMagnitude;
+    FieldQuantization quantization = FieldQuantization::UInt16;
+    int computedCount = 0;         ///< Phases stored so far
+    int totalPhases = 0;
+    int failedCount = 0;           ///< Phases whose load or computation failed
+    bool running = false;          ///< Background pass still in progress
+    size_t memoryUsageBytes = 0;   ///< Bytes held by quantized fields
+    double errorBound = 0.0;       ///< Worst decode error of stored fields
+
+    uint64_t hitCount = 0;         ///< getField() served from storage
+    uint64_t missCount = 0;        ///< getField() computed on the caller
+    double averageComputeTimeMs = 0.0;  ///< Moving average per phase
+};
+
+/**
+ * @brief Computes one overlay field for every phase in the background
+ *
+ * Typical wiring after a flow study loads:
+ * @code
+ *   precomputer.setPhaseLoader([&](int i) { return phaseCache.getPhase(i); });
+ *   precomputer.setStatusCallback(reportToUi);
+ *   precomputer.start(HemodynamicFieldType::Vorticity, phaseCount);
+ *   ...
+ *   if (auto field = precomputer.getField(phase)) {
+ *       overlay.setScalarField(*field);
+ *   }
+ * @endcode
+ *
+ * getField() for a phase the background pass has not reached yet computes
+ * it on the caller and stores the result, so it is never recomputed.
+ *
+ * @trace SRS-FR-046
+ */
+class HemodynamicFieldPrecomputer {
+public:
+    using PhaseLoader = std::function<std::expected<VelocityPhase, FlowError>(int)>;
+    using StatusCallback = std::function<void(const FieldPrecomputeStatus& status)>;
+
+    HemodynamicFieldPrecomputer();
+
+    /// Cancels a running pass and waits for it to stop
+    ~HemodynamicFieldPrecomputer();
+
+    HemodynamicFieldPrecomputer(const HemodynamicFieldPrecomputer&) = delete;
+    HemodynamicFieldPrecomputer& operator=(const HemodynamicFieldPrecomputer&) = delete;
+
+    /**
+     * @brief Set the function that provides velocity phases
+     */
+    void setPhaseLoader(PhaseLoader loader);
+
+    /**
+     * @brief Set the callback invoked after every stored phase
+     */
+    void setStatusCallback(StatusCallback callback);
+
+    /**
+     * @brief Select the bit depth for subsequently computed fields
+     */
+    void setQuantization(FieldQuantization format);
+
+    /**
+     * @brief Number of phases computed concurrently (0 = hardware concurrency)
+     */
+    void setThreadCount(size_t threadCount);
+
+    /**
+     * @brief Discard stored fields and compute @p fieldType for all phases
+     *
+     * Cancels and waits for a pass that is still running. Returns
+     * immediately; progress is reported through the status callback.
+     *
+     * @param fieldType Overlay field to compute
+     * @param phaseCount Number of phases in the study
+     * @return Error if no loader is set or phaseCount is not positive
+     */
+    [[nodiscard]] std::expected<void, FlowError>
+    start(HemodynamicFieldType fieldType, int phaseCount);
+
+    /**
+     * @brief Stop the background pass; stored fields are kept
+     */
+    void cancel();
+
+    /**
+     * @brief Block until the background pass finishes or is cancelled
+     */
+    void wait();
+
+    /**
+     * @brief Check whether the background pass is still running
+     */
+    [[nodiscard]] bool isRunning() const;
+
+    /**
+     * @brief Check whether a phase is stored
+     */
+    [[nodiscard]] bool isComputed(int phaseIndex) const;
+
+    /**
+     * @brief Decoded field of a phase, computing it now if not yet stored
+     * @return Single-component float vtkImageData, or FlowError
+     */
+    [[nodiscard]] std::expected<vtkSmartPointer<vtkImageData>, FlowError>
+    getField(int phaseIndex);
+
+    /**
+     * @brief Quantized storage of a phase without decoding it
+     * @return nullptr if the phase is not stored
+     */
+    [[nodiscard]] std::shared_ptr<const QuantizedScalarField>
+    getQuantizedField(int phaseIndex) const;
+
+    /**
+     * @brief Value range over all stored phases
+     *
+     * Useful as a fixed colormap range so colors are comparable across
+     * phases. Returns {0, 0} when nothing is stored.
+     */
+    [[nodiscard]] std::pair<double, double> valueRange() const;
+
+    /**
+     * @brief Get precomputation progress and storage statistics
+     */
+    [[nodiscard]] FieldPrecomputeStatus status() const;
+
+    /**
+     * @brief Cancel the pass and drop all stored fields
+     */
+    void clear();
+
+    /**
+     * @brief Compute an overlay field for one phase at full precision
+     *
+     * @param phase Velocity phase
+     * @param fieldType Field to derive
+     * @param threadCount Worker threads of the gradient pass (0 = hardware)
+     * @return Voxel values in ITK buffer order, or FlowError
+     */
+    [[nodiscard]] static std::expected<std::vector<float>, FlowError>
+    computeField(const VelocityPhase& phase, HemodynamicFieldType fieldType,
+                 size_t threadCount = 1);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace dicom_viewer::services
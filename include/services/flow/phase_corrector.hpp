@@ -35,9 +35,13 @@
  *          velocity aliasing (phase wrapping beyond VENC), eddy current
  *          background phase offsets, and Maxwell term (concomitant gradient)
  *          errors. Each correction independently configurable.
+ *          The eddy current fit streams the least-squares normal equations
+ *          slice by slice, and correctPhases() fits one background per
+ *          acquisition from time-averaged stationary tissue.
  *
  * ## Thread Safety
  * - Processes large 3D image data; corrections may be computationally intensive
+ * - Corrections split work across z-slices on internal worker threads
  * - ITK image operations should not be performed concurrently on the same data
  * - Input images must not be modified during correction
  *
@@ -46,6 +50,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <expected>
 #include <functional>
 #include <memory>
@@ -71,6 +76,7 @@ struct PhaseCorrectionConfig {
     bool enableMaxwellCorrection = true;
     int polynomialOrder = 2;           ///< Order for eddy current polynomial fit
     double aliasingThreshold = 0.8;    ///< Fraction of VENC for jump detection
+    size_t threadCount = 0;            ///< Worker threads (0 = hardware concurrency)
 
     [[nodiscard]] bool isValid() const noexcept {
         return polynomialOrder >= 1 && polynomialOrder <= 4 &&
@@ -127,6 +133,26 @@ public:
     correctPhase(const VelocityPhase& phase, double venc,
                  const PhaseCorrectionConfig& config) const;
 
+    /**
+     * @brief Apply all enabled corrections to every phase of an acquisition
+     *
+     * Eddy current offsets are static over the cardiac cycle, so one
+     * polynomial background is fitted to the time-averaged velocity in
+     * stationary tissue (detected on the time-averaged magnitude) and
+     * subtracted from every phase. Aliasing unwrap and the normal-equation
+     * accumulation share one pass per slice; the background subtraction is
+     * a second pass. Eddy current correction is skipped if any phase lacks
+     * a magnitude image.
+     *
+     * @param phases All phases of the acquisition, on one shared grid
+     * @param venc Velocity encoding value (cm/s), uniform across components
+     * @param config Correction options
+     * @return Corrected copies in input order, or FlowError on failure
+     */
+    [[nodiscard]] std::expected<std::vector<VelocityPhase>, FlowError>
+    correctPhases(const std::vector<VelocityPhase>& phases, double venc,
+                  const PhaseCorrectionConfig& config) const;
+
     /**
      * @brief Unwrap velocity aliasing artifacts in a vector velocity field
      *
@@ -170,12 +196,14 @@ public:
      * @brief Fit polynomial to scalar field within masked region
      *
      * Performs least-squares fitting of a polynomial surface to velocity
-     * values at locations identified by the mask.
+     * values at locations identified by the mask. The normal equations are
+     * accumulated per slice in parallel; the design matrix is not stored.
+     * The mask must have the same size as the scalar field.
      *
      * @param scalarField Single velocity component image
      * @param mask Binary mask (non-zero = include in fitting)
-     * @param order Polynomial order (1 = linear, 2 = quadratic)
-     * @return Polynomial coefficients
+     * @param order Polynomial order (1 = linear, 2 = quadratic, ...)
+     * @return Polynomial coefficients; empty if @p order is negative
      */
     [[nodiscard]] static std::vector<double> fitPolynomialBackground(
         FloatImage3D::Pointer scalarField,
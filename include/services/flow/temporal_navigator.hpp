@@ -34,28 +34,46 @@
  * @details Manages memory by keeping configurable number of phases loaded,
  *          evicting least-recently-used phases when window size exceeded.
  *          Supports cine playback modes with FPS, speed multipliers,
- *          and CacheStatus monitoring.
+ *          and CacheStatus monitoring. Phases can be held in a compact
+ *          16-bit tier (see compact_velocity_phase.hpp) so the window can
+ *          span a whole cardiac cycle. During playback the navigator
+ *          prefetches the next phases in the playback direction on a
+ *          background thread, sized from the measured load time and the
+ *          effective frame rate. An overlay field can be precomputed for
+ *          every phase through the cache and delivered on each phase change.
  *
  * ## Thread Safety
  * - Uses std::mutex internally for thread-safe cache access
- * - LRU eviction requires synchronization during phase lookup and updates
- * - Playback state changes are protected against race conditions
+ * - Phase loads run outside the lock; concurrent requests for the same
+ *   phase share one load
+ * - The phase loader may be invoked concurrently from a caller thread and
+ *   the prefetch worker, so it must be thread-safe
+ * - TemporalNavigator itself is intended for a single (UI) thread
+ * - Overlay precomputation also calls the phase loader from its workers
  *
  * @author kcenon
  * @since 1.0.0
  */
 #pragma once
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <expected>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "services/flow/compact_velocity_phase.hpp"
 #include "services/flow/flow_dicom_types.hpp"
+#include "services/flow/hemodynamic_field_precomputer.hpp"
 #include "services/flow/velocity_field_assembler.hpp"
 
 namespace dicom_viewer::services {
@@ -68,8 +86,18 @@ namespace dicom_viewer::services {
 struct CacheStatus {
     int cachedCount = 0;
     int totalPhases = 0;
-    size_t memoryUsageBytes = 0;
+    size_t memoryUsageBytes = 0;  ///< Bytes held by cached phase buffers
     int windowSize = 0;
+
+    PhaseStorageFormat storageFormat = PhaseStorageFormat::Float32;
+    double velocityErrorBound = 0.0;  ///< Worst decode error of cached phases (cm/s)
+
+    uint64_t hitCount = 0;           ///< getPhase() served from cache
+    uint64_t missCount = 0;          ///< getPhase() that had to wait for a load
+    uint64_t prefetchCount = 0;      ///< Phases loaded by the prefetch worker
+    uint64_t prefetchHitCount = 0;   ///< Hits on phases the worker loaded
+    int prefetchDepth = 0;           ///< Size of the latest prefetch request
+    double averageLoadTimeMs = 0.0;  ///< Moving average of loader latency
 };
 
 /**
@@ -91,7 +119,9 @@ struct PlaybackState {
  *
  * Manages memory by keeping only a configurable number of phases
  * in memory, evicting least-recently-used phases when the window
- * size is exceeded.
+ * size is exceeded. Phases can be prefetched on a background worker;
+ * a getPhase() for a phase that is already loading waits for that load
+ * instead of starting another.
  *
  * @trace SRS-FR-048
  */
@@ -103,6 +133,12 @@ public:
      */
     explicit PhaseCache(int windowSize = 5);
 
+    /// Stops the prefetch worker, waiting for a load in progress
+    ~PhaseCache();
+
+    PhaseCache(const PhaseCache&) = delete;
+    PhaseCache& operator=(const PhaseCache&) = delete;
+
     /**
      * @brief Set the phase loader function
      *
@@ -122,6 +158,59 @@ public:
     [[nodiscard]] std::expected<VelocityPhase, FlowError>
     getPhase(int phaseIndex);
 
+    /**
+     * @brief Read a phase without changing the cache
+     *
+     * For background readers that visit every phase once. A cached phase
+     * is returned without moving it in the LRU order or counting a hit;
+     * any other phase is loaded with the current loader and not inserted,
+     * so the playback window is never evicted.
+     *
+     * @param phaseIndex 0-based phase index
+     * @return VelocityPhase on success, FlowError on failure
+     */
+    [[nodiscard]] std::expected<VelocityPhase, FlowError>
+    peekOrLoad(int phaseIndex);
+
+    /**
+     * @brief Queue phases for background loading
+     *
+     * Replaces any queued but not yet started requests, so the most recent
+     * playback position wins. Phases already cached or loading are skipped.
+     * The worker thread is started on first use.
+     *
+     * @param phaseIndices Phases in the order they should be loaded
+     */
+    void prefetch(const std::vector<int>& phaseIndices);
+
+    /**
+     * @brief Select how newly loaded phases are stored
+     *
+     * Compact formats cut memory per phase in half; getPhase() expands
+     * them back to float32 images, and getCompactPhase() exposes the 16-bit
+     * buffers for kernels that decode on the fly. Already cached phases
+     * keep their format.
+     *
+     * @param format Storage tier for subsequent loads
+     * @param venc Series VENC (cm/s) used to size the int16 quantization step
+     */
+    void setStorageFormat(PhaseStorageFormat format, double venc = 0.0);
+
+    /** @brief Current storage tier for newly loaded phases */
+    [[nodiscard]] PhaseStorageFormat storageFormat() const;
+
+    /**
+     * @brief Compact buffers of a cached phase without expanding them
+     * @return nullptr if the phase is not cached or is stored as Float32
+     */
+    [[nodiscard]] std::shared_ptr<const CompactVelocityPhase>
+    getCompactPhase(int phaseIndex) const;
+
+    /**
+     * @brief Moving average of loader latency (0 before the first load)
+     */
+    [[nodiscard]] double averageLoadTimeMs() const;
+
     /**
      * @brief Check if a phase is currently cached
      */
@@ -153,15 +242,54 @@ public:
     [[nodiscard]] int windowSize() const noexcept;
 
 private:
+    using PhaseLoader = std::function<std::expected<VelocityPhase, FlowError>(int)>;
+
+    /// Cached phase in float32 or compact form, and whether it was loaded
+    /// by the prefetch worker and not yet requested
+    struct Entry {
+        VelocityPhase phase;
+        std::shared_ptr<const CompactVelocityPhase> compact;
+        size_t bytes = 0;
+        double errorBound = 0.0;
+        bool prefetched = false;
+    };
+
+    static Entry makeEntry(VelocityPhase phase, PhaseStorageFormat format,
+                           double venc, bool prefetched);
     void evictIfNeeded();
     void touchPhase(int phaseIndex);
+    void insertLocked(int phaseIndex, Entry entry);
+    void recordLoadTimeLocked(double milliseconds);
+    void prefetchLoop();
 
     int windowSize_;
     int totalPhases_ = 0;
-    std::unordered_map<int, VelocityPhase> cache_;
+    std::unordered_map<int, Entry> cache_;
     std::list<int> accessOrder_;  // Front = most recent
-    std::function<std::expected<VelocityPhase, FlowError>(int)> loader_;
+    std::shared_ptr<const PhaseLoader> loader_;
     mutable std::mutex mutex_;
+    PhaseStorageFormat storageFormat_ = PhaseStorageFormat::Float32;
+    double storageVenc_ = 0.0;
+    size_t memoryBytes_ = 0;
+
+    // Loads in progress (foreground or prefetch); waiters block on loadDone_
+    std::unordered_set<int> inFlight_;
+    std::condition_variable loadDone_;
+
+    // Prefetch worker state
+    std::deque<int> prefetchQueue_;
+    std::condition_variable prefetchReady_;
+    std::thread prefetchThread_;
+    bool stopping_ = false;
+    uint64_t generation_ = 0;  // Bumped by clear() to drop stale loads
+
+    // Statistics
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+    uint64_t prefetchCount_ = 0;
+    uint64_t prefetchHitCount_ = 0;
+    int prefetchDepth_ = 0;
+    double averageLoadTimeMs_ = 0.0;
 };
 
 /**
@@ -183,6 +311,9 @@ public:
     using PlaybackChangedCallback = std::function<void(const PlaybackState& state)>;
     /// Callback for cache status updates
     using CacheStatusCallback = std::function<void(const CacheStatus& status)>;
+    /// Callback with the overlay field of the phase just navigated to
+    using OverlayFieldCallback =
+        std::function<void(int phaseIndex, vtkSmartPointer<vtkImageData> field)>;
 
     TemporalNavigator();
     ~TemporalNavigator();
@@ -202,6 +333,13 @@ public:
     void initialize(int phaseCount, double temporalResolution,
                     int cacheWindowSize = 5);
 
+    /**
+     * @brief Set the storage tier of the phase cache
+     *
+     * Kept across initialize(); see PhaseCache::setStorageFormat().
+     */
+    void setPhaseStorageFormat(PhaseStorageFormat format, double venc = 0.0);
+
     /**
      * @brief Set the phase loader for cache
      */
@@ -246,6 +384,11 @@ public:
      * Call this method from a timer (e.g., QTimer) at the configured
      * frame rate. Returns the next phase to display.
      *
+     * While playing, every navigation also queues the following phases in
+     * the playback direction (wrapping when looping) for background
+     * loading. The depth covers the measured load time at the effective
+     * frame rate and never exceeds the cache window minus the shown phase.
+     *
      * @return Next phase data, or error, or nullopt if not playing
      */
     [[nodiscard]] std::expected<VelocityPhase, FlowError> tick();
@@ -260,11 +403,54 @@ public:
     [[nodiscard]] CacheStatus cacheStatus() const;
     [[nodiscard]] bool isInitialized() const;
 
+    /**
+     * @brief Number of phases prefetched ahead at the current playback rate
+     *
+     * ceil(averageLoadTime / frameInterval) + 1, limited to the cache window
+     * minus the displayed phase; 0 when the window holds a single phase.
+     */
+    [[nodiscard]] int prefetchDepth() const;
+
+    // --- Overlay precomputation ---
+
+    /**
+     * @brief Precompute an overlay field for every phase in the background
+     *
+     * A HemodynamicFieldPrecomputer reads phases through
+     * PhaseCache::peekOrLoad(): phases already in the playback window are
+     * reused, the rest are loaded from disk without entering the cache, so
+     * the pass never evicts the window. The cost is a second disk read for
+     * phases that navigation later brings into the window. The pass starts
+     * once the navigator is initialized and has a phase loader, and
+     * restarts on initialize() or setPhaseLoader().
+     * Each successful navigation then passes the phase's field to the
+     * overlay field callback:
+     * @code
+     *   navigator.enableOverlayPrecompute(HemodynamicFieldType::Vorticity);
+     *   navigator.setOverlayFieldCallback([&](int, auto field) {
+     *       overlay.setScalarField(field);
+     *   });
+     * @endcode
+     *
+     * @param fieldType Overlay field to compute
+     * @param quantization Bit depth of the stored fields
+     */
+    void enableOverlayPrecompute(
+        HemodynamicFieldType fieldType,
+        FieldQuantization quantization = FieldQuantization::UInt16);
+
+    /** @brief Stop overlay precomputation and drop the stored fields */
+    void disableOverlayPrecompute();
+
+    /** @brief Progress of overlay precomputation; nullopt when disabled */
+    [[nodiscard]] std::optional<FieldPrecomputeStatus> overlayPrecomputeStatus() const;
+
     // --- Callbacks ---
 
     void setPhaseChangedCallback(PhaseChangedCallback callback);
     void setPlaybackChangedCallback(PlaybackChangedCallback callback);
     void setCacheStatusCallback(CacheStatusCallback callback);
+    void setOverlayFieldCallback(OverlayFieldCallback callback);
 
 private:
     class Impl;
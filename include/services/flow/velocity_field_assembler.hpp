@@ -32,9 +32,17 @@
  * @file velocity_field_assembler.hpp
  * @brief Assembles 3D velocity vector fields from parsed 4D Flow DICOM frames
  * @details Constructs temporal sequence of 3D velocity vector fields from frame
- *          matrix using ITK image types. Pipeline: read scalar volumes,
- *          apply VENC scaling, compose 3 components into VectorImage3D,
- *          output VelocityPhase per cardiac phase.
+ *          matrix using ITK image types. Every DICOM file of the requested
+ *          phases is decoded exactly once on a worker pool; velocity
+ *          components are VENC-scaled in the same pass and written straight
+ *          into the interleaved VectorImage3D buffer of their phase.
+ *
+ * ## Thread Safety
+ * - assemblePhase() and assembleAllPhases() are const and may run
+ *   concurrently (e.g. from a PhaseCache prefetch worker); do not change
+ *   the progress callback while they run
+ * - Decoding runs on internal worker threads; the progress callback is
+ *   serialized but may be invoked from any of them
  *
  * @author kcenon
  * @since 1.0.0
@@ -82,12 +90,19 @@ struct VelocityPhase {
  * Pipeline:
  * @code
  * FlowSeriesInfo (from FlowDicomParser)
- *   → Read scalar DICOM volumes (Magnitude, Vx, Vy, Vz)
+ *   → Allocate VectorImage3D (+ magnitude) per phase from slice headers
+ *   → Decode each file (Magnitude, Vx, Vy, Vz) once on a worker pool
  *   → Apply VENC scaling to convert pixel values to velocity (cm/s)
- *   → Compose 3 scalar volumes into VectorImage3D
+ *   → Write each component into its slot of the interleaved buffer
  *   → Output VelocityPhase per cardiac phase
  * @endcode
  *
+ * VENC scaling maps the representable pixel range of each file (from
+ * Bits Stored, Pixel Representation and the modality rescale) onto
+ * [-VENC, +VENC] by its centre and half-range, so a rescale whose range
+ * does not start at 0 is handled and no second pass over the decoded data
+ * is needed.
+ *
  * @trace SRS-FR-044
  */
 class VelocityFieldAssembler {
@@ -113,8 +128,8 @@ public:
     /**
      * @brief Assemble all cardiac phases into velocity fields
      *
-     * Reads pixel data for each phase and component, applies VENC scaling,
-     * and composes vector fields.
+     * Decodes all phases as one parallel work list; phases that fail are
+     * logged and skipped.
      *
      * @param seriesInfo Parsed series from FlowDicomParser
      * @return Vector of VelocityPhase on success, FlowError on failure
@@ -144,6 +159,21 @@ public:
     [[nodiscard]] static float applyVENCScaling(
         float pixelValue, double venc, int maxPixelValue, bool isSigned);
 
+    /**
+     * @brief Apply VENC scaling over an explicit rescaled pixel range
+     *
+     * Maps the centre of [rangeMin, rangeMax] to 0 and its bounds to
+     * -VENC and +VENC.
+     *
+     * @param pixelValue Pixel value after the modality rescale
+     * @param venc Velocity encoding value (cm/s)
+     * @param rangeMin Lowest representable rescaled pixel value
+     * @param rangeMax Highest representable rescaled pixel value
+     * @return Velocity in cm/s, or 0 for an empty range
+     */
+    [[nodiscard]] static float applyVENCScaling(
+        float pixelValue, double venc, double rangeMin, double rangeMax);
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -32,12 +32,21 @@
  * @file vessel_analyzer.hpp
  * @brief Wall Shear Stress and vortex analysis for flow dynamics
  * @details Computes Wall Shear Stress (WSS), vorticity magnitude and field,
- *          helicity density with right/left components, and kinetic energy
- *          per voxel. Provides WSSResult, VortexResult, and
- *          KineticEnergyResult structures.
+ *          helicity density with right/left components, viscous dissipation,
+ *          Q-criterion, lambda2 and kinetic energy per voxel. The
+ *          derivative-based metrics share one multithreaded pass that
+ *          evaluates the full velocity gradient tensor per voxel. Provides
+ *          WSSResult, VortexResult, EnergyLossResult, VelocityGradientResult
+ *          and KineticEnergyResult structures. TKEAccumulator and
+ *          WallShearAccumulator compute the multi-phase metrics from phases
+ *          fed one at a time, so a full cardiac cycle never has to be
+ *          resident at once.
  *
  * ## Thread Safety
  * - Computationally intensive derivative calculations on 3D velocity fields
+ * - computeVelocityGradientMetrics() splits the volume into slab tiles and
+ *   processes them on worker threads; each tile writes disjoint voxels
+ * - Accumulators are not thread-safe; feed each from one thread at a time
  * - Different analysis metrics may be computed in parallel on separate data
  * - Input velocity data must not be modified during analysis
  *
@@ -46,6 +55,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <expected>
 #include <memory>
 #include <vector>
@@ -123,6 +133,52 @@ struct EnergyLossResult {
     int voxelCount = 0;                      ///< Number of voxels in computation
 };
 
+/**
+ * @brief Selects the outputs of the fused velocity gradient pass
+ *
+ * All requested metrics are derived from the same per-voxel gradient
+ * tensor, so adding outputs costs arithmetic but no extra field reads.
+ *
+ * @trace SRS-FR-047
+ */
+struct VelocityGradientOptions {
+    /// Emit curl(V) vector field and its magnitude (1/s)
+    bool computeVorticity = true;
+
+    /// Emit helicity density V dot curl(V) with right/left parts (m/s^2)
+    bool computeHelicity = true;
+
+    /// Emit viscous dissipation field and integrated energy loss
+    bool computeDissipation = true;
+
+    /// Emit Q-criterion 0.5 * (|Omega|^2 - |S|^2) in 1/s^2
+    bool computeQCriterion = true;
+
+    /// Emit lambda2, the middle eigenvalue of S^2 + Omega^2, in 1/s^2
+    bool computeLambda2 = true;
+
+    /// Optional ROI; voxels where the mask is zero are left at 0
+    FloatImage3D::Pointer mask;
+
+    /// Worker threads (0 = hardware concurrency)
+    size_t threadCount = 0;
+};
+
+/**
+ * @brief Output of the fused velocity gradient pass
+ *
+ * Images for metrics that were not requested stay null. Boundary voxels
+ * (no central-difference neighbors) are 0.
+ *
+ * @trace SRS-FR-047
+ */
+struct VelocityGradientResult {
+    VortexResult vortex;            ///< Vorticity and/or helicity fields
+    EnergyLossResult energyLoss;    ///< Dissipation field and totals
+    FloatImage3D::Pointer qCriterion;  ///< Q > 0 marks rotation-dominated flow (1/s^2)
+    FloatImage3D::Pointer lambda2;     ///< lambda2 < 0 marks vortex cores (1/s^2)
+};
+
 /**
  * @brief Advanced hemodynamic analysis for 4D Flow velocity data
  *
@@ -137,6 +193,8 @@ struct EnergyLossResult {
  * OSI:       0.5 * (1 - |sum(tau_i)| / sum(|tau_i|))
  * Vorticity: omega = curl(V) = nabla x V
  * Helicity:  H = V dot omega
+ * Q:         0.5 * (|Omega|^2 - |S|^2),  S/Omega = sym/antisym(grad V)
+ * lambda2:   middle eigenvalue of S^2 + Omega^2
  * TKE:       0.5 * (var_Vx + var_Vy + var_Vz)
  * @endcode
  *
@@ -207,7 +265,8 @@ public:
     /**
      * @brief Compute Time-Averaged WSS (TAWSS) across all phases
      *
-     * TAWSS = (1/N) * sum(|tau_i|) at each wall vertex
+     * TAWSS = (1/N) * sum(|tau_i|) at each wall vertex.
+     * Use WallShearAccumulator to stream phases instead.
      *
      * @param phases All cardiac phases
      * @param wallMesh Vessel wall surface mesh with vertex normals
@@ -222,6 +281,7 @@ public:
      *
      * OSI = 0.5 * (1 - |sum(tau_i)| / sum(|tau_i|))
      * Range: [0, 0.5], higher = more oscillatory (atherosclerosis risk)
+     * Use WallShearAccumulator to stream phases instead.
      *
      * @param phases All cardiac phases
      * @param wallMesh Vessel wall surface mesh with vertex normals
@@ -247,6 +307,26 @@ public:
     [[nodiscard]] std::expected<VortexResult, FlowError>
     computeVorticity(const VelocityPhase& phase) const;
 
+    // --- Velocity gradient tensor ---
+
+    /**
+     * @brief Compute several derivative-based metrics in one pass
+     *
+     * Evaluates all 9 central-difference derivatives of the velocity field
+     * once per interior voxel and derives every requested output from that
+     * tensor. computeVorticity() and computeEnergyLoss() are thin wrappers
+     * around this pass; call it directly to get vorticity, helicity,
+     * dissipation, Q-criterion and lambda2 from a single read of the field.
+     *
+     * @param phase Velocity field
+     * @param options Requested outputs, ROI mask and thread count
+     * @return VelocityGradientResult, or FlowError on invalid input or if
+     *         no output is requested
+     */
+    [[nodiscard]] std::expected<VelocityGradientResult, FlowError>
+    computeVelocityGradientMetrics(const VelocityPhase& phase,
+                                   const VelocityGradientOptions& options = {}) const;
+
     // --- Turbulent Kinetic Energy ---
 
     /**
@@ -255,6 +335,8 @@ public:
      * TKE = 0.5 * (sigma^2_Vx + sigma^2_Vy + sigma^2_Vz)
      * where sigma^2 is temporal variance at each voxel
      *
+     * All phases must be resident; use TKEAccumulator to stream them.
+     *
      * @param phases All cardiac phases (minimum 3 required)
      * @return TKE volume in J/m^3
      */
@@ -314,4 +396,119 @@ private:
     std::unique_ptr<Impl> impl_;
 };
 
+/**
+ * @brief Streaming Turbulent Kinetic Energy from phases fed one at a time
+ *
+ * Keeps a running per-voxel mean and sum of squared deviations (Welford),
+ * so memory stays at one float32 velocity field plus one scalar image
+ * regardless of the number of phases. Phases can come straight from
+ * PhaseCache::getPhase() or VelocityFieldAssembler::assemblePhase() and be
+ * released after addPhase() returns.
+ *
+ * @code
+ * TKEAccumulator tke(analyzer.bloodDensity());
+ * for (int i = 0; i < phaseCount; ++i) {
+ *     auto phase = cache.getPhase(i);
+ *     if (!phase || !tke.addPhase(*phase)) { ... }
+ * }
+ * auto tkeImage = tke.result();
+ * @endcode
+ *
+ * @trace SRS-FR-047
+ */
+class TKEAccumulator {
+public:
+    /**
+     * @param bloodDensity Density in kg/m^3 used to convert variance to J/m^3
+     */
+    explicit TKEAccumulator(double bloodDensity = 1060.0);
+    ~TKEAccumulator();
+
+    TKEAccumulator(const TKEAccumulator&) = delete;
+    TKEAccumulator& operator=(const TKEAccumulator&) = delete;
+    TKEAccumulator(TKEAccumulator&&) noexcept;
+    TKEAccumulator& operator=(TKEAccumulator&&) noexcept;
+
+    /**
+     * @brief Fold one phase into the running moments
+     * @return FlowError if the field is null, not 3-component, or on a
+     *         different grid than the first phase
+     */
+    [[nodiscard]] std::expected<void, FlowError> addPhase(const VelocityPhase& phase);
+
+    /** @brief Number of phases accumulated so far */
+    [[nodiscard]] int phaseCount() const;
+
+    /**
+     * @brief TKE = 0.5 * rho * (var_Vx + var_Vy + var_Vz) in J/m^3
+     * @return New image each call; FlowError with fewer than 3 phases
+     */
+    [[nodiscard]] std::expected<FloatImage3D::Pointer, FlowError> result() const;
+
+    /** @brief Drop all accumulated phases */
+    void reset();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Streaming TAWSS / OSI on a fixed wall mesh
+ *
+ * The wall sampling stencil is built from the first phase and reused for
+ * every later phase on the same grid. Per vertex only the running WSS
+ * vector sum and magnitude sum are kept, so memory does not grow with the
+ * number of phases.
+ *
+ * @trace SRS-FR-047
+ */
+class WallShearAccumulator {
+public:
+    /**
+     * @param wallMesh Vessel wall surface (normals are computed if missing)
+     * @param bloodViscosity Dynamic viscosity in Pa*s
+     * @param lowWSSThreshold Threshold in Pa for the first phase's low WSS area
+     */
+    explicit WallShearAccumulator(vtkSmartPointer<vtkPolyData> wallMesh,
+                                  double bloodViscosity = 0.004,
+                                  double lowWSSThreshold = 0.4);
+    ~WallShearAccumulator();
+
+    WallShearAccumulator(const WallShearAccumulator&) = delete;
+    WallShearAccumulator& operator=(const WallShearAccumulator&) = delete;
+    WallShearAccumulator(WallShearAccumulator&&) noexcept;
+    WallShearAccumulator& operator=(WallShearAccumulator&&) noexcept;
+
+    /**
+     * @brief Evaluate WSS for one phase and add it to the running sums
+     * @return FlowError if the field is invalid or the wall mesh is empty
+     */
+    [[nodiscard]] std::expected<void, FlowError> addPhase(const VelocityPhase& phase);
+
+    /** @brief Number of phases accumulated so far */
+    [[nodiscard]] int phaseCount() const;
+
+    /**
+     * @brief TAWSS over the accumulated phases
+     *
+     * The mesh carries the first phase's WSS_Magnitude / WSS_Vector arrays
+     * and a TAWSS array. FlowError if no phase was added.
+     */
+    [[nodiscard]] std::expected<WSSResult, FlowError> tawss() const;
+
+    /**
+     * @brief OSI (and TAWSS) over the accumulated phases
+     * @return FlowError with fewer than 2 phases
+     */
+    [[nodiscard]] std::expected<WSSResult, FlowError> osi() const;
+
+    /** @brief Drop all accumulated phases (the wall mesh is kept) */
+    void reset();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 }  // namespace dicom_viewer::services
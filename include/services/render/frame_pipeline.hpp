@@ -0,0 +1,213 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/**
+ * @file frame_pipeline.hpp
+ * @brief Pipelined encode and send stages for remote render streaming
+ * @details Decouples frame encoding and transmission from the render
+ *          workers. Frames handed over by RenderSessionManager's frame
+ *          callback are queued per session, compressed on an encoder
+ *          pool and delivered by sender threads, so rendering frame N+1
+ *          overlaps with encoding frame N and sending frame N-1.
+ *
+ * ## Architecture
+ * ```
+ * render worker --submit()--> [encode queue/session] --encoder pool-->
+ *     [send queue/session] --sender--> FrameSendCallback (e.g. pushFrame)
+ * ```
+ *
+ * ## Drop Policy
+ * - Each session holds at most FramePipelineConfig::maxQueuedFrames frames
+ *   waiting at each stage; when a stage is full the oldest waiting frame
+ *   is dropped, so clients always converge on the latest render
+ * - A session has at most one frame encoding and one frame sending at a
+ *   time, so its frames leave in submission order; sessions proceed in
+ *   parallel across the encoder pool
+ * - Frame sequence numbers are assigned per session at submission, so
+ *   dropped frames show up as gaps
+ *
+ * ## Thread Safety
+ * - All public methods are thread-safe (internal mutex)
+ * - submit() moves the caller's frame buffer into the queue without
+ *   copying it and never waits for encoding or sending
+ * - The send callback is invoked from sender threads without the
+ *   pipeline lock held, at most once at a time per session
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+
+#pragma once
+
+#include "services/render/frame_encoder.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dicom_viewer::services {
+
+/**
+ * @brief Configuration for the frame pipeline
+ */
+struct FramePipelineConfig {
+    /// Encoder worker threads (0 = hardware concurrency)
+    uint32_t encodeThreads = 0;
+
+    /// Sender threads delivering encoded frames (minimum 1)
+    uint32_t sendThreads = 1;
+
+    /// Frames waiting per session at each stage before the oldest is dropped
+    uint32_t maxQueuedFrames = 1;
+
+    /// Compression applied by the encode stage
+    EncodeFormat format = EncodeFormat::Jpeg;
+
+    /// JPEG quality 1-100
+    int quality = 85;
+};
+
+/**
+ * @brief Callback that transmits one encoded frame
+ * @param sessionId Session that produced the frame
+ * @param encoded Compressed frame data
+ * @param width Frame width in pixels
+ * @param height Frame height in pixels
+ * @param frameSeq Per-session sequence number assigned at submission
+ */
+using FrameSendCallback = std::function<void(
+    const std::string& sessionId,
+    const std::vector<uint8_t>& encoded,
+    uint32_t width, uint32_t height,
+    uint32_t frameSeq)>;
+
+/**
+ * @brief Timing summary of one pipeline stage
+ */
+struct FrameStageTiming {
+    uint64_t count = 0;      ///< Frames measured
+    double averageMs = 0.0;  ///< Mean time per frame
+    double maxMs = 0.0;      ///< Slowest frame
+};
+
+/**
+ * @brief Throughput, drop and timing counters of the pipeline
+ */
+struct FramePipelineStats {
+    uint64_t submitted = 0;            ///< Frames accepted by submit()
+    uint64_t encoded = 0;              ///< Frames encoded successfully
+    uint64_t sent = 0;                 ///< Frames handed to the send callback
+    uint64_t droppedBeforeEncode = 0;  ///< Replaced or discarded while waiting to encode
+    uint64_t droppedBeforeSend = 0;    ///< Replaced or discarded while waiting to send
+    uint64_t encodeFailures = 0;       ///< Frames the encoder returned empty
+    FrameStageTiming queueWait;        ///< submit() to encode start
+    FrameStageTiming encode;           ///< Compression time
+    FrameStageTiming send;             ///< Send callback time
+    FrameStageTiming latency;          ///< submit() to send completion
+};
+
+/**
+ * @brief Per-session encode/send pipeline with latest-frame-wins queues
+ *
+ * Worker threads start on construction and stop on stop() or
+ * destruction; frames still queued at that point are discarded.
+ *
+ * @trace SRS-FR-REMOTE-002
+ */
+class FramePipeline {
+public:
+    explicit FramePipeline(const FramePipelineConfig& config = {});
+    ~FramePipeline();
+
+    // Non-copyable, non-movable (owns worker threads)
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+    FramePipeline(FramePipeline&&) = delete;
+    FramePipeline& operator=(FramePipeline&&) = delete;
+
+    /**
+     * @brief Set the callback that transmits encoded frames
+     * @details Frames encoded while no callback is set are discarded
+     */
+    void setSendCallback(FrameSendCallback callback);
+
+    /**
+     * @brief Queue a raw frame for encoding and sending
+     * @param sessionId Session that produced the frame
+     * @param rgbaFrame RGBA pixel data (width * height * 4 bytes); ownership
+     *        passes to the pipeline
+     * @param width Frame width in pixels
+     * @param height Frame height in pixels
+     * @return false if the pipeline is stopped or the frame is malformed
+     */
+    bool submit(const std::string& sessionId,
+                std::vector<uint8_t>&& rgbaFrame,
+                uint32_t width, uint32_t height);
+
+    /**
+     * @brief Discard a session's queued frames and sequence state
+     * @details A frame of the session that is already being encoded is
+     *          discarded when encoding finishes; one already being sent
+     *          completes.
+     */
+    void removeSession(const std::string& sessionId);
+
+    /**
+     * @brief Block until no frame is queued, encoding or sending
+     */
+    void waitIdle();
+
+    /**
+     * @brief Stop the workers and discard queued frames (idempotent)
+     * @details Must not be called from the send callback
+     */
+    void stop();
+
+    /**
+     * @brief Get throughput, drop and per-stage timing counters
+     */
+    [[nodiscard]] FramePipelineStats stats() const;
+
+    /**
+     * @brief Reset all counters and timings to zero
+     */
+    void resetStats();
+
+    /**
+     * @brief Get the pipeline configuration
+     */
+    [[nodiscard]] const FramePipelineConfig& config() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace dicom_viewer::services
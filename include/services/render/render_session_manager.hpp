@@ -32,21 +32,31 @@
  * @brief Manages lifecycle of per-client headless render sessions
  * @details Creates, tracks, and destroys RenderSession objects for remote
  *          rendering clients. Provides idle timeout cleanup, max session
- *          enforcement, and a background render loop that captures frames
- *          at a configurable target FPS.
+ *          enforcement, and a pool of background render workers that
+ *          capture frames at a configurable target FPS.
  *
  * ## Architecture
  * ```
  * RenderSessionManager
  *   +-- session_map: {session_id -> RenderSession + metadata}
- *   +-- render_thread: fires at target FPS, captures frames
+ *   +-- render_workers[N]: each paces its own sessions at target FPS
  *   +-- idle_timeout: destroys zombie sessions
  *   +-- frame_callback: delivers rendered frames to caller
+ *   +-- volume_cache: read-only volumes shared by sessions (StudyVolumeCache)
  * ```
  *
+ * Each session is pinned to one worker for its lifetime, so its off-screen
+ * context is only ever driven from that thread, and sessions are spread
+ * over workers by current load. A slow render delays only the sessions
+ * that share its worker.
+ *
  * ## Thread Safety
  * - All public methods are thread-safe (internal mutex)
- * - Frame callback is invoked from the render loop thread
+ * - The manager mutex is never held while a frame is rendered or
+ *   delivered; capture and delivery take only a per-session lock, so
+ *   session bookkeeping never waits behind a render
+ * - Frame callback is invoked concurrently from the render workers, at
+ *   most once at a time per session
  * - Idle cleanup can be called from any thread
  *
  * @author kcenon
@@ -55,6 +65,8 @@
 
 #pragma once
 
+#include "services/render/study_volume_cache.hpp"
+
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -87,20 +99,45 @@ struct RenderSessionManagerConfig {
 
     /// Default frame height when not specified per session
     uint32_t defaultHeight = 512;
+
+    /// Host-memory budget for volumes shared between sessions (0 = unlimited)
+    uint64_t volumeCacheBudgetBytes = 4ULL * 1024 * 1024 * 1024;
+
+    /// Render worker threads (0 = hardware concurrency); never more than
+    /// maxSessions when a session limit is set
+    uint32_t renderThreads = 0;
+};
+
+/**
+ * @brief Render loop throughput and per-stage timings
+ */
+struct RenderLoopStats {
+    uint64_t framesRendered = 0;     ///< Non-empty frames captured and delivered
+    double averageCaptureMs = 0.0;   ///< Mean captureVolumeFrame() time
+    double maxCaptureMs = 0.0;       ///< Slowest capture
+    double averageDeliveryMs = 0.0;  ///< Mean frame callback time
+    double maxDeliveryMs = 0.0;      ///< Slowest frame callback
 };
 
 /**
  * @brief Callback invoked when a frame is ready for delivery
  * @param sessionId Session that produced the frame
- * @param rgbaFrame RGBA pixel data (width * height * 4 bytes)
+ * @param rgbaFrame RGBA pixel data (width * height * 4 bytes); the callback
+ *        owns the buffer and may move it onward instead of copying
  * @param width Frame width in pixels
  * @param height Frame height in pixels
  */
 using FrameReadyCallback = std::function<void(
     const std::string& sessionId,
-    const std::vector<uint8_t>& rgbaFrame,
+    std::vector<uint8_t>&& rgbaFrame,
     uint32_t width, uint32_t height)>;
 
+/**
+ * @brief Callback invoked after a session is destroyed (explicitly or idle)
+ * @param sessionId Session that no longer exists
+ */
+using SessionDestroyedCallback = std::function<void(const std::string& sessionId)>;
+
 /**
  * @brief Manages per-client headless render session lifecycles
  *
@@ -133,6 +170,12 @@ public:
 
     /**
      * @brief Destroy a render session and free its resources
+     *
+     * Waits for a frame of this session that is being rendered or
+     * delivered to finish; no frame callback for the session starts after
+     * this returns. Must not be called from the frame callback for the
+     * same session.
+     *
      * @param sessionId Session to destroy
      * @return true if destroyed, false if session not found
      */
@@ -175,19 +218,72 @@ public:
     [[nodiscard]] AdaptiveQualityController* getQualityController(
         const std::string& sessionId);
 
+    /**
+     * @brief Load a volume into a session through the shared volume cache
+     *
+     * Sessions that request the same key share one vtkImageData instead of
+     * holding separate copies. The loader runs only on a cache miss and
+     * without the manager lock held; the session keeps the volume resident
+     * until it is destroyed or loads another volume.
+     *
+     * @param sessionId Target session
+     * @param key Series and processing identity of the volume
+     * @param loader Produces the volume on a miss (nullptr = failure)
+     * @return true if the session now displays the volume
+     * @throws StudyVolumeLoadAborted if @p loader abandoned the load
+     */
+    bool loadSessionVolume(const std::string& sessionId,
+                           const StudyVolumeKey& key,
+                           const StudyVolumeCache::Loader& loader);
+
+    /**
+     * @brief Show a transient volume in a session without caching it
+     *
+     * Used for the coarse passes of a progressive build while the full
+     * volume is still decoding. sessionVolume() is unchanged; the next
+     * loadSessionVolume() replaces the preview.
+     *
+     * @param sessionId Target session
+     * @param image Preview volume, or nullptr to restore the session's
+     *        cached volume (or no input if it has none)
+     * @return true if the session exists
+     */
+    bool previewSessionVolume(const std::string& sessionId,
+                              vtkSmartPointer<vtkImageData> image);
+
+    /**
+     * @brief Get the volume shared into a session, if any
+     */
+    [[nodiscard]] CachedVolumeHandle sessionVolume(const std::string& sessionId) const;
+
+    /**
+     * @brief Get the volume cache shared by all sessions
+     */
+    [[nodiscard]] StudyVolumeCache& volumeCache();
+
     /**
      * @brief Set callback for rendered frame delivery
-     * @details Called from the render loop thread at target FPS
+     * @details Called from the render workers at target FPS, concurrently
+     *          for sessions on different workers. The manager lock is not
+     *          held, so the callback may call back into the manager.
      */
     void setFrameReadyCallback(FrameReadyCallback callback);
 
     /**
-     * @brief Start the background render loop
+     * @brief Set callback for session destruction (e.g., to cancel loads)
+     * @details Called without the manager lock held, from the thread that
+     *          destroyed the session or ran idle cleanup
+     */
+    void setSessionDestroyedCallback(SessionDestroyedCallback callback);
+
+    /**
+     * @brief Start the background render workers
      */
     void startRenderLoop();
 
     /**
-     * @brief Stop the background render loop
+     * @brief Stop the background render workers
+     * @details Must not be called from the frame callback
      */
     void stopRenderLoop();
 
@@ -196,6 +292,18 @@ public:
      */
     [[nodiscard]] bool isRenderLoopRunning() const;
 
+    /**
+     * @brief Get the number of render workers sessions are spread over
+     */
+    [[nodiscard]] size_t renderWorkerCount() const;
+
+    /**
+     * @brief Get frame counts and capture/delivery timings of the render loop
+     * @details A slow delivery means the frame callback does too much work
+     *          on the render worker; hand frames to a FramePipeline instead
+     */
+    [[nodiscard]] RenderLoopStats renderLoopStats() const;
+
     /**
      * @brief Destroy sessions that have been idle beyond the timeout
      * @return Number of sessions destroyed
@@ -33,11 +33,15 @@
  * @details Generates and renders 2D streamlines from 3D velocity field data
  *          projected onto MPR slice planes. Supports configurable
  *          streamline density, length, and color mapping for
- *          flow visualization.
+ *          flow visualization. LIC textures are computed with a
+ *          multithreaded fast-LIC kernel and kept in an LRU cache keyed
+ *          by plane, slice and cardiac phase for cine playback.
  *
  * ## Thread Safety
  * - All rendering operations must be called from the main (UI) thread
  * - Streamline computation may be offloaded to background threads
+ * - computeLIC() uses internal worker threads and is safe to call
+ *   concurrently on different inputs
  *
  * @author kcenon
  * @since 1.0.0
@@ -46,6 +50,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <memory>
 
@@ -78,6 +84,17 @@ struct LICParams {
     int kernelLength = 20;            ///< Number of steps forward+backward for convolution
     double stepSize = 0.5;            ///< Euler integration step in pixels
     unsigned int noiseSeed = 42;      ///< Random seed for reproducible noise texture
+    size_t threadCount = 0;           ///< Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Occupancy and effectiveness counters of the LIC texture cache
+ */
+struct LICCacheStats {
+    size_t entries = 0;               ///< Textures currently cached
+    size_t capacity = 0;              ///< Maximum number of cached textures
+    uint64_t hits = 0;                ///< Plane updates served from the cache
+    uint64_t misses = 0;              ///< Plane updates that computed a texture
 };
 
 /**
@@ -105,6 +122,10 @@ struct LICParams {
  *     → vtkImageActor (grayscale overlay)
  * @endcode
  *
+ * LIC textures are cached per (plane, slice index, phase index). During
+ * cine playback, pass the phase with setVelocityField(field, phaseIndex)
+ * so revisited phases reuse their textures instead of recomputing them.
+ *
  * @trace SRS-FR-046
  */
 class StreamlineOverlayRenderer {
@@ -134,6 +155,25 @@ public:
      */
     void setVelocityField(vtkSmartPointer<vtkImageData> velocityField);
 
+    /**
+     * @brief Set the velocity field of one cardiac phase
+     *
+     * Unlike the single-argument overload, cached LIC textures are kept so
+     * cine playback reuses the textures of previously shown phases. All
+     * phases passed this way must belong to the same acquisition; call
+     * clearLICCache() when switching datasets.
+     *
+     * @param velocityField 3D vtkImageData with 3-component vectors
+     * @param phaseIndex Cardiac phase index of @p velocityField
+     */
+    void setVelocityField(vtkSmartPointer<vtkImageData> velocityField,
+                          int phaseIndex);
+
+    /**
+     * @brief Get the phase index of the current velocity field
+     */
+    [[nodiscard]] int phaseIndex() const noexcept;
+
     /**
      * @brief Check if a velocity field has been set
      */
@@ -178,9 +218,31 @@ public:
 
     /**
      * @brief Set LIC parameters
+     *
+     * Clears the LIC texture cache, since cached textures depend on them.
      */
     void setLICParams(const LICParams& params);
 
+    // ==================== LIC Cache ====================
+
+    /**
+     * @brief Set the maximum number of cached LIC textures
+     *
+     * Least recently used textures are evicted beyond the capacity.
+     * A capacity of 0 disables caching.
+     */
+    void setLICCacheCapacity(size_t capacity);
+
+    /**
+     * @brief Drop all cached LIC textures
+     */
+    void clearLICCache();
+
+    /**
+     * @brief Get LIC cache occupancy and hit/miss counters
+     */
+    [[nodiscard]] LICCacheStats licCacheStats() const noexcept;
+
     // ==================== Rendering ====================
 
     /**
@@ -244,6 +306,12 @@ public:
      * Creates a grayscale texture showing flow direction patterns by
      * convolving a white noise image along streamlines.
      *
+     * Uses fast LIC: each traced streamline is reused for every pixel it
+     * passes, with a running box filter over its noise samples, so most
+     * pixels cost a prefix-sum lookup instead of a full trace. Rows are
+     * processed in fixed blocks across LICParams::threadCount workers;
+     * the result does not depend on the thread count.
+     *
      * @param velocitySlice 2D velocity field from extractSliceVelocity()
      * @param params LIC parameters
      * @return Grayscale vtkImageData texture, or error
@@ -0,0 +1,251 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file study_load_job_queue.hpp
+ * @brief Background job engine that loads studies into render sessions
+ * @details Runs the scan -> decode -> ITK-to-VTK pipeline for
+ *          POST /api/v1/sessions/{id}/load on a bounded worker pool, so
+ *          REST worker threads return immediately while multi-second
+ *          loads proceed in the background.
+ *
+ * ## Scheduling
+ * - Jobs are ordered by priority (Interactive before Prefetch), then
+ *   by submission order
+ * - At most StudyLoadJobConfig::maxQueuedJobs jobs wait at any time;
+ *   further submissions are rejected
+ * - Decoded volumes go through RenderSessionManager::loadSessionVolume(),
+ *   so sessions loading the same series share one decode
+ *
+ * ## Cancellation
+ * - cancel() / cancelSession() drop queued jobs immediately
+ * - Running jobs stop at their next progress report; a job whose volume
+ *   is already attached completes normally
+ * - RenderSessionManager skips attaching volumes to destroyed sessions, so
+ *   a decode that finishes after its session is gone only warms the cache
+ *
+ * ## Thread Safety
+ * - All public methods are thread-safe (internal mutex)
+ * - The progress callback is invoked from worker threads without the
+ *   queue lock held
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+namespace dicom_viewer::services {
+
+class RenderSessionManager;
+
+/**
+ * @brief Scheduling class of a load job
+ */
+enum class LoadJobPriority {
+    Interactive = 0,  ///< A user is waiting on the session
+    Prefetch = 1      ///< Speculative warm-up; runs when no interactive work waits
+};
+
+/**
+ * @brief Lifecycle state of a load job
+ */
+enum class LoadJobState {
+    Queued,
+    Running,
+    Completed,
+    Failed,
+    Cancelled
+};
+
+/**
+ * @brief Convert a job state to its wire name ("queued", "running", ...)
+ */
+[[nodiscard]] const char* toString(LoadJobState state);
+
+/**
+ * @brief What to load and where
+ */
+struct LoadJobRequest {
+    std::string sessionId;
+    std::string studyInstanceUid;
+
+    /// Series to load; empty selects the study's series with most slices
+    std::string seriesInstanceUid;
+
+    /// Directory scanned for the study's DICOM files
+    std::filesystem::path sourceDirectory;
+
+    LoadJobPriority priority = LoadJobPriority::Interactive;
+};
+
+/**
+ * @brief Snapshot of a job's progress
+ */
+struct LoadJobStatus {
+    std::string jobId;
+    std::string sessionId;
+    std::string studyInstanceUid;
+    std::string seriesInstanceUid;  ///< Resolved series once scanning is done
+    LoadJobPriority priority = LoadJobPriority::Interactive;
+    LoadJobState state = LoadJobState::Queued;
+    double progress = 0.0;          ///< 0.0 - 1.0
+    std::string message;
+};
+
+/**
+ * @brief Configuration for the load job engine
+ */
+struct StudyLoadJobConfig {
+    /// Number of worker threads running load pipelines
+    uint32_t workerCount = 2;
+
+    /// Maximum jobs waiting to run (0 = unlimited)
+    uint32_t maxQueuedJobs = 64;
+
+    /// Finished job statuses retained for polling
+    uint32_t maxRetainedJobs = 256;
+
+    /// Decoded-volume cache used by the default pipeline (empty = disabled)
+    std::filesystem::path volumeCacheDirectory;
+
+    /// Reuse and update the persistent scan index (SeriesIndex) of each
+    /// source directory, so repeat loads only parse new or changed files
+    bool useScanIndex = true;
+};
+
+/**
+ * @brief Callback invoked whenever a job's status changes
+ */
+using LoadJobProgressCallback = std::function<void(const LoadJobStatus& status)>;
+
+/**
+ * @brief Bounded, prioritized worker pool for study loading
+ *
+ * @trace SRS-FR-REMOTE-005
+ */
+class StudyLoadJobQueue {
+public:
+    /**
+     * @brief Reports pipeline progress (0.0 - 1.0) from a volume loader
+     * @return false if the job was cancelled and the loader should stop
+     */
+    using ProgressReporter = std::function<bool(double progress, const std::string& message)>;
+
+    /**
+     * @brief Decodes the series of a request into a VTK volume
+     *
+     * The default pipeline scans the request's source directory with
+     * SeriesBuilder, reusing the directory's scan index unless
+     * StudyLoadJobConfig::useScanIndex is off, decodes the selected series
+     * and shares the result with VTK through ImageConverter (no copy). A replacement loader
+     * receives the request unchanged; its volume is cached under the
+     * request's series UID, or the study UID when no series is named.
+     */
+    using VolumeLoader = std::function<vtkSmartPointer<vtkImageData>(
+        const LoadJobRequest& request, const ProgressReporter& progress)>;
+
+    /**
+     * @param sessions Session manager receiving loaded volumes (must outlive the queue)
+     * @param config Worker and queue limits
+     */
+    explicit StudyLoadJobQueue(RenderSessionManager& sessions,
+                               const StudyLoadJobConfig& config = {});
+    ~StudyLoadJobQueue();
+
+    // Non-copyable, non-movable (owns worker threads)
+    StudyLoadJobQueue(const StudyLoadJobQueue&) = delete;
+    StudyLoadJobQueue& operator=(const StudyLoadJobQueue&) = delete;
+    StudyLoadJobQueue(StudyLoadJobQueue&&) = delete;
+    StudyLoadJobQueue& operator=(StudyLoadJobQueue&&) = delete;
+
+    /**
+     * @brief Queue a load job
+     * @return Job ID, or std::nullopt if the queue is full or stopped
+     */
+    std::optional<std::string> submit(LoadJobRequest request);
+
+    /**
+     * @brief Cancel a queued or running job
+     * @return true if the job existed and had not finished
+     */
+    bool cancel(const std::string& jobId);
+
+    /**
+     * @brief Cancel every unfinished job of a session (e.g., on destroy)
+     * @return Number of jobs cancelled
+     */
+    size_t cancelSession(const std::string& sessionId);
+
+    /**
+     * @brief Get the current status of a job
+     */
+    [[nodiscard]] std::optional<LoadJobStatus> status(const std::string& jobId) const;
+
+    /**
+     * @brief Number of jobs waiting for a worker
+     */
+    [[nodiscard]] size_t queuedCount() const;
+
+    /**
+     * @brief Set callback for job status changes (e.g., WebSocket push)
+     */
+    void setProgressCallback(LoadJobProgressCallback callback);
+
+    /**
+     * @brief Replace the scan/decode pipeline (nullptr restores the default)
+     */
+    void setVolumeLoader(VolumeLoader loader);
+
+    /**
+     * @brief Cancel all jobs and join the worker threads
+     */
+    void stop();
+
+    /**
+     * @brief Get the engine configuration
+     */
+    [[nodiscard]] const StudyLoadJobConfig& config() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace dicom_viewer::services
@@ -0,0 +1,194 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file study_volume_cache.hpp
+ * @brief Reference-counted host-memory cache of decoded study volumes
+ * @details Shares one read-only vtkImageData per (series, processing)
+ *          key across all render sessions that display it. Volumes are
+ *          kept within a configurable host-memory budget and evicted in
+ *          least-recently-used order once no session holds them.
+ *
+ * ## Sharing Model
+ * - getOrLoad() returns a CachedVolumeHandle; the volume stays resident
+ *   while any handle is alive, even if the cache itself evicts the entry
+ * - Concurrent requests for a key that is still loading wait for the
+ *   single in-flight load instead of decoding the study again
+ * - Cached images are shared between sessions and must not be modified
+ *
+ * ## Thread Safety
+ * - All public methods are thread-safe (internal mutex)
+ * - Loader callbacks run on the requesting thread without the lock held
+ * - A loader that throws StudyVolumeLoadAborted hands the key to the next
+ *   waiter, which retries with its own loader
+ *
+ * @author kcenon
+ * @since 1.0.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+namespace dicom_viewer::services {
+
+/**
+ * @brief Identity of a cached volume
+ *
+ * Two sessions share a volume only if both the series and every
+ * processing step applied after decoding (resampling, HU windowing,
+ * masking, ...) are identical.
+ */
+struct StudyVolumeKey {
+    /// Series Instance UID of the source series
+    std::string seriesInstanceUid;
+
+    /// Canonical description of processing parameters (empty = raw decode)
+    std::string processing;
+
+    bool operator==(const StudyVolumeKey&) const = default;
+};
+
+/**
+ * @brief A resident, read-only shared volume
+ */
+struct CachedVolume {
+    StudyVolumeKey key;
+    vtkSmartPointer<vtkImageData> image;  ///< Shared; treat as read-only
+    uint64_t sizeBytes = 0;               ///< Scalar memory of @c image
+};
+
+/// Shared ownership of a cached volume; keeps it resident while held
+using CachedVolumeHandle = std::shared_ptr<const CachedVolume>;
+
+/**
+ * @brief Cache occupancy and effectiveness counters
+ */
+struct StudyVolumeCacheStats {
+    size_t entries = 0;         ///< Volumes currently held by the cache
+    uint64_t residentBytes = 0; ///< Sum of sizeBytes over held volumes
+    uint64_t budgetBytes = 0;   ///< Configured host-memory budget
+    uint64_t hits = 0;          ///< Requests served from the cache
+    uint64_t misses = 0;        ///< Requests that invoked the loader
+    uint64_t evictions = 0;     ///< Entries dropped to honor the budget
+};
+
+/**
+ * @brief Thrown by a Loader to abandon a load without failing other callers
+ *        waiting for the same key
+ *
+ * getOrLoad() rethrows it to the aborting caller only; waiters retry the
+ * load with their own loader.
+ */
+class StudyVolumeLoadAborted : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief LRU cache of decoded volumes shared across render sessions
+ *
+ * @trace SRS-FR-REMOTE-005
+ */
+class StudyVolumeCache {
+public:
+    /// Produces the volume on a cache miss; nullptr signals failure
+    using Loader = std::function<vtkSmartPointer<vtkImageData>()>;
+
+    /**
+     * @param budgetBytes Host-memory budget for cached volumes (0 = unlimited)
+     */
+    explicit StudyVolumeCache(uint64_t budgetBytes);
+    ~StudyVolumeCache();
+
+    // Non-copyable, non-movable (shared by reference between components)
+    StudyVolumeCache(const StudyVolumeCache&) = delete;
+    StudyVolumeCache& operator=(const StudyVolumeCache&) = delete;
+    StudyVolumeCache(StudyVolumeCache&&) = delete;
+    StudyVolumeCache& operator=(StudyVolumeCache&&) = delete;
+
+    /**
+     * @brief Return the cached volume for @p key, loading it on a miss
+     *
+     * If another thread is already loading the same key, this call waits
+     * for that load and shares its result. If that load is abandoned with
+     * StudyVolumeLoadAborted, this call retries with @p loader.
+     *
+     * @param key Series and processing identity
+     * @param loader Invoked at most once per miss, without the lock held
+     * @return Handle to the volume, or nullptr if the loader failed
+     * @throws StudyVolumeLoadAborted if @p loader itself aborted the load
+     */
+    CachedVolumeHandle getOrLoad(const StudyVolumeKey& key, const Loader& loader);
+
+    /**
+     * @brief Look up a resident volume without loading
+     * @return Handle, or nullptr if not cached
+     */
+    [[nodiscard]] CachedVolumeHandle find(const StudyVolumeKey& key);
+
+    /**
+     * @brief Drop a volume from the cache (existing handles stay valid)
+     * @return true if the key was cached
+     */
+    bool erase(const StudyVolumeKey& key);
+
+    /**
+     * @brief Drop every volume from the cache
+     */
+    void clear();
+
+    /**
+     * @brief Change the budget and evict down to it if necessary
+     */
+    void setBudget(uint64_t budgetBytes);
+
+    /**
+     * @brief Get occupancy and hit/miss counters
+     */
+    [[nodiscard]] StudyVolumeCacheStats stats() const;
+
+    /**
+     * @brief Scalar memory footprint of an image in bytes
+     */
+    [[nodiscard]] static uint64_t imageSizeBytes(vtkImageData* image);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace dicom_viewer::services
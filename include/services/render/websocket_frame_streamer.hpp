@@ -62,11 +62,16 @@
  *  "buttons":1,"modifiers":[],"ts":1709600000123}
  * ```
  *
+ * Server -> Client (text frame, JSON status events such as load progress):
+ * ```json
+ * {"type":"load_progress","jobId":"load-1a2b3c4d","state":"running","progress":0.42}
+ * ```
+ *
  * Channel mapping: 0=3D Volume, 1=Axial MPR, 2=Sagittal MPR, 3=Coronal MPR
  *
  * ## Thread Safety
  * - start()/stop() must be called from one thread
- * - pushFrame() is thread-safe (uses internal locking)
+ * - pushFrame() and pushText() are thread-safe (use internal locking)
  * - Input event callback is invoked from Crow's IO thread
  *
  * @author kcenon
@@ -220,6 +225,14 @@ public:
                      uint8_t channelId = 0,
                      uint8_t frameType = 0x00);
 
+    /**
+     * @brief Push a JSON text message to all clients connected to a session
+     * @param sessionId Target render session ID
+     * @param message Serialized JSON payload
+     * @return Number of clients the message was sent to
+     */
+    size_t pushText(const std::string& sessionId, const std::string& message);
+
     /**
      * @brief Set callback for received input events
      * @param callback Function to call when an input event arrives
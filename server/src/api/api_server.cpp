@@ -91,6 +91,14 @@ public:
         gpuBudget_ = gpuBudget;
     }
 
+    void setFramePipeline(services::FramePipeline* pipeline) {
+        pipeline_ = pipeline;
+    }
+
+    void setLoadJobQueue(services::StudyLoadJobQueue* jobs) {
+        jobs_ = jobs;
+    }
+
     void setPacsServices(services::DicomEchoSCU* echo,
                          services::DicomFindSCU* finder,
                          services::DicomMoveSCU* mover) {
@@ -167,7 +175,7 @@ private:
         // ---- Modular route registration ----
         registerAuthRoutes(app_.get(), auth_, audit_, config_.corsOrigin);
         registerSessionRoutes(app_.get(), sessions_, audit_, config_.wsBaseUrl, config_.corsOrigin);
-        registerStudyRoutes(app_.get(), sessions_, audit_, config_.uploadDir, config_.corsOrigin);
+        registerStudyRoutes(app_.get(), sessions_, jobs_, audit_, config_.uploadDir, config_.corsOrigin);
         registerPacsRoutes(app_.get(), echo_, finder_, mover_, audit_, config_.corsOrigin);
         registerRenderRoutes(app_.get(), sessions_, config_.corsOrigin);
         registerSegmentationRoutes(app_.get(), sessions_, config_.corsOrigin);
@@ -175,7 +183,8 @@ private:
         registerFlowRoutes(app_.get(), sessions_, config_.corsOrigin);
         registerCardiacRoutes(app_.get(), sessions_, config_.corsOrigin);
         registerExportRoutes(app_.get(), sessions_, audit_, config_.exportDir, config_.corsOrigin);
-        registerHealthRoutes(app_.get(), gpuBudget_, config_.corsOrigin);
+        registerHealthRoutes(app_.get(), gpuBudget_, sessions_, pipeline_,
+                             config_.corsOrigin);
 
         // ---- Catch-all 404 ----
         CROW_CATCHALL_ROUTE((*app_))([this](crow::response& res) {
@@ -199,6 +208,8 @@ private:
     services::DicomFindSCU* finder_ = nullptr;
     services::DicomMoveSCU* mover_ = nullptr;
     services::GpuMemoryBudgetManager* gpuBudget_ = nullptr;
+    services::FramePipeline* pipeline_ = nullptr;
+    services::StudyLoadJobQueue* jobs_ = nullptr;
 };
 
 // ---- ApiServer public interface ----
@@ -228,6 +239,14 @@ void ApiServer::setGpuBudgetManager(services::GpuMemoryBudgetManager* gpuBudget)
     impl_->setGpuBudgetManager(gpuBudget);
 }
 
+void ApiServer::setFramePipeline(services::FramePipeline* pipeline) {
+    impl_->setFramePipeline(pipeline);
+}
+
+void ApiServer::setLoadJobQueue(services::StudyLoadJobQueue* jobs) {
+    impl_->setLoadJobQueue(jobs);
+}
+
 void ApiServer::setPacsServices(services::DicomEchoSCU* echo,
                                  services::DicomFindSCU* finder,
                                  services::DicomMoveSCU* mover) {
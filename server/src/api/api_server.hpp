@@ -38,6 +38,7 @@
  * |--------|---------------------------------------------|-----------|------------------------------|
  * | GET    | /api/v1/health                              | No        | Health check                 |
  * | GET    | /api/v1/health/gpu                          | No        | GPU metrics (stub)           |
+ * | GET    | /api/v1/health/stream                       | No        | Frame stream stage timings   |
  * | POST   | /api/v1/auth/login                          | No        | User authentication          |
  * | POST   | /api/v1/auth/refresh                        | No        | Token refresh                |
  * | POST   | /api/v1/auth/logout                         | Bearer    | Token revocation             |
@@ -49,7 +50,9 @@
  * | POST   | /api/v1/studies/upload                      | Clinician | DICOM file upload            |
  * | GET    | /api/v1/studies                             | Viewer    | List studies                 |
  * | GET    | /api/v1/studies/{uid}/series                | Viewer    | List series                  |
- * | POST   | /api/v1/sessions/{id}/load                  | Clinician | Load study into session      |
+ * | POST   | /api/v1/sessions/{id}/load                  | Clinician | Queue study load             |
+ * | GET    | /api/v1/load-jobs/{id}                      | Viewer    | Study load progress          |
+ * | DELETE | /api/v1/load-jobs/{id}                      | Clinician | Cancel study load            |
  * | POST   | /api/v1/pacs/servers/{id}/echo              | Clinician | C-ECHO connectivity test     |
  * | POST   | /api/v1/pacs/query                          | Clinician | C-FIND study query           |
  * | POST   | /api/v1/pacs/retrieve                       | Clinician | C-MOVE image retrieval       |
@@ -78,9 +81,11 @@
 
 namespace dicom_viewer::services {
 class AuthProvider;
+class FramePipeline;
 class GpuMemoryBudgetManager;
 class RenderSessionManager;
 class SessionTokenValidator;
+class StudyLoadJobQueue;
 class AuditService;
 class DicomEchoSCU;
 class DicomFindSCU;
@@ -159,6 +164,19 @@ public:
      */
     void setGpuBudgetManager(services::GpuMemoryBudgetManager* gpuBudget);
 
+    /**
+     * @brief Inject the frame pipeline whose stage timings health routes report
+     * @param pipeline FramePipeline instance (non-owning, may be nullptr)
+     */
+    void setFramePipeline(services::FramePipeline* pipeline);
+
+    /**
+     * @brief Inject the background study-load job queue
+     * @param jobs StudyLoadJobQueue instance (non-owning, may be nullptr)
+     * @note If nullptr, the session load route returns 503 Service Unavailable
+     */
+    void setLoadJobQueue(services::StudyLoadJobQueue* jobs);
+
     /**
      * @brief Inject PACS SCU services for PACS integration routes
      * @param echo   C-ECHO SCU (non-owning, may be nullptr)
@@ -29,7 +29,9 @@
 
 #include "health_routes.hpp"
 
+#include "services/render/frame_pipeline.hpp"
 #include "services/render/gpu_memory_budget_manager.hpp"
+#include "services/render/render_session_manager.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -38,8 +40,22 @@ namespace dicom_viewer::server {
 using routes::addCorsHeaders;
 using nlohmann::json;
 
+namespace {
+
+json stageJson(const services::FrameStageTiming& timing) {
+    json stage;
+    stage["frames"]    = timing.count;
+    stage["averageMs"] = timing.averageMs;
+    stage["maxMs"]     = timing.maxMs;
+    return stage;
+}
+
+} // anonymous namespace
+
 void registerHealthRoutes(routes::App* app,
                           services::GpuMemoryBudgetManager* gpuBudget,
+                          services::RenderSessionManager* sessions,
+                          services::FramePipeline* pipeline,
                           const std::string& corsOrigin) {
     // GET /api/v1/health/gpu — GPU memory budget metrics
     CROW_ROUTE((*app), "/api/v1/health/gpu")(
@@ -67,6 +83,47 @@ void registerHealthRoutes(routes::App* app,
                 resp["activeSessions"] = 0;
             }
 
+            res.code = 200;
+            res.body = resp.dump();
+            res.end();
+        });
+
+    // GET /api/v1/health/stream — capture, encode and send stage timings
+    CROW_ROUTE((*app), "/api/v1/health/stream")(
+        [corsOrigin, sessions, pipeline](const crow::request& /*req*/, crow::response& res) {
+            addCorsHeaders(res, corsOrigin);
+
+            json resp;
+            resp["available"] = sessions != nullptr && pipeline != nullptr;
+
+            if (sessions) {
+                auto r = sessions->renderLoopStats();
+                json capture;
+                capture["frames"]    = r.framesRendered;
+                capture["averageMs"] = r.averageCaptureMs;
+                capture["maxMs"]     = r.maxCaptureMs;
+                json delivery;
+                delivery["frames"]    = r.framesRendered;
+                delivery["averageMs"] = r.averageDeliveryMs;
+                delivery["maxMs"]     = r.maxDeliveryMs;
+                resp["renderWorkers"] = sessions->renderWorkerCount();
+                resp["capture"]       = capture;
+                resp["delivery"]      = delivery;
+            }
+
+            if (pipeline) {
+                auto p = pipeline->stats();
+                resp["submitted"]           = p.submitted;
+                resp["sent"]                = p.sent;
+                resp["droppedBeforeEncode"] = p.droppedBeforeEncode;
+                resp["droppedBeforeSend"]   = p.droppedBeforeSend;
+                resp["encodeFailures"]      = p.encodeFailures;
+                resp["queueWait"]           = stageJson(p.queueWait);
+                resp["encode"]              = stageJson(p.encode);
+                resp["send"]                = stageJson(p.send);
+                resp["latency"]             = stageJson(p.latency);
+            }
+
             res.code = 200;
             res.body = resp.dump();
             res.end();
@@ -29,14 +29,16 @@
 
 /**
  * @file health_routes.hpp
- * @brief Extended health check routes (GPU metrics)
+ * @brief Extended health check routes (GPU metrics, frame stream timings)
  * @details The base /api/v1/health route remains in api_server.cpp.
- *          This module adds the GPU-specific health endpoint.
+ *          This module adds the GPU-specific health endpoint and the
+ *          per-stage timings of the capture -> encode -> send stream.
  *
  * ## Routes
- * | Method | Path               | Auth   |
- * |--------|--------------------|--------|
- * | GET    | /api/v1/health/gpu | Public |
+ * | Method | Path                  | Auth   |
+ * |--------|-----------------------|--------|
+ * | GET    | /api/v1/health/gpu    | Public |
+ * | GET    | /api/v1/health/stream | Public |
  *
  * @author kcenon
  * @since 1.0.0
@@ -49,7 +51,9 @@
 #include <string>
 
 namespace dicom_viewer::services {
+class FramePipeline;
 class GpuMemoryBudgetManager;
+class RenderSessionManager;
 } // namespace dicom_viewer::services
 
 namespace dicom_viewer::server {
@@ -58,10 +62,14 @@ namespace dicom_viewer::server {
  * @brief Register extended health check routes on the Crow application.
  * @param app        Crow application with JwtMiddleware (non-owning)
  * @param gpuBudget  GPU memory budget manager (non-owning, may be nullptr)
+ * @param sessions   Render session manager for capture timings (non-owning, may be nullptr)
+ * @param pipeline   Frame pipeline for encode/send timings (non-owning, may be nullptr)
  * @param corsOrigin CORS allowed-origin header value
  */
 void registerHealthRoutes(routes::App* app,
                           services::GpuMemoryBudgetManager* gpuBudget,
+                          services::RenderSessionManager* sessions,
+                          services::FramePipeline* pipeline,
                           const std::string& corsOrigin);
 
 } // namespace dicom_viewer::server
@@ -30,6 +30,7 @@
 #include "study_routes.hpp"
 
 #include "services/render/render_session_manager.hpp"
+#include "services/render/study_load_job_queue.hpp"
 #include "services/audit_service.hpp"
 
 #include <nlohmann/json.hpp>
@@ -59,10 +60,25 @@ bool isDicomFile(const std::string& data) {
 /// Max DICOM upload size: 512 MB
 constexpr size_t kMaxUploadBytes = 512UL * 1024 * 1024;
 
+json loadJobToJson(const services::LoadJobStatus& status) {
+    json j;
+    j["jobId"]     = status.jobId;
+    j["sessionId"] = status.sessionId;
+    j["studyUid"]  = status.studyInstanceUid;
+    j["seriesUid"] = status.seriesInstanceUid;
+    j["priority"]  = status.priority == services::LoadJobPriority::Prefetch
+                         ? "prefetch" : "interactive";
+    j["status"]    = services::toString(status.state);
+    j["progress"]  = status.progress;
+    j["message"]   = status.message;
+    return j;
+}
+
 } // anonymous namespace
 
 void registerStudyRoutes(routes::App* app,
                          services::RenderSessionManager* sessions,
+                         services::StudyLoadJobQueue* jobs,
                          services::AuditService* audit,
                          const std::string& uploadDir,
                          const std::string& corsOrigin) {
@@ -178,10 +194,12 @@ void registerStudyRoutes(routes::App* app,
             res.end();
         });
 
-    // POST /api/v1/sessions/{id}/load — Load a study into a render session (Clinician+)
+    // POST /api/v1/sessions/{id}/load — Queue a study load into a render session (Clinician+)
+    // Returns immediately; progress is pushed on the session WebSocket and
+    // can be polled at /api/v1/load-jobs/{jobId}.
     CROW_ROUTE((*app), "/api/v1/sessions/<string>/load")
         .methods(crow::HTTPMethod::Post)(
-        [app, sessions, audit, corsOrigin]
+        [app, sessions, jobs, audit, uploadDir, corsOrigin]
         (const crow::request& req, crow::response& res, const std::string& sessionId) {
             if (!requireRole(*app, req, res, services::Role::Clinician, corsOrigin)) return;
             addCorsHeaders(res, corsOrigin);
@@ -193,6 +211,13 @@ void registerStudyRoutes(routes::App* app,
                 return;
             }
 
+            if (!jobs) {
+                res.code = 503;
+                res.body = R"({"error":"service_unavailable","message":"Study load queue not configured"})";
+                res.end();
+                return;
+            }
+
             json body;
             try {
                 body = json::parse(req.body);
@@ -211,6 +236,31 @@ void registerStudyRoutes(routes::App* app,
                 return;
             }
 
+            const auto priority = body.value("priority", std::string{"interactive"});
+            if (priority != "interactive" && priority != "prefetch") {
+                res.code = 400;
+                res.body = R"({"error":"bad_request","message":"priority must be 'interactive' or 'prefetch'"})";
+                res.end();
+                return;
+            }
+
+            services::LoadJobRequest request;
+            request.sessionId         = sessionId;
+            request.studyInstanceUid  = studyUid;
+            request.seriesInstanceUid = body.value("seriesUid", std::string{});
+            request.sourceDirectory   = uploadDir;
+            request.priority          = priority == "prefetch"
+                                            ? services::LoadJobPriority::Prefetch
+                                            : services::LoadJobPriority::Interactive;
+
+            const auto jobId = jobs->submit(std::move(request));
+            if (!jobId) {
+                res.code = 429;
+                res.body = R"({"error":"queue_full","message":"Too many pending study loads"})";
+                res.end();
+                return;
+            }
+
             sessions->touchSession(sessionId);
 
             const auto& ctx = app->get_context<JwtMiddleware>(req);
@@ -218,18 +268,63 @@ void registerStudyRoutes(routes::App* app,
                 audit->auditSecurityAlert(ctx.userId, "study_loaded:" + studyUid
                                           + " session:" + sessionId);
             }
-            spdlog::info("[study] Load: session='{}' study='{}' user='{}'",
-                         sessionId, studyUid, ctx.userId);
+            spdlog::info("[study] Load queued: job='{}' session='{}' study='{}' user='{}'",
+                         *jobId, sessionId, studyUid, ctx.userId);
 
             json resp;
+            resp["jobId"]     = *jobId;
             resp["sessionId"] = sessionId;
             resp["studyUid"]  = studyUid;
-            resp["status"]    = "loading";
+            resp["status"]    = "queued";
+            resp["pollUrl"]   = "/api/v1/load-jobs/" + *jobId;
 
             res.code = 202;
             res.body = resp.dump();
             res.end();
         });
+
+    // GET /api/v1/load-jobs/{id} — Query study load progress (Viewer+)
+    CROW_ROUTE((*app), "/api/v1/load-jobs/<string>")
+        .methods(crow::HTTPMethod::Get)(
+        [app, jobs, corsOrigin]
+        (const crow::request& req, crow::response& res, const std::string& jobId) {
+            if (!requireRole(*app, req, res, services::Role::Viewer, corsOrigin)) return;
+            addCorsHeaders(res, corsOrigin);
+
+            const auto status = jobs ? jobs->status(jobId) : std::nullopt;
+            if (!status) {
+                res.code = 404;
+                res.body = R"({"error":"not_found","message":"Load job not found"})";
+                res.end();
+                return;
+            }
+
+            res.code = 200;
+            res.body = loadJobToJson(*status).dump();
+            res.end();
+        });
+
+    // DELETE /api/v1/load-jobs/{id} — Cancel a pending or running study load (Clinician+)
+    CROW_ROUTE((*app), "/api/v1/load-jobs/<string>")
+        .methods(crow::HTTPMethod::Delete)(
+        [app, jobs, corsOrigin]
+        (const crow::request& req, crow::response& res, const std::string& jobId) {
+            if (!requireRole(*app, req, res, services::Role::Clinician, corsOrigin)) return;
+            addCorsHeaders(res, corsOrigin);
+
+            if (!jobs || !jobs->cancel(jobId)) {
+                res.code = 404;
+                res.body = R"({"error":"not_found","message":"Load job not found or already finished"})";
+                res.end();
+                return;
+            }
+
+            const auto& ctx = app->get_context<JwtMiddleware>(req);
+            spdlog::info("[study] Load cancelled: job='{}' by user='{}'", jobId, ctx.userId);
+
+            res.code = 204;
+            res.end();
+        });
 }
 
 } // namespace dicom_viewer::server
@@ -32,7 +32,8 @@
  * @brief DICOM study upload and listing REST API routes
  * @details Registers routes for DICOM file upload with magic-byte validation,
  *          study listing, and series listing for a given study UID.
- *          Study-load-into-session is also registered here.
+ *          Study-load-into-session is also registered here; loads run
+ *          on a StudyLoadJobQueue and report progress through load jobs.
  *
  * ## Routes
  * | Method | Path                                    | Min Role  |
@@ -41,6 +42,8 @@
  * | GET    | /api/v1/studies                         | Viewer    |
  * | GET    | /api/v1/studies/{uid}/series            | Viewer    |
  * | POST   | /api/v1/sessions/{id}/load              | Clinician |
+ * | GET    | /api/v1/load-jobs/{id}                  | Viewer    |
+ * | DELETE | /api/v1/load-jobs/{id}                  | Clinician |
  *
  * @author kcenon
  * @since 1.0.0
@@ -54,6 +57,7 @@
 
 namespace dicom_viewer::services {
 class RenderSessionManager;
+class StudyLoadJobQueue;
 class AuditService;
 } // namespace dicom_viewer::services
 
@@ -63,12 +67,14 @@ namespace dicom_viewer::server {
  * @brief Register DICOM study management routes on the Crow application.
  * @param app        Crow application with JwtMiddleware (non-owning)
  * @param sessions   RenderSessionManager for session-load endpoint (may be nullptr)
+ * @param jobs       StudyLoadJobQueue running session loads (may be nullptr)
  * @param audit      AuditService for ePHI event logging (may be nullptr)
- * @param uploadDir  Local directory for incoming DICOM uploads
+ * @param uploadDir  Local directory for incoming DICOM uploads (also scanned by loads)
  * @param corsOrigin CORS allowed-origin header value
  */
 void registerStudyRoutes(routes::App* app,
                          services::RenderSessionManager* sessions,
+                         services::StudyLoadJobQueue* jobs,
                          services::AuditService* audit,
                          const std::string& uploadDir,
                          const std::string& corsOrigin);
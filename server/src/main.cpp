@@ -48,10 +48,11 @@
 
 #include "services/render/render_session_manager.hpp"
 #include "services/render/websocket_frame_streamer.hpp"
-#include "services/render/frame_encoder.hpp"
+#include "services/render/frame_pipeline.hpp"
 #include "services/render/input_event_dispatcher.hpp"
 #include "services/render/offscreen_render_context.hpp"
 #include "services/render/session_token_validator.hpp"
+#include "services/render/study_load_job_queue.hpp"
 #include "services/audit_service.hpp"
 #include "services/config/deployment_config.hpp"
 #include "services/store/session_store.hpp"
@@ -62,6 +63,7 @@
 #include "services/store/postgres_audit_sink.hpp"
 #endif
 
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
@@ -311,8 +313,8 @@ int main(int argc, char* argv[]) {
     }
 #endif
 
-    // Frame encoder
-    auto frameEncoder = std::make_unique<dicom_viewer::services::FrameEncoder>();
+    // Frame pipeline: encodes and sends off the render workers
+    auto framePipeline = std::make_unique<dicom_viewer::services::FramePipeline>();
 
     // Input event dispatcher
     auto inputDispatcher = std::make_unique<dicom_viewer::services::InputEventDispatcher>();
@@ -352,19 +354,22 @@ int main(int argc, char* argv[]) {
     wsStreamer->setAuditService(auditService.get());
 
     // 4. Wire frame callback pipeline:
-    //    RenderSessionManager → FrameEncoder → WebSocketFrameStreamer
+    //    RenderSessionManager → FramePipeline (encode → send) → WebSocketFrameStreamer
+    //    The render worker only hands the frame over, so rendering the next
+    //    frame overlaps with encoding and sending the previous ones
+    framePipeline->setSendCallback(
+        [&wsStreamer](const std::string& sessionId,
+                      const std::vector<uint8_t>& encoded,
+                      uint32_t width, uint32_t height, uint32_t frameSeq) {
+            wsStreamer->pushFrame(sessionId, encoded, width, height, frameSeq);
+        });
     sessionManager->setFrameReadyCallback(
-        [&wsStreamer, &frameEncoder, frameSeq = uint32_t{0}]
+        [&wsStreamer, &framePipeline]
         (const std::string& sessionId,
-         const std::vector<uint8_t>& rgbaFrame,
-         uint32_t width, uint32_t height) mutable {
+         std::vector<uint8_t>&& rgbaFrame,
+         uint32_t width, uint32_t height) {
             if (!wsStreamer->hasClients(sessionId)) return;
-            const auto encoded = frameEncoder->encode(
-                rgbaFrame.data(), width, height,
-                dicom_viewer::services::EncodeFormat::Jpeg, 85);
-            if (!encoded.empty()) {
-                wsStreamer->pushFrame(sessionId, encoded, width, height, ++frameSeq);
-            }
+            framePipeline->submit(sessionId, std::move(rgbaFrame), width, height);
         });
 
     // 5. Wire input callback pipeline:
@@ -380,11 +385,33 @@ int main(int argc, char* argv[]) {
             }
         });
 
+    // Background study loads: progress is pushed to the session's WebSocket
+    // clients, and destroying a session cancels its pending loads
+    auto loadJobs = std::make_unique<dicom_viewer::services::StudyLoadJobQueue>(*sessionManager);
+    loadJobs->setProgressCallback(
+        [&wsStreamer](const dicom_viewer::services::LoadJobStatus& status) {
+            if (!wsStreamer->hasClients(status.sessionId)) return;
+            nlohmann::json msg;
+            msg["type"]     = "load_progress";
+            msg["jobId"]    = status.jobId;
+            msg["state"]    = dicom_viewer::services::toString(status.state);
+            msg["progress"] = status.progress;
+            msg["message"]  = status.message;
+            wsStreamer->pushText(status.sessionId, msg.dump());
+        });
+    sessionManager->setSessionDestroyedCallback(
+        [&loadJobs, &framePipeline](const std::string& sessionId) {
+            loadJobs->cancelSession(sessionId);
+            framePipeline->removeSession(sessionId);
+        });
+
     // 6. REST API server
     dicom_viewer::server::ApiServerConfig apiCfg;
     apiCfg.port = args.restPort;
     auto apiServer = std::make_unique<dicom_viewer::server::ApiServer>(apiCfg);
     apiServer->setServices(sessionManager.get(), tokenValidator.get(), auditService.get());
+    apiServer->setLoadJobQueue(loadJobs.get());
+    apiServer->setFramePipeline(framePipeline.get());
 
     if (!apiServer->start()) {
         spdlog::error("Failed to start REST API server on port {}", args.restPort);
@@ -420,7 +447,10 @@ int main(int argc, char* argv[]) {
     // 10. Graceful shutdown
     spdlog::info("Shutdown signal received — stopping services");
 
+    loadJobs->stop();
+    sessionManager->setSessionDestroyedCallback(nullptr);
     sessionManager->stopRenderLoop();
+    framePipeline->stop();
     wsStreamer->stop();
     apiServer->stop();
 
@@ -28,17 +28,28 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "core/dicom_loader.hpp"
+#include "core/parallel_for.hpp"
 #include "core/transfer_syntax_decoder.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <cstring>
 #include <format>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
 
 #include <kcenon/common/logging/log_macros.h>
 
+#include <gdcmImage.h>
+#include <gdcmImageReader.h>
+#include <gdcmPixelFormat.h>
 #include <gdcmReader.h>
+#include <gdcmStringFilter.h>
 #include <gdcmTag.h>
 
 #include <itkGDCMImageIO.h>
@@ -52,10 +63,30 @@ namespace dicom_viewer::core {
 class DicomLoader::Impl {
 public:
     itk::GDCMImageIO::Pointer gdcmIO;
+    ProgressCallback progressCallback;
+    size_t decodeThreadCount = 0;
 
     Impl()
         : gdcmIO(itk::GDCMImageIO::New())
     {}
+
+    /// Decode all slices in parallel into one preallocated ITK volume
+    template <typename TImage>
+    typename TImage::Pointer decodeSeries(const std::vector<SliceInfo>& slices,
+                                          const DicomFileHeader& firstHeader,
+                                          const DecodedSliceSource<TImage>* reuse);
+
+    /// Fallback: decode slices sequentially through itk::ImageSeriesReader
+    template <typename TImage>
+    typename TImage::Pointer readWithSeriesReader(const std::vector<SliceInfo>& slices);
+
+    /// Header-only scan: parse every file up to Pixel Data on a worker pool
+    std::map<std::string, std::vector<SliceInfo>>
+    scanHeaders(const std::filesystem::path& directoryPath, size_t threadCount);
+
+    /// Legacy scan: group with GDCMSeriesFileNames and decode each slice
+    std::map<std::string, std::vector<SliceInfo>>
+    scanWithSeriesReader(const std::filesystem::path& directoryPath);
 };
 
 DicomLoader::DicomLoader() : impl_(std::make_unique<Impl>()) {}
@@ -65,6 +96,16 @@ DicomLoader::~DicomLoader() = default;
 DicomLoader::DicomLoader(DicomLoader&&) noexcept = default;
 DicomLoader& DicomLoader::operator=(DicomLoader&&) noexcept = default;
 
+void DicomLoader::setProgressCallback(ProgressCallback callback)
+{
+    impl_->progressCallback = std::move(callback);
+}
+
+void DicomLoader::setDecodeThreadCount(size_t threadCount)
+{
+    impl_->decodeThreadCount = threadCount;
+}
+
 std::expected<DicomMetadata, DicomErrorInfo>
 DicomLoader::loadFile(const std::filesystem::path& filePath)
 {
@@ -230,10 +271,264 @@ SliceInfo extractSliceInfo(const std::filesystem::path& filePath,
     return info;
 }
 
+/// Trim whitespace and NUL padding from a DICOM string value
+std::string trimValue(const std::string& value)
+{
+    size_t start = value.find_first_not_of(std::string(" \t\r\n\0", 5));
+    size_t end = value.find_last_not_of(std::string(" \t\r\n\0", 5));
+    if (start != std::string::npos && end != std::string::npos) {
+        return value.substr(start, end - start + 1);
+    }
+    return "";
+}
+
+/// Build the series grouping key the same way GDCMSeriesFileNames does with
+/// SetUseSeriesDetails(true): Series Instance UID followed by Series Number,
+/// Sequence Name, Slice Thickness, Rows and Columns, reduced to [A-Za-z0-9.]
+std::string makeSeriesKey(const std::string& seriesUid,
+                          const std::vector<std::string>& details)
+{
+    std::string key = seriesUid;
+    for (const auto& value : details) {
+        if (key == seriesUid && !value.empty()) {
+            key += ".";
+        }
+        key += value;
+    }
+    std::erase_if(key, [](char c) {
+        return c != '.' && !std::isalnum(static_cast<unsigned char>(c));
+    });
+    return key;
+}
+
 } // anonymous namespace
 
+std::expected<DicomFileHeader, DicomErrorInfo>
+DicomLoader::readHeader(const std::filesystem::path& filePath)
+{
+    const gdcm::Tag pixelDataTag{0x7FE0, 0x0010};
+
+    gdcm::Reader reader;
+    reader.SetFileName(filePath.string().c_str());
+
+    bool parsed = false;
+    try {
+        parsed = reader.ReadUpToTag(pixelDataTag);
+    } catch (const std::exception&) {
+        parsed = false;
+    }
+    if (!parsed) {
+        return std::unexpected(DicomErrorInfo{
+            DicomError::InvalidDicomFormat,
+            "Failed to parse DICOM header: " + filePath.string()
+        });
+    }
+
+    const auto& file = reader.GetFile();
+    const auto& ds = file.GetDataSet();
+
+    gdcm::StringFilter filter;
+    filter.SetFile(file);
+
+    auto getString = [&](uint16_t group, uint16_t element) -> std::string {
+        const gdcm::Tag tag{group, element};
+        if (!ds.FindDataElement(tag) || ds.GetDataElement(tag).IsEmpty()) {
+            return "";
+        }
+        return trimValue(filter.ToString(tag));
+    };
+
+    auto getInt = [&](uint16_t group, uint16_t element, int fallback) -> int {
+        std::string value = getString(group, element);
+        if (value.empty()) {
+            return fallback;
+        }
+        try {
+            return std::stoi(value);
+        } catch (...) {
+            return fallback;
+        }
+    };
+
+    auto getDouble = [&](uint16_t group, uint16_t element, double fallback) -> double {
+        auto values = parseMultiValueDouble(getString(group, element));
+        return values.empty() ? fallback : values.front();
+    };
+
+    DicomFileHeader header;
+    auto& meta = header.metadata;
+
+    meta.seriesInstanceUid = getString(0x0020, 0x000E);
+    const std::string rowsStr = getString(0x0028, 0x0010);
+    const std::string columnsStr = getString(0x0028, 0x0011);
+    if (meta.seriesInstanceUid.empty() || rowsStr.empty() || columnsStr.empty()) {
+        return std::unexpected(DicomErrorInfo{
+            DicomError::MetadataExtractionFailed,
+            "Not a DICOM image: " + filePath.string()
+        });
+    }
+
+    meta.patientName = getString(0x0010, 0x0010);
+    meta.patientId = getString(0x0010, 0x0020);
+    meta.patientBirthDate = getString(0x0010, 0x0030);
+    meta.patientSex = getString(0x0010, 0x0040);
+
+    meta.studyInstanceUid = getString(0x0020, 0x000D);
+    meta.studyDate = getString(0x0008, 0x0020);
+    meta.studyTime = getString(0x0008, 0x0030);
+    meta.studyDescription = getString(0x0008, 0x1030);
+    meta.accessionNumber = getString(0x0008, 0x0050);
+
+    meta.seriesNumber = getString(0x0020, 0x0011);
+    meta.seriesDescription = getString(0x0008, 0x103E);
+    meta.modality = getString(0x0008, 0x0060);
+
+    meta.rows = getInt(0x0028, 0x0010, 0);
+    meta.columns = getInt(0x0028, 0x0011, 0);
+    meta.bitsAllocated = getInt(0x0028, 0x0100, 0);
+    meta.bitsStored = getInt(0x0028, 0x0101, meta.bitsAllocated);
+
+    // Pixel Spacing (0028,0030) is row spacing \ column spacing
+    auto spacing = parseMultiValueDouble(getString(0x0028, 0x0030));
+    if (spacing.size() >= 2) {
+        meta.pixelSpacingY = spacing[0];
+        meta.pixelSpacingX = spacing[1];
+    }
+    meta.sliceThickness = getDouble(0x0018, 0x0050, 1.0);
+    meta.rescaleSlope = getDouble(0x0028, 0x1053, 1.0);
+    meta.rescaleIntercept = getDouble(0x0028, 0x1052, 0.0);
+
+    // Private creator blocks are not in the public dictionary, so vendor
+    // tags are taken verbatim from their byte values
+    auto getPrivateString = [&](uint16_t group, uint16_t element) -> std::string {
+        const gdcm::Tag tag{group, element};
+        if (!ds.FindDataElement(tag)) {
+            return "";
+        }
+        const auto* bytes = ds.GetDataElement(tag).GetByteValue();
+        if (bytes == nullptr || bytes->GetLength() == 0) {
+            return "";
+        }
+        return trimValue(std::string(bytes->GetPointer(), bytes->GetLength()));
+    };
+
+    meta.imageType = getString(0x0008, 0x0008);
+    meta.scanningSequence = getString(0x0018, 0x0020);
+    meta.phaseContrast = getString(0x0018, 0x9014);
+    meta.velocityEncoding = getString(0x0018, 0x9197);
+    meta.numberOfFrames = getString(0x0028, 0x0008);
+    meta.siemensFlowDirection = getPrivateString(0x0051, 0x1014);
+    meta.philipsVelocityEncoding = getPrivateString(0x2001, 0x101A);
+    meta.geVelocityEncoding = getPrivateString(0x0019, 0x10CC);
+    meta.hasAcquisitionAttributes = true;
+
+    auto& slice = header.slice;
+    slice.filePath = filePath;
+
+    auto positionValues = parseMultiValueDouble(getString(0x0020, 0x0032));
+    if (positionValues.size() >= 3) {
+        slice.imagePosition = {positionValues[0], positionValues[1], positionValues[2]};
+    }
+
+    auto orientationValues = parseMultiValueDouble(getString(0x0020, 0x0037));
+    if (orientationValues.size() >= 6) {
+        for (size_t i = 0; i < 6; ++i) {
+            slice.imageOrientation[i] = orientationValues[i];
+        }
+    }
+
+    slice.sliceLocation = getDouble(0x0020, 0x1041, 0.0);
+    slice.instanceNumber = getInt(0x0020, 0x0013, 0);
+
+    header.seriesKey = makeSeriesKey(meta.seriesInstanceUid, {
+        meta.seriesNumber,
+        getString(0x0018, 0x0024),  // Sequence Name
+        getString(0x0018, 0x0050),  // Slice Thickness
+        rowsStr,
+        columnsStr
+    });
+
+    return header;
+}
+
+std::map<std::string, std::vector<SliceInfo>>
+DicomLoader::Impl::scanHeaders(const std::filesystem::path& directoryPath,
+                               size_t threadCount)
+{
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directoryPath)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    const size_t workers = resolveThreadCount(threadCount, files.size());
+    LOG_DEBUG(std::format("Header scan: {} files on {} threads", files.size(), workers));
+
+    std::vector<std::optional<DicomFileHeader>> headers(files.size());
+    parallelFor(files.size(), workers, [&](size_t i) {
+        auto result = DicomLoader::readHeader(files[i]);
+        if (result) {
+            headers[i] = std::move(*result);
+        }
+    });
+
+    std::map<std::string, std::vector<SliceInfo>> seriesMap;
+    for (auto& header : headers) {
+        if (header) {
+            seriesMap[header->seriesKey].push_back(std::move(header->slice));
+        }
+    }
+
+    for (auto& [uid, slices] : seriesMap) {
+        DicomLoader::sortSlices(slices);
+        LOG_DEBUG(std::format("Series {}: {} slices", uid.substr(0, 20), slices.size()));
+    }
+    return seriesMap;
+}
+
+std::map<std::string, std::vector<SliceInfo>>
+DicomLoader::Impl::scanWithSeriesReader(const std::filesystem::path& directoryPath)
+{
+    using NamesGeneratorType = itk::GDCMSeriesFileNames;
+    auto namesGenerator = NamesGeneratorType::New();
+    namesGenerator->SetUseSeriesDetails(true);
+    namesGenerator->SetRecursive(false);
+    namesGenerator->SetDirectory(directoryPath.string());
+
+    std::map<std::string, std::vector<SliceInfo>> seriesMap;
+
+    const auto& seriesUIDs = namesGenerator->GetSeriesUIDs();
+    LOG_DEBUG(std::format("Found {} series in directory", seriesUIDs.size()));
+
+    for (const auto& uid : seriesUIDs) {
+        const auto& fileNames = namesGenerator->GetFileNames(uid);
+        std::vector<SliceInfo> slices;
+        slices.reserve(fileNames.size());
+
+        for (const auto& fileName : fileNames) {
+            auto gdcmIO = itk::GDCMImageIO::New();
+            SliceInfo info = extractSliceInfo(fileName, gdcmIO);
+            slices.push_back(std::move(info));
+        }
+
+        DicomLoader::sortSlices(slices);
+        LOG_DEBUG(std::format("Series {}: {} slices", uid.substr(0, 20), slices.size()));
+        seriesMap[uid] = std::move(slices);
+    }
+    return seriesMap;
+}
+
 std::expected<std::map<std::string, std::vector<SliceInfo>>, DicomErrorInfo>
 DicomLoader::scanDirectory(const std::filesystem::path& directoryPath)
+{
+    return scanDirectory(directoryPath, ScanOptions{});
+}
+
+std::expected<std::map<std::string, std::vector<SliceInfo>>, DicomErrorInfo>
+DicomLoader::scanDirectory(const std::filesystem::path& directoryPath,
+                           const ScanOptions& options)
 {
     LOG_INFO(std::format("Scanning directory: {}", directoryPath.string()));
 
@@ -247,32 +542,9 @@ DicomLoader::scanDirectory(const std::filesystem::path& directoryPath)
     }
 
     try {
-        using NamesGeneratorType = itk::GDCMSeriesFileNames;
-        auto namesGenerator = NamesGeneratorType::New();
-        namesGenerator->SetUseSeriesDetails(true);
-        namesGenerator->SetRecursive(false);
-        namesGenerator->SetDirectory(directoryPath.string());
-
-        std::map<std::string, std::vector<SliceInfo>> seriesMap;
-
-        const auto& seriesUIDs = namesGenerator->GetSeriesUIDs();
-        LOG_DEBUG(std::format("Found {} series in directory", seriesUIDs.size()));
-
-        for (const auto& uid : seriesUIDs) {
-            const auto& fileNames = namesGenerator->GetFileNames(uid);
-            std::vector<SliceInfo> slices;
-            slices.reserve(fileNames.size());
-
-            for (const auto& fileName : fileNames) {
-                auto gdcmIO = itk::GDCMImageIO::New();
-                SliceInfo info = extractSliceInfo(fileName, gdcmIO);
-                slices.push_back(std::move(info));
-            }
-
-            sortSlices(slices);
-            seriesMap[uid] = std::move(slices);
-            LOG_DEBUG(std::format("Series {}: {} slices", uid.substr(0, 20), slices.size()));
-        }
+        auto seriesMap = options.headerOnly
+            ? impl_->scanHeaders(directoryPath, options.threadCount)
+            : impl_->scanWithSeriesReader(directoryPath);
 
         LOG_INFO(std::format("Directory scan complete: {} series found", seriesMap.size()));
         return seriesMap;
@@ -286,92 +558,312 @@ DicomLoader::scanDirectory(const std::filesystem::path& directoryPath)
     }
 }
 
-std::expected<CTImageType::Pointer, DicomErrorInfo>
-DicomLoader::loadCTSeries(const std::vector<SliceInfo>& slices)
+namespace {
+
+/// Slice layout the direct decode path cannot handle (e.g. RGB, multi-frame);
+/// the caller falls back to itk::ImageSeriesReader
+class UnsupportedSliceLayout : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Convert stored pixel values to the output type, applying the modality
+/// rescale. @p src may alias @p dst when both types have the same size:
+/// each element is read before the same index is written.
+template <typename TStored, typename TPixel>
+void convertPixels(const char* src, TPixel* dst, size_t count,
+                   double slope, double intercept)
 {
-    LOG_INFO(std::format("Loading CT series with {} slices", slices.size()));
+    constexpr double lo = static_cast<double>(std::numeric_limits<TPixel>::lowest());
+    constexpr double hi = static_cast<double>(std::numeric_limits<TPixel>::max());
+    const bool identity = slope == 1.0 && intercept == 0.0;
 
-    if (slices.empty()) {
-        LOG_ERROR("No slices provided for CT series");
-        return std::unexpected(DicomErrorInfo{
-            DicomError::SeriesAssemblyFailed,
-            "No slices provided"
-        });
+    if constexpr (std::is_same_v<TStored, TPixel>) {
+        if (identity && static_cast<const void*>(src) == static_cast<const void*>(dst)) {
+            return;
+        }
     }
 
-    try {
-        std::vector<std::string> fileNames;
-        fileNames.reserve(slices.size());
-        for (const auto& slice : slices) {
-            fileNames.push_back(slice.filePath.string());
+    for (size_t i = 0; i < count; ++i) {
+        TStored stored;
+        std::memcpy(&stored, src + i * sizeof(TStored), sizeof(TStored));
+        double value = identity
+            ? static_cast<double>(stored)
+            : std::nearbyint(static_cast<double>(stored) * slope + intercept);
+        dst[i] = static_cast<TPixel>(std::clamp(value, lo, hi));
+    }
+}
+
+/// Decode one single-frame slice straight into @p dest (rows x columns).
+/// @p scratch is a per-worker buffer used only when the stored pixel size
+/// differs from the output pixel size.
+template <typename TPixel>
+void decodeSliceInto(const std::filesystem::path& path, TPixel* dest,
+                     size_t columns, size_t rows, std::vector<char>& scratch)
+{
+    gdcm::ImageReader reader;
+    reader.SetFileName(path.string().c_str());
+    if (!reader.Read()) {
+        throw std::runtime_error("Failed to read slice: " + path.string());
+    }
+
+    const gdcm::Image& image = reader.GetImage();
+    const unsigned int* dims = image.GetDimensions();
+    if (dims[0] != columns || dims[1] != rows) {
+        throw std::runtime_error(std::format(
+            "Slice {} is {}x{}, expected {}x{}",
+            path.filename().string(), dims[0], dims[1], columns, rows));
+    }
+
+    const gdcm::PixelFormat& pf = image.GetPixelFormat();
+    const size_t pixelCount = columns * rows;
+    const size_t length = image.GetBufferLength();
+    if (pf.GetSamplesPerPixel() != 1 || length != pixelCount * pf.GetPixelSize()) {
+        throw UnsupportedSliceLayout("Unsupported slice layout: " + path.string());
+    }
+
+    char* target = reinterpret_cast<char*>(dest);
+    if (pf.GetPixelSize() != sizeof(TPixel)) {
+        scratch.resize(length);
+        target = scratch.data();
+    }
+    if (!image.GetBuffer(target)) {
+        throw std::runtime_error("Failed to decode slice: " + path.string());
+    }
+
+    const double slope = image.GetSlope();
+    const double intercept = image.GetIntercept();
+    switch (pf.GetScalarType()) {
+        case gdcm::PixelFormat::UINT8:
+            convertPixels<uint8_t>(target, dest, pixelCount, slope, intercept);
+            break;
+        case gdcm::PixelFormat::INT8:
+            convertPixels<int8_t>(target, dest, pixelCount, slope, intercept);
+            break;
+        case gdcm::PixelFormat::UINT16:
+            convertPixels<uint16_t>(target, dest, pixelCount, slope, intercept);
+            break;
+        case gdcm::PixelFormat::INT16:
+            convertPixels<int16_t>(target, dest, pixelCount, slope, intercept);
+            break;
+        case gdcm::PixelFormat::UINT32:
+            convertPixels<uint32_t>(target, dest, pixelCount, slope, intercept);
+            break;
+        case gdcm::PixelFormat::INT32:
+            convertPixels<int32_t>(target, dest, pixelCount, slope, intercept);
+            break;
+        default:
+            throw UnsupportedSliceLayout("Unsupported pixel type: " + path.string());
+    }
+}
+
+} // anonymous namespace
+
+template <typename TImage>
+typename TImage::Pointer
+DicomLoader::Impl::decodeSeries(const std::vector<SliceInfo>& slices,
+                                const DicomFileHeader& firstHeader,
+                                const DecodedSliceSource<TImage>* reuse)
+{
+    using PixelType = typename TImage::PixelType;
+
+    const auto& meta = firstHeader.metadata;
+    const size_t columns = static_cast<size_t>(meta.columns);
+    const size_t rows = static_cast<size_t>(meta.rows);
+    const size_t depth = slices.size();
+
+    // Geometry mirrors ImageSeriesReader: origin at the first slice, z axis
+    // along the slice normal oriented from the first to the last slice
+    const auto& ori = slices.front().imageOrientation;
+    std::array<double, 3> normal = {
+        ori[1] * ori[5] - ori[2] * ori[4],
+        ori[2] * ori[3] - ori[0] * ori[5],
+        ori[0] * ori[4] - ori[1] * ori[3]
+    };
+    double spacingZ = meta.sliceThickness > 0.0 ? meta.sliceThickness : 1.0;
+    if (depth > 1) {
+        double span = DicomLoader::calculateSlicePosition(slices.back(), normal)
+                    - DicomLoader::calculateSlicePosition(slices.front(), normal);
+        if (std::abs(span) > 1e-6) {
+            spacingZ = std::abs(span) / static_cast<double>(depth - 1);
+            if (span < 0.0) {
+                for (auto& n : normal) {
+                    n = -n;
+                }
+            }
         }
+    }
 
-        using ReaderType = itk::ImageSeriesReader<CTImageType>;
-        auto reader = ReaderType::New();
-        reader->SetImageIO(impl_->gdcmIO);
-        reader->SetFileNames(fileNames);
-        reader->Update();
+    typename TImage::SizeType size;
+    size[0] = columns;
+    size[1] = rows;
+    size[2] = depth;
 
-        loadFile(slices.front().filePath);
+    typename TImage::IndexType start;
+    start.Fill(0);
 
-        auto output = reader->GetOutput();
-        auto size = output->GetLargestPossibleRegion().GetSize();
-        LOG_INFO(std::format("CT series loaded: {}x{}x{}", size[0], size[1], size[2]));
+    typename TImage::RegionType region;
+    region.SetIndex(start);
+    region.SetSize(size);
 
-        return output;
+    typename TImage::SpacingType spacing;
+    spacing[0] = meta.pixelSpacingX;
+    spacing[1] = meta.pixelSpacingY;
+    spacing[2] = spacingZ;
 
-    } catch (const itk::ExceptionObject& e) {
-        LOG_ERROR(std::format("Failed to load CT series: {}", e.what()));
-        return std::unexpected(DicomErrorInfo{
-            DicomError::SeriesAssemblyFailed,
-            std::string("Failed to load CT series: ") + e.what()
-        });
+    typename TImage::PointType origin;
+    for (unsigned int i = 0; i < 3; ++i) {
+        origin[i] = slices.front().imagePosition[i];
+    }
+
+    typename TImage::DirectionType direction;
+    for (unsigned int i = 0; i < 3; ++i) {
+        direction[i][0] = ori[i];
+        direction[i][1] = ori[i + 3];
+        direction[i][2] = normal[i];
+    }
+
+    auto image = TImage::New();
+    image->SetRegions(region);
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    image->SetDirection(direction);
+    image->Allocate();
+
+    PixelType* buffer = image->GetBufferPointer();
+    const size_t sliceSize = columns * rows;
+
+    // Validate the reuse source once; a mismatched source is ignored
+    const PixelType* reuseBuffer = nullptr;
+    size_t reuseDepth = 0;
+    if (reuse && reuse->volume && reuse->sourceIndex.size() == depth) {
+        auto reuseSize = reuse->volume->GetLargestPossibleRegion().GetSize();
+        if (reuseSize[0] == columns && reuseSize[1] == rows) {
+            reuseBuffer = reuse->volume->GetBufferPointer();
+            reuseDepth = reuseSize[2];
+        }
     }
+
+    std::mutex progressMutex;
+    size_t completed = 0;
+
+    parallelFor(depth, decodeThreadCount, [&](size_t z) {
+        PixelType* dest = buffer + z * sliceSize;
+        const std::ptrdiff_t source = reuseBuffer ? reuse->sourceIndex[z] : -1;
+        if (source >= 0 && static_cast<size_t>(source) < reuseDepth) {
+            std::memcpy(dest, reuseBuffer + static_cast<size_t>(source) * sliceSize,
+                        sliceSize * sizeof(PixelType));
+        } else {
+            thread_local std::vector<char> scratch;
+            decodeSliceInto(slices[z].filePath, dest, columns, rows, scratch);
+        }
+
+        if (progressCallback) {
+            std::lock_guard lock(progressMutex);
+            progressCallback(++completed, depth, "Decoding slices...");
+        }
+    });
+
+    return image;
 }
 
-std::expected<MRImageType::Pointer, DicomErrorInfo>
-DicomLoader::loadMRSeries(const std::vector<SliceInfo>& slices)
+template <typename TImage>
+typename TImage::Pointer
+DicomLoader::Impl::readWithSeriesReader(const std::vector<SliceInfo>& slices)
+{
+    std::vector<std::string> fileNames;
+    fileNames.reserve(slices.size());
+    for (const auto& slice : slices) {
+        fileNames.push_back(slice.filePath.string());
+    }
+
+    using ReaderType = itk::ImageSeriesReader<TImage>;
+    auto reader = ReaderType::New();
+    reader->SetImageIO(gdcmIO);
+    reader->SetFileNames(fileNames);
+    reader->Update();
+    return reader->GetOutput();
+}
+
+template <typename TImage>
+std::expected<typename TImage::Pointer, DicomErrorInfo>
+DicomLoader::loadSeries(const std::vector<SliceInfo>& slices, const char* label,
+                        const DecodedSliceSource<TImage>* reuse)
 {
-    LOG_INFO(std::format("Loading MR series with {} slices", slices.size()));
+    LOG_INFO(std::format("Loading {} series with {} slices", label, slices.size()));
 
     if (slices.empty()) {
-        LOG_ERROR("No slices provided for MR series");
+        LOG_ERROR(std::format("No slices provided for {} series", label));
         return std::unexpected(DicomErrorInfo{
             DicomError::SeriesAssemblyFailed,
             "No slices provided"
         });
     }
 
+    auto header = readHeader(slices.front().filePath);
+    if (!header) {
+        LOG_ERROR(std::format("Failed to load {} series: {}", label, header.error().message));
+        return std::unexpected(DicomErrorInfo{
+            DicomError::SeriesAssemblyFailed,
+            std::format("Failed to load {} series: {}", label, header.error().message)
+        });
+    }
+
     try {
-        std::vector<std::string> fileNames;
-        fileNames.reserve(slices.size());
-        for (const auto& slice : slices) {
-            fileNames.push_back(slice.filePath.string());
+        typename TImage::Pointer output;
+        try {
+            output = impl_->decodeSeries<TImage>(slices, *header, reuse);
+        } catch (const UnsupportedSliceLayout& e) {
+            LOG_DEBUG(std::format("{}; using ImageSeriesReader", e.what()));
+            output = impl_->readWithSeriesReader<TImage>(slices);
         }
 
-        using ReaderType = itk::ImageSeriesReader<MRImageType>;
-        auto reader = ReaderType::New();
-        reader->SetImageIO(impl_->gdcmIO);
-        reader->SetFileNames(fileNames);
-        reader->Update();
+        metadata_ = header->metadata;
 
-        loadFile(slices.front().filePath);
-
-        auto output = reader->GetOutput();
         auto size = output->GetLargestPossibleRegion().GetSize();
-        LOG_INFO(std::format("MR series loaded: {}x{}x{}", size[0], size[1], size[2]));
-
+        LOG_INFO(std::format("{} series loaded: {}x{}x{}", label, size[0], size[1], size[2]));
         return output;
 
     } catch (const itk::ExceptionObject& e) {
-        LOG_ERROR(std::format("Failed to load MR series: {}", e.what()));
+        LOG_ERROR(std::format("Failed to load {} series: {}", label, e.what()));
         return std::unexpected(DicomErrorInfo{
             DicomError::SeriesAssemblyFailed,
-            std::string("Failed to load MR series: ") + e.what()
+            std::format("Failed to load {} series: {}", label, e.what())
+        });
+    } catch (const std::bad_alloc&) {
+        LOG_ERROR(std::format("Out of memory loading {} series", label));
+        return std::unexpected(DicomErrorInfo{
+            DicomError::MemoryAllocationFailed,
+            std::format("Out of memory loading {} series", label)
+        });
+    } catch (const std::exception& e) {
+        LOG_ERROR(std::format("Failed to decode {} series: {}", label, e.what()));
+        return std::unexpected(DicomErrorInfo{
+            DicomError::DecodingFailed,
+            std::format("Failed to decode {} series: {}", label, e.what())
         });
     }
 }
 
+std::expected<CTImageType::Pointer, DicomErrorInfo>
+DicomLoader::loadCTSeries(const std::vector<SliceInfo>& slices)
+{
+    return loadSeries<CTImageType>(slices, "CT");
+}
+
+std::expected<MRImageType::Pointer, DicomErrorInfo>
+DicomLoader::loadMRSeries(const std::vector<SliceInfo>& slices)
+{
+    return loadSeries<MRImageType>(slices, "MR");
+}
+
+std::expected<CTImageType::Pointer, DicomErrorInfo>
+DicomLoader::loadCTSeries(const std::vector<SliceInfo>& slices,
+                          const DecodedSliceSource<CTImageType>& reuse)
+{
+    return loadSeries<CTImageType>(slices, "CT", &reuse);
+}
+
 void DicomLoader::sortSlices(std::vector<SliceInfo>& slices)
 {
     if (slices.empty()) {
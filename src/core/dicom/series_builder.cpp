@@ -28,12 +28,15 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "core/series_builder.hpp"
+#include "core/series_index.hpp"
+#include "core/volume_cache.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <format>
 #include <future>
 #include <numeric>
+#include <optional>
 
 #include <kcenon/common/logging/log_macros.h>
 
@@ -44,6 +47,12 @@ public:
     DicomLoader loader;
     ProgressCallback progressCallback;
     DicomMetadata lastMetadata;
+    bool scanIndexEnabled = false;
+    std::optional<VolumeCache> volumeCache;
+
+    // Current refinement pass, used to spread decode progress across passes
+    size_t pass = 0;
+    size_t passCount = 1;
 
     void reportProgress(size_t current, size_t total, const std::string& message)
     {
@@ -51,11 +60,39 @@ public:
             progressCallback(current, total, message);
         }
     }
+
+    /// Fingerprint of the series if the volume cache is enabled
+    std::optional<std::uint64_t> cacheKey(const SeriesInfo& series) const
+    {
+        return volumeCache ? VolumeCache::fingerprint(series.slices) : std::nullopt;
+    }
+
+    template <typename TImage>
+    void storeInCache(std::uint64_t key, const TImage& image)
+    {
+        auto stored = volumeCache->store(key, image, lastMetadata);
+        if (!stored) {
+            LOG_WARNING(std::format("Volume cache not updated: {}", stored.error().message));
+        }
+    }
+
+    /// Map per-slice decode progress onto the 20-100% "Loading slices" range
+    void reportSliceProgress(size_t current, size_t total, const std::string& message)
+    {
+        const size_t perPass = 80 / std::max<size_t>(passCount, 1);
+        const size_t done = 20 + pass * perPass
+                          + (perPass * current) / std::max<size_t>(total, 1);
+        reportProgress(std::min<size_t>(done, 100), 100, message);
+    }
 };
 
 SeriesBuilder::SeriesBuilder()
     : impl_(std::make_unique<Impl>())
 {
+    impl_->loader.setProgressCallback(
+        [impl = impl_.get()](size_t current, size_t total, const std::string& message) {
+            impl->reportSliceProgress(current, total, message);
+        });
 }
 
 SeriesBuilder::~SeriesBuilder() = default;
@@ -68,48 +105,86 @@ void SeriesBuilder::setProgressCallback(ProgressCallback callback)
     impl_->progressCallback = std::move(callback);
 }
 
+void SeriesBuilder::setScanIndexEnabled(bool enabled)
+{
+    impl_->scanIndexEnabled = enabled;
+}
+
+void SeriesBuilder::setVolumeCacheDirectory(const std::filesystem::path& directory)
+{
+    if (directory.empty()) {
+        impl_->volumeCache.reset();
+    } else {
+        impl_->volumeCache.emplace(directory);
+    }
+}
+
 std::expected<std::vector<SeriesInfo>, DicomErrorInfo>
 SeriesBuilder::scanForSeries(const std::filesystem::path& directoryPath)
 {
     LOG_INFO(std::format("Scanning for series in: {}", directoryPath.string()));
     impl_->reportProgress(0, 100, "Scanning directory...");
 
-    auto scanResult = impl_->loader.scanDirectory(directoryPath);
-    if (!scanResult) {
-        LOG_ERROR(std::format("Failed to scan directory: {}", scanResult.error().message));
-        return std::unexpected(scanResult.error());
+    if (!std::filesystem::exists(directoryPath) ||
+        !std::filesystem::is_directory(directoryPath)) {
+        LOG_ERROR(std::format("Directory not found: {}", directoryPath.string()));
+        return std::unexpected(DicomErrorInfo{
+            DicomError::FileNotFound,
+            "Directory not found: " + directoryPath.string()
+        });
+    }
+
+    SeriesIndex seriesIndex(directoryPath);
+    try {
+        if (impl_->scanIndexEnabled && seriesIndex.load()) {
+            LOG_DEBUG(std::format("Using series index: {}", seriesIndex.indexPath().string()));
+        }
+
+        auto stats = seriesIndex.refresh();
+        if (impl_->scanIndexEnabled && stats.changed()) {
+            if (auto saved = seriesIndex.save(); !saved) {
+                LOG_WARNING(std::format("Series index not saved: {}", saved.error().message));
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR(std::format("Failed to scan directory: {}", e.what()));
+        return std::unexpected(DicomErrorInfo{
+            DicomError::SeriesAssemblyFailed,
+            std::string("Failed to scan directory: ") + e.what()
+        });
     }
 
     std::vector<SeriesInfo> seriesInfoList;
-    const auto& seriesMap = scanResult.value();
+    const auto groups = seriesIndex.groupBySeries();
     size_t index = 0;
-    size_t total = seriesMap.size();
+    size_t total = groups.size();
 
-    for (const auto& [uid, slices] : seriesMap) {
+    for (const auto& [uid, headers] : groups) {
         impl_->reportProgress(index, total, "Processing series: " + uid.substr(0, 20) + "...");
 
         SeriesInfo info;
         info.seriesInstanceUid = uid;
-        info.slices = slices;
-        info.sliceCount = slices.size();
-
-        // Load metadata from first slice
-        if (!slices.empty()) {
-            auto metaResult = impl_->loader.loadFile(slices.front().filePath);
-            if (metaResult) {
-                info.seriesDescription = metaResult->seriesDescription;
-                info.modality = metaResult->modality;
-                info.pixelSpacingX = metaResult->pixelSpacingX;
-                info.pixelSpacingY = metaResult->pixelSpacingY;
-                info.dimensions[0] = metaResult->columns;
-                info.dimensions[1] = metaResult->rows;
-                info.dimensions[2] = slices.size();
-            }
+        info.slices.reserve(headers.size());
+        for (const auto* header : headers) {
+            info.slices.push_back(header->slice);
         }
+        DicomLoader::sortSlices(info.slices);
+        info.sliceCount = info.slices.size();
+
+        // Series metadata comes from the already-parsed header
+        const auto& meta = headers.front()->metadata;
+        info.metadata = meta;
+        info.seriesDescription = meta.seriesDescription;
+        info.modality = meta.modality;
+        info.pixelSpacingX = meta.pixelSpacingX;
+        info.pixelSpacingY = meta.pixelSpacingY;
+        info.dimensions[0] = meta.columns;
+        info.dimensions[1] = meta.rows;
+        info.dimensions[2] = info.slices.size();
 
         // Calculate slice spacing
-        if (slices.size() >= 2) {
-            info.sliceSpacing = calculateSliceSpacing(slices);
+        if (info.slices.size() >= 2) {
+            info.sliceSpacing = calculateSliceSpacing(info.slices);
         }
 
         seriesInfoList.push_back(std::move(info));
@@ -136,6 +211,16 @@ SeriesBuilder::buildCTVolume(const SeriesInfo& series)
 
     impl_->reportProgress(0, 100, "Building CT volume...");
 
+    const auto cacheKey = impl_->cacheKey(series);
+    if (cacheKey) {
+        if (auto cached = impl_->volumeCache->openCT(*cacheKey)) {
+            impl_->lastMetadata = series.metadata;
+            LOG_INFO("CT volume mapped from volume cache");
+            impl_->reportProgress(100, 100, "Volume loaded from cache");
+            return *cached;
+        }
+    }
+
     if (!validateSeriesConsistency(series.slices)) {
         LOG_WARNING("Inconsistent slice spacing detected in series");
         impl_->reportProgress(10, 100, "Warning: Inconsistent slice spacing detected");
@@ -146,6 +231,9 @@ SeriesBuilder::buildCTVolume(const SeriesInfo& series)
     auto result = impl_->loader.loadCTSeries(series.slices);
     if (result) {
         impl_->lastMetadata = impl_->loader.getMetadata();
+        if (cacheKey) {
+            impl_->storeInCache(*cacheKey, *result.value());
+        }
         LOG_INFO("CT volume built successfully");
         impl_->reportProgress(100, 100, "Volume built successfully");
     } else {
@@ -170,6 +258,16 @@ SeriesBuilder::buildMRVolume(const SeriesInfo& series)
 
     impl_->reportProgress(0, 100, "Building MR volume...");
 
+    const auto cacheKey = impl_->cacheKey(series);
+    if (cacheKey) {
+        if (auto cached = impl_->volumeCache->openMR(*cacheKey)) {
+            impl_->lastMetadata = series.metadata;
+            LOG_INFO("MR volume mapped from volume cache");
+            impl_->reportProgress(100, 100, "Volume loaded from cache");
+            return *cached;
+        }
+    }
+
     if (!validateSeriesConsistency(series.slices)) {
         LOG_WARNING("Inconsistent slice spacing detected in series");
         impl_->reportProgress(10, 100, "Warning: Inconsistent slice spacing detected");
@@ -180,6 +278,9 @@ SeriesBuilder::buildMRVolume(const SeriesInfo& series)
     auto result = impl_->loader.loadMRSeries(series.slices);
     if (result) {
         impl_->lastMetadata = impl_->loader.getMetadata();
+        if (cacheKey) {
+            impl_->storeInCache(*cacheKey, *result.value());
+        }
         LOG_INFO("MR volume built successfully");
         impl_->reportProgress(100, 100, "Volume built successfully");
     } else {
@@ -198,6 +299,100 @@ SeriesBuilder::buildCTVolumeAsync(const SeriesInfo& series)
         });
 }
 
+std::future<std::expected<CTImageType::Pointer, DicomErrorInfo>>
+SeriesBuilder::buildCTVolumeProgressive(const SeriesInfo& series,
+                                        VolumeRefinementCallback onRefinement,
+                                        ProgressiveBuildOptions options)
+{
+    return std::async(std::launch::async,
+        [this, series, onRefinement = std::move(onRefinement), options]()
+            -> std::expected<CTImageType::Pointer, DicomErrorInfo> {
+        const auto& slices = series.slices;
+        if (slices.empty()) {
+            LOG_ERROR("No slices in series");
+            return std::unexpected(DicomErrorInfo{
+                DicomError::SeriesAssemblyFailed,
+                "No slices in series"
+            });
+        }
+
+        // A cached volume is already full resolution: publish it as one pass
+        const auto cacheKey = impl_->cacheKey(series);
+        if (cacheKey) {
+            if (auto cached = impl_->volumeCache->openCT(*cacheKey)) {
+                impl_->lastMetadata = series.metadata;
+                LOG_INFO("CT volume mapped from volume cache");
+                if (onRefinement) {
+                    onRefinement(*cached, 0, 1);
+                }
+                impl_->reportProgress(100, 100, "Volume loaded from cache");
+                return *cached;
+            }
+        }
+
+        // Strides for each pass: initialStride, initialStride/2, ..., 1.
+        // Coarse passes with too few slices to form a volume are skipped.
+        std::vector<size_t> strides;
+        for (size_t stride = std::max<size_t>(options.initialStride, 1); stride > 1; stride /= 2) {
+            size_t count = (slices.size() + stride - 1) / stride;
+            if (count >= std::max<size_t>(options.minimumSlicesPerPass, 2)) {
+                strides.push_back(stride);
+            }
+        }
+        strides.push_back(1);
+
+        LOG_INFO(std::format("Progressive CT build: {} slices in {} passes",
+                             slices.size(), strides.size()));
+        impl_->reportProgress(0, 100, "Building CT volume...");
+
+        CTImageType::Pointer previous;
+        size_t previousStride = 0;
+
+        impl_->passCount = strides.size();
+        for (size_t pass = 0; pass < strides.size(); ++pass) {
+            const size_t stride = strides[pass];
+            impl_->pass = pass;
+
+            std::vector<SliceInfo> passSlices;
+            DecodedSliceSource<CTImageType> reuse;
+            reuse.volume = previous.GetPointer();
+            for (size_t z = 0; z < slices.size(); z += stride) {
+                passSlices.push_back(slices[z]);
+                reuse.sourceIndex.push_back(
+                    previous && z % previousStride == 0
+                        ? static_cast<std::ptrdiff_t>(z / previousStride)
+                        : -1);
+            }
+
+            auto result = impl_->loader.loadCTSeries(passSlices, reuse);
+            if (!result) {
+                impl_->pass = 0;
+                impl_->passCount = 1;
+                LOG_ERROR(std::format("Progressive pass {} failed: {}", pass, result.error().message));
+                return std::unexpected(result.error());
+            }
+
+            previous = result.value();
+            previousStride = stride;
+            LOG_DEBUG(std::format("Progressive pass {}/{}: stride {}, {} slices",
+                                  pass + 1, strides.size(), stride, passSlices.size()));
+            if (onRefinement) {
+                onRefinement(previous, pass, strides.size());
+            }
+        }
+
+        impl_->pass = 0;
+        impl_->passCount = 1;
+        impl_->lastMetadata = impl_->loader.getMetadata();
+        if (cacheKey) {
+            impl_->storeInCache(*cacheKey, *previous);
+        }
+        LOG_INFO("CT volume built successfully");
+        impl_->reportProgress(100, 100, "Volume built successfully");
+        return previous;
+    });
+}
+
 const DicomMetadata& SeriesBuilder::getMetadata() const
 {
     return impl_->lastMetadata;
@@ -0,0 +1,342 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "core/series_index.hpp"
+#include "core/parallel_for.hpp"
+
+#include <array>
+#include <format>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+#include <kcenon/common/logging/log_macros.h>
+
+namespace dicom_viewer::core {
+
+namespace {
+
+constexpr std::array<char, 4> kMagic = {'D', 'V', 'S', 'I'};
+
+/// Upper bound for a single serialized string; larger values mean corruption
+constexpr std::uint32_t kMaxStringLength = 1u << 16;
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& os) : os_(os) {}
+
+    template <typename T>
+    void pod(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        os_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void str(const std::string& value)
+    {
+        pod(static_cast<std::uint32_t>(value.size()));
+        os_.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+private:
+    std::ostream& os_;
+};
+
+class BinaryReader {
+public:
+    explicit BinaryReader(std::istream& is) : is_(is) {}
+
+    template <typename T>
+    void pod(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (!is_.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            ok_ = false;
+        }
+    }
+
+    void str(std::string& value)
+    {
+        std::uint32_t length = 0;
+        pod(length);
+        if (!ok_ || length > kMaxStringLength) {
+            ok_ = false;
+            return;
+        }
+        value.resize(length);
+        if (!is_.read(value.data(), length)) {
+            ok_ = false;
+        }
+    }
+
+    [[nodiscard]] bool ok() const { return ok_; }
+
+private:
+    std::istream& is_;
+    bool ok_ = true;
+};
+
+/// Serialize or deserialize every persisted field of a header.
+/// Shared by both directions so the field order cannot drift apart.
+template <typename Archive, typename Header>
+void visitHeader(Archive& ar, Header& header)
+{
+    ar.str(header.seriesKey);
+
+    auto& slice = header.slice;
+    ar.pod(slice.sliceLocation);
+    ar.pod(slice.instanceNumber);
+    ar.pod(slice.imagePosition);
+    ar.pod(slice.imageOrientation);
+
+    auto& meta = header.metadata;
+    ar.str(meta.patientName);
+    ar.str(meta.patientId);
+    ar.str(meta.patientBirthDate);
+    ar.str(meta.patientSex);
+    ar.str(meta.studyInstanceUid);
+    ar.str(meta.studyDate);
+    ar.str(meta.studyTime);
+    ar.str(meta.studyDescription);
+    ar.str(meta.accessionNumber);
+    ar.str(meta.seriesInstanceUid);
+    ar.str(meta.seriesNumber);
+    ar.str(meta.seriesDescription);
+    ar.str(meta.modality);
+    ar.pod(meta.rows);
+    ar.pod(meta.columns);
+    ar.pod(meta.bitsAllocated);
+    ar.pod(meta.bitsStored);
+    ar.pod(meta.pixelSpacingX);
+    ar.pod(meta.pixelSpacingY);
+    ar.pod(meta.sliceThickness);
+    ar.pod(meta.rescaleSlope);
+    ar.pod(meta.rescaleIntercept);
+    ar.str(meta.imageType);
+    ar.str(meta.scanningSequence);
+    ar.str(meta.phaseContrast);
+    ar.str(meta.velocityEncoding);
+    ar.str(meta.numberOfFrames);
+    ar.str(meta.siemensFlowDirection);
+    ar.str(meta.philipsVelocityEncoding);
+    ar.str(meta.geVelocityEncoding);
+    ar.pod(meta.hasAcquisitionAttributes);
+}
+
+} // anonymous namespace
+
+SeriesIndex::SeriesIndex(std::filesystem::path rootDirectory)
+    : root_(std::move(rootDirectory))
+{
+}
+
+std::filesystem::path SeriesIndex::indexPath() const
+{
+    return root_ / kIndexFileName;
+}
+
+bool SeriesIndex::load()
+{
+    entries_.clear();
+
+    std::ifstream in(indexPath(), std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    BinaryReader reader(in);
+    std::array<char, 4> magic{};
+    std::uint32_t version = 0;
+    std::uint64_t count = 0;
+    reader.pod(magic);
+    reader.pod(version);
+    reader.pod(count);
+    if (!reader.ok() || magic != kMagic || version != kFormatVersion) {
+        LOG_DEBUG(std::format("Ignoring incompatible series index: {}", indexPath().string()));
+        return false;
+    }
+
+    std::map<std::string, SeriesIndexEntry> loaded;
+    for (std::uint64_t i = 0; i < count && reader.ok(); ++i) {
+        std::string name;
+        SeriesIndexEntry entry;
+        std::uint8_t isImage = 0;
+        reader.str(name);
+        reader.pod(entry.fileSize);
+        reader.pod(entry.modifiedTime);
+        reader.pod(isImage);
+        entry.isImage = isImage != 0;
+        if (entry.isImage) {
+            visitHeader(reader, entry.header);
+            entry.header.slice.filePath = root_ / name;
+        }
+        loaded.emplace(std::move(name), std::move(entry));
+    }
+
+    if (!reader.ok()) {
+        LOG_WARNING(std::format("Discarding corrupt series index: {}", indexPath().string()));
+        return false;
+    }
+
+    entries_ = std::move(loaded);
+    LOG_DEBUG(std::format("Loaded series index with {} entries", entries_.size()));
+    return true;
+}
+
+std::expected<void, DicomErrorInfo> SeriesIndex::save() const
+{
+    auto finalPath = indexPath();
+    auto tempPath = finalPath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return std::unexpected(DicomErrorInfo{
+                DicomError::FileNotFound,
+                "Cannot write series index: " + tempPath.string()
+            });
+        }
+
+        BinaryWriter writer(out);
+        writer.pod(kMagic);
+        writer.pod(kFormatVersion);
+        writer.pod(static_cast<std::uint64_t>(entries_.size()));
+        for (const auto& [name, entry] : entries_) {
+            writer.str(name);
+            writer.pod(entry.fileSize);
+            writer.pod(entry.modifiedTime);
+            writer.pod(static_cast<std::uint8_t>(entry.isImage ? 1 : 0));
+            if (entry.isImage) {
+                visitHeader(writer, entry.header);
+            }
+        }
+
+        if (!out.flush()) {
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return std::unexpected(DicomErrorInfo{
+                DicomError::FileNotFound,
+                "Failed to write series index: " + tempPath.string()
+            });
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return std::unexpected(DicomErrorInfo{
+            DicomError::FileNotFound,
+            "Failed to replace series index: " + finalPath.string()
+        });
+    }
+    return {};
+}
+
+SeriesIndexStats SeriesIndex::refresh(size_t threadCount)
+{
+    SeriesIndexStats stats;
+    std::map<std::string, SeriesIndexEntry> current;
+    std::vector<std::pair<std::filesystem::path, SeriesIndexEntry*>> pending;
+
+    for (const auto& dirEntry : std::filesystem::directory_iterator(root_)) {
+        std::error_code ec;
+        if (!dirEntry.is_regular_file(ec)) {
+            continue;
+        }
+
+        std::string name = dirEntry.path().filename().string();
+        if (name == kIndexFileName || name == std::string(kIndexFileName) + ".tmp") {
+            continue;
+        }
+
+        const auto size = dirEntry.file_size(ec);
+        if (ec) {
+            continue;
+        }
+        const auto mtime = dirEntry.last_write_time(ec);
+        if (ec) {
+            continue;
+        }
+        const std::int64_t ticks = mtime.time_since_epoch().count();
+
+        auto cached = entries_.find(name);
+        if (cached != entries_.end()
+            && cached->second.fileSize == size
+            && cached->second.modifiedTime == ticks) {
+            current.emplace(name, std::move(cached->second));
+            ++stats.reused;
+            continue;
+        }
+
+        SeriesIndexEntry fresh;
+        fresh.fileSize = size;
+        fresh.modifiedTime = ticks;
+        auto [it, inserted] = current.emplace(std::move(name), std::move(fresh));
+        pending.emplace_back(dirEntry.path(), &it->second);
+    }
+
+    for (const auto& [name, entry] : entries_) {
+        if (!current.contains(name)) {
+            ++stats.removed;
+        }
+    }
+
+    // Map nodes are stable, so workers can fill entries in place
+    parallelFor(pending.size(), threadCount, [&](size_t i) {
+        auto& [path, entry] = pending[i];
+        auto header = DicomLoader::readHeader(path);
+        if (header) {
+            entry->isImage = true;
+            entry->header = std::move(*header);
+        }
+    });
+    stats.parsed = pending.size();
+
+    entries_ = std::move(current);
+    LOG_INFO(std::format("Series index refreshed: {} reused, {} parsed, {} removed",
+                         stats.reused, stats.parsed, stats.removed));
+    return stats;
+}
+
+std::map<std::string, std::vector<const DicomFileHeader*>>
+SeriesIndex::groupBySeries() const
+{
+    std::map<std::string, std::vector<const DicomFileHeader*>> groups;
+    for (const auto& [name, entry] : entries_) {
+        if (entry.isImage) {
+            groups[entry.header.seriesKey].push_back(&entry.header);
+        }
+    }
+    return groups;
+}
+
+} // namespace dicom_viewer::core
@@ -0,0 +1,456 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "core/volume_cache.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#include <itkImportImageContainer.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <kcenon/common/logging/log_macros.h>
+
+namespace dicom_viewer::core {
+
+namespace {
+
+constexpr std::array<char, 4> kMagic = {'D', 'V', 'V', 'C'};
+
+/// Fixed-size on-disk header; padded with zeros up to kDataOffset
+struct CacheFileHeader {
+    std::array<char, 4> magic{};
+    std::uint32_t version = 0;
+    std::uint32_t pixelType = 0;
+    std::uint32_t reserved = 0;
+    std::array<std::uint64_t, 3> size{};
+    std::array<double, 3> spacing{};
+    std::array<double, 3> origin{};
+    std::array<double, 9> direction{};
+    double rescaleSlope = 1.0;
+    double rescaleIntercept = 0.0;
+    std::uint64_t fingerprint = 0;
+    std::uint64_t dataOffset = 0;
+    std::uint64_t dataBytes = 0;
+};
+static_assert(std::is_trivially_copyable_v<CacheFileHeader>);
+static_assert(sizeof(CacheFileHeader) <= VolumeCache::kDataOffset);
+
+/// Temporary name next to @p finalPath, unique across processes sharing
+/// the cache directory and across stores within this process
+std::filesystem::path uniqueTempPath(const std::filesystem::path& finalPath)
+{
+    static std::atomic<std::uint64_t> sequence{0};
+#ifdef _WIN32
+    const auto pid = static_cast<std::uint64_t>(GetCurrentProcessId());
+#else
+    const auto pid = static_cast<std::uint64_t>(getpid());
+#endif
+    auto tempPath = finalPath;
+    tempPath += std::format(".{}.{}.tmp", pid, sequence.fetch_add(1));
+    return tempPath;
+}
+
+template <typename TPixel>
+struct PixelTraits;
+
+template <>
+struct PixelTraits<short> {
+    static constexpr std::uint32_t kType = 1;
+    static constexpr const char* kTag = "i16";
+};
+
+template <>
+struct PixelTraits<unsigned short> {
+    static constexpr std::uint32_t kType = 2;
+    static constexpr const char* kTag = "u16";
+};
+
+/// Read-only file mapped copy-on-write; unmapped on destruction
+class MappedFile {
+public:
+    static std::shared_ptr<MappedFile> open(const std::filesystem::path& path)
+    {
+        auto mapped = std::shared_ptr<MappedFile>(new MappedFile());
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+            CloseHandle(file);
+            return nullptr;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            return nullptr;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping);  // the view keeps the mapping alive
+        if (!view) {
+            return nullptr;
+        }
+        mapped->data_ = view;
+        mapped->size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        // MAP_PRIVATE: writes by consumers stay in their own pages
+        void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size),
+                            PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // the mapping stays valid after close
+        if (view == MAP_FAILED) {
+            return nullptr;
+        }
+        mapped->data_ = view;
+        mapped->size_ = static_cast<size_t>(info.st_size);
+#endif
+        return mapped;
+    }
+
+    ~MappedFile()
+    {
+        if (!data_) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        ::munmap(data_, size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] char* data() const { return static_cast<char*>(data_); }
+    [[nodiscard]] size_t size() const { return size_; }
+
+private:
+    MappedFile() = default;
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/// ITK pixel container that keeps the file mapping alive for the image
+template <typename TElement>
+class MappedPixelContainer
+    : public itk::ImportImageContainer<itk::SizeValueType, TElement> {
+public:
+    using Self = MappedPixelContainer;
+    using Superclass = itk::ImportImageContainer<itk::SizeValueType, TElement>;
+    using Pointer = itk::SmartPointer<Self>;
+    using ConstPointer = itk::SmartPointer<const Self>;
+
+    itkNewMacro(Self);
+
+    void setMapping(std::shared_ptr<MappedFile> mapping, TElement* pixels,
+                    itk::SizeValueType count)
+    {
+        // The container never frees the pointer; the mapping owns the memory
+        this->SetImportPointer(pixels, count, false);
+        mapping_ = std::move(mapping);
+    }
+
+protected:
+    MappedPixelContainer() = default;
+    ~MappedPixelContainer() override = default;
+
+private:
+    std::shared_ptr<MappedFile> mapping_;
+};
+
+/// FNV-1a, 64-bit
+class Fnv1a {
+public:
+    void bytes(const void* data, size_t length)
+    {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; ++i) {
+            hash_ ^= p[i];
+            hash_ *= 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void pod(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes(&value, sizeof(T));
+    }
+
+    [[nodiscard]] std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = 14695981039346656037ull;
+};
+
+template <typename TImage>
+std::expected<void, DicomErrorInfo>
+storeVolume(const VolumeCache& cache, std::uint64_t key, const TImage& image,
+            const DicomMetadata& metadata)
+{
+    using PixelType = typename TImage::PixelType;
+    using Traits = PixelTraits<PixelType>;
+
+    const auto region = image.GetLargestPossibleRegion();
+    if (image.GetBufferedRegion() != region || !image.GetBufferPointer()) {
+        return std::unexpected(DicomErrorInfo{
+            DicomError::SeriesAssemblyFailed,
+            "Volume cache requires a fully buffered image"
+        });
+    }
+
+    CacheFileHeader header;
+    header.magic = kMagic;
+    header.version = VolumeCache::kFormatVersion;
+    header.pixelType = Traits::kType;
+    for (unsigned i = 0; i < 3; ++i) {
+        header.size[i] = region.GetSize()[i];
+        header.spacing[i] = image.GetSpacing()[i];
+        header.origin[i] = image.GetOrigin()[i];
+        for (unsigned j = 0; j < 3; ++j) {
+            header.direction[i * 3 + j] = image.GetDirection()(i, j);
+        }
+    }
+    header.rescaleSlope = metadata.rescaleSlope;
+    header.rescaleIntercept = metadata.rescaleIntercept;
+    header.fingerprint = key;
+    header.dataOffset = VolumeCache::kDataOffset;
+    header.dataBytes = region.GetNumberOfPixels() * sizeof(PixelType);
+
+    std::error_code ec;
+    std::filesystem::create_directories(cache.cacheDirectory(), ec);
+
+    const auto finalPath = cache.cachePath(key, Traits::kTag);
+    // Concurrent stores of one key, from any thread or process, write
+    // separate files and the last rename wins
+    const auto tempPath = uniqueTempPath(finalPath);
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return std::unexpected(DicomErrorInfo{
+                DicomError::FileNotFound,
+                "Cannot write volume cache: " + tempPath.string()
+            });
+        }
+
+        std::array<char, VolumeCache::kDataOffset> page{};
+        std::memcpy(page.data(), &header, sizeof(header));
+        out.write(page.data(), static_cast<std::streamsize>(page.size()));
+        out.write(reinterpret_cast<const char*>(image.GetBufferPointer()),
+                  static_cast<std::streamsize>(header.dataBytes));
+
+        if (!out.flush()) {
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return std::unexpected(DicomErrorInfo{
+                DicomError::FileNotFound,
+                "Failed to write volume cache: " + tempPath.string()
+            });
+        }
+    }
+
+    std::filesystem::rename(tempPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return std::unexpected(DicomErrorInfo{
+            DicomError::FileNotFound,
+            "Failed to replace volume cache: " + finalPath.string()
+        });
+    }
+
+    LOG_DEBUG(std::format("Stored {} MB volume in cache: {}",
+                          header.dataBytes / (1024 * 1024), finalPath.string()));
+    return {};
+}
+
+template <typename TImage>
+std::optional<typename TImage::Pointer>
+openVolume(const VolumeCache& cache, std::uint64_t key)
+{
+    using PixelType = typename TImage::PixelType;
+    using Traits = PixelTraits<PixelType>;
+
+    const auto path = cache.cachePath(key, Traits::kTag);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) {
+        return std::nullopt;
+    }
+
+    auto mapping = MappedFile::open(path);
+    if (!mapping || mapping->size() < VolumeCache::kDataOffset) {
+        LOG_DEBUG(std::format("Unable to map volume cache: {}", path.string()));
+        return std::nullopt;
+    }
+
+    CacheFileHeader header;
+    std::memcpy(&header, mapping->data(), sizeof(header));
+
+    std::uint64_t pixelCount = 1;
+    for (auto extent : header.size) {
+        pixelCount *= extent;
+    }
+
+    if (header.magic != kMagic
+        || header.version != VolumeCache::kFormatVersion
+        || header.pixelType != Traits::kType
+        || header.fingerprint != key
+        || header.dataOffset != VolumeCache::kDataOffset
+        || pixelCount == 0
+        || header.dataBytes != pixelCount * sizeof(PixelType)
+        || mapping->size() < header.dataOffset + header.dataBytes) {
+        LOG_WARNING(std::format("Ignoring invalid volume cache: {}", path.string()));
+        return std::nullopt;
+    }
+
+    typename TImage::SizeType size;
+    typename TImage::IndexType start;
+    typename TImage::SpacingType spacing;
+    typename TImage::PointType origin;
+    typename TImage::DirectionType direction;
+    for (unsigned i = 0; i < 3; ++i) {
+        size[i] = static_cast<itk::SizeValueType>(header.size[i]);
+        start[i] = 0;
+        spacing[i] = header.spacing[i];
+        origin[i] = header.origin[i];
+        for (unsigned j = 0; j < 3; ++j) {
+            direction(i, j) = header.direction[i * 3 + j];
+        }
+    }
+
+    auto* pixels = reinterpret_cast<PixelType*>(mapping->data() + header.dataOffset);
+    auto container = MappedPixelContainer<PixelType>::New();
+    container->setMapping(std::move(mapping), pixels,
+                          static_cast<itk::SizeValueType>(pixelCount));
+
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::RegionType(start, size));
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    image->SetDirection(direction);
+    image->SetPixelContainer(container);
+
+    LOG_DEBUG(std::format("Mapped cached volume {}x{}x{}: {}",
+                          header.size[0], header.size[1], header.size[2], path.string()));
+    return image;
+}
+
+} // anonymous namespace
+
+VolumeCache::VolumeCache(std::filesystem::path cacheDirectory)
+    : directory_(std::move(cacheDirectory))
+{
+}
+
+std::optional<std::uint64_t>
+VolumeCache::fingerprint(const std::vector<SliceInfo>& slices)
+{
+    Fnv1a hash;
+    hash.pod(static_cast<std::uint64_t>(slices.size()));
+    for (const auto& slice : slices) {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(slice.filePath, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        const auto mtime = std::filesystem::last_write_time(slice.filePath, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+
+        const auto path = slice.filePath.string();
+        hash.pod(static_cast<std::uint64_t>(path.size()));
+        hash.bytes(path.data(), path.size());
+        hash.pod(static_cast<std::uint64_t>(size));
+        hash.pod(static_cast<std::int64_t>(mtime.time_since_epoch().count()));
+    }
+    return hash.value();
+}
+
+std::filesystem::path VolumeCache::cachePath(std::uint64_t key, const char* pixelTag) const
+{
+    return directory_ / std::format("{:016x}-{}{}", key, pixelTag, kFileExtension);
+}
+
+std::expected<void, DicomErrorInfo>
+VolumeCache::store(std::uint64_t key, const CTImageType& image,
+                   const DicomMetadata& metadata) const
+{
+    return storeVolume(*this, key, image, metadata);
+}
+
+std::expected<void, DicomErrorInfo>
+VolumeCache::store(std::uint64_t key, const MRImageType& image,
+                   const DicomMetadata& metadata) const
+{
+    return storeVolume(*this, key, image, metadata);
+}
+
+std::optional<CTImageType::Pointer> VolumeCache::openCT(std::uint64_t key) const
+{
+    return openVolume<CTImageType>(*this, key);
+}
+
+std::optional<MRImageType::Pointer> VolumeCache::openMR(std::uint64_t key) const
+{
+    return openVolume<MRImageType>(*this, key);
+}
+
+} // namespace dicom_viewer::core
@@ -29,16 +29,98 @@
 
 #include "core/image_converter.hpp"
 
+#include <algorithm>
+
+#include <itkImageDuplicator.h>
 #include <itkImageToVTKImageFilter.h>
+#include <itkImportImageContainer.h>
 #include <itkVTKImageToImageFilter.h>
 #include <itkImageRegionIterator.h>
 
+#include <vtkCommand.h>
+#include <vtkFloatArray.h>
+#include <vtkMatrix3x3.h>
+#include <vtkPointData.h>
+#include <vtkShortArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkUnsignedShortArray.h>
+
 namespace dicom_viewer::core {
 
-vtkSmartPointer<vtkImageData>
-ImageConverter::itkToVtk(CTImageType::Pointer itkImage)
+namespace {
+
+template <typename TPixel>
+struct VtkArrayFor;
+
+template <>
+struct VtkArrayFor<short> {
+    using Type = vtkShortArray;
+};
+
+template <>
+struct VtkArrayFor<unsigned short> {
+    using Type = vtkUnsignedShortArray;
+};
+
+template <>
+struct VtkArrayFor<float> {
+    using Type = vtkFloatArray;
+};
+
+template <>
+struct VtkArrayFor<unsigned char> {
+    using Type = vtkUnsignedCharArray;
+};
+
+/**
+ * @brief Keeps an ITK pixel container alive while a VTK array aliases it
+ *
+ * Registered as a DeleteEvent observer on the array: VTK holds a reference
+ * to its observers until the array is destroyed, which is exactly the
+ * lifetime the aliased pixels must outlive.
+ */
+template <typename TContainer>
+class PixelContainerGuard : public vtkCommand {
+public:
+    static PixelContainerGuard* New() { return new PixelContainerGuard; }
+
+    void Execute(vtkObject*, unsigned long, void*) override {}
+
+    typename TContainer::Pointer container;
+};
+
+/// ITK pixel container that aliases a VTK array and keeps it alive
+template <typename TElement>
+class VtkArrayPixelContainer
+    : public itk::ImportImageContainer<itk::SizeValueType, TElement> {
+public:
+    using Self = VtkArrayPixelContainer;
+    using Superclass = itk::ImportImageContainer<itk::SizeValueType, TElement>;
+    using Pointer = itk::SmartPointer<Self>;
+    using ConstPointer = itk::SmartPointer<const Self>;
+
+    itkNewMacro(Self);
+
+    void setArray(vtkSmartPointer<vtkDataArray> array, TElement* pixels,
+                  itk::SizeValueType count)
+    {
+        // The container never frees the pointer; the VTK array owns it
+        this->SetImportPointer(pixels, count, false);
+        array_ = std::move(array);
+    }
+
+protected:
+    VtkArrayPixelContainer() = default;
+    ~VtkArrayPixelContainer() override = default;
+
+private:
+    vtkSmartPointer<vtkDataArray> array_;
+};
+
+template <typename TImage>
+vtkSmartPointer<vtkImageData> copyToVtk(const typename TImage::Pointer& itkImage)
 {
-    using ConnectorType = itk::ImageToVTKImageFilter<CTImageType>;
+    using ConnectorType = itk::ImageToVTKImageFilter<TImage>;
     auto connector = ConnectorType::New();
     connector->SetInput(itkImage);
     connector->Update();
@@ -48,56 +130,174 @@ ImageConverter::itkToVtk(CTImageType::Pointer itkImage)
     return vtkImage;
 }
 
-vtkSmartPointer<vtkImageData>
-ImageConverter::itkToVtk(MRImageType::Pointer itkImage)
+template <typename TImage>
+vtkSmartPointer<vtkImageData> shareWithVtk(const typename TImage::Pointer& itkImage)
 {
-    using ConnectorType = itk::ImageToVTKImageFilter<MRImageType>;
-    auto connector = ConnectorType::New();
-    connector->SetInput(itkImage);
-    connector->Update();
+    using PixelType = typename TImage::PixelType;
+    using ArrayType = typename VtkArrayFor<PixelType>::Type;
+    using ContainerType = typename TImage::PixelContainer;
+
+    const auto region = itkImage->GetBufferedRegion();
+    const auto index = region.GetIndex();
+    const auto size = region.GetSize();
+    const auto spacing = itkImage->GetSpacing();
+    const auto origin = itkImage->GetOrigin();
+    const auto direction = itkImage->GetDirection();
 
     auto vtkImage = vtkSmartPointer<vtkImageData>::New();
-    vtkImage->DeepCopy(connector->GetOutput());
+    vtkImage->SetExtent(
+        static_cast<int>(index[0]), static_cast<int>(index[0] + size[0]) - 1,
+        static_cast<int>(index[1]), static_cast<int>(index[1] + size[1]) - 1,
+        static_cast<int>(index[2]), static_cast<int>(index[2] + size[2]) - 1);
+    vtkImage->SetSpacing(spacing[0], spacing[1], spacing[2]);
+    vtkImage->SetOrigin(origin[0], origin[1], origin[2]);
+    vtkImage->SetDirectionMatrix(
+        direction(0, 0), direction(0, 1), direction(0, 2),
+        direction(1, 0), direction(1, 1), direction(1, 2),
+        direction(2, 0), direction(2, 1), direction(2, 2));
+
+    auto scalars = vtkSmartPointer<ArrayType>::New();
+    scalars->SetNumberOfComponents(1);
+    // save = 1: VTK must never free memory owned by the ITK container
+    scalars->SetArray(itkImage->GetBufferPointer(),
+                      static_cast<vtkIdType>(region.GetNumberOfPixels()), 1);
+    scalars->SetName("scalars");
+
+    auto guard = vtkSmartPointer<PixelContainerGuard<ContainerType>>::Take(
+        PixelContainerGuard<ContainerType>::New());
+    guard->container = itkImage->GetPixelContainer();
+    scalars->AddObserver(vtkCommand::DeleteEvent, guard);
+
+    vtkImage->GetPointData()->SetScalars(scalars);
     return vtkImage;
 }
 
+template <typename TImage>
 vtkSmartPointer<vtkImageData>
-ImageConverter::itkToVtk(FloatImageType::Pointer itkImage)
+convertToVtk(const typename TImage::Pointer& itkImage, ImageConverter::ConversionMode mode)
 {
-    using ConnectorType = itk::ImageToVTKImageFilter<FloatImageType>;
-    auto connector = ConnectorType::New();
-    connector->SetInput(itkImage);
-    connector->Update();
-
-    auto vtkImage = vtkSmartPointer<vtkImageData>::New();
-    vtkImage->DeepCopy(connector->GetOutput());
-    return vtkImage;
+    if (mode == ImageConverter::ConversionMode::SharedBuffer
+        && itkImage && itkImage->GetBufferPointer()) {
+        return shareWithVtk<TImage>(itkImage);
+    }
+    return copyToVtk<TImage>(itkImage);
 }
 
-ImageConverter::CTImageType::Pointer
-ImageConverter::vtkToItkCT(vtkSmartPointer<vtkImageData> vtkImage)
+/// Alias the VTK scalars, or return nullptr if their layout cannot be shared
+template <typename TImage>
+typename TImage::Pointer shareWithItk(vtkImageData* vtkImage)
 {
-    using ConnectorType = itk::VTKImageToImageFilter<CTImageType>;
-    auto connector = ConnectorType::New();
-    connector->SetInput(vtkImage);
-    connector->Update();
+    using PixelType = typename TImage::PixelType;
+    using ArrayType = typename VtkArrayFor<PixelType>::Type;
 
-    auto output = CTImageType::New();
-    output->Graft(connector->GetOutput());
+    auto* scalars = ArrayType::FastDownCast(vtkImage->GetPointData()->GetScalars());
+    if (!scalars || scalars->GetNumberOfComponents() != 1) {
+        return nullptr;
+    }
+
+    int extent[6];
+    vtkImage->GetExtent(extent);
+
+    typename TImage::IndexType index;
+    typename TImage::SizeType size;
+    itk::SizeValueType pixelCount = 1;
+    for (unsigned i = 0; i < 3; ++i) {
+        index[i] = extent[2 * i];
+        size[i] = static_cast<itk::SizeValueType>(
+            std::max(0, extent[2 * i + 1] - extent[2 * i] + 1));
+        pixelCount *= size[i];
+    }
+    if (pixelCount == 0
+        || static_cast<itk::SizeValueType>(scalars->GetNumberOfTuples()) != pixelCount) {
+        return nullptr;
+    }
+
+    typename TImage::SpacingType spacing;
+    typename TImage::PointType origin;
+    typename TImage::DirectionType direction;
+    const double* vtkSpacing = vtkImage->GetSpacing();
+    const double* vtkOrigin = vtkImage->GetOrigin();
+    vtkMatrix3x3* vtkDirection = vtkImage->GetDirectionMatrix();
+    for (unsigned i = 0; i < 3; ++i) {
+        spacing[i] = vtkSpacing[i];
+        origin[i] = vtkOrigin[i];
+        for (unsigned j = 0; j < 3; ++j) {
+            direction(i, j) = vtkDirection->GetElement(static_cast<int>(i), static_cast<int>(j));
+        }
+    }
+
+    auto container = VtkArrayPixelContainer<PixelType>::New();
+    container->setArray(scalars, scalars->GetPointer(0), pixelCount);
+
+    auto output = TImage::New();
+    output->SetRegions(typename TImage::RegionType(index, size));
+    output->SetSpacing(spacing);
+    output->SetOrigin(origin);
+    output->SetDirection(direction);
+    output->SetPixelContainer(container);
     return output;
 }
 
-ImageConverter::FloatImageType::Pointer
-ImageConverter::vtkToItkFloat(vtkSmartPointer<vtkImageData> vtkImage)
+template <typename TImage>
+typename TImage::Pointer
+convertToItk(const vtkSmartPointer<vtkImageData>& vtkImage, ImageConverter::ConversionMode mode)
 {
-    using ConnectorType = itk::VTKImageToImageFilter<FloatImageType>;
+    if (mode == ImageConverter::ConversionMode::SharedBuffer && vtkImage) {
+        if (auto shared = shareWithItk<TImage>(vtkImage)) {
+            return shared;
+        }
+    }
+
+    using ConnectorType = itk::VTKImageToImageFilter<TImage>;
     auto connector = ConnectorType::New();
     connector->SetInput(vtkImage);
     connector->Update();
 
-    auto output = FloatImageType::New();
-    output->Graft(connector->GetOutput());
-    return output;
+    // The connector output aliases the VTK scalars without holding them;
+    // duplicate so the result stays valid after the VTK image is released
+    using DuplicatorType = itk::ImageDuplicator<TImage>;
+    auto duplicator = DuplicatorType::New();
+    duplicator->SetInputImage(connector->GetOutput());
+    duplicator->Update();
+    return duplicator->GetOutput();
+}
+
+} // anonymous namespace
+
+vtkSmartPointer<vtkImageData>
+ImageConverter::itkToVtk(CTImageType::Pointer itkImage, ConversionMode mode)
+{
+    return convertToVtk<CTImageType>(itkImage, mode);
+}
+
+vtkSmartPointer<vtkImageData>
+ImageConverter::itkToVtk(MRImageType::Pointer itkImage, ConversionMode mode)
+{
+    return convertToVtk<MRImageType>(itkImage, mode);
+}
+
+vtkSmartPointer<vtkImageData>
+ImageConverter::itkToVtk(FloatImageType::Pointer itkImage, ConversionMode mode)
+{
+    return convertToVtk<FloatImageType>(itkImage, mode);
+}
+
+vtkSmartPointer<vtkImageData>
+ImageConverter::itkToVtk(MaskImageType::Pointer itkImage, ConversionMode mode)
+{
+    return convertToVtk<MaskImageType>(itkImage, mode);
+}
+
+ImageConverter::CTImageType::Pointer
+ImageConverter::vtkToItkCT(vtkSmartPointer<vtkImageData> vtkImage, ConversionMode mode)
+{
+    return convertToItk<CTImageType>(vtkImage, mode);
+}
+
+ImageConverter::FloatImageType::Pointer
+ImageConverter::vtkToItkFloat(vtkSmartPointer<vtkImageData> vtkImage, ConversionMode mode)
+{
+    return convertToItk<FloatImageType>(vtkImage, mode);
 }
 
 void ImageConverter::applyHUConversion(
@@ -365,30 +365,39 @@ CardiacPhaseDetector::buildPhaseVolumes(
     LOG_INFO(std::format("Building {} phase volumes from {}",
                         result.phases.size(), seriesInfo.filePath));
 
-    std::vector<std::pair<CardiacPhaseInfo, itk::Image<short, 3>::Pointer>>
-        volumes;
-    volumes.reserve(result.phases.size());
-
+    std::vector<const CardiacPhaseInfo*> phases;
+    std::vector<std::vector<int>> frameGroups;
     for (const auto& phase : result.phases) {
         if (phase.frameIndices.empty()) {
             LOG_WARNING(std::format("Phase {} has no frames, skipping",
                                 phase.phaseIndex));
             continue;
         }
+        phases.push_back(&phase);
+        frameGroups.push_back(phase.frameIndices);
+    }
 
-        auto volumeResult = impl_->frameExtractor.assembleVolumeFromFrames(
-            seriesInfo.filePath, seriesInfo, phase.frameIndices);
+    std::vector<std::pair<CardiacPhaseInfo, itk::Image<short, 3>::Pointer>>
+        volumes;
+    if (frameGroups.empty()) {
+        LOG_INFO("Built 0 phase volumes successfully");
+        return volumes;
+    }
 
-        if (!volumeResult) {
-            return std::unexpected(CardiacError{
-                CardiacError::Code::VolumeAssemblyFailed,
-                "Failed to assemble volume for phase " +
-                    std::to_string(phase.phaseIndex) + ": " +
-                    volumeResult.error().toString()
-            });
-        }
+    // All phases share one decode of the pixel data
+    auto volumeResult = impl_->frameExtractor.assembleVolumesFromFrameGroups(
+        seriesInfo.filePath, seriesInfo, frameGroups);
+    if (!volumeResult) {
+        return std::unexpected(CardiacError{
+            CardiacError::Code::VolumeAssemblyFailed,
+            "Failed to assemble phase volumes: " +
+                volumeResult.error().toString()
+        });
+    }
 
-        volumes.emplace_back(phase, volumeResult.value());
+    volumes.reserve(phases.size());
+    for (size_t i = 0; i < phases.size(); ++i) {
+        volumes.emplace_back(*phases[i], (*volumeResult)[i]);
     }
 
     LOG_INFO(std::format("Built {} phase volumes successfully", volumes.size()));
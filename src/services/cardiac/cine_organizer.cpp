@@ -429,17 +429,15 @@ CineOrganizer::organizePhases(const EnhancedSeriesInfo& series) const {
     CineVolumeSeries result;
     result.info = info;
 
-    for (const auto& group : sortedGroups) {
-        auto volume = extractor.assembleVolumeFromFrames(
-            series.filePath, series, group);
-        if (!volume) {
-            return std::unexpected(CardiacError{
-                CardiacError::Code::VolumeAssemblyFailed,
-                "Failed to assemble volume: "
-                + volume.error().toString()});
-        }
-        result.phaseVolumes.push_back(std::move(volume.value()));
+    auto volumes = extractor.assembleVolumesFromFrameGroups(
+        series.filePath, series, sortedGroups);
+    if (!volumes) {
+        return std::unexpected(CardiacError{
+            CardiacError::Code::VolumeAssemblyFailed,
+            "Failed to assemble volume: "
+            + volumes.error().toString()});
     }
+    result.phaseVolumes = std::move(volumes.value());
 
     return result;
 }
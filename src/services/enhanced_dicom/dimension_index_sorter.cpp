@@ -29,6 +29,7 @@
 
 #include "services/enhanced_dicom/dimension_index_sorter.hpp"
 #include "services/enhanced_dicom/frame_extractor.hpp"
+#include "services/enhanced_dicom/functional_group_parser.hpp"
 #include <kcenon/common/logging/log_macros.h>
 
 #include <algorithm>
@@ -110,11 +111,37 @@ double projectOntoNormal(const std::array<double, 3>& position,
            position[2] * normal[2];
 }
 
+void logDimensions(const DimensionOrganization& org) {
+    for (size_t i = 0; i < org.dimensions.size(); ++i) {
+        const auto& dim = org.dimensions[i];
+        LOG_DEBUG(std::format(
+            "Dimension {}: pointer=0x{:08X}, group=0x{:08X}, desc={}",
+            i, dim.dimensionIndexPointer, dim.functionalGroupPointer,
+            dim.dimensionDescription));
+    }
+    LOG_INFO(std::format("Parsed {} dimensions from DimensionIndexSequence",
+                        org.dimensions.size()));
+}
+
+/// Materialize frames in the order given by a sorted permutation
+std::vector<EnhancedFrameInfo> applyOrder(
+    const std::vector<EnhancedFrameInfo>& frames,
+    const std::vector<uint32_t>& order)
+{
+    std::vector<EnhancedFrameInfo> sorted;
+    sorted.reserve(frames.size());
+    for (uint32_t position : order) {
+        sorted.push_back(frames[position]);
+    }
+    return sorted;
+}
+
 }  // anonymous namespace
 
 class DimensionIndexSorter::Impl {
 public:
     FrameExtractor frameExtractor;
+    FunctionalGroupParser groupParser;
 };
 
 DimensionIndexSorter::DimensionIndexSorter()
@@ -132,6 +159,15 @@ DimensionIndexSorter::parseDimensionIndex(const std::string& filePath)
 {
     LOG_DEBUG(std::format("Parsing DimensionIndexSequence from: {}", filePath));
 
+    // The sequence precedes the functional groups, so a header-only
+    // streaming scan finds it without touching the per-frame items
+    auto table = impl_->groupParser.scanFrameTable(filePath, 0);
+    if (table) {
+        logDimensions(table->dimensions);
+        return std::move(table->dimensions);
+    }
+    LOG_DEBUG(std::format("{}; using GDCM reader", table.error().toString()));
+
     gdcm::Reader reader;
     reader.SetFileName(filePath.c_str());
     if (!reader.Read()) {
@@ -173,16 +209,10 @@ DimensionIndexSorter::parseDimensionIndex(const std::string& filePath)
 
         if (def.dimensionIndexPointer != 0) {
             org.dimensions.push_back(std::move(def));
-            LOG_DEBUG(std::format(
-                "Dimension {}: pointer=0x{:08X}, group=0x{:08X}, desc={}",
-                i, org.dimensions.back().dimensionIndexPointer,
-                org.dimensions.back().functionalGroupPointer,
-                org.dimensions.back().dimensionDescription));
         }
     }
 
-    LOG_INFO(std::format("Parsed {} dimensions from DimensionIndexSequence",
-                        org.dimensions.size()));
+    logDimensions(org);
     return org;
 }
 
@@ -201,44 +231,41 @@ std::vector<EnhancedFrameInfo> DimensionIndexSorter::sortFrames(
         return sortFramesBySpatialPosition(frames);
     }
 
-    // Build dimension pointer list for lexicographic comparison
-    std::vector<uint32_t> dimPointers;
-    dimPointers.reserve(dimOrg.dimensions.size());
-    for (const auto& dim : dimOrg.dimensions) {
-        dimPointers.push_back(dim.dimensionIndexPointer);
+    // Precompute a flat key row per frame so the comparator reads
+    // contiguous ints instead of doing map lookups on every comparison
+    const size_t n = frames.size();
+    const size_t dimCount = dimOrg.dimensions.size();
+    std::vector<int> keys(n * dimCount, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& indices = frames[i].dimensionIndices;
+        for (size_t d = 0; d < dimCount; ++d) {
+            auto it = indices.find(dimOrg.dimensions[d].dimensionIndexPointer);
+            if (it != indices.end()) {
+                keys[i * dimCount + d] = it->second;
+            }
+        }
     }
 
-    auto sorted = frames;
-    std::sort(sorted.begin(), sorted.end(),
-        [&dimPointers](const EnhancedFrameInfo& a,
-                       const EnhancedFrameInfo& b) {
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b) {
             // Lexicographic comparison across dimension indices
-            for (uint32_t ptr : dimPointers) {
-                int valA = 0;
-                int valB = 0;
-
-                auto itA = a.dimensionIndices.find(ptr);
-                if (itA != a.dimensionIndices.end()) {
-                    valA = itA->second;
-                }
-
-                auto itB = b.dimensionIndices.find(ptr);
-                if (itB != b.dimensionIndices.end()) {
-                    valB = itB->second;
-                }
-
-                if (valA != valB) {
-                    return valA < valB;
+            const int* keyA = keys.data() + a * dimCount;
+            const int* keyB = keys.data() + b * dimCount;
+            for (size_t d = 0; d < dimCount; ++d) {
+                if (keyA[d] != keyB[d]) {
+                    return keyA[d] < keyB[d];
                 }
             }
 
             // If all dimension indices are equal, preserve original order
-            return a.frameIndex < b.frameIndex;
+            return frames[a].frameIndex < frames[b].frameIndex;
         });
 
     LOG_DEBUG(std::format("Sorted {} frames by {} dimensions",
-                         sorted.size(), dimPointers.size()));
-    return sorted;
+                         n, dimCount));
+    return applyOrder(frames, order);
 }
 
 std::vector<EnhancedFrameInfo> DimensionIndexSorter::sortFramesBySpatialPosition(
@@ -251,20 +278,24 @@ std::vector<EnhancedFrameInfo> DimensionIndexSorter::sortFramesBySpatialPosition
     // Compute slice normal from first frame's orientation
     auto normal = computeSliceNormal(frames[0].imageOrientation);
 
-    auto sorted = frames;
-    std::sort(sorted.begin(), sorted.end(),
-        [&normal](const EnhancedFrameInfo& a, const EnhancedFrameInfo& b) {
-            double projA = projectOntoNormal(a.imagePosition, normal);
-            double projB = projectOntoNormal(b.imagePosition, normal);
-            if (std::abs(projA - projB) > 1e-6) {
-                return projA < projB;
+    std::vector<double> projections(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        projections[i] = projectOntoNormal(frames[i].imagePosition, normal);
+    }
+
+    std::vector<uint32_t> order(frames.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b) {
+            if (std::abs(projections[a] - projections[b]) > 1e-6) {
+                return projections[a] < projections[b];
             }
-            return a.frameIndex < b.frameIndex;
+            return frames[a].frameIndex < frames[b].frameIndex;
         });
 
     LOG_DEBUG(std::format("Sorted {} frames by spatial position",
-                         sorted.size()));
-    return sorted;
+                         frames.size()));
+    return applyOrder(frames, order);
 }
 
 std::map<int, std::vector<EnhancedFrameInfo>>
@@ -327,19 +358,22 @@ DimensionIndexSorter::reconstructVolumes(
         return result;
     }
 
-    // Multi-dimensional: group by outermost dimension, assemble each group
+    // Multi-dimensional: group by outermost dimension, then assemble every
+    // group from a single decode of the pixel data
     uint32_t outerDimPointer = dimOrg.dimensions[0].dimensionIndexPointer;
     auto groups = groupByDimension(sortedFrames, outerDimPointer);
 
-    std::map<int, itk::Image<short, 3>::Pointer> result;
+    DimensionOrganization innerOrg;
+    for (size_t i = 1; i < dimOrg.dimensions.size(); ++i) {
+        innerOrg.dimensions.push_back(dimOrg.dimensions[i]);
+    }
 
+    std::vector<int> groupValues;
+    std::vector<std::vector<int>> frameGroups;
+    groupValues.reserve(groups.size());
+    frameGroups.reserve(groups.size());
     for (auto& [groupValue, groupFrames] : groups) {
         // Sort within-group frames spatially (innermost dimensions)
-        DimensionOrganization innerOrg;
-        for (size_t i = 1; i < dimOrg.dimensions.size(); ++i) {
-            innerOrg.dimensions.push_back(dimOrg.dimensions[i]);
-        }
-
         auto sortedGroup = sortFrames(groupFrames, innerOrg);
 
         std::vector<int> indices;
@@ -347,19 +381,23 @@ DimensionIndexSorter::reconstructVolumes(
         for (const auto& frame : sortedGroup) {
             indices.push_back(frame.frameIndex);
         }
+        groupValues.push_back(groupValue);
+        frameGroups.push_back(std::move(indices));
+    }
 
-        auto volumeResult = impl_->frameExtractor.assembleVolumeFromFrames(
-            info.filePath, info, indices);
-        if (!volumeResult) {
-            LOG_ERROR(std::format(
-                "Failed to assemble volume for dimension group {}: {}",
-                groupValue, volumeResult.error().toString()));
-            return std::unexpected(volumeResult.error());
-        }
+    auto volumes = impl_->frameExtractor.assembleVolumesFromFrameGroups(
+        info.filePath, info, frameGroups);
+    if (!volumes) {
+        LOG_ERROR(std::format("Failed to assemble dimension group volumes: {}",
+                             volumes.error().toString()));
+        return std::unexpected(volumes.error());
+    }
 
-        result[groupValue] = volumeResult.value();
+    std::map<int, itk::Image<short, 3>::Pointer> result;
+    for (size_t g = 0; g < groupValues.size(); ++g) {
+        result[groupValues[g]] = (*volumes)[g];
         LOG_DEBUG(std::format("Assembled volume for group {}: {} frames",
-                             groupValue, indices.size()));
+                             groupValues[g], frameGroups[g].size()));
     }
 
     LOG_INFO(std::format("Reconstructed {} volumes from {} dimension groups",
@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <cstring>
 #include <format>
+#include <set>
 #include <sstream>
 
 #include <gdcmAttribute.h>
@@ -65,6 +66,13 @@ const gdcm::Tag kStudyInstanceUID{0x0020, 0x000d};
 const gdcm::Tag kSeriesInstanceUID{0x0020, 0x000e};
 const gdcm::Tag kSeriesDescription{0x0008, 0x103e};
 
+/// Top-level attributes read by parseFile()
+const std::set<gdcm::Tag> kTopLevelTags = {
+    kSOPClassUID, kSOPInstanceUID, kNumberOfFrames, kRows, kColumns,
+    kBitsAllocated, kBitsStored, kHighBit, kPixelRepresentation, kModality,
+    kPatientId, kPatientName, kStudyInstanceUID, kSeriesInstanceUID,
+    kSeriesDescription};
+
 /// Get string value from top-level GDCM DataSet
 std::string getStringValue(const gdcm::DataSet& ds, const gdcm::Tag& tag) {
     if (!ds.FindDataElement(tag)) {
@@ -174,10 +182,12 @@ EnhancedDicomParser::parseFile(const std::string& filePath)
     LOG_INFO(std::format("Parsing Enhanced DICOM file: {}", filePath));
     impl_->reportProgress(0.0);
 
-    // Step 1: Read file header and top-level attributes
+    // Step 1: Read file header and top-level attributes. Only the
+    // attributes below are materialized; the reader stops before the
+    // functional group sequences and Pixel Data.
     gdcm::Reader reader;
     reader.SetFileName(filePath.c_str());
-    if (!reader.Read()) {
+    if (!reader.ReadSelectedTags(kTopLevelTags)) {
         LOG_ERROR(std::format("Failed to read DICOM file: {}", filePath));
         return std::unexpected(EnhancedDicomError{
             EnhancedDicomError::Code::ParseFailed,
@@ -240,28 +250,43 @@ EnhancedDicomParser::parseFile(const std::string& filePath)
 
     impl_->reportProgress(0.2);
 
-    // Step 2: Parse per-frame functional groups
-    info.frames = impl_->groupParser.parsePerFrameGroups(
-        filePath, info.numberOfFrames, info);
+    // Steps 2-4: one streaming pass collects per-frame groups, shared
+    // groups and the DimensionIndexSequence
+    auto table = impl_->groupParser.scanFrameTable(filePath, info.numberOfFrames);
+    if (table) {
+        info.frames = table->toFrameInfos();
+        impl_->reportProgress(0.6);
 
-    impl_->reportProgress(0.6);
+        // Shared groups override per-frame defaults
+        table->applySharedGroups(info);
+        impl_->dimOrg = std::move(table->dimensions);
+        impl_->reportProgress(0.7);
+    } else {
+        LOG_DEBUG(std::format("{}; using GDCM reader",
+                             table.error().toString()));
 
-    // Step 3: Parse shared functional groups (overrides per-frame defaults)
-    impl_->groupParser.parseSharedGroups(filePath, info);
+        // Step 2: Parse per-frame functional groups
+        info.frames = impl_->groupParser.parsePerFrameGroups(
+            filePath, info.numberOfFrames, info);
 
-    impl_->reportProgress(0.7);
+        impl_->reportProgress(0.6);
 
-    // Step 4: Parse DimensionIndexSequence and sort frames
-    auto dimResult = impl_->dimensionSorter.parseDimensionIndex(filePath);
-    if (dimResult) {
-        impl_->dimOrg = dimResult.value();
-        if (!impl_->dimOrg.dimensions.empty()) {
-            info.frames = impl_->dimensionSorter.sortFrames(
-                info.frames, impl_->dimOrg);
-            LOG_INFO(std::format(
-                "Frames sorted by {} dimensions from DimensionIndexSequence",
-                impl_->dimOrg.dimensions.size()));
-        }
+        // Step 3: Parse shared functional groups (overrides per-frame defaults)
+        impl_->groupParser.parseSharedGroups(filePath, info);
+
+        impl_->reportProgress(0.7);
+
+        auto dimResult = impl_->dimensionSorter.parseDimensionIndex(filePath);
+        impl_->dimOrg = dimResult ? dimResult.value() : DimensionOrganization{};
+    }
+
+    // Step 4: Sort frames by DimensionIndexSequence
+    if (!impl_->dimOrg.dimensions.empty()) {
+        info.frames = impl_->dimensionSorter.sortFrames(
+            info.frames, impl_->dimOrg);
+        LOG_INFO(std::format(
+            "Frames sorted by {} dimensions from DimensionIndexSequence",
+            impl_->dimOrg.dimensions.size()));
     }
 
     impl_->reportProgress(0.9);
@@ -28,24 +28,513 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "services/enhanced_dicom/frame_extractor.hpp"
+#include "core/parallel_for.hpp"
 #include <kcenon/common/logging/log_macros.h>
 
 #include <algorithm>
 #include <cstring>
+#include <filesystem>
 #include <format>
+#include <fstream>
+#include <list>
+#include <mutex>
 #include <numeric>
+#include <set>
+#include <stdexcept>
+#include <utility>
 
+#include <gdcmFragment.h>
 #include <gdcmImageReader.h>
 #include <gdcmImage.h>
+#include <gdcmPhotometricInterpretation.h>
+#include <gdcmPixelFormat.h>
 #include <gdcmPixmapReader.h>
+#include <gdcmReader.h>
+#include <gdcmSequenceOfFragments.h>
+#include <gdcmTransferSyntax.h>
 
 #include <itkImage.h>
-#include <itkImportImageFilter.h>
+#include <itkImportImageContainer.h>
 
 namespace dicom_viewer::services {
 
+namespace {
+
+const gdcm::Tag kPixelDataTag{0x7FE0, 0x0010};
+const gdcm::Tag kExtendedOffsetTableTag{0x7FE0, 0x0001};
+const gdcm::Tag kItemTag{0xFFFE, 0xE000};
+const gdcm::Tag kSequenceDelimiterTag{0xFFFE, 0xE0DD};
+
+/// Number of files whose frame index is kept in memory
+constexpr size_t kMaxIndexedFiles = 32;
+
+/// One encapsulated fragment
+struct Fragment {
+    uint64_t itemOffset = 0;   ///< Item position relative to the first fragment item
+    uint64_t valueOffset = 0;  ///< Absolute file position of the fragment bytes
+    uint32_t length = 0;
+};
+
+/// Where each frame of one file is stored
+struct FrameIndex {
+    std::uintmax_t fileSize = 0;
+    int numberOfFrames = 0;
+
+    gdcm::TransferSyntax transferSyntax;
+    gdcm::PixelFormat pixelFormat;
+    gdcm::PhotometricInterpretation photometric;
+    unsigned int planarConfiguration = 0;
+    unsigned int rows = 0;
+    unsigned int columns = 0;
+    size_t frameBytes = 0;
+
+    bool encapsulated = false;
+    uint64_t nativeOffset = 0;  ///< Absolute position of native pixel data
+
+    std::vector<Fragment> fragments;
+    std::vector<std::pair<size_t, size_t>> frameFragments;  ///< [first, last) per frame
+};
+
+using FrameIndexPtr = std::shared_ptr<const FrameIndex>;
+
+EnhancedDicomError readError(const std::string& filePath)
+{
+    return EnhancedDicomError{
+        EnhancedDicomError::Code::ParseFailed,
+        "Failed to read image data from: " + filePath
+    };
+}
+
+unsigned int readUS(const gdcm::DataSet& ds, const gdcm::Tag& tag,
+                    unsigned int fallback)
+{
+    if (!ds.FindDataElement(tag)) {
+        return fallback;
+    }
+    const auto* bv = ds.GetDataElement(tag).GetByteValue();
+    if (!bv || bv->GetLength() < 2) {
+        return fallback;
+    }
+    uint16_t value = 0;
+    std::memcpy(&value, bv->GetPointer(), sizeof(value));
+    return value;
+}
+
+std::string readString(const gdcm::DataSet& ds, const gdcm::Tag& tag)
+{
+    if (!ds.FindDataElement(tag)) {
+        return {};
+    }
+    const auto* bv = ds.GetDataElement(tag).GetByteValue();
+    if (!bv) {
+        return {};
+    }
+    std::string value(bv->GetPointer(), bv->GetLength());
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\0')) {
+        value.pop_back();
+    }
+    return value;
+}
+
+/// Read an item header (tag + 32-bit length) inside encapsulated pixel data
+bool readItemHeader(std::istream& in, gdcm::Tag& tag, uint32_t& length)
+{
+    char header[8];
+    if (!in.read(header, sizeof(header))) {
+        return false;
+    }
+    uint16_t group = 0;
+    uint16_t element = 0;
+    std::memcpy(&group, header, 2);
+    std::memcpy(&element, header + 2, 2);
+    std::memcpy(&length, header + 4, 4);
+    tag = gdcm::Tag(group, element);
+    return true;
+}
+
+/// Group fragments into frames using the offset tables, if possible
+bool mapFragmentsToFrames(FrameIndex& index,
+                          const std::vector<uint64_t>& extendedOffsets,
+                          const std::vector<uint32_t>& basicOffsets)
+{
+    const auto frames = static_cast<size_t>(index.numberOfFrames);
+    const auto& fragments = index.fragments;
+
+    std::vector<uint64_t> starts;
+    if (extendedOffsets.size() == frames) {
+        starts = extendedOffsets;
+    } else if (basicOffsets.size() == frames) {
+        starts.assign(basicOffsets.begin(), basicOffsets.end());
+    } else if (fragments.size() == frames) {
+        for (const auto& fragment : fragments) {
+            starts.push_back(fragment.itemOffset);
+        }
+    } else if (frames == 1 && !fragments.empty()) {
+        starts.push_back(0);
+    } else {
+        // Multi-fragment frames without an offset table: boundaries unknown
+        return false;
+    }
+
+    index.frameFragments.clear();
+    index.frameFragments.reserve(frames);
+    std::vector<size_t> firsts;
+    firsts.reserve(frames);
+    for (uint64_t start : starts) {
+        auto it = std::lower_bound(
+            fragments.begin(), fragments.end(), start,
+            [](const Fragment& f, uint64_t offset) { return f.itemOffset < offset; });
+        if (it == fragments.end() || it->itemOffset != start) {
+            return false;
+        }
+        firsts.push_back(static_cast<size_t>(it - fragments.begin()));
+    }
+    for (size_t f = 0; f < frames; ++f) {
+        const size_t last = (f + 1 < frames) ? firsts[f + 1] : fragments.size();
+        if (last <= firsts[f]) {
+            return false;
+        }
+        index.frameFragments.emplace_back(firsts[f], last);
+    }
+    return true;
+}
+
+/// Whether cleanupUnusedBits() reproduces the decoder's output for @p pf
+bool canCleanupUnusedBits(const gdcm::PixelFormat& pf)
+{
+    return pf.GetBitsAllocated() == 16
+        && pf.GetBitsStored() >= 1
+        && pf.GetBitsStored() < 16
+        && pf.GetHighBit() + 1u >= pf.GetBitsStored()
+        && pf.GetHighBit() < 16;
+}
+
+/**
+ * @brief Right-align the stored bits of 16-bit samples and clear the
+ *        unused ones, sign-extending signed data, as gdcm's raw codec does
+ */
+void cleanupUnusedBits(std::vector<char>& frame, const gdcm::PixelFormat& pf)
+{
+    const unsigned int stored = pf.GetBitsStored();
+    const unsigned int shift = pf.GetHighBit() + 1u - stored;
+    const uint16_t valueMask = static_cast<uint16_t>(0xFFFFu >> (16u - stored));
+    const uint16_t signBit = static_cast<uint16_t>(1u << (stored - 1u));
+    const bool isSigned = pf.GetPixelRepresentation() == 1;
+
+    const size_t count = frame.size() / sizeof(uint16_t);
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t word;
+        std::memcpy(&word, frame.data() + i * sizeof(uint16_t), sizeof(word));
+        word = static_cast<uint16_t>((word >> shift) & valueMask);
+        if (isSigned && (word & signBit) != 0) {
+            word = static_cast<uint16_t>(word | ~valueMask);
+        }
+        std::memcpy(frame.data() + i * sizeof(uint16_t), &word, sizeof(word));
+    }
+}
+
+/**
+ * @brief Parse the header of a file and locate its frames
+ * @return Index, nullptr if the layout does not allow random access, or
+ *         an error if the file cannot be read
+ */
+std::expected<FrameIndexPtr, EnhancedDicomError>
+buildFrameIndex(const std::string& filePath, int numberOfFrames)
+{
+    std::error_code ec;
+    auto index = std::make_shared<FrameIndex>();
+    index->fileSize = std::filesystem::file_size(filePath, ec);
+    if (ec) {
+        return std::unexpected(readError(filePath));
+    }
+    index->numberOfFrames = numberOfFrames;
+
+    // Parse everything before Pixel Data; skipping the tag leaves the
+    // stream positioned at the start of its value
+    gdcm::Reader reader;
+    reader.SetFileName(filePath.c_str());
+    if (!reader.ReadUpToTag(kPixelDataTag, std::set<gdcm::Tag>{kPixelDataTag})) {
+        return std::unexpected(readError(filePath));
+    }
+    const uint64_t valueOffset = reader.GetStreamCurrentPosition();
+    if (valueOffset == 0 || valueOffset >= index->fileSize) {
+        return FrameIndexPtr{};  // No pixel data found
+    }
+
+    const auto& ds = reader.GetFile().GetDataSet();
+    index->transferSyntax = reader.GetFile().GetHeader().GetDataSetTransferSyntax();
+    const auto& ts = index->transferSyntax;
+    if (ts == gdcm::TransferSyntax::DeflatedExplicitVRLittleEndian
+        || ts.GetSwapCode() == gdcm::SwapCode::BigEndian) {
+        return FrameIndexPtr{};
+    }
+
+    const unsigned int samples = readUS(ds, gdcm::Tag(0x0028, 0x0002), 1);
+    const unsigned int bitsAllocated = readUS(ds, gdcm::Tag(0x0028, 0x0100), 0);
+    const unsigned int bitsStored = readUS(ds, gdcm::Tag(0x0028, 0x0101), bitsAllocated);
+    const unsigned int highBit = readUS(ds, gdcm::Tag(0x0028, 0x0102),
+                                        bitsStored > 0 ? bitsStored - 1 : 0);
+    const unsigned int pixelRep = readUS(ds, gdcm::Tag(0x0028, 0x0103), 0);
+    index->rows = readUS(ds, gdcm::Tag(0x0028, 0x0010), 0);
+    index->columns = readUS(ds, gdcm::Tag(0x0028, 0x0011), 0);
+    index->planarConfiguration = readUS(ds, gdcm::Tag(0x0028, 0x0006), 0);
+    index->photometric = gdcm::PhotometricInterpretation(
+        gdcm::PhotometricInterpretation::GetPIType(
+            readString(ds, gdcm::Tag(0x0028, 0x0004)).c_str()));
+
+    if (bitsAllocated == 0 || bitsAllocated % 8 != 0
+        || index->rows == 0 || index->columns == 0) {
+        return FrameIndexPtr{};  // Bit-packed or incomplete header
+    }
+    index->pixelFormat = gdcm::PixelFormat(
+        static_cast<unsigned short>(samples),
+        static_cast<unsigned short>(bitsAllocated),
+        static_cast<unsigned short>(bitsStored),
+        static_cast<unsigned short>(highBit),
+        static_cast<unsigned short>(pixelRep));
+    index->frameBytes = static_cast<size_t>(index->rows) * index->columns
+                      * samples * (bitsAllocated / 8);
+
+    if (!ts.IsEncapsulated()) {
+        // Native frames are laid out back to back; only formats returned
+        // by the decoder unchanged (or after readNativeFrame's unused-bit
+        // cleanup) can be read directly
+        const auto pi = index->photometric;
+        const bool passthrough =
+            (pi == gdcm::PhotometricInterpretation::MONOCHROME1
+             || pi == gdcm::PhotometricInterpretation::MONOCHROME2
+             || (pi == gdcm::PhotometricInterpretation::RGB
+                 && index->planarConfiguration == 0))
+            && (bitsStored == bitsAllocated
+                || canCleanupUnusedBits(index->pixelFormat));
+        const uint64_t required =
+            static_cast<uint64_t>(index->frameBytes) * static_cast<uint64_t>(numberOfFrames);
+        if (!passthrough || valueOffset + required > index->fileSize) {
+            return FrameIndexPtr{};
+        }
+        index->nativeOffset = valueOffset;
+        return FrameIndexPtr{index};
+    }
+
+    index->encapsulated = true;
+
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in) {
+        return std::unexpected(readError(filePath));
+    }
+    in.seekg(static_cast<std::streamoff>(valueOffset));
+
+    // First item is the Basic Offset Table (possibly empty)
+    gdcm::Tag tag;
+    uint32_t length = 0;
+    if (!readItemHeader(in, tag, length) || tag != kItemTag || length % 4 != 0) {
+        return FrameIndexPtr{};
+    }
+    std::vector<uint32_t> basicOffsets(length / 4);
+    if (length > 0
+        && !in.read(reinterpret_cast<char*>(basicOffsets.data()), length)) {
+        return FrameIndexPtr{};
+    }
+
+    // Walk fragment item headers without reading fragment bytes
+    const uint64_t firstItem = valueOffset + 8 + length;
+    uint64_t position = firstItem;
+    while (readItemHeader(in, tag, length)) {
+        if (tag == kSequenceDelimiterTag) {
+            break;
+        }
+        if (tag != kItemTag || length == 0xFFFFFFFFu
+            || position + 8 + length > index->fileSize) {
+            return FrameIndexPtr{};
+        }
+        index->fragments.push_back(Fragment{position - firstItem, position + 8, length});
+        position += 8 + static_cast<uint64_t>(length);
+        in.seekg(static_cast<std::streamoff>(position));
+    }
+
+    std::vector<uint64_t> extendedOffsets;
+    if (ds.FindDataElement(kExtendedOffsetTableTag)) {
+        if (const auto* bv = ds.GetDataElement(kExtendedOffsetTableTag).GetByteValue()) {
+            extendedOffsets.resize(bv->GetLength() / sizeof(uint64_t));
+            std::memcpy(extendedOffsets.data(), bv->GetPointer(),
+                        extendedOffsets.size() * sizeof(uint64_t));
+        }
+    }
+
+    if (!mapFragmentsToFrames(*index, extendedOffsets, basicOffsets)) {
+        return FrameIndexPtr{};
+    }
+    return FrameIndexPtr{index};
+}
+
+/// Read one native frame with a single seek
+std::expected<std::vector<char>, EnhancedDicomError>
+readNativeFrame(const std::string& filePath, const FrameIndex& index, int frameIndex)
+{
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in) {
+        return std::unexpected(readError(filePath));
+    }
+    in.seekg(static_cast<std::streamoff>(
+        index.nativeOffset + static_cast<uint64_t>(frameIndex) * index.frameBytes));
+
+    std::vector<char> frame(index.frameBytes);
+    if (!in.read(frame.data(), static_cast<std::streamsize>(frame.size()))) {
+        return std::unexpected(EnhancedDicomError{
+            EnhancedDicomError::Code::FrameExtractionFailed,
+            "Pixel data truncated at frame " + std::to_string(frameIndex)
+        });
+    }
+    if (index.pixelFormat.GetBitsStored() != index.pixelFormat.GetBitsAllocated()) {
+        cleanupUnusedBits(frame, index.pixelFormat);
+    }
+    return frame;
+}
+
+/// Read one encapsulated frame's fragments and decode only those
+std::expected<std::vector<char>, EnhancedDicomError>
+decodeEncapsulatedFrame(const std::string& filePath, const FrameIndex& index,
+                        int frameIndex)
+{
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in) {
+        return std::unexpected(readError(filePath));
+    }
+
+    const auto [first, last] = index.frameFragments[static_cast<size_t>(frameIndex)];
+    gdcm::SmartPointer<gdcm::SequenceOfFragments> sequence = new gdcm::SequenceOfFragments;
+    std::vector<char> bytes;
+    for (size_t i = first; i < last; ++i) {
+        const auto& fragment = index.fragments[i];
+        bytes.resize(fragment.length);
+        in.seekg(static_cast<std::streamoff>(fragment.valueOffset));
+        if (!in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+            return std::unexpected(EnhancedDicomError{
+                EnhancedDicomError::Code::FrameExtractionFailed,
+                "Pixel data truncated at frame " + std::to_string(frameIndex)
+            });
+        }
+        gdcm::Fragment item;
+        item.SetByteValue(bytes.data(), fragment.length);
+        sequence->AddFragment(item);
+    }
+
+    gdcm::DataElement pixelData(kPixelDataTag);
+    pixelData.SetVR(gdcm::VR::OB);
+    pixelData.SetValue(*sequence);
+    pixelData.SetVLToUndefined();
+
+    gdcm::Image image;
+    image.SetNumberOfDimensions(2);
+    image.SetDimension(0, index.columns);
+    image.SetDimension(1, index.rows);
+    image.SetPixelFormat(index.pixelFormat);
+    image.SetPhotometricInterpretation(index.photometric);
+    image.SetPlanarConfiguration(index.planarConfiguration);
+    image.SetTransferSyntax(index.transferSyntax);
+    image.SetDataElement(pixelData);
+
+    std::vector<char> frame(image.GetBufferLength());
+    if (!image.GetBuffer(frame.data())) {
+        return std::unexpected(EnhancedDicomError{
+            EnhancedDicomError::Code::FrameExtractionFailed,
+            "Failed to decode frame " + std::to_string(frameIndex)
+        });
+    }
+    return frame;
+}
+
+/// Decode the entire pixel data element and copy out one frame
+std::expected<std::vector<char>, EnhancedDicomError>
+extractFrameByFullDecode(const std::string& filePath, int frameIndex,
+                         const EnhancedSeriesInfo& info)
+{
+    gdcm::ImageReader reader;
+    reader.SetFileName(filePath.c_str());
+    if (!reader.Read()) {
+        return std::unexpected(readError(filePath));
+    }
+
+    const auto& image = reader.GetImage();
+    size_t totalBytes = image.GetBufferLength();
+    size_t bytesPerFrame = totalBytes / info.numberOfFrames;
+
+    std::vector<char> fullBuffer(totalBytes);
+    if (!image.GetBuffer(fullBuffer.data())) {
+        return std::unexpected(EnhancedDicomError{
+            EnhancedDicomError::Code::FrameExtractionFailed,
+            "Failed to decode pixel data"
+        });
+    }
+
+    size_t offset = static_cast<size_t>(frameIndex) * bytesPerFrame;
+    return std::vector<char>(
+        fullBuffer.begin() + static_cast<ptrdiff_t>(offset),
+        fullBuffer.begin() + static_cast<ptrdiff_t>(offset + bytesPerFrame));
+}
+
+}  // anonymous namespace
+
 class FrameExtractor::Impl {
 public:
+    /// Cached frame index for a file, rebuilt when the file changes
+    std::expected<FrameIndexPtr, EnhancedDicomError>
+    frameIndex(const std::string& filePath, int numberOfFrames)
+    {
+        std::error_code ec;
+        Entry probe;
+        probe.fileSize = std::filesystem::file_size(filePath, ec);
+        if (!ec) {
+            probe.modified = std::filesystem::last_write_time(filePath, ec);
+        }
+        if (ec) {
+            return std::unexpected(readError(filePath));
+        }
+        probe.numberOfFrames = numberOfFrames;
+
+        {
+            std::lock_guard lock(mutex_);
+            auto it = std::find_if(entries_.begin(), entries_.end(),
+                [&filePath](const auto& entry) { return entry.first == filePath; });
+            if (it != entries_.end()) {
+                if (it->second.matches(probe)) {
+                    entries_.splice(entries_.begin(), entries_, it);
+                    return it->second.index;
+                }
+                entries_.erase(it);
+            }
+        }
+
+        auto built = buildFrameIndex(filePath, numberOfFrames);
+        if (!built) {
+            return built;
+        }
+
+        probe.index = *built;
+        std::lock_guard lock(mutex_);
+        entries_.emplace_front(filePath, std::move(probe));
+        if (entries_.size() > kMaxIndexedFiles) {
+            entries_.pop_back();
+        }
+        return *built;
+    }
+
+private:
+    struct Entry {
+        FrameIndexPtr index;  ///< nullptr = layout needs a full decode
+        std::uintmax_t fileSize = 0;
+        std::filesystem::file_time_type modified;
+        int numberOfFrames = 0;
+
+        bool matches(const Entry& other) const
+        {
+            return fileSize == other.fileSize && modified == other.modified
+                && numberOfFrames == other.numberOfFrames;
+        }
+    };
+
+    std::mutex mutex_;
+    std::list<std::pair<std::string, Entry>> entries_;  ///< Most recent first
 };
 
 FrameExtractor::FrameExtractor() : impl_(std::make_unique<Impl>()) {}
@@ -71,34 +560,20 @@ FrameExtractor::extractFrame(const std::string& filePath,
     }
 
     try {
-        gdcm::ImageReader reader;
-        reader.SetFileName(filePath.c_str());
-        if (!reader.Read()) {
-            return std::unexpected(EnhancedDicomError{
-                EnhancedDicomError::Code::ParseFailed,
-                "Failed to read image data from: " + filePath
-            });
+        auto index = impl_->frameIndex(filePath, info.numberOfFrames);
+        if (!index) {
+            return std::unexpected(index.error());
         }
 
-        const auto& image = reader.GetImage();
-        size_t totalBytes = image.GetBufferLength();
-        size_t bytesPerFrame = totalBytes / info.numberOfFrames;
-
-        std::vector<char> fullBuffer(totalBytes);
-        if (!image.GetBuffer(fullBuffer.data())) {
-            return std::unexpected(EnhancedDicomError{
-                EnhancedDicomError::Code::FrameExtractionFailed,
-                "Failed to decode pixel data"
-            });
+        const auto& frames = *index;
+        if (!frames) {
+            LOG_DEBUG(std::format("No frame index for {}, decoding all frames", filePath));
+            return extractFrameByFullDecode(filePath, frameIndex, info);
         }
-
-        // Extract the requested frame
-        size_t offset = static_cast<size_t>(frameIndex) * bytesPerFrame;
-        std::vector<char> frameBuffer(
-            fullBuffer.begin() + static_cast<ptrdiff_t>(offset),
-            fullBuffer.begin() + static_cast<ptrdiff_t>(offset + bytesPerFrame));
-
-        return frameBuffer;
+        if (frames->encapsulated) {
+            return decodeEncapsulatedFrame(filePath, *frames, frameIndex);
+        }
+        return readNativeFrame(filePath, *frames, frameIndex);
 
     } catch (const std::exception& e) {
         return std::unexpected(EnhancedDicomError{
@@ -110,6 +585,40 @@ FrameExtractor::extractFrame(const std::string& filePath,
 
 namespace {
 
+using VolumeType = itk::Image<short, 3>;
+
+/**
+ * @brief Pixel container viewing a slice range of a shared 4D buffer
+ *
+ * Every phase volume produced by one assembly call points into the same
+ * allocation; the buffer is released with the last volume that uses it.
+ */
+class SharedVolumeContainer
+    : public itk::ImportImageContainer<itk::SizeValueType, short> {
+public:
+    using Self = SharedVolumeContainer;
+    using Superclass = itk::ImportImageContainer<itk::SizeValueType, short>;
+    using Pointer = itk::SmartPointer<Self>;
+    using ConstPointer = itk::SmartPointer<const Self>;
+
+    itkNewMacro(Self);
+
+    void setView(std::shared_ptr<std::vector<short>> buffer, size_t offset,
+                 itk::SizeValueType count)
+    {
+        // The container never frees the pointer; the shared buffer owns it
+        this->SetImportPointer(buffer->data() + offset, count, false);
+        buffer_ = std::move(buffer);
+    }
+
+protected:
+    SharedVolumeContainer() = default;
+    ~SharedVolumeContainer() override = default;
+
+private:
+    std::shared_ptr<std::vector<short>> buffer_;
+};
+
 /// Sort frame indices by spatial position along the slice normal
 std::vector<int> sortFramesBySpatialPosition(
     const EnhancedSeriesInfo& info,
@@ -143,6 +652,122 @@ std::vector<int> sortFramesBySpatialPosition(
     return sorted;
 }
 
+/// Create an (unallocated) volume with geometry taken from spatially sorted frames
+VolumeType::Pointer createVolumeGeometry(const EnhancedSeriesInfo& info,
+                                         const std::vector<int>& sortedIndices)
+{
+    const int sliceCount = static_cast<int>(sortedIndices.size());
+
+    VolumeType::SizeType itkSize;
+    itkSize[0] = info.columns;
+    itkSize[1] = info.rows;
+    itkSize[2] = sliceCount;
+
+    VolumeType::IndexType start;
+    start.Fill(0);
+
+    VolumeType::RegionType region;
+    region.SetIndex(start);
+    region.SetSize(itkSize);
+
+    auto volume = VolumeType::New();
+    volume->SetRegions(region);
+
+    // Set origin from first frame
+    const auto& firstFrame = info.frames[sortedIndices[0]];
+    double origin[3] = {
+        firstFrame.imagePosition[0],
+        firstFrame.imagePosition[1],
+        firstFrame.imagePosition[2]
+    };
+    volume->SetOrigin(origin);
+
+    // Set spacing
+    double spacing[3] = {info.pixelSpacingX, info.pixelSpacingY, 0.0};
+
+    // Calculate Z spacing from frame positions
+    if (sliceCount >= 2) {
+        const auto& orient = firstFrame.imageOrientation;
+        std::array<double, 3> normal = {
+            orient[1] * orient[5] - orient[2] * orient[4],
+            orient[2] * orient[3] - orient[0] * orient[5],
+            orient[0] * orient[4] - orient[1] * orient[3]
+        };
+
+        const auto& pos0 = info.frames[sortedIndices[0]].imagePosition;
+        const auto& pos1 = info.frames[sortedIndices[1]].imagePosition;
+        double zDist = std::abs(
+            (pos1[0] - pos0[0]) * normal[0]
+            + (pos1[1] - pos0[1]) * normal[1]
+            + (pos1[2] - pos0[2]) * normal[2]);
+        spacing[2] = (zDist > 0.001) ? zDist : firstFrame.sliceThickness;
+    } else {
+        spacing[2] = firstFrame.sliceThickness;
+    }
+    volume->SetSpacing(spacing);
+
+    // Set direction cosines
+    VolumeType::DirectionType direction;
+    direction.SetIdentity();
+    direction[0][0] = firstFrame.imageOrientation[0];
+    direction[1][0] = firstFrame.imageOrientation[1];
+    direction[2][0] = firstFrame.imageOrientation[2];
+    direction[0][1] = firstFrame.imageOrientation[3];
+    direction[1][1] = firstFrame.imageOrientation[4];
+    direction[2][1] = firstFrame.imageOrientation[5];
+    // Z direction = cross product of row and column
+    direction[0][2] = firstFrame.imageOrientation[1]
+                    * firstFrame.imageOrientation[5]
+                    - firstFrame.imageOrientation[2]
+                    * firstFrame.imageOrientation[4];
+    direction[1][2] = firstFrame.imageOrientation[2]
+                    * firstFrame.imageOrientation[3]
+                    - firstFrame.imageOrientation[0]
+                    * firstFrame.imageOrientation[5];
+    direction[2][2] = firstFrame.imageOrientation[0]
+                    * firstFrame.imageOrientation[4]
+                    - firstFrame.imageOrientation[1]
+                    * firstFrame.imageOrientation[3];
+    volume->SetDirection(direction);
+
+    return volume;
+}
+
+/// Convert one stored frame to rescaled signed short pixels
+void convertFrame(const char* srcPtr, const EnhancedFrameInfo& frame,
+                  const EnhancedSeriesInfo& info, size_t pixelsPerSlice,
+                  short* dst)
+{
+    const bool isSigned = (info.pixelRepresentation == 1);
+    const int bytesPerPixel = info.bitsAllocated / 8;
+
+    for (size_t px = 0; px < pixelsPerSlice; ++px) {
+        short rawValue = 0;
+        if (bytesPerPixel == 2) {
+            if (isSigned) {
+                std::memcpy(&rawValue, srcPtr + px * 2, 2);
+            } else {
+                uint16_t uval = 0;
+                std::memcpy(&uval, srcPtr + px * 2, 2);
+                rawValue = static_cast<short>(uval);
+            }
+        } else if (bytesPerPixel == 1) {
+            if (isSigned) {
+                rawValue = static_cast<short>(
+                    static_cast<int8_t>(srcPtr[px]));
+            } else {
+                rawValue = static_cast<short>(
+                    static_cast<uint8_t>(srcPtr[px]));
+            }
+        }
+
+        // Apply per-frame rescale: HU = slope * raw + intercept
+        double hu = frame.rescaleSlope * rawValue
+                  + frame.rescaleIntercept;
+        dst[px] = static_cast<short>(std::clamp(hu, -32768.0, 32767.0));
+    }
+}
+
 }  // anonymous namespace
 
 std::expected<itk::Image<short, 3>::Pointer, EnhancedDicomError>
@@ -161,176 +786,143 @@ FrameExtractor::assembleVolumeFromFrames(
     const EnhancedSeriesInfo& info,
     const std::vector<int>& frameIndices)
 {
-    LOG_INFO(std::format("Assembling volume from {} frames", frameIndices.size()));
+    auto volumes = assembleVolumesFromFrameGroups(filePath, info, {frameIndices});
+    if (!volumes) {
+        return std::unexpected(volumes.error());
+    }
+    return volumes->front();
+}
+
+std::expected<std::vector<itk::Image<short, 3>::Pointer>, EnhancedDicomError>
+FrameExtractor::assembleVolumesFromFrameGroups(
+    const std::string& filePath,
+    const EnhancedSeriesInfo& info,
+    const std::vector<std::vector<int>>& frameGroups)
+{
+    LOG_INFO(std::format("Assembling {} volume(s) from {}",
+                        frameGroups.size(), filePath));
 
-    if (frameIndices.empty()) {
+    if (frameGroups.empty()
+        || std::any_of(frameGroups.begin(), frameGroups.end(),
+                       [](const auto& group) { return group.empty(); })) {
         return std::unexpected(EnhancedDicomError{
             EnhancedDicomError::Code::InvalidInput,
             "No frame indices provided for volume assembly"
         });
     }
+    for (const auto& group : frameGroups) {
+        for (int frameIdx : group) {
+            if (frameIdx < 0 || frameIdx >= info.numberOfFrames
+                || frameIdx >= static_cast<int>(info.frames.size())) {
+                return std::unexpected(EnhancedDicomError{
+                    EnhancedDicomError::Code::InvalidInput,
+                    "Frame index " + std::to_string(frameIdx) + " out of range"
+                });
+            }
+        }
+    }
 
     try {
-        // Read all pixel data at once using GDCM ImageReader
-        gdcm::ImageReader reader;
-        reader.SetFileName(filePath.c_str());
-        if (!reader.Read()) {
-            return std::unexpected(EnhancedDicomError{
-                EnhancedDicomError::Code::ParseFailed,
-                "Failed to read image data from: " + filePath
-            });
-        }
+        const size_t pixelsPerSlice =
+            static_cast<size_t>(info.rows) * info.columns;
 
-        const auto& image = reader.GetImage();
-        size_t totalBytes = image.GetBufferLength();
-        size_t bytesPerFrame =
-            static_cast<size_t>(info.rows) * info.columns
-            * (info.bitsAllocated / 8);
+        // Lay out every group's spatially sorted slices back to back in one
+        // 4D buffer and remember which slots each source frame fills
+        std::vector<std::vector<int>> sortedGroups;
+        sortedGroups.reserve(frameGroups.size());
+        std::vector<size_t> groupOffsets;
+        groupOffsets.reserve(frameGroups.size());
+        std::vector<std::vector<size_t>> slotsByFrame(info.numberOfFrames);
+        size_t totalSlices = 0;
+        for (const auto& group : frameGroups) {
+            sortedGroups.push_back(sortFramesBySpatialPosition(info, group));
+            groupOffsets.push_back(totalSlices);
+            for (int frameIdx : sortedGroups.back()) {
+                slotsByFrame[frameIdx].push_back(totalSlices++);
+            }
+        }
 
-        std::vector<char> fullBuffer(totalBytes);
-        if (!image.GetBuffer(fullBuffer.data())) {
-            return std::unexpected(EnhancedDicomError{
-                EnhancedDicomError::Code::FrameExtractionFailed,
-                "Failed to decode pixel data"
-            });
+        std::vector<int> neededFrames;
+        for (int f = 0; f < info.numberOfFrames; ++f) {
+            if (!slotsByFrame[f].empty()) {
+                neededFrames.push_back(f);
+            }
         }
 
-        // Sort frames by spatial position
-        auto sortedIndices = sortFramesBySpatialPosition(info, frameIndices);
-        int sliceCount = static_cast<int>(sortedIndices.size());
-
-        // Create ITK image via ImportImageFilter
-        using ImportFilterType = itk::ImportImageFilter<short, 3>;
-        auto importFilter = ImportFilterType::New();
-
-        ImportFilterType::SizeType itkSize;
-        itkSize[0] = info.columns;
-        itkSize[1] = info.rows;
-        itkSize[2] = sliceCount;
-
-        ImportFilterType::IndexType start;
-        start.Fill(0);
-
-        ImportFilterType::RegionType region;
-        region.SetIndex(start);
-        region.SetSize(itkSize);
-        importFilter->SetRegion(region);
-
-        // Set origin from first frame
-        const auto& firstFrame = info.frames[sortedIndices[0]];
-        double origin[3] = {
-            firstFrame.imagePosition[0],
-            firstFrame.imagePosition[1],
-            firstFrame.imagePosition[2]
+        auto buffer = std::make_shared<std::vector<short>>(totalSlices * pixelsPerSlice);
+        auto storeFrame = [&](int frameIdx, const char* raw) {
+            for (size_t slot : slotsByFrame[frameIdx]) {
+                convertFrame(raw, info.frames[frameIdx], info, pixelsPerSlice,
+                             buffer->data() + slot * pixelsPerSlice);
+            }
         };
-        importFilter->SetOrigin(origin);
-
-        // Set spacing
-        double spacing[3] = {info.pixelSpacingX, info.pixelSpacingY, 0.0};
-
-        // Calculate Z spacing from frame positions
-        if (sliceCount >= 2) {
-            const auto& orient = firstFrame.imageOrientation;
-            std::array<double, 3> normal = {
-                orient[1] * orient[5] - orient[2] * orient[4],
-                orient[2] * orient[3] - orient[0] * orient[5],
-                orient[0] * orient[4] - orient[1] * orient[3]
-            };
-
-            const auto& pos0 = info.frames[sortedIndices[0]].imagePosition;
-            const auto& pos1 = info.frames[sortedIndices[1]].imagePosition;
-            double zDist = std::abs(
-                (pos1[0] - pos0[0]) * normal[0]
-                + (pos1[1] - pos0[1]) * normal[1]
-                + (pos1[2] - pos0[2]) * normal[2]);
-            spacing[2] = (zDist > 0.001) ? zDist : firstFrame.sliceThickness;
-        } else {
-            spacing[2] = firstFrame.sliceThickness;
+
+        // Decode each needed frame exactly once, straight into its slot(s)
+        auto index = impl_->frameIndex(filePath, info.numberOfFrames);
+        if (!index) {
+            return std::unexpected(index.error());
         }
-        importFilter->SetSpacing(spacing);
-
-        // Set direction cosines
-        ImportFilterType::DirectionType direction;
-        direction.SetIdentity();
-        direction[0][0] = firstFrame.imageOrientation[0];
-        direction[1][0] = firstFrame.imageOrientation[1];
-        direction[2][0] = firstFrame.imageOrientation[2];
-        direction[0][1] = firstFrame.imageOrientation[3];
-        direction[1][1] = firstFrame.imageOrientation[4];
-        direction[2][1] = firstFrame.imageOrientation[5];
-        // Z direction = cross product of row and column
-        direction[0][2] = firstFrame.imageOrientation[1]
-                        * firstFrame.imageOrientation[5]
-                        - firstFrame.imageOrientation[2]
-                        * firstFrame.imageOrientation[4];
-        direction[1][2] = firstFrame.imageOrientation[2]
-                        * firstFrame.imageOrientation[3]
-                        - firstFrame.imageOrientation[0]
-                        * firstFrame.imageOrientation[5];
-        direction[2][2] = firstFrame.imageOrientation[0]
-                        * firstFrame.imageOrientation[4]
-                        - firstFrame.imageOrientation[1]
-                        * firstFrame.imageOrientation[3];
-        importFilter->SetDirection(direction);
-
-        // Allocate output buffer and copy frame data
-        size_t pixelsPerSlice =
-            static_cast<size_t>(info.rows) * info.columns;
-        size_t totalPixels = pixelsPerSlice * sliceCount;
-        auto* outputBuffer = new short[totalPixels];
-
-        bool isSigned = (info.pixelRepresentation == 1);
-        int bytesPerPixel = info.bitsAllocated / 8;
-
-        for (int sliceIdx = 0; sliceIdx < sliceCount; ++sliceIdx) {
-            int frameIdx = sortedIndices[sliceIdx];
-            const auto& frame = info.frames[frameIdx];
-
-            size_t srcOffset =
-                static_cast<size_t>(frameIdx) * bytesPerFrame;
-            size_t dstOffset = static_cast<size_t>(sliceIdx) * pixelsPerSlice;
-
-            const char* srcPtr = fullBuffer.data() + srcOffset;
-
-            for (size_t px = 0; px < pixelsPerSlice; ++px) {
-                short rawValue = 0;
-                if (bytesPerPixel == 2) {
-                    if (isSigned) {
-                        std::memcpy(&rawValue, srcPtr + px * 2, 2);
-                    } else {
-                        uint16_t uval = 0;
-                        std::memcpy(&uval, srcPtr + px * 2, 2);
-                        rawValue = static_cast<short>(uval);
-                    }
-                } else if (bytesPerPixel == 1) {
-                    if (isSigned) {
-                        rawValue = static_cast<short>(
-                            static_cast<int8_t>(srcPtr[px]));
-                    } else {
-                        rawValue = static_cast<short>(
-                            static_cast<uint8_t>(srcPtr[px]));
-                    }
+
+        if (const auto& frames = *index) {
+            core::parallelFor(neededFrames.size(), 0, [&](size_t i) {
+                const int frameIdx = neededFrames[i];
+                auto raw = frames->encapsulated
+                    ? decodeEncapsulatedFrame(filePath, *frames, frameIdx)
+                    : readNativeFrame(filePath, *frames, frameIdx);
+                if (!raw) {
+                    throw std::runtime_error(raw.error().message);
                 }
+                storeFrame(frameIdx, raw->data());
+            });
+        } else {
+            // Layout without frame-level access: decode everything once
+            gdcm::ImageReader reader;
+            reader.SetFileName(filePath.c_str());
+            if (!reader.Read()) {
+                return std::unexpected(readError(filePath));
+            }
+
+            const auto& image = reader.GetImage();
+            std::vector<char> fullBuffer(image.GetBufferLength());
+            if (!image.GetBuffer(fullBuffer.data())) {
+                return std::unexpected(EnhancedDicomError{
+                    EnhancedDicomError::Code::FrameExtractionFailed,
+                    "Failed to decode pixel data"
+                });
+            }
 
-                // Apply per-frame rescale: HU = slope * raw + intercept
-                double hu = frame.rescaleSlope * rawValue
-                          + frame.rescaleIntercept;
-                outputBuffer[dstOffset + px] =
-                    static_cast<short>(std::clamp(hu, -32768.0, 32767.0));
+            const size_t bytesPerFrame = pixelsPerSlice * (info.bitsAllocated / 8);
+            if (fullBuffer.size() < bytesPerFrame * info.numberOfFrames) {
+                return std::unexpected(EnhancedDicomError{
+                    EnhancedDicomError::Code::FrameExtractionFailed,
+                    "Decoded pixel data is smaller than the frame count implies"
+                });
             }
+            core::parallelFor(neededFrames.size(), 0, [&](size_t i) {
+                const int frameIdx = neededFrames[i];
+                storeFrame(frameIdx,
+                           fullBuffer.data() + static_cast<size_t>(frameIdx) * bytesPerFrame);
+            });
         }
 
-        const bool letITKManageMemory = true;
-        importFilter->SetImportPointer(outputBuffer, totalPixels,
-                                       letITKManageMemory);
-        importFilter->Update();
+        // Each volume is a zero-copy view of its slice range
+        std::vector<VolumeType::Pointer> volumes;
+        volumes.reserve(sortedGroups.size());
+        for (size_t g = 0; g < sortedGroups.size(); ++g) {
+            auto volume = createVolumeGeometry(info, sortedGroups[g]);
+            auto container = SharedVolumeContainer::New();
+            container->setView(buffer, groupOffsets[g] * pixelsPerSlice,
+                               sortedGroups[g].size() * pixelsPerSlice);
+            volume->SetPixelContainer(container);
+            volumes.push_back(volume);
+        }
 
-        auto output = importFilter->GetOutput();
-        auto size = output->GetLargestPossibleRegion().GetSize();
-        LOG_INFO(std::format("Volume assembled: {}x{}x{}", size[0], size[1],
-                           size[2]));
+        const auto size = volumes.front()->GetLargestPossibleRegion().GetSize();
+        LOG_INFO(std::format("Assembled {} volume(s), first {}x{}x{}, from {} decoded frames",
+                            volumes.size(), size[0], size[1], size[2],
+                            neededFrames.size()));
 
-        return output;
+        return volumes;
 
     } catch (const std::exception& e) {
         return std::unexpected(EnhancedDicomError{
@@ -26,12 +26,15 @@
 // CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-
 #include "services/enhanced_dicom/functional_group_parser.hpp"
 #include <kcenon/common/logging/log_macros.h>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <format>
+#include <fstream>
+#include <limits>
 #include <sstream>
 #include <string>
 
@@ -69,6 +72,37 @@ const gdcm::Tag kTriggerTime{0x0018, 0x1060};
 const gdcm::Tag kStackId{0x0020, 0x9056};
 const gdcm::Tag kInStackPositionNumber{0x0020, 0x9057};
 
+// DimensionIndexSequence (0020,9222) and its item attributes
+const gdcm::Tag kDimensionIndexSequence{0x0020, 0x9222};
+const gdcm::Tag kDimensionIndexPointer{0x0020, 0x9165};
+const gdcm::Tag kFunctionalGroupPointer{0x0020, 0x9167};
+const gdcm::Tag kDimensionOrganizationUID{0x0020, 0x9164};
+const gdcm::Tag kDimensionDescriptionLabel{0x0020, 0x9421};
+
+// Stream walker tags
+const gdcm::Tag kTransferSyntaxUID{0x0002, 0x0010};
+const gdcm::Tag kItem{0xFFFE, 0xE000};
+const gdcm::Tag kItemDelimiter{0xFFFE, 0xE00D};
+const gdcm::Tag kSequenceDelimiter{0xFFFE, 0xE0DD};
+
+constexpr const char* kImplicitVRLittleEndian = "1.2.840.10008.1.2";
+constexpr const char* kExplicitVRBigEndian = "1.2.840.10008.1.2.2";
+constexpr const char* kDeflatedExplicitVRLittleEndian = "1.2.840.10008.1.2.1.99";
+
+constexpr uint32_t kUndefinedLength = 0xFFFFFFFF;
+constexpr uint64_t kUnbounded = std::numeric_limits<uint64_t>::max();
+constexpr uint32_t kMaxAttributeLength = 16 * 1024 * 1024;
+constexpr uint64_t kSeekThreshold = 64 * 1024;
+constexpr size_t kStreamBufferSize = 1 << 20;
+
+/// Strip the trailing padding DICOM uses to reach an even value length
+std::string trimValue(std::string value) {
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\0')) {
+        value.pop_back();
+    }
+    return value;
+}
+
 /// Get string value from a GDCM DataSet element
 std::string getStringValue(const gdcm::DataSet& ds, const gdcm::Tag& tag) {
     if (!ds.FindDataElement(tag)) {
@@ -78,13 +112,8 @@ std::string getStringValue(const gdcm::DataSet& ds, const gdcm::Tag& tag) {
     if (de.IsEmpty() || de.GetByteValue() == nullptr) {
         return "";
     }
-    std::string value(de.GetByteValue()->GetPointer(),
-                      de.GetByteValue()->GetLength());
-    // Trim trailing whitespace/null
-    while (!value.empty() && (value.back() == ' ' || value.back() == '\0')) {
-        value.pop_back();
-    }
-    return value;
+    return trimValue(std::string(de.GetByteValue()->GetPointer(),
+                                 de.GetByteValue()->GetLength()));
 }
 
 /// Parse a backslash-separated multi-value string into doubles
@@ -138,27 +167,567 @@ std::vector<int> parseDimensionIndexValues(const gdcm::DataSet& ds) {
     return indices;
 }
 
-}  // anonymous namespace
+// =============================================================================
+// Streaming element walker
+// =============================================================================
 
-class FunctionalGroupParser::Impl {
+uint16_t readLE16(const char* p) {
+    return static_cast<uint16_t>(static_cast<uint8_t>(p[0])
+        | (static_cast<uint8_t>(p[1]) << 8));
+}
+
+uint32_t readLE32(const char* p) {
+    return static_cast<uint32_t>(readLE16(p))
+        | (static_cast<uint32_t>(readLE16(p + 2)) << 16);
+}
+
+/// VRs encoded with a reserved field and a 32-bit length (PS3.5 7.1.2)
+bool hasLongLength(const char vr[2]) {
+    static constexpr std::array<const char*, 13> kLongVRs = {
+        "OB", "OD", "OF", "OL", "OV", "OW", "SQ", "SV", "UC", "UN", "UR",
+        "UT", "UV"};
+    return std::any_of(kLongVRs.begin(), kLongVRs.end(),
+        [vr](const char* candidate) {
+            return vr[0] == candidate[0] && vr[1] == candidate[1];
+        });
+}
+
+/// Header of one encoded data element, item or delimiter
+struct ElementHeader {
+    gdcm::Tag tag;
+    char vr[2] = {0, 0};   ///< Zero for implicit VR and item headers
+    uint32_t length = 0;
+
+    [[nodiscard]] bool undefinedLength() const {
+        return length == kUndefinedLength;
+    }
+    [[nodiscard]] bool isUN() const { return vr[0] == 'U' && vr[1] == 'N'; }
+};
+
+/**
+ * @brief Forward-only reader over the encoded elements of a DICOM file
+ *
+ * Little-endian transfer syntaxes only. Values are either skipped or
+ * copied into a caller buffer and nothing else is retained, so memory
+ * stays flat regardless of how many per-frame items the file carries.
+ */
+class ElementStream {
 public:
+    explicit ElementStream(const std::string& filePath)
+        : buffer_(kStreamBufferSize)
+    {
+        // The buffer must be installed before open() to take effect
+        in_.rdbuf()->pubsetbuf(buffer_.data(),
+                               static_cast<std::streamsize>(buffer_.size()));
+        in_.open(filePath, std::ios::binary);
+    }
+
+    /// Consume the preamble and File Meta group; false if the walker
+    /// cannot decode the dataset's transfer syntax
+    bool openDataSet() {
+        char preamble[132];
+        if (!in_.is_open() || !readRaw(preamble, sizeof(preamble))
+            || std::memcmp(preamble + 128, "DICM", 4) != 0) {
+            return false;
+        }
+
+        // File Meta elements are always Explicit VR Little Endian
+        std::string transferSyntax;
+        while (true) {
+            char tagBytes[4];
+            if (!readRaw(tagBytes, sizeof(tagBytes))) {
+                return false;
+            }
+            if (readLE16(tagBytes) != 0x0002) {
+                in_.seekg(-4, std::ios::cur);
+                position_ -= 4;
+                break;
+            }
+            ElementHeader header;
+            if (!readHeaderAfterTag(tagBytes, true, header)) {
+                return false;
+            }
+            if (header.tag == kTransferSyntaxUID) {
+                if (!readValue(header.length, transferSyntax)) {
+                    return false;
+                }
+                transferSyntax = trimValue(transferSyntax);
+            } else if (header.undefinedLength() || !skip(header.length)) {
+                return false;
+            }
+        }
+
+        if (transferSyntax == kExplicitVRBigEndian
+            || transferSyntax == kDeflatedExplicitVRLittleEndian) {
+            return false;
+        }
+        explicitVr = transferSyntax != kImplicitVRLittleEndian;
+        return true;
+    }
+
+    bool readHeader(ElementHeader& header) {
+        char tagBytes[4];
+        return readRaw(tagBytes, sizeof(tagBytes))
+            && readHeaderAfterTag(tagBytes, explicitVr, header);
+    }
+
+    bool skip(uint64_t count) {
+        if (count >= kSeekThreshold) {
+            in_.seekg(static_cast<std::streamoff>(count), std::ios::cur);
+        } else {
+            in_.ignore(static_cast<std::streamsize>(count));
+        }
+        position_ += count;
+        return static_cast<bool>(in_);
+    }
+
+    bool readValue(uint32_t length, std::string& value) {
+        if (length == kUndefinedLength || length > kMaxAttributeLength) {
+            return false;
+        }
+        value.resize(length);
+        return readRaw(value.data(), length);
+    }
+
+    [[nodiscard]] uint64_t position() const { return position_; }
+
+    /// Encoding of the data set currently being walked
+    bool explicitVr = true;
+
+private:
+    bool readRaw(char* dst, size_t count) {
+        in_.read(dst, static_cast<std::streamsize>(count));
+        if (!in_) {
+            return false;
+        }
+        position_ += count;
+        return true;
+    }
+
+    bool readHeaderAfterTag(const char* tagBytes, bool explicitEncoding,
+                            ElementHeader& header) {
+        header.tag = gdcm::Tag(readLE16(tagBytes), readLE16(tagBytes + 2));
+        header.vr[0] = header.vr[1] = 0;
+
+        char bytes[4];
+        // Items and delimiters never carry a VR
+        if (header.tag.GetGroup() == 0xFFFE || !explicitEncoding) {
+            if (!readRaw(bytes, 4)) {
+                return false;
+            }
+            header.length = readLE32(bytes);
+            return true;
+        }
+
+        if (!readRaw(header.vr, 2)) {
+            return false;
+        }
+        if (hasLongLength(header.vr)) {
+            if (!readRaw(bytes, 2) || !readRaw(bytes, 4)) {
+                return false;
+            }
+            header.length = readLE32(bytes);
+        } else {
+            if (!readRaw(bytes, 2)) {
+                return false;
+            }
+            header.length = readLE16(bytes);
+        }
+        return true;
+    }
+
+    std::vector<char> buffer_;
+    std::ifstream in_;
+    uint64_t position_ = 0;
 };
 
-FunctionalGroupParser::FunctionalGroupParser()
-    : impl_(std::make_unique<Impl>()) {}
+bool skipValue(ElementStream& stream, const ElementHeader& header);
 
-FunctionalGroupParser::~FunctionalGroupParser() = default;
+/**
+ * @brief Invoke onItem(index, itemHeader) for every item of a sequence
+ *
+ * onItem must consume the item's content. A defined-length sequence must
+ * end exactly on its boundary, which catches encodings the walker has
+ * misread before they turn into silently wrong metadata.
+ */
+template <typename OnItem>
+bool forEachItem(ElementStream& stream, const ElementHeader& sequence,
+                 OnItem&& onItem)
+{
+    // A UN sequence holds Implicit VR Little Endian content (PS3.5 6.2.2)
+    const bool savedExplicitVr = stream.explicitVr;
+    if (sequence.isUN()) {
+        stream.explicitVr = false;
+    }
 
-FunctionalGroupParser::FunctionalGroupParser(FunctionalGroupParser&&) noexcept
-    = default;
-FunctionalGroupParser& FunctionalGroupParser::operator=(
-    FunctionalGroupParser&&) noexcept = default;
+    const uint64_t end = sequence.undefinedLength()
+        ? kUnbounded : stream.position() + sequence.length;
+    bool ok = true;
+    int index = 0;
+    while (ok && stream.position() < end) {
+        ElementHeader item;
+        if (!stream.readHeader(item)) {
+            ok = false;
+        } else if (item.tag == kSequenceDelimiter) {
+            break;
+        } else if (item.tag != kItem) {
+            ok = false;
+        } else {
+            ok = onItem(index++, item);
+        }
+    }
+    if (ok && end != kUnbounded && stream.position() != end) {
+        ok = false;
+    }
 
-void FunctionalGroupParser::parseSharedGroups(const std::string& filePath,
-                                              EnhancedSeriesInfo& info)
+    stream.explicitVr = savedExplicitVr;
+    return ok;
+}
+
+/// Invoke onElement(header) for every element of an item; onElement must
+/// consume the element's value
+template <typename OnElement>
+bool forEachElement(ElementStream& stream, const ElementHeader& item,
+                    OnElement&& onElement)
 {
-    LOG_DEBUG(std::format("Parsing shared functional groups from: {}", filePath));
+    const uint64_t end = item.undefinedLength()
+        ? kUnbounded : stream.position() + item.length;
+    while (stream.position() < end) {
+        ElementHeader header;
+        if (!stream.readHeader(header)) {
+            return false;
+        }
+        if (header.tag == kItemDelimiter) {
+            return end == kUnbounded;
+        }
+        if (!onElement(header)) {
+            return false;
+        }
+    }
+    return end == kUnbounded ? false : stream.position() == end;
+}
+
+bool skipItem(ElementStream& stream, const ElementHeader& item) {
+    if (!item.undefinedLength()) {
+        return stream.skip(item.length);
+    }
+    return forEachElement(stream, item, [&stream](const ElementHeader& header) {
+        return skipValue(stream, header);
+    });
+}
+
+bool skipValue(ElementStream& stream, const ElementHeader& header) {
+    if (!header.undefinedLength()) {
+        return stream.skip(header.length);
+    }
+    // Outside Pixel Data an undefined length always means a sequence
+    return forEachItem(stream, header,
+        [&stream](int, const ElementHeader& item) {
+            return skipItem(stream, item);
+        });
+}
+
+/// Copy the raw values of the wanted tags found in one item
+template <size_t N>
+bool readItemValues(ElementStream& stream, const ElementHeader& item,
+                    const std::array<gdcm::Tag, N>& wanted,
+                    std::array<std::string, N>& values)
+{
+    return forEachElement(stream, item, [&](const ElementHeader& header) {
+        for (size_t i = 0; i < N; ++i) {
+            if (header.tag == wanted[i] && !header.undefinedLength()) {
+                return stream.readValue(header.length, values[i]);
+            }
+        }
+        return skipValue(stream, header);
+    });
+}
+
+/// Wanted values from the first item of a functional group macro sequence
+template <size_t N>
+struct MacroItem {
+    bool present = false;               ///< Sequence had at least one item
+    std::array<std::string, N> values;  ///< Raw values, empty when absent
+};
+
+template <size_t N>
+bool readMacroItem(ElementStream& stream, const ElementHeader& sequence,
+                   const std::array<gdcm::Tag, N>& wanted, MacroItem<N>& macro)
+{
+    return forEachItem(stream, sequence,
+        [&](int index, const ElementHeader& item) {
+            if (index > 0) {
+                return skipItem(stream, item);
+            }
+            macro.present = true;
+            return readItemValues(stream, item, wanted, macro.values);
+        });
+}
+
+void initializeTable(FrameMetadataTable& table, int numberOfFrames) {
+    const auto n = static_cast<size_t>(std::max(numberOfFrames, 0));
+    const auto defaultOrientation = EnhancedFrameInfo{}.imageOrientation;
+
+    table.numberOfFrames = static_cast<int>(n);
+    table.imagePositions.assign(n * 3, 0.0);
+    table.imageOrientations.resize(n * 6);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(defaultOrientation.begin(), defaultOrientation.end(),
+                  table.imageOrientations.begin() + i * 6);
+    }
+    table.rescaleSlopes.assign(n, 1.0);
+    table.rescaleIntercepts.assign(n, 0.0);
+    table.triggerTimes.assign(n, 0.0);
+    table.temporalPositionIndices.assign(n, 0);
+    table.inStackPositions.assign(n, 0);
+    table.fields.assign(n, 0);
+    table.dimensionValueOffsets.assign(n + 1, 0);
+}
+
+bool parseDimensionIndexStream(ElementStream& stream,
+                               const ElementHeader& sequence,
+                               DimensionOrganization& org)
+{
+    static const std::array<gdcm::Tag, 4> kWanted = {
+        kDimensionIndexPointer, kFunctionalGroupPointer,
+        kDimensionOrganizationUID, kDimensionDescriptionLabel};
+
+    // AT VR: stored as two uint16_t values (group, element)
+    auto tagValue = [](const std::string& raw) -> uint32_t {
+        if (raw.size() < 4) {
+            return 0;
+        }
+        return (static_cast<uint32_t>(readLE16(raw.data())) << 16)
+            | readLE16(raw.data() + 2);
+    };
+
+    return forEachItem(stream, sequence,
+        [&](int, const ElementHeader& item) {
+            std::array<std::string, 4> values;
+            if (!readItemValues(stream, item, kWanted, values)) {
+                return false;
+            }
+            DimensionDefinition def;
+            def.dimensionIndexPointer = tagValue(values[0]);
+            def.functionalGroupPointer = tagValue(values[1]);
+            def.dimensionOrganizationUID = trimValue(std::move(values[2]));
+            def.dimensionDescription = trimValue(std::move(values[3]));
+            if (def.dimensionIndexPointer != 0) {
+                org.dimensions.push_back(std::move(def));
+            }
+            return true;
+        });
+}
+
+bool parseSharedGroupsStream(ElementStream& stream,
+                             const ElementHeader& sequence,
+                             FrameMetadataTable::SharedGroups& shared)
+{
+    return forEachItem(stream, sequence,
+        [&](int index, const ElementHeader& item) {
+            if (index > 0) {
+                return skipItem(stream, item);
+            }
+            shared.present = true;
+            return forEachElement(stream, item,
+                [&](const ElementHeader& header) {
+                    if (header.tag == kPixelMeasuresSequence) {
+                        MacroItem<2> macro;
+                        if (!readMacroItem(stream, header,
+                                std::array{kPixelSpacing, kSliceThickness},
+                                macro)) {
+                            return false;
+                        }
+                        if (!macro.present) {
+                            return true;
+                        }
+                        auto spacing =
+                            parseDoubleValues(trimValue(macro.values[0]));
+                        if (spacing.size() >= 2) {
+                            shared.pixelSpacing =
+                                std::array<double, 2>{spacing[0], spacing[1]};
+                        }
+                        auto thickness = trimValue(macro.values[1]);
+                        if (!thickness.empty()) {
+                            try {
+                                shared.sliceThickness = std::stod(thickness);
+                            } catch (...) {}
+                        }
+                        return true;
+                    }
+                    if (header.tag == kPixelValueTransformationSequence) {
+                        MacroItem<2> macro;
+                        if (!readMacroItem(stream, header,
+                                std::array{kRescaleSlope, kRescaleIntercept},
+                                macro)) {
+                            return false;
+                        }
+                        if (!macro.present) {
+                            return true;
+                        }
+                        shared.hasPixelValueTransformation = true;
+                        auto slope = trimValue(macro.values[0]);
+                        auto intercept = trimValue(macro.values[1]);
+                        if (!slope.empty()) {
+                            try { shared.rescaleSlope = std::stod(slope); }
+                            catch (...) {}
+                        }
+                        if (!intercept.empty()) {
+                            try {
+                                shared.rescaleIntercept = std::stod(intercept);
+                            } catch (...) {}
+                        }
+                        return true;
+                    }
+                    if (header.tag == kPlaneOrientationSequence) {
+                        MacroItem<1> macro;
+                        if (!readMacroItem(stream, header,
+                                std::array{kImageOrientationPatient}, macro)) {
+                            return false;
+                        }
+                        auto orientation =
+                            parseDoubleValues(trimValue(macro.values[0]));
+                        if (orientation.size() >= 6) {
+                            std::array<double, 6> values{};
+                            std::copy_n(orientation.begin(), 6, values.begin());
+                            shared.imageOrientation = values;
+                        }
+                        return true;
+                    }
+                    return skipValue(stream, header);
+                });
+        });
+}
+
+/// Parse one PerFrameFunctionalGroupsSequence item into table row i
+bool parseFrameItemStream(ElementStream& stream, const ElementHeader& item,
+                          FrameMetadataTable& table, size_t i)
+{
+    table.dimensionValueOffsets[i + 1] =
+        static_cast<uint32_t>(table.dimensionIndexValues.size());
 
+    return forEachElement(stream, item, [&](const ElementHeader& header) {
+        if (header.tag == kPlanePositionSequence) {
+            MacroItem<1> macro;
+            if (!readMacroItem(stream, header,
+                    std::array{kImagePositionPatient}, macro)) {
+                return false;
+            }
+            auto position = parseDoubleValues(trimValue(macro.values[0]));
+            if (position.size() >= 3) {
+                std::copy_n(position.begin(), 3,
+                            table.imagePositions.begin() + i * 3);
+            }
+            return true;
+        }
+        if (header.tag == kPlaneOrientationSequence) {
+            MacroItem<1> macro;
+            if (!readMacroItem(stream, header,
+                    std::array{kImageOrientationPatient}, macro)) {
+                return false;
+            }
+            auto orientation = parseDoubleValues(trimValue(macro.values[0]));
+            if (orientation.size() >= 6) {
+                std::copy_n(orientation.begin(), 6,
+                            table.imageOrientations.begin() + i * 6);
+            }
+            return true;
+        }
+        if (header.tag == kPixelValueTransformationSequence) {
+            MacroItem<2> macro;
+            if (!readMacroItem(stream, header,
+                    std::array{kRescaleSlope, kRescaleIntercept}, macro)) {
+                return false;
+            }
+            auto slope = trimValue(macro.values[0]);
+            auto intercept = trimValue(macro.values[1]);
+            if (!slope.empty()) {
+                try { table.rescaleSlopes[i] = std::stod(slope); } catch (...) {}
+            }
+            if (!intercept.empty()) {
+                try {
+                    table.rescaleIntercepts[i] = std::stod(intercept);
+                } catch (...) {}
+            }
+            return true;
+        }
+        if (header.tag == kFrameContentSequence) {
+            MacroItem<3> macro;
+            if (!readMacroItem(stream, header,
+                    std::array{kDimensionIndexValues, kTemporalPositionIndex,
+                               kInStackPositionNumber}, macro)) {
+                return false;
+            }
+            // DimensionIndexValues (0020,9157) — unsigned long array
+            const auto& raw = macro.values[0];
+            for (size_t offset = 0; offset + 4 <= raw.size(); offset += 4) {
+                table.dimensionIndexValues.push_back(
+                    readLE32(raw.data() + offset));
+            }
+            table.dimensionValueOffsets[i + 1] =
+                static_cast<uint32_t>(table.dimensionIndexValues.size());
+
+            auto temporal = trimValue(macro.values[1]);
+            if (!temporal.empty()) {
+                try {
+                    table.temporalPositionIndices[i] = std::stoi(temporal);
+                    table.fields[i] |= FrameMetadataTable::HasTemporalPosition;
+                } catch (...) {}
+            }
+            auto inStack = trimValue(macro.values[2]);
+            if (!inStack.empty()) {
+                try {
+                    table.inStackPositions[i] = std::stoi(inStack);
+                    table.fields[i] |= FrameMetadataTable::HasInStackPosition;
+                } catch (...) {}
+            }
+            return true;
+        }
+        // Trigger Time (0018,1060) — may be at frame level outside sequences
+        if (header.tag == kTriggerTime && !header.undefinedLength()) {
+            std::string value;
+            if (!stream.readValue(header.length, value)) {
+                return false;
+            }
+            value = trimValue(std::move(value));
+            if (!value.empty()) {
+                try {
+                    table.triggerTimes[i] = std::stod(value);
+                    table.fields[i] |= FrameMetadataTable::HasTriggerTime;
+                } catch (...) {}
+            }
+            return true;
+        }
+        return skipValue(stream, header);
+    });
+}
+
+bool parsePerFrameGroupsStream(ElementStream& stream,
+                               const ElementHeader& sequence,
+                               FrameMetadataTable& table)
+{
+    // Items past numberOfFrames are never needed; stop at the first one
+    bool reachedLimit = false;
+    bool ok = forEachItem(stream, sequence,
+        [&](int index, const ElementHeader& item) {
+            if (index >= table.numberOfFrames) {
+                reachedLimit = true;
+                return false;
+            }
+            table.perFrameItemCount = index + 1;
+            return parseFrameItemStream(stream, item, table,
+                                        static_cast<size_t>(index));
+        });
+    return ok || reachedLimit;
+}
+
+// =============================================================================
+// GDCM DOM fallback
+// =============================================================================
+
+void parseSharedGroupsFromDom(const std::string& filePath,
+                              EnhancedSeriesInfo& info)
+{
     gdcm::Reader reader;
     reader.SetFileName(filePath.c_str());
     if (!reader.Read()) {
@@ -242,18 +811,11 @@ void FunctionalGroupParser::parseSharedGroups(const std::string& filePath,
             }
         }
     }
-
-    LOG_DEBUG("Shared functional groups parsed successfully");
 }
 
-std::vector<EnhancedFrameInfo> FunctionalGroupParser::parsePerFrameGroups(
-    const std::string& filePath,
-    int numberOfFrames,
-    const EnhancedSeriesInfo& sharedInfo)
+std::vector<EnhancedFrameInfo> parsePerFrameGroupsFromDom(
+    const std::string& filePath, int numberOfFrames)
 {
-    LOG_DEBUG(std::format("Parsing per-frame functional groups ({} frames)",
-                         numberOfFrames));
-
     std::vector<EnhancedFrameInfo> frames(numberOfFrames);
 
     // Initialize with shared defaults
@@ -388,4 +950,178 @@ std::vector<EnhancedFrameInfo> FunctionalGroupParser::parsePerFrameGroups(
     return frames;
 }
 
+}  // anonymous namespace
+
+// =============================================================================
+// FrameMetadataTable
+// =============================================================================
+
+std::vector<EnhancedFrameInfo> FrameMetadataTable::toFrameInfos() const
+{
+    std::vector<EnhancedFrameInfo> frames(static_cast<size_t>(numberOfFrames));
+    for (size_t i = 0; i < frames.size(); ++i) {
+        auto& frame = frames[i];
+        frame.frameIndex = static_cast<int>(i);
+        std::copy_n(imagePositions.begin() + i * 3, 3,
+                    frame.imagePosition.begin());
+        std::copy_n(imageOrientations.begin() + i * 6, 6,
+                    frame.imageOrientation.begin());
+        frame.rescaleSlope = rescaleSlopes[i];
+        frame.rescaleIntercept = rescaleIntercepts[i];
+        if (fields[i] & HasTriggerTime) {
+            frame.triggerTime = triggerTimes[i];
+        }
+        if (fields[i] & HasTemporalPosition) {
+            frame.temporalPositionIndex = temporalPositionIndices[i];
+        }
+
+        // Ordinal keys for DimensionIndexValues, as in the DOM parser
+        const uint32_t begin = dimensionValueOffsets[i];
+        for (uint32_t j = begin; j < dimensionValueOffsets[i + 1]; ++j) {
+            frame.dimensionIndices[j - begin] =
+                static_cast<int>(dimensionIndexValues[j]);
+        }
+        if (fields[i] & HasInStackPosition) {
+            frame.dimensionIndices[kInStackPositionNumber.GetElementTag()] =
+                inStackPositions[i];
+        }
+    }
+    return frames;
+}
+
+void FrameMetadataTable::applySharedGroups(EnhancedSeriesInfo& info) const
+{
+    if (shared.pixelSpacing) {
+        info.pixelSpacingX = (*shared.pixelSpacing)[0];
+        info.pixelSpacingY = (*shared.pixelSpacing)[1];
+    }
+    for (auto& frame : info.frames) {
+        if (shared.sliceThickness) {
+            frame.sliceThickness = *shared.sliceThickness;
+        }
+        if (shared.hasPixelValueTransformation) {
+            frame.rescaleSlope = shared.rescaleSlope;
+            frame.rescaleIntercept = shared.rescaleIntercept;
+        }
+        if (shared.imageOrientation) {
+            frame.imageOrientation = *shared.imageOrientation;
+        }
+    }
+}
+
+// =============================================================================
+// FunctionalGroupParser
+// =============================================================================
+
+class FunctionalGroupParser::Impl {
+public:
+};
+
+FunctionalGroupParser::FunctionalGroupParser()
+    : impl_(std::make_unique<Impl>()) {}
+
+FunctionalGroupParser::~FunctionalGroupParser() = default;
+
+FunctionalGroupParser::FunctionalGroupParser(FunctionalGroupParser&&) noexcept
+    = default;
+FunctionalGroupParser& FunctionalGroupParser::operator=(
+    FunctionalGroupParser&&) noexcept = default;
+
+void FunctionalGroupParser::parseSharedGroups(const std::string& filePath,
+                                              EnhancedSeriesInfo& info)
+{
+    LOG_DEBUG(std::format("Parsing shared functional groups from: {}", filePath));
+
+    auto table = scanFrameTable(filePath, 0);
+    if (!table) {
+        LOG_DEBUG(std::format("{}; using GDCM reader", table.error().toString()));
+        parseSharedGroupsFromDom(filePath, info);
+        return;
+    }
+
+    if (!table->shared.present) {
+        LOG_DEBUG("No SharedFunctionalGroupsSequence found");
+        return;
+    }
+    table->applySharedGroups(info);
+    LOG_DEBUG(std::format("Shared pixel spacing: {}x{}", info.pixelSpacingX,
+                         info.pixelSpacingY));
+}
+
+std::vector<EnhancedFrameInfo> FunctionalGroupParser::parsePerFrameGroups(
+    const std::string& filePath,
+    int numberOfFrames,
+    const EnhancedSeriesInfo& /*sharedInfo*/)
+{
+    LOG_DEBUG(std::format("Parsing per-frame functional groups ({} frames)",
+                         numberOfFrames));
+
+    if (numberOfFrames <= 0) {
+        return {};
+    }
+
+    auto table = scanFrameTable(filePath, numberOfFrames);
+    if (!table) {
+        LOG_DEBUG(std::format("{}; using GDCM reader", table.error().toString()));
+        return parsePerFrameGroupsFromDom(filePath, numberOfFrames);
+    }
+
+    LOG_DEBUG(std::format("Parsed per-frame groups for {} frames",
+                         table->perFrameItemCount));
+    return table->toFrameInfos();
+}
+
+std::expected<FrameMetadataTable, EnhancedDicomError>
+FunctionalGroupParser::scanFrameTable(const std::string& filePath,
+                                      int numberOfFrames)
+{
+    ElementStream stream(filePath);
+    if (!stream.openDataSet()) {
+        return std::unexpected(EnhancedDicomError{
+            EnhancedDicomError::Code::ParseFailed,
+            "Streaming header scan not supported for: " + filePath
+        });
+    }
+
+    FrameMetadataTable table;
+    initializeTable(table, numberOfFrames);
+
+    ElementHeader header;
+    bool ok = true;
+    // Top-level elements are in ascending tag order, so everything needed
+    // precedes the end of the per-frame sequence; Pixel Data is never read
+    while (ok && stream.readHeader(header)) {
+        if (header.tag == kPerFrameFunctionalGroups) {
+            if (table.numberOfFrames > 0) {
+                ok = parsePerFrameGroupsStream(stream, header, table);
+            }
+            break;
+        }
+        if (kPerFrameFunctionalGroups < header.tag) {
+            break;
+        }
+        if (header.tag == kDimensionIndexSequence) {
+            ok = parseDimensionIndexStream(stream, header, table.dimensions);
+        } else if (header.tag == kSharedFunctionalGroups) {
+            ok = parseSharedGroupsStream(stream, header, table.shared);
+        } else {
+            ok = skipValue(stream, header);
+        }
+    }
+
+    if (!ok) {
+        return std::unexpected(EnhancedDicomError{
+            EnhancedDicomError::Code::ParseFailed,
+            "Malformed functional group encoding in: " + filePath
+        });
+    }
+
+    // Frames without a per-frame item carry no dimension index values
+    for (size_t i = static_cast<size_t>(table.perFrameItemCount);
+         i < static_cast<size_t>(table.numberOfFrames); ++i) {
+        table.dimensionValueOffsets[i + 1] = table.dimensionValueOffsets[i];
+    }
+    return table;
+}
+
 }  // namespace dicom_viewer::services
@@ -29,12 +29,13 @@
 
 #include "services/enhanced_dicom/series_classifier.hpp"
 
+#include "core/dicom_loader.hpp"
+#include "core/parallel_for.hpp"
 #include "core/series_builder.hpp"
 
 #include <algorithm>
 #include <string>
 
-#include <itkGDCMImageIO.h>
 #include <itkMetaDataObject.h>
 
 namespace {
@@ -56,14 +57,6 @@ std::string toUpper(std::string s) {
     return s;
 }
 
-/// Read DICOM metadata from a file via GDCMImageIO
-itk::MetaDataDictionary readDicomMetadata(const std::string& filePath) {
-    auto gdcmIO = itk::GDCMImageIO::New();
-    gdcmIO->SetFileName(filePath.c_str());
-    gdcmIO->ReadImageInformation();
-    return gdcmIO->GetMetaDataDictionary();
-}
-
 // =========================================================================
 // DICOM tag keys (format: "GROUP|ELEMENT")
 // =========================================================================
@@ -80,6 +73,7 @@ constexpr const char* kNumberOfFrames     = "0028|0008";
 constexpr const char* kSiemensFlowDir     = "0051|1014";
 constexpr const char* kPhilipsPrivateVenc = "2001|101a";
 constexpr const char* kGEPrivateVenc      = "0019|10cc";
+constexpr const char* kVelocityEncoding   = "0018|9197";
 
 using dicom_viewer::services::SeriesType;
 
@@ -117,7 +111,7 @@ SeriesType detect4DFlowDirection(const itk::MetaDataDictionary& dict) {
 
     if (!isPhase) {
         // If no phase/magnitude indicator, check for any velocity encoding
-        auto venc = getMetaString(dict, "0018|9197");
+        auto venc = getMetaString(dict, kVelocityEncoding);
         if (venc.empty()) {
             return SeriesType::Flow4D_Magnitude;
         }
@@ -207,17 +201,48 @@ bool is2DSeries(const itk::MetaDataDictionary& dict) {
     }
 }
 
+/// Expose scanned header attributes under the keys GDCMImageIO uses, so
+/// both entry points share one set of classification rules
+itk::MetaDataDictionary toDictionary(
+    const dicom_viewer::core::DicomMetadata& meta) {
+    itk::MetaDataDictionary dict;
+    auto put = [&dict](const char* key, const std::string& value) {
+        if (!value.empty()) {
+            itk::EncapsulateMetaData<std::string>(dict, key, value);
+        }
+    };
+    put(kModality, meta.modality);
+    put(kImageType, meta.imageType);
+    put(kSeriesDescription, meta.seriesDescription);
+    put(kSeriesInstanceUID, meta.seriesInstanceUid);
+    put(kScanningSequence, meta.scanningSequence);
+    put(kPhaseContrast, meta.phaseContrast);
+    put(kNumberOfFrames, meta.numberOfFrames);
+    put(kVelocityEncoding, meta.velocityEncoding);
+    put(kSiemensFlowDir, meta.siemensFlowDirection);
+    put(kPhilipsPrivateVenc, meta.philipsVelocityEncoding);
+    put(kGEPrivateVenc, meta.geVelocityEncoding);
+    return dict;
+}
+
 }  // anonymous namespace
 
 namespace dicom_viewer::services {
 
 ClassifiedSeries SeriesClassifier::classifyFile(const std::string& filePath) {
     try {
-        auto dict = readDicomMetadata(filePath);
-        return classify(dict);
+        auto header = core::DicomLoader::readHeader(filePath);
+        if (header) {
+            return classifyMetadata(header->metadata);
+        }
     } catch (...) {
-        return ClassifiedSeries{SeriesType::Unknown, "", "", "", false};
     }
+    return ClassifiedSeries{SeriesType::Unknown, "", "", "", false};
+}
+
+ClassifiedSeries SeriesClassifier::classifyMetadata(
+    const core::DicomMetadata& metadata) {
+    return classify(toDictionary(metadata));
 }
 
 ClassifiedSeries SeriesClassifier::classify(
@@ -329,33 +354,43 @@ ClassifiedSeries SeriesClassifier::classify(
 }
 
 std::vector<ClassifiedSeries> SeriesClassifier::classifyStudy(
-    const std::vector<std::string>& seriesFiles) {
-    std::vector<ClassifiedSeries> results;
-    results.reserve(seriesFiles.size());
-    for (const auto& file : seriesFiles) {
-        results.push_back(classifyFile(file));
-    }
+    const std::vector<std::string>& seriesFiles, size_t threadCount) {
+    std::vector<ClassifiedSeries> results(seriesFiles.size());
+    core::parallelFor(seriesFiles.size(), threadCount, [&](size_t i) {
+        results[i] = classifyFile(seriesFiles[i]);
+    });
     return results;
 }
 
 std::vector<ClassifiedSeries> SeriesClassifier::classifyScannedSeries(
-    const std::vector<core::SeriesInfo>& scannedSeries) {
-    std::vector<ClassifiedSeries> results;
-    results.reserve(scannedSeries.size());
-    for (const auto& info : scannedSeries) {
-        if (info.slices.empty()) {
-            results.push_back(ClassifiedSeries{
+    const std::vector<core::SeriesInfo>& scannedSeries, size_t threadCount) {
+    std::vector<ClassifiedSeries> results(scannedSeries.size());
+
+    // Series scanned with header attributes need no I/O; only the rest
+    // are handed to the worker pool
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < scannedSeries.size(); ++i) {
+        const auto& info = scannedSeries[i];
+        if (info.metadata.hasAcquisitionAttributes) {
+            results[i] = classifyMetadata(info.metadata);
+        } else if (info.slices.empty()) {
+            results[i] = ClassifiedSeries{
                 SeriesType::Unknown,
                 info.seriesInstanceUid,
                 info.seriesDescription,
                 info.modality,
                 false
-            });
+            };
         } else {
-            results.push_back(
-                classifyFile(info.slices.front().filePath.string()));
+            pending.push_back(i);
         }
     }
+
+    core::parallelFor(pending.size(), threadCount, [&](size_t k) {
+        const auto& info = scannedSeries[pending[k]];
+        results[pending[k]] =
+            classifyFile(info.slices.front().filePath.string());
+    });
     return results;
 }
 
@@ -0,0 +1,329 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "services/flow/compact_velocity_phase.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace dicom_viewer::services {
+
+namespace {
+
+constexpr float kInt16Max = 32767.0f;
+
+/// Relative rounding error of IEEE half precision (2^-11)
+constexpr double kHalfRelativeError = 1.0 / 2048.0;
+
+/// Largest finite IEEE half value
+constexpr float kHalfMax = 65504.0f;
+
+template <typename TImage>
+CompactImageGeometry geometryOf(const TImage* image) {
+    CompactImageGeometry geometry;
+    const auto size = image->GetLargestPossibleRegion().GetSize();
+    const auto& spacing = image->GetSpacing();
+    const auto& origin = image->GetOrigin();
+    const auto& direction = image->GetDirection();
+    for (unsigned int i = 0; i < 3; ++i) {
+        geometry.size[i] = size[i];
+        geometry.spacing[i] = spacing[i];
+        geometry.origin[i] = origin[i];
+        for (unsigned int j = 0; j < 3; ++j) {
+            geometry.direction[i * 3 + j] = direction[i][j];
+        }
+    }
+    return geometry;
+}
+
+template <typename TImage>
+typename TImage::Pointer allocateFrom(const CompactImageGeometry& geometry,
+                                      unsigned int componentsPerPixel = 1) {
+    typename TImage::SizeType size;
+    typename TImage::SpacingType spacing;
+    typename TImage::PointType origin;
+    typename TImage::DirectionType direction;
+    for (unsigned int i = 0; i < 3; ++i) {
+        size[i] = geometry.size[i];
+        spacing[i] = geometry.spacing[i];
+        origin[i] = geometry.origin[i];
+        for (unsigned int j = 0; j < 3; ++j) {
+            direction[i][j] = geometry.direction[i * 3 + j];
+        }
+    }
+
+    typename TImage::IndexType start;
+    start.Fill(0);
+
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::RegionType(start, size));
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    image->SetDirection(direction);
+    if constexpr (std::is_same_v<TImage, VectorImage3D>) {
+        image->SetNumberOfComponentsPerPixel(componentsPerPixel);
+    }
+    image->Allocate();
+    return image;
+}
+
+float peakMagnitude(const float* values, size_t count) {
+    float peak = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        peak = std::max(peak, std::abs(values[i]));
+    }
+    return peak;
+}
+
+/// Encode @p count floats; returns the decode scale
+float encodeValues(const float* values, size_t count, PhaseStorageFormat format,
+                   float peak, std::vector<uint16_t>& out) {
+    out.resize(count);
+    if (format == PhaseStorageFormat::QuantizedInt16) {
+        const float scale = peak > 0.0f ? peak / kInt16Max : 1.0f;
+        const float inverse = 1.0f / scale;
+        for (size_t i = 0; i < count; ++i) {
+            const float q = std::clamp(std::nearbyint(values[i] * inverse),
+                                       -kInt16Max, kInt16Max);
+            out[i] = static_cast<uint16_t>(static_cast<int16_t>(q));
+        }
+        return scale;
+    }
+
+    // Scale by a power of two only when the peak exceeds the half range,
+    // so the relative error is unchanged and nothing overflows to Inf
+    float scale = 1.0f;
+    while (peak / scale > kHalfMax) {
+        scale *= 2.0f;
+    }
+    const float inverse = 1.0f / scale;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = floatToHalf(values[i] * inverse);
+    }
+    return scale;
+}
+
+}  // anonymous namespace
+
+// =============================================================================
+// Half precision conversion
+// =============================================================================
+
+uint16_t floatToHalf(float value) noexcept {
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+    if (absBits >= 0x7F800000u) {
+        // Inf stays Inf; NaN keeps a quiet payload bit
+        return static_cast<uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x200u : 0u));
+    }
+    if (absBits >= 0x477FF000u) {
+        // Rounds to a value above the largest half (65504)
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (absBits < 0x38800000u) {
+        // Subnormal half (or zero): shift the implicit-one mantissa into place
+        if (absBits < 0x33000000u) {
+            return static_cast<uint16_t>(sign);
+        }
+        const uint32_t exponent = absBits >> 23;
+        const uint32_t mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+        const uint32_t shift = 126u - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // Normal: rebias exponent, round mantissa to 10 bits (nearest even)
+    uint32_t half = ((absBits - 0x38000000u) >> 13);
+    const uint32_t remainder = absBits & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t bits) noexcept {
+    const uint32_t sign = static_cast<uint32_t>(bits & 0x8000u) << 16;
+    const uint32_t exponent = (bits >> 10) & 0x1Fu;
+    const uint32_t mantissa = bits & 0x3FFu;
+
+    if (exponent == 0) {
+        // Zero or subnormal: value = mantissa * 2^-24
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+}
+
+// =============================================================================
+// CompactVelocityPhase
+// =============================================================================
+
+float CompactVelocityPhase::decode(uint16_t stored, float scale) const noexcept {
+    if (format == PhaseStorageFormat::QuantizedInt16) {
+        return static_cast<float>(static_cast<int16_t>(stored)) * scale;
+    }
+    return halfToFloat(stored) * (scale > 0.0f ? scale : 1.0f);
+}
+
+std::array<float, 3> CompactVelocityPhase::velocityAt(size_t voxel) const noexcept {
+    const uint16_t* v = velocity.data() + voxel * 3;
+    return {decode(v[0], velocityScale), decode(v[1], velocityScale),
+            decode(v[2], velocityScale)};
+}
+
+float CompactVelocityPhase::magnitudeAt(size_t voxel) const noexcept {
+    return decode(magnitude[voxel], magnitudeScale);
+}
+
+double CompactVelocityPhase::velocityErrorBound() const noexcept {
+    if (format == PhaseStorageFormat::QuantizedInt16) {
+        return velocityScale * 0.5;
+    }
+    return velocityPeak * kHalfRelativeError;
+}
+
+// =============================================================================
+// Encoding / decoding
+// =============================================================================
+
+CompactVelocityPhase compressPhase(
+    const VelocityPhase& phase, PhaseStorageFormat format, double venc) {
+    CompactVelocityPhase compact;
+    compact.format = format == PhaseStorageFormat::QuantizedInt16
+        ? PhaseStorageFormat::QuantizedInt16
+        : PhaseStorageFormat::Float16;
+    compact.phaseIndex = phase.phaseIndex;
+    compact.triggerTime = phase.triggerTime;
+
+    if (phase.velocityField) {
+        const auto* field = phase.velocityField.GetPointer();
+        compact.hasVelocity = true;
+        compact.velocityGeometry = geometryOf(field);
+        const size_t count = compact.velocityGeometry.voxelCount()
+                           * field->GetNumberOfComponentsPerPixel();
+        const float* values = field->GetBufferPointer();
+        compact.velocityPeak = peakMagnitude(values, count);
+        const float range = std::max(compact.velocityPeak, static_cast<float>(venc));
+        compact.velocityScale =
+            encodeValues(values, count, compact.format, range, compact.velocity);
+    }
+
+    if (phase.magnitudeImage) {
+        const auto* image = phase.magnitudeImage.GetPointer();
+        compact.hasMagnitude = true;
+        compact.magnitudeGeometry = geometryOf(image);
+        const size_t count = compact.magnitudeGeometry.voxelCount();
+        const float* values = image->GetBufferPointer();
+        compact.magnitudeScale = encodeValues(
+            values, count, compact.format, peakMagnitude(values, count),
+            compact.magnitude);
+    }
+
+    return compact;
+}
+
+VelocityPhase decompressPhase(const CompactVelocityPhase& compact) {
+    VelocityPhase phase;
+    phase.phaseIndex = compact.phaseIndex;
+    phase.triggerTime = compact.triggerTime;
+
+    if (compact.hasVelocity) {
+        phase.velocityField = allocateFrom<VectorImage3D>(compact.velocityGeometry, 3);
+        float* out = phase.velocityField->GetBufferPointer();
+        const size_t voxels = compact.velocityGeometry.voxelCount();
+        for (size_t v = 0; v < voxels; ++v) {
+            const auto vec = compact.velocityAt(v);
+            std::copy(vec.begin(), vec.end(), out + v * 3);
+        }
+    }
+
+    if (compact.hasMagnitude) {
+        phase.magnitudeImage = allocateFrom<FloatImage3D>(compact.magnitudeGeometry);
+        float* out = phase.magnitudeImage->GetBufferPointer();
+        for (size_t i = 0; i < compact.magnitude.size(); ++i) {
+            out[i] = compact.magnitudeAt(i);
+        }
+    }
+
+    return phase;
+}
+
+QuantizationError measureQuantizationError(
+    const VelocityPhase& phase, PhaseStorageFormat format, double venc) {
+    QuantizationError error;
+    if (!phase.velocityField) {
+        return error;
+    }
+
+    auto compact = compressPhase(phase, format, venc);
+    const float* original = phase.velocityField->GetBufferPointer();
+    const size_t voxels = compact.velocityGeometry.voxelCount();
+    double sumSquared = 0.0;
+    for (size_t v = 0; v < voxels; ++v) {
+        const auto decoded = compact.velocityAt(v);
+        for (size_t c = 0; c < 3; ++c) {
+            const double diff = static_cast<double>(decoded[c])
+                              - static_cast<double>(original[v * 3 + c]);
+            error.maxAbsError = std::max(error.maxAbsError, std::abs(diff));
+            sumSquared += diff * diff;
+        }
+    }
+    if (!compact.velocity.empty()) {
+        error.rmsError = std::sqrt(sumSquared / static_cast<double>(compact.velocity.size()));
+    }
+    error.compressionRatio = static_cast<double>(phaseMemoryBytes(phase))
+                           / static_cast<double>(compact.memoryBytes());
+    return error;
+}
+
+size_t phaseMemoryBytes(const VelocityPhase& phase) noexcept {
+    size_t bytes = sizeof(VelocityPhase);
+    if (phase.velocityField) {
+        bytes += phase.velocityField->GetPixelContainer()->Size() * sizeof(float);
+    }
+    if (phase.magnitudeImage) {
+        bytes += phase.magnitudeImage->GetPixelContainer()->Size() * sizeof(float);
+    }
+    return bytes;
+}
+
+}  // namespace dicom_viewer::services
@@ -29,11 +29,14 @@
 
 #include "services/flow/flow_quantifier.hpp"
 
+#include "core/parallel_for.hpp"
+
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <limits>
 #include <numeric>
 
 #include <kcenon/common/logging/log_macros.h>
@@ -56,109 +59,75 @@ void computePlaneBasis(const std::array<double, 3>& normal,
     v = FlowQuantifier::normalize(FlowQuantifier::crossProduct(normal, u));
 }
 
-}  // anonymous namespace
-
-namespace dicom_viewer::services {
-
-// =============================================================================
-// FlowQuantifier::Impl
-// =============================================================================
-
-class FlowQuantifier::Impl {
-public:
-    MeasurementPlane plane;
-};
-
-// =============================================================================
-// Lifecycle
-// =============================================================================
-
-FlowQuantifier::FlowQuantifier()
-    : impl_(std::make_unique<Impl>()) {}
-
-FlowQuantifier::~FlowQuantifier() = default;
-
-FlowQuantifier::FlowQuantifier(FlowQuantifier&&) noexcept = default;
-FlowQuantifier& FlowQuantifier::operator=(FlowQuantifier&&) noexcept = default;
-
-// =============================================================================
-// Measurement plane configuration
-// =============================================================================
-
-void FlowQuantifier::setMeasurementPlane(const MeasurementPlane& plane) {
-    impl_->plane = plane;
-    // Ensure normal is unit vector
-    impl_->plane.normal = normalize(plane.normal);
-}
-
-void FlowQuantifier::setMeasurementPlaneFrom3Points(
-    const std::array<double, 3>& p1,
-    const std::array<double, 3>& p2,
-    const std::array<double, 3>& p3) {
-
-    // Edge vectors
-    std::array<double, 3> e1 = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]};
-    std::array<double, 3> e2 = {p3[0] - p1[0], p3[1] - p1[1], p3[2] - p1[2]};
-
-    // Normal = e1 × e2
-    auto normal = normalize(crossProduct(e1, e2));
-
-    // Center = centroid
-    std::array<double, 3> center = {
-        (p1[0] + p2[0] + p3[0]) / 3.0,
-        (p1[1] + p2[1] + p3[1]) / 3.0,
-        (p1[2] + p2[2] + p3[2]) / 3.0
-    };
-
-    impl_->plane.center = center;
-    impl_->plane.normal = normal;
-}
-
-MeasurementPlane FlowQuantifier::measurementPlane() const {
-    return impl_->plane;
-}
+using dicom_viewer::services::FlowError;
+using dicom_viewer::services::FlowMeasurement;
+using dicom_viewer::services::MeasurementPlane;
+using dicom_viewer::services::TimeVelocityCurve;
+using dicom_viewer::services::VectorImage3D;
+using dicom_viewer::services::VelocityPhase;
 
-// =============================================================================
-// Core flow measurement
-// =============================================================================
-
-std::expected<FlowMeasurement, FlowError>
-FlowQuantifier::measureFlow(const VelocityPhase& phase) const {
+std::expected<void, FlowError> validatePhase(const VelocityPhase& phase) {
     if (!phase.velocityField) {
         return std::unexpected(FlowError{
             FlowError::Code::InvalidInput,
             "VelocityPhase has null velocity field"});
     }
-
-    auto image = phase.velocityField;
-    if (image->GetNumberOfComponentsPerPixel() != 3) {
+    if (phase.velocityField->GetNumberOfComponentsPerPixel() != 3) {
         return std::unexpected(FlowError{
             FlowError::Code::InvalidInput,
             "Expected 3-component velocity field"});
     }
+    return {};
+}
 
-    const auto& center = impl_->plane.center;
-    const auto& normal = impl_->plane.normal;
-    double radius = impl_->plane.radius;
-    double spacing = std::max(0.1, impl_->plane.sampleSpacing);
+/**
+ * @brief Voxels sampled by one measurement plane on one image grid
+ *
+ * The plane's sample points and their nearest-voxel lookups depend only on
+ * the plane and the image geometry, so they are resolved once and reused
+ * for every phase acquired on the same grid.
+ */
+struct PlaneSampler {
+    std::array<double, 3> normal = {0, 0, 1};
+    double pixelAreaCm2 = 0.0;
+    double pixelAreaMm2 = 0.0;
+    std::vector<size_t> voxels;  ///< Linear voxel index of each in-bounds sample
+
+    VectorImage3D::RegionType region;
+    VectorImage3D::SpacingType spacing;
+    VectorImage3D::PointType origin;
+    VectorImage3D::DirectionType direction;
+
+    [[nodiscard]] bool matches(const VectorImage3D& image) const {
+        return region == image.GetLargestPossibleRegion()
+            && spacing == image.GetSpacing()
+            && origin == image.GetOrigin()
+            && direction == image.GetDirection();
+    }
+};
 
-    // Compute plane basis vectors
-    std::array<double, 3> u, v;
-    computePlaneBasis(normal, u, v);
+PlaneSampler buildPlaneSampler(const MeasurementPlane& plane, const VectorImage3D& image) {
+    using dicom_viewer::services::FlowQuantifier;
 
-    // Sample velocity field at grid points on the plane
-    double sumThroughPlane = 0.0;
-    double sumThroughPlaneSq = 0.0;
-    double maxThroughPlane = 0.0;
-    double minThroughPlane = std::numeric_limits<double>::max();
-    int sampleCount = 0;
+    PlaneSampler sampler;
+    sampler.normal = plane.normal;
+    sampler.region = image.GetLargestPossibleRegion();
+    sampler.spacing = image.GetSpacing();
+    sampler.origin = image.GetOrigin();
+    sampler.direction = image.GetDirection();
+
+    const auto& center = plane.center;
+    double radius = plane.radius;
+    double spacing = std::max(0.1, plane.sampleSpacing);
 
     // Pixel area in cm^2 (spacing in mm → spacing/10 in cm)
-    double pixelAreaCm2 = (spacing / 10.0) * (spacing / 10.0);
+    sampler.pixelAreaCm2 = (spacing / 10.0) * (spacing / 10.0);
     // Pixel area in mm^2 (spacing in mm)
-    double pixelAreaMm2 = spacing * spacing;
+    sampler.pixelAreaMm2 = spacing * spacing;
 
-    auto region = image->GetLargestPossibleRegion();
+    // Compute plane basis vectors
+    std::array<double, 3> u, v;
+    computePlaneBasis(plane.normal, u, v);
 
     for (double si = -radius; si <= radius; si += spacing) {
         for (double sj = -radius; sj <= radius; sj += spacing) {
@@ -173,27 +142,42 @@ FlowQuantifier::measureFlow(const VelocityPhase& phase) const {
 
             // Transform to image index (nearest-neighbor)
             VectorImage3D::IndexType index;
-            bool inBounds = image->TransformPhysicalPointToIndex(point, index);
+            bool inBounds = image.TransformPhysicalPointToIndex(point, index);
             if (!inBounds) continue;
-            if (!region.IsInside(index)) continue;
-
-            // Get velocity vector at this point
-            auto pixel = image->GetPixel(index);
-            std::array<double, 3> velocity = {
-                pixel[0], pixel[1], pixel[2]
-            };
-
-            // Through-plane velocity component (dot product with normal)
-            double vThrough = dotProduct(velocity, normal);
-
-            sumThroughPlane += vThrough;
-            sumThroughPlaneSq += vThrough * vThrough;
-            maxThroughPlane = std::max(maxThroughPlane, std::abs(vThrough));
-            minThroughPlane = std::min(minThroughPlane, std::abs(vThrough));
-            ++sampleCount;
+            if (!sampler.region.IsInside(index)) continue;
+
+            sampler.voxels.push_back(static_cast<size_t>(image.ComputeOffset(index)));
         }
     }
+    return sampler;
+}
 
+/// Through-plane statistics of one phase at the sampler's voxels
+FlowMeasurement sampleFlow(const PlaneSampler& sampler, const VelocityPhase& phase) {
+    using dicom_viewer::services::FlowQuantifier;
+
+    const float* buf = phase.velocityField->GetBufferPointer();
+    const auto& normal = sampler.normal;
+
+    double sumThroughPlane = 0.0;
+    double sumThroughPlaneSq = 0.0;
+    double maxThroughPlane = 0.0;
+    double minThroughPlane = std::numeric_limits<double>::max();
+
+    for (size_t voxel : sampler.voxels) {
+        const float* pixel = buf + voxel * 3;
+        std::array<double, 3> velocity = {pixel[0], pixel[1], pixel[2]};
+
+        // Through-plane velocity component (dot product with normal)
+        double vThrough = FlowQuantifier::dotProduct(velocity, normal);
+
+        sumThroughPlane += vThrough;
+        sumThroughPlaneSq += vThrough * vThrough;
+        maxThroughPlane = std::max(maxThroughPlane, std::abs(vThrough));
+        minThroughPlane = std::min(minThroughPlane, std::abs(vThrough));
+    }
+
+    const int sampleCount = static_cast<int>(sampler.voxels.size());
     FlowMeasurement result;
     result.phaseIndex = phase.phaseIndex;
     result.sampleCount = sampleCount;
@@ -202,10 +186,10 @@ FlowQuantifier::measureFlow(const VelocityPhase& phase) const {
         result.meanVelocity = sumThroughPlane / sampleCount;
         result.maxVelocity = maxThroughPlane;
         result.minVelocity = minThroughPlane;
-        result.crossSectionArea = sampleCount * pixelAreaCm2;
-        result.roiAreaMm2 = sampleCount * pixelAreaMm2;
+        result.crossSectionArea = sampleCount * sampler.pixelAreaCm2;
+        result.roiAreaMm2 = sampleCount * sampler.pixelAreaMm2;
         // Flow rate = mean_through_plane_velocity × area
-        result.flowRate = sumThroughPlane * pixelAreaCm2;  // mL/s
+        result.flowRate = sumThroughPlane * sampler.pixelAreaCm2;  // mL/s
 
         // Standard deviation of through-plane velocity
         double meanSq = sumThroughPlaneSq / sampleCount;
@@ -227,27 +211,19 @@ FlowQuantifier::measureFlow(const VelocityPhase& phase) const {
     return result;
 }
 
-// =============================================================================
-// Time-velocity curve computation
-// =============================================================================
-
-std::expected<TimeVelocityCurve, FlowError>
-FlowQuantifier::computeTimeVelocityCurve(
-    const std::vector<VelocityPhase>& phases,
-    double temporalResolution) const {
-
-    if (phases.empty()) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InvalidInput,
-            "No phases provided for time-velocity curve"});
-    }
-
-    if (temporalResolution <= 0.0) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InvalidInput,
-            "Temporal resolution must be positive"});
+/// Sample a phase, reusing @p sampler when the phase shares its grid
+FlowMeasurement sampleFlowOnGrid(const PlaneSampler& sampler, const MeasurementPlane& plane,
+                                 const VelocityPhase& phase) {
+    if (sampler.matches(*phase.velocityField)) {
+        return sampleFlow(sampler, phase);
     }
+    return sampleFlow(buildPlaneSampler(plane, *phase.velocityField), phase);
+}
 
+/// Assemble the curve and cycle volumes from per-phase measurements
+TimeVelocityCurve buildTimeVelocityCurve(const std::vector<VelocityPhase>& phases,
+                                         const std::vector<FlowMeasurement>& measurements,
+                                         double temporalResolution) {
     TimeVelocityCurve tvc;
     tvc.timePoints.reserve(phases.size());
     tvc.meanVelocities.reserve(phases.size());
@@ -260,27 +236,24 @@ FlowQuantifier::computeTimeVelocityCurve(
 
     double sumRoiArea = 0.0;
 
-    for (const auto& phase : phases) {
-        auto measurement = measureFlow(phase);
-        if (!measurement) {
-            return std::unexpected(measurement.error());
-        }
+    for (size_t p = 0; p < phases.size(); ++p) {
+        const auto& measurement = measurements[p];
 
-        tvc.timePoints.push_back(phase.triggerTime);
-        tvc.meanVelocities.push_back(measurement->meanVelocity);
-        tvc.maxVelocities.push_back(measurement->maxVelocity);
-        tvc.minVelocities.push_back(measurement->minVelocity);
-        tvc.stdVelocities.push_back(measurement->stdVelocity);
-        tvc.flowRates.push_back(measurement->flowRate);
+        tvc.timePoints.push_back(phases[p].triggerTime);
+        tvc.meanVelocities.push_back(measurement.meanVelocity);
+        tvc.maxVelocities.push_back(measurement.maxVelocity);
+        tvc.minVelocities.push_back(measurement.minVelocity);
+        tvc.stdVelocities.push_back(measurement.stdVelocity);
+        tvc.flowRates.push_back(measurement.flowRate);
 
         // Per-pixel flow stats: min flow = minVelocity * pixelArea
-        double pixelAreaCm2 = (measurement->sampleCount > 0)
-            ? measurement->crossSectionArea / measurement->sampleCount
+        double pixelAreaCm2 = (measurement.sampleCount > 0)
+            ? measurement.crossSectionArea / measurement.sampleCount
             : 0.0;
-        tvc.minFlowRates.push_back(measurement->minVelocity * pixelAreaCm2);
-        tvc.stdFlowRates.push_back(measurement->stdVelocity * pixelAreaCm2);
+        tvc.minFlowRates.push_back(measurement.minVelocity * pixelAreaCm2);
+        tvc.stdFlowRates.push_back(measurement.stdVelocity * pixelAreaCm2);
 
-        sumRoiArea += measurement->roiAreaMm2;
+        sumRoiArea += measurement.roiAreaMm2;
     }
 
     tvc.meanRoiArea = phases.empty() ? 0.0 : sumRoiArea / phases.size();
@@ -315,6 +288,152 @@ FlowQuantifier::computeTimeVelocityCurve(
     return tvc;
 }
 
+}  // anonymous namespace
+
+namespace dicom_viewer::services {
+
+// =============================================================================
+// FlowQuantifier::Impl
+// =============================================================================
+
+class FlowQuantifier::Impl {
+public:
+    MeasurementPlane plane;
+};
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+FlowQuantifier::FlowQuantifier()
+    : impl_(std::make_unique<Impl>()) {}
+
+FlowQuantifier::~FlowQuantifier() = default;
+
+FlowQuantifier::FlowQuantifier(FlowQuantifier&&) noexcept = default;
+FlowQuantifier& FlowQuantifier::operator=(FlowQuantifier&&) noexcept = default;
+
+// =============================================================================
+// Measurement plane configuration
+// =============================================================================
+
+void FlowQuantifier::setMeasurementPlane(const MeasurementPlane& plane) {
+    impl_->plane = plane;
+    // Ensure normal is unit vector
+    impl_->plane.normal = normalize(plane.normal);
+}
+
+void FlowQuantifier::setMeasurementPlaneFrom3Points(
+    const std::array<double, 3>& p1,
+    const std::array<double, 3>& p2,
+    const std::array<double, 3>& p3) {
+
+    // Edge vectors
+    std::array<double, 3> e1 = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]};
+    std::array<double, 3> e2 = {p3[0] - p1[0], p3[1] - p1[1], p3[2] - p1[2]};
+
+    // Normal = e1 × e2
+    auto normal = normalize(crossProduct(e1, e2));
+
+    // Center = centroid
+    std::array<double, 3> center = {
+        (p1[0] + p2[0] + p3[0]) / 3.0,
+        (p1[1] + p2[1] + p3[1]) / 3.0,
+        (p1[2] + p2[2] + p3[2]) / 3.0
+    };
+
+    impl_->plane.center = center;
+    impl_->plane.normal = normal;
+}
+
+MeasurementPlane FlowQuantifier::measurementPlane() const {
+    return impl_->plane;
+}
+
+// =============================================================================
+// Core flow measurement
+// =============================================================================
+
+std::expected<FlowMeasurement, FlowError>
+FlowQuantifier::measureFlow(const VelocityPhase& phase) const {
+    if (auto valid = validatePhase(phase); !valid) {
+        return std::unexpected(valid.error());
+    }
+    return sampleFlow(buildPlaneSampler(impl_->plane, *phase.velocityField), phase);
+}
+
+// =============================================================================
+// Time-velocity curve computation
+// =============================================================================
+
+std::expected<TimeVelocityCurve, FlowError>
+FlowQuantifier::computeTimeVelocityCurve(
+    const std::vector<VelocityPhase>& phases,
+    double temporalResolution) const {
+    auto curves = computeTimeVelocityCurves({impl_->plane}, phases, temporalResolution);
+    if (!curves) {
+        return std::unexpected(curves.error());
+    }
+    return std::move(curves->front());
+}
+
+std::expected<std::vector<TimeVelocityCurve>, FlowError>
+FlowQuantifier::computeTimeVelocityCurves(
+    const std::vector<MeasurementPlane>& planes,
+    const std::vector<VelocityPhase>& phases,
+    double temporalResolution,
+    size_t threadCount) const {
+
+    if (planes.empty()) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "No measurement planes provided"});
+    }
+
+    if (phases.empty()) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "No phases provided for time-velocity curve"});
+    }
+
+    if (temporalResolution <= 0.0) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "Temporal resolution must be positive"});
+    }
+
+    for (const auto& phase : phases) {
+        if (auto valid = validatePhase(phase); !valid) {
+            return std::unexpected(valid.error());
+        }
+    }
+
+    // Resolve every plane's sample voxels once on the first phase's grid
+    std::vector<MeasurementPlane> normalized(planes);
+    std::vector<PlaneSampler> samplers(planes.size());
+    const auto& reference = *phases.front().velocityField;
+    core::parallelFor(planes.size(), threadCount, [&](size_t i) {
+        normalized[i].normal = normalize(planes[i].normal);
+        samplers[i] = buildPlaneSampler(normalized[i], reference);
+    });
+
+    // One pass over the velocity data: each phase is read once for all planes
+    std::vector<std::vector<FlowMeasurement>> measurements(
+        planes.size(), std::vector<FlowMeasurement>(phases.size()));
+    core::parallelFor(phases.size(), threadCount, [&](size_t p) {
+        for (size_t i = 0; i < planes.size(); ++i) {
+            measurements[i][p] = sampleFlowOnGrid(samplers[i], normalized[i], phases[p]);
+        }
+    });
+
+    std::vector<TimeVelocityCurve> curves;
+    curves.reserve(planes.size());
+    for (size_t i = 0; i < planes.size(); ++i) {
+        curves.push_back(buildTimeVelocityCurve(phases, measurements[i], temporalResolution));
+    }
+    return curves;
+}
+
 // =============================================================================
 // Pressure gradient estimation
 // =============================================================================
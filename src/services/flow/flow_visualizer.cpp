@@ -28,6 +28,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "services/flow/flow_visualizer.hpp"
+#include "services/flow/streamline_integrator.hpp"
+#include "services/flow/temporal_navigator.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -43,7 +45,6 @@
 #include <vtkPointSource.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
-#include <vtkPolyLine.h>
 #include <vtkRungeKutta45.h>
 #include <vtkStreamTracer.h>
 #include <vtkTubeFilter.h>
@@ -52,6 +53,85 @@
 
 namespace dicom_viewer::services {
 
+namespace {
+
+/// Seed positions of a point source
+std::vector<std::array<double, 3>> seedPositions(vtkPointSource* source) {
+    std::vector<std::array<double, 3>> seeds;
+    auto* points = source->GetOutput()->GetPoints();
+    if (!points) {
+        return seeds;
+    }
+    seeds.resize(static_cast<size_t>(points->GetNumberOfPoints()));
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i) {
+        points->GetPoint(i, seeds[static_cast<size_t>(i)].data());
+    }
+    return seeds;
+}
+
+/**
+ * @brief Convert traced lines to polylines with velocity point data
+ *
+ * Lines with fewer than two points are dropped. Adds "velocity" vectors
+ * and "VelocityMagnitude" scalars, plus "TriggerTime" when @p withTime.
+ */
+vtkSmartPointer<vtkPolyData> linesToPolyData(const std::vector<TracedLine>& traced,
+                                             bool withTime) {
+    vtkIdType totalPoints = 0;
+    for (const auto& line : traced) {
+        if (line.points.size() >= 2) {
+            totalPoints += static_cast<vtkIdType>(line.points.size());
+        }
+    }
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetNumberOfPoints(totalPoints);
+    auto lines = vtkSmartPointer<vtkCellArray>::New();
+
+    auto velocities = vtkSmartPointer<vtkFloatArray>::New();
+    velocities->SetName("velocity");
+    velocities->SetNumberOfComponents(3);
+    velocities->SetNumberOfTuples(totalPoints);
+
+    auto magnitudes = vtkSmartPointer<vtkFloatArray>::New();
+    magnitudes->SetName("VelocityMagnitude");
+    magnitudes->SetNumberOfTuples(totalPoints);
+
+    auto times = vtkSmartPointer<vtkFloatArray>::New();
+    times->SetName("TriggerTime");
+    if (withTime) {
+        times->SetNumberOfTuples(totalPoints);
+    }
+
+    vtkIdType next = 0;
+    for (const auto& line : traced) {
+        if (line.points.size() < 2) continue;
+        lines->InsertNextCell(static_cast<int>(line.points.size()));
+        for (size_t i = 0; i < line.points.size(); ++i, ++next) {
+            const auto& v = line.velocities[i];
+            points->SetPoint(next, line.points[i].data());
+            velocities->SetTuple3(next, v[0], v[1], v[2]);
+            magnitudes->SetValue(next, std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]));
+            if (withTime) {
+                times->SetValue(next, line.times[i]);
+            }
+            lines->InsertCellPoint(next);
+        }
+    }
+
+    auto output = vtkSmartPointer<vtkPolyData>::New();
+    output->SetPoints(points);
+    output->SetLines(lines);
+    output->GetPointData()->SetVectors(velocities);
+    output->GetPointData()->SetScalars(magnitudes);
+    if (withTime) {
+        output->GetPointData()->AddArray(times);
+    }
+    return output;
+}
+
+}  // anonymous namespace
+
 // =============================================================================
 // FlowVisualizer::Impl
 // =============================================================================
@@ -59,6 +139,7 @@ namespace dicom_viewer::services {
 class FlowVisualizer::Impl {
 public:
     vtkSmartPointer<vtkImageData> velocityData;
+    SampledVelocityField sampledField;  ///< Flat copy for native integration
     SeedRegion seed;
     ColorMode colorMode_ = ColorMode::VelocityMagnitude;
     double velocityMin = 0.0;
@@ -106,6 +187,35 @@ public:
         source->Update();
         return source;
     }
+
+    /// Pathlines from phases supplied in order by @p provider
+    std::expected<vtkSmartPointer<vtkPolyData>, FlowError>
+    tracePathlinePolyData(const PhaseProvider& provider, int phaseCount,
+                          const PathlineParams& params) const {
+        auto seedSource = createSeedSource(params.maxSeedPoints);
+        auto seeds = seedPositions(seedSource);
+        if (seeds.empty()) {
+            return std::unexpected(FlowError{
+                FlowError::Code::InternalError,
+                "Failed to generate seed points"});
+        }
+
+        PathlineIntegrationOptions options;
+        options.maxSteps = params.maxSteps;
+        options.terminalSpeed = params.terminalSpeed;
+        options.threadCount = params.threadCount;
+
+        auto traced = tracePathlines(provider, phaseCount, seeds, options);
+        if (!traced) {
+            return std::unexpected(traced.error());
+        }
+
+        auto output = linesToPolyData(*traced, true);
+        LOG_INFO(std::format("Pathlines: {} lines, {} points from {} seeds",
+                             output->GetNumberOfCells(),
+                             output->GetNumberOfPoints(), seeds.size()));
+        return output;
+    }
 };
 
 // =============================================================================
@@ -131,7 +241,13 @@ FlowVisualizer::setVelocityField(const VelocityPhase& phase) {
         return std::unexpected(vtkData.error());
     }
 
+    auto sampled = SampledVelocityField::fromPhase(phase);
+    if (!sampled) {
+        return std::unexpected(sampled.error());
+    }
+
     impl_->velocityData = vtkData.value();
+    impl_->sampledField = std::move(sampled.value());
     impl_->hasField = true;
 
     // Auto-set seed region to image bounds if not configured
@@ -167,24 +283,39 @@ FlowVisualizer::generateStreamlines(const StreamlineParams& params) const {
     // Create seed points
     auto seedSource = impl_->createSeedSource(params.maxSeedPoints);
 
-    // Configure stream tracer with RK45 integrator
-    auto tracer = vtkSmartPointer<vtkStreamTracer>::New();
-    tracer->SetInputData(impl_->velocityData);
-    tracer->SetSourceConnection(seedSource->GetOutputPort());
-
-    auto integrator = vtkSmartPointer<vtkRungeKutta45>::New();
-    tracer->SetIntegrator(integrator);
-
-    tracer->SetMaximumPropagation(params.maxSteps * params.stepLength);
-    tracer->SetInitialIntegrationStep(params.stepLength);
-    tracer->SetIntegrationDirectionToBoth();
-    tracer->SetTerminalSpeed(params.terminalSpeed);
-    tracer->SetMaximumNumberOfSteps(params.maxSteps);
-    tracer->Update();
+    vtkSmartPointer<vtkPolyData> lines;
+    if (params.engine == StreamlineEngine::Native) {
+        StreamlineIntegrationOptions options;
+        options.stepLength = params.stepLength;
+        options.maxSteps = params.maxSteps;
+        options.maxPropagation = params.maxSteps * params.stepLength;
+        options.terminalSpeed = params.terminalSpeed;
+        options.adaptiveStep = params.adaptiveStep;
+        options.threadCount = params.threadCount;
+        lines = linesToPolyData(
+            traceStreamlines(impl_->sampledField, seedPositions(seedSource), options),
+            false);
+    } else {
+        // Configure stream tracer with RK45 integrator
+        auto tracer = vtkSmartPointer<vtkStreamTracer>::New();
+        tracer->SetInputData(impl_->velocityData);
+        tracer->SetSourceConnection(seedSource->GetOutputPort());
+
+        auto integrator = vtkSmartPointer<vtkRungeKutta45>::New();
+        tracer->SetIntegrator(integrator);
+
+        tracer->SetMaximumPropagation(params.maxSteps * params.stepLength);
+        tracer->SetInitialIntegrationStep(params.stepLength);
+        tracer->SetIntegrationDirectionToBoth();
+        tracer->SetTerminalSpeed(params.terminalSpeed);
+        tracer->SetMaximumNumberOfSteps(params.maxSteps);
+        tracer->Update();
+        lines = tracer->GetOutput();
+    }
 
     // Apply tube filter for 3D appearance
     auto tubeFilter = vtkSmartPointer<vtkTubeFilter>::New();
-    tubeFilter->SetInputConnection(tracer->GetOutputPort());
+    tubeFilter->SetInputData(lines);
     tubeFilter->SetRadius(params.tubeRadius);
     tubeFilter->SetNumberOfSides(params.tubeSides);
     tubeFilter->CappingOn();
@@ -200,7 +331,7 @@ FlowVisualizer::generateStreamlines(const StreamlineParams& params) const {
 }
 
 // =============================================================================
-// Pathline generation (manual Euler integration across phases)
+// Pathline generation (RK4 in time across phases)
 // =============================================================================
 
 std::expected<vtkSmartPointer<vtkPolyData>, FlowError>
@@ -212,99 +343,31 @@ FlowVisualizer::generatePathlines(const std::vector<VelocityPhase>& allPhases,
             "No phases provided for pathline generation"});
     }
 
-    // Convert all phases to VTK
-    std::vector<vtkSmartPointer<vtkImageData>> phaseData;
-    phaseData.reserve(allPhases.size());
-    for (const auto& phase : allPhases) {
-        auto vtkResult = velocityFieldToVTK(phase);
-        if (!vtkResult) {
-            return std::unexpected(vtkResult.error());
-        }
-        phaseData.push_back(vtkResult.value());
-    }
+    PhaseProvider provider = [&allPhases](int index)
+        -> std::expected<VelocityPhase, FlowError> {
+        return allPhases[static_cast<size_t>(index)];
+    };
+    return impl_->tracePathlinePolyData(
+        provider, static_cast<int>(allPhases.size()), params);
+}
 
-    // Create seed points
-    auto seedSource = impl_->createSeedSource(params.maxSeedPoints);
-    auto seedPoints = seedSource->GetOutput()->GetPoints();
-    if (!seedPoints || seedPoints->GetNumberOfPoints() == 0) {
+std::expected<vtkSmartPointer<vtkPolyData>, FlowError>
+FlowVisualizer::generatePathlines(PhaseCache& cache, int phaseCount,
+                                  const PathlineParams& params) const {
+    if (phaseCount <= 0) {
         return std::unexpected(FlowError{
-            FlowError::Code::InternalError,
-            "Failed to generate seed points"});
+            FlowError::Code::InvalidInput,
+            "No phases provided for pathline generation"});
     }
 
-    auto output = vtkSmartPointer<vtkPolyData>::New();
-    auto points = vtkSmartPointer<vtkPoints>::New();
-    auto lines = vtkSmartPointer<vtkCellArray>::New();
-
-    auto timeScalars = vtkSmartPointer<vtkFloatArray>::New();
-    timeScalars->SetName("TriggerTime");
-
-    auto magnitudeScalars = vtkSmartPointer<vtkFloatArray>::New();
-    magnitudeScalars->SetName("VelocityMagnitude");
-
-    int numSeeds = static_cast<int>(seedPoints->GetNumberOfPoints());
-    for (int s = 0; s < numSeeds; ++s) {
-        double pos[3];
-        seedPoints->GetPoint(s, pos);
-
-        auto polyLine = vtkSmartPointer<vtkPolyLine>::New();
-        bool active = true;
-
-        for (size_t p = 0; p < phaseData.size() && active; ++p) {
-            auto* imageData = phaseData[p].Get();
-            int dims[3];
-            imageData->GetDimensions(dims);
-
-            // Check if position is within image bounds
-            int ijk[3];
-            double pcoords[3];
-            int inBounds = imageData->ComputeStructuredCoordinates(pos, ijk, pcoords);
-            if (!inBounds) {
-                break;
-            }
-
-            auto* vectors = imageData->GetPointData()->GetVectors();
-            if (!vectors) break;
-
-            vtkIdType ptId = ijk[0] + dims[0] * (ijk[1] + dims[1] * ijk[2]);
-            double vel[3];
-            vectors->GetTuple(ptId, vel);
-
-            double mag = std::sqrt(vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2]);
-            if (mag < params.terminalSpeed) {
-                break;
-            }
-
-            // Record current position
-            vtkIdType pid = points->InsertNextPoint(pos);
-            polyLine->GetPointIds()->InsertNextId(pid);
-            timeScalars->InsertNextValue(
-                static_cast<float>(allPhases[p].triggerTime));
-            magnitudeScalars->InsertNextValue(static_cast<float>(mag));
-
-            // Advance position with Euler integration
-            // Scale velocity by spacing to convert cm/s to mm displacement
-            double spacing[3];
-            imageData->GetSpacing(spacing);
-            pos[0] += vel[0] * spacing[0];
-            pos[1] += vel[1] * spacing[1];
-            pos[2] += vel[2] * spacing[2];
+    PhaseProvider provider = [&cache, phaseCount](int index) {
+        // Load the following phase while this interval is integrated
+        if (index + 1 < phaseCount) {
+            cache.prefetch({index + 1});
         }
-
-        if (polyLine->GetPointIds()->GetNumberOfIds() >= 2) {
-            lines->InsertNextCell(polyLine);
-        }
-    }
-
-    output->SetPoints(points);
-    output->SetLines(lines);
-    output->GetPointData()->AddArray(timeScalars);
-    output->GetPointData()->AddArray(magnitudeScalars);
-
-    LOG_INFO(std::format("Pathlines: {} lines, {} points from {} seeds",
-                         output->GetNumberOfCells(),
-                         output->GetNumberOfPoints(), numSeeds));
-    return output;
+        return cache.getPhase(index);
+    };
+    return impl_->tracePathlinePolyData(provider, phaseCount, params);
 }
 
 // =============================================================================
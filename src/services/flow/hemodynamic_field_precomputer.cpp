@@ -0,0 +1,561 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "services/flow/hemodynamic_field_precomputer.hpp"
+#include "core/parallel_for.hpp"
+#include "services/flow/vessel_analyzer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <format>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+
+#include <kcenon/common/logging/log_macros.h>
+
+namespace dicom_viewer::services {
+
+namespace {
+
+/// Weight of the newest sample in the compute-time moving average
+constexpr double kComputeTimeSmoothing = 0.25;
+
+double levelsOf(FieldQuantization format) {
+    return format == FieldQuantization::UInt8 ? 255.0 : 65535.0;
+}
+
+CompactImageGeometry geometryOf(const VectorImage3D* image) {
+    CompactImageGeometry geometry;
+    const auto size = image->GetLargestPossibleRegion().GetSize();
+    const auto& spacing = image->GetSpacing();
+    const auto& origin = image->GetOrigin();
+    const auto& direction = image->GetDirection();
+    for (unsigned int i = 0; i < 3; ++i) {
+        geometry.size[i] = size[i];
+        geometry.spacing[i] = spacing[i];
+        geometry.origin[i] = origin[i];
+        for (unsigned int j = 0; j < 3; ++j) {
+            geometry.direction[i * 3 + j] = direction[i][j];
+        }
+    }
+    return geometry;
+}
+
+std::vector<float> copyBuffer(const FloatImage3D* image, size_t count) {
+    const float* buffer = image->GetBufferPointer();
+    return std::vector<float>(buffer, buffer + count);
+}
+
+}  // anonymous namespace
+
+// =============================================================================
+// Quantized field
+// =============================================================================
+
+double QuantizedScalarField::step() const noexcept {
+    return (static_cast<double>(maxValue) - minValue) / levelsOf(format);
+}
+
+float QuantizedScalarField::valueAt(size_t voxel) const noexcept {
+    const double q = format == FieldQuantization::UInt8
+        ? values8[voxel] : values16[voxel];
+    return static_cast<float>(minValue + q * step());
+}
+
+QuantizedScalarField quantizeScalarField(
+    const std::vector<float>& values, const CompactImageGeometry& geometry,
+    FieldQuantization format) {
+    QuantizedScalarField field;
+    field.format = format;
+    field.geometry = geometry;
+
+    if (!values.empty()) {
+        auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+        field.minValue = *lo;
+        field.maxValue = *hi;
+    }
+
+    const double levels = levelsOf(format);
+    const double range = static_cast<double>(field.maxValue) - field.minValue;
+    const double inverseStep = range > 0.0 ? levels / range : 0.0;
+    const double minValue = field.minValue;
+
+    auto encode = [&](auto& out) {
+        using T = typename std::decay_t<decltype(out)>::value_type;
+        out.resize(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            double q = std::round((values[i] - minValue) * inverseStep);
+            out[i] = static_cast<T>(std::clamp(q, 0.0, levels));
+        }
+    };
+    if (format == FieldQuantization::UInt8) {
+        encode(field.values8);
+    } else {
+        encode(field.values16);
+    }
+    return field;
+}
+
+vtkSmartPointer<vtkImageData> dequantizeScalarField(const QuantizedScalarField& field) {
+    const auto& g = field.geometry;
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(static_cast<int>(g.size[0]),
+                         static_cast<int>(g.size[1]),
+                         static_cast<int>(g.size[2]));
+    image->SetSpacing(g.spacing[0], g.spacing[1], g.spacing[2]);
+    image->SetOrigin(g.origin[0], g.origin[1], g.origin[2]);
+    image->AllocateScalars(VTK_FLOAT, 1);
+
+    auto* out = static_cast<float*>(image->GetScalarPointer());
+    const size_t voxels = g.voxelCount();
+    const float minValue = field.minValue;
+    const float step = static_cast<float>(field.step());
+    if (field.format == FieldQuantization::UInt8) {
+        for (size_t i = 0; i < voxels; ++i) {
+            out[i] = minValue + field.values8[i] * step;
+        }
+    } else {
+        for (size_t i = 0; i < voxels; ++i) {
+            out[i] = minValue + field.values16[i] * step;
+        }
+    }
+    image->GetPointData()->GetScalars()->SetName("OverlayField");
+    return image;
+}
+
+// =============================================================================
+// HemodynamicFieldPrecomputer implementation
+// =============================================================================
+
+class HemodynamicFieldPrecomputer::Impl {
+public:
+    mutable std::mutex mutex;
+    std::shared_ptr<const PhaseLoader> loader;
+    StatusCallback statusCallback;
+    FieldQuantization quantization = FieldQuantization::UInt16;
+    size_t threadCount = 0;
+
+    HemodynamicFieldType fieldType = HemodynamicFieldType::VelocityMagnitude;
+    int totalPhases = 0;
+    std::unordered_map<int, std::shared_ptr<const QuantizedScalarField>> fields;
+    size_t memoryBytes = 0;
+    int failedCount = 0;
+
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    double averageComputeTimeMs = 0.0;
+
+    // Background pass; generation is bumped by start()/clear() so results
+    // of an abandoned pass are dropped. controlMutex serializes the
+    // methods that start or join the worker.
+    std::mutex controlMutex;
+    std::thread worker;
+    std::atomic<bool> cancelRequested{false};
+    bool running = false;
+    uint64_t generation = 0;
+    std::condition_variable finished;
+
+    ~Impl() { stopWorker(); }
+
+    void stopWorker() {
+        cancelRequested = true;
+        if (worker.joinable()) {
+            worker.join();
+        }
+        cancelRequested = false;
+    }
+
+    FieldPrecomputeStatus statusLocked() const {
+        FieldPrecomputeStatus status;
+        status.fieldType = fieldType;
+        status.quantization = quantization;
+        status.computedCount = static_cast<int>(fields.size());
+        status.totalPhases = totalPhases;
+        status.failedCount = failedCount;
+        status.running = running;
+        status.memoryUsageBytes = memoryBytes;
+        for (const auto& [index, field] : fields) {
+            status.errorBound = std::max(status.errorBound, field->errorBound());
+        }
+        status.hitCount = hitCount;
+        status.missCount = missCount;
+        status.averageComputeTimeMs = averageComputeTimeMs;
+        return status;
+    }
+
+    void recordComputeTimeLocked(double milliseconds) {
+        averageComputeTimeMs = averageComputeTimeMs == 0.0
+            ? milliseconds
+            : kComputeTimeSmoothing * milliseconds
+                  + (1.0 - kComputeTimeSmoothing) * averageComputeTimeMs;
+    }
+
+    void clearLocked() {
+        ++generation;
+        running = false;
+        fields.clear();
+        memoryBytes = 0;
+        failedCount = 0;
+        hitCount = 0;
+        missCount = 0;
+        averageComputeTimeMs = 0.0;
+        finished.notify_all();
+    }
+
+    /// Load, derive and quantize one phase
+    static std::expected<std::shared_ptr<const QuantizedScalarField>, FlowError>
+    computePhase(const PhaseLoader& load, int phaseIndex,
+                 HemodynamicFieldType type, FieldQuantization format,
+                 size_t gradientThreads) {
+        auto phase = load(phaseIndex);
+        if (!phase) {
+            return std::unexpected(phase.error());
+        }
+        if (!phase->velocityField) {
+            return std::unexpected(FlowError{
+                FlowError::Code::InvalidInput,
+                std::format("Phase {} has no velocity field", phaseIndex)});
+        }
+        auto values = HemodynamicFieldPrecomputer::computeField(
+            *phase, type, gradientThreads);
+        if (!values) {
+            return std::unexpected(values.error());
+        }
+        auto field = std::make_shared<QuantizedScalarField>(
+            quantizeScalarField(*values, geometryOf(phase->velocityField.GetPointer()),
+                                format));
+        field->phaseIndex = phaseIndex;
+        return field;
+    }
+
+    /// Store a result unless it belongs to an abandoned pass or is a duplicate
+    void storeLocked(int phaseIndex, uint64_t resultGeneration,
+                     std::shared_ptr<const QuantizedScalarField> field) {
+        if (resultGeneration != generation || fields.contains(phaseIndex)) {
+            return;
+        }
+        memoryBytes += field->memoryBytes();
+        fields.emplace(phaseIndex, std::move(field));
+    }
+
+    void run(std::shared_ptr<const PhaseLoader> load, HemodynamicFieldType type,
+             FieldQuantization format, int phaseCount, size_t threads,
+             uint64_t runGeneration) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        // Phases run concurrently with single-threaded gradient passes,
+        // which scales better than parallelizing inside each phase
+        try {
+            core::parallelFor(static_cast<size_t>(phaseCount), threads,
+                [&](size_t i) {
+                    const int phaseIndex = static_cast<int>(i);
+                    if (cancelRequested) {
+                        return;
+                    }
+                    {
+                        std::lock_guard lock(mutex);
+                        if (fields.contains(phaseIndex)) {
+                            return;
+                        }
+                    }
+
+                    auto phaseStart = std::chrono::steady_clock::now();
+                    auto field = computePhase(*load, phaseIndex, type, format, 1);
+                    const std::chrono::duration<double, std::milli> elapsed =
+                        std::chrono::steady_clock::now() - phaseStart;
+
+                    FieldPrecomputeStatus status;
+                    StatusCallback callback;
+                    {
+                        std::lock_guard lock(mutex);
+                        if (runGeneration != generation) {
+                            return;
+                        }
+                        recordComputeTimeLocked(elapsed.count());
+                        if (field) {
+                            storeLocked(phaseIndex, runGeneration, std::move(*field));
+                        } else {
+                            ++failedCount;
+                            LOG_WARNING(std::format(
+                                "Overlay precompute of phase {} failed: {}",
+                                phaseIndex, field.error().toString()));
+                        }
+                        status = statusLocked();
+                        callback = statusCallback;
+                    }
+                    if (callback) {
+                        callback(status);
+                    }
+                });
+        } catch (const std::exception& e) {
+            LOG_ERROR(std::format("Overlay precompute failed: {}", e.what()));
+        } catch (...) {
+            LOG_ERROR("Overlay precompute failed: unknown exception");
+        }
+
+        const std::chrono::duration<double, std::milli> total =
+            std::chrono::steady_clock::now() - startTime;
+
+        FieldPrecomputeStatus status;
+        StatusCallback callback;
+        {
+            std::lock_guard lock(mutex);
+            if (runGeneration != generation) {
+                return;
+            }
+            status = statusLocked();
+            status.running = false;
+            callback = statusCallback;
+        }
+        LOG_INFO(std::format(
+            "Overlay precompute: {}/{} phases in {:.0f} ms, {} bytes{}",
+            status.computedCount, status.totalPhases, total.count(),
+            status.memoryUsageBytes, cancelRequested ? " (cancelled)" : ""));
+        if (callback) {
+            callback(status);
+        }
+
+        // Release wait() only after the final report has been delivered
+        std::lock_guard lock(mutex);
+        if (runGeneration == generation) {
+            running = false;
+            finished.notify_all();
+        }
+    }
+};
+
+HemodynamicFieldPrecomputer::HemodynamicFieldPrecomputer()
+    : impl_(std::make_unique<Impl>()) {}
+
+HemodynamicFieldPrecomputer::~HemodynamicFieldPrecomputer() = default;
+
+void HemodynamicFieldPrecomputer::setPhaseLoader(PhaseLoader loader) {
+    std::lock_guard lock(impl_->mutex);
+    impl_->loader = std::make_shared<const PhaseLoader>(std::move(loader));
+}
+
+void HemodynamicFieldPrecomputer::setStatusCallback(StatusCallback callback) {
+    std::lock_guard lock(impl_->mutex);
+    impl_->statusCallback = std::move(callback);
+}
+
+void HemodynamicFieldPrecomputer::setQuantization(FieldQuantization format) {
+    std::lock_guard lock(impl_->mutex);
+    impl_->quantization = format;
+}
+
+void HemodynamicFieldPrecomputer::setThreadCount(size_t threadCount) {
+    std::lock_guard lock(impl_->mutex);
+    impl_->threadCount = threadCount;
+}
+
+std::expected<void, FlowError>
+HemodynamicFieldPrecomputer::start(HemodynamicFieldType fieldType, int phaseCount) {
+    if (phaseCount <= 0) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            std::format("Phase count must be positive, got {}", phaseCount)});
+    }
+
+    std::lock_guard control(impl_->controlMutex);
+    impl_->stopWorker();
+
+    std::lock_guard lock(impl_->mutex);
+    impl_->clearLocked();
+    if (!impl_->loader || !*impl_->loader) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput, "No phase loader set"});
+    }
+
+    impl_->fieldType = fieldType;
+    impl_->totalPhases = phaseCount;
+    impl_->running = true;
+    impl_->worker = std::thread(&Impl::run, impl_.get(), impl_->loader,
+                                fieldType, impl_->quantization, phaseCount,
+                                impl_->threadCount, impl_->generation);
+    return {};
+}
+
+void HemodynamicFieldPrecomputer::cancel() {
+    std::lock_guard control(impl_->controlMutex);
+    impl_->stopWorker();
+    std::lock_guard lock(impl_->mutex);
+    impl_->running = false;
+    impl_->finished.notify_all();
+}
+
+void HemodynamicFieldPrecomputer::wait() {
+    std::unique_lock lock(impl_->mutex);
+    impl_->finished.wait(lock, [this] { return !impl_->running; });
+}
+
+bool HemodynamicFieldPrecomputer::isRunning() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->running;
+}
+
+bool HemodynamicFieldPrecomputer::isComputed(int phaseIndex) const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->fields.contains(phaseIndex);
+}
+
+std::expected<vtkSmartPointer<vtkImageData>, FlowError>
+HemodynamicFieldPrecomputer::getField(int phaseIndex) {
+    std::shared_ptr<const PhaseLoader> load;
+    HemodynamicFieldType type;
+    FieldQuantization format;
+    size_t threads;
+    uint64_t requestGeneration;
+    {
+        std::lock_guard lock(impl_->mutex);
+        if (phaseIndex < 0 || phaseIndex >= impl_->totalPhases) {
+            return std::unexpected(FlowError{
+                FlowError::Code::InvalidInput,
+                std::format("Phase index {} out of range [0, {})",
+                            phaseIndex, impl_->totalPhases)});
+        }
+        if (auto it = impl_->fields.find(phaseIndex); it != impl_->fields.end()) {
+            ++impl_->hitCount;
+            auto field = it->second;
+            return dequantizeScalarField(*field);
+        }
+        ++impl_->missCount;
+        load = impl_->loader;
+        type = impl_->fieldType;
+        format = impl_->quantization;
+        threads = impl_->threadCount;
+        requestGeneration = impl_->generation;
+    }
+
+    // Not reached by the background pass yet: compute on the caller with
+    // the full thread budget, since the user is waiting for this phase
+    auto field = Impl::computePhase(*load, phaseIndex, type, format, threads);
+    if (!field) {
+        return std::unexpected(field.error());
+    }
+    {
+        std::lock_guard lock(impl_->mutex);
+        impl_->storeLocked(phaseIndex, requestGeneration, *field);
+    }
+    return dequantizeScalarField(**field);
+}
+
+std::shared_ptr<const QuantizedScalarField>
+HemodynamicFieldPrecomputer::getQuantizedField(int phaseIndex) const {
+    std::lock_guard lock(impl_->mutex);
+    auto it = impl_->fields.find(phaseIndex);
+    return it != impl_->fields.end() ? it->second : nullptr;
+}
+
+std::pair<double, double> HemodynamicFieldPrecomputer::valueRange() const {
+    std::lock_guard lock(impl_->mutex);
+    if (impl_->fields.empty()) {
+        return {0.0, 0.0};
+    }
+    double lo = std::numeric_limits<double>::max();
+    double hi = std::numeric_limits<double>::lowest();
+    for (const auto& [index, field] : impl_->fields) {
+        lo = std::min(lo, static_cast<double>(field->minValue));
+        hi = std::max(hi, static_cast<double>(field->maxValue));
+    }
+    return {lo, hi};
+}
+
+FieldPrecomputeStatus HemodynamicFieldPrecomputer::status() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->statusLocked();
+}
+
+void HemodynamicFieldPrecomputer::clear() {
+    std::lock_guard control(impl_->controlMutex);
+    impl_->stopWorker();
+    std::lock_guard lock(impl_->mutex);
+    impl_->clearLocked();
+}
+
+std::expected<std::vector<float>, FlowError>
+HemodynamicFieldPrecomputer::computeField(const VelocityPhase& phase,
+                                          HemodynamicFieldType fieldType,
+                                          size_t threadCount) {
+    if (!phase.velocityField) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput, "VelocityPhase has null velocity field"});
+    }
+    if (phase.velocityField->GetNumberOfComponentsPerPixel() != 3) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput, "Expected 3-component velocity field"});
+    }
+
+    const auto size = phase.velocityField->GetLargestPossibleRegion().GetSize();
+    const size_t voxels = size[0] * size[1] * size[2];
+
+    if (fieldType == HemodynamicFieldType::VelocityMagnitude) {
+        const float* v = phase.velocityField->GetBufferPointer();
+        std::vector<float> values(voxels);
+        for (size_t i = 0; i < voxels; ++i) {
+            const float* p = v + i * 3;
+            values[i] = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        }
+        return values;
+    }
+
+    VelocityGradientOptions options;
+    options.computeVorticity = fieldType == HemodynamicFieldType::Vorticity;
+    options.computeHelicity = false;
+    options.computeDissipation = fieldType == HemodynamicFieldType::EnergyLoss;
+    options.computeQCriterion = false;
+    options.computeLambda2 = false;
+    options.threadCount = threadCount;
+
+    VesselAnalyzer analyzer;
+    auto result = analyzer.computeVelocityGradientMetrics(phase, options);
+    if (!result) {
+        return std::unexpected(result.error());
+    }
+
+    const FloatImage3D* image = fieldType == HemodynamicFieldType::Vorticity
+        ? result->vortex.vorticityMagnitude.GetPointer()
+        : result->energyLoss.dissipationField.GetPointer();
+    if (!image) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InternalError, "Gradient pass produced no field"});
+    }
+    return copyBuffer(image, voxels);
+}
+
+} // namespace dicom_viewer::services
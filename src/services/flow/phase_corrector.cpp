@@ -29,7 +29,10 @@
 
 #include "services/flow/phase_corrector.hpp"
 
+#include "core/parallel_for.hpp"
+
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <format>
 #include <numeric>
@@ -37,8 +40,6 @@
 #include <itkBinaryErodeImageFilter.h>
 #include <itkFlatStructuringElement.h>
 #include <itkImageDuplicator.h>
-#include <itkImageRegionIterator.h>
-#include <itkImageRegionIteratorWithIndex.h>
 #include <itkOtsuThresholdImageFilter.h>
 
 #include <kcenon/common/logging/log_macros.h>
@@ -68,13 +69,363 @@ FloatImage3D::Pointer duplicateScalarImage(FloatImage3D::Pointer input) {
 }
 
 /// Count the number of polynomial terms for given order in 3D
-int polynomialTermCount(int order) {
+constexpr int polynomialTermCount(int order) {
     // order 1: 1 + x + y + z = 4 terms
     // order 2: + xx + yy + zz + xy + xz + yz = 10 terms
     // order 3: + xxx + yyy + zzz + xxy + xxz + xyy + yyz + xzz + yzz + xyz = 20 terms
     return (order + 1) * (order + 2) * (order + 3) / 6;
 }
 
+/// Exponents (i, j, k) of x^i y^j z^k for each term, in evaluatePolynomial order
+std::vector<std::array<int, 3>> polynomialExponents(int order) {
+    std::vector<std::array<int, 3>> exponents;
+    exponents.reserve(polynomialTermCount(order));
+    for (int p = 0; p <= order; ++p) {
+        for (int i = p; i >= 0; --i) {
+            for (int j = p - i; j >= 0; --j) {
+                exponents.push_back({i, j, p - i - j});
+            }
+        }
+    }
+    return exponents;
+}
+
+/// Powers c^0 .. c^order
+void fillPowers(double c, int order, double* out) {
+    out[0] = 1.0;
+    for (int i = 1; i <= order; ++i) {
+        out[i] = out[i - 1] * c;
+    }
+}
+
+/**
+ * @brief Voxel grid with the [-1, 1] coordinate normalization of the fit
+ */
+struct PolynomialGrid {
+    std::array<size_t, 3> size = {0, 0, 0};
+    std::array<double, 3> scale = {1.0, 1.0, 1.0};
+    int order = 1;
+    std::vector<std::array<int, 3>> exponents;
+
+    PolynomialGrid(const std::array<size_t, 3>& imageSize, int polynomialOrder)
+        : size(imageSize), order(std::max(polynomialOrder, 0)),
+          exponents(polynomialExponents(order)) {
+        for (int a = 0; a < 3; ++a) {
+            scale[a] = (size[a] > 1) ? 2.0 / (size[a] - 1) : 1.0;
+        }
+    }
+
+    [[nodiscard]] double coordinate(int axis, size_t index) const {
+        return index * scale[axis] - 1.0;
+    }
+
+    [[nodiscard]] size_t sliceVoxels() const { return size[0] * size[1]; }
+};
+
+std::array<size_t, 3> imageSize(const itk::ImageRegion<3>& region) {
+    auto size = region.GetSize();
+    return {size[0], size[1], size[2]};
+}
+
+/**
+ * @brief Normal equations A^T A c = A^T b for several right-hand sides
+ *
+ * Rows of the design matrix are folded in as they are generated, so only
+ * the terms x terms matrix and one terms-long vector per right-hand side
+ * are ever stored.
+ */
+struct NormalEquations {
+    int terms = 0;
+    int rhsCount = 0;
+    size_t samples = 0;
+    std::vector<double> ata;  ///< terms x terms, upper triangle accumulated
+    std::vector<double> atb;  ///< rhsCount x terms
+
+    NormalEquations() = default;
+    NormalEquations(int termCount, int rhs)
+        : terms(termCount), rhsCount(rhs),
+          ata(static_cast<size_t>(termCount) * termCount, 0.0),
+          atb(static_cast<size_t>(rhs) * termCount, 0.0) {}
+
+    void add(const double* row, const double* values) {
+        for (int i = 0; i < terms; ++i) {
+            double* ataRow = ata.data() + static_cast<size_t>(i) * terms;
+            const double ri = row[i];
+            for (int j = i; j < terms; ++j) {
+                ataRow[j] += ri * row[j];
+            }
+        }
+        for (int r = 0; r < rhsCount; ++r) {
+            double* atbRow = atb.data() + static_cast<size_t>(r) * terms;
+            for (int i = 0; i < terms; ++i) {
+                atbRow[i] += row[i] * values[r];
+            }
+        }
+        ++samples;
+    }
+
+    void merge(const NormalEquations& other) {
+        if (other.samples == 0) return;
+        for (size_t i = 0; i < ata.size(); ++i) ata[i] += other.ata[i];
+        for (size_t i = 0; i < atb.size(); ++i) atb[i] += other.atb[i];
+        samples += other.samples;
+    }
+
+    /// Solve for right-hand side @p r; zeros if under-determined
+    [[nodiscard]] std::vector<double> solve(int r) const {
+        std::vector<double> coeffs(terms, 0.0);
+        if (samples < static_cast<size_t>(terms)) {
+            // Not enough samples for fitting
+            return coeffs;
+        }
+
+        std::vector<std::vector<double>> ATA(terms, std::vector<double>(terms, 0.0));
+        std::vector<double> augmented(terms);
+        for (int i = 0; i < terms; ++i) {
+            for (int j = i; j < terms; ++j) {
+                ATA[i][j] = ata[static_cast<size_t>(i) * terms + j];
+                ATA[j][i] = ATA[i][j];
+            }
+            augmented[i] = atb[static_cast<size_t>(r) * terms + i];
+        }
+
+        // Gaussian elimination with partial pivoting
+        for (int col = 0; col < terms; ++col) {
+            // Find pivot
+            int maxRow = col;
+            double maxVal = std::abs(ATA[col][col]);
+            for (int row = col + 1; row < terms; ++row) {
+                if (std::abs(ATA[row][col]) > maxVal) {
+                    maxVal = std::abs(ATA[row][col]);
+                    maxRow = row;
+                }
+            }
+
+            if (maxVal < 1e-12) continue;  // Singular or near-singular
+
+            // Swap rows
+            if (maxRow != col) {
+                std::swap(ATA[col], ATA[maxRow]);
+                std::swap(augmented[col], augmented[maxRow]);
+            }
+
+            // Eliminate below
+            for (int row = col + 1; row < terms; ++row) {
+                double factor = ATA[row][col] / ATA[col][col];
+                for (int j = col; j < terms; ++j) {
+                    ATA[row][j] -= factor * ATA[col][j];
+                }
+                augmented[row] -= factor * augmented[col];
+            }
+        }
+
+        // Back substitution
+        for (int i = terms - 1; i >= 0; --i) {
+            double sum = augmented[i];
+            for (int j = i + 1; j < terms; ++j) {
+                sum -= ATA[i][j] * coeffs[j];
+            }
+            if (std::abs(ATA[i][i]) > 1e-12) {
+                coeffs[i] = sum / ATA[i][i];
+            }
+        }
+        return coeffs;
+    }
+};
+
+/**
+ * @brief Fold the masked voxels of z-slice @p z into @p eq
+ * @param sampleAt Callable (size_t voxel, double* values) writing one
+ *        value per right-hand side for the linear voxel index
+ */
+template <typename SampleFn>
+void accumulateSlice(NormalEquations& eq, const PolynomialGrid& grid,
+                     const unsigned char* mask, size_t z, SampleFn&& sampleAt) {
+    const int order = grid.order;
+    const size_t terms = grid.exponents.size();
+    std::vector<double> px(order + 1), py(order + 1), pz(order + 1);
+    std::vector<double> row(terms);
+    std::array<double, 3> values{};
+
+    fillPowers(grid.coordinate(2, z), order, pz.data());
+    for (size_t y = 0; y < grid.size[1]; ++y) {
+        fillPowers(grid.coordinate(1, y), order, py.data());
+        size_t rowStart = (z * grid.size[1] + y) * grid.size[0];
+        for (size_t x = 0; x < grid.size[0]; ++x) {
+            size_t voxel = rowStart + x;
+            if (mask[voxel] == 0) continue;
+
+            fillPowers(grid.coordinate(0, x), order, px.data());
+            for (size_t t = 0; t < terms; ++t) {
+                const auto& e = grid.exponents[t];
+                row[t] = px[e[0]] * py[e[1]] * pz[e[2]];
+            }
+            sampleAt(voxel, values.data());
+            eq.add(row.data(), values.data());
+        }
+    }
+}
+
+/// Sum per-slice partial equations in slice order (deterministic)
+NormalEquations mergeSlices(const std::vector<NormalEquations>& slices,
+                            int terms, int rhsCount) {
+    NormalEquations total(terms, rhsCount);
+    for (const auto& slice : slices) {
+        total.merge(slice);
+    }
+    return total;
+}
+
+/**
+ * @brief Subtract the fitted background from every voxel of z-slice @p z
+ *
+ * Per row the polynomial collapses to a polynomial in x, which is then
+ * evaluated with Horner's rule in a tight loop over the row.
+ *
+ * @param coeffs One coefficient vector per component
+ */
+void subtractBackgroundSlice(float* data, int numComponents,
+                             const PolynomialGrid& grid,
+                             const std::vector<std::vector<double>>& coeffs,
+                             size_t z) {
+    const int order = grid.order;
+    std::vector<double> py(order + 1), pz(order + 1), q(order + 1);
+
+    fillPowers(grid.coordinate(2, z), order, pz.data());
+    for (size_t y = 0; y < grid.size[1]; ++y) {
+        fillPowers(grid.coordinate(1, y), order, py.data());
+        float* row = data + (z * grid.size[1] + y) * grid.size[0] * numComponents;
+
+        for (int comp = 0; comp < numComponents && comp < static_cast<int>(coeffs.size()); ++comp) {
+            std::fill(q.begin(), q.end(), 0.0);
+            for (size_t t = 0; t < grid.exponents.size(); ++t) {
+                const auto& e = grid.exponents[t];
+                q[e[0]] += coeffs[comp][t] * py[e[1]] * pz[e[2]];
+            }
+            for (size_t x = 0; x < grid.size[0]; ++x) {
+                double cx = grid.coordinate(0, x);
+                double bg = q[order];
+                for (int i = order - 1; i >= 0; --i) {
+                    bg = bg * cx + q[i];
+                }
+                float& v = row[x * numComponents + comp];
+                v = static_cast<float>(v - bg);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Unwrap one x-row of interleaved velocity components in place
+ *
+ * Jumps are detected between consecutive raw values, and the accumulated
+ * offset of +/-2 VENC is carried along the rest of the row.
+ */
+void unwrapRow(float* row, size_t width, int numComponents,
+               double jumpThreshold, double twoVenc) {
+    for (int comp = 0; comp < numComponents; ++comp) {
+        double accumulated = 0.0;
+        double prevVal = row[comp];
+        for (size_t x = 1; x < width; ++x) {
+            float& value = row[x * numComponents + comp];
+            double curVal = value;
+            double diff = curVal - prevVal;
+
+            if (diff > jumpThreshold) {
+                accumulated -= twoVenc;
+            } else if (diff < -jumpThreshold) {
+                accumulated += twoVenc;
+            }
+
+            if (accumulated != 0.0) {
+                value = static_cast<float>(curVal + accumulated);
+            }
+
+            prevVal = curVal;
+        }
+    }
+}
+
+/// Unwrap all x-rows of z-slice @p z
+void unwrapSlice(float* data, const std::array<size_t, 3>& size, int numComponents,
+                 double jumpThreshold, double twoVenc, size_t z) {
+    for (size_t y = 0; y < size[1]; ++y) {
+        float* row = data + (z * size[1] + y) * size[0] * numComponents;
+        unwrapRow(row, size[0], numComponents, jumpThreshold, twoVenc);
+    }
+}
+
+void unwrapAliasingParallel(VectorImage3D& velocity, double venc,
+                            double threshold, size_t threadCount) {
+    auto size = imageSize(velocity.GetLargestPossibleRegion());
+    if (size[0] == 0) return;
+
+    int numComponents = static_cast<int>(velocity.GetNumberOfComponentsPerPixel());
+    float* data = velocity.GetBufferPointer();
+    double jumpThreshold = threshold * venc;
+    double twoVenc = 2.0 * venc;
+
+    // Rows are independent, so slices can be unwrapped concurrently
+    dicom_viewer::core::parallelFor(size[2], threadCount, [&](size_t z) {
+        unwrapSlice(data, size, numComponents, jumpThreshold, twoVenc, z);
+    });
+}
+
+/// Stationary-tissue mask buffer if the mask covers @p size, else nullptr
+const unsigned char* maskBuffer(const MaskImage3D::Pointer& mask,
+                                const std::array<size_t, 3>& size) {
+    if (!mask || imageSize(mask->GetLargestPossibleRegion()) != size) {
+        return nullptr;
+    }
+    return mask->GetBufferPointer();
+}
+
+void correctEddyCurrentParallel(VectorImage3D& velocity,
+                                FloatImage3D::Pointer magnitude,
+                                int polynomialOrder, size_t threadCount) {
+    // Create stationary tissue mask
+    auto mask = dicom_viewer::services::PhaseCorrector::createStationaryMask(magnitude);
+    auto size = imageSize(velocity.GetLargestPossibleRegion());
+    const unsigned char* maskData = maskBuffer(mask, size);
+    if (!maskData) {
+        LOG_WARNING("Failed to create stationary tissue mask");
+        return;
+    }
+
+    const int numComponents = static_cast<int>(velocity.GetNumberOfComponentsPerPixel());
+    if (numComponents > 3) {
+        LOG_WARNING(std::format("Eddy current correction supports up to 3 components, got {}",
+                                numComponents));
+        return;
+    }
+
+    PolynomialGrid grid(size, polynomialOrder);
+    const int terms = static_cast<int>(grid.exponents.size());
+    float* data = velocity.GetBufferPointer();
+
+    // One pass fits all components: they share the design matrix
+    std::vector<NormalEquations> slices(size[2]);
+    dicom_viewer::core::parallelFor(size[2], threadCount, [&](size_t z) {
+        slices[z] = NormalEquations(terms, numComponents);
+        accumulateSlice(slices[z], grid, maskData, z, [&](size_t voxel, double* values) {
+            const float* pixel = data + voxel * numComponents;
+            for (int c = 0; c < numComponents; ++c) values[c] = pixel[c];
+        });
+    });
+    NormalEquations equations = mergeSlices(slices, terms, numComponents);
+
+    std::vector<std::vector<double>> coeffs(numComponents);
+    for (int comp = 0; comp < numComponents; ++comp) {
+        coeffs[comp] = equations.solve(comp);
+        LOG_DEBUG(std::format("Eddy current correction: component {} fitted with {} terms",
+                              comp, coeffs[comp].size()));
+    }
+
+    dicom_viewer::core::parallelFor(size[2], threadCount, [&](size_t z) {
+        subtractBackgroundSlice(data, numComponents, grid, coeffs, z);
+    });
+}
+
 }  // anonymous namespace
 
 namespace dicom_viewer::services {
@@ -141,8 +492,8 @@ PhaseCorrector::correctPhase(
         if (config.enableAliasingUnwrap) {
             LOG_DEBUG(std::format("Unwrapping velocity aliasing for phase {}",
                                   phase.phaseIndex));
-            unwrapAliasing(corrected.velocityField, venc,
-                           config.aliasingThreshold);
+            unwrapAliasingParallel(*corrected.velocityField, venc,
+                                   config.aliasingThreshold, config.threadCount);
         }
 
         impl_->reportProgress(0.4);
@@ -151,9 +502,10 @@ PhaseCorrector::correctPhase(
         if (config.enableEddyCurrentCorrection && corrected.magnitudeImage) {
             LOG_DEBUG(std::format("Correcting eddy currents for phase {}",
                                   phase.phaseIndex));
-            correctEddyCurrent(corrected.velocityField,
-                               corrected.magnitudeImage,
-                               config.polynomialOrder);
+            correctEddyCurrentParallel(*corrected.velocityField,
+                                       corrected.magnitudeImage,
+                                       config.polynomialOrder,
+                                       config.threadCount);
         }
 
         impl_->reportProgress(0.8);
@@ -179,53 +531,173 @@ PhaseCorrector::correctPhase(
     }
 }
 
-void PhaseCorrector::unwrapAliasing(
-    VectorImage3D::Pointer velocity, double venc, double threshold) {
-    if (!velocity) return;
+std::expected<std::vector<VelocityPhase>, FlowError>
+PhaseCorrector::correctPhases(
+    const std::vector<VelocityPhase>& phases, double venc,
+    const PhaseCorrectionConfig& config) const {
+    if (!config.isValid()) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "Invalid correction configuration"});
+    }
 
-    auto region = velocity->GetLargestPossibleRegion();
-    auto size = region.GetSize();
-    double jumpThreshold = threshold * venc;
-    double twoVenc = 2.0 * venc;
-    int numComponents = velocity->GetNumberOfComponentsPerPixel();
+    if (venc <= 0.0) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "VENC must be positive, got: " + std::to_string(venc)});
+    }
 
-    // Neighbor-based phase unwrapping along each axis
-    for (int comp = 0; comp < numComponents; ++comp) {
-        // Scan along X axis
-        for (unsigned int z = 0; z < size[2]; ++z) {
-            for (unsigned int y = 0; y < size[1]; ++y) {
-                double accumulated = 0.0;
-                VectorImage3D::IndexType prevIdx = {{0, static_cast<long>(y),
-                                                     static_cast<long>(z)}};
-                auto prevPixel = velocity->GetPixel(prevIdx);
-                double prevVal = prevPixel[comp];
-
-                for (unsigned int x = 1; x < size[0]; ++x) {
-                    VectorImage3D::IndexType idx = {
-                        {static_cast<long>(x), static_cast<long>(y),
-                         static_cast<long>(z)}};
-                    auto pixel = velocity->GetPixel(idx);
-                    double curVal = pixel[comp];
-                    double diff = curVal - prevVal;
-
-                    if (diff > jumpThreshold) {
-                        accumulated -= twoVenc;
-                    } else if (diff < -jumpThreshold) {
-                        accumulated += twoVenc;
-                    }
+    if (phases.empty()) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "No phases provided for correction"});
+    }
 
-                    if (accumulated != 0.0) {
-                        pixel[comp] = static_cast<float>(curVal + accumulated);
-                        velocity->SetPixel(idx, pixel);
-                    }
+    for (const auto& phase : phases) {
+        if (!phase.velocityField) {
+            return std::unexpected(FlowError{
+                FlowError::Code::InvalidInput,
+                "Velocity field is null"});
+        }
+    }
+
+    const auto& reference = *phases.front().velocityField;
+    const auto size = imageSize(reference.GetLargestPossibleRegion());
+    const int numComponents = static_cast<int>(reference.GetNumberOfComponentsPerPixel());
+    bool allMagnitudes = true;
+    for (const auto& phase : phases) {
+        if (imageSize(phase.velocityField->GetLargestPossibleRegion()) != size
+            || static_cast<int>(phase.velocityField->GetNumberOfComponentsPerPixel())
+                   != numComponents) {
+            return std::unexpected(FlowError{
+                FlowError::Code::InvalidInput,
+                "All phases must share the same velocity grid"});
+        }
+        if (!phase.magnitudeImage
+            || imageSize(phase.magnitudeImage->GetLargestPossibleRegion()) != size) {
+            allMagnitudes = false;
+        }
+    }
+
+    impl_->reportProgress(0.0);
+
+    try {
+        // Create corrected copies
+        std::vector<VelocityPhase> corrected(phases.size());
+        for (size_t p = 0; p < phases.size(); ++p) {
+            corrected[p].velocityField = duplicateVectorImage(phases[p].velocityField);
+            corrected[p].magnitudeImage = phases[p].magnitudeImage
+                ? duplicateScalarImage(phases[p].magnitudeImage) : nullptr;
+            corrected[p].phaseIndex = phases[p].phaseIndex;
+            corrected[p].triggerTime = phases[p].triggerTime;
+        }
 
-                    prevVal = curVal;
+        impl_->reportProgress(0.1);
+
+        // Stationary tissue is detected once, on the time-averaged magnitude
+        PolynomialGrid grid(size, config.polynomialOrder);
+        const int terms = static_cast<int>(grid.exponents.size());
+        const size_t sliceVoxels = grid.sliceVoxels();
+        MaskImage3D::Pointer mask;
+        const unsigned char* maskData = nullptr;
+        bool fitEddy = config.enableEddyCurrentCorrection && allMagnitudes
+                       && numComponents <= 3;
+        if (fitEddy) {
+            auto meanMagnitude = duplicateScalarImage(phases.front().magnitudeImage);
+            float* mean = meanMagnitude->GetBufferPointer();
+            const float invCount = 1.0f / static_cast<float>(phases.size());
+            core::parallelFor(size[2], config.threadCount, [&](size_t z) {
+                float* slice = mean + z * sliceVoxels;
+                for (size_t p = 1; p < phases.size(); ++p) {
+                    const float* src = phases[p].magnitudeImage->GetBufferPointer()
+                                       + z * sliceVoxels;
+                    for (size_t i = 0; i < sliceVoxels; ++i) slice[i] += src[i];
+                }
+                for (size_t i = 0; i < sliceVoxels; ++i) slice[i] *= invCount;
+            });
+            mask = createStationaryMask(meanMagnitude);
+            maskData = maskBuffer(mask, size);
+            if (!maskData) {
+                LOG_WARNING("Failed to create stationary tissue mask");
+                fitEddy = false;
+            }
+        }
+
+        impl_->reportProgress(0.3);
+
+        // Pass 1, per slice: unwrap every phase, then fold the phase-averaged
+        // stationary velocities into the normal equations while cached
+        std::vector<float*> buffers(corrected.size());
+        for (size_t p = 0; p < corrected.size(); ++p) {
+            buffers[p] = corrected[p].velocityField->GetBufferPointer();
+        }
+        const double jumpThreshold = config.aliasingThreshold * venc;
+        const double twoVenc = 2.0 * venc;
+        const double invPhases = 1.0 / static_cast<double>(corrected.size());
+
+        std::vector<NormalEquations> slices(fitEddy ? size[2] : 0);
+        core::parallelFor(size[2], config.threadCount, [&](size_t z) {
+            if (config.enableAliasingUnwrap) {
+                for (float* data : buffers) {
+                    unwrapSlice(data, size, numComponents, jumpThreshold, twoVenc, z);
                 }
             }
+            if (fitEddy) {
+                slices[z] = NormalEquations(terms, numComponents);
+                accumulateSlice(slices[z], grid, maskData, z, [&](size_t voxel, double* values) {
+                    for (int c = 0; c < numComponents; ++c) values[c] = 0.0;
+                    for (const float* data : buffers) {
+                        const float* pixel = data + voxel * numComponents;
+                        for (int c = 0; c < numComponents; ++c) values[c] += pixel[c];
+                    }
+                    for (int c = 0; c < numComponents; ++c) values[c] *= invPhases;
+                });
+            }
+        });
+
+        impl_->reportProgress(0.6);
+
+        // Pass 2: subtract the single acquisition-level background from all phases
+        if (fitEddy) {
+            NormalEquations equations = mergeSlices(slices, terms, numComponents);
+            std::vector<std::vector<double>> coeffs(numComponents);
+            for (int comp = 0; comp < numComponents; ++comp) {
+                coeffs[comp] = equations.solve(comp);
+            }
+            LOG_DEBUG(std::format("Eddy current background fitted once from {} stationary "
+                                  "voxels over {} phases ({} terms)",
+                                  equations.samples, corrected.size(), terms));
+
+            core::parallelFor(corrected.size() * size[2], config.threadCount, [&](size_t task) {
+                subtractBackgroundSlice(buffers[task / size[2]], numComponents, grid,
+                                        coeffs, task % size[2]);
+            });
         }
+
+        impl_->reportProgress(1.0);
+
+        LOG_INFO(std::format("Corrected {} phases (unwrap: {}, eddy current: {})",
+                             corrected.size(), config.enableAliasingUnwrap, fitEddy));
+        return corrected;
+
+    } catch (const itk::ExceptionObject& e) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InternalError,
+            "ITK error during phase correction: " +
+                std::string(e.GetDescription())});
+    } catch (const std::exception& e) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InternalError,
+            "Error during phase correction: " + std::string(e.what())});
     }
 }
 
+void PhaseCorrector::unwrapAliasing(
+    VectorImage3D::Pointer velocity, double venc, double threshold) {
+    if (!velocity) return;
+    unwrapAliasingParallel(*velocity, venc, threshold, 0);
+}
+
 MaskImage3D::Pointer PhaseCorrector::createStationaryMask(
     FloatImage3D::Pointer magnitude) {
     if (!magnitude) return nullptr;
@@ -261,126 +733,36 @@ MaskImage3D::Pointer PhaseCorrector::createStationaryMask(
 std::vector<double> PhaseCorrector::fitPolynomialBackground(
     FloatImage3D::Pointer scalarField,
     MaskImage3D::Pointer mask, int order) {
+    if (order < 0) {
+        LOG_WARNING(std::format("Negative polynomial order {}", order));
+        return {};
+    }
+
     int numTerms = polynomialTermCount(order);
     std::vector<double> coeffs(numTerms, 0.0);
 
     if (!scalarField || !mask) return coeffs;
 
-    auto region = scalarField->GetLargestPossibleRegion();
-    auto size = region.GetSize();
-
-    // Normalize coordinates to [-1, 1] range
-    double scaleX = (size[0] > 1) ? 2.0 / (size[0] - 1) : 1.0;
-    double scaleY = (size[1] > 1) ? 2.0 / (size[1] - 1) : 1.0;
-    double scaleZ = (size[2] > 1) ? 2.0 / (size[2] - 1) : 1.0;
-
-    // Collect samples from masked region
-    std::vector<std::vector<double>> A;  // Design matrix rows
-    std::vector<double> b;               // Observed values
-
-    using IterType = itk::ImageRegionIteratorWithIndex<FloatImage3D>;
-    IterType it(scalarField, region);
-    for (it.GoToBegin(); !it.IsAtEnd(); ++it) {
-        auto idx = it.GetIndex();
-        if (mask->GetPixel(idx) == 0) continue;
-
-        double x = idx[0] * scaleX - 1.0;
-        double y = idx[1] * scaleY - 1.0;
-        double z = idx[2] * scaleZ - 1.0;
-
-        // Build polynomial basis row
-        std::vector<double> row;
-        row.reserve(numTerms);
-
-        // Generate terms up to given order
-        for (int p = 0; p <= order; ++p) {
-            for (int i = p; i >= 0; --i) {
-                for (int j = p - i; j >= 0; --j) {
-                    int k = p - i - j;
-                    double term = std::pow(x, i) * std::pow(y, j) * std::pow(z, k);
-                    row.push_back(term);
-                }
-            }
-        }
-
-        A.push_back(std::move(row));
-        b.push_back(it.Get());
-    }
-
-    if (A.size() < static_cast<size_t>(numTerms)) {
-        // Not enough samples for fitting
+    auto size = imageSize(scalarField->GetLargestPossibleRegion());
+    const unsigned char* maskData = maskBuffer(mask, size);
+    if (!maskData) {
+        LOG_WARNING("Stationary mask does not match the fitted image");
         return coeffs;
     }
 
-    // Solve via normal equations: (A^T A) x = A^T b
-    // Using simple Cholesky-free approach for small systems
-    std::vector<std::vector<double>> ATA(numTerms,
-                                          std::vector<double>(numTerms, 0.0));
-    std::vector<double> ATb(numTerms, 0.0);
-
-    for (size_t s = 0; s < A.size(); ++s) {
-        for (int i = 0; i < numTerms; ++i) {
-            ATb[i] += A[s][i] * b[s];
-            for (int j = i; j < numTerms; ++j) {
-                ATA[i][j] += A[s][i] * A[s][j];
-            }
-        }
-    }
-
-    // Symmetrize
-    for (int i = 0; i < numTerms; ++i) {
-        for (int j = 0; j < i; ++j) {
-            ATA[i][j] = ATA[j][i];
-        }
-    }
-
-    // Gaussian elimination with partial pivoting
-    std::vector<double> augmented(numTerms);
-    for (int i = 0; i < numTerms; ++i) {
-        augmented[i] = ATb[i];
-    }
-
-    for (int col = 0; col < numTerms; ++col) {
-        // Find pivot
-        int maxRow = col;
-        double maxVal = std::abs(ATA[col][col]);
-        for (int row = col + 1; row < numTerms; ++row) {
-            if (std::abs(ATA[row][col]) > maxVal) {
-                maxVal = std::abs(ATA[row][col]);
-                maxRow = row;
-            }
-        }
-
-        if (maxVal < 1e-12) continue;  // Singular or near-singular
-
-        // Swap rows
-        if (maxRow != col) {
-            std::swap(ATA[col], ATA[maxRow]);
-            std::swap(augmented[col], augmented[maxRow]);
-        }
-
-        // Eliminate below
-        for (int row = col + 1; row < numTerms; ++row) {
-            double factor = ATA[row][col] / ATA[col][col];
-            for (int j = col; j < numTerms; ++j) {
-                ATA[row][j] -= factor * ATA[col][j];
-            }
-            augmented[row] -= factor * augmented[col];
-        }
-    }
-
-    // Back substitution
-    for (int i = numTerms - 1; i >= 0; --i) {
-        double sum = augmented[i];
-        for (int j = i + 1; j < numTerms; ++j) {
-            sum -= ATA[i][j] * coeffs[j];
-        }
-        if (std::abs(ATA[i][i]) > 1e-12) {
-            coeffs[i] = sum / ATA[i][i];
-        }
-    }
-
-    return coeffs;
+    // Normalize coordinates to [-1, 1] range; stream rows into the
+    // normal equations instead of storing the design matrix
+    PolynomialGrid grid(size, order);
+    const float* data = scalarField->GetBufferPointer();
+    std::vector<NormalEquations> slices(size[2]);
+    core::parallelFor(size[2], 0, [&](size_t z) {
+        slices[z] = NormalEquations(numTerms, 1);
+        accumulateSlice(slices[z], grid, maskData, z, [&](size_t voxel, double* values) {
+            values[0] = data[voxel];
+        });
+    });
+
+    return mergeSlices(slices, numTerms, 1).solve(0);
 }
 
 double PhaseCorrector::evaluatePolynomial(
@@ -410,63 +792,7 @@ void PhaseCorrector::correctEddyCurrent(
     FloatImage3D::Pointer magnitude,
     int polynomialOrder) {
     if (!velocity || !magnitude) return;
-
-    // Create stationary tissue mask
-    auto mask = createStationaryMask(magnitude);
-    if (!mask) {
-        LOG_WARNING("Failed to create stationary tissue mask");
-        return;
-    }
-
-    auto region = velocity->GetLargestPossibleRegion();
-    auto size = region.GetSize();
-    int numComponents = velocity->GetNumberOfComponentsPerPixel();
-
-    double scaleX = (size[0] > 1) ? 2.0 / (size[0] - 1) : 1.0;
-    double scaleY = (size[1] > 1) ? 2.0 / (size[1] - 1) : 1.0;
-    double scaleZ = (size[2] > 1) ? 2.0 / (size[2] - 1) : 1.0;
-
-    // Process each velocity component separately
-    for (int comp = 0; comp < numComponents; ++comp) {
-        // Extract single component as scalar image
-        auto componentImage = FloatImage3D::New();
-        componentImage->SetRegions(region);
-        componentImage->SetSpacing(velocity->GetSpacing());
-        componentImage->SetOrigin(velocity->GetOrigin());
-        componentImage->SetDirection(velocity->GetDirection());
-        componentImage->Allocate();
-
-        using VecIterType = itk::ImageRegionIteratorWithIndex<VectorImage3D>;
-        using ScalarIterType = itk::ImageRegionIterator<FloatImage3D>;
-
-        VecIterType vecIt(velocity, region);
-        ScalarIterType scalarIt(componentImage, region);
-        for (vecIt.GoToBegin(), scalarIt.GoToBegin();
-             !vecIt.IsAtEnd(); ++vecIt, ++scalarIt) {
-            scalarIt.Set(vecIt.Get()[comp]);
-        }
-
-        // Fit polynomial background
-        auto coeffs = fitPolynomialBackground(componentImage, mask,
-                                               polynomialOrder);
-
-        // Subtract polynomial background from velocity
-        for (vecIt.GoToBegin(); !vecIt.IsAtEnd(); ++vecIt) {
-            auto idx = vecIt.GetIndex();
-            double x = idx[0] * scaleX - 1.0;
-            double y = idx[1] * scaleY - 1.0;
-            double z = idx[2] * scaleZ - 1.0;
-
-            double bgValue = evaluatePolynomial(coeffs, x, y, z,
-                                                 polynomialOrder);
-            auto pixel = vecIt.Get();
-            pixel[comp] = static_cast<float>(pixel[comp] - bgValue);
-            velocity->SetPixel(idx, pixel);
-        }
-
-        LOG_DEBUG(std::format("Eddy current correction: component {} fitted with {} terms",
-                              comp, coeffs.size()));
-    }
+    correctEddyCurrentParallel(*velocity, magnitude, polynomialOrder, 0);
 }
 
 }  // namespace dicom_viewer::services
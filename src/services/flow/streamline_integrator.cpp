@@ -0,0 +1,493 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "services/flow/streamline_integrator.hpp"
+
+#include "core/parallel_for.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace dicom_viewer::services {
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+/// Positions are in mm and velocities in cm/s; 1 cm/s = 0.01 mm/ms
+constexpr double kMmPerMsPerCmPerS = 0.01;
+
+/// Smallest adaptive step relative to the initial step length
+constexpr double kMinStepFraction = 0.1;
+
+/// Largest step growth per accepted RK45 step
+constexpr double kMaxStepGrowth = 5.0;
+
+double norm(const Vec3& v) {
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+Vec3 axpy(const Vec3& x, double a, const Vec3& y) {
+    return {x[0] + a * y[0], x[1] + a * y[1], x[2] + a * y[2]};
+}
+
+std::array<float, 3> toFloat(const Vec3& v) {
+    return {static_cast<float>(v[0]), static_cast<float>(v[1]),
+            static_cast<float>(v[2])};
+}
+
+// =============================================================================
+// Streamlines (steady field, arc-length parameterization)
+// =============================================================================
+
+/**
+ * @brief Signed unit flow direction at a point
+ * @return false if the point is outside the field or below terminal speed
+ */
+bool directionAt(const SampledVelocityField& field, const Vec3& point,
+                 double sign, double terminalSpeed, Vec3& direction) {
+    Vec3 velocity;
+    if (!field.sample(point, velocity)) {
+        return false;
+    }
+    double speed = norm(velocity);
+    if (speed <= 0.0 || speed < terminalSpeed) {
+        return false;
+    }
+    double scale = sign / speed;
+    direction = {velocity[0] * scale, velocity[1] * scale, velocity[2] * scale};
+    return true;
+}
+
+/// Classic RK4 step of length h along the direction field
+bool rk4Step(const SampledVelocityField& field, const Vec3& x, double h,
+             double sign, double terminalSpeed, Vec3& xNew) {
+    Vec3 k1, k2, k3, k4;
+    if (!directionAt(field, x, sign, terminalSpeed, k1)) return false;
+    if (!directionAt(field, axpy(x, 0.5 * h, k1), sign, terminalSpeed, k2)) return false;
+    if (!directionAt(field, axpy(x, 0.5 * h, k2), sign, terminalSpeed, k3)) return false;
+    if (!directionAt(field, axpy(x, h, k3), sign, terminalSpeed, k4)) return false;
+    for (int i = 0; i < 3; ++i) {
+        xNew[i] = x[i] + h * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]) / 6.0;
+    }
+    return true;
+}
+
+/// Cash-Karp RK45 step (the scheme used by vtkRungeKutta45)
+bool rk45Step(const SampledVelocityField& field, const Vec3& x, double h,
+              double sign, double terminalSpeed, Vec3& xNew, double& error) {
+    constexpr double b21 = 1.0 / 5.0;
+    constexpr double b31 = 3.0 / 40.0, b32 = 9.0 / 40.0;
+    constexpr double b41 = 3.0 / 10.0, b42 = -9.0 / 10.0, b43 = 6.0 / 5.0;
+    constexpr double b51 = -11.0 / 54.0, b52 = 5.0 / 2.0, b53 = -70.0 / 27.0,
+                     b54 = 35.0 / 27.0;
+    constexpr double b61 = 1631.0 / 55296.0, b62 = 175.0 / 512.0,
+                     b63 = 575.0 / 13824.0, b64 = 44275.0 / 110592.0,
+                     b65 = 253.0 / 4096.0;
+    constexpr double c1 = 37.0 / 378.0, c3 = 250.0 / 621.0,
+                     c4 = 125.0 / 594.0, c6 = 512.0 / 1771.0;
+    constexpr double d1 = c1 - 2825.0 / 27648.0, d3 = c3 - 18575.0 / 48384.0,
+                     d4 = c4 - 13525.0 / 55296.0, d5 = -277.0 / 14336.0,
+                     d6 = c6 - 0.25;
+
+    Vec3 k1, k2, k3, k4, k5, k6, p;
+    if (!directionAt(field, x, sign, terminalSpeed, k1)) return false;
+
+    for (int i = 0; i < 3; ++i) p[i] = x[i] + h * b21 * k1[i];
+    if (!directionAt(field, p, sign, terminalSpeed, k2)) return false;
+
+    for (int i = 0; i < 3; ++i) p[i] = x[i] + h * (b31 * k1[i] + b32 * k2[i]);
+    if (!directionAt(field, p, sign, terminalSpeed, k3)) return false;
+
+    for (int i = 0; i < 3; ++i) {
+        p[i] = x[i] + h * (b41 * k1[i] + b42 * k2[i] + b43 * k3[i]);
+    }
+    if (!directionAt(field, p, sign, terminalSpeed, k4)) return false;
+
+    for (int i = 0; i < 3; ++i) {
+        p[i] = x[i] + h * (b51 * k1[i] + b52 * k2[i] + b53 * k3[i] + b54 * k4[i]);
+    }
+    if (!directionAt(field, p, sign, terminalSpeed, k5)) return false;
+
+    for (int i = 0; i < 3; ++i) {
+        p[i] = x[i] + h * (b61 * k1[i] + b62 * k2[i] + b63 * k3[i]
+                           + b64 * k4[i] + b65 * k5[i]);
+    }
+    if (!directionAt(field, p, sign, terminalSpeed, k6)) return false;
+
+    Vec3 delta;
+    for (int i = 0; i < 3; ++i) {
+        xNew[i] = x[i] + h * (c1 * k1[i] + c3 * k3[i] + c4 * k4[i] + c6 * k6[i]);
+        delta[i] = h * (d1 * k1[i] + d3 * k3[i] + d4 * k4[i] + d5 * k5[i] + d6 * k6[i]);
+    }
+    error = norm(delta);
+    return true;
+}
+
+/**
+ * @brief Integrate from @p seed in one direction
+ * @return Points after the seed (the seed itself is not included)
+ */
+TracedLine traceOneDirection(const SampledVelocityField& field, const Vec3& seed,
+                             double sign, const StreamlineIntegrationOptions& options) {
+    TracedLine line;
+    const double initialStep = std::max(options.stepLength, 1e-6);
+    const double minStep = initialStep * kMinStepFraction;
+    const double maxStep = std::max(initialStep, field.minSpacing());
+
+    Vec3 x = seed;
+    double h = initialStep;
+    double length = 0.0;
+
+    for (int step = 0; step < options.maxSteps && length < options.maxPropagation; ++step) {
+        h = std::min(h, options.maxPropagation - length);
+        Vec3 xNew;
+        double advanced = h;
+
+        if (options.adaptiveStep) {
+            double errorRatio = 0.0;
+            while (true) {
+                double error = 0.0;
+                if (!rk45Step(field, x, h, sign, options.terminalSpeed, xNew, error)) {
+                    // A stage left the field; retry shorter before giving up
+                    if (h > minStep) {
+                        h = std::max(minStep, h * 0.5);
+                        continue;
+                    }
+                    return line;
+                }
+                errorRatio = error / (options.maxError * h);
+                if (errorRatio > 1.0 && h > minStep) {
+                    h = std::max(minStep, 0.9 * h * std::pow(errorRatio, -0.25));
+                    continue;
+                }
+                break;
+            }
+            advanced = h;
+            double growth = (errorRatio > 0.0)
+                ? std::min(kMaxStepGrowth, 0.9 * std::pow(errorRatio, -0.2))
+                : kMaxStepGrowth;
+            h = std::clamp(h * std::max(growth, 0.1), minStep, maxStep);
+        } else if (!rk4Step(field, x, h, sign, options.terminalSpeed, xNew)) {
+            return line;
+        }
+
+        Vec3 velocity;
+        if (!field.sample(xNew, velocity) || norm(velocity) < options.terminalSpeed) {
+            return line;
+        }
+        x = xNew;
+        length += advanced;
+        line.points.push_back(x);
+        line.velocities.push_back(toFloat(velocity));
+    }
+    return line;
+}
+
+TracedLine traceStreamline(const SampledVelocityField& field, const Vec3& seed,
+                           const StreamlineIntegrationOptions& options) {
+    TracedLine line;
+    Vec3 velocity;
+    double speed = field.sample(seed, velocity) ? norm(velocity) : 0.0;
+    if (speed <= 0.0 || speed < options.terminalSpeed) {
+        return line;
+    }
+
+    if (options.bothDirections) {
+        TracedLine backward = traceOneDirection(field, seed, -1.0, options);
+        line.points.assign(backward.points.rbegin(), backward.points.rend());
+        line.velocities.assign(backward.velocities.rbegin(), backward.velocities.rend());
+    }
+
+    line.points.push_back(seed);
+    line.velocities.push_back(toFloat(velocity));
+
+    TracedLine forward = traceOneDirection(field, seed, 1.0, options);
+    line.points.insert(line.points.end(), forward.points.begin(), forward.points.end());
+    line.velocities.insert(line.velocities.end(),
+                           forward.velocities.begin(), forward.velocities.end());
+    return line;
+}
+
+// =============================================================================
+// Pathlines (time-resolved field, RK4 in time)
+// =============================================================================
+
+/// Two adjacent phases with linear interpolation in trigger time
+struct PhaseInterval {
+    const SampledVelocityField* first = nullptr;
+    const SampledVelocityField* second = nullptr;
+    double t0 = 0.0;
+    double t1 = 0.0;
+
+    bool velocityAt(const Vec3& x, double t, Vec3& velocity) const {
+        Vec3 v0, v1;
+        if (!first->sample(x, v0) || !second->sample(x, v1)) {
+            return false;
+        }
+        double alpha = std::clamp((t - t0) / (t1 - t0), 0.0, 1.0);
+        for (int i = 0; i < 3; ++i) {
+            velocity[i] = (1.0 - alpha) * v0[i] + alpha * v1[i];
+        }
+        return true;
+    }
+};
+
+struct PathlineState {
+    Vec3 position = {0.0, 0.0, 0.0};
+    Vec3 velocity = {0.0, 0.0, 0.0};
+    int steps = 0;
+    bool active = false;
+};
+
+/// Advance one particle across [t0, t1], appending every accepted step
+void advanceParticle(const PhaseInterval& interval, double maxDisplacement,
+                     const PathlineIntegrationOptions& options,
+                     PathlineState& state, TracedLine& line) {
+    double t = interval.t0;
+    while (state.active && t < interval.t1) {
+        if (state.steps >= options.maxSteps) {
+            state.active = false;
+            break;
+        }
+
+        // Limit the displacement per step to a fraction of a voxel
+        double speed = kMmPerMsPerCmPerS * norm(state.velocity);
+        double h = interval.t1 - t;
+        if (speed > 0.0) {
+            h = std::min(h, maxDisplacement / speed);
+        }
+
+        const Vec3& x = state.position;
+        Vec3 k1 = state.velocity, k2, k3, k4;
+        double s = kMmPerMsPerCmPerS * h;
+        if (!interval.velocityAt(axpy(x, 0.5 * s, k1), t + 0.5 * h, k2)
+            || !interval.velocityAt(axpy(x, 0.5 * s, k2), t + 0.5 * h, k3)
+            || !interval.velocityAt(axpy(x, s, k3), t + h, k4)) {
+            state.active = false;
+            break;
+        }
+
+        Vec3 xNew;
+        for (int i = 0; i < 3; ++i) {
+            xNew[i] = x[i] + s * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]) / 6.0;
+        }
+        t = (h == interval.t1 - t) ? interval.t1 : t + h;
+        ++state.steps;
+
+        Vec3 velocity;
+        if (!interval.velocityAt(xNew, t, velocity)
+            || norm(velocity) < options.terminalSpeed) {
+            state.active = false;
+            break;
+        }
+        state.position = xNew;
+        state.velocity = velocity;
+        line.points.push_back(xNew);
+        line.velocities.push_back(toFloat(velocity));
+        line.times.push_back(static_cast<float>(t));
+    }
+}
+
+}  // anonymous namespace
+
+// =============================================================================
+// SampledVelocityField
+// =============================================================================
+
+std::expected<SampledVelocityField, FlowError>
+SampledVelocityField::fromPhase(const VelocityPhase& phase) {
+    if (!phase.velocityField) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "VelocityPhase has null velocity field"});
+    }
+
+    const auto& image = *phase.velocityField;
+    if (image.GetNumberOfComponentsPerPixel() != 3) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "Expected 3-component vector image, got " +
+                std::to_string(image.GetNumberOfComponentsPerPixel())});
+    }
+
+    SampledVelocityField field;
+    auto size = image.GetLargestPossibleRegion().GetSize();
+    auto spacing = image.GetSpacing();
+    auto origin = image.GetOrigin();
+    for (int i = 0; i < 3; ++i) {
+        field.dims_[i] = size[i];
+        field.spacing_[i] = spacing[i];
+        field.origin_[i] = origin[i];
+    }
+
+    size_t count = field.dims_[0] * field.dims_[1] * field.dims_[2] * 3;
+    const float* buffer = image.GetBufferPointer();
+    field.data_.assign(buffer, buffer + count);
+    return field;
+}
+
+bool SampledVelocityField::sample(const std::array<double, 3>& point,
+                                  std::array<double, 3>& velocity) const noexcept {
+    if (data_.empty()) {
+        return false;
+    }
+
+    size_t base[3];
+    size_t step[3];
+    double frac[3];
+    const size_t stride[3] = {3, 3 * dims_[0], 3 * dims_[0] * dims_[1]};
+    for (int i = 0; i < 3; ++i) {
+        double c = (point[i] - origin_[i]) / spacing_[i];
+        double last = static_cast<double>(dims_[i] - 1);
+        if (!(c >= 0.0 && c <= last)) {
+            return false;
+        }
+        size_t i0 = std::min(static_cast<size_t>(c), dims_[i] > 1 ? dims_[i] - 2 : 0);
+        base[i] = i0;
+        frac[i] = c - static_cast<double>(i0);
+        step[i] = dims_[i] > 1 ? stride[i] : 0;
+    }
+
+    const float* p = data_.data() + base[0] * stride[0] + base[1] * stride[1]
+                     + base[2] * stride[2];
+    const double fx = frac[0], fy = frac[1], fz = frac[2];
+    for (int c = 0; c < 3; ++c) {
+        double c00 = p[c] + fx * (p[c + step[0]] - p[c]);
+        double c10 = p[c + step[1]] + fx * (p[c + step[1] + step[0]] - p[c + step[1]]);
+        double c01 = p[c + step[2]] + fx * (p[c + step[2] + step[0]] - p[c + step[2]]);
+        double c11 = p[c + step[2] + step[1]]
+                     + fx * (p[c + step[2] + step[1] + step[0]] - p[c + step[2] + step[1]]);
+        double c0 = c00 + fy * (c10 - c00);
+        double c1 = c01 + fy * (c11 - c01);
+        velocity[c] = c0 + fz * (c1 - c0);
+    }
+    return true;
+}
+
+std::array<double, 6> SampledVelocityField::bounds() const noexcept {
+    std::array<double, 6> result{};
+    for (int i = 0; i < 3; ++i) {
+        result[2 * i] = origin_[i];
+        result[2 * i + 1] = origin_[i]
+            + spacing_[i] * static_cast<double>(dims_[i] > 0 ? dims_[i] - 1 : 0);
+    }
+    return result;
+}
+
+double SampledVelocityField::minSpacing() const noexcept {
+    return std::min({spacing_[0], spacing_[1], spacing_[2]});
+}
+
+// =============================================================================
+// Streamline integration
+// =============================================================================
+
+std::vector<TracedLine>
+traceStreamlines(const SampledVelocityField& field,
+                 const std::vector<std::array<double, 3>>& seeds,
+                 const StreamlineIntegrationOptions& options) {
+    std::vector<TracedLine> lines(seeds.size());
+    core::parallelFor(seeds.size(), options.threadCount, [&](size_t s) {
+        lines[s] = traceStreamline(field, seeds[s], options);
+    });
+    return lines;
+}
+
+// =============================================================================
+// Pathline integration
+// =============================================================================
+
+std::expected<std::vector<TracedLine>, FlowError>
+tracePathlines(const PhaseProvider& provider, int phaseCount,
+               const std::vector<std::array<double, 3>>& seeds,
+               const PathlineIntegrationOptions& options) {
+    std::vector<TracedLine> lines(seeds.size());
+    if (phaseCount <= 0 || seeds.empty()) {
+        return lines;
+    }
+
+    auto loadField = [&](int index, double& triggerTime)
+        -> std::expected<SampledVelocityField, FlowError> {
+        auto phase = provider(index);
+        if (!phase) {
+            return std::unexpected(phase.error());
+        }
+        triggerTime = phase->triggerTime;
+        return SampledVelocityField::fromPhase(*phase);
+    };
+
+    double t0 = 0.0;
+    auto current = loadField(0, t0);
+    if (!current) {
+        return std::unexpected(current.error());
+    }
+
+    // Seeds start at the first phase's trigger time
+    std::vector<PathlineState> states(seeds.size());
+    for (size_t s = 0; s < seeds.size(); ++s) {
+        auto& state = states[s];
+        state.position = seeds[s];
+        state.active = current->sample(seeds[s], state.velocity)
+                       && norm(state.velocity) >= options.terminalSpeed;
+        if (state.active) {
+            lines[s].points.push_back(seeds[s]);
+            lines[s].velocities.push_back(toFloat(state.velocity));
+            lines[s].times.push_back(static_cast<float>(t0));
+        }
+    }
+
+    for (int p = 0; p + 1 < phaseCount; ++p) {
+        double t1 = 0.0;
+        auto next = loadField(p + 1, t1);
+        if (!next) {
+            return std::unexpected(next.error());
+        }
+        if (!(t1 > t0)) {
+            return std::unexpected(FlowError{
+                FlowError::Code::InvalidInput,
+                "Phase trigger times must be strictly increasing"});
+        }
+
+        PhaseInterval interval{&*current, &*next, t0, t1};
+        double maxDisplacement = options.maxVoxelFraction
+            * std::min(current->minSpacing(), next->minSpacing());
+        core::parallelFor(seeds.size(), options.threadCount, [&](size_t s) {
+            advanceParticle(interval, maxDisplacement, options, states[s], lines[s]);
+        });
+
+        // Only the two phases bounding the current interval stay resident
+        current = std::move(next);
+        t0 = t1;
+    }
+    return lines;
+}
+
+}  // namespace dicom_viewer::services
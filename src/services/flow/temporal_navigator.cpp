@@ -30,8 +30,10 @@
 #include "services/flow/temporal_navigator.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <format>
+#include <optional>
 
 #include <kcenon/common/logging/log_macros.h>
 
@@ -41,24 +43,58 @@ namespace dicom_viewer::services {
 // PhaseCache implementation
 // =============================================================================
 
+namespace {
+
+/// Weight of the newest sample in the load-time moving average
+constexpr double kLoadTimeSmoothing = 0.25;
+
+}  // anonymous namespace
+
 PhaseCache::PhaseCache(int windowSize)
     : windowSize_(std::max(1, windowSize)) {}
 
+PhaseCache::~PhaseCache() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+        prefetchQueue_.clear();
+    }
+    prefetchReady_.notify_all();
+    if (prefetchThread_.joinable()) {
+        prefetchThread_.join();
+    }
+}
+
 void PhaseCache::setPhaseLoader(
     std::function<std::expected<VelocityPhase, FlowError>(int)> loader) {
     std::lock_guard lock(mutex_);
-    loader_ = std::move(loader);
+    loader_ = loader ? std::make_shared<const PhaseLoader>(std::move(loader))
+                     : nullptr;
 }
 
 std::expected<VelocityPhase, FlowError>
 PhaseCache::getPhase(int phaseIndex) {
-    std::lock_guard lock(mutex_);
+    std::unique_lock lock(mutex_);
+
+    // A load already in progress (prefetch or another caller) is shared
+    loadDone_.wait(lock, [&] { return !inFlight_.contains(phaseIndex); });
 
     // Check cache first
     auto it = cache_.find(phaseIndex);
     if (it != cache_.end()) {
+        ++hitCount_;
+        if (it->second.prefetched) {
+            ++prefetchHitCount_;
+            it->second.prefetched = false;
+        }
         touchPhase(phaseIndex);
-        return it->second;
+        if (!it->second.compact) {
+            return it->second.phase;
+        }
+        // Expand outside the lock so other readers are not blocked
+        auto compact = it->second.compact;
+        lock.unlock();
+        return decompressPhase(*compact);
     }
 
     // Load from disk
@@ -68,20 +104,193 @@ PhaseCache::getPhase(int phaseIndex) {
             "No phase loader configured"});
     }
 
-    auto result = loader_(phaseIndex);
-    if (!result) {
-        return result;
+    ++missCount_;
+    auto loader = loader_;
+    const auto generation = generation_;
+    const auto format = storageFormat_;
+    const double venc = storageVenc_;
+    inFlight_.insert(phaseIndex);
+    std::erase(prefetchQueue_, phaseIndex);
+    lock.unlock();
+
+    const auto start = std::chrono::steady_clock::now();
+    std::expected<VelocityPhase, FlowError> result;
+    try {
+        result = (*loader)(phaseIndex);
+    } catch (const std::exception& e) {
+        result = std::unexpected(FlowError{
+            FlowError::Code::InternalError,
+            std::format("Loading phase {} failed: {}", phaseIndex, e.what())});
+    } catch (...) {
+        result = std::unexpected(FlowError{
+            FlowError::Code::InternalError,
+            std::format("Loading phase {} failed: unknown exception", phaseIndex)});
     }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
 
-    // Evict if needed before inserting
-    evictIfNeeded();
+    std::optional<Entry> entry;
+    if (result) {
+        entry = makeEntry(result.value(), format, venc, false);
+    }
 
-    cache_[phaseIndex] = result.value();
-    accessOrder_.push_front(phaseIndex);
+    lock.lock();
+    inFlight_.erase(phaseIndex);
+    recordLoadTimeLocked(elapsed.count());
+    if (entry && generation == generation_) {
+        insertLocked(phaseIndex, std::move(*entry));
+    }
+    lock.unlock();
+    loadDone_.notify_all();
 
     return result;
 }
 
+std::expected<VelocityPhase, FlowError>
+PhaseCache::peekOrLoad(int phaseIndex) {
+    std::unique_lock lock(mutex_);
+
+    // Share a load already in progress instead of reading the file twice
+    loadDone_.wait(lock, [&] { return !inFlight_.contains(phaseIndex); });
+
+    auto it = cache_.find(phaseIndex);
+    if (it != cache_.end()) {
+        if (!it->second.compact) {
+            return it->second.phase;
+        }
+        auto compact = it->second.compact;
+        lock.unlock();
+        return decompressPhase(*compact);
+    }
+
+    if (!loader_) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InternalError,
+            "No phase loader configured"});
+    }
+    auto loader = loader_;
+    lock.unlock();
+
+    try {
+        return (*loader)(phaseIndex);
+    } catch (const std::exception& e) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InternalError,
+            std::format("Loading phase {} failed: {}", phaseIndex, e.what())});
+    } catch (...) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InternalError,
+            std::format("Loading phase {} failed: unknown exception", phaseIndex)});
+    }
+}
+
+void PhaseCache::prefetch(const std::vector<int>& phaseIndices) {
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_ || !loader_) {
+            return;
+        }
+
+        prefetchQueue_.clear();
+        for (int phase : phaseIndices) {
+            if (!cache_.contains(phase) && !inFlight_.contains(phase) &&
+                std::find(prefetchQueue_.begin(), prefetchQueue_.end(), phase) ==
+                    prefetchQueue_.end()) {
+                prefetchQueue_.push_back(phase);
+            }
+        }
+        prefetchDepth_ = static_cast<int>(phaseIndices.size());
+
+        if (prefetchQueue_.empty()) {
+            return;
+        }
+        if (!prefetchThread_.joinable()) {
+            prefetchThread_ = std::thread([this] { prefetchLoop(); });
+        }
+    }
+    prefetchReady_.notify_one();
+}
+
+void PhaseCache::setStorageFormat(PhaseStorageFormat format, double venc) {
+    std::lock_guard lock(mutex_);
+    storageFormat_ = format;
+    storageVenc_ = venc;
+}
+
+PhaseStorageFormat PhaseCache::storageFormat() const {
+    std::lock_guard lock(mutex_);
+    return storageFormat_;
+}
+
+std::shared_ptr<const CompactVelocityPhase>
+PhaseCache::getCompactPhase(int phaseIndex) const {
+    std::lock_guard lock(mutex_);
+    auto it = cache_.find(phaseIndex);
+    return it != cache_.end() ? it->second.compact : nullptr;
+}
+
+double PhaseCache::averageLoadTimeMs() const {
+    std::lock_guard lock(mutex_);
+    return averageLoadTimeMs_;
+}
+
+void PhaseCache::prefetchLoop() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        prefetchReady_.wait(lock, [&] {
+            return stopping_ || !prefetchQueue_.empty();
+        });
+        if (stopping_) {
+            return;
+        }
+
+        const int phaseIndex = prefetchQueue_.front();
+        prefetchQueue_.pop_front();
+        if (cache_.contains(phaseIndex) || inFlight_.contains(phaseIndex) ||
+            !loader_) {
+            continue;
+        }
+
+        auto loader = loader_;
+        const auto generation = generation_;
+        const auto format = storageFormat_;
+        const double venc = storageVenc_;
+        inFlight_.insert(phaseIndex);
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::expected<VelocityPhase, FlowError> result;
+        try {
+            result = (*loader)(phaseIndex);
+        } catch (const std::exception& e) {
+            result = std::unexpected(FlowError{
+                FlowError::Code::InternalError, e.what()});
+        } catch (...) {
+            result = std::unexpected(FlowError{
+                FlowError::Code::InternalError, "unknown exception"});
+        }
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        std::optional<Entry> entry;
+        if (result) {
+            entry = makeEntry(std::move(result.value()), format, venc, true);
+        }
+
+        lock.lock();
+        inFlight_.erase(phaseIndex);
+        recordLoadTimeLocked(elapsed.count());
+        if (entry && generation == generation_) {
+            ++prefetchCount_;
+            insertLocked(phaseIndex, std::move(*entry));
+        } else if (!result) {
+            LOG_DEBUG(std::format("Prefetch of phase {} failed: {}",
+                                  phaseIndex, result.error().toString()));
+        }
+        loadDone_.notify_all();
+    }
+}
+
 bool PhaseCache::isCached(int phaseIndex) const {
     std::lock_guard lock(mutex_);
     return cache_.contains(phaseIndex);
@@ -105,9 +314,19 @@ CacheStatus PhaseCache::getStatus() const {
     status.totalPhases = totalPhases_;
     status.windowSize = windowSize_;
 
-    // Estimate memory: each VelocityPhase holds a VectorImage3D + FloatImage3D
-    // Rough estimation only — actual size depends on image dimensions
-    status.memoryUsageBytes = cache_.size() * 50 * 1024 * 1024;  // ~50MB/phase estimate
+    status.memoryUsageBytes = memoryBytes_;
+    status.storageFormat = storageFormat_;
+    for (const auto& [idx, entry] : cache_) {
+        status.velocityErrorBound = std::max(status.velocityErrorBound,
+                                             entry.errorBound);
+    }
+
+    status.hitCount = hitCount_;
+    status.missCount = missCount_;
+    status.prefetchCount = prefetchCount_;
+    status.prefetchHitCount = prefetchHitCount_;
+    status.prefetchDepth = prefetchDepth_;
+    status.averageLoadTimeMs = averageLoadTimeMs_;
 
     return status;
 }
@@ -121,6 +340,9 @@ void PhaseCache::clear() {
     std::lock_guard lock(mutex_);
     cache_.clear();
     accessOrder_.clear();
+    memoryBytes_ = 0;
+    prefetchQueue_.clear();
+    ++generation_;
 }
 
 int PhaseCache::windowSize() const noexcept {
@@ -133,7 +355,10 @@ void PhaseCache::evictIfNeeded() {
            !accessOrder_.empty()) {
         int oldest = accessOrder_.back();
         accessOrder_.pop_back();
-        cache_.erase(oldest);
+        if (auto it = cache_.find(oldest); it != cache_.end()) {
+            memoryBytes_ -= it->second.bytes;
+            cache_.erase(it);
+        }
     }
 }
 
@@ -143,6 +368,45 @@ void PhaseCache::touchPhase(int phaseIndex) {
     accessOrder_.push_front(phaseIndex);
 }
 
+PhaseCache::Entry PhaseCache::makeEntry(VelocityPhase phase, PhaseStorageFormat format,
+                                        double venc, bool prefetched) {
+    Entry entry;
+    entry.prefetched = prefetched;
+    if (format == PhaseStorageFormat::Float32) {
+        entry.bytes = phaseMemoryBytes(phase);
+        entry.phase = std::move(phase);
+        return entry;
+    }
+
+    auto compact = std::make_shared<CompactVelocityPhase>(
+        compressPhase(phase, format, venc));
+    entry.bytes = compact->memoryBytes();
+    entry.errorBound = compact->velocityErrorBound();
+    entry.compact = std::move(compact);
+    return entry;
+}
+
+void PhaseCache::insertLocked(int phaseIndex, Entry entry) {
+    // Already holding mutex; a concurrent load may have inserted it first
+    if (auto it = cache_.find(phaseIndex); it != cache_.end()) {
+        touchPhase(phaseIndex);
+        return;
+    }
+
+    // Evict if needed before inserting
+    evictIfNeeded();
+
+    memoryBytes_ += entry.bytes;
+    cache_[phaseIndex] = std::move(entry);
+    accessOrder_.push_front(phaseIndex);
+}
+
+void PhaseCache::recordLoadTimeLocked(double milliseconds) {
+    averageLoadTimeMs_ = averageLoadTimeMs_ == 0.0
+        ? milliseconds
+        : averageLoadTimeMs_ + kLoadTimeSmoothing * (milliseconds - averageLoadTimeMs_);
+}
+
 // =============================================================================
 // TemporalNavigator implementation
 // =============================================================================
@@ -153,13 +417,23 @@ public:
     int phaseCount_ = 0;
     double temporalResolution_ = 0.0;
     int currentPhase_ = 0;
+    int direction_ = 1;  ///< +1 forward, -1 backward (last step direction)
     bool initialized_ = false;
+    PhaseStorageFormat storageFormat_ = PhaseStorageFormat::Float32;
+    double storageVenc_ = 0.0;
 
     PlaybackState playback;
 
+    bool hasLoader_ = false;
+
+    // Declared after cache so its workers stop before the cache goes away
+    std::unique_ptr<HemodynamicFieldPrecomputer> overlay;
+    HemodynamicFieldType overlayType_ = HemodynamicFieldType::VelocityMagnitude;
+
     PhaseChangedCallback phaseChangedCb;
     PlaybackChangedCallback playbackChangedCb;
     CacheStatusCallback cacheStatusCb;
+    OverlayFieldCallback overlayFieldCb;
 
     void notifyPhaseChanged(int phase) {
         if (phaseChangedCb) {
@@ -179,6 +453,34 @@ public:
         }
     }
 
+    void notifyOverlayField(int phase) {
+        if (!overlay || !overlayFieldCb) {
+            return;
+        }
+        auto field = overlay->getField(phase);
+        if (!field) {
+            LOG_WARNING(std::format("Overlay field for phase {} unavailable: {}",
+                                    phase, field.error().toString()));
+            return;
+        }
+        overlayFieldCb(phase, *field);
+    }
+
+    /// Recompute overlay fields for the current study, if one is ready
+    void restartOverlayPrecompute() {
+        if (!overlay) {
+            return;
+        }
+        overlay->clear();
+        if (!initialized_ || !hasLoader_) {
+            return;
+        }
+        if (auto started = overlay->start(overlayType_, phaseCount_); !started) {
+            LOG_WARNING(std::format("Overlay precomputation not started: {}",
+                                    started.error().toString()));
+        }
+    }
+
     int wrapPhase(int phase) const {
         if (phaseCount_ <= 0) return 0;
         if (playback.looping) {
@@ -186,6 +488,37 @@ public:
         }
         return std::clamp(phase, 0, phaseCount_ - 1);
     }
+
+    int prefetchDepth() const {
+        // Keep the displayed phase resident: at most window - 1 ahead
+        const int maxDepth = std::min(cache->windowSize(), phaseCount_) - 1;
+        if (maxDepth <= 0) {
+            return 0;
+        }
+        const double effectiveFps = playback.fps * playback.speedMultiplier;
+        const double frameIntervalMs = 1000.0 / std::max(effectiveFps, 1e-3);
+        const double loadMs = cache->averageLoadTimeMs();
+        const int framesToCover =
+            static_cast<int>(std::ceil(loadMs / frameIntervalMs)) + 1;
+        return std::clamp(framesToCover, 1, maxDepth);
+    }
+
+    /// Queue the phases after the current one in the playback direction
+    void schedulePrefetch() {
+        if (!playback.isPlaying) {
+            return;
+        }
+        std::vector<int> ahead;
+        const int depth = prefetchDepth();
+        for (int k = 1; k <= depth; ++k) {
+            int phase = currentPhase_ + direction_ * k;
+            if (!playback.looping && (phase < 0 || phase >= phaseCount_)) {
+                break;
+            }
+            ahead.push_back(wrapPhase(phase));
+        }
+        cache->prefetch(ahead);
+    }
 };
 
 TemporalNavigator::TemporalNavigator()
@@ -203,8 +536,14 @@ void TemporalNavigator::initialize(
     impl_->currentPhase_ = 0;
     impl_->initialized_ = true;
 
+    // The overlay workers load through the cache that is replaced here
+    if (impl_->overlay) {
+        impl_->overlay->cancel();
+    }
+    impl_->hasLoader_ = false;
     impl_->cache = std::make_unique<PhaseCache>(cacheWindowSize);
     impl_->cache->setTotalPhases(phaseCount);
+    impl_->cache->setStorageFormat(impl_->storageFormat_, impl_->storageVenc_);
 
     impl_->playback = PlaybackState{};
     impl_->playback.currentPhase = 0;
@@ -212,11 +551,23 @@ void TemporalNavigator::initialize(
 
     LOG_INFO(std::format("Initialized: {} phases, {:.1f} ms/phase, cache={}",
                          phaseCount, temporalResolution, cacheWindowSize));
+    impl_->restartOverlayPrecompute();
+}
+
+void TemporalNavigator::setPhaseStorageFormat(PhaseStorageFormat format, double venc) {
+    impl_->storageFormat_ = format;
+    impl_->storageVenc_ = venc;
+    impl_->cache->setStorageFormat(format, venc);
 }
 
 void TemporalNavigator::setPhaseLoader(
     std::function<std::expected<VelocityPhase, FlowError>(int)> loader) {
+    if (impl_->overlay) {
+        impl_->overlay->cancel();
+    }
+    impl_->hasLoader_ = static_cast<bool>(loader);
     impl_->cache->setPhaseLoader(std::move(loader));
+    impl_->restartOverlayPrecompute();
 }
 
 std::expected<VelocityPhase, FlowError>
@@ -241,7 +592,9 @@ TemporalNavigator::goToPhase(int phaseIndex) {
         impl_->playback.currentTimeMs =
             phaseIndex * impl_->temporalResolution_;
 
+        impl_->schedulePrefetch();
         impl_->notifyPhaseChanged(phaseIndex);
+        impl_->notifyOverlayField(phaseIndex);
         impl_->notifyCacheStatus();
     }
 
@@ -265,6 +618,7 @@ TemporalNavigator::nextPhase() {
         }
     }
 
+    impl_->direction_ = 1;
     return goToPhase(next);
 }
 
@@ -285,12 +639,17 @@ TemporalNavigator::previousPhase() {
         }
     }
 
+    impl_->direction_ = -1;
     return goToPhase(prev);
 }
 
 void TemporalNavigator::play(double fps) {
     impl_->playback.isPlaying = true;
     impl_->playback.fps = std::clamp(fps, 1.0, 60.0);
+    impl_->direction_ = 1;
+    if (impl_->initialized_) {
+        impl_->schedulePrefetch();
+    }
     impl_->notifyPlaybackChanged();
     LOG_DEBUG(std::format("Playback started: {:.1f} fps", fps));
 }
@@ -339,6 +698,7 @@ TemporalNavigator::tick() {
         }
     }
 
+    impl_->direction_ = 1;
     return goToPhase(next);
 }
 
@@ -370,6 +730,34 @@ bool TemporalNavigator::isInitialized() const {
     return impl_->initialized_;
 }
 
+int TemporalNavigator::prefetchDepth() const {
+    return impl_->prefetchDepth();
+}
+
+void TemporalNavigator::enableOverlayPrecompute(
+    HemodynamicFieldType fieldType, FieldQuantization quantization) {
+    if (!impl_->overlay) {
+        impl_->overlay = std::make_unique<HemodynamicFieldPrecomputer>();
+        impl_->overlay->setPhaseLoader([impl = impl_.get()](int phaseIndex) {
+            return impl->cache->peekOrLoad(phaseIndex);
+        });
+    }
+    impl_->overlayType_ = fieldType;
+    impl_->overlay->setQuantization(quantization);
+    impl_->restartOverlayPrecompute();
+}
+
+void TemporalNavigator::disableOverlayPrecompute() {
+    impl_->overlay.reset();
+}
+
+std::optional<FieldPrecomputeStatus> TemporalNavigator::overlayPrecomputeStatus() const {
+    if (!impl_->overlay) {
+        return std::nullopt;
+    }
+    return impl_->overlay->status();
+}
+
 void TemporalNavigator::setPhaseChangedCallback(PhaseChangedCallback callback) {
     impl_->phaseChangedCb = std::move(callback);
 }
@@ -383,4 +771,8 @@ void TemporalNavigator::setCacheStatusCallback(CacheStatusCallback callback) {
     impl_->cacheStatusCb = std::move(callback);
 }
 
+void TemporalNavigator::setOverlayFieldCallback(OverlayFieldCallback callback) {
+    impl_->overlayFieldCb = std::move(callback);
+}
+
 }  // namespace dicom_viewer::services
@@ -26,19 +26,27 @@
 // CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-
 #include "services/flow/velocity_field_assembler.hpp"
 
+#include "core/dicom_loader.hpp"
+#include "core/parallel_for.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <format>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-#include <itkCastImageFilter.h>
-#include <itkComposeImageFilter.h>
-#include <itkGDCMImageIO.h>
-#include <itkGDCMSeriesFileNames.h>
-#include <itkImageSeriesReader.h>
-#include <itkMultiplyImageFilter.h>
-#include <itkSubtractImageFilter.h>
+#include <gdcmImage.h>
+#include <gdcmImageReader.h>
+#include <gdcmPixelFormat.h>
 
 #include <kcenon/common/logging/log_macros.h>
 
@@ -46,75 +54,209 @@ namespace {
 
 using FloatImage3D = dicom_viewer::services::FloatImage3D;
 using VectorImage3D = dicom_viewer::services::VectorImage3D;
+using dicom_viewer::services::FlowError;
 
-/// Read a 3D scalar volume from a list of DICOM slice files
-FloatImage3D::Pointer readScalarVolume(
-    const std::vector<std::string>& sliceFiles) {
-    using ReaderType = itk::ImageSeriesReader<FloatImage3D>;
-    auto reader = ReaderType::New();
-    auto gdcmIO = itk::GDCMImageIO::New();
-    reader->SetImageIO(gdcmIO);
-    reader->SetFileNames(sliceFiles);
-    reader->Update();
-    return reader->GetOutput();
-}
+/// Number of vector components in a velocity field
+constexpr unsigned int kVelocityComponents = 3;
 
-/// Compose 3 scalar images into a vector image
-VectorImage3D::Pointer composeVectorField(
-    FloatImage3D::Pointer vx,
-    FloatImage3D::Pointer vy,
-    FloatImage3D::Pointer vz) {
-    using ComposerType = itk::ComposeImageFilter<FloatImage3D, VectorImage3D>;
-    auto composer = ComposerType::New();
-    composer->SetInput(0, vx);
-    composer->SetInput(1, vy);
-    composer->SetInput(2, vz);
-    composer->Update();
-    return composer->GetOutput();
-}
+/// Output channel of a decoded file: Vx, Vy, Vz or magnitude
+constexpr size_t kMagnitudeChannel = kVelocityComponents;
 
-/// Apply VENC scaling to all pixels of a scalar image (in-place)
-void applyVENCScalingToImage(
-    FloatImage3D::Pointer image,
-    double venc,
-    bool isSigned) {
-    using IteratorType = itk::ImageRegionIterator<FloatImage3D>;
-    IteratorType it(image, image->GetLargestPossibleRegion());
+/// Error raised by a decode work item, carrying the FlowError code
+class AssemblyError : public std::runtime_error {
+public:
+    AssemblyError(FlowError::Code code, const std::string& message)
+        : std::runtime_error(message), code_(code) {}
 
-    if (isSigned) {
-        // Signed: assume pixel range is already centered around 0
-        // Find max absolute pixel value for normalization
-        float maxAbs = 0.0f;
-        for (it.GoToBegin(); !it.IsAtEnd(); ++it) {
-            float absVal = std::abs(it.Get());
-            if (absVal > maxAbs) {
-                maxAbs = absVal;
-            }
-        }
+    [[nodiscard]] FlowError::Code code() const noexcept { return code_; }
 
-        if (maxAbs > 0.0f) {
-            float scale = static_cast<float>(venc) / maxAbs;
-            for (it.GoToBegin(); !it.IsAtEnd(); ++it) {
-                it.Set(it.Get() * scale);
-            }
+private:
+    FlowError::Code code_;
+};
+
+/// Volume geometry of a slice stack, mirroring itk::ImageSeriesReader:
+/// origin at the first slice, z axis along the slice normal oriented from
+/// the first to the last slice
+struct StackGeometry {
+    size_t columns = 0;
+    size_t rows = 0;
+    size_t depth = 0;
+    FloatImage3D::SpacingType spacing;
+    FloatImage3D::PointType origin;
+    FloatImage3D::DirectionType direction;
+};
+
+/// Derive stack geometry from the headers of the first and last slice
+StackGeometry readStackGeometry(const std::vector<std::string>& sliceFiles) {
+    using dicom_viewer::core::DicomLoader;
+
+    auto first = DicomLoader::readHeader(sliceFiles.front());
+    if (!first) {
+        throw AssemblyError(FlowError::Code::ParseFailed, first.error().message);
+    }
+
+    const auto& meta = first->metadata;
+    const auto& slice = first->slice;
+    const auto& ori = slice.imageOrientation;
+
+    StackGeometry geometry;
+    geometry.columns = static_cast<size_t>(meta.columns);
+    geometry.rows = static_cast<size_t>(meta.rows);
+    geometry.depth = sliceFiles.size();
+
+    std::array<double, 3> normal = {
+        ori[1] * ori[5] - ori[2] * ori[4],
+        ori[2] * ori[3] - ori[0] * ori[5],
+        ori[0] * ori[4] - ori[1] * ori[3]
+    };
+    double spacingZ = meta.sliceThickness > 0.0 ? meta.sliceThickness : 1.0;
+    if (sliceFiles.size() > 1) {
+        auto last = DicomLoader::readHeader(sliceFiles.back());
+        if (!last) {
+            throw AssemblyError(FlowError::Code::ParseFailed, last.error().message);
         }
-    } else {
-        // Unsigned: pixel range [0, maxVal], midpoint = maxVal/2
-        float maxVal = 0.0f;
-        for (it.GoToBegin(); !it.IsAtEnd(); ++it) {
-            if (it.Get() > maxVal) {
-                maxVal = it.Get();
-            }
+        double span = 0.0;
+        for (size_t i = 0; i < 3; ++i) {
+            span += (last->slice.imagePosition[i] - slice.imagePosition[i]) * normal[i];
         }
-
-        if (maxVal > 0.0f) {
-            float midpoint = maxVal / 2.0f;
-            float scale = static_cast<float>(venc) / midpoint;
-            for (it.GoToBegin(); !it.IsAtEnd(); ++it) {
-                it.Set((it.Get() - midpoint) * scale);
+        if (std::abs(span) > 1e-6) {
+            spacingZ = std::abs(span) / static_cast<double>(sliceFiles.size() - 1);
+            if (span < 0.0) {
+                for (auto& n : normal) {
+                    n = -n;
+                }
             }
         }
     }
+
+    geometry.spacing[0] = meta.pixelSpacingX;
+    geometry.spacing[1] = meta.pixelSpacingY;
+    geometry.spacing[2] = spacingZ;
+    for (unsigned int i = 0; i < 3; ++i) {
+        geometry.origin[i] = slice.imagePosition[i];
+        geometry.direction[i][0] = ori[i];
+        geometry.direction[i][1] = ori[i + 3];
+        geometry.direction[i][2] = normal[i];
+    }
+    return geometry;
+}
+
+/// Allocate an image laid out by @p geometry
+template <typename TImage>
+typename TImage::Pointer allocateImage(const StackGeometry& geometry,
+                                       unsigned int componentsPerPixel = 1) {
+    typename TImage::SizeType size;
+    size[0] = geometry.columns;
+    size[1] = geometry.rows;
+    size[2] = geometry.depth;
+
+    typename TImage::IndexType start;
+    start.Fill(0);
+
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::RegionType(start, size));
+    image->SetSpacing(geometry.spacing);
+    image->SetOrigin(geometry.origin);
+    image->SetDirection(geometry.direction);
+    if constexpr (std::is_same_v<TImage, VectorImage3D>) {
+        image->SetNumberOfComponentsPerPixel(componentsPerPixel);
+    }
+    image->Allocate();
+    return image;
+}
+
+/// Stored pixels of one decoded slice, held in a per-worker buffer
+struct DecodedSlice {
+    const char* data = nullptr;
+    size_t pixelCount = 0;
+    gdcm::PixelFormat::ScalarType scalarType = gdcm::PixelFormat::UNKNOWN;
+    int bitsStored = 0;
+    bool isSignedStorage = false;
+    double slope = 1.0;
+    double intercept = 0.0;
+};
+
+/// Decode one single-frame slice into @p buffer
+DecodedSlice decodeSlice(const std::string& path, size_t columns, size_t rows,
+                         std::vector<char>& buffer) {
+    gdcm::ImageReader reader;
+    reader.SetFileName(path.c_str());
+    if (!reader.Read()) {
+        throw AssemblyError(FlowError::Code::ParseFailed,
+                            "Failed to read slice: " + path);
+    }
+
+    const gdcm::Image& image = reader.GetImage();
+    const unsigned int* dims = image.GetDimensions();
+    if (dims[0] != columns || dims[1] != rows) {
+        throw AssemblyError(FlowError::Code::InconsistentData, std::format(
+            "Slice {} is {}x{}, expected {}x{}", path, dims[0], dims[1],
+            columns, rows));
+    }
+
+    const gdcm::PixelFormat& pf = image.GetPixelFormat();
+    const size_t pixelCount = columns * rows;
+    const size_t length = image.GetBufferLength();
+    if (pf.GetSamplesPerPixel() != 1 || length != pixelCount * pf.GetPixelSize()) {
+        throw AssemblyError(FlowError::Code::InconsistentData,
+                            "Unsupported slice layout: " + path);
+    }
+
+    buffer.resize(length);
+    if (!image.GetBuffer(buffer.data())) {
+        throw AssemblyError(FlowError::Code::ParseFailed,
+                            "Failed to decode slice: " + path);
+    }
+
+    DecodedSlice slice;
+    slice.data = buffer.data();
+    slice.pixelCount = pixelCount;
+    slice.scalarType = pf.GetScalarType();
+    slice.bitsStored = pf.GetBitsStored() > 0 ? pf.GetBitsStored() : pf.GetBitsAllocated();
+    slice.isSignedStorage = pf.GetPixelRepresentation() == 1;
+    slice.slope = image.GetSlope();
+    slice.intercept = image.GetIntercept();
+    return slice;
+}
+
+/// Pixel range the slice can represent after the modality rescale, derived
+/// from Bits Stored and Pixel Representation. A negative slope flips the
+/// bounds, so the pair is always returned as {min, max}.
+std::pair<double, double> rescaledRange(const DecodedSlice& slice) {
+    const double full = std::ldexp(1.0, slice.bitsStored);
+    const double low = slice.isSignedStorage ? -full / 2.0 : 0.0;
+    const double a = low * slice.slope + slice.intercept;
+    const double b = (low + full) * slice.slope + slice.intercept;
+    return {std::min(a, b), std::max(a, b)};
+}
+
+template <typename TStored, typename Func>
+void forEachStored(const DecodedSlice& slice, Func& func) {
+    const bool identity = slice.slope == 1.0 && slice.intercept == 0.0;
+    for (size_t i = 0; i < slice.pixelCount; ++i) {
+        TStored stored;
+        std::memcpy(&stored, slice.data + i * sizeof(TStored), sizeof(TStored));
+        const double value = identity
+            ? static_cast<double>(stored)
+            : static_cast<double>(stored) * slice.slope + slice.intercept;
+        func(i, static_cast<float>(value));
+    }
+}
+
+/// Invoke func(pixelIndex, rescaledValue) for every pixel of the slice
+template <typename Func>
+void forEachRescaled(const DecodedSlice& slice, Func&& func) {
+    switch (slice.scalarType) {
+        case gdcm::PixelFormat::UINT8:  forEachStored<uint8_t>(slice, func); break;
+        case gdcm::PixelFormat::INT8:   forEachStored<int8_t>(slice, func); break;
+        case gdcm::PixelFormat::UINT16: forEachStored<uint16_t>(slice, func); break;
+        case gdcm::PixelFormat::INT16:  forEachStored<int16_t>(slice, func); break;
+        case gdcm::PixelFormat::UINT32: forEachStored<uint32_t>(slice, func); break;
+        case gdcm::PixelFormat::INT32:  forEachStored<int32_t>(slice, func); break;
+        default:
+            throw AssemblyError(FlowError::Code::InconsistentData,
+                                "Unsupported pixel type");
+    }
 }
 
 }  // anonymous namespace
@@ -130,8 +272,189 @@ public:
             progressCallback(progress);
         }
     }
+
+    /**
+     * @brief Assemble the given phases, decoding every file exactly once
+     *
+     * All files of all requested phases form one work list on a worker
+     * pool. Each file is decoded, rescaled, VENC-scaled (velocity
+     * components) and written straight into its slice of the phase's
+     * interleaved vector buffer or magnitude image.
+     */
+    std::vector<std::expected<VelocityPhase, FlowError>>
+    assemble(const FlowSeriesInfo& seriesInfo, const std::vector<int>& phaseIndices,
+             bool reportsProgress) const;
 };
 
+std::vector<std::expected<VelocityPhase, FlowError>>
+VelocityFieldAssembler::Impl::assemble(
+    const FlowSeriesInfo& seriesInfo, const std::vector<int>& phaseIndices,
+    bool reportsProgress) const {
+
+    static constexpr std::array<VelocityComponent, 4> kChannels = {
+        VelocityComponent::Vx, VelocityComponent::Vy,
+        VelocityComponent::Vz, VelocityComponent::Magnitude};
+
+    /// Per-phase output buffers and first failure
+    struct PhaseSlot {
+        int phaseIndex = 0;
+        std::array<const std::vector<std::string>*, 4> files{};
+        VectorImage3D::Pointer velocityField;
+        FloatImage3D::Pointer magnitudeImage;
+        std::atomic<bool> failed{false};
+        std::optional<FlowError> error;
+    };
+
+    std::vector<PhaseSlot> slots(phaseIndices.size());
+    std::mutex errorMutex;
+
+    auto fail = [&](PhaseSlot& slot, FlowError::Code code, const std::string& message) {
+        std::lock_guard lock(errorMutex);
+        if (!slot.error) {
+            slot.error = FlowError{code, message};
+        }
+        slot.failed.store(true, std::memory_order_relaxed);
+    };
+
+    // Validate phases and allocate output images (header reads only)
+    core::parallelFor(slots.size(), 0, [&](size_t s) {
+        auto& slot = slots[s];
+        slot.phaseIndex = phaseIndices[s];
+        const auto& phaseFrames = seriesInfo.frameMatrix[slot.phaseIndex];
+        for (size_t c = 0; c < kChannels.size(); ++c) {
+            auto it = phaseFrames.find(kChannels[c]);
+            if (it != phaseFrames.end() && !it->second.empty()) {
+                slot.files[c] = &it->second;
+            }
+        }
+
+        if (!slot.files[0] || !slot.files[1] || !slot.files[2]) {
+            fail(slot, FlowError::Code::InconsistentData,
+                 "Phase " + std::to_string(slot.phaseIndex) +
+                     " missing velocity components (need Vx, Vy, Vz)");
+            return;
+        }
+        if (slot.files[1]->size() != slot.files[0]->size() ||
+            slot.files[2]->size() != slot.files[0]->size()) {
+            fail(slot, FlowError::Code::InconsistentData,
+                 "Phase " + std::to_string(slot.phaseIndex) +
+                     " velocity components have different slice counts");
+            return;
+        }
+
+        try {
+            slot.velocityField = allocateImage<VectorImage3D>(
+                readStackGeometry(*slot.files[0]), kVelocityComponents);
+            if (slot.files[kMagnitudeChannel]) {
+                slot.magnitudeImage = allocateImage<FloatImage3D>(
+                    readStackGeometry(*slot.files[kMagnitudeChannel]));
+            }
+        } catch (const AssemblyError& e) {
+            fail(slot, e.code(), "Error assembling phase " +
+                 std::to_string(slot.phaseIndex) + ": " + e.what());
+        } catch (const std::exception& e) {
+            fail(slot, FlowError::Code::InternalError, "Error assembling phase " +
+                 std::to_string(slot.phaseIndex) + ": " + e.what());
+        }
+    });
+
+    /// One file of one channel of one phase
+    struct WorkItem {
+        size_t slot;
+        size_t channel;
+        size_t z;
+    };
+
+    std::vector<WorkItem> items;
+    for (size_t s = 0; s < slots.size(); ++s) {
+        if (slots[s].failed.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        for (size_t c = 0; c < kChannels.size(); ++c) {
+            if (!slots[s].files[c]) {
+                continue;
+            }
+            for (size_t z = 0; z < slots[s].files[c]->size(); ++z) {
+                items.push_back({s, c, z});
+            }
+        }
+    }
+
+    std::mutex progressMutex;
+    size_t completed = 0;
+
+    core::parallelFor(items.size(), 0, [&](size_t i) {
+        const auto& item = items[i];
+        auto& slot = slots[item.slot];
+
+        if (!slot.failed.load(std::memory_order_relaxed)) {
+            try {
+                thread_local std::vector<char> buffer;
+                const auto& path = (*slot.files[item.channel])[item.z];
+
+                if (item.channel == kMagnitudeChannel) {
+                    auto size = slot.magnitudeImage->GetLargestPossibleRegion().GetSize();
+                    const size_t sliceSize = size[0] * size[1];
+                    float* dest = slot.magnitudeImage->GetBufferPointer()
+                                + item.z * sliceSize;
+                    auto decoded = decodeSlice(path, size[0], size[1], buffer);
+                    forEachRescaled(decoded, [dest](size_t p, float value) {
+                        dest[p] = value;
+                    });
+                } else {
+                    auto size = slot.velocityField->GetLargestPossibleRegion().GetSize();
+                    const size_t sliceSize = size[0] * size[1];
+                    float* dest = slot.velocityField->GetBufferPointer()
+                                + item.z * sliceSize * kVelocityComponents
+                                + item.channel;
+                    auto decoded = decodeSlice(path, size[0], size[1], buffer);
+                    const double venc = seriesInfo.venc[item.channel];
+                    const auto [rangeMin, rangeMax] = rescaledRange(decoded);
+                    forEachRescaled(decoded, [&](size_t p, float value) {
+                        dest[p * kVelocityComponents] =
+                            VelocityFieldAssembler::applyVENCScaling(
+                                value, venc, rangeMin, rangeMax);
+                    });
+                }
+            } catch (const AssemblyError& e) {
+                fail(slot, e.code(), "Error assembling phase " +
+                     std::to_string(slot.phaseIndex) + ": " + e.what());
+            } catch (const std::exception& e) {
+                fail(slot, FlowError::Code::InternalError, "Error assembling phase " +
+                     std::to_string(slot.phaseIndex) + ": " + e.what());
+            }
+        }
+
+        if (reportsProgress) {
+            std::lock_guard lock(progressMutex);
+            reportProgress(static_cast<double>(++completed) /
+                           static_cast<double>(items.size()));
+        }
+    });
+
+    std::vector<std::expected<VelocityPhase, FlowError>> results;
+    results.reserve(slots.size());
+    for (auto& slot : slots) {
+        if (slot.error) {
+            results.push_back(std::unexpected(*slot.error));
+            continue;
+        }
+
+        VelocityPhase phase;
+        phase.velocityField = slot.velocityField;
+        phase.magnitudeImage = slot.magnitudeImage;
+        phase.phaseIndex = slot.phaseIndex;
+        phase.triggerTime = seriesInfo.temporalResolution * slot.phaseIndex;
+
+        auto size = phase.velocityField->GetLargestPossibleRegion().GetSize();
+        LOG_DEBUG(std::format("Phase {} assembled: {}x{}x{}, VENC=[{:.1f},{:.1f},{:.1f}]",
+                              slot.phaseIndex, size[0], size[1], size[2],
+                              seriesInfo.venc[0], seriesInfo.venc[1], seriesInfo.venc[2]));
+        results.push_back(std::move(phase));
+    }
+    return results;
+}
+
 VelocityFieldAssembler::VelocityFieldAssembler()
     : impl_(std::make_unique<Impl>()) {}
 
@@ -154,20 +477,27 @@ VelocityFieldAssembler::assembleAllPhases(const FlowSeriesInfo& seriesInfo) cons
 
     impl_->reportProgress(0.0);
 
-    std::vector<VelocityPhase> phases;
-    phases.reserve(seriesInfo.phaseCount);
-
+    // Phases without frame data fail validation exactly as assemblePhase() would
+    std::vector<int> phaseIndices;
     for (int i = 0; i < seriesInfo.phaseCount; ++i) {
-        auto result = assemblePhase(seriesInfo, i);
-        if (!result) {
+        if (i < static_cast<int>(seriesInfo.frameMatrix.size())) {
+            phaseIndices.push_back(i);
+        } else {
+            LOG_WARNING(std::format("Failed to assemble phase {}: no frame data", i));
+        }
+    }
+
+    auto results = impl_->assemble(seriesInfo, phaseIndices, true);
+
+    std::vector<VelocityPhase> phases;
+    phases.reserve(results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i]) {
             LOG_WARNING(std::format("Failed to assemble phase {}: {}",
-                                    i, result.error().toString()));
+                                    phaseIndices[i], results[i].error().toString()));
             continue;
         }
-        phases.push_back(std::move(result.value()));
-
-        impl_->reportProgress(
-            static_cast<double>(i + 1) / static_cast<double>(seriesInfo.phaseCount));
+        phases.push_back(std::move(results[i].value()));
     }
 
     if (phases.empty()) {
@@ -193,74 +523,8 @@ VelocityFieldAssembler::assemblePhase(
                 std::to_string(seriesInfo.frameMatrix.size()) + ")"});
     }
 
-    const auto& phaseFrames = seriesInfo.frameMatrix[phaseIndex];
-
-    // Check required velocity components
-    auto hasComponent = [&](VelocityComponent comp) {
-        auto it = phaseFrames.find(comp);
-        return it != phaseFrames.end() && !it->second.empty();
-    };
-
-    if (!hasComponent(VelocityComponent::Vx) ||
-        !hasComponent(VelocityComponent::Vy) ||
-        !hasComponent(VelocityComponent::Vz)) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InconsistentData,
-            "Phase " + std::to_string(phaseIndex) +
-                " missing velocity components (need Vx, Vy, Vz)"});
-    }
-
-    try {
-        // Read velocity component volumes
-        LOG_DEBUG(std::format("Reading velocity components for phase {}", phaseIndex));
-
-        auto vxImage = readScalarVolume(phaseFrames.at(VelocityComponent::Vx));
-        auto vyImage = readScalarVolume(phaseFrames.at(VelocityComponent::Vy));
-        auto vzImage = readScalarVolume(phaseFrames.at(VelocityComponent::Vz));
-
-        // Apply VENC scaling to convert pixel values → velocity (cm/s)
-        double vencX = seriesInfo.venc[0];
-        double vencY = seriesInfo.venc[1];
-        double vencZ = seriesInfo.venc[2];
-
-        applyVENCScalingToImage(vxImage, vencX, seriesInfo.isSignedPhase);
-        applyVENCScalingToImage(vyImage, vencY, seriesInfo.isSignedPhase);
-        applyVENCScalingToImage(vzImage, vencZ, seriesInfo.isSignedPhase);
-
-        // Compose into vector field
-        auto vectorField = composeVectorField(vxImage, vyImage, vzImage);
-
-        // Read magnitude image if available
-        FloatImage3D::Pointer magnitudeImage;
-        if (hasComponent(VelocityComponent::Magnitude)) {
-            magnitudeImage = readScalarVolume(
-                phaseFrames.at(VelocityComponent::Magnitude));
-        }
-
-        VelocityPhase phase;
-        phase.velocityField = vectorField;
-        phase.magnitudeImage = magnitudeImage;
-        phase.phaseIndex = phaseIndex;
-        phase.triggerTime = seriesInfo.temporalResolution * phaseIndex;
-
-        auto size = vectorField->GetLargestPossibleRegion().GetSize();
-        LOG_DEBUG(std::format("Phase {} assembled: {}x{}x{}, VENC=[{:.1f},{:.1f},{:.1f}]",
-                              phaseIndex, size[0], size[1], size[2],
-                              vencX, vencY, vencZ));
-
-        return phase;
-
-    } catch (const itk::ExceptionObject& e) {
-        return std::unexpected(FlowError{
-            FlowError::Code::ParseFailed,
-            "ITK error assembling phase " + std::to_string(phaseIndex) +
-                ": " + e.GetDescription()});
-    } catch (const std::exception& e) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InternalError,
-            "Error assembling phase " + std::to_string(phaseIndex) +
-                ": " + e.what()});
-    }
+    LOG_DEBUG(std::format("Reading velocity components for phase {}", phaseIndex));
+    return std::move(impl_->assemble(seriesInfo, {phaseIndex}, false).front());
 }
 
 float VelocityFieldAssembler::applyVENCScaling(
@@ -281,4 +545,17 @@ float VelocityFieldAssembler::applyVENCScaling(
         ((static_cast<double>(pixelValue) - midpoint) / midpoint) * venc);
 }
 
+float VelocityFieldAssembler::applyVENCScaling(
+    float pixelValue, double venc, double rangeMin, double rangeMax) {
+    const double halfRange = (rangeMax - rangeMin) / 2.0;
+    if (halfRange <= 0.0) {
+        return 0.0f;
+    }
+
+    // velocity = ((pixel_value - centre) / half_range) × VENC
+    const double centre = (rangeMin + rangeMax) / 2.0;
+    return static_cast<float>(
+        ((static_cast<double>(pixelValue) - centre) / halfRange) * venc);
+}
+
 }  // namespace dicom_viewer::services
@@ -29,9 +29,13 @@
 
 #include "services/flow/vessel_analyzer.hpp"
 
+#include "core/parallel_for.hpp"
+
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <format>
+#include <numbers>
 #include <numeric>
 
 #include <vtkCellArray.h>
@@ -46,93 +50,242 @@
 
 namespace dicom_viewer::services {
 
-// =============================================================================
-// VesselAnalyzer::Impl
-// =============================================================================
-
-class VesselAnalyzer::Impl {
-public:
-    double bloodViscosity = 0.004;   // Pa*s (4 cP)
-    double bloodDensity = 1060.0;    // kg/m^3
-    double lowWSSThreshold = 0.4;    // Pa
-};
-
-// =============================================================================
-// Lifecycle
-// =============================================================================
-
-VesselAnalyzer::VesselAnalyzer()
-    : impl_(std::make_unique<Impl>()) {}
-
-VesselAnalyzer::~VesselAnalyzer() = default;
+namespace {
 
-VesselAnalyzer::VesselAnalyzer(VesselAnalyzer&&) noexcept = default;
-VesselAnalyzer& VesselAnalyzer::operator=(VesselAnalyzer&&) noexcept = default;
-
-// =============================================================================
-// Configuration
-// =============================================================================
+/// Velocity gradient tensor at one voxel: g[i][j] = dV_i/dx_j (1/s)
+using GradientTensor = std::array<std::array<double, 3>, 3>;
 
-void VesselAnalyzer::setBloodViscosity(double mu) {
-    impl_->bloodViscosity = mu;
+FloatImage3D::Pointer allocateScalarLike(const VectorImage3D::Pointer& reference) {
+    auto image = FloatImage3D::New();
+    image->SetRegions(reference->GetLargestPossibleRegion());
+    image->SetSpacing(reference->GetSpacing());
+    image->SetOrigin(reference->GetOrigin());
+    image->SetDirection(reference->GetDirection());
+    image->Allocate(true);
+    return image;
 }
 
-void VesselAnalyzer::setBloodDensity(double rho) {
-    impl_->bloodDensity = rho;
+VectorImage3D::Pointer allocateVectorLike(const VectorImage3D::Pointer& reference) {
+    auto image = VectorImage3D::New();
+    image->SetRegions(reference->GetLargestPossibleRegion());
+    image->SetSpacing(reference->GetSpacing());
+    image->SetOrigin(reference->GetOrigin());
+    image->SetDirection(reference->GetDirection());
+    image->SetNumberOfComponentsPerPixel(3);
+    image->Allocate(true);
+    return image;
 }
 
-void VesselAnalyzer::setLowWSSThreshold(double threshold) {
-    impl_->lowWSSThreshold = threshold;
-}
+/**
+ * @brief Middle eigenvalue of S^2 + Omega^2 (Jeong & Hussain lambda2)
+ *
+ * The matrix is symmetric, so its eigenvalues are real and follow from the
+ * closed-form trigonometric solution of the characteristic cubic.
+ */
+double lambda2Of(const GradientTensor& strain, const GradientTensor& spin) {
+    GradientTensor m{};
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t k = 0; k < 3; ++k) {
+                m[i][j] += strain[i][k] * strain[k][j] + spin[i][k] * spin[k][j];
+            }
+        }
+    }
 
-double VesselAnalyzer::bloodViscosity() const {
-    return impl_->bloodViscosity;
-}
+    const double offDiagonal = m[0][1] * m[0][1] + m[0][2] * m[0][2] + m[1][2] * m[1][2];
+    if (offDiagonal == 0.0) {
+        std::array<double, 3> diagonal = {m[0][0], m[1][1], m[2][2]};
+        std::sort(diagonal.begin(), diagonal.end());
+        return diagonal[1];
+    }
 
-double VesselAnalyzer::bloodDensity() const {
-    return impl_->bloodDensity;
+    const double q = (m[0][0] + m[1][1] + m[2][2]) / 3.0;
+    const double a = m[0][0] - q;
+    const double b = m[1][1] - q;
+    const double c = m[2][2] - q;
+    const double p = std::sqrt((a * a + b * b + c * c + 2.0 * offDiagonal) / 6.0);
+
+    // r = det((M - qI) / p) / 2, clamped against round-off
+    const double det = a * (b * c - m[1][2] * m[1][2])
+                     - m[0][1] * (m[0][1] * c - m[1][2] * m[0][2])
+                     + m[0][2] * (m[0][1] * m[1][2] - b * m[0][2]);
+    const double r = std::clamp(det / (2.0 * p * p * p), -1.0, 1.0);
+    const double angle = std::acos(r) / 3.0;
+
+    const double largest = q + 2.0 * p * std::cos(angle);
+    const double smallest = q + 2.0 * p * std::cos(angle + 2.0 * std::numbers::pi / 3.0);
+    return 3.0 * q - largest - smallest;
 }
 
-// =============================================================================
-// WSS computation (single phase)
-// =============================================================================
+/// Vertices per parallel work item for wall-shear loops
+constexpr size_t kWallChunk = 512;
 
-std::expected<WSSResult, FlowError>
-VesselAnalyzer::computeWSS(const VelocityPhase& phase,
-                           vtkSmartPointer<vtkPolyData> wallMesh) const {
+std::expected<void, FlowError> validateVelocityPhase(const VelocityPhase& phase) {
     if (!phase.velocityField) {
         return std::unexpected(FlowError{
             FlowError::Code::InvalidInput,
             "VelocityPhase has null velocity field"});
     }
-    if (!wallMesh || wallMesh->GetNumberOfPoints() == 0) {
+    if (phase.velocityField->GetNumberOfComponentsPerPixel() != 3) {
         return std::unexpected(FlowError{
             FlowError::Code::InvalidInput,
-            "Wall mesh is null or empty"});
+            "Expected 3-component velocity field"});
     }
+    return {};
+}
 
-    auto image = phase.velocityField;
-    if (image->GetNumberOfComponentsPerPixel() != 3) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InvalidInput,
-            "Expected 3-component velocity field"});
+/// Return @p mesh if it has point normals, otherwise a copy with normals
+vtkSmartPointer<vtkPolyData> meshWithPointNormals(vtkSmartPointer<vtkPolyData> mesh) {
+    if (mesh->GetPointData()->GetNormals()) {
+        return mesh;
     }
+    auto normalFilter = vtkSmartPointer<vtkPolyDataNormals>::New();
+    normalFilter->SetInputData(mesh);
+    normalFilter->ComputePointNormalsOn();
+    normalFilter->SplittingOff();
+    normalFilter->Update();
+    return normalFilter->GetOutput();
+}
+
+/**
+ * @brief Per-vertex wall sampling plan, reusable for every phase on one grid
+ *
+ * Each vertex samples the velocity at 1x, 2x and 3x the smallest spacing
+ * along the inward normal. The wall-normal derivative of the tangential
+ * velocity is linear in those samples, so it reduces to fixed weights
+ * (Lagrange derivative at d = 0) applied to fixed voxel indices.
+ */
+struct WallStencil {
+    static constexpr int kNumSamples = 3;
+
+    struct Vertex {
+        std::array<double, 3> inward{};              ///< Unit inward normal
+        std::array<size_t, kNumSamples> voxel{};     ///< Linear voxel index per sample
+        std::array<double, kNumSamples> weight{};    ///< d/dn weight per sample (1/mm)
+        int sampleCount = 0;                         ///< Samples inside the image
+    };
+
+    std::vector<Vertex> vertices;
+};
+
+WallStencil buildWallStencil(const VectorImage3D& image, vtkPolyData& mesh) {
+    auto* normals = mesh.GetPointData()->GetNormals();
+    const auto region = image.GetLargestPossibleRegion();
+    const auto size = region.GetSize();
+    const auto spacing = image.GetSpacing();
+    const double minSpacing = std::min({spacing[0], spacing[1], spacing[2]});
+
+    WallStencil stencil;
+    stencil.vertices.resize(static_cast<size_t>(mesh.GetNumberOfPoints()));
+
+    const size_t chunks = (stencil.vertices.size() + kWallChunk - 1) / kWallChunk;
+    core::parallelFor(chunks, 0, [&](size_t chunk) {
+        const size_t end = std::min(stencil.vertices.size(), (chunk + 1) * kWallChunk);
+        for (size_t i = chunk * kWallChunk; i < end; ++i) {
+            auto& vertex = stencil.vertices[i];
+            double pt[3], normal[3];
+            mesh.GetPoint(static_cast<vtkIdType>(i), pt);
+            normals->GetTuple(static_cast<vtkIdType>(i), normal);
+
+            // Inward normal (flip outward normal)
+            vertex.inward = {-normal[0], -normal[1], -normal[2]};
+
+            std::array<double, WallStencil::kNumSamples> sd{};
+            for (int s = 0; s < WallStencil::kNumSamples; ++s) {
+                double d = minSpacing * (s + 1);
+                VectorImage3D::PointType samplePoint;
+                samplePoint[0] = pt[0] + vertex.inward[0] * d;
+                samplePoint[1] = pt[1] + vertex.inward[1] * d;
+                samplePoint[2] = pt[2] + vertex.inward[2] * d;
+
+                VectorImage3D::IndexType idx;
+                if (!image.TransformPhysicalPointToIndex(samplePoint, idx)) continue;
+                if (!region.IsInside(idx)) continue;
+
+                const int n = vertex.sampleCount++;
+                sd[n] = d;
+                vertex.voxel[n] = static_cast<size_t>(idx[0])
+                    + size[0] * (static_cast<size_t>(idx[1])
+                    + size[1] * static_cast<size_t>(idx[2]));
+            }
+
+            if (vertex.sampleCount >= 3) {
+                // Quadratic interpolation: Lagrange polynomial derivative at d=0
+                double d1 = sd[0], d2 = sd[1], d3 = sd[2];
+                vertex.weight[0] = -(d2 + d3) / ((d1 - d2) * (d1 - d3));
+                vertex.weight[1] = -(d1 + d3) / ((d2 - d1) * (d2 - d3));
+                vertex.weight[2] = -(d1 + d2) / ((d3 - d1) * (d3 - d2));
+            } else if (vertex.sampleCount == 2) {
+                double invDd = 1.0 / (sd[1] - sd[0]);
+                vertex.weight[0] = -invDd;
+                vertex.weight[1] = invDd;
+            } else if (vertex.sampleCount == 1) {
+                vertex.weight[0] = 1.0 / sd[0];
+            }
+        }
+    });
+    return stencil;
+}
 
-    // Ensure wall mesh has normals
-    vtkSmartPointer<vtkPolyData> meshWithNormals = wallMesh;
-    if (!wallMesh->GetPointData()->GetNormals()) {
-        auto normalFilter = vtkSmartPointer<vtkPolyDataNormals>::New();
-        normalFilter->SetInputData(wallMesh);
-        normalFilter->ComputePointNormalsOn();
-        normalFilter->SplittingOff();
-        normalFilter->Update();
-        meshWithNormals = normalFilter->GetOutput();
+/// Size, spacing, origin and direction of an image, without its pixels
+struct ImageGrid {
+    VectorImage3D::RegionType region;
+    VectorImage3D::SpacingType spacing;
+    VectorImage3D::PointType origin;
+    VectorImage3D::DirectionType direction;
+
+    template <typename TImage>
+    static ImageGrid of(const TImage& image) {
+        return {image.GetLargestPossibleRegion(), image.GetSpacing(),
+                image.GetOrigin(), image.GetDirection()};
     }
 
-    auto normals = meshWithNormals->GetPointData()->GetNormals();
-    int numVertices = meshWithNormals->GetNumberOfPoints();
+    template <typename TImage>
+    [[nodiscard]] bool matches(const TImage& image) const {
+        return region == image.GetLargestPossibleRegion()
+            && spacing == image.GetSpacing()
+            && origin == image.GetOrigin()
+            && direction == image.GetDirection();
+    }
+};
+
+/// Evaluate the WSS vector (Pa) of every stencil vertex for one velocity buffer
+void evaluateWallShear(const WallStencil& stencil, const float* velocity, double mu,
+                       std::vector<std::array<double, 3>>& wss) {
+    wss.resize(stencil.vertices.size());
+    const size_t chunks = (stencil.vertices.size() + kWallChunk - 1) / kWallChunk;
+    core::parallelFor(chunks, 0, [&](size_t chunk) {
+        const size_t end = std::min(stencil.vertices.size(), (chunk + 1) * kWallChunk);
+        for (size_t i = chunk * kWallChunk; i < end; ++i) {
+            const auto& vertex = stencil.vertices[i];
+            const auto& n = vertex.inward;
+
+            // Velocity gradient at wall (d=0) in cm/s per mm
+            double g[3] = {0.0, 0.0, 0.0};
+            for (int s = 0; s < vertex.sampleCount; ++s) {
+                const float* v = velocity + vertex.voxel[s] * 3;
+                double vx = v[0], vy = v[1], vz = v[2];
+
+                // Tangential velocity: V_t = V - (V·n)*n
+                double vDotN = vx * n[0] + vy * n[1] + vz * n[2];
+                g[0] += vertex.weight[s] * (vx - vDotN * n[0]);
+                g[1] += vertex.weight[s] * (vy - vDotN * n[1]);
+                g[2] += vertex.weight[s] * (vz - vDotN * n[2]);
+            }
+
+            // Convert gradient: (cm/s)/mm → (m/s)/m = ×10
+            // WSS = μ × velocity_gradient (Pa = Pa·s × s⁻¹)
+            wss[i] = {mu * g[0] * 10.0, mu * g[1] * 10.0, mu * g[2] * 10.0};
+        }
+    });
+}
+
+/// Copy @p mesh and attach WSS_Magnitude / WSS_Vector arrays and statistics
+WSSResult buildWSSResult(vtkSmartPointer<vtkPolyData> mesh, const WallStencil& stencil,
+                         const std::vector<std::array<double, 3>>& wss,
+                         double lowWSSThreshold) {
+    const int numVertices = static_cast<int>(wss.size());
 
-    // Create WSS arrays
     auto wssMagnitude = vtkSmartPointer<vtkFloatArray>::New();
     wssMagnitude->SetName("WSS_Magnitude");
     wssMagnitude->SetNumberOfTuples(numVertices);
@@ -142,91 +295,18 @@ VesselAnalyzer::computeWSS(const VelocityPhase& phase,
     wssVector->SetNumberOfComponents(3);
     wssVector->SetNumberOfTuples(numVertices);
 
-    auto region = image->GetLargestPossibleRegion();
-    double mu = impl_->bloodViscosity;
     double sumWSS = 0.0;
     double maxWSS = 0.0;
     int validCount = 0;
-
-    // Multi-point sampling for velocity gradient estimation
-    auto spacing = image->GetSpacing();
-    double minSpacing = std::min({spacing[0], spacing[1], spacing[2]});
-    constexpr int kNumSamples = 3;
-
     for (int i = 0; i < numVertices; ++i) {
-        double pt[3], normal[3];
-        meshWithNormals->GetPoint(i, pt);
-        normals->GetTuple(i, normal);
-
-        // Inward normal (flip outward normal)
-        double inward[3] = {-normal[0], -normal[1], -normal[2]};
-
-        // Sample tangential velocity at 1×, 2×, 3× spacing from wall
-        double sd[kNumSamples], stx[kNumSamples], sty[kNumSamples], stz[kNumSamples];
-        int nValid = 0;
-
-        for (int s = 0; s < kNumSamples; ++s) {
-            double d = minSpacing * (s + 1);
-            VectorImage3D::PointType samplePoint;
-            samplePoint[0] = pt[0] + inward[0] * d;
-            samplePoint[1] = pt[1] + inward[1] * d;
-            samplePoint[2] = pt[2] + inward[2] * d;
-
-            VectorImage3D::IndexType idx;
-            if (!image->TransformPhysicalPointToIndex(samplePoint, idx)) continue;
-            if (!region.IsInside(idx)) continue;
-
-            auto pixel = image->GetPixel(idx);
-            double vx = pixel[0], vy = pixel[1], vz = pixel[2];
-
-            // Tangential velocity: V_t = V - (V·n)*n
-            double vDotN = vx * inward[0] + vy * inward[1] + vz * inward[2];
-            sd[nValid] = d;
-            stx[nValid] = vx - vDotN * inward[0];
-            sty[nValid] = vy - vDotN * inward[1];
-            stz[nValid] = vz - vDotN * inward[2];
-            ++nValid;
-        }
+        const auto& w = wss[i];
+        double wssMag = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        wssMagnitude->SetValue(i, static_cast<float>(wssMag));
+        wssVector->SetTuple3(i, w[0], w[1], w[2]);
 
-        if (nValid == 0) {
-            wssMagnitude->SetValue(i, 0.0f);
-            wssVector->SetTuple3(i, 0.0, 0.0, 0.0);
+        if (stencil.vertices[i].sampleCount == 0) {
             continue;
         }
-
-        // Estimate velocity gradient at wall (d=0) in cm/s per mm
-        double gx, gy, gz;
-
-        if (nValid >= 3) {
-            // Quadratic interpolation: Lagrange polynomial derivative at d=0
-            double d1 = sd[0], d2 = sd[1], d3 = sd[2];
-            double c1 = -(d2 + d3) / ((d1 - d2) * (d1 - d3));
-            double c2 = -(d1 + d3) / ((d2 - d1) * (d2 - d3));
-            double c3 = -(d1 + d2) / ((d3 - d1) * (d3 - d2));
-            gx = c1 * stx[0] + c2 * stx[1] + c3 * stx[2];
-            gy = c1 * sty[0] + c2 * sty[1] + c3 * sty[2];
-            gz = c1 * stz[0] + c2 * stz[1] + c3 * stz[2];
-        } else if (nValid == 2) {
-            double invDd = 1.0 / (sd[1] - sd[0]);
-            gx = (stx[1] - stx[0]) * invDd;
-            gy = (sty[1] - sty[0]) * invDd;
-            gz = (stz[1] - stz[0]) * invDd;
-        } else {
-            gx = stx[0] / sd[0];
-            gy = sty[0] / sd[0];
-            gz = stz[0] / sd[0];
-        }
-
-        // Convert gradient: (cm/s)/mm → (m/s)/m = ×10
-        // WSS = μ × velocity_gradient (Pa = Pa·s × s⁻¹)
-        double wssX = mu * gx * 10.0;
-        double wssY = mu * gy * 10.0;
-        double wssZ = mu * gz * 10.0;
-        double wssMag = std::sqrt(wssX * wssX + wssY * wssY + wssZ * wssZ);
-
-        wssMagnitude->SetValue(i, static_cast<float>(wssMag));
-        wssVector->SetTuple3(i, wssX, wssY, wssZ);
-
         sumWSS += wssMag;
         maxWSS = std::max(maxWSS, wssMag);
         ++validCount;
@@ -234,7 +314,7 @@ VesselAnalyzer::computeWSS(const VelocityPhase& phase,
 
     // Attach arrays to output mesh
     auto outputMesh = vtkSmartPointer<vtkPolyData>::New();
-    outputMesh->DeepCopy(meshWithNormals);
+    outputMesh->DeepCopy(mesh);
     outputMesh->GetPointData()->AddArray(wssMagnitude);
     outputMesh->GetPointData()->AddArray(wssVector);
 
@@ -250,7 +330,7 @@ VesselAnalyzer::computeWSS(const VelocityPhase& phase,
             double w0 = wssMagnitude->GetValue(pts[0]);
             double w1 = wssMagnitude->GetValue(pts[1]);
             double w2 = wssMagnitude->GetValue(pts[2]);
-            if ((w0 + w1 + w2) / 3.0 >= impl_->lowWSSThreshold) continue;
+            if ((w0 + w1 + w2) / 3.0 >= lowWSSThreshold) continue;
 
             double p0[3], p1[3], p2[3];
             outputMesh->GetPoint(pts[0], p0);
@@ -272,177 +352,134 @@ VesselAnalyzer::computeWSS(const VelocityPhase& phase,
     result.maxWSS = maxWSS;
     result.lowWSSArea = lowWSSArea;
     result.wallVertexCount = validCount;
-
-    LOG_DEBUG(std::format("WSS: mean={:.4f} Pa, max={:.4f} Pa, lowArea={:.2f} cm², vertices={}",
-                         result.meanWSS, result.maxWSS, result.lowWSSArea, validCount));
-
     return result;
 }
 
+}  // anonymous namespace
+
 // =============================================================================
-// Time-Averaged WSS (TAWSS)
+// VesselAnalyzer::Impl
 // =============================================================================
 
-std::expected<WSSResult, FlowError>
-VesselAnalyzer::computeTAWSS(const std::vector<VelocityPhase>& phases,
-                             vtkSmartPointer<vtkPolyData> wallMesh) const {
-    if (phases.empty()) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InvalidInput,
-            "No phases provided for TAWSS computation"});
-    }
+class VesselAnalyzer::Impl {
+public:
+    double bloodViscosity = 0.004;   // Pa*s (4 cP)
+    double bloodDensity = 1060.0;    // kg/m^3
+    double lowWSSThreshold = 0.4;    // Pa
+};
 
-    // Compute WSS for each phase and accumulate
-    std::vector<WSSResult> phaseResults;
-    phaseResults.reserve(phases.size());
+// =============================================================================
+// Lifecycle
+// =============================================================================
 
-    for (const auto& phase : phases) {
-        auto wssResult = computeWSS(phase, wallMesh);
-        if (!wssResult) {
-            return std::unexpected(wssResult.error());
-        }
-        phaseResults.push_back(std::move(*wssResult));
-    }
+VesselAnalyzer::VesselAnalyzer()
+    : impl_(std::make_unique<Impl>()) {}
 
-    int numVertices = phaseResults[0].wallMesh->GetNumberOfPoints();
-    int numPhases = static_cast<int>(phases.size());
+VesselAnalyzer::~VesselAnalyzer() = default;
 
-    // Compute TAWSS = (1/N) * sum(|WSS_i|)
-    auto tawssArray = vtkSmartPointer<vtkFloatArray>::New();
-    tawssArray->SetName("TAWSS");
-    tawssArray->SetNumberOfTuples(numVertices);
+VesselAnalyzer::VesselAnalyzer(VesselAnalyzer&&) noexcept = default;
+VesselAnalyzer& VesselAnalyzer::operator=(VesselAnalyzer&&) noexcept = default;
 
-    double sumTAWSS = 0.0;
-    double maxTAWSS = 0.0;
+// =============================================================================
+// Configuration
+// =============================================================================
 
-    for (int v = 0; v < numVertices; ++v) {
-        double sum = 0.0;
-        for (int p = 0; p < numPhases; ++p) {
-            auto wssMag = phaseResults[p].wallMesh->GetPointData()
-                ->GetArray("WSS_Magnitude");
-            if (wssMag) {
-                sum += wssMag->GetTuple1(v);
-            }
-        }
-        double tawss = sum / numPhases;
-        tawssArray->SetValue(v, static_cast<float>(tawss));
-        sumTAWSS += tawss;
-        maxTAWSS = std::max(maxTAWSS, tawss);
-    }
+void VesselAnalyzer::setBloodViscosity(double mu) {
+    impl_->bloodViscosity = mu;
+}
 
-    auto outputMesh = vtkSmartPointer<vtkPolyData>::New();
-    outputMesh->DeepCopy(phaseResults[0].wallMesh);
-    outputMesh->GetPointData()->AddArray(tawssArray);
+void VesselAnalyzer::setBloodDensity(double rho) {
+    impl_->bloodDensity = rho;
+}
 
-    WSSResult result;
-    result.wallMesh = outputMesh;
-    result.meanWSS = (numVertices > 0) ? sumTAWSS / numVertices : 0.0;
-    result.maxWSS = maxTAWSS;
-    result.wallVertexCount = numVertices;
+void VesselAnalyzer::setLowWSSThreshold(double threshold) {
+    impl_->lowWSSThreshold = threshold;
+}
 
-    LOG_INFO(std::format("TAWSS: mean={:.4f} Pa, max={:.4f} Pa, phases={}",
-                        result.meanWSS, result.maxWSS, numPhases));
+double VesselAnalyzer::bloodViscosity() const {
+    return impl_->bloodViscosity;
+}
 
-    return result;
+double VesselAnalyzer::bloodDensity() const {
+    return impl_->bloodDensity;
 }
 
 // =============================================================================
-// Oscillatory Shear Index (OSI)
+// WSS computation (single phase)
 // =============================================================================
 
 std::expected<WSSResult, FlowError>
-VesselAnalyzer::computeOSI(const std::vector<VelocityPhase>& phases,
+VesselAnalyzer::computeWSS(const VelocityPhase& phase,
                            vtkSmartPointer<vtkPolyData> wallMesh) const {
-    if (phases.size() < 2) {
+    if (auto valid = validateVelocityPhase(phase); !valid) {
+        return std::unexpected(valid.error());
+    }
+    if (!wallMesh || wallMesh->GetNumberOfPoints() == 0) {
         return std::unexpected(FlowError{
             FlowError::Code::InvalidInput,
-            "OSI requires at least 2 cardiac phases"});
+            "Wall mesh is null or empty"});
     }
 
-    // Compute WSS vectors for each phase
-    std::vector<WSSResult> phaseResults;
-    for (const auto& phase : phases) {
-        auto wss = computeWSS(phase, wallMesh);
-        if (!wss) return std::unexpected(wss.error());
-        phaseResults.push_back(std::move(*wss));
-    }
+    auto meshWithNormals = meshWithPointNormals(wallMesh);
+    const auto stencil = buildWallStencil(*phase.velocityField, *meshWithNormals);
 
-    int numVertices = phaseResults[0].wallMesh->GetNumberOfPoints();
-    int numPhases = static_cast<int>(phases.size());
+    std::vector<std::array<double, 3>> wss;
+    evaluateWallShear(stencil, phase.velocityField->GetBufferPointer(),
+                      impl_->bloodViscosity, wss);
 
-    auto osiArray = vtkSmartPointer<vtkFloatArray>::New();
-    osiArray->SetName("OSI");
-    osiArray->SetNumberOfTuples(numVertices);
+    auto result = buildWSSResult(meshWithNormals, stencil, wss, impl_->lowWSSThreshold);
 
-    auto tawssArray = vtkSmartPointer<vtkFloatArray>::New();
-    tawssArray->SetName("TAWSS");
-    tawssArray->SetNumberOfTuples(numVertices);
+    LOG_DEBUG(std::format("WSS: mean={:.4f} Pa, max={:.4f} Pa, lowArea={:.2f} cm², vertices={}",
+                         result.meanWSS, result.maxWSS, result.lowWSSArea,
+                         result.wallVertexCount));
 
-    double sumOSI = 0.0;
-    int validCount = 0;
+    return result;
+}
 
-    for (int v = 0; v < numVertices; ++v) {
-        // Sum of WSS vectors and sum of magnitudes
-        double sumVec[3] = {0, 0, 0};
-        double sumMag = 0.0;
-
-        for (int p = 0; p < numPhases; ++p) {
-            auto wssVec = phaseResults[p].wallMesh->GetPointData()
-                ->GetArray("WSS_Vector");
-            auto wssMag = phaseResults[p].wallMesh->GetPointData()
-                ->GetArray("WSS_Magnitude");
-            if (wssVec && wssMag) {
-                double vec[3];
-                wssVec->GetTuple(v, vec);
-                sumVec[0] += vec[0];
-                sumVec[1] += vec[1];
-                sumVec[2] += vec[2];
-                sumMag += wssMag->GetTuple1(v);
-            }
-        }
+// =============================================================================
+// Time-Averaged WSS (TAWSS)
+// =============================================================================
 
-        double magSumVec = std::sqrt(sumVec[0] * sumVec[0] +
-                                     sumVec[1] * sumVec[1] +
-                                     sumVec[2] * sumVec[2]);
+std::expected<WSSResult, FlowError>
+VesselAnalyzer::computeTAWSS(const std::vector<VelocityPhase>& phases,
+                             vtkSmartPointer<vtkPolyData> wallMesh) const {
+    if (phases.empty()) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "No phases provided for TAWSS computation"});
+    }
 
-        double osi = 0.0;
-        double tawss = sumMag / numPhases;
-        if (sumMag > 1e-12) {
-            osi = 0.5 * (1.0 - magSumVec / sumMag);
+    WallShearAccumulator accumulator(wallMesh, impl_->bloodViscosity,
+                                     impl_->lowWSSThreshold);
+    for (const auto& phase : phases) {
+        if (auto added = accumulator.addPhase(phase); !added) {
+            return std::unexpected(added.error());
         }
-
-        osiArray->SetValue(v, static_cast<float>(osi));
-        tawssArray->SetValue(v, static_cast<float>(tawss));
-
-        sumOSI += osi;
-        ++validCount;
     }
+    return accumulator.tawss();
+}
 
-    auto outputMesh = vtkSmartPointer<vtkPolyData>::New();
-    outputMesh->DeepCopy(phaseResults[0].wallMesh);
-    outputMesh->GetPointData()->AddArray(osiArray);
-    outputMesh->GetPointData()->AddArray(tawssArray);
-
-    WSSResult result;
-    result.wallMesh = outputMesh;
-    result.meanOSI = (validCount > 0) ? sumOSI / validCount : 0.0;
-    result.wallVertexCount = validCount;
+// =============================================================================
+// Oscillatory Shear Index (OSI)
+// =============================================================================
 
-    // Compute TAWSS stats from the array
-    double sumTAWSS = 0.0;
-    double maxTAWSS = 0.0;
-    for (int v = 0; v < numVertices; ++v) {
-        double t = tawssArray->GetValue(v);
-        sumTAWSS += t;
-        maxTAWSS = std::max(maxTAWSS, t);
+std::expected<WSSResult, FlowError>
+VesselAnalyzer::computeOSI(const std::vector<VelocityPhase>& phases,
+                           vtkSmartPointer<vtkPolyData> wallMesh) const {
+    if (phases.size() < 2) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "OSI requires at least 2 cardiac phases"});
     }
-    result.meanWSS = (numVertices > 0) ? sumTAWSS / numVertices : 0.0;
-    result.maxWSS = maxTAWSS;
 
-    LOG_INFO(std::format("OSI: mean={:.4f}, TAWSS mean={:.4f} Pa, phases={}",
-                        result.meanOSI, result.meanWSS, numPhases));
-
-    return result;
+    WallShearAccumulator accumulator(wallMesh, impl_->bloodViscosity,
+                                     impl_->lowWSSThreshold);
+    for (const auto& phase : phases) {
+        if (auto added = accumulator.addPhase(phase); !added) {
+            return std::unexpected(added.error());
+        }
+    }
+    return accumulator.osi();
 }
 
 // =============================================================================
@@ -451,6 +488,25 @@ VesselAnalyzer::computeOSI(const std::vector<VelocityPhase>& phases,
 
 std::expected<VortexResult, FlowError>
 VesselAnalyzer::computeVorticity(const VelocityPhase& phase) const {
+    VelocityGradientOptions options;
+    options.computeDissipation = false;
+    options.computeQCriterion = false;
+    options.computeLambda2 = false;
+
+    auto result = computeVelocityGradientMetrics(phase, options);
+    if (!result) {
+        return std::unexpected(result.error());
+    }
+    return std::move(result->vortex);
+}
+
+// =============================================================================
+// Velocity gradient tensor (fused vorticity / helicity / dissipation / Q / lambda2)
+// =============================================================================
+
+std::expected<VelocityGradientResult, FlowError>
+VesselAnalyzer::computeVelocityGradientMetrics(
+    const VelocityPhase& phase, const VelocityGradientOptions& options) const {
     if (!phase.velocityField) {
         return std::unexpected(FlowError{
             FlowError::Code::InvalidInput,
@@ -464,224 +520,221 @@ VesselAnalyzer::computeVorticity(const VelocityPhase& phase) const {
             "Expected 3-component velocity field"});
     }
 
-    auto region = image->GetLargestPossibleRegion();
-    auto size = region.GetSize();
-    auto spacing = image->GetSpacing();
+    const bool wantVorticity = options.computeVorticity;
+    const bool wantHelicity = options.computeHelicity;
+    const bool wantDissipation = options.computeDissipation;
+    const bool wantQ = options.computeQCriterion;
+    const bool wantLambda2 = options.computeLambda2;
+    if (!wantVorticity && !wantHelicity && !wantDissipation && !wantQ && !wantLambda2) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "No velocity gradient outputs requested"});
+    }
 
-    // Create output images matching input geometry
-    auto vortField = VectorImage3D::New();
-    vortField->SetRegions(region);
-    vortField->SetSpacing(image->GetSpacing());
-    vortField->SetOrigin(image->GetOrigin());
-    vortField->SetDirection(image->GetDirection());
-    vortField->SetNumberOfComponentsPerPixel(3);
-    vortField->Allocate(true);
-
-    auto vortMag = FloatImage3D::New();
-    vortMag->SetRegions(region);
-    vortMag->SetSpacing(image->GetSpacing());
-    vortMag->SetOrigin(image->GetOrigin());
-    vortMag->SetDirection(image->GetDirection());
-    vortMag->Allocate(true);
-
-    auto helicity = FloatImage3D::New();
-    helicity->SetRegions(region);
-    helicity->SetSpacing(image->GetSpacing());
-    helicity->SetOrigin(image->GetOrigin());
-    helicity->SetDirection(image->GetDirection());
-    helicity->Allocate(true);
-
-    auto rightHel = FloatImage3D::New();
-    rightHel->SetRegions(region);
-    rightHel->SetSpacing(image->GetSpacing());
-    rightHel->SetOrigin(image->GetOrigin());
-    rightHel->SetDirection(image->GetDirection());
-    rightHel->Allocate(true);
-
-    auto leftHel = FloatImage3D::New();
-    leftHel->SetRegions(region);
-    leftHel->SetSpacing(image->GetSpacing());
-    leftHel->SetOrigin(image->GetOrigin());
-    leftHel->SetDirection(image->GetDirection());
-    leftHel->Allocate(true);
-
-    // Spacing in meters for SI vorticity (1/s)
-    // But velocity is in cm/s and spacing in mm
-    // vorticity = dV/dx where V in cm/s and dx in mm
-    // → raw vorticity unit = cm/s/mm = 10/s
-    // To get 1/s: multiply by 10
-    double dxMM = spacing[0];
-    double dyMM = spacing[1];
-    double dzMM = spacing[2];
+    auto size = image->GetLargestPossibleRegion().GetSize();
+    auto spacing = image->GetSpacing();
 
-    // Central differences: dVi/dj = (V[j+1] - V[j-1]) / (2*spacing_j)
-    // Units: (cm/s) / mm → multiply by 10 for 1/s
-    auto* vBuf = image->GetBufferPointer();
-    auto* vortBuf = vortField->GetBufferPointer();
-    auto* magBuf = vortMag->GetBufferPointer();
-    auto* helBuf = helicity->GetBufferPointer();
-    auto* rhBuf = rightHel->GetBufferPointer();
-    auto* lhBuf = leftHel->GetBufferPointer();
-
-    int nx = static_cast<int>(size[0]);
-    int ny = static_cast<int>(size[1]);
-    int nz = static_cast<int>(size[2]);
-
-    for (int z = 1; z < nz - 1; ++z) {
-        for (int y = 1; y < ny - 1; ++y) {
-            for (int x = 1; x < nx - 1; ++x) {
-                int idx = z * ny * nx + y * nx + x;
-
-                // Neighbor indices for central differences
-                int xp = z * ny * nx + y * nx + (x + 1);
-                int xm = z * ny * nx + y * nx + (x - 1);
-                int yp = z * ny * nx + (y + 1) * nx + x;
-                int ym = z * ny * nx + (y - 1) * nx + x;
-                int zp = (z + 1) * ny * nx + y * nx + x;
-                int zm = (z - 1) * ny * nx + y * nx + x;
-
-                // Velocity components at neighbors
-                // dVx/dy, dVx/dz
-                double dVxDy = (vBuf[yp * 3] - vBuf[ym * 3]) / (2.0 * dyMM);
-                double dVxDz = (vBuf[zp * 3] - vBuf[zm * 3]) / (2.0 * dzMM);
-
-                // dVy/dx, dVy/dz
-                double dVyDx = (vBuf[xp * 3 + 1] - vBuf[xm * 3 + 1]) / (2.0 * dxMM);
-                double dVyDz = (vBuf[zp * 3 + 1] - vBuf[zm * 3 + 1]) / (2.0 * dzMM);
-
-                // dVz/dx, dVz/dy
-                double dVzDx = (vBuf[xp * 3 + 2] - vBuf[xm * 3 + 2]) / (2.0 * dxMM);
-                double dVzDy = (vBuf[yp * 3 + 2] - vBuf[ym * 3 + 2]) / (2.0 * dyMM);
-
-                // curl(V) = (dVz/dy - dVy/dz, dVx/dz - dVz/dx, dVy/dx - dVx/dy)
-                // Convert from cm/s/mm to 1/s: multiply by 10
-                double wx = (dVzDy - dVyDz) * 10.0;
-                double wy = (dVxDz - dVzDx) * 10.0;
-                double wz = (dVyDx - dVxDy) * 10.0;
-
-                vortBuf[idx * 3]     = static_cast<float>(wx);
-                vortBuf[idx * 3 + 1] = static_cast<float>(wy);
-                vortBuf[idx * 3 + 2] = static_cast<float>(wz);
-
-                double mag = std::sqrt(wx * wx + wy * wy + wz * wz);
-                magBuf[idx] = static_cast<float>(mag);
-
-                // Helicity density: H = V · omega
-                // V in cm/s → convert to m/s (×0.01), omega in 1/s → H in m/s^2
-                double vxM = vBuf[idx * 3]     * 0.01;
-                double vyM = vBuf[idx * 3 + 1] * 0.01;
-                double vzM = vBuf[idx * 3 + 2] * 0.01;
-                double h = vxM * wx + vyM * wy + vzM * wz;
-                helBuf[idx] = static_cast<float>(h);
-                rhBuf[idx] = static_cast<float>(std::max(h, 0.0));
-                lhBuf[idx] = static_cast<float>(std::min(h, 0.0));
-            }
+    // Validate mask dimensions if provided
+    const float* maskBuf = nullptr;
+    if (options.mask) {
+        auto maskSize = options.mask->GetLargestPossibleRegion().GetSize();
+        if (maskSize[0] != size[0] || maskSize[1] != size[1] || maskSize[2] != size[2]) {
+            return std::unexpected(FlowError{
+                FlowError::Code::InvalidInput,
+                "Mask dimensions do not match velocity field"});
         }
+        maskBuf = options.mask->GetBufferPointer();
     }
 
-    VortexResult result;
-    result.vorticityField = vortField;
-    result.vorticityMagnitude = vortMag;
-    result.helicityDensity = helicity;
-    result.rightHelicity = rightHel;
-    result.leftHelicity = leftHel;
+    VelocityGradientResult result;
+    if (wantVorticity) {
+        result.vortex.vorticityField = allocateVectorLike(image);
+        result.vortex.vorticityMagnitude = allocateScalarLike(image);
+    }
+    if (wantHelicity) {
+        result.vortex.helicityDensity = allocateScalarLike(image);
+        result.vortex.rightHelicity = allocateScalarLike(image);
+        result.vortex.leftHelicity = allocateScalarLike(image);
+    }
+    if (wantDissipation) {
+        result.energyLoss.dissipationField = allocateScalarLike(image);
+    }
+    if (wantQ) {
+        result.qCriterion = allocateScalarLike(image);
+    }
+    if (wantLambda2) {
+        result.lambda2 = allocateScalarLike(image);
+    }
 
-    LOG_DEBUG(std::format("Vorticity: computed for {}x{}x{} volume",
-                         nx, ny, nz));
+    auto bufferOf = [](const auto& img) { return img ? img->GetBufferPointer() : nullptr; };
+    const float* vBuf = image->GetBufferPointer();
+    float* vortBuf = bufferOf(result.vortex.vorticityField);
+    float* magBuf = bufferOf(result.vortex.vorticityMagnitude);
+    float* helBuf = bufferOf(result.vortex.helicityDensity);
+    float* rhBuf = bufferOf(result.vortex.rightHelicity);
+    float* lhBuf = bufferOf(result.vortex.leftHelicity);
+    float* dBuf = bufferOf(result.energyLoss.dissipationField);
+    float* qBuf = bufferOf(result.qCriterion);
+    float* l2Buf = bufferOf(result.lambda2);
+
+    const size_t nx = size[0];
+    const size_t ny = size[1];
+    const size_t nz = size[2];
+    const double mu = impl_->bloodViscosity;  // Pa·s
 
-    return result;
-}
+    // Central differences: dVi/dj = (V[j+1] - V[j-1]) / (2*spacing_j)
+    // Velocity is in cm/s and spacing in mm → (cm/s)/mm = 10/s, so scale by 10
+    const std::array<double, 3> invTwoH = {
+        10.0 / (2.0 * spacing[0]), 10.0 / (2.0 * spacing[1]), 10.0 / (2.0 * spacing[2])};
+    const std::array<size_t, 3> stride = {3, nx * 3, nx * ny * 3};
 
-// =============================================================================
-// Turbulent Kinetic Energy (TKE)
-// =============================================================================
+    // Voxel volume in m³: spacing is in mm, so mm³ × 1e-9 = m³
+    const double voxelVolM3 = spacing[0] * spacing[1] * spacing[2] * 1e-9;
+
+    // Work items are (z, block of rows) tiles: the 3-plane stencil of one
+    // tile stays in cache while its rows are swept along x
+    constexpr size_t kTileRows = 16;
+    const size_t interiorY = ny > 2 ? ny - 2 : 0;
+    const size_t interiorZ = nz > 2 ? nz - 2 : 0;
+    const size_t tilesPerSlice = (interiorY + kTileRows - 1) / kTileRows;
+    const size_t tileCount = nx > 2 ? interiorZ * tilesPerSlice : 0;
+
+    // Per-tile partial sums, combined in tile order for deterministic totals
+    std::vector<double> tileDissipation(tileCount, 0.0);
+    std::vector<int> tileVoxels(tileCount, 0);
+
+    core::parallelFor(tileCount, options.threadCount, [&](size_t tile) {
+        const size_t z = 1 + tile / tilesPerSlice;
+        const size_t yBegin = 1 + (tile % tilesPerSlice) * kTileRows;
+        const size_t yEnd = std::min(yBegin + kTileRows, ny - 1);
+
+        double sumPhi = 0.0;
+        int voxels = 0;
+        for (size_t y = yBegin; y < yEnd; ++y) {
+            for (size_t x = 1; x < nx - 1; ++x) {
+                const size_t idx = (z * ny + y) * nx + x;
+                if (maskBuf && maskBuf[idx] == 0.0f) {
+                    continue;
+                }
 
-std::expected<FloatImage3D::Pointer, FlowError>
-VesselAnalyzer::computeTKE(const std::vector<VelocityPhase>& phases) const {
-    if (phases.size() < 3) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InvalidInput,
-            "TKE requires at least 3 cardiac phases"});
-    }
+                // g[i][j] = dV_i/dx_j in 1/s
+                const float* v = vBuf + idx * 3;
+                GradientTensor g;
+                for (size_t j = 0; j < 3; ++j) {
+                    const float* plus = v + stride[j];
+                    const float* minus = v - stride[j];
+                    for (size_t i = 0; i < 3; ++i) {
+                        g[i][j] = (plus[i] - minus[i]) * invTwoH[j];
+                    }
+                }
 
-    // Validate all phases have velocity fields
-    for (const auto& phase : phases) {
-        if (!phase.velocityField) {
-            return std::unexpected(FlowError{
-                FlowError::Code::InvalidInput,
-                "Phase " + std::to_string(phase.phaseIndex) +
-                " has null velocity field"});
-        }
-        if (phase.velocityField->GetNumberOfComponentsPerPixel() != 3) {
-            return std::unexpected(FlowError{
-                FlowError::Code::InvalidInput,
-                "Phase " + std::to_string(phase.phaseIndex) +
-                " has wrong component count"});
+                if (vortBuf || helBuf) {
+                    // curl(V) = (dVz/dy - dVy/dz, dVx/dz - dVz/dx, dVy/dx - dVx/dy)
+                    const double wx = g[2][1] - g[1][2];
+                    const double wy = g[0][2] - g[2][0];
+                    const double wz = g[1][0] - g[0][1];
+                    if (vortBuf) {
+                        vortBuf[idx * 3]     = static_cast<float>(wx);
+                        vortBuf[idx * 3 + 1] = static_cast<float>(wy);
+                        vortBuf[idx * 3 + 2] = static_cast<float>(wz);
+                        magBuf[idx] = static_cast<float>(std::sqrt(wx * wx + wy * wy + wz * wz));
+                    }
+                    if (helBuf) {
+                        // Helicity density: H = V · omega
+                        // V in cm/s → m/s (×0.01), omega in 1/s → H in m/s^2
+                        const double h = 0.01 * (v[0] * wx + v[1] * wy + v[2] * wz);
+                        helBuf[idx] = static_cast<float>(h);
+                        rhBuf[idx] = static_cast<float>(std::max(h, 0.0));
+                        lhBuf[idx] = static_cast<float>(std::min(h, 0.0));
+                    }
+                }
+
+                if (dBuf) {
+                    // Φ = μ { 2(∂u/∂x)² + 2(∂v/∂y)² + 2(∂w/∂z)²
+                    //       + (∂u/∂y + ∂v/∂x)² + (∂v/∂z + ∂w/∂y)²
+                    //       + (∂u/∂z + ∂w/∂x)² }
+                    const double sxy = g[0][1] + g[1][0];
+                    const double syz = g[1][2] + g[2][1];
+                    const double sxz = g[0][2] + g[2][0];
+                    const double phi = mu * (
+                        2.0 * g[0][0] * g[0][0] +
+                        2.0 * g[1][1] * g[1][1] +
+                        2.0 * g[2][2] * g[2][2] +
+                        sxy * sxy + syz * syz + sxz * sxz);
+                    dBuf[idx] = static_cast<float>(phi);
+                    sumPhi += phi;
+                }
+
+                if (qBuf || l2Buf) {
+                    GradientTensor strain;
+                    GradientTensor spin;
+                    for (size_t i = 0; i < 3; ++i) {
+                        for (size_t j = 0; j < 3; ++j) {
+                            strain[i][j] = 0.5 * (g[i][j] + g[j][i]);
+                            spin[i][j] = 0.5 * (g[i][j] - g[j][i]);
+                        }
+                    }
+                    if (qBuf) {
+                        double spinNorm = 0.0;
+                        double strainNorm = 0.0;
+                        for (size_t i = 0; i < 3; ++i) {
+                            for (size_t j = 0; j < 3; ++j) {
+                                spinNorm += spin[i][j] * spin[i][j];
+                                strainNorm += strain[i][j] * strain[i][j];
+                            }
+                        }
+                        qBuf[idx] = static_cast<float>(0.5 * (spinNorm - strainNorm));
+                    }
+                    if (l2Buf) {
+                        l2Buf[idx] = static_cast<float>(lambda2Of(strain, spin));
+                    }
+                }
+                ++voxels;
+            }
         }
-    }
+        tileDissipation[tile] = sumPhi;
+        tileVoxels[tile] = voxels;
+    });
 
-    auto refImage = phases[0].velocityField;
-    auto region = refImage->GetLargestPossibleRegion();
-    auto size = region.GetSize();
-    int numPixels = static_cast<int>(size[0] * size[1] * size[2]);
-    int numPhases = static_cast<int>(phases.size());
+    int voxelCount = 0;
+    double sumDissipation = 0.0;
+    for (size_t t = 0; t < tileCount; ++t) {
+        voxelCount += tileVoxels[t];
+        sumDissipation += tileDissipation[t];
+    }
 
-    // Create output TKE image
-    auto tke = FloatImage3D::New();
-    tke->SetRegions(region);
-    tke->SetSpacing(refImage->GetSpacing());
-    tke->SetOrigin(refImage->GetOrigin());
-    tke->SetDirection(refImage->GetDirection());
-    tke->Allocate(true);
+    if (wantDissipation) {
+        result.energyLoss.totalEnergyLoss = sumDissipation * voxelVolM3;
+        result.energyLoss.meanDissipation =
+            (voxelCount > 0) ? sumDissipation / voxelCount : 0.0;
+        result.energyLoss.voxelCount = voxelCount;
+    }
 
-    auto* tkeBuf = tke->GetBufferPointer();
+    LOG_DEBUG(std::format("VelocityGradient: {}x{}x{} volume, {} voxels, {} tiles",
+                          nx, ny, nz, voxelCount, tileCount));
 
-    // First pass: compute mean velocity at each voxel
-    std::vector<float> meanVx(numPixels, 0.0f);
-    std::vector<float> meanVy(numPixels, 0.0f);
-    std::vector<float> meanVz(numPixels, 0.0f);
+    return result;
+}
 
-    for (const auto& phase : phases) {
-        auto* buf = phase.velocityField->GetBufferPointer();
-        for (int i = 0; i < numPixels; ++i) {
-            meanVx[i] += buf[i * 3];
-            meanVy[i] += buf[i * 3 + 1];
-            meanVz[i] += buf[i * 3 + 2];
-        }
-    }
+// =============================================================================
+// Turbulent Kinetic Energy (TKE)
+// =============================================================================
 
-    for (int i = 0; i < numPixels; ++i) {
-        meanVx[i] /= numPhases;
-        meanVy[i] /= numPhases;
-        meanVz[i] /= numPhases;
+std::expected<FloatImage3D::Pointer, FlowError>
+VesselAnalyzer::computeTKE(const std::vector<VelocityPhase>& phases) const {
+    if (phases.size() < 3) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "TKE requires at least 3 cardiac phases"});
     }
 
-    // Second pass: compute variance
+    TKEAccumulator accumulator(impl_->bloodDensity);
     for (const auto& phase : phases) {
-        auto* buf = phase.velocityField->GetBufferPointer();
-        for (int i = 0; i < numPixels; ++i) {
-            float dvx = buf[i * 3] - meanVx[i];
-            float dvy = buf[i * 3 + 1] - meanVy[i];
-            float dvz = buf[i * 3 + 2] - meanVz[i];
-            tkeBuf[i] += dvx * dvx + dvy * dvy + dvz * dvz;
+        if (auto added = accumulator.addPhase(phase); !added) {
+            return std::unexpected(added.error());
         }
     }
-
-    // TKE = 0.5 * (var_Vx + var_Vy + var_Vz)
-    // Variance = sum((Vi - mean)^2) / N
-    // Convert from (cm/s)^2 to (m/s)^2: divide by 10000
-    // Then multiply by density/2 for J/m^3
-    double rho = impl_->bloodDensity;
-    for (int i = 0; i < numPixels; ++i) {
-        double variance_sum = tkeBuf[i] / numPhases;  // (cm/s)^2
-        double variance_si = variance_sum * 1e-4;     // (m/s)^2
-        tkeBuf[i] = static_cast<float>(0.5 * rho * variance_si);  // J/m^3
-    }
-
-    LOG_INFO(std::format("TKE: computed from {} phases, density={} kg/m^3",
-                        numPhases, rho));
-
-    return tke;
+    return accumulator.result();
 }
 
 // =============================================================================
@@ -781,125 +834,21 @@ VesselAnalyzer::computeKineticEnergy(const VelocityPhase& phase,
 std::expected<EnergyLossResult, FlowError>
 VesselAnalyzer::computeEnergyLoss(const VelocityPhase& phase,
                                    FloatImage3D::Pointer mask) const {
-    if (!phase.velocityField) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InvalidInput,
-            "VelocityPhase has null velocity field"});
-    }
-
-    auto image = phase.velocityField;
-    if (image->GetNumberOfComponentsPerPixel() != 3) {
-        return std::unexpected(FlowError{
-            FlowError::Code::InvalidInput,
-            "Expected 3-component velocity field"});
-    }
-
-    auto region = image->GetLargestPossibleRegion();
-    auto size = region.GetSize();
-    auto spacing = image->GetSpacing();
-
-    // Validate mask dimensions if provided
-    float* maskBuf = nullptr;
-    if (mask) {
-        auto maskSize = mask->GetLargestPossibleRegion().GetSize();
-        if (maskSize[0] != size[0] || maskSize[1] != size[1] || maskSize[2] != size[2]) {
-            return std::unexpected(FlowError{
-                FlowError::Code::InvalidInput,
-                "Mask dimensions do not match velocity field"});
-        }
-        maskBuf = mask->GetBufferPointer();
-    }
-
-    // Create output dissipation image
-    auto dissipation = FloatImage3D::New();
-    dissipation->SetRegions(region);
-    dissipation->SetSpacing(image->GetSpacing());
-    dissipation->SetOrigin(image->GetOrigin());
-    dissipation->SetDirection(image->GetDirection());
-    dissipation->Allocate(true);
-
-    double mu = impl_->bloodViscosity;  // Pa·s
-
-    // Spacing in mm for central differences
-    double dxMM = spacing[0];
-    double dyMM = spacing[1];
-    double dzMM = spacing[2];
-
-    // Voxel volume in m³: spacing is in mm, so mm³ × 1e-9 = m³
-    double voxelVolM3 = dxMM * dyMM * dzMM * 1e-9;
-
-    auto* vBuf = image->GetBufferPointer();
-    auto* dBuf = dissipation->GetBufferPointer();
-
-    int nx = static_cast<int>(size[0]);
-    int ny = static_cast<int>(size[1]);
-    int nz = static_cast<int>(size[2]);
-
-    double totalEL = 0.0;
-    double sumDissipation = 0.0;
-    int voxelCount = 0;
-
-    for (int z = 1; z < nz - 1; ++z) {
-        for (int y = 1; y < ny - 1; ++y) {
-            for (int x = 1; x < nx - 1; ++x) {
-                int idx = z * ny * nx + y * nx + x;
-
-                // Skip masked-out voxels
-                if (maskBuf && maskBuf[idx] == 0.0f) {
-                    continue;
-                }
-
-                // Neighbor indices for central differences
-                int xp = z * ny * nx + y * nx + (x + 1);
-                int xm = z * ny * nx + y * nx + (x - 1);
-                int yp = z * ny * nx + (y + 1) * nx + x;
-                int ym = z * ny * nx + (y - 1) * nx + x;
-                int zp = (z + 1) * ny * nx + y * nx + x;
-                int zm = (z - 1) * ny * nx + y * nx + x;
-
-                // All 9 partial derivatives (raw: (cm/s)/mm)
-                // Convert to SI (1/s) by multiplying by 10
-                double dudx = (vBuf[xp * 3]     - vBuf[xm * 3])     / (2.0 * dxMM) * 10.0;
-                double dudy = (vBuf[yp * 3]     - vBuf[ym * 3])     / (2.0 * dyMM) * 10.0;
-                double dudz = (vBuf[zp * 3]     - vBuf[zm * 3])     / (2.0 * dzMM) * 10.0;
-
-                double dvdx = (vBuf[xp * 3 + 1] - vBuf[xm * 3 + 1]) / (2.0 * dxMM) * 10.0;
-                double dvdy = (vBuf[yp * 3 + 1] - vBuf[ym * 3 + 1]) / (2.0 * dyMM) * 10.0;
-                double dvdz = (vBuf[zp * 3 + 1] - vBuf[zm * 3 + 1]) / (2.0 * dzMM) * 10.0;
-
-                double dwdx = (vBuf[xp * 3 + 2] - vBuf[xm * 3 + 2]) / (2.0 * dxMM) * 10.0;
-                double dwdy = (vBuf[yp * 3 + 2] - vBuf[ym * 3 + 2]) / (2.0 * dyMM) * 10.0;
-                double dwdz = (vBuf[zp * 3 + 2] - vBuf[zm * 3 + 2]) / (2.0 * dzMM) * 10.0;
-
-                // Viscous dissipation rate:
-                // Φ = μ { 2(∂u/∂x)² + 2(∂v/∂y)² + 2(∂w/∂z)²
-                //       + (∂u/∂y + ∂v/∂x)² + (∂v/∂z + ∂w/∂y)²
-                //       + (∂u/∂z + ∂w/∂x)² }
-                double phi = mu * (
-                    2.0 * dudx * dudx +
-                    2.0 * dvdy * dvdy +
-                    2.0 * dwdz * dwdz +
-                    (dudy + dvdx) * (dudy + dvdx) +
-                    (dvdz + dwdy) * (dvdz + dwdy) +
-                    (dudz + dwdx) * (dudz + dwdx)
-                );
-
-                dBuf[idx] = static_cast<float>(phi);
-                sumDissipation += phi;
-                totalEL += phi * voxelVolM3;
-                ++voxelCount;
-            }
-        }
+    VelocityGradientOptions options;
+    options.computeVorticity = false;
+    options.computeHelicity = false;
+    options.computeQCriterion = false;
+    options.computeLambda2 = false;
+    options.mask = mask;
+
+    auto gradients = computeVelocityGradientMetrics(phase, options);
+    if (!gradients) {
+        return std::unexpected(gradients.error());
     }
 
-    EnergyLossResult result;
-    result.dissipationField = dissipation;
-    result.totalEnergyLoss = totalEL;
-    result.meanDissipation = (voxelCount > 0) ? sumDissipation / voxelCount : 0.0;
-    result.voxelCount = voxelCount;
-
+    EnergyLossResult result = std::move(gradients->energyLoss);
     LOG_INFO(std::format("EnergyLoss: total={:.6e} W, mean={:.2f} W/m³, voxels={}",
-                        result.totalEnergyLoss, result.meanDissipation, voxelCount));
+                        result.totalEnergyLoss, result.meanDissipation, result.voxelCount));
 
     return result;
 }
@@ -954,4 +903,331 @@ VesselAnalyzer::computeRRT(vtkSmartPointer<vtkPolyData> surface) const {
     return outputSurface;
 }
 
+// =============================================================================
+// TKEAccumulator
+// =============================================================================
+
+class TKEAccumulator::Impl {
+public:
+    double bloodDensity = 1060.0;
+    int count = 0;
+    ImageGrid grid;
+    std::vector<float> mean;          ///< Running mean, 3 per voxel (cm/s)
+    FloatImage3D::Pointer sumSquares; ///< Sum of squared deviations, all components
+};
+
+TKEAccumulator::TKEAccumulator(double bloodDensity)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->bloodDensity = bloodDensity;
+}
+
+TKEAccumulator::~TKEAccumulator() = default;
+
+TKEAccumulator::TKEAccumulator(TKEAccumulator&&) noexcept = default;
+TKEAccumulator& TKEAccumulator::operator=(TKEAccumulator&&) noexcept = default;
+
+std::expected<void, FlowError> TKEAccumulator::addPhase(const VelocityPhase& phase) {
+    if (!phase.velocityField) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "Phase " + std::to_string(phase.phaseIndex) +
+            " has null velocity field"});
+    }
+    const auto& image = *phase.velocityField;
+    if (image.GetNumberOfComponentsPerPixel() != 3) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "Phase " + std::to_string(phase.phaseIndex) +
+            " has wrong component count"});
+    }
+
+    if (impl_->count == 0) {
+        impl_->grid = ImageGrid::of(image);
+        impl_->sumSquares = allocateScalarLike(phase.velocityField);
+        auto size = impl_->grid.region.GetSize();
+        impl_->mean.assign(size[0] * size[1] * size[2] * 3, 0.0f);
+    } else if (!impl_->grid.matches(image)) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "Phase " + std::to_string(phase.phaseIndex) +
+            " grid does not match the first phase"});
+    }
+
+    // Welford update: mean += delta / n, M2 += delta * (x - mean_new)
+    const double n = static_cast<double>(++impl_->count);
+    const float* buf = image.GetBufferPointer();
+    float* mean = impl_->mean.data();
+    float* m2 = impl_->sumSquares->GetBufferPointer();
+    const size_t numPixels = impl_->mean.size() / 3;
+
+    constexpr size_t kChunk = 1 << 16;
+    core::parallelFor((numPixels + kChunk - 1) / kChunk, 0, [&](size_t chunk) {
+        const size_t end = std::min(numPixels, (chunk + 1) * kChunk);
+        for (size_t i = chunk * kChunk; i < end; ++i) {
+            double deviation = 0.0;
+            for (size_t c = 0; c < 3; ++c) {
+                const double x = buf[i * 3 + c];
+                const double delta = x - mean[i * 3 + c];
+                const double updated = mean[i * 3 + c] + delta / n;
+                mean[i * 3 + c] = static_cast<float>(updated);
+                deviation += delta * (x - updated);
+            }
+            m2[i] = static_cast<float>(m2[i] + deviation);
+        }
+    });
+    return {};
+}
+
+int TKEAccumulator::phaseCount() const {
+    return impl_->count;
+}
+
+std::expected<FloatImage3D::Pointer, FlowError> TKEAccumulator::result() const {
+    if (impl_->count < 3) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "TKE requires at least 3 cardiac phases"});
+    }
+
+    auto tke = FloatImage3D::New();
+    tke->SetRegions(impl_->grid.region);
+    tke->SetSpacing(impl_->grid.spacing);
+    tke->SetOrigin(impl_->grid.origin);
+    tke->SetDirection(impl_->grid.direction);
+    tke->Allocate();
+
+    // TKE = 0.5 * (var_Vx + var_Vy + var_Vz)
+    // Variance = sum((Vi - mean)^2) / N
+    // Convert from (cm/s)^2 to (m/s)^2: divide by 10000
+    // Then multiply by density/2 for J/m^3
+    const double rho = impl_->bloodDensity;
+    const double numPhases = impl_->count;
+    const float* m2 = impl_->sumSquares->GetBufferPointer();
+    float* tkeBuf = tke->GetBufferPointer();
+    const size_t numPixels = impl_->mean.size() / 3;
+    for (size_t i = 0; i < numPixels; ++i) {
+        double variance_sum = m2[i] / numPhases;  // (cm/s)^2
+        double variance_si = variance_sum * 1e-4;  // (m/s)^2
+        tkeBuf[i] = static_cast<float>(0.5 * rho * variance_si);  // J/m^3
+    }
+
+    LOG_INFO(std::format("TKE: computed from {} phases, density={} kg/m^3",
+                        impl_->count, rho));
+
+    return tke;
+}
+
+void TKEAccumulator::reset() {
+    impl_->count = 0;
+    impl_->mean.clear();
+    impl_->mean.shrink_to_fit();
+    impl_->sumSquares = nullptr;
+}
+
+// =============================================================================
+// WallShearAccumulator
+// =============================================================================
+
+class WallShearAccumulator::Impl {
+public:
+    vtkSmartPointer<vtkPolyData> wallMesh;
+    vtkSmartPointer<vtkPolyData> meshWithNormals;
+    double bloodViscosity = 0.004;
+    double lowWSSThreshold = 0.4;
+
+    int count = 0;
+    ImageGrid grid;
+    WallStencil stencil;
+    WSSResult firstPhase;  ///< Single-phase result whose mesh outputs extend
+
+    std::vector<std::array<double, 3>> wss;     ///< Scratch for the current phase
+    std::vector<std::array<double, 3>> sumVec;  ///< sum(tau_i) per vertex
+    std::vector<double> sumMag;                 ///< sum(|tau_i|) per vertex
+
+    /// Fresh copy of the first phase's mesh for a result
+    vtkSmartPointer<vtkPolyData> outputMesh() const {
+        auto mesh = vtkSmartPointer<vtkPolyData>::New();
+        mesh->DeepCopy(firstPhase.wallMesh);
+        return mesh;
+    }
+};
+
+WallShearAccumulator::WallShearAccumulator(vtkSmartPointer<vtkPolyData> wallMesh,
+                                           double bloodViscosity,
+                                           double lowWSSThreshold)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->wallMesh = wallMesh;
+    impl_->bloodViscosity = bloodViscosity;
+    impl_->lowWSSThreshold = lowWSSThreshold;
+}
+
+WallShearAccumulator::~WallShearAccumulator() = default;
+
+WallShearAccumulator::WallShearAccumulator(WallShearAccumulator&&) noexcept = default;
+WallShearAccumulator& WallShearAccumulator::operator=(WallShearAccumulator&&) noexcept = default;
+
+std::expected<void, FlowError> WallShearAccumulator::addPhase(const VelocityPhase& phase) {
+    if (auto valid = validateVelocityPhase(phase); !valid) {
+        return std::unexpected(valid.error());
+    }
+    if (!impl_->wallMesh || impl_->wallMesh->GetNumberOfPoints() == 0) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "Wall mesh is null or empty"});
+    }
+
+    const auto& image = *phase.velocityField;
+    if (impl_->count == 0) {
+        if (!impl_->meshWithNormals) {
+            impl_->meshWithNormals = meshWithPointNormals(impl_->wallMesh);
+        }
+        impl_->grid = ImageGrid::of(image);
+        impl_->stencil = buildWallStencil(image, *impl_->meshWithNormals);
+    }
+
+    if (impl_->grid.matches(image)) {
+        evaluateWallShear(impl_->stencil, image.GetBufferPointer(),
+                          impl_->bloodViscosity, impl_->wss);
+    } else {
+        evaluateWallShear(buildWallStencil(image, *impl_->meshWithNormals),
+                          image.GetBufferPointer(), impl_->bloodViscosity, impl_->wss);
+    }
+
+    const auto& wss = impl_->wss;
+    if (impl_->count == 0) {
+        impl_->firstPhase = buildWSSResult(impl_->meshWithNormals, impl_->stencil,
+                                           wss, impl_->lowWSSThreshold);
+        impl_->sumVec.assign(wss.size(), {0.0, 0.0, 0.0});
+        impl_->sumMag.assign(wss.size(), 0.0);
+    }
+    for (size_t v = 0; v < wss.size(); ++v) {
+        impl_->sumVec[v][0] += wss[v][0];
+        impl_->sumVec[v][1] += wss[v][1];
+        impl_->sumVec[v][2] += wss[v][2];
+        impl_->sumMag[v] += std::sqrt(wss[v][0] * wss[v][0] +
+                                      wss[v][1] * wss[v][1] +
+                                      wss[v][2] * wss[v][2]);
+    }
+    ++impl_->count;
+    return {};
+}
+
+int WallShearAccumulator::phaseCount() const {
+    return impl_->count;
+}
+
+std::expected<WSSResult, FlowError> WallShearAccumulator::tawss() const {
+    if (impl_->count == 0) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "No phases provided for TAWSS computation"});
+    }
+
+    int numVertices = static_cast<int>(impl_->sumMag.size());
+    int numPhases = impl_->count;
+
+    // Compute TAWSS = (1/N) * sum(|WSS_i|)
+    auto tawssArray = vtkSmartPointer<vtkFloatArray>::New();
+    tawssArray->SetName("TAWSS");
+    tawssArray->SetNumberOfTuples(numVertices);
+
+    double sumTAWSS = 0.0;
+    double maxTAWSS = 0.0;
+
+    for (int v = 0; v < numVertices; ++v) {
+        double tawss = impl_->sumMag[v] / numPhases;
+        tawssArray->SetValue(v, static_cast<float>(tawss));
+        sumTAWSS += tawss;
+        maxTAWSS = std::max(maxTAWSS, tawss);
+    }
+
+    auto outputMesh = impl_->outputMesh();
+    outputMesh->GetPointData()->AddArray(tawssArray);
+
+    WSSResult result;
+    result.wallMesh = outputMesh;
+    result.meanWSS = (numVertices > 0) ? sumTAWSS / numVertices : 0.0;
+    result.maxWSS = maxTAWSS;
+    result.wallVertexCount = numVertices;
+
+    LOG_INFO(std::format("TAWSS: mean={:.4f} Pa, max={:.4f} Pa, phases={}",
+                        result.meanWSS, result.maxWSS, numPhases));
+
+    return result;
+}
+
+std::expected<WSSResult, FlowError> WallShearAccumulator::osi() const {
+    if (impl_->count < 2) {
+        return std::unexpected(FlowError{
+            FlowError::Code::InvalidInput,
+            "OSI requires at least 2 cardiac phases"});
+    }
+
+    int numVertices = static_cast<int>(impl_->sumMag.size());
+    int numPhases = impl_->count;
+
+    auto osiArray = vtkSmartPointer<vtkFloatArray>::New();
+    osiArray->SetName("OSI");
+    osiArray->SetNumberOfTuples(numVertices);
+
+    auto tawssArray = vtkSmartPointer<vtkFloatArray>::New();
+    tawssArray->SetName("TAWSS");
+    tawssArray->SetNumberOfTuples(numVertices);
+
+    double sumOSI = 0.0;
+    int validCount = 0;
+
+    for (int v = 0; v < numVertices; ++v) {
+        const auto& sumVec = impl_->sumVec[v];
+        const double sumMag = impl_->sumMag[v];
+        double magSumVec = std::sqrt(sumVec[0] * sumVec[0] +
+                                     sumVec[1] * sumVec[1] +
+                                     sumVec[2] * sumVec[2]);
+
+        double osi = 0.0;
+        double tawss = sumMag / numPhases;
+        if (sumMag > 1e-12) {
+            osi = 0.5 * (1.0 - magSumVec / sumMag);
+        }
+
+        osiArray->SetValue(v, static_cast<float>(osi));
+        tawssArray->SetValue(v, static_cast<float>(tawss));
+
+        sumOSI += osi;
+        ++validCount;
+    }
+
+    auto outputMesh = impl_->outputMesh();
+    outputMesh->GetPointData()->AddArray(osiArray);
+    outputMesh->GetPointData()->AddArray(tawssArray);
+
+    WSSResult result;
+    result.wallMesh = outputMesh;
+    result.meanOSI = (validCount > 0) ? sumOSI / validCount : 0.0;
+    result.wallVertexCount = validCount;
+
+    // Compute TAWSS stats from the array
+    double sumTAWSS = 0.0;
+    double maxTAWSS = 0.0;
+    for (int v = 0; v < numVertices; ++v) {
+        double t = tawssArray->GetValue(v);
+        sumTAWSS += t;
+        maxTAWSS = std::max(maxTAWSS, t);
+    }
+    result.meanWSS = (numVertices > 0) ? sumTAWSS / numVertices : 0.0;
+    result.maxWSS = maxTAWSS;
+
+    LOG_INFO(std::format("OSI: mean={:.4f}, TAWSS mean={:.4f} Pa, phases={}",
+                        result.meanOSI, result.meanWSS, numPhases));
+
+    return result;
+}
+
+void WallShearAccumulator::reset() {
+    impl_->count = 0;
+    impl_->firstPhase = WSSResult{};
+    impl_->sumVec.clear();
+    impl_->sumMag.clear();
+}
+
 }  // namespace dicom_viewer::services
@@ -0,0 +1,446 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "services/render/frame_pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace dicom_viewer::services {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct RawFrame {
+    std::vector<uint8_t> rgba;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t seq = 0;
+    Clock::time_point submitted;
+};
+
+struct EncodedFrame {
+    std::vector<uint8_t> data;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t seq = 0;
+    Clock::time_point submitted;
+};
+
+class TimingAccumulator {
+public:
+    void add(Clock::duration elapsed)
+    {
+        double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+        ++count_;
+        totalMs_ += ms;
+        maxMs_ = std::max(maxMs_, ms);
+    }
+
+    FrameStageTiming summary() const
+    {
+        FrameStageTiming timing;
+        timing.count = count_;
+        timing.averageMs = count_ > 0 ? totalMs_ / static_cast<double>(count_) : 0.0;
+        timing.maxMs = maxMs_;
+        return timing;
+    }
+
+private:
+    uint64_t count_ = 0;
+    double totalMs_ = 0.0;
+    double maxMs_ = 0.0;
+};
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Impl
+// ---------------------------------------------------------------------------
+class FramePipeline::Impl {
+public:
+    struct SessionState {
+        std::string id;
+        std::deque<RawFrame> toEncode;
+        std::deque<EncodedFrame> toSend;
+        bool encodeScheduled = false;  ///< Queued in encodeReady_ or encoding
+        bool sendScheduled = false;    ///< Queued in sendReady_ or sending
+        bool removed = false;
+        uint32_t nextSeq = 0;
+    };
+    using StatePtr = std::shared_ptr<SessionState>;
+
+    explicit Impl(const FramePipelineConfig& config)
+        : config_(config)
+        , maxQueued_(std::max<size_t>(1, config.maxQueuedFrames))
+    {
+        const size_t encoders = config.encodeThreads > 0
+            ? config.encodeThreads
+            : std::max(1u, std::thread::hardware_concurrency());
+        const size_t senders = std::max(1u, config.sendThreads);
+
+        workers_.reserve(encoders + senders);
+        for (size_t i = 0; i < encoders; ++i) {
+            workers_.emplace_back([this]() { encodeLoop(); });
+        }
+        for (size_t i = 0; i < senders; ++i) {
+            workers_.emplace_back([this]() { sendLoop(); });
+        }
+    }
+
+    ~Impl() { stop(); }
+
+    void setSendCallback(FrameSendCallback callback)
+    {
+        std::lock_guard lock(mutex_);
+        sendCallback_ = std::move(callback);
+    }
+
+    bool submit(const std::string& sessionId, std::vector<uint8_t>&& rgba,
+                uint32_t width, uint32_t height)
+    {
+        if (width == 0 || height == 0
+            || rgba.size() < static_cast<size_t>(width) * height * 4) {
+            return false;
+        }
+
+        std::lock_guard lock(mutex_);
+        if (stopping_) {
+            return false;
+        }
+
+        auto& state = sessions_[sessionId];
+        if (!state) {
+            state = std::make_shared<SessionState>();
+            state->id = sessionId;
+        }
+
+        // Latest frame wins: a full stage sheds its oldest waiting frame
+        if (state->toEncode.size() >= maxQueued_) {
+            state->toEncode.pop_front();
+            ++droppedBeforeEncode_;
+        }
+        state->toEncode.push_back(
+            {std::move(rgba), width, height, ++state->nextSeq, Clock::now()});
+        ++submitted_;
+
+        if (!state->encodeScheduled) {
+            state->encodeScheduled = true;
+            encodeReady_.push_back(state);
+            encodeCv_.notify_one();
+        }
+        return true;
+    }
+
+    void removeSession(const std::string& sessionId)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = sessions_.find(sessionId);
+        if (it == sessions_.end()) {
+            return;
+        }
+
+        StatePtr state = std::move(it->second);
+        sessions_.erase(it);
+
+        state->removed = true;
+        droppedBeforeEncode_ += state->toEncode.size();
+        droppedBeforeSend_ += state->toSend.size();
+        state->toEncode.clear();
+        state->toSend.clear();
+        std::erase(encodeReady_, state);
+        std::erase(sendReady_, state);
+        idleCv_.notify_all();
+    }
+
+    void waitIdle()
+    {
+        std::unique_lock lock(mutex_);
+        idleCv_.wait(lock, [this]() {
+            return stopping_
+                || (encodeReady_.empty() && sendReady_.empty() && busy_ == 0);
+        });
+    }
+
+    void stop()
+    {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+            encodeReady_.clear();
+            sendReady_.clear();
+            sessions_.clear();
+            workers.swap(workers_);
+        }
+        encodeCv_.notify_all();
+        sendCv_.notify_all();
+        idleCv_.notify_all();
+
+        for (auto& worker : workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    FramePipelineStats stats() const
+    {
+        std::lock_guard lock(mutex_);
+        FramePipelineStats s;
+        s.submitted = submitted_;
+        s.encoded = encoded_;
+        s.sent = sent_;
+        s.droppedBeforeEncode = droppedBeforeEncode_;
+        s.droppedBeforeSend = droppedBeforeSend_;
+        s.encodeFailures = encodeFailures_;
+        s.queueWait = queueWait_.summary();
+        s.encode = encode_.summary();
+        s.send = send_.summary();
+        s.latency = latency_.summary();
+        return s;
+    }
+
+    void resetStats()
+    {
+        std::lock_guard lock(mutex_);
+        submitted_ = encoded_ = sent_ = 0;
+        droppedBeforeEncode_ = droppedBeforeSend_ = encodeFailures_ = 0;
+        queueWait_ = {};
+        encode_ = {};
+        send_ = {};
+        latency_ = {};
+    }
+
+    const FramePipelineConfig& config() const { return config_; }
+
+private:
+    void encodeLoop()
+    {
+        // One encoder per worker; FrameEncoder is not shared across threads
+        FrameEncoder encoder;
+
+        std::unique_lock lock(mutex_);
+        while (true) {
+            encodeCv_.wait(lock, [this]() {
+                return stopping_ || !encodeReady_.empty();
+            });
+            if (stopping_) {
+                return;
+            }
+
+            StatePtr state = std::move(encodeReady_.front());
+            encodeReady_.pop_front();
+            RawFrame frame = std::move(state->toEncode.front());
+            state->toEncode.pop_front();
+            queueWait_.add(Clock::now() - frame.submitted);
+            ++busy_;
+            lock.unlock();
+
+            auto start = Clock::now();
+            auto data = encoder.encode(frame.rgba.data(), frame.width, frame.height,
+                                       config_.format, config_.quality);
+            auto elapsed = Clock::now() - start;
+            std::vector<uint8_t>().swap(frame.rgba);
+
+            lock.lock();
+            --busy_;
+            if (data.empty()) {
+                ++encodeFailures_;
+            } else {
+                ++encoded_;
+                encode_.add(elapsed);
+                if (state->removed) {
+                    ++droppedBeforeSend_;
+                } else {
+                    enqueueSend(state, {std::move(data), frame.width, frame.height,
+                                        frame.seq, frame.submitted});
+                }
+            }
+
+            // Keep the session scheduled while it has frames waiting, so its
+            // frames are encoded one at a time and in order
+            if (!state->removed && !state->toEncode.empty()) {
+                encodeReady_.push_back(std::move(state));
+                encodeCv_.notify_one();
+            } else {
+                state->encodeScheduled = false;
+            }
+            idleCv_.notify_all();
+        }
+    }
+
+    void sendLoop()
+    {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            sendCv_.wait(lock, [this]() {
+                return stopping_ || !sendReady_.empty();
+            });
+            if (stopping_) {
+                return;
+            }
+
+            StatePtr state = std::move(sendReady_.front());
+            sendReady_.pop_front();
+            EncodedFrame frame = std::move(state->toSend.front());
+            state->toSend.pop_front();
+            FrameSendCallback cb = sendCallback_;
+            ++busy_;
+            lock.unlock();
+
+            // Deliver without the lock so the callback may block on the network
+            auto start = Clock::now();
+            if (cb) {
+                cb(state->id, frame.data, frame.width, frame.height, frame.seq);
+            }
+            auto end = Clock::now();
+
+            lock.lock();
+            --busy_;
+            if (cb) {
+                ++sent_;
+                send_.add(end - start);
+                latency_.add(end - frame.submitted);
+            } else {
+                ++droppedBeforeSend_;
+            }
+
+            if (!state->removed && !state->toSend.empty()) {
+                sendReady_.push_back(std::move(state));
+                sendCv_.notify_one();
+            } else {
+                state->sendScheduled = false;
+            }
+            idleCv_.notify_all();
+        }
+    }
+
+    /// Queue an encoded frame for sending (mutex_ held)
+    void enqueueSend(const StatePtr& state, EncodedFrame frame)
+    {
+        if (state->toSend.size() >= maxQueued_) {
+            state->toSend.pop_front();
+            ++droppedBeforeSend_;
+        }
+        state->toSend.push_back(std::move(frame));
+
+        if (!state->sendScheduled) {
+            state->sendScheduled = true;
+            sendReady_.push_back(state);
+            sendCv_.notify_one();
+        }
+    }
+
+    FramePipelineConfig config_;
+    size_t maxQueued_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable encodeCv_;
+    std::condition_variable sendCv_;
+    std::condition_variable idleCv_;
+    std::unordered_map<std::string, StatePtr> sessions_;
+    std::deque<StatePtr> encodeReady_;  ///< Sessions with a frame to encode
+    std::deque<StatePtr> sendReady_;    ///< Sessions with a frame to send
+    FrameSendCallback sendCallback_;
+    size_t busy_ = 0;  ///< Frames being encoded or sent
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+
+    uint64_t submitted_ = 0;
+    uint64_t encoded_ = 0;
+    uint64_t sent_ = 0;
+    uint64_t droppedBeforeEncode_ = 0;
+    uint64_t droppedBeforeSend_ = 0;
+    uint64_t encodeFailures_ = 0;
+    TimingAccumulator queueWait_;
+    TimingAccumulator encode_;
+    TimingAccumulator send_;
+    TimingAccumulator latency_;
+};
+
+// ---------------------------------------------------------------------------
+// FramePipeline
+// ---------------------------------------------------------------------------
+FramePipeline::FramePipeline(const FramePipelineConfig& config)
+    : impl_(std::make_unique<Impl>(config))
+{
+}
+
+FramePipeline::~FramePipeline() = default;
+
+void FramePipeline::setSendCallback(FrameSendCallback callback)
+{
+    impl_->setSendCallback(std::move(callback));
+}
+
+bool FramePipeline::submit(const std::string& sessionId,
+                           std::vector<uint8_t>&& rgbaFrame,
+                           uint32_t width, uint32_t height)
+{
+    return impl_->submit(sessionId, std::move(rgbaFrame), width, height);
+}
+
+void FramePipeline::removeSession(const std::string& sessionId)
+{
+    impl_->removeSession(sessionId);
+}
+
+void FramePipeline::waitIdle()
+{
+    impl_->waitIdle();
+}
+
+void FramePipeline::stop()
+{
+    impl_->stop();
+}
+
+FramePipelineStats FramePipeline::stats() const
+{
+    return impl_->stats();
+}
+
+void FramePipeline::resetStats()
+{
+    impl_->resetStats();
+}
+
+const FramePipelineConfig& FramePipeline::config() const
+{
+    return impl_->config();
+}
+
+} // namespace dicom_viewer::services
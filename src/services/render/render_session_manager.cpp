@@ -28,6 +28,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "services/render/render_session_manager.hpp"
+#include "core/parallel_for.hpp"
 #include "services/render/adaptive_quality_controller.hpp"
 #include "services/render/render_session.hpp"
 #include "services/render/session_token_validator.hpp"
@@ -35,12 +36,14 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 
 namespace dicom_viewer::services {
 
@@ -49,16 +52,34 @@ namespace dicom_viewer::services {
 // ---------------------------------------------------------------------------
 class RenderSessionManager::Impl {
 public:
+    // Lock order: SessionEntry::frameMutex may be held while taking mutex_
+    // (the frame callback may call back into the manager), never the reverse.
     struct SessionEntry {
         std::unique_ptr<RenderSession> session;
-        std::chrono::steady_clock::time_point lastActive;
+        std::chrono::steady_clock::time_point lastActive;  ///< Guarded by mutex_
         uint32_t width;
         uint32_t height;
-        uint32_t frameSeq = 0;
+        size_t worker = 0;  ///< Render worker that owns this session
         AdaptiveQualityController qualityController;
-    };
+        CachedVolumeHandle volume;  ///< Keeps the shared input volume resident
 
-    explicit Impl(const RenderSessionManagerConfig& config) : config_(config) {}
+        std::mutex frameMutex;  ///< Serializes capture, delivery and input changes
+        uint32_t frameSeq = 0;  ///< Guarded by frameMutex
+        bool closed = false;    ///< Guarded by frameMutex
+    };
+    using EntryPtr = std::shared_ptr<SessionEntry>;
+
+    explicit Impl(const RenderSessionManagerConfig& config)
+        : config_(config)
+        , volumeCache_(config.volumeCacheBudgetBytes)
+        , workerLoad_(core::resolveThreadCount(
+              config.renderThreads,
+              config.maxSessions > 0
+                  ? config.maxSessions
+                  : std::max(1u, std::thread::hardware_concurrency())),
+              0)
+    {
+    }
 
     void setSessionStore(ISessionStore* store) { sessionStore_ = store; }
 
@@ -81,11 +102,16 @@ public:
         uint32_t w = (width > 0) ? width : config_.defaultWidth;
         uint32_t h = (height > 0) ? height : config_.defaultHeight;
 
-        SessionEntry entry;
-        entry.session = std::make_unique<RenderSession>(w, h);
-        entry.lastActive = std::chrono::steady_clock::now();
-        entry.width = w;
-        entry.height = h;
+        auto entry = std::make_shared<SessionEntry>();
+        entry->session = std::make_unique<RenderSession>(w, h);
+        entry->lastActive = std::chrono::steady_clock::now();
+        entry->width = w;
+        entry->height = h;
+
+        // Pin to the least-loaded worker so its context stays on one thread
+        auto least = std::min_element(workerLoad_.begin(), workerLoad_.end());
+        entry->worker = static_cast<size_t>(least - workerLoad_.begin());
+        ++*least;
 
         sessions_.emplace(sessionId, std::move(entry));
 
@@ -107,16 +133,33 @@ public:
 
     bool destroySession(const std::string& sessionId)
     {
-        std::lock_guard lock(mutex_);
-        bool removed = sessions_.erase(sessionId) > 0;
+        SessionDestroyedCallback cb;
+        EntryPtr entry;
+        {
+            std::lock_guard lock(mutex_);
+            auto it = sessions_.find(sessionId);
+            if (it != sessions_.end()) {
+                entry = releaseLocked(it);
+            }
 
-        if (removed && sessionStore_) {
-            if (!sessionStore_->removeSession(sessionId)) {
-                spdlog::warn("Failed to remove session {} from store", sessionId);
+            if (entry && sessionStore_) {
+                if (!sessionStore_->removeSession(sessionId)) {
+                    spdlog::warn("Failed to remove session {} from store", sessionId);
+                }
             }
+            cb = destroyedCallback_;
         }
 
-        return removed;
+        if (!entry) {
+            return false;
+        }
+        closeEntry(*entry);
+
+        // Notify outside the lock so listeners may call back into the manager
+        if (cb) {
+            cb(sessionId);
+        }
+        return true;
     }
 
     bool hasSession(const std::string& sessionId) const
@@ -132,7 +175,7 @@ public:
         if (it == sessions_.end()) {
             return nullptr;
         }
-        return it->second.session.get();
+        return it->second->session.get();
     }
 
     void touchSession(const std::string& sessionId)
@@ -140,7 +183,7 @@ public:
         std::lock_guard lock(mutex_);
         auto it = sessions_.find(sessionId);
         if (it != sessions_.end()) {
-            it->second.lastActive = std::chrono::steady_clock::now();
+            it->second->lastActive = std::chrono::steady_clock::now();
             if (sessionStore_) {
                 sessionStore_->touchSession(sessionId);
             }
@@ -152,8 +195,8 @@ public:
         std::lock_guard lock(mutex_);
         auto it = sessions_.find(sessionId);
         if (it != sessions_.end()) {
-            it->second.qualityController.onInteractionStart();
-            it->second.lastActive = std::chrono::steady_clock::now();
+            it->second->qualityController.onInteractionStart();
+            it->second->lastActive = std::chrono::steady_clock::now();
         }
     }
 
@@ -162,7 +205,7 @@ public:
         std::lock_guard lock(mutex_);
         auto it = sessions_.find(sessionId);
         if (it != sessions_.end()) {
-            it->second.qualityController.onInteractionEnd();
+            it->second->qualityController.onInteractionEnd();
         }
     }
 
@@ -174,15 +217,89 @@ public:
         if (it == sessions_.end()) {
             return nullptr;
         }
-        return &it->second.qualityController;
+        return &it->second->qualityController;
     }
 
+    bool loadSessionVolume(const std::string& sessionId,
+                           const StudyVolumeKey& key,
+                           const StudyVolumeCache::Loader& loader)
+    {
+        if (!hasSession(sessionId)) {
+            return false;
+        }
+
+        // Decode (or wait for another session's decode) outside the lock
+        auto handle = volumeCache_.getOrLoad(key, loader);
+        if (!handle) {
+            spdlog::warn("Failed to load series {} for session {}",
+                         key.seriesInstanceUid, sessionId);
+            return false;
+        }
+
+        EntryPtr entry = findEntry(sessionId);
+        if (!entry) {
+            return false;
+        }
+
+        // Swap the input between frames, not under the manager lock
+        std::lock_guard frameLock(entry->frameMutex);
+        if (entry->closed) {
+            return false;
+        }
+        entry->session->setInputData(handle->image);
+
+        std::lock_guard lock(mutex_);
+        entry->volume = std::move(handle);
+        entry->lastActive = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool previewSessionVolume(const std::string& sessionId,
+                              vtkSmartPointer<vtkImageData> image)
+    {
+        EntryPtr entry = findEntry(sessionId);
+        if (!entry) {
+            return false;
+        }
+
+        std::lock_guard frameLock(entry->frameMutex);
+        if (entry->closed) {
+            return false;
+        }
+        if (!image) {
+            std::lock_guard lock(mutex_);
+            if (entry->volume) {
+                image = entry->volume->image;
+            }
+        }
+        entry->session->setInputData(image);
+        return true;
+    }
+
+    CachedVolumeHandle sessionVolume(const std::string& sessionId) const
+    {
+        std::lock_guard lock(mutex_);
+        auto it = sessions_.find(sessionId);
+        if (it == sessions_.end()) {
+            return nullptr;
+        }
+        return it->second->volume;
+    }
+
+    StudyVolumeCache& volumeCache() { return volumeCache_; }
+
     void setFrameReadyCallback(FrameReadyCallback callback)
     {
         std::lock_guard lock(mutex_);
         frameCallback_ = std::move(callback);
     }
 
+    void setSessionDestroyedCallback(SessionDestroyedCallback callback)
+    {
+        std::lock_guard lock(mutex_);
+        destroyedCallback_ = std::move(callback);
+    }
+
     void startLoop()
     {
         if (running_.load()) {
@@ -190,7 +307,10 @@ public:
         }
 
         running_.store(true);
-        renderThread_ = std::thread([this]() { renderLoop(); });
+        workers_.reserve(workerLoad_.size());
+        for (size_t w = 0; w < workerLoad_.size(); ++w) {
+            workers_.emplace_back([this, w]() { renderLoop(w); });
+        }
     }
 
     void stopLoop()
@@ -203,15 +323,35 @@ public:
             std::lock_guard lock(cvMutex_);
             running_.store(false);
         }
-        cv_.notify_one();
+        cv_.notify_all();
 
-        if (renderThread_.joinable()) {
-            renderThread_.join();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
         }
+        workers_.clear();
     }
 
     bool isRenderLoopRunning() const { return running_.load(); }
 
+    size_t renderWorkerCount() const { return workerLoad_.size(); }
+
+    RenderLoopStats renderLoopStats() const
+    {
+        std::lock_guard lock(statsMutex_);
+        RenderLoopStats stats;
+        stats.framesRendered = framesRendered_;
+        if (framesRendered_ > 0) {
+            auto n = static_cast<double>(framesRendered_);
+            stats.averageCaptureMs = captureTotalMs_ / n;
+            stats.averageDeliveryMs = deliveryTotalMs_ / n;
+        }
+        stats.maxCaptureMs = captureMaxMs_;
+        stats.maxDeliveryMs = deliveryMaxMs_;
+        return stats;
+    }
+
     size_t cleanupIdleSessions()
     {
         if (config_.idleTimeoutSeconds == 0) {
@@ -221,22 +361,35 @@ public:
         auto now = std::chrono::steady_clock::now();
         auto timeout = std::chrono::seconds(config_.idleTimeoutSeconds);
 
-        std::lock_guard lock(mutex_);
-        size_t removed = 0;
-
-        for (auto it = sessions_.begin(); it != sessions_.end(); ) {
-            if ((now - it->second.lastActive) > timeout) {
-                if (sessionStore_) {
-                    sessionStore_->removeSession(it->first);
+        std::vector<std::string> expired;
+        std::vector<EntryPtr> released;
+        SessionDestroyedCallback cb;
+        {
+            std::lock_guard lock(mutex_);
+            for (auto it = sessions_.begin(); it != sessions_.end(); ) {
+                if ((now - it->second->lastActive) > timeout) {
+                    if (sessionStore_) {
+                        sessionStore_->removeSession(it->first);
+                    }
+                    expired.push_back(it->first);
+                    released.push_back(releaseLocked(it++));
+                } else {
+                    ++it;
                 }
-                it = sessions_.erase(it);
-                ++removed;
-            } else {
-                ++it;
             }
+            cb = destroyedCallback_;
+        }
+
+        for (const auto& entry : released) {
+            closeEntry(*entry);
         }
 
-        return removed;
+        if (cb) {
+            for (const auto& id : expired) {
+                cb(id);
+            }
+        }
+        return expired.size();
     }
 
     size_t activeSessionCount() const
@@ -261,7 +414,31 @@ public:
     SessionTokenValidator& tokenValidator() { return tokenValidator_; }
 
 private:
-    void renderLoop()
+    EntryPtr findEntry(const std::string& sessionId) const
+    {
+        std::lock_guard lock(mutex_);
+        auto it = sessions_.find(sessionId);
+        return it != sessions_.end() ? it->second : nullptr;
+    }
+
+    /// Remove a session from the map and its worker (mutex_ held)
+    EntryPtr releaseLocked(
+        std::unordered_map<std::string, EntryPtr>::iterator it)
+    {
+        EntryPtr entry = std::move(it->second);
+        --workerLoad_[entry->worker];
+        sessions_.erase(it);
+        return entry;
+    }
+
+    /// Wait out an in-flight frame and stop further renders (mutex_ not held)
+    static void closeEntry(SessionEntry& entry)
+    {
+        std::lock_guard frameLock(entry.frameMutex);
+        entry.closed = true;
+    }
+
+    void renderLoop(size_t worker)
     {
         using clock = std::chrono::steady_clock;
         auto frameDuration = std::chrono::microseconds(
@@ -270,7 +447,7 @@ private:
         while (running_.load()) {
             auto frameStart = clock::now();
 
-            renderAllSessions();
+            renderWorkerSessions(worker);
 
             // Sleep until next frame, waking early if stopped
             auto elapsed = clock::now() - frameStart;
@@ -284,57 +461,91 @@ private:
         }
     }
 
-    void renderAllSessions()
+    void renderWorkerSessions(size_t worker)
     {
-        // Snapshot session IDs and callback under lock
-        std::vector<std::string> ids;
+        using clock = std::chrono::steady_clock;
+
+        // Snapshot this worker's sessions and the callback under lock
+        std::vector<std::pair<std::string, EntryPtr>> batch;
         FrameReadyCallback cb;
 
         {
             std::lock_guard lock(mutex_);
             cb = frameCallback_;
-            if (!cb || sessions_.empty()) {
+            if (!cb) {
                 return;
             }
-            ids.reserve(sessions_.size());
-            for (const auto& [id, _] : sessions_) {
-                ids.push_back(id);
+            for (const auto& [id, entry] : sessions_) {
+                if (entry->worker == worker) {
+                    batch.emplace_back(id, entry);
+                }
             }
         }
 
-        // Render each session (lock per session to avoid holding global lock)
-        for (const auto& id : ids) {
-            std::lock_guard lock(mutex_);
-            auto it = sessions_.find(id);
-            if (it == sessions_.end()) {
-                continue;
+        // Render with only the session's own lock held, so bookkeeping and
+        // other workers never wait behind a slow frame
+        for (const auto& [id, entry] : batch) {
+            if (!running_.load()) {
+                return;
             }
 
-            auto& entry = it->second;
+            std::lock_guard frameLock(entry->frameMutex);
+            if (entry->closed) {
+                continue;
+            }
 
             // Check adaptive quality controller
-            if (!entry.qualityController.shouldEmitFrame()) {
+            if (!entry->qualityController.shouldEmitFrame()) {
                 continue;
             }
 
-            auto frame = entry.session->captureVolumeFrame();
+            auto captureStart = clock::now();
+            auto frame = entry->session->captureVolumeFrame();
+            auto deliveryStart = clock::now();
             if (!frame.empty()) {
-                cb(id, frame, entry.width, entry.height);
-                ++entry.frameSeq;
+                cb(id, std::move(frame), entry->width, entry->height);
+                ++entry->frameSeq;
+                recordFrame(deliveryStart - captureStart,
+                            clock::now() - deliveryStart);
             }
         }
     }
 
+    void recordFrame(std::chrono::steady_clock::duration capture,
+                     std::chrono::steady_clock::duration delivery)
+    {
+        using ms = std::chrono::duration<double, std::milli>;
+        double captureMs = ms(capture).count();
+        double deliveryMs = ms(delivery).count();
+
+        std::lock_guard lock(statsMutex_);
+        ++framesRendered_;
+        captureTotalMs_ += captureMs;
+        deliveryTotalMs_ += deliveryMs;
+        captureMaxMs_ = std::max(captureMaxMs_, captureMs);
+        deliveryMaxMs_ = std::max(deliveryMaxMs_, deliveryMs);
+    }
+
     RenderSessionManagerConfig config_;
     SessionTokenValidator tokenValidator_;
+    StudyVolumeCache volumeCache_;
     ISessionStore* sessionStore_ = nullptr;
 
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, SessionEntry> sessions_;
+    std::unordered_map<std::string, EntryPtr> sessions_;
+    std::vector<size_t> workerLoad_;  ///< Sessions pinned to each worker
     FrameReadyCallback frameCallback_;
+    SessionDestroyedCallback destroyedCallback_;
+
+    mutable std::mutex statsMutex_;
+    uint64_t framesRendered_ = 0;
+    double captureTotalMs_ = 0.0;
+    double captureMaxMs_ = 0.0;
+    double deliveryTotalMs_ = 0.0;
+    double deliveryMaxMs_ = 0.0;
 
     std::atomic<bool> running_{false};
-    std::thread renderThread_;
+    std::vector<std::thread> workers_;
     std::mutex cvMutex_;
     std::condition_variable cv_;
 };
@@ -394,6 +605,30 @@ AdaptiveQualityController* RenderSessionManager::getQualityController(
     return impl_->getQualityController(sessionId);
 }
 
+bool RenderSessionManager::loadSessionVolume(const std::string& sessionId,
+                                             const StudyVolumeKey& key,
+                                             const StudyVolumeCache::Loader& loader)
+{
+    return impl_->loadSessionVolume(sessionId, key, loader);
+}
+
+bool RenderSessionManager::previewSessionVolume(const std::string& sessionId,
+                                                vtkSmartPointer<vtkImageData> image)
+{
+    return impl_->previewSessionVolume(sessionId, std::move(image));
+}
+
+CachedVolumeHandle RenderSessionManager::sessionVolume(
+    const std::string& sessionId) const
+{
+    return impl_->sessionVolume(sessionId);
+}
+
+StudyVolumeCache& RenderSessionManager::volumeCache()
+{
+    return impl_->volumeCache();
+}
+
 void RenderSessionManager::setSessionStore(ISessionStore* store)
 {
     impl_->setSessionStore(store);
@@ -404,6 +639,12 @@ void RenderSessionManager::setFrameReadyCallback(FrameReadyCallback callback)
     impl_->setFrameReadyCallback(std::move(callback));
 }
 
+void RenderSessionManager::setSessionDestroyedCallback(
+    SessionDestroyedCallback callback)
+{
+    impl_->setSessionDestroyedCallback(std::move(callback));
+}
+
 void RenderSessionManager::startRenderLoop()
 {
     impl_->startLoop();
@@ -419,6 +660,16 @@ bool RenderSessionManager::isRenderLoopRunning() const
     return impl_->isRenderLoopRunning();
 }
 
+size_t RenderSessionManager::renderWorkerCount() const
+{
+    return impl_->renderWorkerCount();
+}
+
+RenderLoopStats RenderSessionManager::renderLoopStats() const
+{
+    return impl_->renderLoopStats();
+}
+
 size_t RenderSessionManager::cleanupIdleSessions()
 {
     return impl_->cleanupIdleSessions();
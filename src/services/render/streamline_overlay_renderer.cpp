@@ -28,6 +28,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "services/render/streamline_overlay_renderer.hpp"
+#include "core/parallel_for.hpp"
 #include "services/render/hemodynamic_overlay_renderer.hpp"
 #include "services/mpr_renderer.hpp"
 
@@ -49,11 +50,190 @@
 
 #include <algorithm>
 #include <cmath>
+#include <list>
 #include <random>
+#include <unordered_map>
 #include <vector>
 
 namespace dicom_viewer::services {
 
+namespace {
+
+/// Rows per LIC work item; fixed so the output is thread-count independent
+constexpr int kLICRowBlock = 16;
+
+/// Streamlines are traced this many kernel lengths beyond the kernel so
+/// one trace serves many pixels; longer traces drift and stop paying off
+constexpr int kLICStreamlineExtension = 1;
+
+/// Default number of cached LIC textures (3 planes x ~20 cardiac phases)
+constexpr size_t kDefaultLICCacheCapacity = 64;
+
+/// Volume axis normal to an MPR plane (Axial: Z, Coronal: Y, Sagittal: X)
+int sliceAxisFor(MPRPlane plane) {
+    switch (plane) {
+        case MPRPlane::Coronal:  return 1;
+        case MPRPlane::Sagittal: return 0;
+        case MPRPlane::Axial:
+        default:                 return 2;
+    }
+}
+
+/// Voxel slice index closest to @p worldPosition along the plane normal
+int sliceIndexFor(vtkImageData* field, MPRPlane plane, double worldPosition) {
+    int axis = sliceAxisFor(plane);
+    int* dims = field->GetDimensions();
+    double* spacing = field->GetSpacing();
+    double* origin = field->GetOrigin();
+    int index = static_cast<int>(
+        std::round((worldPosition - origin[axis]) / spacing[axis]));
+    return std::clamp(index, 0, dims[axis] - 1);
+}
+
+/**
+ * @brief Input of the fast-LIC kernel over one 2D velocity slice
+ */
+struct LICField {
+    const float* velocity = nullptr;
+    int components = 3;
+    const float* noise = nullptr;
+    int width = 0;
+    int height = 0;
+    double stepSize = 0.5;
+};
+
+/**
+ * @brief Trace one direction of a streamline from a pixel center
+ *
+ * Appends the pixel index and noise value of every sample, starting with
+ * the seed pixel itself. Stops at the image border, at a stagnation point
+ * (after recording it) or after @p maxSamples samples.
+ *
+ * @return true if the trace was cut by @p maxSamples rather than the flow
+ */
+bool traceLICHalf(const LICField& f, int x, int y, double dir, int maxSamples,
+                  std::vector<int>& pixels, std::vector<float>& noise) {
+    double px = x;
+    double py = y;
+    for (int step = 0; step < maxSamples; ++step) {
+        int ix = static_cast<int>(std::round(px));
+        int iy = static_cast<int>(std::round(py));
+        if (ix < 0 || ix >= f.width || iy < 0 || iy >= f.height) {
+            return false;
+        }
+
+        int idx = iy * f.width + ix;
+        pixels.push_back(idx);
+        noise.push_back(f.noise[idx]);
+
+        // Nearest-neighbor velocity is sufficient for visualization
+        const float* v = f.velocity + static_cast<size_t>(idx) * f.components;
+        double vx = v[0];
+        double vy = v[1];
+        double mag = std::sqrt(vx * vx + vy * vy);
+        if (mag < 1e-10) {
+            return false;
+        }
+
+        px += dir * f.stepSize * vx / mag;
+        py += dir * f.stepSize * vy / mag;
+    }
+    return true;
+}
+
+/**
+ * @brief Fast LIC over rows [y0, y1), writing only those output rows
+ *
+ * Seeds a long streamline at every pixel of the block that no earlier
+ * streamline has visited, then slides a box kernel of 2 * kernelLength - 1
+ * samples along it using prefix sums and deposits the result into every
+ * block pixel the streamline crosses. Kernels truncated by the trace
+ * length (not by the flow) are skipped so every deposit is a true LIC
+ * value. Pixels accumulate the mean of all deposits they receive.
+ */
+void computeLICBlock(const LICField& f, int kernelLength, int y0, int y1,
+                     float* output) {
+    const int radius = std::max(kernelLength, 1) - 1;
+    const int halfSamples = radius + 1 + kLICStreamlineExtension * std::max(kernelLength, 1);
+    const size_t blockPixels = static_cast<size_t>(y1 - y0) * f.width;
+    const int blockBegin = y0 * f.width;
+    const int blockEnd = y1 * f.width;
+
+    std::vector<double> sums(blockPixels, 0.0);
+    std::vector<int> hits(blockPixels, 0);
+
+    std::vector<int> backPixels, forePixels, linePixels;
+    std::vector<float> backNoise, foreNoise;
+    std::vector<double> prefix;
+
+    for (int y = y0; y < y1; ++y) {
+        for (int x = 0; x < f.width; ++x) {
+            if (hits[static_cast<size_t>(y - y0) * f.width + x] > 0) {
+                continue;
+            }
+
+            backPixels.clear(); backNoise.clear();
+            forePixels.clear(); foreNoise.clear();
+            bool backCut = traceLICHalf(f, x, y, -1.0, halfSamples, backPixels, backNoise);
+            bool foreCut = traceLICHalf(f, x, y, 1.0, halfSamples, forePixels, foreNoise);
+
+            // Line = reversed backward half (without its seed) + forward half
+            const int back = static_cast<int>(backPixels.size()) - 1;
+            const int length = back + static_cast<int>(forePixels.size());
+            linePixels.resize(length);
+            prefix.assign(static_cast<size_t>(length) + 1, 0.0);
+            for (int i = 0; i < length; ++i) {
+                bool fromBack = i < back;
+                int src = fromBack ? back - i : i - back;
+                linePixels[i] = fromBack ? backPixels[src] : forePixels[src];
+                float n = fromBack ? backNoise[src] : foreNoise[src];
+                prefix[i + 1] = prefix[i] + n;
+            }
+
+            // The seed (index back) always has a complete or flow-limited kernel
+            int first = backCut ? std::min(radius, back) : 0;
+            int last = foreCut ? std::max(length - 1 - radius, back) : length - 1;
+            for (int i = first; i <= last; ++i) {
+                int pixel = linePixels[i];
+                if (pixel < blockBegin || pixel >= blockEnd) {
+                    continue;
+                }
+                int lo = std::max(i - radius, 0);
+                int hi = std::min(i + radius, length - 1);
+                size_t local = static_cast<size_t>(pixel - blockBegin);
+                sums[local] += (prefix[hi + 1] - prefix[lo]) / (hi - lo + 1);
+                ++hits[local];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < blockPixels; ++i) {
+        output[blockBegin + i] = static_cast<float>(sums[i] / hits[i]);
+    }
+}
+
+/**
+ * @brief Cache identity of a LIC texture
+ */
+struct LICCacheKey {
+    int plane = 0;
+    int sliceIndex = 0;
+    int phaseIndex = 0;
+
+    bool operator==(const LICCacheKey&) const = default;
+};
+
+struct LICCacheKeyHash {
+    size_t operator()(const LICCacheKey& key) const noexcept {
+        uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(key.phaseIndex)) << 34)
+                        ^ (static_cast<uint64_t>(static_cast<uint32_t>(key.sliceIndex)) << 2)
+                        ^ static_cast<uint64_t>(key.plane);
+        return std::hash<uint64_t>{}(packed);
+    }
+};
+
+} // anonymous namespace
+
 // =============================================================================
 // Implementation
 // =============================================================================
@@ -80,6 +260,16 @@ public:
     // LIC mode: image actors
     std::array<vtkSmartPointer<vtkImageActor>, 3> licActors;
 
+    // LIC texture cache (most recently used first)
+    using LICCacheEntry = std::pair<LICCacheKey, vtkSmartPointer<vtkImageData>>;
+    int phaseIndex = 0;
+    size_t licCacheCapacity = kDefaultLICCacheCapacity;
+    std::list<LICCacheEntry> licLru;
+    std::unordered_map<LICCacheKey, std::list<LICCacheEntry>::iterator,
+                       LICCacheKeyHash> licCache;
+    uint64_t licCacheHits = 0;
+    uint64_t licCacheMisses = 0;
+
     Impl() {
         for (int i = 0; i < 3; ++i) {
             streamlineActors[i] = vtkSmartPointer<vtkActor>::New();
@@ -123,6 +313,37 @@ public:
         }
     }
 
+    void clearLICCache() {
+        licLru.clear();
+        licCache.clear();
+    }
+
+    vtkSmartPointer<vtkImageData> findLICTexture(const LICCacheKey& key) {
+        auto it = licCache.find(key);
+        if (it == licCache.end()) {
+            return nullptr;
+        }
+        licLru.splice(licLru.begin(), licLru, it->second);
+        return it->second->second;
+    }
+
+    void storeLICTexture(const LICCacheKey& key,
+                         vtkSmartPointer<vtkImageData> texture) {
+        if (licCacheCapacity == 0) {
+            return;
+        }
+        licLru.emplace_front(key, texture);
+        licCache[key] = licLru.begin();
+        evictLICTextures();
+    }
+
+    void evictLICTextures() {
+        while (licLru.size() > licCacheCapacity) {
+            licCache.erase(licLru.back().first);
+            licLru.pop_back();
+        }
+    }
+
     void regeneratePlane(int planeIndex) {
         if (!velocityField) {
             return;
@@ -131,6 +352,22 @@ public:
         auto mprPlane = static_cast<MPRPlane>(planeIndex);
         double position = slicePositions[planeIndex];
 
+        // Cine playback revisits the same (plane, slice, phase) textures;
+        // serve them without extracting the slice again
+        LICCacheKey licKey;
+        if (mode == Mode::LIC
+            && velocityField->GetNumberOfScalarComponents() >= 3) {
+            licKey = {planeIndex,
+                      sliceIndexFor(velocityField, mprPlane, position),
+                      phaseIndex};
+            if (auto cached = findLICTexture(licKey)) {
+                ++licCacheHits;
+                licActors[planeIndex]->GetMapper()->SetInputData(cached);
+                applyVisibility();
+                return;
+            }
+        }
+
         auto sliceResult = StreamlineOverlayRenderer::extractSliceVelocity(
             velocityField, mprPlane, position);
         if (!sliceResult.has_value()) {
@@ -172,6 +409,8 @@ public:
             auto licResult = StreamlineOverlayRenderer::computeLIC(
                 velocitySlice, licParams);
             if (licResult.has_value()) {
+                ++licCacheMisses;
+                storeLICTexture(licKey, *licResult);
                 licActors[planeIndex]->GetMapper()->SetInputData(*licResult);
             }
         }
@@ -198,9 +437,22 @@ StreamlineOverlayRenderer& StreamlineOverlayRenderer::operator=(StreamlineOverla
 
 void StreamlineOverlayRenderer::setVelocityField(vtkSmartPointer<vtkImageData> velocityField) {
     impl_->velocityField = velocityField;
+    impl_->phaseIndex = 0;
+    impl_->clearLICCache();
+    impl_->applyVisibility();
+}
+
+void StreamlineOverlayRenderer::setVelocityField(
+    vtkSmartPointer<vtkImageData> velocityField, int phaseIndex) {
+    impl_->velocityField = velocityField;
+    impl_->phaseIndex = phaseIndex;
     impl_->applyVisibility();
 }
 
+int StreamlineOverlayRenderer::phaseIndex() const noexcept {
+    return impl_->phaseIndex;
+}
+
 bool StreamlineOverlayRenderer::hasVelocityField() const noexcept {
     return impl_->velocityField != nullptr;
 }
@@ -241,6 +493,25 @@ void StreamlineOverlayRenderer::setStreamlineParams(const Streamline2DParams& pa
 
 void StreamlineOverlayRenderer::setLICParams(const LICParams& params) {
     impl_->licParams = params;
+    impl_->clearLICCache();
+}
+
+void StreamlineOverlayRenderer::setLICCacheCapacity(size_t capacity) {
+    impl_->licCacheCapacity = capacity;
+    impl_->evictLICTextures();
+}
+
+void StreamlineOverlayRenderer::clearLICCache() {
+    impl_->clearLICCache();
+}
+
+LICCacheStats StreamlineOverlayRenderer::licCacheStats() const noexcept {
+    LICCacheStats stats;
+    stats.entries = impl_->licLru.size();
+    stats.capacity = impl_->licCacheCapacity;
+    stats.hits = impl_->licCacheHits;
+    stats.misses = impl_->licCacheMisses;
+    return stats;
 }
 
 void StreamlineOverlayRenderer::setRenderers(
@@ -312,7 +583,6 @@ StreamlineOverlayRenderer::extractSliceVelocity(
     // Coronal (XZ plane): slice along Y, extract (Vx, Vz)
     // Sagittal (YZ plane): slice along X, extract (Vy, Vz)
 
-    int sliceAxis = -1;
     int comp0 = -1, comp1 = -1;
     int outDimX = 0, outDimY = 0;
     double outSpacingX = 0.0, outSpacingY = 0.0;
@@ -320,21 +590,18 @@ StreamlineOverlayRenderer::extractSliceVelocity(
 
     switch (plane) {
         case MPRPlane::Axial:
-            sliceAxis = 2;  // Z
             comp0 = 0; comp1 = 1;  // Vx, Vy
             outDimX = dims[0]; outDimY = dims[1];
             outSpacingX = spacing[0]; outSpacingY = spacing[1];
             outOriginX = origin[0]; outOriginY = origin[1];
             break;
         case MPRPlane::Coronal:
-            sliceAxis = 1;  // Y
             comp0 = 0; comp1 = 2;  // Vx, Vz
             outDimX = dims[0]; outDimY = dims[2];
             outSpacingX = spacing[0]; outSpacingY = spacing[2];
             outOriginX = origin[0]; outOriginY = origin[2];
             break;
         case MPRPlane::Sagittal:
-            sliceAxis = 0;  // X
             comp0 = 1; comp1 = 2;  // Vy, Vz
             outDimX = dims[1]; outDimY = dims[2];
             outSpacingX = spacing[1]; outSpacingY = spacing[2];
@@ -343,13 +610,7 @@ StreamlineOverlayRenderer::extractSliceVelocity(
     }
 
     // Find the slice index closest to worldPosition
-    int sliceDim = dims[sliceAxis];
-    double sliceOrigin = origin[sliceAxis];
-    double sliceSpacing = spacing[sliceAxis];
-
-    int sliceIndex = static_cast<int>(
-        std::round((worldPosition - sliceOrigin) / sliceSpacing));
-    sliceIndex = std::clamp(sliceIndex, 0, sliceDim - 1);
+    int sliceIndex = sliceIndexFor(velocityField, plane, worldPosition);
 
     // Create 2D output with 3-component vectors (in-plane velocity + 0 for z)
     auto output = vtkSmartPointer<vtkImageData>::New();
@@ -535,61 +796,28 @@ StreamlineOverlayRenderer::computeLIC(
         n = dist(rng);
     }
 
-    // Get velocity data pointer
-    auto* velPtr = static_cast<float*>(velocitySlice->GetScalarPointer());
-    int numComponents = velocitySlice->GetNumberOfScalarComponents();
+    LICField field;
+    field.velocity = static_cast<float*>(velocitySlice->GetScalarPointer());
+    field.components = velocitySlice->GetNumberOfScalarComponents();
+    field.noise = noise.data();
+    field.width = width;
+    field.height = height;
+    field.stepSize = params.stepSize;
 
-    // LIC output
-    std::vector<float> licOutput(static_cast<size_t>(width) * height, 0.0f);
-
-    // For each pixel, trace streamline forward and backward,
-    // average noise values along the path
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            double sum = 0.0;
-            int count = 0;
-
-            // Trace forward and backward
-            for (int dir = -1; dir <= 1; dir += 2) {
-                double px = static_cast<double>(x);
-                double py = static_cast<double>(y);
-
-                for (int step = 0; step < params.kernelLength; ++step) {
-                    int ix = static_cast<int>(std::round(px));
-                    int iy = static_cast<int>(std::round(py));
-
-                    if (ix < 0 || ix >= width || iy < 0 || iy >= height) {
-                        break;
-                    }
-
-                    size_t idx = static_cast<size_t>(iy) * width + ix;
-                    sum += noise[idx];
-                    ++count;
-
-                    // Get velocity at current position (bilinear would be better,
-                    // but nearest-neighbor is sufficient for visualization)
-                    size_t velIdx = idx * numComponents;
-                    double vx = velPtr[velIdx];
-                    double vy = velPtr[velIdx + 1];
-
-                    double mag = std::sqrt(vx * vx + vy * vy);
-                    if (mag < 1e-10) {
-                        break;
-                    }
-
-                    // Normalize and advance
-                    px += dir * params.stepSize * vx / mag;
-                    py += dir * params.stepSize * vy / mag;
-                }
-            }
-
-            size_t outIdx = static_cast<size_t>(y) * width + x;
-            licOutput[outIdx] = (count > 0)
-                ? static_cast<float>(sum / count)
-                : noise[outIdx];
-        }
+    if (!field.velocity || field.components < 2) {
+        return std::unexpected(OverlayError::NoScalarField);
     }
 
+    // Row blocks write disjoint output rows, so no synchronization is needed
+    std::vector<float> licOutput(static_cast<size_t>(width) * height, 0.0f);
+    const int blockCount = (height + kLICRowBlock - 1) / kLICRowBlock;
+    core::parallelFor(static_cast<size_t>(blockCount), params.threadCount,
+        [&](size_t block) {
+            int y0 = static_cast<int>(block) * kLICRowBlock;
+            int y1 = std::min(y0 + kLICRowBlock, height);
+            computeLICBlock(field, params.kernelLength, y0, y1, licOutput.data());
+        });
+
     // Create output vtkImageData
     auto output = vtkSmartPointer<vtkImageData>::New();
     output->SetDimensions(width, height, 1);
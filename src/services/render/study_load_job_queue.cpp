@@ -0,0 +1,644 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "services/render/study_load_job_queue.hpp"
+#include "services/render/render_session_manager.hpp"
+
+#include "core/image_converter.hpp"
+#include "core/series_builder.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dicom_viewer::services {
+
+const char* toString(LoadJobState state)
+{
+    switch (state) {
+        case LoadJobState::Queued:    return "queued";
+        case LoadJobState::Running:   return "running";
+        case LoadJobState::Completed: return "completed";
+        case LoadJobState::Failed:    return "failed";
+        case LoadJobState::Cancelled: return "cancelled";
+    }
+    return "unknown";
+}
+
+namespace {
+
+std::string newLoadJobId()
+{
+    static thread_local std::mt19937 rng{std::random_device{}()};
+    std::uniform_int_distribution<uint32_t> dist;
+    std::ostringstream oss;
+    oss << "load-" << std::hex << std::setw(8) << std::setfill('0') << dist(rng);
+    return oss.str();
+}
+
+/// Thrown from progress callbacks to unwind a cancelled decode, and again
+/// from the cache loader so the shared cache hands the series to the next
+/// waiting session instead of failing it. SeriesBuilder / DicomLoader convert
+/// it into an ordinary error result, so loaders rethrow after they return.
+class LoadCancelled : public StudyVolumeLoadAborted {
+public:
+    LoadCancelled() : StudyVolumeLoadAborted("Load cancelled") {}
+};
+
+/// Minimum progress change between two pushed updates
+constexpr double kProgressStep = 0.01;
+
+/// Pipeline progress ranges: scanning, decoding, then ITK->VTK handoff
+constexpr double kScanShare = 0.2;
+constexpr double kDecodeEnd = 0.95;
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Impl
+// ---------------------------------------------------------------------------
+class StudyLoadJobQueue::Impl {
+public:
+    struct Job {
+        LoadJobRequest request;
+        LoadJobStatus status;
+        uint64_t sequence = 0;
+        std::atomic<bool> cancelled{false};
+    };
+    using JobPtr = std::shared_ptr<Job>;
+
+    /// Pending order: lower priority value first, then submission order
+    using QueueKey = std::pair<int, uint64_t>;
+
+    Impl(RenderSessionManager& sessions, const StudyLoadJobConfig& config)
+        : sessions_(sessions)
+        , config_(config)
+    {
+        const uint32_t workers = std::max<uint32_t>(config_.workerCount, 1);
+        workers_.reserve(workers);
+        for (uint32_t i = 0; i < workers; ++i) {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~Impl() { stop(); }
+
+    std::optional<std::string> submit(LoadJobRequest request)
+    {
+        auto job = std::make_shared<Job>();
+        LoadJobStatus snapshot;
+        {
+            std::lock_guard lock(mutex_);
+            if (stopping_) {
+                return std::nullopt;
+            }
+            if (config_.maxQueuedJobs > 0 && pending_.size() >= config_.maxQueuedJobs) {
+                spdlog::warn("[load-jobs] Queue full, rejecting load of study {} for session {}",
+                             request.studyInstanceUid, request.sessionId);
+                return std::nullopt;
+            }
+
+            std::string jobId;
+            do {
+                jobId = newLoadJobId();
+            } while (jobs_.count(jobId) > 0);
+
+            job->status.jobId = jobId;
+            job->status.sessionId = request.sessionId;
+            job->status.studyInstanceUid = request.studyInstanceUid;
+            job->status.seriesInstanceUid = request.seriesInstanceUid;
+            job->status.priority = request.priority;
+            job->status.message = "Queued";
+            job->request = std::move(request);
+            job->sequence = nextSequence_++;
+
+            jobs_.emplace(jobId, job);
+            snapshot = job->status;
+        }
+
+        // Announce the job before a worker can pick it up, so listeners
+        // always see "queued" ahead of "running"
+        spdlog::debug("[load-jobs] Queued {} (session {}, study {})",
+                      snapshot.jobId, snapshot.sessionId, snapshot.studyInstanceUid);
+        notify(snapshot);
+
+        {
+            std::lock_guard lock(mutex_);
+            if (job->status.state != LoadJobState::Queued) {
+                // Cancelled (or stopped) while being announced
+                return snapshot.jobId;
+            }
+            pending_.emplace(keyOf(*job), job);
+        }
+        cv_.notify_one();
+        return snapshot.jobId;
+    }
+
+    bool cancel(const std::string& jobId)
+    {
+        std::optional<LoadJobStatus> snapshot;
+        {
+            std::lock_guard lock(mutex_);
+            auto it = jobs_.find(jobId);
+            if (it == jobs_.end()) {
+                return false;
+            }
+            snapshot = cancelLocked(it->second);
+        }
+        if (!snapshot) {
+            return false;
+        }
+        if (snapshot->state == LoadJobState::Cancelled) {
+            notify(*snapshot);
+        }
+        return true;
+    }
+
+    size_t cancelSession(const std::string& sessionId)
+    {
+        std::vector<LoadJobStatus> dropped;
+        size_t cancelled = 0;
+        {
+            std::lock_guard lock(mutex_);
+            for (auto& [id, job] : jobs_) {
+                if (job->request.sessionId != sessionId) {
+                    continue;
+                }
+                if (auto snapshot = cancelLocked(job)) {
+                    ++cancelled;
+                    if (snapshot->state == LoadJobState::Cancelled) {
+                        dropped.push_back(std::move(*snapshot));
+                    }
+                }
+            }
+        }
+        for (const auto& status : dropped) {
+            notify(status);
+        }
+        if (cancelled > 0) {
+            spdlog::info("[load-jobs] Cancelled {} load job(s) of session {}",
+                         cancelled, sessionId);
+        }
+        return cancelled;
+    }
+
+    std::optional<LoadJobStatus> status(const std::string& jobId) const
+    {
+        std::lock_guard lock(mutex_);
+        auto it = jobs_.find(jobId);
+        if (it == jobs_.end()) {
+            return std::nullopt;
+        }
+        return it->second->status;
+    }
+
+    size_t queuedCount() const
+    {
+        std::lock_guard lock(mutex_);
+        return pending_.size();
+    }
+
+    void setProgressCallback(LoadJobProgressCallback callback)
+    {
+        std::lock_guard lock(mutex_);
+        progressCallback_ = std::move(callback);
+    }
+
+    void setVolumeLoader(VolumeLoader loader)
+    {
+        std::lock_guard lock(mutex_);
+        loader_ = std::move(loader);
+    }
+
+    void stop()
+    {
+        std::vector<LoadJobStatus> dropped;
+        {
+            std::lock_guard lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            stopping_ = true;
+            for (auto& [id, job] : jobs_) {
+                if (auto snapshot = cancelLocked(job);
+                    snapshot && snapshot->state == LoadJobState::Cancelled) {
+                    dropped.push_back(std::move(*snapshot));
+                }
+            }
+        }
+        cv_.notify_all();
+        for (const auto& status : dropped) {
+            notify(status);
+        }
+
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    const StudyLoadJobConfig& config() const { return config_; }
+
+private:
+    static QueueKey keyOf(const Job& job)
+    {
+        return {static_cast<int>(job.request.priority), job.sequence};
+    }
+
+    /// Flag a job as cancelled; queued jobs are finished immediately,
+    /// running jobs stop at their next progress report.
+    /// @return Status snapshot, or nullopt if the job had already finished
+    std::optional<LoadJobStatus> cancelLocked(const JobPtr& job)
+    {
+        if (job->status.state != LoadJobState::Queued
+            && job->status.state != LoadJobState::Running) {
+            return std::nullopt;
+        }
+        job->cancelled.store(true);
+
+        if (job->status.state == LoadJobState::Queued) {
+            pending_.erase(keyOf(*job));
+            finishLocked(job, LoadJobState::Cancelled, "Cancelled");
+        }
+        return job->status;
+    }
+
+    void finishLocked(const JobPtr& job, LoadJobState state, std::string message)
+    {
+        job->status.state = state;
+        job->status.message = std::move(message);
+        if (state == LoadJobState::Completed) {
+            job->status.progress = 1.0;
+        }
+
+        // Retain a bounded history of finished jobs for status polling
+        finished_.push_back(job->status.jobId);
+        while (config_.maxRetainedJobs > 0 && finished_.size() > config_.maxRetainedJobs) {
+            jobs_.erase(finished_.front());
+            finished_.pop_front();
+        }
+    }
+
+    void notify(const LoadJobStatus& status)
+    {
+        LoadJobProgressCallback cb;
+        {
+            std::lock_guard lock(mutex_);
+            cb = progressCallback_;
+        }
+        if (cb) {
+            cb(status);
+        }
+    }
+
+    void workerLoop()
+    {
+        while (true) {
+            JobPtr job;
+            LoadJobStatus snapshot;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+                if (stopping_) {
+                    return;
+                }
+                auto next = pending_.begin();
+                job = next->second;
+                pending_.erase(next);
+                job->status.state = LoadJobState::Running;
+                job->status.message = "Starting";
+                snapshot = job->status;
+            }
+            notify(snapshot);
+            run(job);
+        }
+    }
+
+    /// Update progress under the lock; returns a snapshot worth pushing
+    std::optional<LoadJobStatus> advance(const JobPtr& job, double progress,
+                                         const std::string& message)
+    {
+        std::lock_guard lock(mutex_);
+        progress = std::clamp(progress, job->status.progress, 1.0);
+        const bool stepped = progress - job->status.progress >= kProgressStep;
+        const bool relabeled = message != job->status.message;
+        job->status.progress = progress;
+        job->status.message = message;
+        if (!stepped && !relabeled) {
+            return std::nullopt;
+        }
+        return job->status;
+    }
+
+    void run(const JobPtr& job)
+    {
+        ProgressReporter report = [this, job](double progress, const std::string& message) {
+            if (job->cancelled.load()) {
+                return false;
+            }
+            if (auto snapshot = advance(job, progress, message)) {
+                notify(*snapshot);
+            }
+            return true;
+        };
+
+        VolumeLoader customLoader;
+        {
+            std::lock_guard lock(mutex_);
+            customLoader = loader_;
+        }
+
+        bool loaded = false;
+        std::string error;
+        StudyVolumeKey key;
+        try {
+            if (customLoader) {
+                const auto& request = job->request;
+                key.seriesInstanceUid = request.seriesInstanceUid.empty()
+                    ? request.studyInstanceUid : request.seriesInstanceUid;
+                loaded = sessions_.loadSessionVolume(
+                    request.sessionId, key,
+                    [&]() {
+                        auto image = customLoader(request, report);
+                        if (!image && job->cancelled.load()) {
+                            throw LoadCancelled();
+                        }
+                        return image;
+                    });
+            } else {
+                loaded = runDefaultPipeline(job, report, key, error);
+            }
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+
+        LoadJobStatus snapshot;
+        {
+            std::lock_guard lock(mutex_);
+            if (loaded) {
+                // A cancel that arrives after the volume is attached is too late
+                finishLocked(job, LoadJobState::Completed, "Loaded");
+            } else if (job->cancelled.load()) {
+                finishLocked(job, LoadJobState::Cancelled, "Cancelled");
+            } else {
+                if (error.empty()) {
+                    error = sessions_.hasSession(job->request.sessionId)
+                        ? "Failed to load volume" : "Session not found";
+                }
+                finishLocked(job, LoadJobState::Failed, error);
+            }
+            snapshot = job->status;
+        }
+
+        if (snapshot.state == LoadJobState::Failed) {
+            spdlog::warn("[load-jobs] {} failed: {}", snapshot.jobId, snapshot.message);
+        } else {
+            spdlog::info("[load-jobs] {} {} (series {})", snapshot.jobId,
+                         toString(snapshot.state), key.seriesInstanceUid);
+        }
+        notify(snapshot);
+    }
+
+    /// Scan -> select series -> decode (via the shared cache) -> attach
+    bool runDefaultPipeline(const JobPtr& job, const ProgressReporter& report,
+                            StudyVolumeKey& key, std::string& error)
+    {
+        const auto& request = job->request;
+        if (!sessions_.hasSession(request.sessionId)) {
+            error = "Session not found";
+            return false;
+        }
+
+        // A named series that another session already decoded needs no scan
+        if (!request.seriesInstanceUid.empty()) {
+            key.seriesInstanceUid = request.seriesInstanceUid;
+            if (sessions_.volumeCache().find(key)
+                && sessions_.loadSessionVolume(request.sessionId, key, nullptr)) {
+                return true;
+            }
+        }
+
+        core::SeriesBuilder builder;
+        builder.setScanIndexEnabled(config_.useScanIndex);
+        if (!config_.volumeCacheDirectory.empty()) {
+            builder.setVolumeCacheDirectory(config_.volumeCacheDirectory);
+        }
+
+        double share = kScanShare;
+        double offset = 0.0;
+        builder.setProgressCallback(
+            [&](size_t current, size_t total, const std::string& message) {
+                const double fraction = total > 0
+                    ? static_cast<double>(current) / static_cast<double>(total) : 0.0;
+                if (!report(offset + share * fraction, message)) {
+                    throw LoadCancelled();
+                }
+            });
+
+        if (!report(0.0, "Scanning")) {
+            return false;
+        }
+        auto scanned = builder.scanForSeries(request.sourceDirectory);
+        if (!scanned) {
+            error = scanned.error().message;
+            return false;
+        }
+
+        const core::SeriesInfo* selected = nullptr;
+        for (const auto& series : *scanned) {
+            if (!request.studyInstanceUid.empty()
+                && series.metadata.studyInstanceUid != request.studyInstanceUid) {
+                continue;
+            }
+            // SeriesInfo::seriesInstanceUid is the scanner's grouping key;
+            // requests and the cache use the DICOM Series Instance UID
+            if (!request.seriesInstanceUid.empty()
+                && series.metadata.seriesInstanceUid != request.seriesInstanceUid) {
+                continue;
+            }
+            if (!selected || series.sliceCount > selected->sliceCount) {
+                selected = &series;
+            }
+        }
+        if (!selected) {
+            error = "No matching series found for study " + request.studyInstanceUid;
+            return false;
+        }
+
+        key.seriesInstanceUid = selected->metadata.seriesInstanceUid;
+        {
+            std::lock_guard lock(mutex_);
+            job->status.seriesInstanceUid = key.seriesInstanceUid;
+        }
+
+        // The builder already reports decode progress on a 0-100 scale
+        offset = 0.0;
+        share = kDecodeEnd;
+
+        // Other sessions may be waiting on this decode: a cancel must not
+        // publish a failure to them. A coarse preview is taken down again.
+        std::atomic<bool> previewed{false};
+        auto failDecode = [&](const std::string& message) -> vtkSmartPointer<vtkImageData> {
+            if (previewed.load()) {
+                sessions_.previewSessionVolume(request.sessionId, nullptr);
+            }
+            if (job->cancelled.load()) {
+                throw LoadCancelled();
+            }
+            error = message;
+            return nullptr;
+        };
+
+        const core::SeriesInfo& series = *selected;
+        auto decode = [&]() -> vtkSmartPointer<vtkImageData> {
+            using Mode = core::ImageConverter::ConversionMode;
+            if (series.modality == "CT") {
+                // Show each coarse pass in the requesting session; the final
+                // pass goes through the shared cache like any other load
+                auto build = builder.buildCTVolumeProgressive(series,
+                    [&](const core::CTImageType::Pointer& volume, size_t pass, size_t passCount) {
+                        if (pass + 1 >= passCount || job->cancelled.load()) {
+                            return;
+                        }
+                        if (sessions_.previewSessionVolume(
+                                request.sessionId,
+                                core::ImageConverter::itkToVtk(volume, Mode::SharedBuffer))) {
+                            previewed = true;
+                        }
+                    });
+                auto image = build.get();
+                if (!image) {
+                    return failDecode(image.error().message);
+                }
+                report(kDecodeEnd, "Preparing volume");
+                return core::ImageConverter::itkToVtk(*image, Mode::SharedBuffer);
+            }
+            auto image = builder.buildMRVolume(series);
+            if (!image) {
+                return failDecode(image.error().message);
+            }
+            report(kDecodeEnd, "Preparing volume");
+            return core::ImageConverter::itkToVtk(*image, Mode::SharedBuffer);
+        };
+
+        if (job->cancelled.load()) {
+            return false;
+        }
+        return sessions_.loadSessionVolume(request.sessionId, key, decode);
+    }
+
+    RenderSessionManager& sessions_;
+    StudyLoadJobConfig config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    uint64_t nextSequence_ = 0;
+
+    std::unordered_map<std::string, JobPtr> jobs_;
+    std::map<QueueKey, JobPtr> pending_;
+    std::deque<std::string> finished_;
+
+    LoadJobProgressCallback progressCallback_;
+    VolumeLoader loader_;
+
+    std::vector<std::thread> workers_;
+};
+
+// ---------------------------------------------------------------------------
+// StudyLoadJobQueue
+// ---------------------------------------------------------------------------
+StudyLoadJobQueue::StudyLoadJobQueue(RenderSessionManager& sessions,
+                                     const StudyLoadJobConfig& config)
+    : impl_(std::make_unique<Impl>(sessions, config))
+{
+}
+
+StudyLoadJobQueue::~StudyLoadJobQueue() = default;
+
+std::optional<std::string> StudyLoadJobQueue::submit(LoadJobRequest request)
+{
+    return impl_->submit(std::move(request));
+}
+
+bool StudyLoadJobQueue::cancel(const std::string& jobId)
+{
+    return impl_->cancel(jobId);
+}
+
+size_t StudyLoadJobQueue::cancelSession(const std::string& sessionId)
+{
+    return impl_->cancelSession(sessionId);
+}
+
+std::optional<LoadJobStatus> StudyLoadJobQueue::status(const std::string& jobId) const
+{
+    return impl_->status(jobId);
+}
+
+size_t StudyLoadJobQueue::queuedCount() const
+{
+    return impl_->queuedCount();
+}
+
+void StudyLoadJobQueue::setProgressCallback(LoadJobProgressCallback callback)
+{
+    impl_->setProgressCallback(std::move(callback));
+}
+
+void StudyLoadJobQueue::setVolumeLoader(VolumeLoader loader)
+{
+    impl_->setVolumeLoader(std::move(loader));
+}
+
+void StudyLoadJobQueue::stop()
+{
+    impl_->stop();
+}
+
+const StudyLoadJobConfig& StudyLoadJobQueue::config() const
+{
+    return impl_->config();
+}
+
+} // namespace dicom_viewer::services
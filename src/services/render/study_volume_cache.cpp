@@ -0,0 +1,294 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "services/render/study_volume_cache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <exception>
+#include <future>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <vtkDataArray.h>
+#include <vtkPointData.h>
+
+namespace dicom_viewer::services {
+
+namespace {
+
+struct StudyVolumeKeyHash {
+    size_t operator()(const StudyVolumeKey& key) const noexcept
+    {
+        size_t h = std::hash<std::string>{}(key.seriesInstanceUid);
+        return h ^ (std::hash<std::string>{}(key.processing) + 0x9e3779b97f4a7c15ULL
+                    + (h << 6) + (h >> 2));
+    }
+};
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Impl
+// ---------------------------------------------------------------------------
+class StudyVolumeCache::Impl {
+public:
+    explicit Impl(uint64_t budgetBytes) : budget_(budgetBytes) {}
+
+    CachedVolumeHandle getOrLoad(const StudyVolumeKey& key, const Loader& loader)
+    {
+        for (;;) {
+            std::promise<CachedVolumeHandle> promise;
+            std::shared_future<CachedVolumeHandle> pending;
+
+            {
+                std::lock_guard lock(mutex_);
+                if (auto handle = touchLocked(key)) {
+                    ++hits_;
+                    return handle;
+                }
+
+                auto inflight = inflight_.find(key);
+                if (inflight != inflight_.end()) {
+                    ++hits_;
+                    pending = inflight->second;
+                } else {
+                    ++misses_;
+                    inflight_.emplace(key, promise.get_future().share());
+                }
+            }
+
+            // Another thread is decoding this key: share its result, or take
+            // over with our own loader if that thread abandoned the load
+            if (pending.valid()) {
+                try {
+                    return pending.get();
+                } catch (const StudyVolumeLoadAborted&) {
+                    continue;
+                }
+            }
+
+            vtkSmartPointer<vtkImageData> image;
+            try {
+                image = loader ? loader() : nullptr;
+            } catch (const StudyVolumeLoadAborted&) {
+                {
+                    std::lock_guard lock(mutex_);
+                    inflight_.erase(key);
+                }
+                promise.set_exception(std::current_exception());
+                throw;
+            } catch (const std::exception& e) {
+                spdlog::error("[volume-cache] Load of series {} failed: {}",
+                              key.seriesInstanceUid, e.what());
+            }
+
+            CachedVolumeHandle handle;
+            if (image) {
+                auto volume = std::make_shared<CachedVolume>();
+                volume->key = key;
+                volume->image = image;
+                volume->sizeBytes = imageSizeBytes(image);
+                handle = std::move(volume);
+            }
+
+            {
+                std::lock_guard lock(mutex_);
+                inflight_.erase(key);
+                if (handle) {
+                    lru_.push_front(handle);
+                    entries_[key] = lru_.begin();
+                    residentBytes_ += handle->sizeBytes;
+                    evictLocked();
+                }
+            }
+
+            promise.set_value(handle);
+            return handle;
+        }
+    }
+
+    CachedVolumeHandle find(const StudyVolumeKey& key)
+    {
+        std::lock_guard lock(mutex_);
+        return touchLocked(key);
+    }
+
+    bool erase(const StudyVolumeKey& key)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return false;
+        }
+        residentBytes_ -= (*it->second)->sizeBytes;
+        lru_.erase(it->second);
+        entries_.erase(it);
+        return true;
+    }
+
+    void clear()
+    {
+        std::lock_guard lock(mutex_);
+        entries_.clear();
+        lru_.clear();
+        residentBytes_ = 0;
+    }
+
+    void setBudget(uint64_t budgetBytes)
+    {
+        std::lock_guard lock(mutex_);
+        budget_ = budgetBytes;
+        evictLocked();
+    }
+
+    StudyVolumeCacheStats stats() const
+    {
+        std::lock_guard lock(mutex_);
+        StudyVolumeCacheStats s;
+        s.entries = entries_.size();
+        s.residentBytes = residentBytes_;
+        s.budgetBytes = budget_;
+        s.hits = hits_;
+        s.misses = misses_;
+        s.evictions = evictions_;
+        return s;
+    }
+
+private:
+    using LruList = std::list<CachedVolumeHandle>;
+
+    /// Move a resident entry to the front of the LRU list
+    CachedVolumeHandle touchLocked(const StudyVolumeKey& key)
+    {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return nullptr;
+        }
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return *it->second;
+    }
+
+    /// Evict least-recently-used volumes that no session holds any more.
+    /// Volumes still in use are skipped: dropping them would free nothing.
+    void evictLocked()
+    {
+        if (budget_ == 0) {
+            return;
+        }
+
+        auto it = lru_.end();
+        while (residentBytes_ > budget_ && it != lru_.begin()) {
+            --it;
+            if (it->use_count() > 1) {
+                continue;
+            }
+            spdlog::debug("[volume-cache] Evicting series {} ({} bytes)",
+                          (*it)->key.seriesInstanceUid, (*it)->sizeBytes);
+            residentBytes_ -= (*it)->sizeBytes;
+            entries_.erase((*it)->key);
+            it = lru_.erase(it);
+            ++evictions_;
+        }
+
+        if (residentBytes_ > budget_) {
+            spdlog::warn("[volume-cache] {} bytes in use exceed budget of {} bytes",
+                         residentBytes_, budget_);
+        }
+    }
+
+    mutable std::mutex mutex_;
+    uint64_t budget_;
+    uint64_t residentBytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+
+    LruList lru_;  ///< Front = most recently used
+    std::unordered_map<StudyVolumeKey, LruList::iterator, StudyVolumeKeyHash> entries_;
+    std::unordered_map<StudyVolumeKey, std::shared_future<CachedVolumeHandle>,
+                       StudyVolumeKeyHash> inflight_;
+};
+
+// ---------------------------------------------------------------------------
+// StudyVolumeCache
+// ---------------------------------------------------------------------------
+StudyVolumeCache::StudyVolumeCache(uint64_t budgetBytes)
+    : impl_(std::make_unique<Impl>(budgetBytes))
+{
+}
+
+StudyVolumeCache::~StudyVolumeCache() = default;
+
+CachedVolumeHandle StudyVolumeCache::getOrLoad(const StudyVolumeKey& key,
+                                               const Loader& loader)
+{
+    return impl_->getOrLoad(key, loader);
+}
+
+CachedVolumeHandle StudyVolumeCache::find(const StudyVolumeKey& key)
+{
+    return impl_->find(key);
+}
+
+bool StudyVolumeCache::erase(const StudyVolumeKey& key)
+{
+    return impl_->erase(key);
+}
+
+void StudyVolumeCache::clear()
+{
+    impl_->clear();
+}
+
+void StudyVolumeCache::setBudget(uint64_t budgetBytes)
+{
+    impl_->setBudget(budgetBytes);
+}
+
+StudyVolumeCacheStats StudyVolumeCache::stats() const
+{
+    return impl_->stats();
+}
+
+uint64_t StudyVolumeCache::imageSizeBytes(vtkImageData* image)
+{
+    if (!image || !image->GetPointData()) {
+        return 0;
+    }
+    vtkDataArray* scalars = image->GetPointData()->GetScalars();
+    if (!scalars) {
+        return 0;
+    }
+    return static_cast<uint64_t>(scalars->GetNumberOfValues())
+         * static_cast<uint64_t>(scalars->GetDataTypeSize());
+}
+
+} // namespace dicom_viewer::services
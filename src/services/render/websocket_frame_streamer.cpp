@@ -270,6 +270,27 @@ public:
         return sent;
     }
 
+    size_t pushText(const std::string& sessionId, const std::string& message)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = sessions_.find(sessionId);
+        if (it == sessions_.end()) {
+            return 0;
+        }
+
+        size_t sent = 0;
+        auto connections = it->second;
+        for (auto* conn : connections) {
+            try {
+                conn->send_text(message);
+                ++sent;
+            } catch (...) {
+                // Connection may have been closed
+            }
+        }
+        return sent;
+    }
+
     void setInputEventCallback(InputEventCallback callback)
     {
         std::lock_guard lock(mutex_);
@@ -519,6 +540,13 @@ size_t WebSocketFrameStreamer::pushFrame(
         sessionId, frameData, width, height, frameSeq, channelId, frameType);
 }
 
+size_t WebSocketFrameStreamer::pushText(const std::string& sessionId,
+                                        const std::string& message)
+{
+    if (!impl_) return 0;
+    return impl_->pushText(sessionId, message);
+}
+
 void WebSocketFrameStreamer::setInputEventCallback(InputEventCallback callback)
 {
     if (!impl_) return;
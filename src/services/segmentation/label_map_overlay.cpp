@@ -28,8 +28,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "services/segmentation/label_map_overlay.hpp"
+#include "core/image_converter.hpp"
 
-#include <itkImageToVTKImageFilter.h>
 #include <itkExtractImageFilter.h>
 
 #include <vtkImageActor.h>
@@ -38,6 +38,7 @@
 #include <vtkLookupTable.h>
 #include <vtkImageReslice.h>
 #include <vtkMatrix4x4.h>
+#include <vtkPointData.h>
 
 #include <unordered_map>
 
@@ -61,6 +62,7 @@ class LabelMapOverlay::Impl {
 public:
     LabelMapType::Pointer labelMap;
     vtkSmartPointer<vtkImageData> vtkLabelMap;
+    const uint8_t* sharedBuffer = nullptr;  ///< ITK buffer vtkLabelMap aliases
     vtkSmartPointer<vtkLookupTable> lookupTable;
 
     std::unordered_map<uint8_t, LabelColor> labelColors;
@@ -113,17 +115,28 @@ public:
     void updateVTKLabelMap() {
         if (!labelMap) {
             vtkLabelMap = nullptr;
+            sharedBuffer = nullptr;
             return;
         }
 
-        // Convert ITK to VTK image
-        using FilterType = itk::ImageToVTKImageFilter<LabelMapType>;
-        auto filter = FilterType::New();
-        filter->SetInput(labelMap);
-        filter->Update();
-
-        vtkLabelMap = vtkSmartPointer<vtkImageData>::New();
-        vtkLabelMap->DeepCopy(filter->GetOutput());
+        // The VTK label map shares the ITK pixel buffer, so in-place label
+        // edits are already visible; only re-wrap when the buffer changes
+        if (vtkLabelMap && sharedBuffer == labelMap->GetBufferPointer()
+            && static_cast<size_t>(vtkLabelMap->GetNumberOfPoints())
+                   == labelMap->GetBufferedRegion().GetNumberOfPixels()) {
+            vtkLabelMap->GetPointData()->GetScalars()->Modified();
+            vtkLabelMap->Modified();
+        } else {
+            vtkLabelMap = core::ImageConverter::itkToVtk(
+                labelMap, core::ImageConverter::ConversionMode::SharedBuffer);
+            sharedBuffer = labelMap->GetBufferPointer();
+
+            for (auto& data : planeData) {
+                if (data.has_value() && data->reslice) {
+                    data->reslice->SetInputData(vtkLabelMap);
+                }
+            }
+        }
 
         // Update metadata
         auto itkSpacing = labelMap->GetSpacing();
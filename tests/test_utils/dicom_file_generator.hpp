@@ -0,0 +1,187 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+/// @file dicom_file_generator.hpp
+/// @brief Synthetic single-frame DICOM file writer for loader tests
+///
+/// Writes minimal but valid CT Image Storage files (Explicit VR Little
+/// Endian, 16-bit signed, MONOCHROME2) so directory scanning and series
+/// loading can be exercised on disk without sample datasets.
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <gdcmDataElement.h>
+#include <gdcmDataSet.h>
+#include <gdcmFile.h>
+#include <gdcmFileMetaInformation.h>
+#include <gdcmTag.h>
+#include <gdcmTransferSyntax.h>
+#include <gdcmUIDGenerator.h>
+#include <gdcmVR.h>
+#include <gdcmWriter.h>
+
+namespace dicom_viewer::test_utils {
+
+/// Parameters for one synthetic CT slice
+struct SyntheticSliceSpec {
+    std::string studyInstanceUid = "1.2.826.0.1.3680043.8.498.1";
+    std::string seriesInstanceUid = "1.2.826.0.1.3680043.8.498.1.1";
+    std::string seriesDescription = "SYNTHETIC CT";
+    int seriesNumber = 1;
+    int instanceNumber = 1;
+    int rows = 64;
+    int columns = 64;
+    double pixelSpacing = 0.5;
+    double sliceThickness = 1.0;
+    double zPosition = 0.0;
+    double rescaleSlope = 1.0;
+    double rescaleIntercept = -1024.0;
+    int bitsStored = 16;
+    bool isSigned = true;  ///< Pixel Representation (0028,0103)
+    short pixelValue = 0;  ///< Uniform stored value for every pixel
+};
+
+namespace detail {
+
+inline void insertText(gdcm::DataSet& ds, const gdcm::Tag& tag,
+                       const gdcm::VR& vr, std::string value) {
+    // DICOM values must have even length; UIDs pad with NUL, text with space
+    if (value.size() % 2 != 0) {
+        value.push_back(vr == gdcm::VR::UI ? '\0' : ' ');
+    }
+    gdcm::DataElement de(tag);
+    de.SetVR(vr);
+    de.SetByteValue(value.c_str(), static_cast<uint32_t>(value.size()));
+    ds.Insert(de);
+}
+
+inline void insertUS(gdcm::DataSet& ds, const gdcm::Tag& tag, uint16_t value) {
+    gdcm::DataElement de(tag);
+    de.SetVR(gdcm::VR::US);
+    de.SetByteValue(reinterpret_cast<const char*>(&value), sizeof(uint16_t));
+    ds.Insert(de);
+}
+
+}  // namespace detail
+
+/// Write a single-frame CT slice to disk
+/// @param path Destination file path
+/// @param spec Slice geometry, identifiers and pixel value
+/// @return true if GDCM wrote the file successfully
+inline bool writeSyntheticCTSlice(const std::filesystem::path& path,
+                                  const SyntheticSliceSpec& spec) {
+    using detail::insertText;
+    using detail::insertUS;
+
+    const std::string sopClass = "1.2.840.10008.5.1.4.1.1.2";  // CT Image Storage
+    gdcm::UIDGenerator uidGen;
+    const std::string sopInstance = uidGen.Generate();
+
+    gdcm::Writer writer;
+    writer.SetFileName(path.string().c_str());
+    auto& file = writer.GetFile();
+    auto& ds = file.GetDataSet();
+
+    insertText(ds, gdcm::Tag(0x0008, 0x0016), gdcm::VR::UI, sopClass);
+    insertText(ds, gdcm::Tag(0x0008, 0x0018), gdcm::VR::UI, sopInstance);
+    insertText(ds, gdcm::Tag(0x0008, 0x0060), gdcm::VR::CS, "CT");
+    insertText(ds, gdcm::Tag(0x0008, 0x103E), gdcm::VR::LO, spec.seriesDescription);
+    insertText(ds, gdcm::Tag(0x0010, 0x0010), gdcm::VR::PN, "SYNTHETIC^PATIENT");
+    insertText(ds, gdcm::Tag(0x0010, 0x0020), gdcm::VR::LO, "SYN001");
+    insertText(ds, gdcm::Tag(0x0018, 0x0050), gdcm::VR::DS,
+               std::format("{}", spec.sliceThickness));
+    insertText(ds, gdcm::Tag(0x0020, 0x000D), gdcm::VR::UI, spec.studyInstanceUid);
+    insertText(ds, gdcm::Tag(0x0020, 0x000E), gdcm::VR::UI, spec.seriesInstanceUid);
+    insertText(ds, gdcm::Tag(0x0020, 0x0011), gdcm::VR::IS,
+               std::to_string(spec.seriesNumber));
+    insertText(ds, gdcm::Tag(0x0020, 0x0013), gdcm::VR::IS,
+               std::to_string(spec.instanceNumber));
+    insertText(ds, gdcm::Tag(0x0020, 0x0032), gdcm::VR::DS,
+               std::format("0\\0\\{}", spec.zPosition));
+    insertText(ds, gdcm::Tag(0x0020, 0x0037), gdcm::VR::DS, "1\\0\\0\\0\\1\\0");
+    insertText(ds, gdcm::Tag(0x0020, 0x1041), gdcm::VR::DS,
+               std::format("{}", spec.zPosition));
+
+    insertUS(ds, gdcm::Tag(0x0028, 0x0002), 1);
+    insertText(ds, gdcm::Tag(0x0028, 0x0004), gdcm::VR::CS, "MONOCHROME2");
+    insertUS(ds, gdcm::Tag(0x0028, 0x0010), static_cast<uint16_t>(spec.rows));
+    insertUS(ds, gdcm::Tag(0x0028, 0x0011), static_cast<uint16_t>(spec.columns));
+    insertText(ds, gdcm::Tag(0x0028, 0x0030), gdcm::VR::DS,
+               std::format("{}\\{}", spec.pixelSpacing, spec.pixelSpacing));
+    insertUS(ds, gdcm::Tag(0x0028, 0x0100), 16);
+    insertUS(ds, gdcm::Tag(0x0028, 0x0101), static_cast<uint16_t>(spec.bitsStored));
+    insertUS(ds, gdcm::Tag(0x0028, 0x0102), static_cast<uint16_t>(spec.bitsStored - 1));
+    insertUS(ds, gdcm::Tag(0x0028, 0x0103), spec.isSigned ? 1 : 0);
+    insertText(ds, gdcm::Tag(0x0028, 0x1052), gdcm::VR::DS,
+               std::format("{}", spec.rescaleIntercept));
+    insertText(ds, gdcm::Tag(0x0028, 0x1053), gdcm::VR::DS,
+               std::format("{}", spec.rescaleSlope));
+
+    const size_t pixelCount = static_cast<size_t>(spec.rows) * spec.columns;
+    std::vector<short> pixels(pixelCount, spec.pixelValue);
+    gdcm::DataElement pixelData(gdcm::Tag(0x7FE0, 0x0010));
+    pixelData.SetVR(gdcm::VR::OW);
+    pixelData.SetByteValue(reinterpret_cast<const char*>(pixels.data()),
+                           static_cast<uint32_t>(pixelCount * sizeof(short)));
+    ds.Insert(pixelData);
+
+    auto& fmi = file.GetHeader();
+    fmi.Clear();
+    fmi.SetDataSetTransferSyntax(gdcm::TransferSyntax::ExplicitVRLittleEndian);
+
+    return writer.Write();
+}
+
+/// Write an axial CT series of @p sliceCount files into @p directory
+/// @return Paths of the written files in instance order
+inline std::vector<std::filesystem::path> writeSyntheticCTSeries(
+    const std::filesystem::path& directory, int sliceCount,
+    SyntheticSliceSpec spec = {}) {
+    std::filesystem::create_directories(directory);
+    std::vector<std::filesystem::path> paths;
+    paths.reserve(sliceCount);
+    for (int i = 0; i < sliceCount; ++i) {
+        spec.instanceNumber = i + 1;
+        spec.zPosition = i * spec.sliceThickness;
+        spec.pixelValue = static_cast<short>(i);
+        auto path = directory / std::format("slice_{:05d}.dcm", i);
+        if (writeSyntheticCTSlice(path, spec)) {
+            paths.push_back(path);
+        }
+    }
+    return paths;
+}
+
+}  // namespace dicom_viewer::test_utils
@@ -0,0 +1,215 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "services/flow/compact_velocity_phase.hpp"
+
+using namespace dicom_viewer::services;
+
+namespace {
+
+/// Phase with a velocity ramp spanning [-peak, +peak] and a magnitude ramp
+VelocityPhase createRampPhase(unsigned int sx, unsigned int sy, unsigned int sz,
+                              float peak) {
+    VelocityPhase phase;
+    phase.phaseIndex = 3;
+    phase.triggerTime = 120.0;
+
+    auto field = VectorImage3D::New();
+    VectorImage3D::SizeType size = {{sx, sy, sz}};
+    VectorImage3D::RegionType region;
+    region.SetSize(size);
+    field->SetRegions(region);
+    field->SetNumberOfComponentsPerPixel(3);
+    VectorImage3D::SpacingType spacing;
+    spacing[0] = 1.5;
+    spacing[1] = 1.5;
+    spacing[2] = 2.0;
+    field->SetSpacing(spacing);
+    field->Allocate();
+
+    auto magnitude = FloatImage3D::New();
+    magnitude->SetRegions(region);
+    magnitude->SetSpacing(spacing);
+    magnitude->Allocate();
+
+    const size_t voxels = static_cast<size_t>(sx) * sy * sz;
+    float* v = field->GetBufferPointer();
+    float* m = magnitude->GetBufferPointer();
+    for (size_t i = 0; i < voxels; ++i) {
+        const float t = voxels > 1 ? static_cast<float>(i) / (voxels - 1) : 0.0f;
+        v[i * 3 + 0] = peak * (2.0f * t - 1.0f);
+        v[i * 3 + 1] = 0.5f * peak * std::sin(static_cast<float>(i));
+        v[i * 3 + 2] = -0.25f * peak * t;
+        m[i] = 1000.0f * t;
+    }
+
+    phase.velocityField = field;
+    phase.magnitudeImage = magnitude;
+    return phase;
+}
+
+}  // anonymous namespace
+
+// =============================================================================
+// Half precision conversion
+// =============================================================================
+
+TEST(HalfPrecisionTest, ExactValuesRoundTrip) {
+    for (float value : {0.0f, 1.0f, -2.5f, 0.125f, 1024.0f, 65504.0f, -65504.0f}) {
+        EXPECT_EQ(halfToFloat(floatToHalf(value)), value) << value;
+    }
+}
+
+TEST(HalfPrecisionTest, RelativeErrorWithinHalfUlp) {
+    for (float value = 0.01f; value < 60000.0f; value *= 1.37f) {
+        const float decoded = halfToFloat(floatToHalf(value));
+        EXPECT_LE(std::abs(decoded - value) / value, 1.0f / 2048.0f) << value;
+    }
+}
+
+TEST(HalfPrecisionTest, OverflowAndSpecialValues) {
+    EXPECT_TRUE(std::isinf(halfToFloat(floatToHalf(1.0e6f))));
+    EXPECT_TRUE(std::isinf(halfToFloat(
+        floatToHalf(-std::numeric_limits<float>::infinity()))));
+    EXPECT_TRUE(std::isnan(halfToFloat(
+        floatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+    // Smallest half subnormal survives
+    const float tiny = std::ldexp(1.0f, -24);
+    EXPECT_EQ(halfToFloat(floatToHalf(tiny)), tiny);
+}
+
+// =============================================================================
+// Phase compression
+// =============================================================================
+
+TEST(CompactVelocityPhaseTest, Int16ErrorWithinHalfStep) {
+    auto phase = createRampPhase(8, 8, 4, 120.0f);
+    auto compact = compressPhase(phase, PhaseStorageFormat::QuantizedInt16, 150.0);
+
+    EXPECT_EQ(compact.format, PhaseStorageFormat::QuantizedInt16);
+    EXPECT_FLOAT_EQ(compact.velocityScale, 150.0f / 32767.0f);
+    EXPECT_NEAR(compact.velocityErrorBound(), 150.0 / 32767.0 / 2.0, 1e-9);
+
+    auto error = measureQuantizationError(
+        phase, PhaseStorageFormat::QuantizedInt16, 150.0);
+    EXPECT_LE(error.maxAbsError, compact.velocityErrorBound() * 1.0001);
+    EXPECT_GT(error.rmsError, 0.0);
+    EXPECT_LE(error.rmsError, error.maxAbsError);
+}
+
+TEST(CompactVelocityPhaseTest, Int16ScaleCoversPeakBeyondVenc) {
+    // Unwrapped velocities may exceed VENC; they must not clip
+    auto phase = createRampPhase(4, 4, 4, 200.0f);
+    auto compact = compressPhase(phase, PhaseStorageFormat::QuantizedInt16, 100.0);
+
+    EXPECT_FLOAT_EQ(compact.velocityScale, 200.0f / 32767.0f);
+    EXPECT_NEAR(compact.velocityAt(0)[0], -200.0f, compact.velocityErrorBound());
+}
+
+TEST(CompactVelocityPhaseTest, Float16ErrorIsRelative) {
+    auto phase = createRampPhase(8, 8, 4, 120.0f);
+    auto compact = compressPhase(phase, PhaseStorageFormat::Float16);
+
+    EXPECT_EQ(compact.format, PhaseStorageFormat::Float16);
+    auto error = measureQuantizationError(phase, PhaseStorageFormat::Float16);
+    EXPECT_LE(error.maxAbsError, compact.velocityErrorBound());
+}
+
+TEST(CompactVelocityPhaseTest, Float16ScalesMagnitudeBeyondHalfRange) {
+    auto phase = createRampPhase(8, 8, 4, 120.0f);
+    float* m = phase.magnitudeImage->GetBufferPointer();
+    const size_t voxels = 8 * 8 * 4;
+    for (size_t i = 0; i < voxels; ++i) {
+        m[i] *= 200.0f;  // Peak 200000, above the largest half (65504)
+    }
+
+    auto compact = compressPhase(phase, PhaseStorageFormat::Float16);
+    EXPECT_FLOAT_EQ(compact.velocityScale, 1.0f);
+    EXPECT_GT(compact.magnitudeScale, 1.0f);
+    for (size_t i = 0; i < voxels; ++i) {
+        const float decoded = compact.magnitudeAt(i);
+        ASSERT_TRUE(std::isfinite(decoded)) << i;
+        EXPECT_LE(std::abs(decoded - m[i]), m[i] / 2048.0f + 1e-3f) << i;
+    }
+}
+
+TEST(CompactVelocityPhaseTest, HalvesMemoryFootprint) {
+    auto phase = createRampPhase(16, 16, 8, 80.0f);
+    auto compact = compressPhase(phase, PhaseStorageFormat::QuantizedInt16);
+
+    EXPECT_EQ(compact.velocity.size(), 16u * 16u * 8u * 3u);
+    EXPECT_EQ(compact.magnitude.size(), 16u * 16u * 8u);
+    auto error = measureQuantizationError(phase, PhaseStorageFormat::QuantizedInt16);
+    EXPECT_GT(error.compressionRatio, 1.9);
+    EXPECT_LE(error.compressionRatio, 2.0);
+}
+
+TEST(CompactVelocityPhaseTest, DecompressRestoresGeometryAndValues) {
+    auto phase = createRampPhase(6, 5, 4, 90.0f);
+    auto compact = compressPhase(phase, PhaseStorageFormat::QuantizedInt16, 100.0);
+    auto restored = decompressPhase(compact);
+
+    EXPECT_EQ(restored.phaseIndex, 3);
+    EXPECT_DOUBLE_EQ(restored.triggerTime, 120.0);
+    ASSERT_TRUE(restored.velocityField);
+    ASSERT_TRUE(restored.magnitudeImage);
+
+    auto size = restored.velocityField->GetLargestPossibleRegion().GetSize();
+    EXPECT_EQ(size[0], 6u);
+    EXPECT_EQ(size[1], 5u);
+    EXPECT_EQ(size[2], 4u);
+    EXPECT_EQ(restored.velocityField->GetNumberOfComponentsPerPixel(), 3u);
+    EXPECT_DOUBLE_EQ(restored.velocityField->GetSpacing()[2], 2.0);
+
+    const float* original = phase.velocityField->GetBufferPointer();
+    const float* decoded = restored.velocityField->GetBufferPointer();
+    for (size_t i = 0; i < compact.velocity.size(); ++i) {
+        EXPECT_NEAR(decoded[i], original[i], compact.velocityErrorBound() * 1.0001);
+    }
+    const float* mag = restored.magnitudeImage->GetBufferPointer();
+    EXPECT_NEAR(mag[6 * 5 * 4 - 1], 1000.0f, 0.1f);
+}
+
+TEST(CompactVelocityPhaseTest, NullImagesAreSkipped) {
+    VelocityPhase phase;
+    phase.phaseIndex = 1;
+    auto compact = compressPhase(phase, PhaseStorageFormat::Float16);
+
+    EXPECT_FALSE(compact.hasVelocity);
+    EXPECT_FALSE(compact.hasMagnitude);
+    auto restored = decompressPhase(compact);
+    EXPECT_FALSE(restored.velocityField);
+    EXPECT_FALSE(restored.magnitudeImage);
+}
@@ -30,8 +30,11 @@
 #include "core/dicom_loader.hpp"
 #include "core/transfer_syntax_decoder.hpp"
 
+#include "../test_utils/dicom_file_generator.hpp"
+
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -334,6 +337,104 @@ TEST_F(DicomLoaderTest, ScanDirectoryWithNestedSubdirectories)
     EXPECT_TRUE(result.value().empty());
 }
 
+// ============================================================================
+// scanDirectory — header-only parallel scan
+// ============================================================================
+TEST_F(DicomLoaderTest, ScanOptionsDefaults)
+{
+    ScanOptions options;
+    EXPECT_EQ(options.threadCount, 0u);
+    EXPECT_TRUE(options.headerOnly);
+}
+
+TEST_F(DicomLoaderTest, ReadHeaderNonDicomFile)
+{
+    auto path = createNonDicomFile("header.txt", "not dicom");
+    auto result = DicomLoader::readHeader(path);
+    EXPECT_FALSE(result.has_value());
+}
+
+TEST_F(DicomLoaderTest, ReadHeaderExtractsSliceAndMetadata)
+{
+    test_utils::SyntheticSliceSpec spec;
+    spec.instanceNumber = 7;
+    spec.zPosition = 12.5;
+    spec.rows = 32;
+    spec.columns = 48;
+    spec.pixelSpacing = 0.75;
+    auto path = tempDir_ / "slice.dcm";
+    ASSERT_TRUE(test_utils::writeSyntheticCTSlice(path, spec));
+
+    auto result = DicomLoader::readHeader(path);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    const auto& header = result.value();
+    EXPECT_EQ(header.metadata.seriesInstanceUid, spec.seriesInstanceUid);
+    EXPECT_EQ(header.metadata.modality, "CT");
+    EXPECT_EQ(header.metadata.rows, 32);
+    EXPECT_EQ(header.metadata.columns, 48);
+    EXPECT_EQ(header.metadata.bitsAllocated, 16);
+    EXPECT_DOUBLE_EQ(header.metadata.pixelSpacingX, 0.75);
+    EXPECT_DOUBLE_EQ(header.metadata.rescaleIntercept, -1024.0);
+    EXPECT_TRUE(header.metadata.hasAcquisitionAttributes);
+    EXPECT_TRUE(header.metadata.imageType.empty());
+    EXPECT_EQ(header.slice.instanceNumber, 7);
+    EXPECT_DOUBLE_EQ(header.slice.imagePosition[2], 12.5);
+    EXPECT_EQ(header.seriesKey.rfind(spec.seriesInstanceUid, 0), 0u);
+}
+
+TEST_F(DicomLoaderTest, ScanDirectoryHeaderOnlyGroupsAndSortsSlices)
+{
+    auto dir = tempDir_ / "series";
+    auto written = test_utils::writeSyntheticCTSeries(dir, 12);
+    ASSERT_EQ(written.size(), 12u);
+    std::ofstream(dir / "notes.txt") << "not dicom";
+
+    DicomLoader loader;
+    auto result = loader.scanDirectory(dir, ScanOptions{4, true});
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1u);
+
+    const auto& slices = result->begin()->second;
+    ASSERT_EQ(slices.size(), 12u);
+    for (size_t i = 1; i < slices.size(); ++i) {
+        EXPECT_LT(slices[i - 1].imagePosition[2], slices[i].imagePosition[2]);
+    }
+}
+
+TEST_F(DicomLoaderTest, ScanDirectoryResultIndependentOfThreadCount)
+{
+    auto dir = tempDir_ / "two_series";
+    test_utils::SyntheticSliceSpec second;
+    second.seriesInstanceUid = "1.2.826.0.1.3680043.8.498.1.2";
+    second.seriesNumber = 2;
+    test_utils::writeSyntheticCTSeries(dir / "a", 5);
+    test_utils::writeSyntheticCTSeries(dir / "b", 4, second);
+    for (const auto& sub : {"a", "b"}) {
+        for (const auto& entry : std::filesystem::directory_iterator(dir / sub)) {
+            std::filesystem::rename(entry.path(),
+                dir / (std::string(sub) + entry.path().filename().string()));
+        }
+    }
+
+    DicomLoader loader;
+    auto serial = loader.scanDirectory(dir, ScanOptions{1, true});
+    auto parallel = loader.scanDirectory(dir, ScanOptions{8, true});
+    ASSERT_TRUE(serial.has_value());
+    ASSERT_TRUE(parallel.has_value());
+    ASSERT_EQ(serial->size(), 2u);
+    ASSERT_EQ(serial->size(), parallel->size());
+
+    for (const auto& [key, slices] : *serial) {
+        auto it = parallel->find(key);
+        ASSERT_NE(it, parallel->end());
+        ASSERT_EQ(slices.size(), it->second.size());
+        for (size_t i = 0; i < slices.size(); ++i) {
+            EXPECT_EQ(slices[i].filePath, it->second[i].filePath);
+        }
+    }
+}
+
 // ============================================================================
 // loadCTSeries — error paths
 // ============================================================================
@@ -359,6 +460,117 @@ TEST_F(DicomLoaderTest, LoadCTSeriesNonexistentFiles)
     EXPECT_EQ(result.error().code, DicomError::SeriesAssemblyFailed);
 }
 
+// ============================================================================
+// loadCTSeries / loadMRSeries — parallel direct-to-buffer decode
+// ============================================================================
+TEST_F(DicomLoaderTest, LoadCTSeriesDecodesIntoVolumeWithRescale)
+{
+    auto dir = tempDir_ / "ct_series";
+    test_utils::writeSyntheticCTSeries(dir, 6);
+
+    DicomLoader loader;
+    auto scan = loader.scanDirectory(dir);
+    ASSERT_TRUE(scan.has_value());
+    ASSERT_EQ(scan->size(), 1u);
+
+    loader.setDecodeThreadCount(4);
+    auto result = loader.loadCTSeries(scan->begin()->second);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    auto image = result.value();
+    auto size = image->GetLargestPossibleRegion().GetSize();
+    EXPECT_EQ(size[0], 64u);
+    EXPECT_EQ(size[1], 64u);
+    EXPECT_EQ(size[2], 6u);
+    EXPECT_NEAR(image->GetSpacing()[0], 0.5, 1e-9);
+    EXPECT_NEAR(image->GetSpacing()[2], 1.0, 1e-9);
+
+    // Slice i stores value i; rescale intercept -1024 is applied on decode
+    for (long z = 0; z < 6; ++z) {
+        CTImageType::IndexType idx = {{10, 20, z}};
+        EXPECT_EQ(image->GetPixel(idx), static_cast<short>(z - 1024)) << "z=" << z;
+    }
+    EXPECT_EQ(loader.getMetadata().modality, "CT");
+}
+
+TEST_F(DicomLoaderTest, LoadCTSeriesSameResultForAnyThreadCount)
+{
+    auto dir = tempDir_ / "ct_threads";
+    test_utils::writeSyntheticCTSeries(dir, 9);
+
+    DicomLoader loader;
+    auto scan = loader.scanDirectory(dir);
+    ASSERT_TRUE(scan.has_value());
+    const auto& slices = scan->begin()->second;
+
+    loader.setDecodeThreadCount(1);
+    auto serial = loader.loadCTSeries(slices);
+    loader.setDecodeThreadCount(8);
+    auto parallel = loader.loadCTSeries(slices);
+    ASSERT_TRUE(serial.has_value());
+    ASSERT_TRUE(parallel.has_value());
+
+    const size_t voxels = serial.value()->GetLargestPossibleRegion().GetNumberOfPixels();
+    ASSERT_EQ(voxels, parallel.value()->GetLargestPossibleRegion().GetNumberOfPixels());
+    EXPECT_TRUE(std::equal(serial.value()->GetBufferPointer(),
+                           serial.value()->GetBufferPointer() + voxels,
+                           parallel.value()->GetBufferPointer()));
+}
+
+TEST_F(DicomLoaderTest, LoadCTSeriesReusesSlicesFromSourceVolume)
+{
+    auto dir = tempDir_ / "ct_reuse";
+    test_utils::writeSyntheticCTSeries(dir, 5);
+
+    DicomLoader loader;
+    auto scan = loader.scanDirectory(dir);
+    ASSERT_TRUE(scan.has_value());
+    const auto& slices = scan->begin()->second;
+
+    auto full = loader.loadCTSeries(slices);
+    ASSERT_TRUE(full.has_value());
+
+    // Overwrite the source slice so reuse is observable versus a re-decode
+    auto source = full.value();
+    CTImageType::IndexType marker = {{3, 3, 2}};
+    source->SetPixel(marker, 4242);
+
+    DecodedSliceSource<CTImageType> reuse;
+    reuse.volume = source.GetPointer();
+    reuse.sourceIndex = {-1, -1, 2, -1, -1};
+    auto result = loader.loadCTSeries(slices, reuse);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    EXPECT_EQ(result.value()->GetPixel(marker), 4242);
+    CTImageType::IndexType decoded = {{3, 3, 3}};
+    EXPECT_EQ(result.value()->GetPixel(decoded), static_cast<short>(3 - 1024));
+    EXPECT_NE(result.value().GetPointer(), source.GetPointer());
+}
+
+TEST_F(DicomLoaderTest, LoadSeriesReportsProgressPerSlice)
+{
+    auto dir = tempDir_ / "progress";
+    test_utils::writeSyntheticCTSeries(dir, 5);
+
+    DicomLoader loader;
+    auto scan = loader.scanDirectory(dir);
+    ASSERT_TRUE(scan.has_value());
+
+    size_t calls = 0;
+    size_t lastCurrent = 0;
+    loader.setProgressCallback([&](size_t current, size_t total, const std::string&) {
+        ++calls;
+        lastCurrent = std::max(lastCurrent, current);
+        EXPECT_EQ(total, 5u);
+    });
+    loader.setDecodeThreadCount(3);
+
+    auto result = loader.loadMRSeries(scan->begin()->second);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    EXPECT_EQ(calls, 5u);
+    EXPECT_EQ(lastCurrent, 5u);
+}
+
 // ============================================================================
 // loadMRSeries — error paths
 // ============================================================================
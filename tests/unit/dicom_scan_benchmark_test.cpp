@@ -0,0 +1,122 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "core/dicom_loader.hpp"
+
+#include "../test_utils/benchmark_fixture.hpp"
+#include "../test_utils/dicom_file_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+namespace dicom_viewer::core {
+namespace {
+
+using test_utils::PerformanceBenchmark;
+
+// =============================================================================
+// Directory scan throughput (header-only vs. full decode)
+// =============================================================================
+
+class DicomScanBenchmarkTest : public PerformanceBenchmark {
+protected:
+    static constexpr int kFileCount = 400;
+
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() / "dicom_scan_benchmark";
+        std::filesystem::remove_all(dir_);
+        test_utils::SyntheticSliceSpec spec;
+        spec.rows = 256;
+        spec.columns = 256;
+        auto written = test_utils::writeSyntheticCTSeries(dir_, kFileCount, spec);
+        ASSERT_EQ(written.size(), static_cast<size_t>(kFileCount));
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    /// Scan the benchmark directory and return throughput in files/second
+    double scanFilesPerSecond(const ScanOptions& options,
+                              std::chrono::milliseconds& elapsed) {
+        DicomLoader loader;
+        auto result = measureTimeWithResult(
+            [&] { return loader.scanDirectory(dir_, options); }, elapsed);
+        EXPECT_TRUE(result.has_value());
+        if (result && !result->empty()) {
+            EXPECT_EQ(result->begin()->second.size(),
+                      static_cast<size_t>(kFileCount));
+        }
+        double seconds = std::max<double>(elapsed.count(), 1.0) / 1000.0;
+        return kFileCount / seconds;
+    }
+
+    std::filesystem::path dir_;
+};
+
+TEST_F(DicomScanBenchmarkTest, HeaderOnlyScanThreadScaling) {
+    for (size_t threads : {1u, 4u, 16u}) {
+        std::chrono::milliseconds elapsed{0};
+        double rate = scanFilesPerSecond(ScanOptions{threads, true}, elapsed);
+        std::cout << "[BENCHMARK] Header-only scan, " << threads
+                  << " thread(s): " << elapsed.count() << "ms, "
+                  << std::fixed << std::setprecision(0) << rate
+                  << " files/s" << std::endl;
+    }
+}
+
+TEST_F(DicomScanBenchmarkTest, HeaderOnlyFasterThanFullDecode) {
+    std::chrono::milliseconds fullElapsed{0};
+    double fullRate = scanFilesPerSecond(ScanOptions{1, false}, fullElapsed);
+
+    std::chrono::milliseconds headerElapsed{0};
+    double headerRate = scanFilesPerSecond(ScanOptions{1, true}, headerElapsed);
+
+    std::cout << "[BENCHMARK] Full-decode scan: " << std::fixed
+              << std::setprecision(0) << fullRate << " files/s, "
+              << "header-only scan: " << headerRate << " files/s"
+              << std::endl;
+
+    // Single-threaded header parsing must never lose to decoding every file
+    EXPECT_LE(headerElapsed.count(), fullElapsed.count() + 50);
+}
+
+TEST_F(DicomScanBenchmarkTest, HeaderOnlyScan400Files) {
+    std::chrono::milliseconds elapsed{0};
+    scanFilesPerSecond(ScanOptions{}, elapsed);
+    assertWithinThreshold(elapsed, 2000, "Header-only scan 400 files");
+}
+
+}  // namespace
+}  // namespace dicom_viewer::core
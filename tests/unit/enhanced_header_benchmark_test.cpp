@@ -0,0 +1,308 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "services/enhanced_dicom/dimension_index_sorter.hpp"
+#include "services/enhanced_dicom/enhanced_dicom_parser.hpp"
+#include "services/enhanced_dicom/functional_group_parser.hpp"
+
+#include "../test_utils/benchmark_fixture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gdcmDataElement.h>
+#include <gdcmDataSet.h>
+#include <gdcmFile.h>
+#include <gdcmFileMetaInformation.h>
+#include <gdcmItem.h>
+#include <gdcmReader.h>
+#include <gdcmSequenceOfItems.h>
+#include <gdcmTag.h>
+#include <gdcmTransferSyntax.h>
+#include <gdcmUIDGenerator.h>
+#include <gdcmVR.h>
+#include <gdcmWriter.h>
+
+namespace dicom_viewer::services {
+namespace {
+
+using test_utils::PerformanceBenchmark;
+
+// =============================================================================
+// Synthetic 20k-frame Enhanced MR (4D flow-like: 40 phases x 500 slices)
+// =============================================================================
+
+constexpr int kPhases = 40;
+constexpr int kSlicesPerPhase = 500;
+constexpr int kFrameCount = kPhases * kSlicesPerPhase;
+constexpr int kRows = 4;
+constexpr int kColumns = 4;
+
+void insertString(gdcm::DataSet& ds, const gdcm::Tag& tag,
+                  const std::string& value) {
+    gdcm::DataElement de(tag);
+    de.SetByteValue(value.c_str(), static_cast<uint32_t>(value.size()));
+    ds.Insert(de);
+}
+
+void insertUS(gdcm::DataSet& ds, const gdcm::Tag& tag, uint16_t value) {
+    gdcm::DataElement de(tag);
+    de.SetByteValue(reinterpret_cast<const char*>(&value), sizeof(uint16_t));
+    de.SetVR(gdcm::VR::US);
+    ds.Insert(de);
+}
+
+void insertSequence(gdcm::DataSet& parent, const gdcm::Tag& seqTag,
+                    const std::vector<gdcm::DataSet>& items) {
+    auto sq = gdcm::SequenceOfItems::New();
+    sq->SetLengthToUndefined();
+    for (const auto& itemDs : items) {
+        gdcm::Item item;
+        item.SetNestedDataSet(itemDs);
+        sq->AddItem(item);
+    }
+    gdcm::DataElement de(seqTag);
+    de.SetValue(*sq);
+    de.SetVLToUndefined();
+    parent.Insert(de);
+}
+
+gdcm::DataSet dimensionItem(uint32_t pointer) {
+    const uint16_t value[2] = {static_cast<uint16_t>(pointer >> 16),
+                               static_cast<uint16_t>(pointer & 0xFFFF)};
+    gdcm::DataSet item;
+    gdcm::DataElement de(gdcm::Tag(0x0020, 0x9165));
+    de.SetByteValue(reinterpret_cast<const char*>(value), 4);
+    item.Insert(de);
+    return item;
+}
+
+bool writeLargeEnhancedMR(const std::filesystem::path& path) {
+    gdcm::Writer writer;
+    writer.SetFileName(path.string().c_str());
+    auto& file = writer.GetFile();
+    auto& ds = file.GetDataSet();
+
+    const std::string sopClass = enhanced_sop_class::EnhancedMRImageStorage;
+    gdcm::UIDGenerator uidGen;
+    insertString(ds, gdcm::Tag(0x0008, 0x0016), sopClass);
+    insertString(ds, gdcm::Tag(0x0008, 0x0018), uidGen.Generate());
+    insertString(ds, gdcm::Tag(0x0008, 0x0060), "MR");
+    insertString(ds, gdcm::Tag(0x0020, 0x000D), uidGen.Generate());
+    insertString(ds, gdcm::Tag(0x0020, 0x000E), uidGen.Generate());
+    insertUS(ds, gdcm::Tag(0x0028, 0x0002), 1);
+    insertString(ds, gdcm::Tag(0x0028, 0x0004), "MONOCHROME2");
+    insertString(ds, gdcm::Tag(0x0028, 0x0008), std::to_string(kFrameCount));
+    insertUS(ds, gdcm::Tag(0x0028, 0x0010), kRows);
+    insertUS(ds, gdcm::Tag(0x0028, 0x0011), kColumns);
+    insertUS(ds, gdcm::Tag(0x0028, 0x0100), 16);
+    insertUS(ds, gdcm::Tag(0x0028, 0x0101), 16);
+    insertUS(ds, gdcm::Tag(0x0028, 0x0102), 15);
+    insertUS(ds, gdcm::Tag(0x0028, 0x0103), 1);
+
+    insertSequence(ds, gdcm::Tag(0x0020, 0x9222),
+                   {dimensionItem(dimension_tag::TemporalPositionIndex),
+                    dimensionItem(dimension_tag::InStackPositionNumber)});
+
+    gdcm::DataSet pixelMeasures;
+    insertString(pixelMeasures, gdcm::Tag(0x0028, 0x0030), "1.5\\1.5");
+    insertString(pixelMeasures, gdcm::Tag(0x0018, 0x0050), "2.0");
+    gdcm::DataSet orientation;
+    insertString(orientation, gdcm::Tag(0x0020, 0x0037), "1\\0\\0\\0\\1\\0");
+    gdcm::DataSet shared;
+    insertSequence(shared, gdcm::Tag(0x0028, 0x9110), {pixelMeasures});
+    insertSequence(shared, gdcm::Tag(0x0020, 0x9116), {orientation});
+    insertSequence(ds, gdcm::Tag(0x5200, 0x9229), {shared});
+
+    // Frames are stored slice-major so the dimension sort has work to do
+    std::vector<gdcm::DataSet> perFrame;
+    perFrame.reserve(kFrameCount);
+    for (int slice = 0; slice < kSlicesPerPhase; ++slice) {
+        for (int phase = 0; phase < kPhases; ++phase) {
+            gdcm::DataSet position;
+            insertString(position, gdcm::Tag(0x0020, 0x0032),
+                         "0\\0\\" + std::to_string(slice * 2));
+            gdcm::DataSet transform;
+            insertString(transform, gdcm::Tag(0x0028, 0x1053), "2");
+            insertString(transform, gdcm::Tag(0x0028, 0x1052), "-4096");
+            gdcm::DataSet content;
+            const uint32_t indices[2] = {static_cast<uint32_t>(phase + 1),
+                                         static_cast<uint32_t>(slice + 1)};
+            gdcm::DataElement dimValues(gdcm::Tag(0x0020, 0x9157));
+            dimValues.SetByteValue(reinterpret_cast<const char*>(indices),
+                                   sizeof(indices));
+            content.Insert(dimValues);
+            insertString(content, gdcm::Tag(0x0020, 0x9128),
+                         std::to_string(phase + 1));
+
+            gdcm::DataSet frame;
+            insertString(frame, gdcm::Tag(0x0018, 0x1060),
+                         std::to_string(phase * 25));
+            insertSequence(frame, gdcm::Tag(0x0020, 0x9113), {position});
+            insertSequence(frame, gdcm::Tag(0x0028, 0x9145), {transform});
+            insertSequence(frame, gdcm::Tag(0x0020, 0x9111), {content});
+            perFrame.push_back(std::move(frame));
+        }
+    }
+    insertSequence(ds, gdcm::Tag(0x5200, 0x9230), perFrame);
+
+    std::vector<short> pixels(static_cast<size_t>(kRows) * kColumns * kFrameCount);
+    gdcm::DataElement pixelData(gdcm::Tag(0x7FE0, 0x0010));
+    pixelData.SetByteValue(reinterpret_cast<const char*>(pixels.data()),
+                           static_cast<uint32_t>(pixels.size() * sizeof(short)));
+    pixelData.SetVR(gdcm::VR::OW);
+    ds.Insert(pixelData);
+
+    auto& fmi = file.GetHeader();
+    fmi.Clear();
+    fmi.SetDataSetTransferSyntax(gdcm::TransferSyntax::ExplicitVRLittleEndian);
+    return writer.Write();
+}
+
+/// Previous approach: full GDCM DOM, then walk the per-frame sequence
+size_t parseWithDom(const std::string& path) {
+    gdcm::Reader reader;
+    reader.SetFileName(path.c_str());
+    if (!reader.Read()) {
+        return 0;
+    }
+    const auto& ds = reader.GetFile().GetDataSet();
+    const gdcm::Tag perFrameTag(0x5200, 0x9230);
+    if (!ds.FindDataElement(perFrameTag)) {
+        return 0;
+    }
+    auto sq = ds.GetDataElement(perFrameTag).GetValueAsSQ();
+    size_t visited = 0;
+    for (size_t i = 1; sq && i <= sq->GetNumberOfItems(); ++i) {
+        const auto& item = sq->GetItem(i).GetNestedDataSet();
+        visited += item.FindDataElement(gdcm::Tag(0x0020, 0x9113)) ? 1 : 0;
+    }
+    return visited;
+}
+
+class EnhancedHeaderBenchmarkTest : public PerformanceBenchmark {
+protected:
+    static void SetUpTestSuite() {
+        path_ = std::filesystem::temp_directory_path()
+            / "enhanced_header_benchmark_20k.dcm";
+        written_ = writeLargeEnhancedMR(path_);
+    }
+
+    static void TearDownTestSuite() {
+        std::filesystem::remove(path_);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(written_) << "Failed to write synthetic 20k-frame file";
+    }
+
+    static inline std::filesystem::path path_;
+    static inline bool written_ = false;
+};
+
+TEST_F(EnhancedHeaderBenchmarkTest, StreamingScan20kFrames) {
+    FunctionalGroupParser parser;
+    std::chrono::milliseconds elapsed{0};
+    auto table = measureTimeWithResult(
+        [&] { return parser.scanFrameTable(path_.string(), kFrameCount); },
+        elapsed);
+
+    ASSERT_TRUE(table.has_value()) << table.error().toString();
+    EXPECT_EQ(table->perFrameItemCount, kFrameCount);
+    EXPECT_EQ(table->dimensions.dimensions.size(), 2u);
+    EXPECT_DOUBLE_EQ(table->rescaleIntercepts.back(), -4096.0);
+    assertWithinThreshold(elapsed, 2000, "Streaming header scan 20k frames");
+}
+
+TEST_F(EnhancedHeaderBenchmarkTest, StreamingScanFasterThanDom) {
+    std::chrono::milliseconds domElapsed{0};
+    size_t domFrames = measureTimeWithResult(
+        [&] { return parseWithDom(path_.string()); }, domElapsed);
+
+    FunctionalGroupParser parser;
+    std::chrono::milliseconds streamElapsed{0};
+    auto table = measureTimeWithResult(
+        [&] { return parser.scanFrameTable(path_.string(), kFrameCount); },
+        streamElapsed);
+
+    ASSERT_TRUE(table.has_value());
+    EXPECT_EQ(domFrames, static_cast<size_t>(kFrameCount));
+    std::cout << "[BENCHMARK] 20k-frame header: GDCM DOM "
+              << domElapsed.count() << "ms, streaming scan "
+              << streamElapsed.count() << "ms" << std::endl;
+
+    // The streaming walker must never lose to materializing the DOM
+    EXPECT_LE(streamElapsed.count(), domElapsed.count() + 50);
+}
+
+TEST_F(EnhancedHeaderBenchmarkTest, ParseFile20kFrames) {
+    EnhancedDicomParser parser;
+    std::chrono::milliseconds elapsed{0};
+    auto info = measureTimeWithResult(
+        [&] { return parser.parseFile(path_.string()); }, elapsed);
+
+    ASSERT_TRUE(info.has_value()) << info.error().toString();
+    ASSERT_EQ(info->frames.size(), static_cast<size_t>(kFrameCount));
+    EXPECT_DOUBLE_EQ(info->pixelSpacingX, 1.5);
+    assertWithinThreshold(elapsed, 3000, "Enhanced parseFile 20k frames");
+}
+
+TEST_F(EnhancedHeaderBenchmarkTest, DimensionSort20kFrames) {
+    // Keys under the dimension pointers themselves, stored in reverse
+    std::vector<EnhancedFrameInfo> frames(kFrameCount);
+    for (int i = 0; i < kFrameCount; ++i) {
+        const int reversed = kFrameCount - 1 - i;
+        frames[i].frameIndex = i;
+        frames[i].dimensionIndices[dimension_tag::TemporalPositionIndex] =
+            reversed / kSlicesPerPhase;
+        frames[i].dimensionIndices[dimension_tag::InStackPositionNumber] =
+            reversed % kSlicesPerPhase;
+    }
+    DimensionOrganization org;
+    org.dimensions.push_back({dimension_tag::TemporalPositionIndex, 0, "", ""});
+    org.dimensions.push_back({dimension_tag::InStackPositionNumber, 0, "", ""});
+
+    DimensionIndexSorter sorter;
+    std::chrono::milliseconds elapsed{0};
+    auto sorted = measureTimeWithResult(
+        [&] { return sorter.sortFrames(frames, org); }, elapsed);
+
+    ASSERT_EQ(sorted.size(), frames.size());
+    EXPECT_EQ(sorted.front().frameIndex, kFrameCount - 1);
+    EXPECT_EQ(sorted.back().frameIndex, 0);
+    assertWithinThreshold(elapsed, 500, "Dimension sort 20k frames");
+}
+
+}  // namespace
+}  // namespace dicom_viewer::services
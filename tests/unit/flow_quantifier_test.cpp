@@ -479,6 +479,98 @@ TEST(FlowQuantifierTest, ComputeTVC_ZeroForwardFlow) {
     EXPECT_DOUBLE_EQ(result->regurgitantFraction, 0.0);
 }
 
+// =============================================================================
+// Multi-plane time-velocity curve tests
+// =============================================================================
+
+TEST(FlowQuantifierTest, ComputeTVCs_EmptyPlanes) {
+    FlowQuantifier q;
+    std::vector<VelocityPhase> phases = {createUniformZFlow(10, 10.0f, 0)};
+    auto result = q.computeTimeVelocityCurves({}, phases, 40.0);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, FlowError::Code::InvalidInput);
+}
+
+TEST(FlowQuantifierTest, ComputeTVCs_NullPhase) {
+    FlowQuantifier q;
+    std::vector<VelocityPhase> phases = {createUniformZFlow(10, 10.0f, 0),
+                                         VelocityPhase{}};
+    auto result = q.computeTimeVelocityCurves({MeasurementPlane{}}, phases, 40.0);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, FlowError::Code::InvalidInput);
+}
+
+TEST(FlowQuantifierTest, ComputeTVCs_MatchesPerPlaneCurves) {
+    // Pulsatile pipe flow: forward systole, backward diastole
+    std::vector<VelocityPhase> phases;
+    const float vMax[] = {20.0f, 60.0f, 40.0f, -10.0f, -5.0f, 5.0f};
+    for (int p = 0; p < 6; ++p) {
+        phases.push_back(createPoiseuillePipeFlow(24, vMax[p], 8.0, p));
+    }
+
+    std::vector<MeasurementPlane> planes(3);
+    planes[0].center = {11.5, 11.5, 6};
+    planes[0].normal = {0, 0, 1};
+    planes[0].radius = 9.0;
+    planes[1].center = {11.5, 11.5, 12};
+    planes[1].normal = {0, 0.5, 2};  // Oblique, not unit length
+    planes[1].radius = 6.0;
+    planes[1].sampleSpacing = 0.5;
+    planes[2].center = {11.5, 11.5, 18};
+    planes[2].normal = {1, 0, 0};
+    planes[2].radius = 4.0;
+
+    FlowQuantifier q;
+    auto batch = q.computeTimeVelocityCurves(planes, phases, 40.0, 4);
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_EQ(batch->size(), planes.size());
+
+    for (size_t i = 0; i < planes.size(); ++i) {
+        FlowQuantifier single;
+        single.setMeasurementPlane(planes[i]);
+        auto expected = single.computeTimeVelocityCurve(phases, 40.0);
+        ASSERT_TRUE(expected.has_value());
+
+        const auto& curve = (*batch)[i];
+        EXPECT_EQ(curve.timePoints, expected->timePoints);
+        EXPECT_EQ(curve.flowRates, expected->flowRates);
+        EXPECT_EQ(curve.meanVelocities, expected->meanVelocities);
+        EXPECT_EQ(curve.maxVelocities, expected->maxVelocities);
+        EXPECT_EQ(curve.stdVelocities, expected->stdVelocities);
+        EXPECT_DOUBLE_EQ(curve.strokeVolume, expected->strokeVolume);
+        EXPECT_DOUBLE_EQ(curve.regurgitantVolume, expected->regurgitantVolume);
+        EXPECT_DOUBLE_EQ(curve.meanRoiArea, expected->meanRoiArea);
+    }
+
+    // Axial planes see the pulsatile flow; the in-plane (X) normal sees none
+    EXPECT_GT((*batch)[0].strokeVolume, 0.0);
+    EXPECT_GT((*batch)[0].regurgitantVolume, 0.0);
+    EXPECT_NEAR((*batch)[2].strokeVolume, 0.0, 1e-9);
+}
+
+TEST(FlowQuantifierTest, ComputeTVCs_PhasesOnDifferentGrids) {
+    // Second phase uses a larger grid; its samples must be resolved separately
+    std::vector<VelocityPhase> phases = {createUniformZFlow(10, 10.0f, 0),
+                                         createUniformZFlow(20, 10.0f, 1)};
+    MeasurementPlane plane;
+    plane.center = {8, 8, 5};
+    plane.normal = {0, 0, 1};
+    plane.radius = 4.0;
+
+    FlowQuantifier q;
+    auto batch = q.computeTimeVelocityCurves({plane}, phases, 40.0);
+    ASSERT_TRUE(batch.has_value());
+
+    q.setMeasurementPlane(plane);
+    auto first = q.measureFlow(phases[0]);
+    auto second = q.measureFlow(phases[1]);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_LT(first->sampleCount, second->sampleCount);
+    EXPECT_DOUBLE_EQ((*batch)[0].flowRates[0], first->flowRate);
+    EXPECT_DOUBLE_EQ((*batch)[0].flowRates[1], second->flowRate);
+}
+
 // =============================================================================
 // Pressure gradient tests
 // =============================================================================
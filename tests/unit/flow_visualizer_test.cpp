@@ -39,6 +39,7 @@
 #include <vtkPolyData.h>
 
 #include "services/flow/flow_visualizer.hpp"
+#include "services/flow/temporal_navigator.hpp"
 
 using namespace dicom_viewer::services;
 
@@ -147,6 +148,9 @@ TEST(StreamlineParamsTest, Defaults) {
     EXPECT_DOUBLE_EQ(params.terminalSpeed, 0.1);
     EXPECT_DOUBLE_EQ(params.tubeRadius, 0.5);
     EXPECT_EQ(params.tubeSides, 8);
+    EXPECT_EQ(params.engine, StreamlineEngine::Native);
+    EXPECT_TRUE(params.adaptiveStep);
+    EXPECT_EQ(params.threadCount, 0u);
 }
 
 TEST(GlyphParamsTest, Defaults) {
@@ -376,6 +380,37 @@ TEST(FlowVisualizerTest, GenerateStreamlines_ParabolicFlow) {
     EXPECT_GE(result.value()->GetNumberOfPoints(), 0);
 }
 
+TEST(FlowVisualizerTest, GenerateStreamlines_VTKEngine) {
+    FlowVisualizer viz;
+    auto phase = createUniformFlowPhase(10, 10, 10, 5.0f, 0.0f, 0.0f);
+    viz.setVelocityField(phase);
+
+    StreamlineParams params;
+    params.maxSeedPoints = 50;
+    params.maxSteps = 100;
+    params.engine = StreamlineEngine::VTK;
+
+    auto result = viz.generateStreamlines(params);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_GT(result.value()->GetNumberOfPoints(), 0);
+}
+
+TEST(FlowVisualizerTest, GenerateStreamlines_NativeFixedStepMultithreaded) {
+    FlowVisualizer viz;
+    auto phase = createParabolicFlowPhase(12, 50.0f);
+    viz.setVelocityField(phase);
+
+    StreamlineParams params;
+    params.maxSeedPoints = 40;
+    params.maxSteps = 100;
+    params.adaptiveStep = false;
+    params.threadCount = 4;
+
+    auto result = viz.generateStreamlines(params);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_GT(result.value()->GetNumberOfPoints(), 0);
+}
+
 // =============================================================================
 // Glyph generation tests
 // =============================================================================
@@ -450,6 +485,52 @@ TEST(FlowVisualizerTest, GeneratePathlines_MultiPhase) {
     EXPECT_NE(polyData->GetPointData()->GetArray("VelocityMagnitude"), nullptr);
 }
 
+TEST(FlowVisualizerTest, GeneratePathlines_AdvectAcrossAllPhases) {
+    FlowVisualizer viz;
+    auto phase0 = createUniformFlowPhase(16, 16, 16, 1.0f, 0.0f, 0.0f, 0);
+    viz.setVelocityField(phase0);
+
+    // 1 cm/s for 160 ms moves particles 1.6 mm, so most stay inside
+    std::vector<VelocityPhase> phases;
+    for (int i = 0; i < 5; ++i) {
+        phases.push_back(
+            createUniformFlowPhase(16, 16, 16, 1.0f, 0.0f, 0.0f, i));
+    }
+
+    PathlineParams params;
+    params.maxSeedPoints = 30;
+
+    auto result = viz.generatePathlines(phases, params);
+    ASSERT_TRUE(result.has_value());
+    auto* times = result.value()->GetPointData()->GetArray("TriggerTime");
+    ASSERT_NE(times, nullptr);
+    EXPECT_GT(result.value()->GetNumberOfCells(), 0);
+    EXPECT_DOUBLE_EQ(times->GetRange()[1], 160.0);
+}
+
+TEST(FlowVisualizerTest, GeneratePathlines_FromPhaseCache) {
+    FlowVisualizer viz;
+    auto phase0 = createUniformFlowPhase(16, 16, 16, 1.0f, 0.0f, 0.0f, 0);
+    viz.setVelocityField(phase0);
+
+    PhaseCache cache(2);
+    cache.setPhaseLoader([](int index) -> std::expected<VelocityPhase, FlowError> {
+        return createUniformFlowPhase(16, 16, 16, 1.0f, 0.0f, 0.0f, index);
+    });
+
+    PathlineParams params;
+    params.maxSeedPoints = 30;
+
+    auto result = viz.generatePathlines(cache, 5, params);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_GT(result.value()->GetNumberOfCells(), 0);
+    EXPECT_NE(result.value()->GetPointData()->GetArray("TriggerTime"), nullptr);
+
+    auto empty = viz.generatePathlines(cache, 0, params);
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().code, FlowError::Code::InvalidInput);
+}
+
 TEST(FlowVisualizerTest, GeneratePathlines_NullPhaseInSequence) {
     FlowVisualizer viz;
     auto phase0 = createUniformFlowPhase(8, 8, 8, 1.0f, 0.0f, 0.0f, 0);
@@ -42,6 +42,9 @@
 #include <gdcmDataSet.h>
 #include <gdcmFile.h>
 #include <gdcmFileMetaInformation.h>
+#include <gdcmImageChangeTransferSyntax.h>
+#include <gdcmImageReader.h>
+#include <gdcmImageWriter.h>
 #include <gdcmItem.h>
 #include <gdcmMediaStorage.h>
 #include <gdcmSequenceOfItems.h>
@@ -461,6 +464,80 @@ protected:
         return path;
     }
 
+    /// Re-encode an existing file as RLE Lossless (one fragment per frame)
+    /// Write a 12-bit signed file (16 bits allocated) whose stored words
+    /// carry garbage in the 4 unused high bits, as overlay data would.
+    /// Pixel p of frame f is ((f * pixelsPerFrame + p) * 257) % 4096 - 2048.
+    std::string writeSyntheticDicom12s(const std::string& filename,
+                                       int rows, int cols, int numFrames)
+    {
+        auto path = (tempDir_ / filename).string();
+
+        gdcm::Writer writer;
+        writer.SetFileName(path.c_str());
+        auto& file = writer.GetFile();
+        auto& ds = file.GetDataSet();
+
+        insertUSElement(ds, tags::SamplesPerPixel, 1);
+        insertStringElement(ds, tags::NumberOfFrames,
+                            std::to_string(numFrames));
+        insertUSElement(ds, tags::Rows, static_cast<uint16_t>(rows));
+        insertUSElement(ds, tags::Columns, static_cast<uint16_t>(cols));
+        insertUSElement(ds, tags::BitsAllocated, 16);
+        insertUSElement(ds, tags::BitsStored, 12);
+        insertUSElement(ds, tags::HighBit, 11);
+        insertUSElement(ds, tags::PixelRepresentation, 1);  // signed
+        insertStringElement(ds, tags::PhotometricInterpretation, "MONOCHROME2");
+
+        std::string sopClass = "1.2.840.10008.5.1.4.1.1.2.1";
+        insertStringElement(ds, tags::SOPClassUID, sopClass);
+        gdcm::UIDGenerator uidGen;
+        insertStringElement(ds, tags::SOPInstanceUID, uidGen.Generate());
+
+        size_t totalPixels = static_cast<size_t>(rows) * cols * numFrames;
+        std::vector<uint16_t> words(totalPixels);
+        for (size_t i = 0; i < totalPixels; ++i) {
+            const int value = static_cast<int>((i * 257) % 4096) - 2048;
+            words[i] = static_cast<uint16_t>(0xB000u | (value & 0x0FFF));
+        }
+
+        gdcm::DataElement pixelData(tags::PixelData);
+        pixelData.SetByteValue(
+            reinterpret_cast<const char*>(words.data()),
+            static_cast<uint32_t>(totalPixels * sizeof(uint16_t)));
+        pixelData.SetVR(gdcm::VR::OW);
+        ds.Insert(pixelData);
+
+        setupFileMetaInfo(file, sopClass);
+
+        writer.Write();
+        return path;
+    }
+
+    std::string writeRleCopy(const std::string& sourcePath,
+                             const std::string& filename)
+    {
+        gdcm::ImageReader reader;
+        reader.SetFileName(sourcePath.c_str());
+        if (!reader.Read()) {
+            return {};
+        }
+
+        gdcm::ImageChangeTransferSyntax change;
+        change.SetTransferSyntax(gdcm::TransferSyntax::RLELossless);
+        change.SetInput(reader.GetImage());
+        if (!change.Change()) {
+            return {};
+        }
+
+        auto path = (tempDir_ / filename).string();
+        gdcm::ImageWriter writer;
+        writer.SetFileName(path.c_str());
+        writer.SetFile(reader.GetFile());
+        writer.SetImage(change.GetOutput());
+        return writer.Write() ? path : std::string{};
+    }
+
     FrameExtractor extractor_;
     std::filesystem::path tempDir_;
 };
@@ -1397,3 +1474,183 @@ TEST_F(FrameExtractorTest, ExtractFrameDataIndependence) {
         EXPECT_EQ(pixels[0], expected) << "Frame " << f;
     }
 }
+
+// =============================================================================
+// extractFrame: frame-level random access
+// =============================================================================
+
+TEST_F(FrameExtractorTest, ExtractFrameFromEncapsulatedRle) {
+    const int rows = 8, cols = 8, numFrames = 5;
+    auto native = writeSyntheticDicom16s("rle_source.dcm",
+                                         rows, cols, numFrames, -300, 125);
+    auto rle = writeRleCopy(native, "rle.dcm");
+    ASSERT_FALSE(rle.empty()) << "RLE re-encoding failed";
+
+    EnhancedSeriesInfo info = makeSeriesInfo(rows, cols, numFrames, 16, 1);
+
+    // Access out of order to exercise fragment seeks
+    for (int f : {3, 0, 4, 1, 2}) {
+        auto result = extractor_.extractFrame(rle, f, info);
+        ASSERT_TRUE(result.has_value())
+            << "Frame " << f << ": " << result.error().toString();
+        ASSERT_EQ(result->size(), static_cast<size_t>(rows) * cols * sizeof(short));
+
+        const auto* pixels = reinterpret_cast<const short*>(result->data());
+        const short expected = static_cast<short>(-300 + f * 125);
+        for (int i = 0; i < rows * cols; ++i) {
+            ASSERT_EQ(pixels[i], expected) << "Frame " << f << " pixel " << i;
+        }
+    }
+}
+
+TEST_F(FrameExtractorTest, ExtractFrame12BitSignedMatchesFullDecode) {
+    const int rows = 4, cols = 4, numFrames = 3;
+    auto path = writeSyntheticDicom12s("signed12.dcm", rows, cols, numFrames);
+
+    EnhancedSeriesInfo info = makeSeriesInfo(rows, cols, numFrames, 16, 1);
+    info.bitsStored = 12;
+    info.highBit = 11;
+
+    gdcm::ImageReader reader;
+    reader.SetFileName(path.c_str());
+    ASSERT_TRUE(reader.Read());
+    const auto& image = reader.GetImage();
+    std::vector<char> decoded(image.GetBufferLength());
+    ASSERT_TRUE(image.GetBuffer(decoded.data()));
+
+    const size_t pixelsPerFrame = static_cast<size_t>(rows) * cols;
+    const size_t frameBytes = pixelsPerFrame * sizeof(short);
+    for (int f = 0; f < numFrames; ++f) {
+        auto result = extractor_.extractFrame(path, f, info);
+        ASSERT_TRUE(result.has_value()) << result.error().toString();
+        ASSERT_EQ(result->size(), frameBytes);
+        EXPECT_EQ(std::memcmp(result->data(), decoded.data() + f * frameBytes,
+                              frameBytes), 0)
+            << "Frame " << f << " differs from full decode";
+
+        const auto* pixels = reinterpret_cast<const short*>(result->data());
+        for (size_t p = 0; p < pixelsPerFrame; ++p) {
+            const int expected =
+                static_cast<int>(((f * pixelsPerFrame + p) * 257) % 4096) - 2048;
+            ASSERT_EQ(pixels[p], expected) << "Frame " << f << " pixel " << p;
+        }
+    }
+}
+
+TEST_F(FrameExtractorTest, ExtractFrameMatchesAcrossRepeatedRequests) {
+    const int rows = 4, cols = 4, numFrames = 6;
+    auto path = writeSyntheticDicom16u("scrub.dcm", rows, cols, numFrames, 10, 7);
+    EnhancedSeriesInfo info = makeSeriesInfo(rows, cols, numFrames, 16, 0);
+
+    // Scrub back and forth; every request after the first reuses the index
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int f = 0; f < numFrames; ++f) {
+            int frame = (pass % 2 == 0) ? f : numFrames - 1 - f;
+            auto result = extractor_.extractFrame(path, frame, info);
+            ASSERT_TRUE(result.has_value()) << result.error().toString();
+            const auto* pixels = reinterpret_cast<const uint16_t*>(result->data());
+            EXPECT_EQ(pixels[0], static_cast<uint16_t>(10 + frame * 7));
+        }
+    }
+}
+
+TEST_F(FrameExtractorTest, ExtractFrameReindexesRewrittenFile) {
+    const int rows = 4, cols = 4;
+    auto path = writeSyntheticDicom16s("rewritten.dcm", rows, cols, 3, 100, 10);
+    EnhancedSeriesInfo info = makeSeriesInfo(rows, cols, 3, 16, 1);
+    ASSERT_TRUE(extractor_.extractFrame(path, 2, info).has_value());
+
+    // Same path, different frame count and values: the cached index is stale
+    writeSyntheticDicom16s("rewritten.dcm", rows, cols, 5, 1000, 1);
+    info = makeSeriesInfo(rows, cols, 5, 16, 1);
+
+    auto result = extractor_.extractFrame(path, 4, info);
+    ASSERT_TRUE(result.has_value()) << result.error().toString();
+    const auto* pixels = reinterpret_cast<const short*>(result->data());
+    EXPECT_EQ(pixels[0], 1004);
+}
+
+// =============================================================================
+// assembleVolumesFromFrameGroups: single-pass multi-phase assembly
+// =============================================================================
+
+TEST_F(FrameExtractorTest, AssembleFrameGroupsMatchesPerGroupAssembly) {
+    const int rows = 3, cols = 3, numFrames = 6;
+    auto path = writeSyntheticVolumeFile("phases.dcm", rows, cols, numFrames,
+                                         1.0, 1.0, 1.0, 100, 10);
+
+    EnhancedSeriesInfo info = makeSeriesInfo(rows, cols, numFrames);
+    info.frames[2].rescaleSlope = 2.0;
+    info.frames[5].rescaleIntercept = -1000.0;
+
+    // Two "phases" interleaved in the file, listed out of spatial order
+    const std::vector<std::vector<int>> groups = {{4, 0, 2}, {1, 5, 3}};
+    auto result = extractor_.assembleVolumesFromFrameGroups(path, info, groups);
+    ASSERT_TRUE(result.has_value()) << result.error().toString();
+    ASSERT_EQ(result->size(), 2u);
+
+    for (size_t g = 0; g < groups.size(); ++g) {
+        auto expected = extractor_.assembleVolumeFromFrames(path, info, groups[g]);
+        ASSERT_TRUE(expected.has_value());
+
+        const auto& volume = (*result)[g];
+        EXPECT_EQ(volume->GetLargestPossibleRegion(),
+                  (*expected)->GetLargestPossibleRegion());
+        EXPECT_EQ(volume->GetOrigin(), (*expected)->GetOrigin());
+        EXPECT_EQ(volume->GetSpacing(), (*expected)->GetSpacing());
+
+        const size_t pixels = static_cast<size_t>(rows) * cols * groups[g].size();
+        const short* actual = volume->GetBufferPointer();
+        const short* reference = (*expected)->GetBufferPointer();
+        for (size_t i = 0; i < pixels; ++i) {
+            ASSERT_EQ(actual[i], reference[i]) << "Group " << g << " pixel " << i;
+        }
+    }
+
+    // Frame 2 (raw 120, slope 2) lands in the middle slice of phase 0
+    itk::Image<short, 3>::IndexType mid = {{0, 0, 1}};
+    EXPECT_EQ((*result)[0]->GetPixel(mid), 240);
+    // Frame 5 (raw 150, intercept -1000) is the last slice of phase 1
+    itk::Image<short, 3>::IndexType last = {{0, 0, 2}};
+    EXPECT_EQ((*result)[1]->GetPixel(last), -850);
+}
+
+TEST_F(FrameExtractorTest, AssembleFrameGroupsShareOneBuffer) {
+    const int rows = 2, cols = 2, numFrames = 4;
+    auto path = writeSyntheticVolumeFile("shared.dcm", rows, cols, numFrames,
+                                         1.0, 1.0, 1.0, 100, 10);
+    EnhancedSeriesInfo info = makeSeriesInfo(rows, cols, numFrames);
+
+    auto result = extractor_.assembleVolumesFromFrameGroups(
+        path, info, {{0, 1}, {2, 3}});
+    ASSERT_TRUE(result.has_value()) << result.error().toString();
+
+    // Phase volumes are adjacent views of one allocation
+    const short* first = (*result)[0]->GetBufferPointer();
+    const short* second = (*result)[1]->GetBufferPointer();
+    EXPECT_EQ(second, first + 2 * rows * cols);
+
+    // The buffer outlives the volume that was released first
+    auto survivor = (*result)[1];
+    result->clear();
+    itk::Image<short, 3>::IndexType idx = {{1, 1, 1}};
+    EXPECT_EQ(survivor->GetPixel(idx), 130);
+}
+
+TEST_F(FrameExtractorTest, AssembleFrameGroupsRejectsInvalidGroups) {
+    EnhancedSeriesInfo info = makeSeriesInfo(2, 2, 4);
+
+    auto empty = extractor_.assembleVolumesFromFrameGroups("/some/file.dcm", info, {});
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().code, EnhancedDicomError::Code::InvalidInput);
+
+    auto emptyGroup = extractor_.assembleVolumesFromFrameGroups(
+        "/some/file.dcm", info, {{0, 1}, {}});
+    ASSERT_FALSE(emptyGroup.has_value());
+    EXPECT_EQ(emptyGroup.error().code, EnhancedDicomError::Code::InvalidInput);
+
+    auto outOfRange = extractor_.assembleVolumesFromFrameGroups(
+        "/some/file.dcm", info, {{0, 4}});
+    ASSERT_FALSE(outOfRange.has_value());
+    EXPECT_EQ(outOfRange.error().code, EnhancedDicomError::Code::InvalidInput);
+}
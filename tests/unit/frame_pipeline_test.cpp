@@ -0,0 +1,293 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include <gtest/gtest.h>
+
+#include "services/render/frame_pipeline.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dicom_viewer::services;
+
+namespace {
+
+struct SentFrame {
+    std::string sessionId;
+    uint32_t seq = 0;
+    std::vector<uint8_t> data;
+};
+
+/// Collects sent frames; optionally holds the sender until released
+class FrameSink {
+public:
+    FrameSendCallback callback()
+    {
+        return [this](const std::string& id, const std::vector<uint8_t>& data,
+                      uint32_t, uint32_t, uint32_t seq) {
+            std::unique_lock lock(mutex_);
+            frames_.push_back({id, seq, data});
+            ++inCallback_;
+            cv_.notify_all();
+            cv_.wait(lock, [this]() { return !blocked_; });
+        };
+    }
+
+    void block()
+    {
+        std::lock_guard lock(mutex_);
+        blocked_ = true;
+    }
+
+    void release()
+    {
+        std::lock_guard lock(mutex_);
+        blocked_ = false;
+        cv_.notify_all();
+    }
+
+    bool waitForCallbacks(size_t count)
+    {
+        std::unique_lock lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(5),
+                            [&]() { return inCallback_ >= count; });
+    }
+
+    std::vector<SentFrame> frames()
+    {
+        std::lock_guard lock(mutex_);
+        return frames_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<SentFrame> frames_;
+    size_t inCallback_ = 0;
+    bool blocked_ = false;
+};
+
+std::vector<uint8_t> createFrame(uint32_t width, uint32_t height, uint8_t shade)
+{
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < rgba.size(); i += 4) {
+        rgba[i + 0] = shade;
+        rgba[i + 1] = static_cast<uint8_t>(i / 4 % 251);
+        rgba[i + 2] = 64;
+        rgba[i + 3] = 255;
+    }
+    return rgba;
+}
+
+FramePipelineConfig testConfig()
+{
+    FramePipelineConfig cfg;
+    cfg.encodeThreads = 2;
+    cfg.sendThreads = 1;
+    return cfg;
+}
+
+}  // namespace
+
+// =============================================================================
+// Delivery
+// =============================================================================
+
+TEST(FramePipelineTest, DeliversEncodedFramesInOrder) {
+    auto cfg = testConfig();
+    cfg.maxQueuedFrames = 8;  // Deep enough that nothing is dropped
+    FramePipeline pipeline(cfg);
+    FrameSink sink;
+    pipeline.setSendCallback(sink.callback());
+
+    for (uint8_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(pipeline.submit("s1", createFrame(32, 32, i * 40), 32, 32));
+    }
+    pipeline.waitIdle();
+
+    auto frames = sink.frames();
+    ASSERT_EQ(frames.size(), 5u);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        EXPECT_EQ(frames[i].sessionId, "s1");
+        EXPECT_EQ(frames[i].seq, static_cast<uint32_t>(i + 1));
+        ASSERT_GE(frames[i].data.size(), 2u);
+        EXPECT_EQ(frames[i].data[0], 0xFF);  // JPEG SOI marker
+        EXPECT_EQ(frames[i].data[1], 0xD8);
+    }
+
+    auto stats = pipeline.stats();
+    EXPECT_EQ(stats.submitted, 5u);
+    EXPECT_EQ(stats.encoded, 5u);
+    EXPECT_EQ(stats.sent, 5u);
+    EXPECT_EQ(stats.droppedBeforeEncode + stats.droppedBeforeSend, 0u);
+}
+
+TEST(FramePipelineTest, SessionsKeepIndependentSequences) {
+    FramePipeline pipeline(testConfig());
+    FrameSink sink;
+    pipeline.setSendCallback(sink.callback());
+
+    ASSERT_TRUE(pipeline.submit("a", createFrame(16, 16, 10), 16, 16));
+    pipeline.waitIdle();
+    ASSERT_TRUE(pipeline.submit("b", createFrame(16, 16, 20), 16, 16));
+    pipeline.waitIdle();
+    ASSERT_TRUE(pipeline.submit("a", createFrame(16, 16, 30), 16, 16));
+    pipeline.waitIdle();
+
+    auto frames = sink.frames();
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0].seq, 1u);
+    EXPECT_EQ(frames[1].sessionId, "b");
+    EXPECT_EQ(frames[1].seq, 1u);
+    EXPECT_EQ(frames[2].seq, 2u);
+}
+
+TEST(FramePipelineTest, RejectsMalformedFrames) {
+    FramePipeline pipeline(testConfig());
+    EXPECT_FALSE(pipeline.submit("s1", createFrame(8, 8, 0), 0, 8));
+    EXPECT_FALSE(pipeline.submit("s1", std::vector<uint8_t>(10), 8, 8));
+    EXPECT_EQ(pipeline.stats().submitted, 0u);
+}
+
+// =============================================================================
+// Drop policy
+// =============================================================================
+
+TEST(FramePipelineTest, LatestFrameWinsUnderBackpressure) {
+    FramePipeline pipeline(testConfig());
+    FrameSink sink;
+    sink.block();
+    pipeline.setSendCallback(sink.callback());
+
+    // Frame 1 occupies the sender; the rest pile up behind it
+    ASSERT_TRUE(pipeline.submit("s1", createFrame(32, 32, 0), 32, 32));
+    ASSERT_TRUE(sink.waitForCallbacks(1));
+    for (uint8_t i = 1; i < 10; ++i) {
+        ASSERT_TRUE(pipeline.submit("s1", createFrame(32, 32, i * 20), 32, 32));
+    }
+
+    sink.release();
+    pipeline.waitIdle();
+
+    auto frames = sink.frames();
+    ASSERT_GE(frames.size(), 2u);
+    EXPECT_LT(frames.size(), 10u);
+    EXPECT_EQ(frames.front().seq, 1u);
+    EXPECT_EQ(frames.back().seq, 10u);  // The newest frame always arrives
+    for (size_t i = 1; i < frames.size(); ++i) {
+        EXPECT_GT(frames[i].seq, frames[i - 1].seq);
+    }
+
+    auto stats = pipeline.stats();
+    EXPECT_EQ(stats.sent, frames.size());
+    EXPECT_EQ(stats.submitted,
+              stats.sent + stats.droppedBeforeEncode + stats.droppedBeforeSend
+                  + stats.encodeFailures);
+}
+
+TEST(FramePipelineTest, RemoveSessionDiscardsQueuedFrames) {
+    FramePipeline pipeline(testConfig());
+    FrameSink sink;
+    sink.block();
+    pipeline.setSendCallback(sink.callback());
+
+    ASSERT_TRUE(pipeline.submit("s1", createFrame(32, 32, 0), 32, 32));
+    ASSERT_TRUE(sink.waitForCallbacks(1));
+    ASSERT_TRUE(pipeline.submit("s1", createFrame(32, 32, 50), 32, 32));
+    ASSERT_TRUE(pipeline.submit("s1", createFrame(32, 32, 100), 32, 32));
+
+    pipeline.removeSession("s1");
+    sink.release();
+    pipeline.waitIdle();
+
+    // Only the frame already being sent was delivered
+    EXPECT_EQ(sink.frames().size(), 1u);
+
+    // A session recreated under the same ID starts a fresh sequence
+    ASSERT_TRUE(pipeline.submit("s1", createFrame(32, 32, 0), 32, 32));
+    pipeline.waitIdle();
+    auto frames = sink.frames();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames.back().seq, 1u);
+}
+
+// =============================================================================
+// Lifecycle and statistics
+// =============================================================================
+
+TEST(FramePipelineTest, SubmitAfterStopFails) {
+    FramePipeline pipeline(testConfig());
+    pipeline.stop();
+    pipeline.stop();  // Idempotent
+    EXPECT_FALSE(pipeline.submit("s1", createFrame(8, 8, 0), 8, 8));
+    pipeline.waitIdle();  // Returns immediately once stopped
+}
+
+TEST(FramePipelineTest, StatsReportStageTimings) {
+    FramePipeline pipeline(testConfig());
+    pipeline.setSendCallback([](const std::string&, const std::vector<uint8_t>&,
+                                uint32_t, uint32_t, uint32_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(pipeline.submit("s" + std::to_string(i),
+                                    createFrame(64, 64, i), 64, 64));
+    }
+    pipeline.waitIdle();
+
+    auto stats = pipeline.stats();
+    EXPECT_EQ(stats.sent, 3u);
+    EXPECT_EQ(stats.encode.count, 3u);
+    EXPECT_EQ(stats.queueWait.count, 3u);
+    EXPECT_EQ(stats.send.count, 3u);
+    EXPECT_GE(stats.send.averageMs, 4.0);
+    EXPECT_GE(stats.send.maxMs, stats.send.averageMs);
+    EXPECT_GE(stats.latency.maxMs, stats.send.averageMs);
+
+    pipeline.resetStats();
+    stats = pipeline.stats();
+    EXPECT_EQ(stats.submitted, 0u);
+    EXPECT_EQ(stats.latency.count, 0u);
+    EXPECT_EQ(stats.latency.maxMs, 0.0);
+}
+
+TEST(FramePipelineTest, FramesWithoutSendCallbackAreDropped) {
+    FramePipeline pipeline(testConfig());
+    ASSERT_TRUE(pipeline.submit("s1", createFrame(16, 16, 0), 16, 16));
+    pipeline.waitIdle();
+
+    auto stats = pipeline.stats();
+    EXPECT_EQ(stats.sent, 0u);
+    EXPECT_EQ(stats.droppedBeforeSend, 1u);
+}
@@ -35,6 +35,7 @@
 #include <cstdio>
 #include <filesystem>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gdcmDataElement.h>
@@ -73,6 +74,9 @@ const gdcm::Tag TemporalPositionIndex{0x0020, 0x9128};
 const gdcm::Tag TriggerTime{0x0018, 0x1060};
 const gdcm::Tag InStackPositionNumber{0x0020, 0x9057};
 const gdcm::Tag NumberOfFrames{0x0028, 0x0008};
+const gdcm::Tag DimensionIndexSequence{0x0020, 0x9222};
+const gdcm::Tag DimensionIndexPointer{0x0020, 0x9165};
+const gdcm::Tag DimensionDescriptionLabel{0x0020, 0x9421};
 }  // namespace tags
 
 // =============================================================================
@@ -157,8 +161,10 @@ protected:
     }
 
     /// Write a gdcm::File to a temporary path and return the path
-    std::string writeDicomFile(const gdcm::DataSet& ds,
-                               const std::string& filename) {
+    std::string writeDicomFile(
+        const gdcm::DataSet& ds, const std::string& filename,
+        gdcm::TransferSyntax::TSType transferSyntax =
+            gdcm::TransferSyntax::ExplicitVRLittleEndian) {
         auto path = (tempDir_ / filename).string();
         gdcm::Writer writer;
         writer.SetFileName(path.c_str());
@@ -174,7 +180,7 @@ protected:
         // Set file meta information using proper GDCM API
         auto& fmi = writer.GetFile().GetHeader();
         fmi.Clear();
-        fmi.SetDataSetTransferSyntax(gdcm::TransferSyntax::ExplicitVRLittleEndian);
+        fmi.SetDataSetTransferSyntax(transferSyntax);
 
         gdcm::DataElement mediaStorage(gdcm::Tag(0x0002, 0x0002));
         mediaStorage.SetByteValue(sopClass.c_str(),
@@ -1427,6 +1433,187 @@ TEST_F(FunctionalGroupParserTest, ParseSharedAsymmetricPixelSpacing) {
     EXPECT_DOUBLE_EQ(info.pixelSpacingY, 0.75);
 }
 
+// =============================================================================
+// scanFrameTable: streaming header scan
+// =============================================================================
+
+namespace {
+
+/// Top-level dataset with a 2-entry DimensionIndexSequence, shared pixel
+/// measures and three per-frame items (temporal 1-2 x in-stack 1-2)
+gdcm::DataSet buildStreamingScanDataSet() {
+    std::vector<gdcm::DataSet> dimensionItems;
+    for (const auto& [element, label] :
+         {std::pair<uint16_t, const char*>{0x9128, "Temporal"},
+          std::pair<uint16_t, const char*>{0x9057, "InStack"}}) {
+        const uint16_t pointer[2] = {0x0020, element};
+        gdcm::DataSet item;
+        gdcm::DataElement de(tags::DimensionIndexPointer);
+        de.SetByteValue(reinterpret_cast<const char*>(pointer), 4);
+        item.Insert(de);
+        insertStringElement(item, tags::DimensionDescriptionLabel, label);
+        dimensionItems.push_back(item);
+    }
+
+    gdcm::DataSet pixelMeasuresDs;
+    insertStringElement(pixelMeasuresDs, tags::PixelSpacing, "0.5\0.75");
+    insertStringElement(pixelMeasuresDs, tags::SliceThickness, "2.0");
+    gdcm::DataSet sharedGroupDs;
+    insertSequenceWithItem(sharedGroupDs, tags::PixelMeasuresSequence,
+                           pixelMeasuresDs);
+
+    std::vector<gdcm::DataSet> perFrameItems;
+    for (uint32_t i = 0; i < 3; ++i) {
+        gdcm::DataSet planePosDs;
+        insertStringElement(planePosDs, tags::ImagePositionPatient,
+                            "0.0\0.0\" + std::to_string(i * 2) + ".0");
+        gdcm::DataSet frameContentDs;
+        insertUint32Array(frameContentDs, tags::DimensionIndexValues,
+                          {i / 2 + 1, i % 2 + 1});
+        insertStringElement(frameContentDs, tags::TemporalPositionIndex,
+                            std::to_string(i / 2 + 1));
+
+        gdcm::DataSet frameItemDs;
+        insertSequenceWithItem(frameItemDs, tags::PlanePositionSequence,
+                               planePosDs);
+        insertSequenceWithItem(frameItemDs, tags::FrameContentSequence,
+                               frameContentDs);
+        insertStringElement(frameItemDs, tags::TriggerTime,
+                            std::to_string(i * 40) + ".0");
+        perFrameItems.push_back(frameItemDs);
+    }
+
+    gdcm::DataSet topDs;
+    insertSequenceWithItems(topDs, tags::DimensionIndexSequence,
+                            dimensionItems);
+    insertSequenceWithItem(topDs, tags::SharedFunctionalGroups, sharedGroupDs);
+    insertSequenceWithItems(topDs, tags::PerFrameFunctionalGroups,
+                            perFrameItems);
+    return topDs;
+}
+
+void expectStreamingScanTable(const FrameMetadataTable& table) {
+    EXPECT_EQ(table.numberOfFrames, 3);
+    EXPECT_EQ(table.perFrameItemCount, 3);
+
+    ASSERT_EQ(table.dimensions.dimensions.size(), 2u);
+    EXPECT_EQ(table.dimensions.dimensions[0].dimensionIndexPointer,
+              dimension_tag::TemporalPositionIndex);
+    EXPECT_EQ(table.dimensions.dimensions[1].dimensionIndexPointer,
+              dimension_tag::InStackPositionNumber);
+    EXPECT_EQ(table.dimensions.dimensions[0].dimensionDescription, "Temporal");
+
+    ASSERT_TRUE(table.shared.present);
+    ASSERT_TRUE(table.shared.pixelSpacing.has_value());
+    EXPECT_DOUBLE_EQ((*table.shared.pixelSpacing)[1], 0.75);
+    ASSERT_TRUE(table.shared.sliceThickness.has_value());
+    EXPECT_DOUBLE_EQ(*table.shared.sliceThickness, 2.0);
+    EXPECT_FALSE(table.shared.hasPixelValueTransformation);
+
+    // Flat columns: z position and CSR dimension index values
+    EXPECT_DOUBLE_EQ(table.imagePositions[2 * 3 + 2], 4.0);
+    ASSERT_EQ(table.dimensionValueOffsets.size(), 4u);
+    EXPECT_EQ(table.dimensionValueOffsets[3], 6u);
+    EXPECT_EQ(table.dimensionIndexValues[2 * 2], 2u);
+    EXPECT_EQ(table.dimensionIndexValues[2 * 2 + 1], 1u);
+
+    auto frames = table.toFrameInfos();
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[1].dimensionIndices.at(0), 1);
+    EXPECT_EQ(frames[1].dimensionIndices.at(1), 2);
+    ASSERT_TRUE(frames[2].temporalPositionIndex.has_value());
+    EXPECT_EQ(*frames[2].temporalPositionIndex, 2);
+    ASSERT_TRUE(frames[2].triggerTime.has_value());
+    EXPECT_DOUBLE_EQ(*frames[2].triggerTime, 80.0);
+}
+
+}  // anonymous namespace
+
+TEST_F(FunctionalGroupParserTest, ScanFrameTableExplicitVR) {
+    std::string path = writeDicomFile(buildStreamingScanDataSet(),
+                                      "scan_explicit.dcm");
+
+    auto table = parser_.scanFrameTable(path, 3);
+    ASSERT_TRUE(table.has_value()) << table.error().toString();
+    expectStreamingScanTable(*table);
+}
+
+TEST_F(FunctionalGroupParserTest, ScanFrameTableImplicitVR) {
+    std::string path = writeDicomFile(buildStreamingScanDataSet(),
+                                      "scan_implicit.dcm",
+                                      gdcm::TransferSyntax::ImplicitVRLittleEndian);
+
+    auto table = parser_.scanFrameTable(path, 3);
+    ASSERT_TRUE(table.has_value()) << table.error().toString();
+    expectStreamingScanTable(*table);
+}
+
+TEST_F(FunctionalGroupParserTest, ScanFrameTableHeaderOnly) {
+    std::string path = writeDicomFile(buildStreamingScanDataSet(),
+                                      "scan_header_only.dcm");
+
+    // numberOfFrames == 0 stops before the per-frame sequence
+    auto table = parser_.scanFrameTable(path, 0);
+    ASSERT_TRUE(table.has_value());
+    EXPECT_EQ(table->perFrameItemCount, 0);
+    EXPECT_TRUE(table->toFrameInfos().empty());
+    EXPECT_EQ(table->dimensions.dimensions.size(), 2u);
+    EXPECT_TRUE(table->shared.present);
+}
+
+TEST_F(FunctionalGroupParserTest, ScanFrameTableStopsAtRequestedFrames) {
+    std::string path = writeDicomFile(buildStreamingScanDataSet(),
+                                      "scan_fewer_frames.dcm");
+
+    auto table = parser_.scanFrameTable(path, 2);
+    ASSERT_TRUE(table.has_value());
+    EXPECT_EQ(table->perFrameItemCount, 2);
+    EXPECT_EQ(table->dimensionValueOffsets.back(), 4u);
+
+    // Requesting more frames than items leaves the tail at defaults
+    auto padded = parser_.scanFrameTable(path, 5);
+    ASSERT_TRUE(padded.has_value());
+    EXPECT_EQ(padded->perFrameItemCount, 3);
+    auto frames = padded->toFrameInfos();
+    ASSERT_EQ(frames.size(), 5u);
+    EXPECT_TRUE(frames[4].dimensionIndices.empty());
+    EXPECT_DOUBLE_EQ(frames[4].rescaleSlope, 1.0);
+}
+
+TEST_F(FunctionalGroupParserTest, ScanFrameTableNonexistentFile) {
+    auto table = parser_.scanFrameTable("/nonexistent/file.dcm", 3);
+    ASSERT_FALSE(table.has_value());
+    EXPECT_EQ(table.error().code, EnhancedDicomError::Code::ParseFailed);
+}
+
+TEST_F(FunctionalGroupParserTest, ApplySharedGroupsMatchesParseSharedGroups) {
+    std::string path = writeDicomFile(buildStreamingScanDataSet(),
+                                      "scan_apply_shared.dcm");
+
+    auto table = parser_.scanFrameTable(path, 3);
+    ASSERT_TRUE(table.has_value());
+    EnhancedSeriesInfo streamed;
+    streamed.frames = table->toFrameInfos();
+    table->applySharedGroups(streamed);
+
+    EnhancedSeriesInfo parsed;
+    parsed.frames = parser_.parsePerFrameGroups(path, 3, parsed);
+    parser_.parseSharedGroups(path, parsed);
+
+    EXPECT_DOUBLE_EQ(streamed.pixelSpacingX, parsed.pixelSpacingX);
+    EXPECT_DOUBLE_EQ(streamed.pixelSpacingY, parsed.pixelSpacingY);
+    ASSERT_EQ(streamed.frames.size(), parsed.frames.size());
+    for (size_t i = 0; i < streamed.frames.size(); ++i) {
+        EXPECT_DOUBLE_EQ(streamed.frames[i].sliceThickness, 2.0);
+        EXPECT_DOUBLE_EQ(streamed.frames[i].sliceThickness,
+                         parsed.frames[i].sliceThickness);
+        EXPECT_EQ(streamed.frames[i].imagePosition,
+                  parsed.frames[i].imagePosition);
+        EXPECT_EQ(streamed.frames[i].dimensionIndices,
+                  parsed.frames[i].dimensionIndices);
+    }
+}
+
 // =============================================================================
 // DimensionOrganization struct tests (pure data structure, no I/O)
 // =============================================================================
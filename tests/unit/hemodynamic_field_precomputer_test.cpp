@@ -0,0 +1,329 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <vtkImageData.h>
+
+#include "services/flow/hemodynamic_field_precomputer.hpp"
+
+#include "../test_utils/flow_phantom_generator.hpp"
+
+using namespace dicom_viewer::services;
+namespace phantom = dicom_viewer::test_utils;
+
+namespace {
+
+constexpr int kDim = 12;
+constexpr int kPhases = 6;
+
+/// Pulsatile phases: uniform Vz = 50 + 30 sin(2 pi t / T)
+std::vector<VelocityPhase> createPhases() {
+    return phantom::generatePulsatileFlow(kDim, kPhases, 50.0, 30.0, 40.0).first;
+}
+
+HemodynamicFieldPrecomputer::PhaseLoader loaderFor(
+    const std::vector<VelocityPhase>& phases) {
+    return [&phases](int index) -> std::expected<VelocityPhase, FlowError> {
+        return phases.at(static_cast<size_t>(index));
+    };
+}
+
+CompactImageGeometry cubeGeometry(size_t dim) {
+    CompactImageGeometry geometry;
+    geometry.size = {dim, dim, dim};
+    return geometry;
+}
+
+}  // anonymous namespace
+
+// =============================================================================
+// Quantization
+// =============================================================================
+
+TEST(QuantizedScalarFieldTest, RoundTripWithinErrorBound) {
+    std::vector<float> values(kDim * kDim * kDim);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<float>(std::sin(i * 0.37) * 120.0 + 40.0);
+    }
+
+    for (auto format : {FieldQuantization::UInt8, FieldQuantization::UInt16}) {
+        auto field = quantizeScalarField(values, cubeGeometry(kDim), format);
+        EXPECT_NEAR(field.minValue, -80.0f, 0.1f);
+        EXPECT_NEAR(field.maxValue, 160.0f, 0.1f);
+        for (size_t i = 0; i < values.size(); ++i) {
+            ASSERT_NEAR(field.valueAt(i), values[i], field.errorBound() * 1.001 + 1e-4);
+        }
+    }
+
+    auto coarse = quantizeScalarField(values, cubeGeometry(kDim), FieldQuantization::UInt8);
+    auto fine = quantizeScalarField(values, cubeGeometry(kDim), FieldQuantization::UInt16);
+    EXPECT_LT(fine.errorBound(), coarse.errorBound() / 200.0);
+    EXPECT_LT(coarse.memoryBytes(), fine.memoryBytes());
+}
+
+TEST(QuantizedScalarFieldTest, ConstantFieldDecodesExactly) {
+    std::vector<float> values(kDim * kDim * kDim, 7.25f);
+    auto field = quantizeScalarField(values, cubeGeometry(kDim), FieldQuantization::UInt8);
+    EXPECT_DOUBLE_EQ(field.errorBound(), 0.0);
+    EXPECT_FLOAT_EQ(field.valueAt(0), 7.25f);
+
+    auto image = dequantizeScalarField(field);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->GetDimensions()[0], kDim);
+    EXPECT_EQ(image->GetNumberOfScalarComponents(), 1);
+    EXPECT_FLOAT_EQ(static_cast<float*>(image->GetScalarPointer())[5], 7.25f);
+}
+
+// =============================================================================
+// Field derivation
+// =============================================================================
+
+TEST(HemodynamicFieldPrecomputerTest, ComputeVelocityMagnitude) {
+    auto [phase, truth] = phantom::generatePoiseuillePipe(kDim, 80.0, 4.0);
+    auto values = HemodynamicFieldPrecomputer::computeField(
+        phase, HemodynamicFieldType::VelocityMagnitude);
+    ASSERT_TRUE(values.has_value());
+
+    const float* v = phase.velocityField->GetBufferPointer();
+    for (size_t i = 0; i < values->size(); ++i) {
+        ASSERT_FLOAT_EQ((*values)[i], std::abs(v[i * 3 + 2]));
+    }
+}
+
+TEST(HemodynamicFieldPrecomputerTest, ComputeVorticityMagnitude) {
+    auto [phase, truth] = phantom::generateRotatingCylinder(24, 2.0, 8.0);
+    auto values = HemodynamicFieldPrecomputer::computeField(
+        phase, HemodynamicFieldType::Vorticity);
+    ASSERT_TRUE(values.has_value());
+
+    // |curl V| = 2 omega, scaled from cm/s per mm to 1/s
+    size_t center = 12 * 24 * 24 + 12 * 24 + 12;
+    EXPECT_NEAR((*values)[center], truth.vorticity * 10.0, truth.vorticity * 0.5);
+}
+
+TEST(HemodynamicFieldPrecomputerTest, ComputeFieldRejectsInvalidPhase) {
+    VelocityPhase empty;
+    EXPECT_FALSE(HemodynamicFieldPrecomputer::computeField(
+        empty, HemodynamicFieldType::EnergyLoss).has_value());
+}
+
+// =============================================================================
+// Background precomputation
+// =============================================================================
+
+TEST(HemodynamicFieldPrecomputerTest, StartValidation) {
+    HemodynamicFieldPrecomputer precomputer;
+    EXPECT_FALSE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, 4).has_value());
+
+    auto phases = createPhases();
+    precomputer.setPhaseLoader(loaderFor(phases));
+    EXPECT_FALSE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, 0).has_value());
+    EXPECT_FALSE(precomputer.isRunning());
+}
+
+TEST(HemodynamicFieldPrecomputerTest, PrecomputesEveryPhase) {
+    auto phases = createPhases();
+    HemodynamicFieldPrecomputer precomputer;
+    precomputer.setPhaseLoader(loaderFor(phases));
+    precomputer.setThreadCount(2);
+
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, kPhases).has_value());
+    precomputer.wait();
+
+    auto status = precomputer.status();
+    EXPECT_FALSE(status.running);
+    EXPECT_EQ(status.computedCount, kPhases);
+    EXPECT_EQ(status.totalPhases, kPhases);
+    EXPECT_EQ(status.failedCount, 0);
+    EXPECT_GT(status.memoryUsageBytes, 0u);
+
+    for (int p = 0; p < kPhases; ++p) {
+        ASSERT_TRUE(precomputer.isComputed(p));
+        auto field = precomputer.getField(p);
+        ASSERT_TRUE(field.has_value()) << field.error().toString();
+        float expected = std::abs(phases[p].velocityField->GetBufferPointer()[2]);
+        auto* values = static_cast<float*>((*field)->GetScalarPointer());
+        EXPECT_NEAR(values[kDim * kDim + 3], expected, 1e-3f);
+    }
+    EXPECT_EQ(precomputer.status().hitCount, static_cast<uint64_t>(kPhases));
+    EXPECT_EQ(precomputer.status().missCount, 0u);
+
+    auto [lo, hi] = precomputer.valueRange();
+    EXPECT_NEAR(lo, 50.0 - 30.0 * std::sin(std::numbers::pi / 3.0), 1e-3);
+    EXPECT_NEAR(hi, 50.0 + 30.0 * std::sin(std::numbers::pi / 3.0), 1e-3);
+}
+
+TEST(HemodynamicFieldPrecomputerTest, ReportsProgressThroughCallback) {
+    auto phases = createPhases();
+    HemodynamicFieldPrecomputer precomputer;
+    precomputer.setPhaseLoader(loaderFor(phases));
+
+    std::mutex mutex;
+    std::vector<FieldPrecomputeStatus> reports;
+    precomputer.setStatusCallback([&](const FieldPrecomputeStatus& status) {
+        std::lock_guard lock(mutex);
+        reports.push_back(status);
+    });
+
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::EnergyLoss, kPhases).has_value());
+    precomputer.wait();
+
+    std::lock_guard lock(mutex);
+    ASSERT_EQ(reports.size(), static_cast<size_t>(kPhases + 1));
+    EXPECT_EQ(reports.back().computedCount, kPhases);
+    EXPECT_FALSE(reports.back().running);
+    EXPECT_EQ(reports.back().fieldType, HemodynamicFieldType::EnergyLoss);
+    EXPECT_TRUE(reports.front().running);
+}
+
+TEST(HemodynamicFieldPrecomputerTest, MissComputesOnCallerWithoutDuplicates) {
+    auto phases = createPhases();
+    const auto mainThread = std::this_thread::get_id();
+    std::atomic<bool> released{false};
+
+    HemodynamicFieldPrecomputer precomputer;
+    precomputer.setThreadCount(1);
+    precomputer.setPhaseLoader(
+        [&](int index) -> std::expected<VelocityPhase, FlowError> {
+            // Hold the background pass until the caller has been served
+            while (std::this_thread::get_id() != mainThread && !released) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return phases.at(static_cast<size_t>(index));
+        });
+
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, kPhases).has_value());
+    auto field = precomputer.getField(4);
+    ASSERT_TRUE(field.has_value());
+    EXPECT_TRUE(precomputer.isComputed(4));
+    EXPECT_EQ(precomputer.status().missCount, 1u);
+
+    released = true;
+    precomputer.wait();
+    auto status = precomputer.status();
+    EXPECT_EQ(status.computedCount, kPhases);
+
+    size_t bytes = 0;
+    for (int p = 0; p < kPhases; ++p) {
+        bytes += precomputer.getQuantizedField(p)->memoryBytes();
+    }
+    EXPECT_EQ(status.memoryUsageBytes, bytes);
+}
+
+TEST(HemodynamicFieldPrecomputerTest, FailedPhasesAreCounted) {
+    auto phases = createPhases();
+    HemodynamicFieldPrecomputer precomputer;
+    precomputer.setPhaseLoader(
+        [&](int index) -> std::expected<VelocityPhase, FlowError> {
+            if (index == 2) {
+                return std::unexpected(FlowError{FlowError::Code::ParseFailed, "corrupt"});
+            }
+            return phases.at(static_cast<size_t>(index));
+        });
+
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, kPhases).has_value());
+    precomputer.wait();
+
+    auto status = precomputer.status();
+    EXPECT_EQ(status.computedCount, kPhases - 1);
+    EXPECT_EQ(status.failedCount, 1);
+    EXPECT_FALSE(precomputer.isComputed(2));
+    EXPECT_FALSE(precomputer.getField(2).has_value());
+    EXPECT_FALSE(precomputer.getField(kPhases).has_value());
+}
+
+TEST(HemodynamicFieldPrecomputerTest, NonStandardLoaderExceptionEndsPass) {
+    auto phases = createPhases();
+    HemodynamicFieldPrecomputer precomputer;
+    precomputer.setThreadCount(1);
+    precomputer.setPhaseLoader(
+        [&](int index) -> std::expected<VelocityPhase, FlowError> {
+            if (index == 2) {
+                throw 42;
+            }
+            return phases.at(static_cast<size_t>(index));
+        });
+
+    // The worker must finish the pass instead of terminating the process
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, kPhases).has_value());
+    precomputer.wait();
+
+    auto status = precomputer.status();
+    EXPECT_FALSE(status.running);
+    EXPECT_FALSE(precomputer.isComputed(2));
+}
+
+TEST(HemodynamicFieldPrecomputerTest, QuantizationSelectsBitDepth) {
+    auto phases = createPhases();
+    HemodynamicFieldPrecomputer precomputer;
+    precomputer.setPhaseLoader(loaderFor(phases));
+
+    precomputer.setQuantization(FieldQuantization::UInt16);
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, kPhases).has_value());
+    precomputer.wait();
+    size_t bytes16 = precomputer.status().memoryUsageBytes;
+    EXPECT_EQ(precomputer.getQuantizedField(0)->format, FieldQuantization::UInt16);
+
+    precomputer.setQuantization(FieldQuantization::UInt8);
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, kPhases).has_value());
+    precomputer.wait();
+    auto status = precomputer.status();
+    EXPECT_EQ(status.quantization, FieldQuantization::UInt8);
+    EXPECT_LT(status.memoryUsageBytes, bytes16);
+    EXPECT_EQ(precomputer.getQuantizedField(0)->format, FieldQuantization::UInt8);
+}
+
+TEST(HemodynamicFieldPrecomputerTest, CancelAndClear) {
+    auto phases = createPhases();
+    HemodynamicFieldPrecomputer precomputer;
+    precomputer.setThreadCount(1);
+    precomputer.setPhaseLoader(
+        [&](int index) -> std::expected<VelocityPhase, FlowError> {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return phases.at(static_cast<size_t>(index));
+        });
+
+    ASSERT_TRUE(precomputer.start(HemodynamicFieldType::VelocityMagnitude, kPhases).has_value());
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    precomputer.cancel();
+    EXPECT_FALSE(precomputer.isRunning());
+    EXPECT_LT(precomputer.status().computedCount, kPhases);
+
+    precomputer.clear();
+    auto status = precomputer.status();
+    EXPECT_EQ(status.computedCount, 0);
+    EXPECT_EQ(status.memoryUsageBytes, 0u);
+}
@@ -691,5 +691,97 @@ TEST(ImageConverterCrossType, SameOriginAcrossTypes) {
     EXPECT_NEAR(ctOrigin[2], mrOrigin[2], 1e-10);
 }
 
+// =============================================================================
+// Shared-buffer conversion (ConversionMode::SharedBuffer)
+// =============================================================================
+
+using ConversionMode = ImageConverter::ConversionMode;
+
+TEST(ImageConverterSharedBuffer, ItkToVtkAliasesPixelBuffer) {
+    auto img = createTestImage<CTImageType>(6, 5, 4, 0.5, 0.5, 2.0, -10.0, 5.0, 30.0);
+    fillWithGradient<CTImageType>(img);
+
+    auto vtkImg = ImageConverter::itkToVtk(img, ConversionMode::SharedBuffer);
+    ASSERT_NE(vtkImg, nullptr);
+    EXPECT_EQ(vtkImg->GetScalarPointer(), static_cast<void*>(img->GetBufferPointer()));
+    EXPECT_EQ(vtkImg->GetScalarType(), VTK_SHORT);
+
+    int dims[3];
+    vtkImg->GetDimensions(dims);
+    EXPECT_EQ(dims[0], 6);
+    EXPECT_EQ(dims[1], 5);
+    EXPECT_EQ(dims[2], 4);
+    double origin[3];
+    vtkImg->GetOrigin(origin);
+    EXPECT_NEAR(origin[2], 30.0, 1e-10);
+
+    // Writes through ITK are visible in VTK
+    CTImageType::IndexType idx = {{2, 3, 1}};
+    img->SetPixel(idx, 1234);
+    auto* vtkPixel = static_cast<short*>(vtkImg->GetScalarPointer(2, 3, 1));
+    EXPECT_EQ(*vtkPixel, 1234);
+}
+
+TEST(ImageConverterSharedBuffer, DeepCopyDoesNotAlias) {
+    auto img = createTestImage<CTImageType>(4, 4, 4);
+    auto vtkImg = ImageConverter::itkToVtk(img);
+    EXPECT_NE(vtkImg->GetScalarPointer(), static_cast<void*>(img->GetBufferPointer()));
+}
+
+TEST(ImageConverterSharedBuffer, VtkImageKeepsItkBufferAlive) {
+    vtkSmartPointer<vtkImageData> vtkImg;
+    {
+        auto img = createTestImage<MRImageType>(8, 8, 2);
+        fillWithConstant<MRImageType>(img, 777);
+        vtkImg = ImageConverter::itkToVtk(img, ConversionMode::SharedBuffer);
+    }
+    // The ITK image is gone; its pixel container must still be valid
+    auto* pixel = static_cast<unsigned short*>(vtkImg->GetScalarPointer(7, 7, 1));
+    EXPECT_EQ(*pixel, 777);
+}
+
+TEST(ImageConverterSharedBuffer, MaskImageShared) {
+    auto mask = createTestImage<MaskImageType>(3, 3, 3);
+    mask->FillBuffer(5);
+    auto vtkImg = ImageConverter::itkToVtk(mask, ConversionMode::SharedBuffer);
+    EXPECT_EQ(vtkImg->GetScalarType(), VTK_UNSIGNED_CHAR);
+    EXPECT_EQ(vtkImg->GetScalarPointer(), static_cast<void*>(mask->GetBufferPointer()));
+}
+
+TEST(ImageConverterSharedBuffer, VtkToItkAliasesScalarsAndKeepsThemAlive) {
+    CTImageType::Pointer itkImg;
+    short* vtkBuffer = nullptr;
+    {
+        auto source = createTestImage<CTImageType>(5, 4, 3, 0.7, 0.8, 1.5, 1.0, 2.0, 3.0);
+        fillWithGradient<CTImageType>(source);
+        auto vtkImg = ImageConverter::itkToVtk(source);
+        vtkBuffer = static_cast<short*>(vtkImg->GetScalarPointer());
+        itkImg = ImageConverter::vtkToItkCT(vtkImg, ConversionMode::SharedBuffer);
+    }
+    ASSERT_NE(itkImg, nullptr);
+    EXPECT_EQ(itkImg->GetBufferPointer(), vtkBuffer);
+
+    auto size = itkImg->GetLargestPossibleRegion().GetSize();
+    EXPECT_EQ(size[0], 5u);
+    EXPECT_EQ(size[1], 4u);
+    EXPECT_EQ(size[2], 3u);
+    EXPECT_NEAR(itkImg->GetSpacing()[1], 0.8, 1e-10);
+    EXPECT_NEAR(itkImg->GetOrigin()[2], 3.0, 1e-10);
+
+    CTImageType::IndexType last = {{4, 3, 2}};
+    EXPECT_EQ(itkImg->GetPixel(last), 59);
+}
+
+TEST(ImageConverterSharedBuffer, DeepCopyVtkToItkOutlivesVtkImage) {
+    CTImageType::Pointer itkImg;
+    {
+        auto source = createTestImage<CTImageType>(4, 4, 4);
+        fillWithConstant<CTImageType>(source, -500);
+        itkImg = ImageConverter::vtkToItkCT(ImageConverter::itkToVtk(source));
+    }
+    CTImageType::IndexType idx = {{3, 3, 3}};
+    EXPECT_EQ(itkImg->GetPixel(idx), -500);
+}
+
 }  // namespace
 }  // namespace dicom_viewer::core
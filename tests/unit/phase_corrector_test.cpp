@@ -29,7 +29,10 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <cmath>
+#include <functional>
+#include <vector>
 
 #include <itkImage.h>
 #include <itkImageRegionIterator.h>
@@ -76,6 +79,47 @@ FloatImage3D::Pointer createUniformScalarImage(
     return image;
 }
 
+/// Create a 3-component vector image with velocity f(x, y, z) per voxel
+VectorImage3D::Pointer createFieldVectorImage(
+    unsigned int sx, unsigned int sy, unsigned int sz,
+    const std::function<std::array<float, 3>(unsigned, unsigned, unsigned)>& f) {
+    auto image = createUniformVectorImage(sx, sy, sz, 0.0f, 0.0f, 0.0f);
+    float* buffer = image->GetBufferPointer();
+    for (unsigned z = 0; z < sz; ++z) {
+        for (unsigned y = 0; y < sy; ++y) {
+            for (unsigned x = 0; x < sx; ++x) {
+                size_t voxel = x + sx * (y + static_cast<size_t>(sy) * z);
+                auto v = f(x, y, z);
+                buffer[voxel * 3] = v[0];
+                buffer[voxel * 3 + 1] = v[1];
+                buffer[voxel * 3 + 2] = v[2];
+            }
+        }
+    }
+    return image;
+}
+
+/// Magnitude with background (air) in the first two x-columns, tissue elsewhere
+FloatImage3D::Pointer createTissueMagnitude(
+    unsigned int sx, unsigned int sy, unsigned int sz) {
+    auto image = createUniformScalarImage(sx, sy, sz, 1000.0f);
+    float* buffer = image->GetBufferPointer();
+    for (size_t voxel = 0; voxel < static_cast<size_t>(sx) * sy * sz; ++voxel) {
+        if (voxel % sx < 2) buffer[voxel] = 5.0f;
+    }
+    return image;
+}
+
+/// Eddy current background: linear in x, quadratic in z (normalized coords)
+std::array<float, 3> eddyBackground(unsigned x, unsigned y, unsigned z) {
+    double nx = x * 2.0 / 15.0 - 1.0;
+    double ny = y * 2.0 / 11.0 - 1.0;
+    double nz = z * 2.0 / 7.0 - 1.0;
+    return {static_cast<float>(4.0 + 3.0 * nx),
+            static_cast<float>(-2.0 + 1.5 * ny - nz * nz),
+            static_cast<float>(1.0 + 0.5 * nx * ny)};
+}
+
 }  // anonymous namespace
 
 // =============================================================================
@@ -384,6 +428,28 @@ TEST(PolynomialFitTest, TooFewSamples) {
     }
 }
 
+TEST(PolynomialFitTest, HighOrderFitsAndNegativeOrderIsRejected) {
+    auto scalar = createUniformScalarImage(8, 8, 8, 42.0f);
+    auto mask = MaskImage3D::New();
+    MaskImage3D::SizeType size = {{8, 8, 8}};
+    MaskImage3D::RegionType region;
+    region.SetSize(size);
+    mask->SetRegions(region);
+    mask->Allocate();
+    mask->FillBuffer(255);
+
+    // Order 5 (56 terms) is fitted through the general normal-equation path
+    auto coeffs = PhaseCorrector::fitPolynomialBackground(scalar, mask, 5);
+    ASSERT_EQ(coeffs.size(), 56u);
+    EXPECT_NEAR(coeffs[0], 42.0, 1e-6);
+    for (size_t i = 1; i < coeffs.size(); ++i) {
+        EXPECT_NEAR(coeffs[i], 0.0, 1e-6) << "term " << i;
+    }
+    EXPECT_NEAR(PhaseCorrector::evaluatePolynomial(coeffs, 0.3, -0.7, 0.5, 5), 42.0, 1e-6);
+
+    EXPECT_TRUE(PhaseCorrector::fitPolynomialBackground(scalar, mask, -1).empty());
+}
+
 // =============================================================================
 // correctEddyCurrent integration test
 // =============================================================================
@@ -545,3 +611,189 @@ TEST(PolynomialTest, QuadraticTerms) {
     val = PhaseCorrector::evaluatePolynomial(coeffs, 2.0, 0.0, 0.0, 2);
     EXPECT_NEAR(val, 9.0, 0.01);
 }
+
+// =============================================================================
+// Streaming polynomial fit
+// =============================================================================
+
+TEST(PolynomialFitTest, RecoversQuadraticBackground) {
+    // 16 x 12 x 8 grid; field is an exact order-2 polynomial in normalized coords
+    auto velocity = createFieldVectorImage(16, 12, 8, eddyBackground);
+    auto scalar = createUniformScalarImage(16, 12, 8, 0.0f);
+    float* out = scalar->GetBufferPointer();
+    const float* in = velocity->GetBufferPointer();
+    for (size_t i = 0; i < 16u * 12u * 8u; ++i) out[i] = in[i * 3 + 1];
+
+    auto mask = MaskImage3D::New();
+    MaskImage3D::SizeType size = {{16, 12, 8}};
+    MaskImage3D::RegionType region;
+    region.SetSize(size);
+    mask->SetRegions(region);
+    mask->Allocate();
+    mask->FillBuffer(255);
+
+    auto coeffs = PhaseCorrector::fitPolynomialBackground(scalar, mask, 2);
+    ASSERT_EQ(coeffs.size(), 10u);
+    for (double nx : {-1.0, 0.0, 0.6}) {
+        for (double nz : {-1.0, 0.3, 1.0}) {
+            double expected = -2.0 + 1.5 * 0.2 - nz * nz;
+            EXPECT_NEAR(PhaseCorrector::evaluatePolynomial(coeffs, nx, 0.2, nz, 2),
+                        expected, 1e-4);
+        }
+    }
+}
+
+TEST(PolynomialFitTest, MismatchedMaskReturnsZeros) {
+    auto scalar = createUniformScalarImage(8, 8, 4, 42.0f);
+    auto mask = MaskImage3D::New();
+    MaskImage3D::SizeType size = {{4, 4, 4}};
+    MaskImage3D::RegionType region;
+    region.SetSize(size);
+    mask->SetRegions(region);
+    mask->Allocate();
+    mask->FillBuffer(255);
+
+    auto coeffs = PhaseCorrector::fitPolynomialBackground(scalar, mask, 1);
+    for (double c : coeffs) {
+        EXPECT_DOUBLE_EQ(c, 0.0);
+    }
+}
+
+TEST(EddyCurrentTest, RemovesBackgroundFromAllComponents) {
+    auto velocity = createFieldVectorImage(16, 12, 8, eddyBackground);
+    auto magnitude = createTissueMagnitude(16, 12, 8);
+
+    PhaseCorrector::correctEddyCurrent(velocity, magnitude, 2);
+
+    // Background is removed everywhere, including the unmasked air columns
+    for (long x : {0L, 7L, 15L}) {
+        VectorImage3D::IndexType idx = {{x, 5, 3}};
+        auto pixel = velocity->GetPixel(idx);
+        EXPECT_NEAR(pixel[0], 0.0f, 1e-3f);
+        EXPECT_NEAR(pixel[1], 0.0f, 1e-3f);
+        EXPECT_NEAR(pixel[2], 0.0f, 1e-3f);
+    }
+}
+
+// =============================================================================
+// Acquisition-level correction (correctPhases)
+// =============================================================================
+
+TEST(CorrectPhasesTest, InvalidInputs) {
+    PhaseCorrector corrector;
+    PhaseCorrectionConfig config;
+
+    EXPECT_FALSE(corrector.correctPhases({}, 150.0, config).has_value());
+
+    VelocityPhase a;
+    a.velocityField = createUniformVectorImage(4, 4, 4, 1.0f, 1.0f, 1.0f);
+    VelocityPhase b;
+    b.velocityField = createUniformVectorImage(4, 4, 5, 1.0f, 1.0f, 1.0f);
+    auto mismatched = corrector.correctPhases({a, b}, 150.0, config);
+    ASSERT_FALSE(mismatched.has_value());
+    EXPECT_EQ(mismatched.error().code, FlowError::Code::InvalidInput);
+
+    EXPECT_FALSE(corrector.correctPhases({a}, 0.0, config).has_value());
+    EXPECT_FALSE(corrector.correctPhases({a, VelocityPhase{}}, 150.0, config).has_value());
+}
+
+TEST(CorrectPhasesTest, MatchesPerPhaseCorrectionForStaticAcquisition) {
+    // Identical phases: the time-averaged fit equals each per-phase fit
+    std::vector<VelocityPhase> phases;
+    for (int p = 0; p < 3; ++p) {
+        VelocityPhase phase;
+        phase.velocityField = createFieldVectorImage(16, 12, 8,
+            [](unsigned x, unsigned y, unsigned z) {
+                auto v = eddyBackground(x, y, z);
+                // Aliased band the unwrap has to fix
+                if (x >= 9 && x < 12 && y == 4) v[0] -= 200.0f;
+                return v;
+            });
+        phase.magnitudeImage = createTissueMagnitude(16, 12, 8);
+        phase.phaseIndex = p;
+        phase.triggerTime = p * 40.0;
+        phases.push_back(phase);
+    }
+
+    PhaseCorrector corrector;
+    PhaseCorrectionConfig config;
+    auto all = corrector.correctPhases(phases, 100.0, config);
+    ASSERT_TRUE(all.has_value());
+    ASSERT_EQ(all->size(), phases.size());
+
+    auto single = corrector.correctPhase(phases[1], 100.0, config);
+    ASSERT_TRUE(single.has_value());
+
+    const float* expected = single->velocityField->GetBufferPointer();
+    const float* actual = (*all)[1].velocityField->GetBufferPointer();
+    for (size_t i = 0; i < 16u * 12u * 8u * 3u; ++i) {
+        ASSERT_NEAR(actual[i], expected[i], 1e-3f) << "value " << i;
+    }
+    EXPECT_EQ((*all)[2].phaseIndex, 2);
+    EXPECT_DOUBLE_EQ((*all)[2].triggerTime, 80.0);
+}
+
+TEST(CorrectPhasesTest, FitsTimeAveragedBackground) {
+    // Tissue carries the static background plus a per-phase offset of ±5 cm/s
+    // that averages to zero; only the static part must be removed
+    std::vector<VelocityPhase> phases;
+    for (int p = 0; p < 4; ++p) {
+        float offset = (p % 2 == 0) ? 5.0f : -5.0f;
+        VelocityPhase phase;
+        phase.velocityField = createFieldVectorImage(16, 12, 8,
+            [offset](unsigned x, unsigned y, unsigned z) {
+                auto v = eddyBackground(x, y, z);
+                v[2] += offset;
+                return v;
+            });
+        phase.magnitudeImage = createTissueMagnitude(16, 12, 8);
+        phase.phaseIndex = p;
+        phase.triggerTime = p * 40.0;
+        phases.push_back(phase);
+    }
+
+    PhaseCorrector corrector;
+    PhaseCorrectionConfig config;
+    config.enableAliasingUnwrap = false;
+    auto result = corrector.correctPhases(phases, 150.0, config);
+    ASSERT_TRUE(result.has_value());
+
+    VectorImage3D::IndexType idx = {{8, 6, 4}};
+    auto even = (*result)[0].velocityField->GetPixel(idx);
+    auto odd = (*result)[1].velocityField->GetPixel(idx);
+    EXPECT_NEAR(even[0], 0.0f, 1e-3f);
+    EXPECT_NEAR(even[2], 5.0f, 1e-3f);
+    EXPECT_NEAR(odd[2], -5.0f, 1e-3f);
+}
+
+TEST(CorrectPhasesTest, ResultIndependentOfThreadCount) {
+    std::vector<VelocityPhase> phases;
+    for (int p = 0; p < 3; ++p) {
+        VelocityPhase phase;
+        phase.velocityField = createFieldVectorImage(16, 12, 8,
+            [p](unsigned x, unsigned y, unsigned z) {
+                auto v = eddyBackground(x, y, z);
+                v[0] += static_cast<float>(p * ((x * 7 + y * 3 + z) % 5));
+                return v;
+            });
+        phase.magnitudeImage = createTissueMagnitude(16, 12, 8);
+        phases.push_back(phase);
+    }
+
+    PhaseCorrector corrector;
+    PhaseCorrectionConfig config;
+    config.threadCount = 1;
+    auto serial = corrector.correctPhases(phases, 150.0, config);
+    config.threadCount = 4;
+    auto parallel = corrector.correctPhases(phases, 150.0, config);
+    ASSERT_TRUE(serial.has_value());
+    ASSERT_TRUE(parallel.has_value());
+
+    for (size_t p = 0; p < phases.size(); ++p) {
+        const float* a = (*serial)[p].velocityField->GetBufferPointer();
+        const float* b = (*parallel)[p].velocityField->GetBufferPointer();
+        for (size_t i = 0; i < 16u * 12u * 8u * 3u; ++i) {
+            ASSERT_EQ(a[i], b[i]) << "phase " << p << " value " << i;
+        }
+    }
+}
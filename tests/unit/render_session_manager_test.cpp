@@ -39,6 +39,9 @@
 #include <thread>
 #include <vector>
 
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
 using namespace dicom_viewer::services;
 
 // =============================================================================
@@ -88,6 +91,7 @@ TEST_F(RenderSessionManagerTest, DefaultConfigValues) {
     EXPECT_EQ(mgr.config().idleTimeoutSeconds, 300u);
     EXPECT_EQ(mgr.config().defaultWidth, 512u);
     EXPECT_EQ(mgr.config().defaultHeight, 512u);
+    EXPECT_EQ(mgr.config().volumeCacheBudgetBytes, 4ULL * 1024 * 1024 * 1024);
 }
 
 // =============================================================================
@@ -526,3 +530,306 @@ TEST_F(RenderSessionManagerTest, NotifyInteractionOnMissingSessionIsNoop) {
     mgr.notifyInteractionStart("nonexistent");
     mgr.notifyInteractionEnd("nonexistent");
 }
+
+// =============================================================================
+// Shared volume cache
+// =============================================================================
+
+TEST_F(RenderSessionManagerTest, SessionsShareCachedVolume) {
+    auto cfg = defaultConfig();
+    RenderSessionManager mgr(cfg);
+    mgr.createSession("s1");
+    mgr.createSession("s2");
+
+    int loads = 0;
+    auto loader = [&]() {
+        ++loads;
+        auto image = vtkSmartPointer<vtkImageData>::New();
+        image->SetDimensions(8, 8, 8);
+        image->AllocateScalars(VTK_SHORT, 1);
+        return image;
+    };
+
+    StudyVolumeKey key{"1.2.840.1", ""};
+    EXPECT_TRUE(mgr.loadSessionVolume("s1", key, loader));
+    EXPECT_TRUE(mgr.loadSessionVolume("s2", key, loader));
+    EXPECT_EQ(loads, 1);
+
+    auto v1 = mgr.sessionVolume("s1");
+    auto v2 = mgr.sessionVolume("s2");
+    ASSERT_NE(v1, nullptr);
+    EXPECT_EQ(v1->image, v2->image);
+    EXPECT_EQ(mgr.volumeCache().stats().entries, 1u);
+}
+
+TEST_F(RenderSessionManagerTest, LoadSessionVolumeFailures) {
+    auto cfg = defaultConfig();
+    RenderSessionManager mgr(cfg);
+
+    StudyVolumeKey key{"1.2.840.1", ""};
+    auto loader = []() { return vtkSmartPointer<vtkImageData>(); };
+    EXPECT_FALSE(mgr.loadSessionVolume("missing", key, loader));
+
+    mgr.createSession("s1");
+    EXPECT_FALSE(mgr.loadSessionVolume("s1", key, loader));
+    EXPECT_EQ(mgr.sessionVolume("s1"), nullptr);
+}
+
+TEST_F(RenderSessionManagerTest, PreviewDoesNotReplaceCachedVolume) {
+    auto cfg = defaultConfig();
+    RenderSessionManager mgr(cfg);
+    auto makeImage = [](int edge) {
+        auto image = vtkSmartPointer<vtkImageData>::New();
+        image->SetDimensions(edge, edge, edge);
+        image->AllocateScalars(VTK_SHORT, 1);
+        return image;
+    };
+
+    EXPECT_FALSE(mgr.previewSessionVolume("missing", makeImage(4)));
+
+    mgr.createSession("s1");
+    StudyVolumeKey key{"1.2.840.1", ""};
+    ASSERT_TRUE(mgr.loadSessionVolume("s1", key, [&]() { return makeImage(8); }));
+    auto loaded = mgr.sessionVolume("s1");
+
+    EXPECT_TRUE(mgr.previewSessionVolume("s1", makeImage(4)));
+    EXPECT_EQ(mgr.sessionVolume("s1"), loaded);
+    EXPECT_EQ(mgr.volumeCache().stats().entries, 1u);
+
+    // nullptr puts the cached volume back
+    EXPECT_TRUE(mgr.previewSessionVolume("s1", nullptr));
+    EXPECT_EQ(mgr.sessionVolume("s1"), loaded);
+}
+
+TEST_F(RenderSessionManagerTest, DestroyedSessionReleasesVolume) {
+    auto cfg = defaultConfig();
+    cfg.volumeCacheBudgetBytes = 1;  // evict anything no session holds
+    RenderSessionManager mgr(cfg);
+    mgr.createSession("s1");
+
+    StudyVolumeKey key{"1.2.840.1", ""};
+    ASSERT_TRUE(mgr.loadSessionVolume("s1", key, []() {
+        auto image = vtkSmartPointer<vtkImageData>::New();
+        image->SetDimensions(4, 4, 4);
+        image->AllocateScalars(VTK_SHORT, 1);
+        return image;
+    }));
+
+    mgr.destroySession("s1");
+    mgr.volumeCache().setBudget(1);
+    EXPECT_EQ(mgr.volumeCache().find(key), nullptr);
+}
+
+TEST_F(RenderSessionManagerTest, SessionDestroyedCallbackCoversExplicitAndIdle) {
+    auto cfg = defaultConfig();
+    cfg.idleTimeoutSeconds = 1;
+    RenderSessionManager mgr(cfg);
+
+    std::vector<std::string> destroyed;
+    mgr.setSessionDestroyedCallback([&](const std::string& id) {
+        // Called without the manager lock, so re-entry must not deadlock
+        EXPECT_FALSE(mgr.hasSession(id));
+        destroyed.push_back(id);
+    });
+
+    mgr.createSession("s1");
+    mgr.createSession("s2");
+    EXPECT_TRUE(mgr.destroySession("s1"));
+    EXPECT_FALSE(mgr.destroySession("s1"));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_EQ(mgr.cleanupIdleSessions(), 1u);
+
+    ASSERT_EQ(destroyed.size(), 2u);
+    EXPECT_EQ(destroyed[0], "s1");
+    EXPECT_EQ(destroyed[1], "s2");
+}
+
+// =============================================================================
+// Parallel render workers
+// =============================================================================
+
+namespace {
+
+vtkSmartPointer<vtkImageData> createRenderVolume()
+{
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(16, 16, 16);
+    image->AllocateScalars(VTK_SHORT, 1);
+    auto* data = static_cast<short*>(image->GetScalarPointer());
+    for (int i = 0; i < 16 * 16 * 16; ++i) {
+        data[i] = static_cast<short>(i % 512);
+    }
+    return image;
+}
+
+/// Load a shared volume and enter interaction mode so frames are emitted
+void prepareForFrames(RenderSessionManager& mgr, const std::string& id)
+{
+    mgr.loadSessionVolume(id, StudyVolumeKey{"1.2.840.99", ""},
+                          []() { return createRenderVolume(); });
+    mgr.notifyInteractionStart(id);
+}
+
+/// Wait for a condition, returning false on timeout
+template <typename Pred>
+bool waitFor(Pred pred, std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_F(RenderSessionManagerTest, RenderWorkerCountFollowsConfig) {
+    auto cfg = defaultConfig();
+    cfg.renderThreads = 3;
+    EXPECT_EQ(RenderSessionManager(cfg).renderWorkerCount(), 3u);
+
+    // Never more workers than sessions can exist
+    cfg.renderThreads = 16;
+    EXPECT_EQ(RenderSessionManager(cfg).renderWorkerCount(), 4u);
+
+    cfg.renderThreads = 0;
+    cfg.maxSessions = 0;
+    EXPECT_GE(RenderSessionManager(cfg).renderWorkerCount(), 1u);
+}
+
+TEST_F(RenderSessionManagerTest, BookkeepingDoesNotWaitBehindFrameDelivery) {
+    auto cfg = defaultConfig();
+    cfg.renderThreads = 2;
+    RenderSessionManager mgr(cfg);
+    mgr.createSession("s1");
+    prepareForFrames(mgr, "s1");
+
+    std::atomic<bool> inCallback{false};
+    std::atomic<bool> release{false};
+    mgr.setFrameReadyCallback([&](const std::string&, const std::vector<uint8_t>&,
+                                  uint32_t, uint32_t) {
+        inCallback.store(true);
+        waitFor([&] { return release.load(); }, std::chrono::seconds(5));
+    });
+    mgr.startRenderLoop();
+
+    if (!waitFor([&] { return inCallback.load(); }, std::chrono::seconds(2))) {
+        mgr.stopRenderLoop();
+        GTEST_SKIP() << "Off-screen rendering produced no frames";
+    }
+
+    // A frame for s1 is in flight; bookkeeping must not block on it
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(mgr.createSession("s2"));
+    mgr.touchSession("s1");
+    EXPECT_TRUE(mgr.hasSession("s1"));
+    EXPECT_EQ(mgr.activeSessionCount(), 2u);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    release.store(true);
+    mgr.stopRenderLoop();
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+TEST_F(RenderSessionManagerTest, SlowSessionDoesNotStallOtherWorkers) {
+    auto cfg = defaultConfig();
+    cfg.renderThreads = 2;
+    cfg.targetFps = 30;
+    RenderSessionManager mgr(cfg);
+    mgr.createSession("slow");
+    mgr.createSession("fast");
+    prepareForFrames(mgr, "slow");
+    prepareForFrames(mgr, "fast");
+
+    std::atomic<bool> release{false};
+    std::atomic<int> fastFrames{0};
+    std::atomic<bool> slowStarted{false};
+    mgr.setFrameReadyCallback([&](const std::string& id, const std::vector<uint8_t>&,
+                                  uint32_t, uint32_t) {
+        if (id == "slow") {
+            slowStarted.store(true);
+            waitFor([&] { return release.load(); }, std::chrono::seconds(5));
+        } else {
+            fastFrames.fetch_add(1);
+        }
+    });
+    mgr.startRenderLoop();
+
+    if (!waitFor([&] { return slowStarted.load(); }, std::chrono::seconds(2))) {
+        mgr.stopRenderLoop();
+        GTEST_SKIP() << "Off-screen rendering produced no frames";
+    }
+
+    // Sessions sit on different workers, so "fast" keeps rendering
+    int before = fastFrames.load();
+    bool progressed = waitFor([&] { return fastFrames.load() >= before + 3; },
+                              std::chrono::seconds(3));
+
+    release.store(true);
+    mgr.stopRenderLoop();
+    EXPECT_TRUE(progressed);
+}
+
+TEST_F(RenderSessionManagerTest, NoFramesDeliveredAfterDestroyReturns) {
+    auto cfg = defaultConfig();
+    cfg.targetFps = 60;
+    RenderSessionManager mgr(cfg);
+    mgr.createSession("s1");
+    prepareForFrames(mgr, "s1");
+
+    std::atomic<int> frames{0};
+    mgr.setFrameReadyCallback([&](const std::string&, const std::vector<uint8_t>&,
+                                  uint32_t, uint32_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        frames.fetch_add(1);
+    });
+    mgr.startRenderLoop();
+
+    if (!waitFor([&] { return frames.load() > 0; }, std::chrono::seconds(2))) {
+        mgr.stopRenderLoop();
+        GTEST_SKIP() << "Off-screen rendering produced no frames";
+    }
+
+    // destroySession waits out the in-flight frame, so the count is final
+    EXPECT_TRUE(mgr.destroySession("s1"));
+    int afterDestroy = frames.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(frames.load(), afterDestroy);
+
+    mgr.stopRenderLoop();
+}
+
+TEST_F(RenderSessionManagerTest, RenderLoopStatsTrackCaptureAndDelivery) {
+    auto cfg = defaultConfig();
+    cfg.targetFps = 60;
+    RenderSessionManager mgr(cfg);
+    EXPECT_EQ(mgr.renderLoopStats().framesRendered, 0u);
+
+    mgr.createSession("s1");
+    prepareForFrames(mgr, "s1");
+
+    std::atomic<int> frames{0};
+    mgr.setFrameReadyCallback([&](const std::string&, const std::vector<uint8_t>&,
+                                  uint32_t, uint32_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        frames.fetch_add(1);
+    });
+    mgr.startRenderLoop();
+
+    if (!waitFor([&] { return frames.load() >= 3; }, std::chrono::seconds(2))) {
+        mgr.stopRenderLoop();
+        GTEST_SKIP() << "Off-screen rendering produced no frames";
+    }
+    mgr.stopRenderLoop();
+
+    auto stats = mgr.renderLoopStats();
+    EXPECT_EQ(stats.framesRendered, static_cast<uint64_t>(frames.load()));
+    EXPECT_GE(stats.averageDeliveryMs, 9.0);
+    EXPECT_GE(stats.maxDeliveryMs, stats.averageDeliveryMs);
+    EXPECT_GE(stats.maxCaptureMs, stats.averageCaptureMs);
+    EXPECT_GT(stats.averageCaptureMs, 0.0);
+}
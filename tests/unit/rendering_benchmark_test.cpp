@@ -30,6 +30,10 @@
 #include "core/image_converter.hpp"
 #include "services/flow/vessel_analyzer.hpp"
 #include "services/mpr_renderer.hpp"
+#include "services/render/frame_pipeline.hpp"
+#include "services/render/hemodynamic_overlay_renderer.hpp"
+#include "services/render/render_session_manager.hpp"
+#include "services/render/streamline_overlay_renderer.hpp"
 #include "services/surface_renderer.hpp"
 #include "services/volume_renderer.hpp"
 
@@ -39,7 +43,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vtkImageData.h>
 
 namespace dicom_viewer::services {
 namespace {
@@ -188,5 +200,240 @@ TEST_F(VesselAnalyzerBenchmarkTest, VorticityComputation64Cube) {
     assertWithinThreshold(elapsed, 5000, "Vorticity computation 64^3");
 }
 
+// =============================================================================
+// LIC Overlay Benchmark
+// =============================================================================
+
+/// 256 x 256 x 8 vortex in the XY plane whose strength scales with @p phase
+vtkSmartPointer<vtkImageData> createVortexPhase(int phase) {
+    constexpr int kDim = 256;
+    constexpr int kSlices = 8;
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(kDim, kDim, kSlices);
+    image->SetSpacing(1.0, 1.0, 1.0);
+    image->AllocateScalars(VTK_FLOAT, 3);
+
+    auto* ptr = static_cast<float*>(image->GetScalarPointer());
+    double center = (kDim - 1) / 2.0;
+    double swirl = 1.0 + 0.1 * phase;
+    size_t idx = 0;
+    for (int z = 0; z < kSlices; ++z) {
+        for (int y = 0; y < kDim; ++y) {
+            for (int x = 0; x < kDim; ++x, ++idx) {
+                double dx = x - center;
+                double dy = y - center;
+                ptr[idx * 3] = static_cast<float>(-dy * swirl + dx * 0.05);
+                ptr[idx * 3 + 1] = static_cast<float>(dx * swirl + dy * 0.05);
+                ptr[idx * 3 + 2] = 0.0f;
+            }
+        }
+    }
+    return image;
+}
+
+class LICOverlayBenchmarkTest : public PerformanceBenchmark {};
+
+TEST_F(LICOverlayBenchmarkTest, ComputeLIC256) {
+    auto slice = StreamlineOverlayRenderer::extractSliceVelocity(
+        createVortexPhase(0), MPRPlane::Axial, 4.0);
+    ASSERT_TRUE(slice.has_value());
+
+    std::chrono::milliseconds elapsed;
+    auto texture = measureTimeWithResult(
+        [&] { return StreamlineOverlayRenderer::computeLIC(*slice); }, elapsed);
+
+    ASSERT_TRUE(texture.has_value());
+    assertWithinThreshold(elapsed, 200, "Fast LIC 256x256");
+}
+
+TEST_F(LICOverlayBenchmarkTest, CinePlaybackFromCache) {
+    constexpr int kPhases = 20;
+    std::vector<vtkSmartPointer<vtkImageData>> phases;
+    for (int p = 0; p < kPhases; ++p) {
+        phases.push_back(createVortexPhase(p));
+    }
+
+    StreamlineOverlayRenderer renderer;
+    renderer.setMode(StreamlineOverlayRenderer::Mode::LIC);
+
+    // First cardiac cycle fills the cache
+    for (int p = 0; p < kPhases; ++p) {
+        renderer.setVelocityField(phases[p], p);
+        ASSERT_TRUE(renderer.setSlicePosition(MPRPlane::Axial, 4.0).has_value());
+        renderer.updatePlane(MPRPlane::Axial);
+    }
+
+    // Second cycle must sustain 20+ fps
+    auto elapsed = measureTime([&] {
+        for (int p = 0; p < kPhases; ++p) {
+            renderer.setVelocityField(phases[p], p);
+            renderer.updatePlane(MPRPlane::Axial);
+        }
+    });
+
+    auto stats = renderer.licCacheStats();
+    std::cout << "[BENCHMARK] LIC cache: " << stats.hits << " hits, "
+              << stats.misses << " misses" << std::endl;
+    EXPECT_EQ(stats.hits, static_cast<uint64_t>(kPhases));
+    assertWithinThreshold(elapsed, 1000 * kPhases / 20,
+                          "Cached LIC cine playback, 20 phases");
+}
+
+// =============================================================================
+// Remote Render Session Benchmarks
+// =============================================================================
+
+class RenderSessionBenchmarkTest : public PerformanceBenchmark {
+protected:
+    static constexpr uint32_t kSessions = 8;
+
+    void SetUp() override {
+        auto itkImage = createSyntheticCTVolume(64);
+        vtkImage_ = core::ImageConverter::itkToVtk(itkImage);
+        ASSERT_NE(vtkImage_, nullptr);
+    }
+
+    /// Aggregate frames/second delivered across all sessions over @p window
+    double measureAggregateFps(uint32_t renderThreads,
+                               std::chrono::milliseconds window) {
+        RenderSessionManagerConfig cfg;
+        cfg.maxSessions = kSessions;
+        cfg.targetFps = 240;  // Uncapped in practice: rendering is the bottleneck
+        cfg.defaultWidth = 256;
+        cfg.defaultHeight = 256;
+        cfg.renderThreads = renderThreads;
+        RenderSessionManager mgr(cfg);
+
+        for (uint32_t i = 0; i < kSessions; ++i) {
+            auto id = "bench-" + std::to_string(i);
+            mgr.createSession(id);
+            mgr.loadSessionVolume(id, StudyVolumeKey{"1.2.840.bench", ""},
+                                  [&] { return vtkImage_; });
+            mgr.notifyInteractionStart(id);
+        }
+
+        std::atomic<uint64_t> frames{0};
+        mgr.setFrameReadyCallback([&](const std::string&, const std::vector<uint8_t>&,
+                                      uint32_t, uint32_t) {
+            frames.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        mgr.startRenderLoop();
+        std::this_thread::sleep_for(window);
+        mgr.stopRenderLoop();
+
+        double fps = static_cast<double>(frames.load())
+                   / std::chrono::duration<double>(window).count();
+        std::cout << "[BENCHMARK] " << kSessions << " sessions, "
+                  << mgr.renderWorkerCount() << " render worker(s): "
+                  << fps << " aggregate FPS" << std::endl;
+        return fps;
+    }
+
+    vtkSmartPointer<vtkImageData> vtkImage_;
+};
+
+TEST_F(RenderSessionBenchmarkTest, AggregateFrameRateScalesWithWorkers) {
+    constexpr auto kWindow = std::chrono::milliseconds(2000);
+
+    double serialFps = measureAggregateFps(1, kWindow);
+    if (serialFps == 0.0) {
+        GTEST_SKIP() << "Off-screen rendering produced no frames";
+    }
+    double parallelFps = measureAggregateFps(0, kWindow);
+
+    std::cout << "[BENCHMARK] Render worker speedup: "
+              << parallelFps / serialFps << "x on "
+              << std::thread::hardware_concurrency() << " cores" << std::endl;
+
+    // Workers never lose throughput against the single render thread
+    EXPECT_GE(parallelFps, serialFps * 0.9);
+}
+
+// =============================================================================
+// Frame Pipeline Benchmarks (capture -> encode -> send)
+// =============================================================================
+
+class FramePipelineBenchmarkTest : public PerformanceBenchmark {
+protected:
+    static constexpr uint32_t kSize = 1024;
+    static constexpr int kSessions = 4;
+    static constexpr int kFramesPerSession = 60;  // 2 s of video at 30 FPS
+
+    void SetUp() override {
+        // Distinct frames per index so the encoder cannot reuse work
+        for (int f = 0; f < 4; ++f) {
+            std::vector<uint8_t> rgba(static_cast<size_t>(kSize) * kSize * 4);
+            for (uint32_t y = 0; y < kSize; ++y) {
+                for (uint32_t x = 0; x < kSize; ++x) {
+                    size_t idx = (static_cast<size_t>(y) * kSize + x) * 4;
+                    rgba[idx + 0] = static_cast<uint8_t>((x + f * 37) & 0xFF);
+                    rgba[idx + 1] = static_cast<uint8_t>((y ^ x) & 0xFF);
+                    rgba[idx + 2] = static_cast<uint8_t>((y * 3 + f) & 0xFF);
+                    rgba[idx + 3] = 255;
+                }
+            }
+            frames_.push_back(std::move(rgba));
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> frames_;
+};
+
+TEST_F(FramePipelineBenchmarkTest, FourSessions1024At30Fps) {
+    // Serial baseline: encode and send inline, as the frame callback used to
+    FrameEncoder encoder;
+    auto serial = measureTime([&] {
+        for (int i = 0; i < 10; ++i) {
+            auto data = encoder.encode(frames_[i % frames_.size()].data(),
+                                       kSize, kSize, EncodeFormat::Jpeg, 85);
+            ASSERT_FALSE(data.empty());
+        }
+    });
+    std::cout << "[BENCHMARK] Serial encode 1024x1024: "
+              << serial.count() / 10.0 << " ms/frame" << std::endl;
+
+    // Deep queues so nothing is dropped and elapsed time reflects throughput
+    FramePipelineConfig cfg;
+    cfg.maxQueuedFrames = kFramesPerSession;
+    FramePipeline pipeline(cfg);
+    std::atomic<uint64_t> bytesSent{0};
+    pipeline.setSendCallback([&](const std::string&, const std::vector<uint8_t>& data,
+                                 uint32_t, uint32_t, uint32_t) {
+        bytesSent.fetch_add(data.size(), std::memory_order_relaxed);
+    });
+
+    // Render side submits every session's frame at a 30 FPS cadence
+    auto elapsed = measureTime([&] {
+        auto next = std::chrono::steady_clock::now();
+        for (int f = 0; f < kFramesPerSession; ++f) {
+            for (int s = 0; s < kSessions; ++s) {
+                // Copy stands in for the render worker's freshly captured frame
+                pipeline.submit("session-" + std::to_string(s),
+                                std::vector<uint8_t>(frames_[(f + s) % frames_.size()]),
+                                kSize, kSize);
+            }
+            next += std::chrono::microseconds(33'333);
+            std::this_thread::sleep_until(next);
+        }
+        pipeline.waitIdle();
+    });
+
+    auto stats = pipeline.stats();
+    std::cout << "[BENCHMARK] Pipeline " << kSessions << "x 1024x1024: "
+              << stats.sent << " frames, encode avg " << stats.encode.averageMs
+              << " ms (max " << stats.encode.maxMs << "), queue wait avg "
+              << stats.queueWait.averageMs << " ms, latency avg "
+              << stats.latency.averageMs << " ms (max " << stats.latency.maxMs
+              << "), " << bytesSent.load() / std::max<uint64_t>(1, stats.sent)
+              << " bytes/frame"
+              << std::endl;
+
+    EXPECT_EQ(stats.sent, static_cast<uint64_t>(kSessions * kFramesPerSession));
+    // Keeping up at 30 FPS means the backlog drains shortly after the last submit
+    assertWithinThreshold(elapsed, 2500,
+                          "Pipelined encode+send, 4 sessions 1024x1024 @ 30 FPS");
+}
+
 }  // namespace
 }  // namespace dicom_viewer::services
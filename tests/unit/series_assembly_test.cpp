@@ -29,9 +29,14 @@
 
 #include "core/series_builder.hpp"
 
+#include "../test_utils/dicom_file_generator.hpp"
+
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <vector>
 
 namespace dicom_viewer::core::test {
 
@@ -215,4 +220,113 @@ TEST_F(DicomLoaderTest, LoadEmptySliceVector)
     EXPECT_EQ(result.error().code, DicomError::SeriesAssemblyFailed);
 }
 
+// ============================================================================
+// Progressive (coarse-to-fine) volume building
+// ============================================================================
+class ProgressiveBuildTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        tempDir_ = std::filesystem::temp_directory_path() / "progressive_build_test";
+        std::filesystem::remove_all(tempDir_);
+        test_utils::writeSyntheticCTSeries(tempDir_, 17);
+
+        auto scan = builder_.scanForSeries(tempDir_);
+        ASSERT_TRUE(scan.has_value());
+        ASSERT_EQ(scan->size(), 1u);
+        series_ = scan->front();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(tempDir_);
+    }
+
+    std::filesystem::path tempDir_;
+    SeriesBuilder builder_;
+    SeriesInfo series_;
+};
+
+TEST_F(ProgressiveBuildTest, PublishesCoarseToFinePasses)
+{
+    std::vector<size_t> depths;
+    std::vector<double> zSpacings;
+    size_t reportedPassCount = 0;
+
+    auto future = builder_.buildCTVolumeProgressive(series_,
+        [&](const CTImageType::Pointer& volume, size_t pass, size_t passCount) {
+            EXPECT_EQ(pass, depths.size());
+            reportedPassCount = passCount;
+            depths.push_back(volume->GetLargestPossibleRegion().GetSize()[2]);
+            zSpacings.push_back(volume->GetSpacing()[2]);
+        });
+    auto result = future.get();
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    // 17 slices: stride 8 -> 3, 4 -> 5, 2 -> 9, 1 -> 17
+    EXPECT_EQ(depths, (std::vector<size_t>{3, 5, 9, 17}));
+    EXPECT_EQ(reportedPassCount, 4u);
+    EXPECT_NEAR(zSpacings.front(), 8.0, 1e-9);
+    EXPECT_NEAR(zSpacings.back(), 1.0, 1e-9);
+}
+
+TEST_F(ProgressiveBuildTest, FinalPassMatchesDirectBuild)
+{
+    auto progressive = builder_.buildCTVolumeProgressive(series_, nullptr).get();
+    auto direct = builder_.buildCTVolume(series_);
+    ASSERT_TRUE(progressive.has_value()) << progressive.error().message;
+    ASSERT_TRUE(direct.has_value()) << direct.error().message;
+
+    const auto& a = progressive.value();
+    const auto& b = direct.value();
+    ASSERT_EQ(a->GetLargestPossibleRegion(), b->GetLargestPossibleRegion());
+    EXPECT_EQ(a->GetSpacing(), b->GetSpacing());
+    EXPECT_EQ(a->GetOrigin(), b->GetOrigin());
+
+    const size_t voxels = a->GetLargestPossibleRegion().GetNumberOfPixels();
+    EXPECT_TRUE(std::equal(a->GetBufferPointer(), a->GetBufferPointer() + voxels,
+                           b->GetBufferPointer()));
+}
+
+TEST_F(ProgressiveBuildTest, EarlierPassesAreNotModified)
+{
+    std::vector<CTImageType::Pointer> passes;
+    auto result = builder_.buildCTVolumeProgressive(series_,
+        [&](const CTImageType::Pointer& volume, size_t, size_t) {
+            passes.push_back(volume);
+        }, ProgressiveBuildOptions{4, 2}).get();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(passes.size(), 3u);
+
+    // Pass 0 holds slices 0, 4, 8, 12, 16 (stored value = slice index)
+    const auto& coarse = passes.front();
+    for (long z = 0; z < 5; ++z) {
+        CTImageType::IndexType idx = {{1, 1, z}};
+        EXPECT_EQ(coarse->GetPixel(idx), static_cast<short>(z * 4 - 1024));
+    }
+    EXPECT_NE(passes.front().GetPointer(), passes.back().GetPointer());
+}
+
+TEST_F(ProgressiveBuildTest, ShortSeriesBuildsInSinglePass)
+{
+    SeriesInfo shortSeries = series_;
+    shortSeries.slices.resize(2);
+    shortSeries.sliceCount = 2;
+
+    size_t passes = 0;
+    auto result = builder_.buildCTVolumeProgressive(shortSeries,
+        [&](const CTImageType::Pointer&, size_t, size_t) { ++passes; }).get();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(passes, 1u);
+    EXPECT_EQ(result.value()->GetLargestPossibleRegion().GetSize()[2], 2u);
+}
+
+TEST_F(ProgressiveBuildTest, EmptySeriesFails)
+{
+    SeriesInfo empty;
+    auto result = builder_.buildCTVolumeProgressive(empty, nullptr).get();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, DicomError::SeriesAssemblyFailed);
+}
+
 } // namespace dicom_viewer::core::test
@@ -30,11 +30,17 @@
 #include "services/enhanced_dicom/series_classifier.hpp"
 
 #include "core/series_builder.hpp"
+#include "../test_utils/dicom_file_generator.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <itkMetaDataObject.h>
 
 using namespace dicom_viewer::services;
+using dicom_viewer::core::DicomMetadata;
 using dicom_viewer::core::SeriesInfo;
 using dicom_viewer::core::SliceInfo;
 
@@ -507,3 +513,114 @@ TEST(SeriesClassifierTest, ClassifyScannedSeriesPreservesOrder) {
     EXPECT_EQ(results[0].seriesUid, "uid-1");
     EXPECT_EQ(results[1].seriesUid, "uid-2");
 }
+
+// =============================================================================
+// Header-only and cached classification
+// =============================================================================
+
+namespace {
+
+/// Scan metadata of a Siemens 4D Flow phase series encoded along FH
+DicomMetadata makeScannedFlowMetadata() {
+    DicomMetadata meta;
+    meta.seriesInstanceUid = "1.2.3.flow.fh";
+    meta.seriesDescription = "4D Flow";
+    meta.modality = "MR";
+    meta.imageType = "ORIGINAL\\PRIMARY\\P\\ND";
+    meta.scanningSequence = "GR\\PC";
+    meta.siemensFlowDirection = "v150_FH";
+    meta.hasAcquisitionAttributes = true;
+    return meta;
+}
+
+}  // anonymous namespace
+
+TEST(SeriesClassifierTest, ClassifyMetadataMatchesDictionaryRules) {
+    auto meta = makeScannedFlowMetadata();
+    auto fromMetadata = SeriesClassifier::classifyMetadata(meta);
+
+    auto dict = MockDicomBuilder()
+        .modality(meta.modality)
+        .seriesDescription(meta.seriesDescription)
+        .seriesUid(meta.seriesInstanceUid)
+        .imageType(meta.imageType)
+        .scanningSequence(meta.scanningSequence)
+        .siemensFlowDir(meta.siemensFlowDirection)
+        .build();
+    auto fromDictionary = SeriesClassifier::classify(dict);
+
+    EXPECT_EQ(fromMetadata.type, SeriesType::Flow4D_Phase_FH);
+    EXPECT_EQ(fromMetadata.type, fromDictionary.type);
+    EXPECT_EQ(fromMetadata.seriesUid, fromDictionary.seriesUid);
+    EXPECT_EQ(fromMetadata.description, fromDictionary.description);
+    EXPECT_TRUE(fromMetadata.is4DFlow);
+}
+
+TEST(SeriesClassifierTest, ClassifyScannedSeriesUsesCachedAttributes) {
+    // The slice path does not exist, so a correct result proves the
+    // classifier relied on the scanned header attributes alone
+    SeriesInfo info;
+    info.seriesInstanceUid = "1.2.3.flow.fh";
+    info.metadata = makeScannedFlowMetadata();
+    SliceInfo slice;
+    slice.filePath = "/nonexistent/flow_fh_0001.dcm";
+    info.slices.push_back(slice);
+
+    auto results = SeriesClassifier::classifyScannedSeries({info});
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].type, SeriesType::Flow4D_Phase_FH);
+    EXPECT_EQ(results[0].seriesUid, "1.2.3.flow.fh");
+    EXPECT_TRUE(results[0].is4DFlow);
+}
+
+TEST(SeriesClassifierTest, ClassifyFileReadsHeaderOfSyntheticSlice) {
+    auto dir = std::filesystem::temp_directory_path() / "series_classifier_test";
+    std::filesystem::create_directories(dir);
+    auto path = dir / "ct_slice.dcm";
+
+    dicom_viewer::test_utils::SyntheticSliceSpec spec;
+    spec.seriesDescription = "CHEST CT";
+    ASSERT_TRUE(dicom_viewer::test_utils::writeSyntheticCTSlice(path, spec));
+
+    auto result = SeriesClassifier::classifyFile(path.string());
+    EXPECT_EQ(result.type, SeriesType::CT);
+    EXPECT_EQ(result.seriesUid, spec.seriesInstanceUid);
+    EXPECT_EQ(result.description, "CHEST CT");
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(SeriesClassifierTest, ClassifyStudyParallelPreservesOrder) {
+    auto dir = std::filesystem::temp_directory_path() / "series_classifier_study";
+    std::filesystem::create_directories(dir);
+
+    std::vector<std::string> files;
+    for (int i = 0; i < 12; ++i) {
+        if (i % 3 == 0) {
+            files.push_back((dir / ("missing_" + std::to_string(i))).string());
+            continue;
+        }
+        dicom_viewer::test_utils::SyntheticSliceSpec spec;
+        spec.seriesInstanceUid = "1.2.826.0.1.3680043.8.498.2." + std::to_string(i);
+        auto path = dir / ("series_" + std::to_string(i) + ".dcm");
+        ASSERT_TRUE(dicom_viewer::test_utils::writeSyntheticCTSlice(path, spec));
+        files.push_back(path.string());
+    }
+
+    auto serial = SeriesClassifier::classifyStudy(files, 1);
+    auto parallel = SeriesClassifier::classifyStudy(files, 4);
+    ASSERT_EQ(parallel.size(), files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(parallel[i].type, serial[i].type) << "index " << i;
+        EXPECT_EQ(parallel[i].seriesUid, serial[i].seriesUid) << "index " << i;
+        if (i % 3 == 0) {
+            EXPECT_EQ(parallel[i].type, SeriesType::Unknown);
+        } else {
+            EXPECT_EQ(parallel[i].type, SeriesType::CT);
+            EXPECT_EQ(parallel[i].seriesUid,
+                      "1.2.826.0.1.3680043.8.498.2." + std::to_string(i));
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+}
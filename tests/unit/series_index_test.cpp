@@ -0,0 +1,224 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "core/series_builder.hpp"
+#include "core/series_index.hpp"
+
+#include "../test_utils/dicom_file_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace dicom_viewer::core::test {
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// Test fixture
+// ============================================================================
+class SeriesIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        tempDir_ = fs::temp_directory_path() / "series_index_test";
+        fs::remove_all(tempDir_);
+        fs::create_directories(tempDir_);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tempDir_);
+    }
+
+    fs::path tempDir_;
+};
+
+// ============================================================================
+// load / save
+// ============================================================================
+TEST_F(SeriesIndexTest, LoadWithoutIndexFileReturnsFalse)
+{
+    SeriesIndex index(tempDir_);
+    EXPECT_FALSE(index.load());
+    EXPECT_TRUE(index.entries().empty());
+}
+
+TEST_F(SeriesIndexTest, LoadCorruptIndexReturnsFalse)
+{
+    std::ofstream(tempDir_ / SeriesIndex::kIndexFileName, std::ios::binary)
+        << "DVSI garbage that is not a valid index";
+
+    SeriesIndex index(tempDir_);
+    EXPECT_FALSE(index.load());
+    EXPECT_TRUE(index.entries().empty());
+}
+
+TEST_F(SeriesIndexTest, SaveAndLoadRoundTripsHeaders)
+{
+    test_utils::writeSyntheticCTSeries(tempDir_, 3);
+    std::ofstream(tempDir_ / "readme.txt") << "not dicom";
+
+    SeriesIndex original(tempDir_);
+    original.refresh(2);
+    ASSERT_TRUE(original.save().has_value());
+
+    SeriesIndex reloaded(tempDir_);
+    ASSERT_TRUE(reloaded.load());
+    ASSERT_EQ(reloaded.entries().size(), original.entries().size());
+
+    for (const auto& [name, entry] : original.entries()) {
+        auto it = reloaded.entries().find(name);
+        ASSERT_NE(it, reloaded.entries().end()) << name;
+        EXPECT_EQ(it->second.isImage, entry.isImage);
+        EXPECT_EQ(it->second.fileSize, entry.fileSize);
+        EXPECT_EQ(it->second.modifiedTime, entry.modifiedTime);
+        if (entry.isImage) {
+            const auto& a = entry.header;
+            const auto& b = it->second.header;
+            EXPECT_EQ(a.seriesKey, b.seriesKey);
+            EXPECT_EQ(a.slice.filePath, b.slice.filePath);
+            EXPECT_EQ(a.slice.instanceNumber, b.slice.instanceNumber);
+            EXPECT_EQ(a.slice.imagePosition, b.slice.imagePosition);
+            EXPECT_EQ(a.metadata.seriesInstanceUid, b.metadata.seriesInstanceUid);
+            EXPECT_EQ(a.metadata.patientName, b.metadata.patientName);
+            EXPECT_EQ(a.metadata.rows, b.metadata.rows);
+            EXPECT_DOUBLE_EQ(a.metadata.rescaleIntercept, b.metadata.rescaleIntercept);
+        }
+    }
+    EXPECT_FALSE(reloaded.entries().at("readme.txt").isImage);
+}
+
+// ============================================================================
+// refresh — incremental behavior
+// ============================================================================
+TEST_F(SeriesIndexTest, RefreshParsesOnlyNewOrChangedFiles)
+{
+    auto paths = test_utils::writeSyntheticCTSeries(tempDir_, 4);
+    ASSERT_EQ(paths.size(), 4u);
+
+    SeriesIndex first(tempDir_);
+    auto initial = first.refresh();
+    EXPECT_EQ(initial.parsed, 4u);
+    EXPECT_EQ(initial.reused, 0u);
+    ASSERT_TRUE(first.save().has_value());
+
+    SeriesIndex second(tempDir_);
+    ASSERT_TRUE(second.load());
+    auto unchanged = second.refresh();
+    EXPECT_EQ(unchanged.parsed, 0u);
+    EXPECT_EQ(unchanged.reused, 4u);
+    EXPECT_FALSE(unchanged.changed());
+
+    // Touch one file and remove another
+    fs::last_write_time(paths[0],
+                        fs::last_write_time(paths[0]) + std::chrono::seconds(5));
+    fs::remove(paths[1]);
+
+    auto changed = second.refresh();
+    EXPECT_EQ(changed.parsed, 1u);
+    EXPECT_EQ(changed.reused, 2u);
+    EXPECT_EQ(changed.removed, 1u);
+    EXPECT_EQ(second.entries().size(), 3u);
+}
+
+TEST_F(SeriesIndexTest, RefreshIgnoresIndexFile)
+{
+    test_utils::writeSyntheticCTSeries(tempDir_, 2);
+
+    SeriesIndex index(tempDir_);
+    index.refresh();
+    ASSERT_TRUE(index.save().has_value());
+    index.refresh();
+
+    EXPECT_FALSE(index.entries().contains(SeriesIndex::kIndexFileName));
+}
+
+TEST_F(SeriesIndexTest, GroupBySeriesSeparatesSeries)
+{
+    test_utils::SyntheticSliceSpec other;
+    other.seriesInstanceUid = "1.2.826.0.1.3680043.8.498.1.9";
+    other.seriesNumber = 9;
+    test_utils::writeSyntheticCTSeries(tempDir_, 3);
+    test_utils::writeSyntheticCTSlice(tempDir_ / "other.dcm", other);
+
+    SeriesIndex index(tempDir_);
+    index.refresh();
+    auto groups = index.groupBySeries();
+    ASSERT_EQ(groups.size(), 2u);
+
+    size_t total = 0;
+    for (const auto& [key, headers] : groups) {
+        total += headers.size();
+    }
+    EXPECT_EQ(total, 4u);
+}
+
+// ============================================================================
+// SeriesBuilder integration
+// ============================================================================
+TEST_F(SeriesIndexTest, ScanForSeriesWritesIndexWhenEnabled)
+{
+    test_utils::writeSyntheticCTSeries(tempDir_, 5);
+
+    SeriesBuilder builder;
+    builder.setScanIndexEnabled(true);
+    auto result = builder.scanForSeries(tempDir_);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    ASSERT_EQ(result->size(), 1u);
+    EXPECT_TRUE(fs::exists(tempDir_ / SeriesIndex::kIndexFileName));
+
+    const auto& series = result->front();
+    EXPECT_EQ(series.sliceCount, 5u);
+    EXPECT_EQ(series.modality, "CT");
+    EXPECT_EQ(series.metadata.patientId, "SYN001");
+    EXPECT_EQ(series.dimensions[0], 64u);
+    EXPECT_NEAR(series.sliceSpacing, 1.0, 1e-6);
+
+    // Second scan is served from the index and yields the same result
+    auto again = builder.scanForSeries(tempDir_);
+    ASSERT_TRUE(again.has_value());
+    ASSERT_EQ(again->size(), 1u);
+    EXPECT_EQ(again->front().seriesInstanceUid, series.seriesInstanceUid);
+    EXPECT_EQ(again->front().slices.size(), series.slices.size());
+}
+
+TEST_F(SeriesIndexTest, ScanForSeriesDoesNotWriteIndexByDefault)
+{
+    test_utils::writeSyntheticCTSeries(tempDir_, 2);
+
+    SeriesBuilder builder;
+    auto result = builder.scanForSeries(tempDir_);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE(fs::exists(tempDir_ / SeriesIndex::kIndexFileName));
+}
+
+} // namespace dicom_viewer::core::test
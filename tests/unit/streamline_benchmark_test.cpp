@@ -0,0 +1,162 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "services/flow/flow_visualizer.hpp"
+#include "services/flow/streamline_integrator.hpp"
+
+#include "../test_utils/benchmark_fixture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <itkVectorImage.h>
+#include <vtkPolyData.h>
+
+namespace dicom_viewer::services {
+namespace {
+
+using test_utils::PerformanceBenchmark;
+
+// =============================================================================
+// Streamline generation (native RK45 vs. vtkStreamTracer)
+// =============================================================================
+
+class StreamlineBenchmarkTest : public PerformanceBenchmark {
+protected:
+    static constexpr int kDim = 64;
+    static constexpr int kSeeds = 2000;
+    static constexpr int kMaxSteps = 500;
+
+    /// Helical pipe flow: swirl about the z axis plus parabolic axial flow
+    static VelocityPhase createHelicalPhase(int phaseIndex, double scale) {
+        auto image = VectorImage3D::New();
+        VectorImage3D::SizeType size = {{kDim, kDim, kDim}};
+        VectorImage3D::IndexType start = {{0, 0, 0}};
+        image->SetRegions(VectorImage3D::RegionType(start, size));
+        image->SetNumberOfComponentsPerPixel(3);
+
+        VectorImage3D::SpacingType spacing;
+        spacing[0] = 1.0; spacing[1] = 1.0; spacing[2] = 1.0;
+        image->SetSpacing(spacing);
+
+        VectorImage3D::PointType origin;
+        origin[0] = 0.0; origin[1] = 0.0; origin[2] = 0.0;
+        image->SetOrigin(origin);
+        image->Allocate();
+
+        auto* buffer = image->GetBufferPointer();
+        const double c = (kDim - 1) / 2.0;
+        const double radius = c;
+        for (int z = 0; z < kDim; ++z) {
+            for (int y = 0; y < kDim; ++y) {
+                for (int x = 0; x < kDim; ++x) {
+                    size_t idx = x + kDim * (y + static_cast<size_t>(kDim) * z);
+                    double dx = x - c;
+                    double dy = y - c;
+                    double frac = std::max(0.0, 1.0 - (dx * dx + dy * dy) / (radius * radius));
+                    buffer[idx * 3]     = static_cast<float>(-dy * scale);
+                    buffer[idx * 3 + 1] = static_cast<float>(dx * scale);
+                    buffer[idx * 3 + 2] = static_cast<float>(50.0 * frac * scale);
+                }
+            }
+        }
+
+        VelocityPhase phase;
+        phase.velocityField = image;
+        phase.phaseIndex = phaseIndex;
+        phase.triggerTime = phaseIndex * 40.0;
+        return phase;
+    }
+
+    std::chrono::milliseconds timeStreamlines(StreamlineEngine engine, size_t threads) {
+        FlowVisualizer viz;
+        EXPECT_TRUE(viz.setVelocityField(createHelicalPhase(0, 1.0)).has_value());
+
+        StreamlineParams params;
+        params.maxSeedPoints = kSeeds;
+        params.maxSteps = kMaxSteps;
+        params.engine = engine;
+        params.threadCount = threads;
+
+        std::chrono::milliseconds elapsed{0};
+        auto result = measureTimeWithResult(
+            [&] { return viz.generateStreamlines(params); }, elapsed);
+        EXPECT_TRUE(result.has_value());
+        if (result) {
+            EXPECT_GT(result.value()->GetNumberOfPoints(), 0);
+        }
+        return elapsed;
+    }
+};
+
+TEST_F(StreamlineBenchmarkTest, NativeVersusVTKStreamTracer) {
+    auto vtkElapsed = timeStreamlines(StreamlineEngine::VTK, 1);
+    auto nativeElapsed = timeStreamlines(StreamlineEngine::Native, 0);
+
+    std::cout << "[BENCHMARK] Streamlines " << kSeeds << " seeds on " << kDim
+              << "^3: vtkStreamTracer " << vtkElapsed.count() << "ms, native "
+              << nativeElapsed.count() << "ms" << std::endl;
+
+    // The native engine must never lose to the single-threaded VTK tracer
+    EXPECT_LE(nativeElapsed.count(), vtkElapsed.count() + 50);
+}
+
+TEST_F(StreamlineBenchmarkTest, NativeThreadScaling) {
+    for (size_t threads : {1u, 4u, 16u}) {
+        auto elapsed = timeStreamlines(StreamlineEngine::Native, threads);
+        std::cout << "[BENCHMARK] Native streamlines, " << threads
+                  << " thread(s): " << elapsed.count() << "ms" << std::endl;
+    }
+}
+
+TEST_F(StreamlineBenchmarkTest, PathlinesAcross20Phases) {
+    std::vector<VelocityPhase> phases;
+    for (int p = 0; p < 20; ++p) {
+        phases.push_back(createHelicalPhase(p, 0.5 + 0.5 * std::sin(p * 0.3)));
+    }
+
+    FlowVisualizer viz;
+    ASSERT_TRUE(viz.setVelocityField(phases.front()).has_value());
+
+    PathlineParams params;
+    params.maxSeedPoints = 1000;
+
+    std::chrono::milliseconds elapsed{0};
+    auto result = measureTimeWithResult(
+        [&] { return viz.generatePathlines(phases, params); }, elapsed);
+    ASSERT_TRUE(result.has_value());
+    assertWithinThreshold(elapsed, 5000, "Pathlines 1000 seeds x 20 phases");
+}
+
+}  // namespace
+}  // namespace dicom_viewer::services
@@ -0,0 +1,312 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include <itkVectorImage.h>
+
+#include "services/flow/streamline_integrator.hpp"
+
+using namespace dicom_viewer::services;
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+/// Create a phase on a dim³ grid (1 mm spacing) with velocity f(x, y, z)
+VelocityPhase createFieldPhase(int dim, const std::function<Vec3(double, double, double)>& f,
+                               int phaseIndex = 0, double triggerTime = 0.0) {
+    auto image = VectorImage3D::New();
+    VectorImage3D::SizeType size = {{
+        static_cast<VectorImage3D::SizeValueType>(dim),
+        static_cast<VectorImage3D::SizeValueType>(dim),
+        static_cast<VectorImage3D::SizeValueType>(dim)
+    }};
+    VectorImage3D::IndexType start = {{0, 0, 0}};
+    image->SetRegions(VectorImage3D::RegionType(start, size));
+    image->SetNumberOfComponentsPerPixel(3);
+
+    VectorImage3D::SpacingType spacing;
+    spacing[0] = 1.0; spacing[1] = 1.0; spacing[2] = 1.0;
+    image->SetSpacing(spacing);
+
+    VectorImage3D::PointType origin;
+    origin[0] = 0.0; origin[1] = 0.0; origin[2] = 0.0;
+    image->SetOrigin(origin);
+
+    image->Allocate();
+
+    auto* buffer = image->GetBufferPointer();
+    for (int z = 0; z < dim; ++z) {
+        for (int y = 0; y < dim; ++y) {
+            for (int x = 0; x < dim; ++x) {
+                int idx = x + dim * (y + dim * z);
+                auto v = f(x, y, z);
+                buffer[idx * 3]     = static_cast<float>(v[0]);
+                buffer[idx * 3 + 1] = static_cast<float>(v[1]);
+                buffer[idx * 3 + 2] = static_cast<float>(v[2]);
+            }
+        }
+    }
+
+    VelocityPhase phase;
+    phase.velocityField = image;
+    phase.phaseIndex = phaseIndex;
+    phase.triggerTime = triggerTime;
+    return phase;
+}
+
+VelocityPhase createUniformPhase(int dim, double vx, int phaseIndex = 0,
+                                 double triggerTime = 0.0) {
+    return createFieldPhase(
+        dim, [vx](double, double, double) { return Vec3{vx, 0.0, 0.0}; },
+        phaseIndex, triggerTime);
+}
+
+/// Solid-body rotation about the axis x = y = center
+VelocityPhase createVortexPhase(int dim) {
+    double c = (dim - 1) / 2.0;
+    return createFieldPhase(dim, [c](double x, double y, double) {
+        return Vec3{-(y - c), x - c, 1.0};
+    });
+}
+
+}  // anonymous namespace
+
+// =============================================================================
+// SampledVelocityField tests
+// =============================================================================
+
+TEST(SampledVelocityFieldTest, FromPhase_NullField) {
+    auto field = SampledVelocityField::fromPhase(VelocityPhase{});
+    ASSERT_FALSE(field.has_value());
+    EXPECT_EQ(field.error().code, FlowError::Code::InvalidInput);
+}
+
+TEST(SampledVelocityFieldTest, TrilinearIsExactForLinearField) {
+    auto phase = createFieldPhase(8, [](double x, double y, double z) {
+        return Vec3{x, 2.0 * y, x + y - 3.0 * z};
+    });
+    auto field = SampledVelocityField::fromPhase(phase);
+    ASSERT_TRUE(field.has_value());
+
+    Vec3 v;
+    ASSERT_TRUE(field->sample({2.25, 3.5, 4.75}, v));
+    EXPECT_NEAR(v[0], 2.25, 1e-5);
+    EXPECT_NEAR(v[1], 7.0, 1e-5);
+    EXPECT_NEAR(v[2], 2.25 + 3.5 - 14.25, 1e-5);
+
+    // Upper grid boundary is inside
+    ASSERT_TRUE(field->sample({7.0, 7.0, 7.0}, v));
+    EXPECT_NEAR(v[0], 7.0, 1e-5);
+}
+
+TEST(SampledVelocityFieldTest, OutsideReturnsFalse) {
+    auto field = SampledVelocityField::fromPhase(createUniformPhase(8, 1.0));
+    ASSERT_TRUE(field.has_value());
+
+    Vec3 v;
+    EXPECT_FALSE(field->sample({-0.1, 1.0, 1.0}, v));
+    EXPECT_FALSE(field->sample({1.0, 7.1, 1.0}, v));
+
+    auto bounds = field->bounds();
+    EXPECT_DOUBLE_EQ(bounds[0], 0.0);
+    EXPECT_DOUBLE_EQ(bounds[1], 7.0);
+    EXPECT_DOUBLE_EQ(field->minSpacing(), 1.0);
+}
+
+// =============================================================================
+// Streamline tests
+// =============================================================================
+
+TEST(StreamlineIntegratorTest, UniformFlowSpansField) {
+    auto field = SampledVelocityField::fromPhase(createUniformPhase(16, 10.0));
+    ASSERT_TRUE(field.has_value());
+
+    auto lines = traceStreamlines(*field, {{7.5, 4.0, 4.0}});
+    ASSERT_EQ(lines.size(), 1u);
+    const auto& points = lines[0].points;
+    ASSERT_GE(points.size(), 2u);
+
+    // Both directions run to the x boundaries along a straight line
+    EXPECT_LT(points.front()[0], 1.0);
+    EXPECT_GT(points.back()[0], 14.0);
+    for (const auto& p : points) {
+        EXPECT_NEAR(p[1], 4.0, 1e-9);
+        EXPECT_NEAR(p[2], 4.0, 1e-9);
+    }
+    EXPECT_EQ(lines[0].velocities.size(), points.size());
+}
+
+TEST(StreamlineIntegratorTest, SeedOutsideOrSlowYieldsEmptyLine) {
+    auto field = SampledVelocityField::fromPhase(createUniformPhase(8, 0.05));
+    ASSERT_TRUE(field.has_value());
+
+    auto lines = traceStreamlines(*field, {{-5.0, 1.0, 1.0}, {3.0, 3.0, 3.0}});
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_TRUE(lines[0].points.empty());
+    EXPECT_TRUE(lines[1].points.empty());  // 0.05 cm/s < terminal speed
+}
+
+TEST(StreamlineIntegratorTest, AdaptiveRK45FollowsVortex) {
+    auto field = SampledVelocityField::fromPhase(createVortexPhase(32));
+    ASSERT_TRUE(field.has_value());
+
+    StreamlineIntegrationOptions options;
+    options.bothDirections = false;
+    options.maxSteps = 500;
+    options.maxPropagation = 200.0;
+    auto lines = traceStreamlines(*field, {{21.5, 15.5, 2.0}}, options);
+    ASSERT_GE(lines[0].points.size(), 10u);
+
+    // Helix around the axis: in-plane radius is preserved
+    for (const auto& p : lines[0].points) {
+        double r = std::hypot(p[0] - 15.5, p[1] - 15.5);
+        EXPECT_NEAR(r, 6.0, 0.01);
+    }
+}
+
+TEST(StreamlineIntegratorTest, FixedStepRK4FollowsVortex) {
+    auto field = SampledVelocityField::fromPhase(createVortexPhase(32));
+    ASSERT_TRUE(field.has_value());
+
+    StreamlineIntegrationOptions options;
+    options.adaptiveStep = false;
+    options.bothDirections = false;
+    options.stepLength = 0.25;
+    options.maxSteps = 400;
+    auto lines = traceStreamlines(*field, {{21.5, 15.5, 2.0}}, options);
+    ASSERT_EQ(lines[0].points.size(), 401u);  // Seed + one point per step
+
+    for (const auto& p : lines[0].points) {
+        double r = std::hypot(p[0] - 15.5, p[1] - 15.5);
+        EXPECT_NEAR(r, 6.0, 0.01);
+    }
+}
+
+TEST(StreamlineIntegratorTest, ResultsIndependentOfThreadCount) {
+    auto field = SampledVelocityField::fromPhase(createVortexPhase(24));
+    ASSERT_TRUE(field.has_value());
+
+    std::vector<Vec3> seeds;
+    for (int i = 0; i < 64; ++i) {
+        seeds.push_back({4.0 + (i % 8) * 2.0, 4.0 + (i / 8) * 2.0, 3.0});
+    }
+
+    StreamlineIntegrationOptions options;
+    options.maxSteps = 200;
+    options.threadCount = 1;
+    auto serial = traceStreamlines(*field, seeds, options);
+    options.threadCount = 4;
+    auto parallel = traceStreamlines(*field, seeds, options);
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t s = 0; s < seeds.size(); ++s) {
+        EXPECT_EQ(serial[s].points, parallel[s].points) << "seed " << s;
+    }
+}
+
+// =============================================================================
+// Pathline tests
+// =============================================================================
+
+TEST(PathlineIntegratorTest, UniformFlowDisplacement) {
+    // 10 cm/s = 0.1 mm/ms; 80 ms across three phases → 8 mm
+    std::vector<VelocityPhase> phases;
+    for (int p = 0; p < 3; ++p) {
+        phases.push_back(createUniformPhase(20, 10.0, p, p * 40.0));
+    }
+    PhaseProvider provider = [&](int i) -> std::expected<VelocityPhase, FlowError> {
+        return phases[i];
+    };
+
+    auto lines = tracePathlines(provider, 3, {{2.0, 5.0, 5.0}});
+    ASSERT_TRUE(lines.has_value());
+    const auto& line = (*lines)[0];
+    ASSERT_GE(line.points.size(), 3u);
+    EXPECT_NEAR(line.points.back()[0], 10.0, 1e-6);
+    EXPECT_NEAR(line.points.back()[1], 5.0, 1e-9);
+    EXPECT_FLOAT_EQ(line.times.front(), 0.0f);
+    EXPECT_FLOAT_EQ(line.times.back(), 80.0f);
+
+    // Steps never exceed half a voxel
+    for (size_t i = 1; i < line.points.size(); ++i) {
+        EXPECT_LE(line.points[i][0] - line.points[i - 1][0], 0.5 + 1e-9);
+    }
+}
+
+TEST(PathlineIntegratorTest, InterpolatesBetweenPhases) {
+    // Velocity ramps linearly 10 → 20 cm/s over 40 ms: mean 15 → 6 mm
+    std::vector<VelocityPhase> phases = {createUniformPhase(20, 10.0, 0, 0.0),
+                                         createUniformPhase(20, 20.0, 1, 40.0)};
+    PhaseProvider provider = [&](int i) -> std::expected<VelocityPhase, FlowError> {
+        return phases[i];
+    };
+
+    auto lines = tracePathlines(provider, 2, {{2.0, 5.0, 5.0}});
+    ASSERT_TRUE(lines.has_value());
+    EXPECT_NEAR((*lines)[0].points.back()[0], 8.0, 1e-6);
+}
+
+TEST(PathlineIntegratorTest, LoadsEachPhaseOnceInOrder) {
+    std::vector<int> requested;
+    PhaseProvider provider = [&](int i) -> std::expected<VelocityPhase, FlowError> {
+        requested.push_back(i);
+        return createUniformPhase(12, 5.0, i, i * 30.0);
+    };
+
+    auto lines = tracePathlines(provider, 4, {{1.0, 1.0, 1.0}, {2.0, 2.0, 2.0}});
+    ASSERT_TRUE(lines.has_value());
+    EXPECT_EQ(requested, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST(PathlineIntegratorTest, NonIncreasingTriggerTimeFails) {
+    PhaseProvider provider = [](int i) -> std::expected<VelocityPhase, FlowError> {
+        return createUniformPhase(8, 5.0, i, 0.0);
+    };
+    auto lines = tracePathlines(provider, 2, {{1.0, 1.0, 1.0}});
+    ASSERT_FALSE(lines.has_value());
+    EXPECT_EQ(lines.error().code, FlowError::Code::InvalidInput);
+}
+
+TEST(PathlineIntegratorTest, ProviderErrorPropagates) {
+    PhaseProvider provider = [](int i) -> std::expected<VelocityPhase, FlowError> {
+        if (i == 1) {
+            return std::unexpected(FlowError{FlowError::Code::InternalError, "load"});
+        }
+        return createUniformPhase(8, 5.0, i, 0.0);
+    };
+    auto lines = tracePathlines(provider, 3, {{1.0, 1.0, 1.0}});
+    ASSERT_FALSE(lines.has_value());
+    EXPECT_EQ(lines.error().code, FlowError::Code::InternalError);
+}
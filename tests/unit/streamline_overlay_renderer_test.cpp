@@ -449,6 +449,165 @@ TEST(StreamlineOverlayRendererTest, ComputeLICReproducible) {
     }
 }
 
+TEST(StreamlineOverlayRendererTest, ComputeLICThreadCountInvariant) {
+    auto field = createVortexVelocityField(48);
+    auto sliceResult = StreamlineOverlayRenderer::extractSliceVelocity(
+        field, MPRPlane::Axial, 24.0);
+    ASSERT_TRUE(sliceResult.has_value());
+
+    LICParams params;
+    params.threadCount = 1;
+    auto serial = StreamlineOverlayRenderer::computeLIC(*sliceResult, params);
+    params.threadCount = 4;
+    auto parallel = StreamlineOverlayRenderer::computeLIC(*sliceResult, params);
+    ASSERT_TRUE(serial.has_value());
+    ASSERT_TRUE(parallel.has_value());
+
+    auto* p1 = static_cast<unsigned char*>((*serial)->GetScalarPointer());
+    auto* p2 = static_cast<unsigned char*>((*parallel)->GetScalarPointer());
+    for (int i = 0; i < 48 * 48; ++i) {
+        ASSERT_EQ(p1[i], p2[i]) << "pixel " << i;
+    }
+}
+
+TEST(StreamlineOverlayRendererTest, ComputeLICSmoothsAlongFlow) {
+    // Horizontal flow: texture correlates along rows, not across them
+    auto field = createUniformVelocityField(64, 64, 4, 10.0, 0.0, 0.0);
+    auto sliceResult = StreamlineOverlayRenderer::extractSliceVelocity(
+        field, MPRPlane::Axial, 2.0);
+    ASSERT_TRUE(sliceResult.has_value());
+
+    auto result = StreamlineOverlayRenderer::computeLIC(*sliceResult);
+    ASSERT_TRUE(result.has_value());
+    auto* ptr = static_cast<unsigned char*>((*result)->GetScalarPointer());
+
+    double alongFlow = 0.0;
+    double acrossFlow = 0.0;
+    for (int y = 0; y < 63; ++y) {
+        for (int x = 0; x < 63; ++x) {
+            int i = y * 64 + x;
+            alongFlow += std::abs(ptr[i + 1] - ptr[i]);
+            acrossFlow += std::abs(ptr[i + 64] - ptr[i]);
+        }
+    }
+    EXPECT_LT(alongFlow * 3.0, acrossFlow);
+}
+
+// =============================================================================
+// LIC Texture Cache
+// =============================================================================
+
+TEST(StreamlineOverlayRendererTest, LICCacheDefaultState) {
+    StreamlineOverlayRenderer renderer;
+    auto stats = renderer.licCacheStats();
+    EXPECT_EQ(stats.entries, 0u);
+    EXPECT_GT(stats.capacity, 0u);
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(renderer.phaseIndex(), 0);
+}
+
+TEST(StreamlineOverlayRendererTest, LICCacheReusesRevisitedPhase) {
+    StreamlineOverlayRenderer renderer;
+    renderer.setMode(StreamlineOverlayRenderer::Mode::LIC);
+    auto phase0 = createVortexVelocityField(16);
+    auto phase1 = createUniformVelocityField(16, 16, 16, 5.0, 5.0, 0.0);
+
+    renderer.setVelocityField(phase0, 0);
+    ASSERT_TRUE(renderer.setSlicePosition(MPRPlane::Axial, 8.0).has_value());
+    renderer.updatePlane(MPRPlane::Axial);
+    renderer.setVelocityField(phase1, 1);
+    EXPECT_EQ(renderer.phaseIndex(), 1);
+    renderer.updatePlane(MPRPlane::Axial);
+    renderer.setVelocityField(phase0, 0);
+    renderer.updatePlane(MPRPlane::Axial);
+
+    auto stats = renderer.licCacheStats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.entries, 2u);
+
+    // A nearby world position that maps to the same voxel slice also hits
+    ASSERT_TRUE(renderer.setSlicePosition(MPRPlane::Axial, 8.2).has_value());
+    renderer.updatePlane(MPRPlane::Axial);
+    EXPECT_EQ(renderer.licCacheStats().hits, 2u);
+
+    // A different slice is a new texture
+    ASSERT_TRUE(renderer.setSlicePosition(MPRPlane::Axial, 4.0).has_value());
+    renderer.updatePlane(MPRPlane::Axial);
+    EXPECT_EQ(renderer.licCacheStats().misses, 3u);
+}
+
+TEST(StreamlineOverlayRendererTest, LICCacheInvalidation) {
+    StreamlineOverlayRenderer renderer;
+    renderer.setMode(StreamlineOverlayRenderer::Mode::LIC);
+    renderer.setVelocityField(createVortexVelocityField(16), 3);
+    ASSERT_TRUE(renderer.setSlicePosition(MPRPlane::Axial, 8.0).has_value());
+    renderer.updatePlane(MPRPlane::Axial);
+    EXPECT_EQ(renderer.licCacheStats().entries, 1u);
+
+    // New LIC parameters invalidate cached textures
+    LICParams params;
+    params.kernelLength = 8;
+    renderer.setLICParams(params);
+    EXPECT_EQ(renderer.licCacheStats().entries, 0u);
+
+    renderer.updatePlane(MPRPlane::Axial);
+    EXPECT_EQ(renderer.licCacheStats().entries, 1u);
+
+    // A field without a phase index starts a new dataset
+    renderer.setVelocityField(createVortexVelocityField(16));
+    EXPECT_EQ(renderer.phaseIndex(), 0);
+    EXPECT_EQ(renderer.licCacheStats().entries, 0u);
+
+    renderer.updatePlane(MPRPlane::Axial);
+    renderer.clearLICCache();
+    EXPECT_EQ(renderer.licCacheStats().entries, 0u);
+}
+
+TEST(StreamlineOverlayRendererTest, LICCacheEvictsLeastRecentlyUsed) {
+    StreamlineOverlayRenderer renderer;
+    renderer.setMode(StreamlineOverlayRenderer::Mode::LIC);
+    renderer.setLICCacheCapacity(2);
+    auto field = createVortexVelocityField(16);
+
+    for (int phase : {0, 1, 0, 2}) {
+        renderer.setVelocityField(field, phase);
+        ASSERT_TRUE(renderer.setSlicePosition(MPRPlane::Axial, 8.0).has_value());
+        renderer.updatePlane(MPRPlane::Axial);
+    }
+    // Phase 1 was least recently used when phase 2 arrived
+    EXPECT_EQ(renderer.licCacheStats().entries, 2u);
+    EXPECT_EQ(renderer.licCacheStats().hits, 1u);
+
+    renderer.setVelocityField(field, 0);
+    renderer.updatePlane(MPRPlane::Axial);
+    EXPECT_EQ(renderer.licCacheStats().hits, 2u);
+    renderer.setVelocityField(field, 1);
+    renderer.updatePlane(MPRPlane::Axial);
+    EXPECT_EQ(renderer.licCacheStats().misses, 4u);
+
+    // Capacity 0 disables caching
+    renderer.setLICCacheCapacity(0);
+    EXPECT_EQ(renderer.licCacheStats().entries, 0u);
+    renderer.updatePlane(MPRPlane::Axial);
+    EXPECT_EQ(renderer.licCacheStats().entries, 0u);
+}
+
+TEST(StreamlineOverlayRendererTest, StreamlineModeBypassesLICCache) {
+    StreamlineOverlayRenderer renderer;
+    Streamline2DParams params;
+    params.numSeedPoints = 16;
+    renderer.setStreamlineParams(params);
+    renderer.setVelocityField(createVortexVelocityField(16), 0);
+    ASSERT_TRUE(renderer.setSlicePosition(MPRPlane::Axial, 8.0).has_value());
+    renderer.updatePlane(MPRPlane::Axial);
+
+    auto stats = renderer.licCacheStats();
+    EXPECT_EQ(stats.entries, 0u);
+    EXPECT_EQ(stats.hits + stats.misses, 0u);
+}
+
 // =============================================================================
 // OverlayType Enum Integration
 // =============================================================================
@@ -0,0 +1,519 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include "core/series_index.hpp"
+#include "services/render/render_session_manager.hpp"
+#include "services/render/study_load_job_queue.hpp"
+
+#include "../test_utils/dicom_file_generator.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+using namespace dicom_viewer::services;
+
+namespace {
+
+vtkSmartPointer<vtkImageData> makeVolume()
+{
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(8, 8, 8);
+    image->AllocateScalars(VTK_SHORT, 1);
+    return image;
+}
+
+/// Blocks loaders until released, so tests control what is running
+class Gate {
+public:
+    void wait()
+    {
+        std::unique_lock lock(mutex_);
+        ++waiting_;
+        cv_.notify_all();
+        cv_.wait(lock, [this]() { return open_; });
+    }
+
+    void waitForWaiter()
+    {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this]() { return waiting_ > 0; });
+    }
+
+    void open()
+    {
+        std::lock_guard lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int waiting_ = 0;
+    bool open_ = false;
+};
+
+bool waitForState(const StudyLoadJobQueue& queue, const std::string& jobId,
+                  LoadJobState state)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto status = queue.status(jobId);
+        if (status && status->state == state) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+LoadJobRequest request(const std::string& sessionId, const std::string& seriesUid,
+                       LoadJobPriority priority = LoadJobPriority::Interactive)
+{
+    LoadJobRequest req;
+    req.sessionId = sessionId;
+    req.studyInstanceUid = "1.2.840.1";
+    req.seriesInstanceUid = seriesUid;
+    req.priority = priority;
+    return req;
+}
+
+} // anonymous namespace
+
+class StudyLoadJobQueueTest : public ::testing::Test {
+protected:
+    RenderSessionManagerConfig sessionConfig()
+    {
+        RenderSessionManagerConfig cfg;
+        cfg.maxSessions = 4;
+        cfg.defaultWidth = 64;
+        cfg.defaultHeight = 64;
+        return cfg;
+    }
+
+    StudyLoadJobConfig singleWorker()
+    {
+        StudyLoadJobConfig cfg;
+        cfg.workerCount = 1;
+        return cfg;
+    }
+};
+
+// =============================================================================
+// Job lifecycle
+// =============================================================================
+
+TEST_F(StudyLoadJobQueueTest, CompletedJobAttachesVolumeToSession) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+    queue.setVolumeLoader([](const LoadJobRequest&, const StudyLoadJobQueue::ProgressReporter& report) {
+        report(0.5, "Decoding");
+        return makeVolume();
+    });
+
+    auto jobId = queue.submit(request("s1", "1.2.840.1.1"));
+    ASSERT_TRUE(jobId.has_value());
+    ASSERT_TRUE(waitForState(queue, *jobId, LoadJobState::Completed));
+
+    auto status = queue.status(*jobId);
+    EXPECT_DOUBLE_EQ(status->progress, 1.0);
+    EXPECT_EQ(status->sessionId, "s1");
+    ASSERT_NE(sessions.sessionVolume("s1"), nullptr);
+    EXPECT_EQ(sessions.sessionVolume("s1")->key.seriesInstanceUid, "1.2.840.1.1");
+}
+
+TEST_F(StudyLoadJobQueueTest, LoaderFailureMarksJobFailed) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+    queue.setVolumeLoader([](const LoadJobRequest&, const StudyLoadJobQueue::ProgressReporter&) {
+        return vtkSmartPointer<vtkImageData>();
+    });
+
+    auto jobId = queue.submit(request("s1", "1.2.840.1.1"));
+    ASSERT_TRUE(jobId.has_value());
+    EXPECT_TRUE(waitForState(queue, *jobId, LoadJobState::Failed));
+    EXPECT_EQ(sessions.sessionVolume("s1"), nullptr);
+}
+
+TEST_F(StudyLoadJobQueueTest, UnknownJobHasNoStatus) {
+    RenderSessionManager sessions(sessionConfig());
+    StudyLoadJobQueue queue(sessions);
+    EXPECT_FALSE(queue.status("load-missing").has_value());
+    EXPECT_FALSE(queue.cancel("load-missing"));
+}
+
+TEST_F(StudyLoadJobQueueTest, ProgressCallbackSeesEveryTransition) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+
+    std::mutex mutex;
+    std::vector<LoadJobState> states;
+    queue.setProgressCallback([&](const LoadJobStatus& status) {
+        std::lock_guard lock(mutex);
+        if (states.empty() || states.back() != status.state) {
+            states.push_back(status.state);
+        }
+    });
+    queue.setVolumeLoader([](const LoadJobRequest&, const StudyLoadJobQueue::ProgressReporter& report) {
+        report(0.5, "Decoding");
+        return makeVolume();
+    });
+
+    auto jobId = queue.submit(request("s1", "1.2.840.1.1"));
+    ASSERT_TRUE(waitForState(queue, *jobId, LoadJobState::Completed));
+    queue.stop();
+
+    std::lock_guard lock(mutex);
+    ASSERT_EQ(states.size(), 3u);
+    EXPECT_EQ(states[0], LoadJobState::Queued);
+    EXPECT_EQ(states[1], LoadJobState::Running);
+    EXPECT_EQ(states[2], LoadJobState::Completed);
+}
+
+// =============================================================================
+// Scheduling
+// =============================================================================
+
+TEST_F(StudyLoadJobQueueTest, InteractiveJobsRunBeforePrefetch) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+
+    Gate gate;
+    std::mutex mutex;
+    std::vector<std::string> order;
+    queue.setVolumeLoader([&](const LoadJobRequest& req, const StudyLoadJobQueue::ProgressReporter&) {
+        if (req.seriesInstanceUid == "blocker") {
+            gate.wait();
+        }
+        std::lock_guard lock(mutex);
+        order.push_back(req.seriesInstanceUid);
+        return makeVolume();
+    });
+
+    auto blocker = queue.submit(request("s1", "blocker"));
+    gate.waitForWaiter();
+
+    auto prefetch = queue.submit(request("s1", "prefetch", LoadJobPriority::Prefetch));
+    auto interactive = queue.submit(request("s1", "interactive"));
+    EXPECT_EQ(queue.queuedCount(), 2u);
+    gate.open();
+
+    ASSERT_TRUE(waitForState(queue, *prefetch, LoadJobState::Completed));
+    ASSERT_TRUE(waitForState(queue, *interactive, LoadJobState::Completed));
+
+    std::lock_guard lock(mutex);
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], "blocker");
+    EXPECT_EQ(order[1], "interactive");
+    EXPECT_EQ(order[2], "prefetch");
+}
+
+TEST_F(StudyLoadJobQueueTest, FullQueueRejectsSubmission) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    auto cfg = singleWorker();
+    cfg.maxQueuedJobs = 1;
+    StudyLoadJobQueue queue(sessions, cfg);
+
+    Gate gate;
+    queue.setVolumeLoader([&](const LoadJobRequest&, const StudyLoadJobQueue::ProgressReporter&) {
+        gate.wait();
+        return makeVolume();
+    });
+
+    ASSERT_TRUE(queue.submit(request("s1", "a")).has_value());
+    gate.waitForWaiter();
+    EXPECT_TRUE(queue.submit(request("s1", "b")).has_value());
+    EXPECT_FALSE(queue.submit(request("s1", "c")).has_value());
+    gate.open();
+}
+
+// =============================================================================
+// Cancellation
+// =============================================================================
+
+TEST_F(StudyLoadJobQueueTest, CancelQueuedJobSkipsLoader) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+
+    Gate gate;
+    std::atomic<int> loads{0};
+    queue.setVolumeLoader([&](const LoadJobRequest& req, const StudyLoadJobQueue::ProgressReporter&) {
+        if (req.seriesInstanceUid == "blocker") {
+            gate.wait();
+        }
+        ++loads;
+        return makeVolume();
+    });
+
+    auto blocker = queue.submit(request("s1", "blocker"));
+    gate.waitForWaiter();
+    auto queued = queue.submit(request("s1", "queued"));
+
+    EXPECT_TRUE(queue.cancel(*queued));
+    EXPECT_FALSE(queue.cancel(*queued));
+    EXPECT_EQ(queue.status(*queued)->state, LoadJobState::Cancelled);
+    EXPECT_EQ(queue.queuedCount(), 0u);
+
+    gate.open();
+    ASSERT_TRUE(waitForState(queue, *blocker, LoadJobState::Completed));
+    EXPECT_EQ(loads.load(), 1);
+}
+
+TEST_F(StudyLoadJobQueueTest, DestroyingSessionCancelsRunningJob) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+    sessions.setSessionDestroyedCallback([&](const std::string& id) {
+        queue.cancelSession(id);
+    });
+
+    std::atomic<bool> started{false};
+    queue.setVolumeLoader([&](const LoadJobRequest&, const StudyLoadJobQueue::ProgressReporter& report) {
+        started = true;
+        // Simulate a long decode that polls for cancellation
+        for (int i = 0; i < 1000; ++i) {
+            if (!report(i / 1000.0, "Decoding")) {
+                return vtkSmartPointer<vtkImageData>();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return makeVolume();
+    });
+
+    auto jobId = queue.submit(request("s1", "1.2.840.1.1"));
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    sessions.destroySession("s1");
+    EXPECT_TRUE(waitForState(queue, *jobId, LoadJobState::Cancelled));
+    sessions.setSessionDestroyedCallback(nullptr);
+}
+
+TEST_F(StudyLoadJobQueueTest, CancelDoesNotFailOtherSessionWaitingOnSameSeries) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    sessions.createSession("s2");
+    StudyLoadJobQueue queue(sessions, StudyLoadJobConfig{});
+
+    std::atomic<int> calls{0};
+    queue.setVolumeLoader([&](const LoadJobRequest&, const StudyLoadJobQueue::ProgressReporter& report) {
+        if (calls++ == 0) {
+            // First decode polls until its job is cancelled
+            while (report(0.1, "Decoding")) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            return vtkSmartPointer<vtkImageData>();
+        }
+        return makeVolume();
+    });
+
+    auto first = queue.submit(request("s1", "1.2.840.1.1"));
+    while (calls.load() == 0) {
+        std::this_thread::yield();
+    }
+    auto second = queue.submit(request("s2", "1.2.840.1.1"));
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+
+    // s2 is now waiting on s1's in-flight decode
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (sessions.volumeCache().stats().hits == 0
+           && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_TRUE(queue.cancel(*first));
+    EXPECT_TRUE(waitForState(queue, *first, LoadJobState::Cancelled));
+    ASSERT_TRUE(waitForState(queue, *second, LoadJobState::Completed))
+        << queue.status(*second)->message;
+    EXPECT_EQ(calls.load(), 2);
+    EXPECT_NE(sessions.sessionVolume("s2"), nullptr);
+    EXPECT_EQ(sessions.sessionVolume("s1"), nullptr);
+}
+
+TEST_F(StudyLoadJobQueueTest, StopCancelsPendingJobsAndRejectsNewOnes) {
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+
+    Gate gate;
+    queue.setVolumeLoader([&](const LoadJobRequest& req, const StudyLoadJobQueue::ProgressReporter&) {
+        if (req.seriesInstanceUid == "blocker") {
+            gate.wait();
+        }
+        return makeVolume();
+    });
+
+    queue.submit(request("s1", "blocker"));
+    gate.waitForWaiter();
+    auto pending = queue.submit(request("s1", "pending"));
+
+    std::thread opener([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        gate.open();
+    });
+    queue.stop();
+    opener.join();
+
+    EXPECT_EQ(queue.status(*pending)->state, LoadJobState::Cancelled);
+    EXPECT_FALSE(queue.submit(request("s1", "late")).has_value());
+}
+
+// =============================================================================
+// Default scan/decode pipeline
+// =============================================================================
+
+TEST_F(StudyLoadJobQueueTest, DefaultPipelineLoadsLargestSeriesOfStudy) {
+    const auto dir = std::filesystem::temp_directory_path() / "study_load_job_queue_test";
+    std::filesystem::remove_all(dir);
+
+    dicom_viewer::test_utils::SyntheticSliceSpec spec;
+    spec.rows = 16;
+    spec.columns = 16;
+    spec.seriesInstanceUid = "1.2.826.0.1.3680043.8.498.1.1";
+    dicom_viewer::test_utils::writeSyntheticCTSeries(dir / "a", 4, spec);
+    spec.seriesInstanceUid = "1.2.826.0.1.3680043.8.498.1.2";
+    spec.seriesNumber = 2;
+    dicom_viewer::test_utils::writeSyntheticCTSeries(dir / "b", 6, spec);
+
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+
+    LoadJobRequest req;
+    req.sessionId = "s1";
+    req.studyInstanceUid = spec.studyInstanceUid;
+    req.sourceDirectory = dir;
+    auto jobId = queue.submit(req);
+    ASSERT_TRUE(jobId.has_value());
+    ASSERT_TRUE(waitForState(queue, *jobId, LoadJobState::Completed))
+        << queue.status(*jobId)->message;
+
+    EXPECT_EQ(queue.status(*jobId)->seriesInstanceUid, spec.seriesInstanceUid);
+    auto volume = sessions.sessionVolume("s1");
+    ASSERT_NE(volume, nullptr);
+    int dims[3];
+    volume->image->GetDimensions(dims);
+    EXPECT_EQ(dims[0], 16);
+    EXPECT_EQ(dims[1], 16);
+    EXPECT_EQ(dims[2], 6);
+
+    // The scan index is persisted so the next load skips unchanged headers
+    EXPECT_TRUE(std::filesystem::exists(
+        dir / dicom_viewer::core::SeriesIndex::kIndexFileName));
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(StudyLoadJobQueueTest, DefaultPipelineLoadsNamedSeries) {
+    const auto dir = std::filesystem::temp_directory_path() / "study_load_job_queue_named";
+    std::filesystem::remove_all(dir);
+
+    dicom_viewer::test_utils::SyntheticSliceSpec spec;
+    spec.rows = 16;
+    spec.columns = 16;
+    spec.seriesInstanceUid = "1.2.826.0.1.3680043.8.498.2.1";
+    dicom_viewer::test_utils::writeSyntheticCTSeries(dir / "a", 4, spec);
+    const std::string namedUid = spec.seriesInstanceUid;
+    spec.seriesInstanceUid = "1.2.826.0.1.3680043.8.498.2.2";
+    spec.seriesNumber = 2;
+    dicom_viewer::test_utils::writeSyntheticCTSeries(dir / "b", 6, spec);
+
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    sessions.createSession("s2");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+
+    // Request the smaller series by its DICOM Series Instance UID
+    LoadJobRequest req;
+    req.sessionId = "s1";
+    req.studyInstanceUid = spec.studyInstanceUid;
+    req.seriesInstanceUid = namedUid;
+    req.sourceDirectory = dir;
+    auto jobId = queue.submit(req);
+    ASSERT_TRUE(jobId.has_value());
+    ASSERT_TRUE(waitForState(queue, *jobId, LoadJobState::Completed))
+        << queue.status(*jobId)->message;
+
+    EXPECT_EQ(queue.status(*jobId)->seriesInstanceUid, namedUid);
+    auto volume = sessions.sessionVolume("s1");
+    ASSERT_NE(volume, nullptr);
+    EXPECT_EQ(volume->key.seriesInstanceUid, namedUid);
+    int dims[3];
+    volume->image->GetDimensions(dims);
+    EXPECT_EQ(dims[2], 4);
+
+    // A second session naming the same series is served from the cache
+    req.sessionId = "s2";
+    auto second = queue.submit(req);
+    ASSERT_TRUE(second.has_value());
+    ASSERT_TRUE(waitForState(queue, *second, LoadJobState::Completed));
+    EXPECT_EQ(sessions.sessionVolume("s2"), volume);
+    EXPECT_EQ(sessions.volumeCache().stats().misses, 1u);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(StudyLoadJobQueueTest, DefaultPipelineFailsForUnknownStudy) {
+    const auto dir = std::filesystem::temp_directory_path() / "study_load_job_queue_missing";
+    std::filesystem::remove_all(dir);
+    dicom_viewer::test_utils::writeSyntheticCTSeries(dir, 2);
+
+    RenderSessionManager sessions(sessionConfig());
+    sessions.createSession("s1");
+    StudyLoadJobQueue queue(sessions, singleWorker());
+
+    LoadJobRequest req;
+    req.sessionId = "s1";
+    req.studyInstanceUid = "9.9.9";
+    req.sourceDirectory = dir;
+    auto jobId = queue.submit(req);
+    ASSERT_TRUE(jobId.has_value());
+    EXPECT_TRUE(waitForState(queue, *jobId, LoadJobState::Failed));
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,224 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include "services/render/study_volume_cache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+using namespace dicom_viewer::services;
+
+namespace {
+
+/// 16x16x16 short volume = 8192 bytes of scalars
+vtkSmartPointer<vtkImageData> makeVolume(int edge = 16)
+{
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(edge, edge, edge);
+    image->AllocateScalars(VTK_SHORT, 1);
+    return image;
+}
+
+StudyVolumeKey key(const std::string& uid, const std::string& processing = {})
+{
+    return StudyVolumeKey{uid, processing};
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Hit / miss behaviour
+// =============================================================================
+
+TEST(StudyVolumeCacheTest, MissInvokesLoaderOnceThenHits) {
+    StudyVolumeCache cache(0);
+    int loads = 0;
+    auto loader = [&]() { ++loads; return makeVolume(); };
+
+    auto first = cache.getOrLoad(key("1.2.3"), loader);
+    auto second = cache.getOrLoad(key("1.2.3"), loader);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->image, second->image);
+    EXPECT_EQ(loads, 1);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.residentBytes, 16u * 16u * 16u * sizeof(short));
+}
+
+TEST(StudyVolumeCacheTest, ProcessingParametersAreSeparateEntries) {
+    StudyVolumeCache cache(0);
+    auto raw = cache.getOrLoad(key("1.2.3"), [] { return makeVolume(); });
+    auto resampled = cache.getOrLoad(key("1.2.3", "iso=1.0"), [] { return makeVolume(8); });
+    ASSERT_NE(raw, nullptr);
+    ASSERT_NE(resampled, nullptr);
+    EXPECT_NE(raw->image, resampled->image);
+    EXPECT_EQ(cache.stats().entries, 2u);
+}
+
+TEST(StudyVolumeCacheTest, FailedLoadIsNotCached) {
+    StudyVolumeCache cache(0);
+    EXPECT_EQ(cache.getOrLoad(key("bad"), [] { return vtkSmartPointer<vtkImageData>(); }),
+              nullptr);
+    EXPECT_EQ(cache.getOrLoad(key("bad"), []() -> vtkSmartPointer<vtkImageData> {
+                  throw std::runtime_error("decode failed");
+              }),
+              nullptr);
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.find(key("bad")), nullptr);
+}
+
+TEST(StudyVolumeCacheTest, ConcurrentRequestsShareSingleLoad) {
+    StudyVolumeCache cache(0);
+    std::atomic<int> loads{0};
+    auto loader = [&]() {
+        ++loads;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return makeVolume();
+    };
+
+    std::vector<CachedVolumeHandle> results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i]() { results[i] = cache.getOrLoad(key("1.2.3"), loader); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(loads.load(), 1);
+    for (const auto& r : results) {
+        ASSERT_NE(r, nullptr);
+        EXPECT_EQ(r->image, results.front()->image);
+    }
+}
+
+TEST(StudyVolumeCacheTest, AbortedLoadHandsKeyToWaiter) {
+    StudyVolumeCache cache(0);
+    std::atomic<bool> aborterStarted{false};
+    std::atomic<bool> releaseAborter{false};
+
+    std::thread aborter([&]() {
+        EXPECT_THROW(cache.getOrLoad(key("1.2.3"), [&]() -> vtkSmartPointer<vtkImageData> {
+                         aborterStarted = true;
+                         while (!releaseAborter) {
+                             std::this_thread::yield();
+                         }
+                         throw StudyVolumeLoadAborted("cancelled");
+                     }),
+                     StudyVolumeLoadAborted);
+    });
+    while (!aborterStarted) {
+        std::this_thread::yield();
+    }
+
+    CachedVolumeHandle waited;
+    std::thread waiter([&]() {
+        waited = cache.getOrLoad(key("1.2.3"), [] { return makeVolume(); });
+    });
+    // The waiter joins the in-flight load (counted as a hit) before the abort
+    while (cache.stats().hits == 0) {
+        std::this_thread::yield();
+    }
+    releaseAborter = true;
+
+    aborter.join();
+    waiter.join();
+    ASSERT_NE(waited, nullptr);
+    EXPECT_EQ(cache.find(key("1.2.3")), waited);
+}
+
+// =============================================================================
+// Budget and LRU eviction
+// =============================================================================
+
+TEST(StudyVolumeCacheTest, EvictsLeastRecentlyUsedUnheldVolume) {
+    const uint64_t volumeBytes = 16 * 16 * 16 * sizeof(short);
+    StudyVolumeCache cache(2 * volumeBytes);
+
+    cache.getOrLoad(key("a"), [] { return makeVolume(); });
+    cache.getOrLoad(key("b"), [] { return makeVolume(); });
+    cache.find(key("a"));  // "b" is now least recently used
+    cache.getOrLoad(key("c"), [] { return makeVolume(); });
+
+    EXPECT_NE(cache.find(key("a")), nullptr);
+    EXPECT_EQ(cache.find(key("b")), nullptr);
+    EXPECT_NE(cache.find(key("c")), nullptr);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_LE(cache.stats().residentBytes, 2 * volumeBytes);
+}
+
+TEST(StudyVolumeCacheTest, HeldVolumesAreNotEvicted) {
+    const uint64_t volumeBytes = 16 * 16 * 16 * sizeof(short);
+    StudyVolumeCache cache(volumeBytes);
+
+    auto held = cache.getOrLoad(key("a"), [] { return makeVolume(); });
+    auto other = cache.getOrLoad(key("b"), [] { return makeVolume(); });
+
+    // Both are in use: the budget is exceeded rather than dropping them
+    EXPECT_EQ(cache.stats().entries, 2u);
+    EXPECT_EQ(cache.stats().evictions, 0u);
+
+    other.reset();
+    cache.setBudget(volumeBytes);
+    EXPECT_EQ(cache.find(key("b")), nullptr);
+    EXPECT_EQ(cache.find(key("a")), held);
+}
+
+TEST(StudyVolumeCacheTest, HandleOutlivesErase) {
+    StudyVolumeCache cache(0);
+    auto handle = cache.getOrLoad(key("a"), [] { return makeVolume(); });
+    EXPECT_TRUE(cache.erase(key("a")));
+    EXPECT_FALSE(cache.erase(key("a")));
+    ASSERT_NE(handle, nullptr);
+    EXPECT_NE(handle->image->GetScalarPointer(), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.stats().residentBytes, 0u);
+}
+
+TEST(StudyVolumeCacheTest, ImageSizeBytes) {
+    EXPECT_EQ(StudyVolumeCache::imageSizeBytes(nullptr), 0u);
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(4, 5, 6);
+    image->AllocateScalars(VTK_FLOAT, 2);
+    EXPECT_EQ(StudyVolumeCache::imageSizeBytes(image), 4u * 5u * 6u * 2u * sizeof(float));
+}
@@ -29,10 +29,21 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+#include <vtkImageData.h>
+
 #include "services/flow/temporal_navigator.hpp"
 
+#include "../test_utils/flow_phantom_generator.hpp"
+
 using namespace dicom_viewer::services;
 
 namespace {
@@ -54,6 +65,85 @@ auto createMockLoader(int maxPhases) {
     };
 }
 
+/// Mock loader that sleeps and counts calls, for prefetch timing tests
+auto createSlowLoader(int maxPhases, std::chrono::milliseconds delay,
+                      std::shared_ptr<std::atomic<int>> calls) {
+    return [maxPhases, delay, calls](int phaseIndex)
+               -> std::expected<VelocityPhase, FlowError> {
+        calls->fetch_add(1);
+        std::this_thread::sleep_for(delay);
+        return createMockLoader(maxPhases)(phaseIndex);
+    };
+}
+
+/// Phase indices passed to a loader, in call order
+struct LoadLog {
+    std::mutex mutex;
+    std::vector<int> phases;
+
+    bool contains(int phase) {
+        std::lock_guard lock(mutex);
+        return std::find(phases.begin(), phases.end(), phase) != phases.end();
+    }
+};
+
+/// Mock loader that records each phase after it has been produced
+auto createRecordingLoader(int maxPhases, std::shared_ptr<LoadLog> log) {
+    return [maxPhases, log](int phaseIndex)
+               -> std::expected<VelocityPhase, FlowError> {
+        auto result = createMockLoader(maxPhases)(phaseIndex);
+        std::lock_guard lock(log->mutex);
+        log->phases.push_back(phaseIndex);
+        return result;
+    };
+}
+
+/// Loader returning phases with a real 8x8x4 velocity field and magnitude
+auto createImageLoader() {
+    return [](int phaseIndex) -> std::expected<VelocityPhase, FlowError> {
+        VelocityPhase phase;
+        phase.phaseIndex = phaseIndex;
+        phase.triggerTime = phaseIndex * 40.0;
+
+        VectorImage3D::SizeType size = {{8, 8, 4}};
+        VectorImage3D::RegionType region;
+        region.SetSize(size);
+
+        auto field = VectorImage3D::New();
+        field->SetRegions(region);
+        field->SetNumberOfComponentsPerPixel(3);
+        field->Allocate();
+        auto magnitude = FloatImage3D::New();
+        magnitude->SetRegions(region);
+        magnitude->Allocate();
+
+        float* v = field->GetBufferPointer();
+        float* m = magnitude->GetBufferPointer();
+        for (size_t i = 0; i < 8 * 8 * 4; ++i) {
+            v[i * 3 + 0] = static_cast<float>(i % 200) - 100.0f + 0.3f * phaseIndex;
+            v[i * 3 + 1] = 0.37f * static_cast<float>(i % 50);
+            v[i * 3 + 2] = -0.11f * static_cast<float>(i % 90);
+            m[i] = static_cast<float>(i);
+        }
+        phase.velocityField = field;
+        phase.magnitudeImage = magnitude;
+        return phase;
+    };
+}
+
+/// Poll until @p predicate holds or two seconds pass
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
 }  // anonymous namespace
 
 // =============================================================================
@@ -163,6 +253,37 @@ TEST(PhaseCacheTest, LRUTouchReorders) {
     EXPECT_TRUE(cache.isCached(3));
 }
 
+TEST(PhaseCacheTest, PeekOrLoadLeavesWindowUntouched) {
+    PhaseCache cache(3);
+    cache.setPhaseLoader(createMockLoader(20));
+
+    (void)cache.getPhase(0);
+    (void)cache.getPhase(1);
+    (void)cache.getPhase(2);
+    auto before = cache.getStatus();
+
+    // Uncached phase is loaded but not inserted
+    auto loaded = cache.peekOrLoad(7);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->phaseIndex, 7);
+    EXPECT_FALSE(cache.isCached(7));
+
+    // Cached phase is served without becoming most recently used
+    auto cached = cache.peekOrLoad(0);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->phaseIndex, 0);
+
+    auto after = cache.getStatus();
+    EXPECT_EQ(after.hitCount, before.hitCount);
+    EXPECT_EQ(after.missCount, before.missCount);
+
+    // Phase 0 is still the oldest entry
+    (void)cache.getPhase(3);
+    EXPECT_FALSE(cache.isCached(0));
+    EXPECT_TRUE(cache.isCached(1));
+    EXPECT_TRUE(cache.isCached(2));
+}
+
 TEST(PhaseCacheTest, GetCachedPhases) {
     PhaseCache cache(5);
     cache.setPhaseLoader(createMockLoader(20));
@@ -206,6 +327,158 @@ TEST(PhaseCacheTest, Status) {
     EXPECT_GT(status.memoryUsageBytes, 0);
 }
 
+TEST(PhaseCacheTest, HitAndMissCounters) {
+    PhaseCache cache(5);
+    cache.setPhaseLoader(createMockLoader(20));
+
+    (void)cache.getPhase(0);
+    (void)cache.getPhase(0);
+    (void)cache.getPhase(1);
+
+    auto status = cache.getStatus();
+    EXPECT_EQ(status.missCount, 2u);
+    EXPECT_EQ(status.hitCount, 1u);
+    EXPECT_EQ(status.prefetchCount, 0u);
+    EXPECT_GE(status.averageLoadTimeMs, 0.0);
+}
+
+TEST(PhaseCacheTest, PrefetchLoadsInBackground) {
+    PhaseCache cache(5);
+    cache.setPhaseLoader(createMockLoader(20));
+
+    cache.prefetch({1, 2});
+    ASSERT_TRUE(waitFor([&] { return cache.isCached(1) && cache.isCached(2); }));
+
+    auto phase = cache.getPhase(1);
+    ASSERT_TRUE(phase.has_value());
+    EXPECT_EQ(phase->phaseIndex, 1);
+
+    auto status = cache.getStatus();
+    EXPECT_EQ(status.prefetchCount, 2u);
+    EXPECT_EQ(status.prefetchHitCount, 1u);
+    EXPECT_EQ(status.hitCount, 1u);
+    EXPECT_EQ(status.missCount, 0u);
+    EXPECT_EQ(status.prefetchDepth, 2);
+}
+
+TEST(PhaseCacheTest, ConcurrentRequestsShareOneLoad) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    PhaseCache cache(5);
+    cache.setPhaseLoader(
+        createSlowLoader(20, std::chrono::milliseconds(50), calls));
+
+    cache.prefetch({4});
+    std::vector<std::thread> readers;
+    std::atomic<int> successes{0};
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            auto phase = cache.getPhase(4);
+            if (phase && phase->phaseIndex == 4) {
+                successes.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(successes.load(), 4);
+    EXPECT_EQ(calls->load(), 1);
+}
+
+TEST(PhaseCacheTest, PrefetchSkipsCachedPhases) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    PhaseCache cache(5);
+    cache.setPhaseLoader(createSlowLoader(20, std::chrono::milliseconds(0), calls));
+
+    (void)cache.getPhase(3);
+    cache.prefetch({3});
+    EXPECT_EQ(calls->load(), 1);
+    EXPECT_EQ(cache.getStatus().prefetchCount, 0u);
+}
+
+TEST(PhaseCacheTest, NonStandardLoaderExceptionIsReported) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    PhaseCache cache(5);
+    cache.setPhaseLoader([calls](int) -> std::expected<VelocityPhase, FlowError> {
+        calls->fetch_add(1);
+        throw 42;
+    });
+
+    // The prefetch thread must survive the throw rather than terminate
+    cache.prefetch({1});
+    ASSERT_TRUE(waitFor([&] { return calls->load() == 1; }));
+
+    auto result = cache.getPhase(1);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, FlowError::Code::InternalError);
+    EXPECT_FALSE(cache.isCached(1));
+    EXPECT_EQ(calls->load(), 2);
+}
+
+TEST(PhaseCacheTest, MemoryUsageCountsPixelBytes) {
+    PhaseCache cache(5);
+    cache.setPhaseLoader(createImageLoader());
+
+    (void)cache.getPhase(0);
+    auto status = cache.getStatus();
+    EXPECT_EQ(status.storageFormat, PhaseStorageFormat::Float32);
+    EXPECT_GE(status.memoryUsageBytes, 8u * 8u * 4u * 4u * sizeof(float));
+    EXPECT_DOUBLE_EQ(status.velocityErrorBound, 0.0);
+    EXPECT_EQ(cache.getCompactPhase(0), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(cache.getStatus().memoryUsageBytes, 0u);
+}
+
+TEST(PhaseCacheTest, CompactStorageHalvesMemory) {
+    PhaseCache full(5);
+    full.setPhaseLoader(createImageLoader());
+    PhaseCache compact(5);
+    compact.setPhaseLoader(createImageLoader());
+    compact.setStorageFormat(PhaseStorageFormat::QuantizedInt16, 150.0);
+    EXPECT_EQ(compact.storageFormat(), PhaseStorageFormat::QuantizedInt16);
+
+    for (int i = 0; i < 3; ++i) {
+        (void)full.getPhase(i);
+        (void)compact.getPhase(i);
+    }
+
+    auto fullStatus = full.getStatus();
+    auto compactStatus = compact.getStatus();
+    EXPECT_EQ(compactStatus.storageFormat, PhaseStorageFormat::QuantizedInt16);
+    EXPECT_LT(compactStatus.memoryUsageBytes * 10, fullStatus.memoryUsageBytes * 6);
+    EXPECT_NEAR(compactStatus.velocityErrorBound, 150.0 / 32767.0 / 2.0, 1e-6);
+}
+
+TEST(PhaseCacheTest, CompactHitDecodesWithinErrorBound) {
+    PhaseCache cache(5);
+    cache.setPhaseLoader(createImageLoader());
+    cache.setStorageFormat(PhaseStorageFormat::Float16);
+
+    auto loaded = cache.getPhase(2);  // miss: loader output
+    auto cached = cache.getPhase(2);  // hit: decoded from float16
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_TRUE(cached.has_value());
+    ASSERT_TRUE(cached->velocityField);
+    ASSERT_TRUE(cached->magnitudeImage);
+    EXPECT_EQ(cached->phaseIndex, 2);
+    EXPECT_EQ(cache.getStatus().hitCount, 1u);
+
+    auto compact = cache.getCompactPhase(2);
+    ASSERT_NE(compact, nullptr);
+    const double bound = compact->velocityErrorBound();
+    EXPECT_DOUBLE_EQ(cache.getStatus().velocityErrorBound, bound);
+
+    const float* original = loaded->velocityField->GetBufferPointer();
+    const float* decoded = cached->velocityField->GetBufferPointer();
+    for (size_t i = 0; i < 8 * 8 * 4 * 3; ++i) {
+        ASSERT_NEAR(decoded[i], original[i], bound);
+    }
+    const auto voxel = compact->velocityAt(5);
+    EXPECT_FLOAT_EQ(voxel[0], decoded[15]);
+}
+
 // =============================================================================
 // TemporalNavigator construction tests
 // =============================================================================
@@ -471,3 +744,137 @@ TEST(TemporalNavigatorTest, CacheStatusCallback) {
     EXPECT_EQ(lastStatus.cachedCount, 1);
     EXPECT_EQ(lastStatus.totalPhases, 10);
 }
+
+TEST(TemporalNavigatorTest, PhaseStorageFormatSurvivesInitialize) {
+    TemporalNavigator nav;
+    nav.setPhaseStorageFormat(PhaseStorageFormat::QuantizedInt16, 100.0);
+    nav.initialize(10, 40.0, 5);
+    nav.setPhaseLoader(createImageLoader());
+
+    ASSERT_TRUE(nav.goToPhase(1).has_value());
+    auto status = nav.cacheStatus();
+    EXPECT_EQ(status.storageFormat, PhaseStorageFormat::QuantizedInt16);
+    EXPECT_GT(status.velocityErrorBound, 0.0);
+}
+
+// =============================================================================
+// Playback prefetch
+// =============================================================================
+
+TEST(TemporalNavigatorTest, PlaybackPrefetchesAheadWithWraparound) {
+    auto log = std::make_shared<LoadLog>();
+    TemporalNavigator nav;
+    nav.initialize(6, 40.0, 4);
+    nav.setPhaseLoader(createRecordingLoader(6, log));
+
+    ASSERT_TRUE(nav.goToPhase(5).has_value());
+    nav.play(15.0);
+    ASSERT_TRUE(waitFor([&] { return log->contains(0); }));
+
+    // Phase 0 follows phase 5 when looping and was loaded in the background
+    auto next = nav.tick();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->phaseIndex, 0);
+    EXPECT_EQ(nav.cacheStatus().prefetchHitCount, 1u);
+}
+
+TEST(TemporalNavigatorTest, PlaybackPrefetchFollowsDirection) {
+    auto log = std::make_shared<LoadLog>();
+    TemporalNavigator nav;
+    nav.initialize(6, 40.0, 4);
+    nav.setPhaseLoader(createRecordingLoader(6, log));
+
+    ASSERT_TRUE(nav.goToPhase(3).has_value());
+    nav.play(15.0);
+    ASSERT_TRUE(nav.previousPhase().has_value());  // now at 2, moving backward
+    ASSERT_TRUE(waitFor([&] { return log->contains(1); }));
+
+    auto prev = nav.previousPhase();
+    ASSERT_TRUE(prev.has_value());
+    EXPECT_EQ(prev->phaseIndex, 1);
+    EXPECT_EQ(nav.cacheStatus().prefetchHitCount, 1u);
+}
+
+TEST(TemporalNavigatorTest, NoPrefetchWhenNotPlaying) {
+    TemporalNavigator nav;
+    nav.initialize(6, 40.0, 4);
+    nav.setPhaseLoader(createMockLoader(6));
+
+    ASSERT_TRUE(nav.goToPhase(2).has_value());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto status = nav.cacheStatus();
+    EXPECT_EQ(status.cachedCount, 1);
+    EXPECT_EQ(status.prefetchCount, 0u);
+}
+
+TEST(TemporalNavigatorTest, PrefetchDepthAdaptsToLoadTimeAndRate) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    TemporalNavigator nav;
+    nav.initialize(20, 40.0, 10);
+    nav.setPhaseLoader(createSlowLoader(20, std::chrono::milliseconds(30), calls));
+
+    // No load measured yet: one phase ahead
+    nav.play(30.0);
+    EXPECT_EQ(nav.prefetchDepth(), 1);
+
+    nav.pause();
+    ASSERT_TRUE(nav.goToPhase(0).has_value());
+    const int slowDepth = nav.prefetchDepth();
+    EXPECT_GE(slowDepth, 2);
+
+    nav.setPlaybackSpeed(4.0);
+    const int fastDepth = nav.prefetchDepth();
+    EXPECT_GT(fastDepth, slowDepth);
+    EXPECT_LE(fastDepth, 9);  // window minus the displayed phase
+}
+
+TEST(TemporalNavigatorTest, PrefetchDepthZeroForSinglePhaseWindow) {
+    TemporalNavigator nav;
+    nav.initialize(10, 40.0, 1);
+    EXPECT_EQ(nav.prefetchDepth(), 0);
+}
+
+// =============================================================================
+// Overlay precomputation
+// =============================================================================
+
+TEST(TemporalNavigatorTest, OverlayFieldDeliveredOnPhaseChange) {
+    auto phases = dicom_viewer::test_utils::generatePulsatileFlow(8, 4, 50.0, 30.0, 40.0).first;
+
+    TemporalNavigator nav;
+    EXPECT_FALSE(nav.overlayPrecomputeStatus().has_value());
+    nav.initialize(4, 40.0, 4);
+    nav.enableOverlayPrecompute(HemodynamicFieldType::VelocityMagnitude);
+
+    std::vector<int> delivered;
+    vtkSmartPointer<vtkImageData> lastField;
+    nav.setOverlayFieldCallback([&](int phase, vtkSmartPointer<vtkImageData> field) {
+        delivered.push_back(phase);
+        lastField = field;
+    });
+
+    // The background pass starts once phases can be loaded
+    nav.setPhaseLoader([&phases](int index) -> std::expected<VelocityPhase, FlowError> {
+        return phases.at(static_cast<size_t>(index));
+    });
+    ASSERT_TRUE(nav.goToPhase(2).has_value());
+    ASSERT_EQ(delivered, std::vector<int>{2});
+    ASSERT_NE(lastField, nullptr);
+    const float expected = std::abs(phases[2].velocityField->GetBufferPointer()[2]);
+    EXPECT_NEAR(static_cast<float*>(lastField->GetScalarPointer())[8 * 8 + 3], expected, 1e-2f);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (nav.overlayPrecomputeStatus()->running
+           && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto status = nav.overlayPrecomputeStatus();
+    ASSERT_TRUE(status.has_value());
+    EXPECT_EQ(status->totalPhases, 4);
+    EXPECT_EQ(status->computedCount, 4);
+
+    nav.disableOverlayPrecompute();
+    EXPECT_FALSE(nav.overlayPrecomputeStatus().has_value());
+    ASSERT_TRUE(nav.goToPhase(3).has_value());
+    EXPECT_EQ(delivered.size(), 1u);
+}
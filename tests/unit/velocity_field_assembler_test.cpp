@@ -30,6 +30,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <filesystem>
+#include <format>
 
 #include <itkImage.h>
 #include <itkImageRegionIterator.h>
@@ -37,6 +39,7 @@
 
 #include "services/flow/flow_dicom_types.hpp"
 #include "services/flow/velocity_field_assembler.hpp"
+#include "../test_utils/dicom_file_generator.hpp"
 
 using namespace dicom_viewer::services;
 
@@ -292,3 +295,204 @@ TEST(VENCScalingTest, Unsigned10BitRange) {
     v = VelocityFieldAssembler::applyVENCScaling(1023.0f, 150.0, 1023, false);
     EXPECT_FLOAT_EQ(v, 150.0f);
 }
+
+TEST(VENCScalingTest, RescaledRangeMapsCentreAndBounds) {
+    // 12-bit unsigned, slope 2, intercept -4096: range [-4096, 4096]
+    EXPECT_FLOAT_EQ(
+        VelocityFieldAssembler::applyVENCScaling(-4096.0f, 100.0, -4096.0, 4096.0), -100.0f);
+    EXPECT_FLOAT_EQ(
+        VelocityFieldAssembler::applyVENCScaling(0.0f, 100.0, -4096.0, 4096.0), 0.0f);
+    EXPECT_FLOAT_EQ(
+        VelocityFieldAssembler::applyVENCScaling(4096.0f, 100.0, -4096.0, 4096.0), 100.0f);
+
+    // Range not centred on 0: [1000, 3000] → centre 2000
+    EXPECT_FLOAT_EQ(
+        VelocityFieldAssembler::applyVENCScaling(2500.0f, 80.0, 1000.0, 3000.0), 40.0f);
+
+    // Empty range
+    EXPECT_FLOAT_EQ(
+        VelocityFieldAssembler::applyVENCScaling(10.0f, 80.0, 5.0, 5.0), 0.0f);
+}
+
+// =============================================================================
+// Parallel single-pass assembly from synthetic DICOM slices
+// =============================================================================
+
+namespace {
+
+using dicom_viewer::test_utils::SyntheticSliceSpec;
+using dicom_viewer::test_utils::writeSyntheticCTSlice;
+
+constexpr int kSlices = 4;
+constexpr int kSize = 8;
+constexpr double kSliceSpacing = 2.0;
+
+/// Writes constant-valued 16-bit signed slice stacks for each component
+class VelocityAssemblyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tempDir_ = std::filesystem::temp_directory_path() / "velocity_field_assembler_test";
+        std::filesystem::remove_all(tempDir_);
+        std::filesystem::create_directories(tempDir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(tempDir_);
+    }
+
+    std::vector<std::string> writeStack(const std::string& name, short value,
+                                        SyntheticSliceSpec spec = unscaledSpec()) {
+        std::vector<std::string> files;
+        spec.rows = kSize;
+        spec.columns = kSize;
+        spec.sliceThickness = kSliceSpacing;
+        spec.pixelValue = value;
+        for (int z = 0; z < kSlices; ++z) {
+            spec.instanceNumber = z + 1;
+            spec.zPosition = z * kSliceSpacing;
+            auto path = tempDir_ / std::format("{}_{:02d}.dcm", name, z);
+            EXPECT_TRUE(writeSyntheticCTSlice(path, spec));
+            files.push_back(path.string());
+        }
+        return files;
+    }
+
+    static SyntheticSliceSpec unscaledSpec() {
+        SyntheticSliceSpec spec;
+        spec.rescaleIntercept = 0.0;
+        return spec;
+    }
+
+    /// Phase p stores Vx = 16384 * (p + 1) / 2, Vy = -8192, Vz = 0
+    FlowSeriesInfo writeSeries(int phaseCount) {
+        FlowSeriesInfo info;
+        info.phaseCount = phaseCount;
+        info.temporalResolution = 40.0;
+        info.venc = {150.0, 200.0, 100.0};
+        info.isSignedPhase = true;
+        info.frameMatrix.resize(phaseCount);
+        for (int p = 0; p < phaseCount; ++p) {
+            auto& phase = info.frameMatrix[p];
+            auto vx = static_cast<short>(16384 * (p + 1) / 2);
+            phase[VelocityComponent::Vx] = writeStack(std::format("p{}_vx", p), vx);
+            phase[VelocityComponent::Vy] = writeStack(std::format("p{}_vy", p), -8192);
+            phase[VelocityComponent::Vz] = writeStack(std::format("p{}_vz", p), 0);
+            phase[VelocityComponent::Magnitude] =
+                writeStack(std::format("p{}_mag", p), static_cast<short>(100 + p));
+        }
+        return info;
+    }
+
+    std::filesystem::path tempDir_;
+};
+
+}  // anonymous namespace
+
+TEST_F(VelocityAssemblyTest, AssemblePhaseScalesAndInterleavesComponents) {
+    auto info = writeSeries(1);
+    VelocityFieldAssembler assembler;
+
+    auto result = assembler.assemblePhase(info, 0);
+    ASSERT_TRUE(result.has_value()) << result.error().toString();
+
+    const auto& field = result->velocityField;
+    ASSERT_NE(field, nullptr);
+    EXPECT_EQ(field->GetNumberOfComponentsPerPixel(), 3u);
+    auto size = field->GetLargestPossibleRegion().GetSize();
+    EXPECT_EQ(size[0], static_cast<size_t>(kSize));
+    EXPECT_EQ(size[1], static_cast<size_t>(kSize));
+    EXPECT_EQ(size[2], static_cast<size_t>(kSlices));
+    EXPECT_DOUBLE_EQ(field->GetSpacing()[0], 0.5);
+    EXPECT_DOUBLE_EQ(field->GetSpacing()[2], kSliceSpacing);
+
+    // 16-bit signed storage: full scale is 32768
+    const float* buffer = field->GetBufferPointer();
+    const size_t pixelCount = static_cast<size_t>(kSize) * kSize * kSlices;
+    for (size_t i = 0; i < pixelCount; i += 37) {
+        EXPECT_NEAR(buffer[i * 3 + 0], 8192.0 / 32768.0 * 150.0, 1e-3);
+        EXPECT_NEAR(buffer[i * 3 + 1], -8192.0 / 32768.0 * 200.0, 1e-3);
+        EXPECT_NEAR(buffer[i * 3 + 2], 0.0, 1e-6);
+    }
+
+    ASSERT_NE(result->magnitudeImage, nullptr);
+    EXPECT_FLOAT_EQ(result->magnitudeImage->GetBufferPointer()[0], 100.0f);
+    EXPECT_EQ(result->magnitudeImage->GetLargestPossibleRegion().GetSize(), size);
+}
+
+TEST_F(VelocityAssemblyTest, AssembleAllPhasesMatchesPerPhaseAssembly) {
+    auto info = writeSeries(3);
+    VelocityFieldAssembler assembler;
+    double lastProgress = -1.0;
+    assembler.setProgressCallback([&](double p) { lastProgress = p; });
+
+    auto all = assembler.assembleAllPhases(info);
+    ASSERT_TRUE(all.has_value()) << all.error().toString();
+    ASSERT_EQ(all->size(), 3u);
+    EXPECT_DOUBLE_EQ(lastProgress, 1.0);
+
+    for (int p = 0; p < 3; ++p) {
+        const auto& phase = (*all)[p];
+        EXPECT_EQ(phase.phaseIndex, p);
+        EXPECT_DOUBLE_EQ(phase.triggerTime, 40.0 * p);
+
+        auto single = assembler.assemblePhase(info, p);
+        ASSERT_TRUE(single.has_value());
+        const size_t values = phase.velocityField->GetPixelContainer()->Size();
+        ASSERT_EQ(values, single->velocityField->GetPixelContainer()->Size());
+        const float* a = phase.velocityField->GetBufferPointer();
+        const float* b = single->velocityField->GetBufferPointer();
+        for (size_t i = 0; i < values; ++i) {
+            ASSERT_FLOAT_EQ(a[i], b[i]) << "phase " << p << " value " << i;
+        }
+        EXPECT_NEAR(a[0], (16384.0 * (p + 1) / 2) / 32768.0 * 150.0, 1e-3);
+        EXPECT_FLOAT_EQ(phase.magnitudeImage->GetBufferPointer()[0],
+                        static_cast<float>(100 + p));
+    }
+}
+
+TEST_F(VelocityAssemblyTest, AssembleAllPhasesSkipsUnreadablePhase) {
+    auto info = writeSeries(2);
+    info.frameMatrix[1][VelocityComponent::Vy].back() =
+        (tempDir_ / "missing.dcm").string();
+    VelocityFieldAssembler assembler;
+
+    auto all = assembler.assembleAllPhases(info);
+    ASSERT_TRUE(all.has_value());
+    ASSERT_EQ(all->size(), 1u);
+    EXPECT_EQ((*all)[0].phaseIndex, 0);
+
+    auto broken = assembler.assemblePhase(info, 1);
+    ASSERT_FALSE(broken.has_value());
+    EXPECT_EQ(broken.error().code, FlowError::Code::ParseFailed);
+}
+
+TEST_F(VelocityAssemblyTest, RescaledUnsignedPhaseMapsRangeOntoVENC) {
+    // 12-bit unsigned storage, slope 2, intercept -4096: rescaled range
+    // [-4096, 4096], so stored 0 / 2048 / 4095 map to -VENC / 0 / ~+VENC
+    SyntheticSliceSpec phaseSpec;
+    phaseSpec.bitsStored = 12;
+    phaseSpec.isSigned = false;
+    phaseSpec.rescaleSlope = 2.0;
+    phaseSpec.rescaleIntercept = -4096.0;
+
+    FlowSeriesInfo info;
+    info.phaseCount = 1;
+    info.temporalResolution = 40.0;
+    info.venc = {100.0, 100.0, 100.0};
+    info.isSignedPhase = false;
+    info.frameMatrix.resize(1);
+    auto& phase = info.frameMatrix[0];
+    phase[VelocityComponent::Vx] = writeStack("vx", 0, phaseSpec);
+    phase[VelocityComponent::Vy] = writeStack("vy", 2048, phaseSpec);
+    phase[VelocityComponent::Vz] = writeStack("vz", 4095, phaseSpec);
+    phase[VelocityComponent::Magnitude] = writeStack("mag", 100);
+
+    VelocityFieldAssembler assembler;
+    auto result = assembler.assemblePhase(info, 0);
+    ASSERT_TRUE(result.has_value()) << result.error().toString();
+
+    const float* buffer = result->velocityField->GetBufferPointer();
+    EXPECT_NEAR(buffer[0], -100.0, 1e-3);
+    EXPECT_NEAR(buffer[1], 0.0, 1e-3);
+    EXPECT_NEAR(buffer[2], 4094.0 / 4096.0 * 100.0, 1e-3);
+}
@@ -29,6 +29,7 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <cmath>
 #include <numbers>
 #include <vector>
@@ -718,6 +719,100 @@ TEST(VesselAnalyzerOSI, BidirectionalFlowHasHighOSI) {
     EXPECT_NE(result->wallMesh->GetPointData()->GetArray("OSI"), nullptr);
 }
 
+// =============================================================================
+// Multi-phase wall stencil reuse
+// =============================================================================
+
+namespace {
+
+/// Per-vertex mean of WSS_Magnitude over independent computeWSS() calls
+std::vector<double> averageWSSMagnitude(const VesselAnalyzer& analyzer,
+                                        const std::vector<VelocityPhase>& phases,
+                                        vtkSmartPointer<vtkPolyData> wallMesh) {
+    std::vector<double> mean(wallMesh->GetNumberOfPoints(), 0.0);
+    for (const auto& phase : phases) {
+        auto wss = analyzer.computeWSS(phase, wallMesh);
+        EXPECT_TRUE(wss.has_value());
+        auto* magnitude = wss->wallMesh->GetPointData()->GetArray("WSS_Magnitude");
+        for (size_t v = 0; v < mean.size(); ++v) {
+            mean[v] += magnitude->GetTuple1(static_cast<vtkIdType>(v)) / phases.size();
+        }
+    }
+    return mean;
+}
+
+}  // anonymous namespace
+
+TEST(VesselAnalyzerTAWSS, MatchesPerPhaseWSS) {
+    constexpr int kDim = 32;
+    constexpr double kRadius = 8.0;
+
+    std::vector<VelocityPhase> phases;
+    for (int p = 0; p < 4; ++p) {
+        auto [phase, truth] = phantom::generatePoiseuillePipe(kDim, 40.0 + 15.0 * p, kRadius, p);
+        phases.push_back(std::move(phase));
+    }
+
+    double center = (kDim - 1) / 2.0;
+    auto wallMesh = createCylindricalWallMesh(kRadius, 20.0, 16, 4, center, center, 5.0);
+
+    VesselAnalyzer analyzer;
+    auto result = analyzer.computeTAWSS(phases, wallMesh);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    auto expected = averageWSSMagnitude(analyzer, phases, wallMesh);
+    auto* tawss = result->wallMesh->GetPointData()->GetArray("TAWSS");
+    ASSERT_NE(tawss, nullptr);
+    for (size_t v = 0; v < expected.size(); ++v) {
+        EXPECT_NEAR(tawss->GetTuple1(static_cast<vtkIdType>(v)), expected[v], 1e-5);
+    }
+
+    // First phase's WSS arrays are carried on the output mesh
+    EXPECT_NE(result->wallMesh->GetPointData()->GetArray("WSS_Magnitude"), nullptr);
+    EXPECT_NE(result->wallMesh->GetPointData()->GetArray("WSS_Vector"), nullptr);
+}
+
+TEST(VesselAnalyzerTAWSS, PhasesOnDifferentGridsUseOwnSampling) {
+    constexpr int kDim = 32;
+    constexpr double kRadius = 8.0;
+
+    auto [first, truth1] = phantom::generatePoiseuillePipe(kDim, 60.0, kRadius, 0);
+    auto [second, truth2] = phantom::generatePoiseuillePipe(kDim, 60.0, kRadius, 1);
+    VectorImage3D::PointType shifted;
+    shifted[0] = 0.6;
+    shifted[1] = -0.6;
+    shifted[2] = 0.0;
+    second.velocityField->SetOrigin(shifted);
+    std::vector<VelocityPhase> phases{first, second};
+
+    double center = (kDim - 1) / 2.0;
+    auto wallMesh = createCylindricalWallMesh(kRadius, 20.0, 16, 4, center, center, 5.0);
+
+    VesselAnalyzer analyzer;
+    auto result = analyzer.computeTAWSS(phases, wallMesh);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    auto expected = averageWSSMagnitude(analyzer, phases, wallMesh);
+    auto* tawss = result->wallMesh->GetPointData()->GetArray("TAWSS");
+    for (size_t v = 0; v < expected.size(); ++v) {
+        EXPECT_NEAR(tawss->GetTuple1(static_cast<vtkIdType>(v)), expected[v], 1e-5);
+    }
+}
+
+TEST(VesselAnalyzerOSI, NullPhaseAfterFirstReturnsError) {
+    constexpr int kDim = 16;
+    auto [phase, truth] = phantom::generatePoiseuillePipe(kDim, 50.0, 5.0);
+    std::vector<VelocityPhase> phases{phase, VelocityPhase{}};
+
+    double center = (kDim - 1) / 2.0;
+    auto wallMesh = createCylindricalWallMesh(5.0, 8.0, 8, 2, center, center, 4.0);
+
+    VesselAnalyzer analyzer;
+    auto result = analyzer.computeOSI(phases, wallMesh);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, FlowError::Code::InvalidInput);
+}
+
 // =============================================================================
 // TKE density scaling test (Issue #202)
 // =============================================================================
@@ -1070,3 +1165,298 @@ TEST(VesselAnalyzerEnergyLoss, DissipationScalesWithViscosity) {
     EXPECT_NEAR(r2->totalEnergyLoss / r1->totalEnergyLoss, 2.0, 0.01)
         << "Doubling viscosity should double energy loss";
 }
+
+// =============================================================================
+// Fused velocity gradient tensor tests
+// =============================================================================
+
+namespace {
+
+/// Velocity field V = f(x, y, z) in cm/s sampled on a 1 mm grid
+template <typename Field>
+VelocityPhase createAnalyticPhase(int dim, Field field) {
+    auto velocity = phantom::createVectorImage(dim, dim, dim);
+    auto* buf = velocity->GetBufferPointer();
+    for (int z = 0; z < dim; ++z) {
+        for (int y = 0; y < dim; ++y) {
+            for (int x = 0; x < dim; ++x) {
+                const auto v = field(x, y, z);
+                const int idx = (z * dim + y) * dim + x;
+                buf[idx * 3]     = static_cast<float>(v[0]);
+                buf[idx * 3 + 1] = static_cast<float>(v[1]);
+                buf[idx * 3 + 2] = static_cast<float>(v[2]);
+            }
+        }
+    }
+    VelocityPhase phase;
+    phase.velocityField = velocity;
+    return phase;
+}
+
+/// Non-trivial field with shear, rotation and stretching in every component
+VelocityPhase createMixedFlowPhase(int dim) {
+    return createAnalyticPhase(dim, [](int x, int y, int z) {
+        return std::array<double, 3>{
+            0.5 * y * y - 0.3 * z + std::sin(0.2 * x),
+            0.7 * x - 0.1 * x * z,
+            0.2 * x * y + std::cos(0.3 * z)};
+    });
+}
+
+}  // anonymous namespace
+
+TEST(VesselAnalyzerGradient, NullFieldReturnsError) {
+    VesselAnalyzer analyzer;
+    VelocityPhase phase;
+    EXPECT_FALSE(analyzer.computeVelocityGradientMetrics(phase).has_value());
+}
+
+TEST(VesselAnalyzerGradient, NoOutputsRequestedReturnsError) {
+    VesselAnalyzer analyzer;
+    VelocityGradientOptions options;
+    options.computeVorticity = false;
+    options.computeHelicity = false;
+    options.computeDissipation = false;
+    options.computeQCriterion = false;
+    options.computeLambda2 = false;
+    auto result = analyzer.computeVelocityGradientMetrics(createMixedFlowPhase(8), options);
+    EXPECT_FALSE(result.has_value());
+}
+
+TEST(VesselAnalyzerGradient, SolidBodyRotationIsVortexCore) {
+    // V = (-w*y, w*x, 0) cm/s on 1 mm grid → dVy/dx = -dVx/dy = 10*w (1/s)
+    constexpr int kDim = 12;
+    constexpr double kOmega = 2.0;
+    const double center = (kDim - 1) / 2.0;
+    auto phase = createAnalyticPhase(kDim, [&](int x, int y, int) {
+        return std::array<double, 3>{-kOmega * (y - center), kOmega * (x - center), 0.0};
+    });
+
+    VesselAnalyzer analyzer;
+    auto result = analyzer.computeVelocityGradientMetrics(phase);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    const double rate = 10.0 * kOmega;
+    const int idx = (5 * kDim + 6) * kDim + 4;
+    EXPECT_NEAR(result->vortex.vorticityField->GetBufferPointer()[idx * 3 + 2],
+                2.0 * rate, 1e-3);
+    EXPECT_NEAR(result->qCriterion->GetBufferPointer()[idx], rate * rate, 1e-2);
+    EXPECT_NEAR(result->lambda2->GetBufferPointer()[idx], -rate * rate, 1e-2);
+    EXPECT_NEAR(result->energyLoss.dissipationField->GetBufferPointer()[idx], 0.0, 1e-6);
+}
+
+TEST(VesselAnalyzerGradient, PureShearIsNotVortex) {
+    // Vx = g*y: equal strain and rotation → Q = 0, lambda2 = 0
+    constexpr int kDim = 12;
+    auto phase = createAnalyticPhase(kDim, [](int, int y, int) {
+        return std::array<double, 3>{3.0 * y, 0.0, 0.0};
+    });
+
+    VesselAnalyzer analyzer;
+    auto result = analyzer.computeVelocityGradientMetrics(phase);
+    ASSERT_TRUE(result.has_value());
+
+    const int idx = (6 * kDim + 6) * kDim + 6;
+    EXPECT_NEAR(result->qCriterion->GetBufferPointer()[idx], 0.0, 1e-3);
+    EXPECT_NEAR(result->lambda2->GetBufferPointer()[idx], 0.0, 1e-3);
+    EXPECT_GT(result->energyLoss.dissipationField->GetBufferPointer()[idx], 0.0f);
+}
+
+TEST(VesselAnalyzerGradient, MatchesIndividualComputations) {
+    constexpr int kDim = 20;
+    auto phase = createMixedFlowPhase(kDim);
+
+    VesselAnalyzer analyzer;
+    auto fused = analyzer.computeVelocityGradientMetrics(phase);
+    auto vortex = analyzer.computeVorticity(phase);
+    auto energy = analyzer.computeEnergyLoss(phase);
+    ASSERT_TRUE(fused.has_value());
+    ASSERT_TRUE(vortex.has_value());
+    ASSERT_TRUE(energy.has_value());
+
+    const int voxels = kDim * kDim * kDim;
+    for (int i = 0; i < voxels; ++i) {
+        ASSERT_FLOAT_EQ(fused->vortex.vorticityMagnitude->GetBufferPointer()[i],
+                        vortex->vorticityMagnitude->GetBufferPointer()[i]);
+        ASSERT_FLOAT_EQ(fused->vortex.helicityDensity->GetBufferPointer()[i],
+                        vortex->helicityDensity->GetBufferPointer()[i]);
+        ASSERT_FLOAT_EQ(fused->energyLoss.dissipationField->GetBufferPointer()[i],
+                        energy->dissipationField->GetBufferPointer()[i]);
+    }
+    EXPECT_DOUBLE_EQ(fused->energyLoss.totalEnergyLoss, energy->totalEnergyLoss);
+    EXPECT_EQ(fused->energyLoss.voxelCount, (kDim - 2) * (kDim - 2) * (kDim - 2));
+}
+
+TEST(VesselAnalyzerGradient, OnlyRequestedOutputsAllocated) {
+    VesselAnalyzer analyzer;
+    VelocityGradientOptions options;
+    options.computeVorticity = false;
+    options.computeHelicity = false;
+    options.computeDissipation = false;
+    options.computeLambda2 = false;
+
+    auto result = analyzer.computeVelocityGradientMetrics(createMixedFlowPhase(8), options);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->qCriterion);
+    EXPECT_FALSE(result->lambda2);
+    EXPECT_FALSE(result->vortex.vorticityField);
+    EXPECT_FALSE(result->vortex.helicityDensity);
+    EXPECT_FALSE(result->energyLoss.dissipationField);
+}
+
+TEST(VesselAnalyzerGradient, ResultIndependentOfThreadCount) {
+    constexpr int kDim = 40;  // several row tiles per slice
+    auto phase = createMixedFlowPhase(kDim);
+
+    VesselAnalyzer analyzer;
+    VelocityGradientOptions serial;
+    serial.threadCount = 1;
+    VelocityGradientOptions parallel;
+    parallel.threadCount = 4;
+
+    auto a = analyzer.computeVelocityGradientMetrics(phase, serial);
+    auto b = analyzer.computeVelocityGradientMetrics(phase, parallel);
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+
+    EXPECT_EQ(a->energyLoss.totalEnergyLoss, b->energyLoss.totalEnergyLoss);
+    const int voxels = kDim * kDim * kDim;
+    for (int i = 0; i < voxels; ++i) {
+        ASSERT_EQ(a->lambda2->GetBufferPointer()[i], b->lambda2->GetBufferPointer()[i]);
+        ASSERT_EQ(a->qCriterion->GetBufferPointer()[i], b->qCriterion->GetBufferPointer()[i]);
+    }
+}
+
+TEST(VesselAnalyzerGradient, MaskRestrictsAllOutputs) {
+    constexpr int kDim = 12;
+    auto phase = createMixedFlowPhase(kDim);
+    auto mask = phantom::createScalarImage(kDim, kDim, kDim);
+    auto* maskBuf = mask->GetBufferPointer();
+    const int inside = (6 * kDim + 6) * kDim + 6;
+    const int outside = (6 * kDim + 6) * kDim + 3;
+    maskBuf[inside] = 1.0f;
+
+    VesselAnalyzer analyzer;
+    VelocityGradientOptions options;
+    options.mask = mask;
+    auto result = analyzer.computeVelocityGradientMetrics(phase, options);
+    ASSERT_TRUE(result.has_value());
+
+    EXPECT_EQ(result->energyLoss.voxelCount, 1);
+    EXPECT_NE(result->qCriterion->GetBufferPointer()[inside], 0.0f);
+    EXPECT_EQ(result->qCriterion->GetBufferPointer()[outside], 0.0f);
+    EXPECT_EQ(result->vortex.vorticityMagnitude->GetBufferPointer()[outside], 0.0f);
+}
+
+// =============================================================================
+// Streaming accumulators
+// =============================================================================
+
+namespace {
+
+/// Uniform phase with Vz = vz; built on demand so only one phase is resident
+VelocityPhase createUniformZPhase(int dim, float vz, int phaseIndex) {
+    auto velocity = phantom::createVectorImage(dim, dim, dim);
+    auto* buf = velocity->GetBufferPointer();
+    for (int i = 0; i < dim * dim * dim; ++i) {
+        buf[i * 3 + 2] = vz;
+    }
+    VelocityPhase phase;
+    phase.velocityField = velocity;
+    phase.phaseIndex = phaseIndex;
+    return phase;
+}
+
+}  // anonymous namespace
+
+TEST(TKEAccumulatorTest, StreamedPhasesMatchAnalyticVariance) {
+    constexpr int kDim = 8;
+    TKEAccumulator accumulator(1060.0);
+    for (int p = 0; p < 5; ++p) {
+        // Each phase is released after addPhase()
+        ASSERT_TRUE(accumulator.addPhase(createUniformZPhase(kDim, 30.0f + p * 20.0f, p)));
+    }
+    EXPECT_EQ(accumulator.phaseCount(), 5);
+
+    auto result = accumulator.result();
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+
+    // Vz = 30..110 step 20 → population variance 800 (cm/s)^2
+    const double expected = 0.5 * 1060.0 * 800.0 * 1e-4;
+    EXPECT_NEAR(result.value()->GetBufferPointer()[0], expected, expected * 1e-5);
+}
+
+TEST(TKEAccumulatorTest, StableForLargeMeanSmallVariance) {
+    // A naive sum-of-squares would lose the ±0.5 cm/s signal at 1000 cm/s
+    constexpr int kDim = 4;
+    TKEAccumulator accumulator;
+    for (int p = 0; p < 100; ++p) {
+        ASSERT_TRUE(accumulator.addPhase(
+            createUniformZPhase(kDim, 1000.0f + (p % 2 == 0 ? 0.5f : -0.5f), p)));
+    }
+    auto result = accumulator.result();
+    ASSERT_TRUE(result.has_value());
+
+    const double expected = 0.5 * 1060.0 * 0.25 * 1e-4;
+    EXPECT_NEAR(result.value()->GetBufferPointer()[0], expected, expected * 0.01);
+}
+
+TEST(TKEAccumulatorTest, RequiresThreePhasesAndMatchingGrid) {
+    TKEAccumulator accumulator;
+    ASSERT_TRUE(accumulator.addPhase(createUniformZPhase(8, 10.0f, 0)));
+    ASSERT_TRUE(accumulator.addPhase(createUniformZPhase(8, 20.0f, 1)));
+    EXPECT_FALSE(accumulator.result().has_value());
+
+    auto mismatched = accumulator.addPhase(createUniformZPhase(6, 30.0f, 2));
+    EXPECT_FALSE(mismatched.has_value());
+    EXPECT_EQ(accumulator.phaseCount(), 2);
+
+    EXPECT_FALSE(accumulator.addPhase(VelocityPhase{}).has_value());
+
+    accumulator.reset();
+    EXPECT_EQ(accumulator.phaseCount(), 0);
+    EXPECT_TRUE(accumulator.addPhase(createUniformZPhase(6, 30.0f, 0)).has_value());
+}
+
+TEST(WallShearAccumulatorTest, StreamedPhasesMatchBatchOSI) {
+    constexpr int kDim = 32;
+    constexpr double kRadius = 8.0;
+    double center = (kDim - 1) / 2.0;
+    auto wallMesh = createCylindricalWallMesh(kRadius, 20.0, 16, 4, center, center, 5.0);
+
+    auto makePhase = [&](int p) {
+        double vmax = (p % 2 == 0) ? 50.0 : -30.0;
+        return phantom::generatePoiseuillePipe(kDim, vmax, kRadius, p).first;
+    };
+
+    WallShearAccumulator accumulator(wallMesh);
+    std::vector<VelocityPhase> phases;
+    for (int p = 0; p < 4; ++p) {
+        ASSERT_TRUE(accumulator.addPhase(makePhase(p)));
+        phases.push_back(makePhase(p));
+    }
+    EXPECT_EQ(accumulator.phaseCount(), 4);
+
+    VesselAnalyzer analyzer;
+    auto batch = analyzer.computeOSI(phases, wallMesh);
+    auto streamed = accumulator.osi();
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_TRUE(streamed.has_value());
+    EXPECT_DOUBLE_EQ(streamed->meanOSI, batch->meanOSI);
+    EXPECT_DOUBLE_EQ(streamed->meanWSS, batch->meanWSS);
+
+    auto tawss = accumulator.tawss();
+    ASSERT_TRUE(tawss.has_value());
+    EXPECT_NEAR(tawss->meanWSS, batch->meanWSS, 1e-6);
+    EXPECT_NE(tawss->wallMesh->GetPointData()->GetArray("TAWSS"), nullptr);
+    EXPECT_EQ(tawss->wallMesh->GetPointData()->GetArray("OSI"), nullptr);
+}
+
+TEST(WallShearAccumulatorTest, EmptyAccumulatorReturnsErrors) {
+    WallShearAccumulator accumulator(nullptr);
+    EXPECT_FALSE(accumulator.tawss().has_value());
+    EXPECT_FALSE(accumulator.osi().has_value());
+
+    auto [phase, truth] = phantom::generatePoiseuillePipe(16, 50.0, 5.0);
+    EXPECT_FALSE(accumulator.addPhase(phase).has_value());  // null mesh
+}
@@ -0,0 +1,274 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "core/series_builder.hpp"
+#include "core/volume_cache.hpp"
+
+#include "../test_utils/dicom_file_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+namespace dicom_viewer::core::test {
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// Test fixture
+// ============================================================================
+class VolumeCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        tempDir_ = fs::temp_directory_path() / "volume_cache_test";
+        fs::remove_all(tempDir_);
+        fs::create_directories(tempDir_);
+        cacheDir_ = tempDir_ / "cache";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(tempDir_);
+    }
+
+    static CTImageType::Pointer makeVolume()
+    {
+        auto image = CTImageType::New();
+        CTImageType::SizeType size;
+        size[0] = 7;
+        size[1] = 5;
+        size[2] = 3;
+        CTImageType::IndexType start;
+        start.Fill(0);
+        image->SetRegions(CTImageType::RegionType(start, size));
+
+        CTImageType::SpacingType spacing;
+        spacing[0] = 0.7;
+        spacing[1] = 0.8;
+        spacing[2] = 2.5;
+        image->SetSpacing(spacing);
+
+        CTImageType::PointType origin;
+        origin[0] = -10.0;
+        origin[1] = 20.0;
+        origin[2] = 30.5;
+        image->SetOrigin(origin);
+
+        CTImageType::DirectionType direction;
+        direction.SetIdentity();
+        direction(1, 1) = -1.0;
+        direction(2, 2) = -1.0;
+        image->SetDirection(direction);
+
+        image->Allocate();
+        auto* buffer = image->GetBufferPointer();
+        const size_t count = image->GetLargestPossibleRegion().GetNumberOfPixels();
+        for (size_t i = 0; i < count; ++i) {
+            buffer[i] = static_cast<short>(static_cast<int>(i) * 13 - 1024);
+        }
+        return image;
+    }
+
+    fs::path tempDir_;
+    fs::path cacheDir_;
+};
+
+// ============================================================================
+// store / open
+// ============================================================================
+TEST_F(VolumeCacheTest, OpenMissingEntryReturnsNullopt)
+{
+    VolumeCache cache(cacheDir_);
+    EXPECT_FALSE(cache.openCT(42).has_value());
+    EXPECT_FALSE(cache.openMR(42).has_value());
+}
+
+TEST_F(VolumeCacheTest, StoreAndOpenPreservesGeometryAndVoxels)
+{
+    VolumeCache cache(cacheDir_);
+    auto original = makeVolume();
+    DicomMetadata metadata;
+    metadata.rescaleIntercept = -1024.0;
+
+    ASSERT_TRUE(cache.store(7, *original, metadata).has_value());
+    EXPECT_TRUE(fs::exists(cache.cachePath(7, "i16")));
+
+    auto mapped = cache.openCT(7);
+    ASSERT_TRUE(mapped.has_value());
+    const auto& image = *mapped;
+
+    EXPECT_EQ(image->GetLargestPossibleRegion(), original->GetLargestPossibleRegion());
+    EXPECT_EQ(image->GetBufferedRegion(), original->GetLargestPossibleRegion());
+    EXPECT_EQ(image->GetSpacing(), original->GetSpacing());
+    EXPECT_EQ(image->GetOrigin(), original->GetOrigin());
+    EXPECT_EQ(image->GetDirection(), original->GetDirection());
+
+    const size_t count = original->GetLargestPossibleRegion().GetNumberOfPixels();
+    EXPECT_TRUE(std::equal(original->GetBufferPointer(),
+                           original->GetBufferPointer() + count,
+                           image->GetBufferPointer()));
+}
+
+TEST_F(VolumeCacheTest, MappedDataIsPageAligned)
+{
+    VolumeCache cache(cacheDir_);
+    ASSERT_TRUE(cache.store(1, *makeVolume(), DicomMetadata{}).has_value());
+
+    auto mapped = cache.openCT(1);
+    ASSERT_TRUE(mapped.has_value());
+    auto address = reinterpret_cast<std::uintptr_t>((*mapped)->GetBufferPointer());
+    EXPECT_EQ(address % VolumeCache::kDataOffset, 0u);
+    EXPECT_EQ(fs::file_size(cache.cachePath(1, "i16")),
+              VolumeCache::kDataOffset + 7 * 5 * 3 * sizeof(short));
+}
+
+TEST_F(VolumeCacheTest, WritesToMappedImageDoNotReachFile)
+{
+    VolumeCache cache(cacheDir_);
+    auto original = makeVolume();
+    ASSERT_TRUE(cache.store(3, *original, DicomMetadata{}).has_value());
+
+    {
+        auto mapped = cache.openCT(3);
+        ASSERT_TRUE(mapped.has_value());
+        (*mapped)->FillBuffer(0);
+    }
+
+    auto reopened = cache.openCT(3);
+    ASSERT_TRUE(reopened.has_value());
+    EXPECT_EQ((*reopened)->GetBufferPointer()[1], original->GetBufferPointer()[1]);
+}
+
+TEST_F(VolumeCacheTest, PixelTypeAndKeyAreValidated)
+{
+    VolumeCache cache(cacheDir_);
+    ASSERT_TRUE(cache.store(5, *makeVolume(), DicomMetadata{}).has_value());
+
+    // CT entries are not visible as MR, and a renamed file is rejected
+    EXPECT_FALSE(cache.openMR(5).has_value());
+    fs::copy_file(cache.cachePath(5, "i16"), cache.cachePath(6, "i16"));
+    EXPECT_FALSE(cache.openCT(6).has_value());
+}
+
+TEST_F(VolumeCacheTest, TruncatedFileIsRejected)
+{
+    VolumeCache cache(cacheDir_);
+    ASSERT_TRUE(cache.store(9, *makeVolume(), DicomMetadata{}).has_value());
+
+    fs::resize_file(cache.cachePath(9, "i16"), VolumeCache::kDataOffset + 10);
+    EXPECT_FALSE(cache.openCT(9).has_value());
+
+    std::ofstream(cache.cachePath(10, "i16"), std::ios::binary) << "DVVC";
+    EXPECT_FALSE(cache.openCT(10).has_value());
+}
+
+// ============================================================================
+// fingerprint
+// ============================================================================
+TEST_F(VolumeCacheTest, FingerprintTracksSliceFiles)
+{
+    auto dir = tempDir_ / "series";
+    auto paths = test_utils::writeSyntheticCTSeries(dir, 3);
+    ASSERT_EQ(paths.size(), 3u);
+
+    std::vector<SliceInfo> slices(3);
+    for (size_t i = 0; i < 3; ++i) {
+        slices[i].filePath = paths[i];
+    }
+
+    auto first = VolumeCache::fingerprint(slices);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(VolumeCache::fingerprint(slices), first);
+
+    // Touching a slice changes the key
+    fs::last_write_time(paths[1], fs::last_write_time(paths[1]) + std::chrono::seconds(5));
+    auto touched = VolumeCache::fingerprint(slices);
+    ASSERT_TRUE(touched.has_value());
+    EXPECT_NE(*touched, *first);
+
+    // Dropping a slice changes the key; a missing file yields no key
+    auto fewer = slices;
+    fewer.pop_back();
+    EXPECT_NE(VolumeCache::fingerprint(fewer), touched);
+    fs::remove(paths[2]);
+    EXPECT_FALSE(VolumeCache::fingerprint(slices).has_value());
+}
+
+// ============================================================================
+// SeriesBuilder integration
+// ============================================================================
+TEST_F(VolumeCacheTest, SeriesBuilderServesReopenFromCache)
+{
+    auto dir = tempDir_ / "series";
+    test_utils::writeSyntheticCTSeries(dir, 4);
+
+    SeriesBuilder builder;
+    builder.setVolumeCacheDirectory(cacheDir_);
+    auto scan = builder.scanForSeries(dir);
+    ASSERT_TRUE(scan.has_value());
+    ASSERT_EQ(scan->size(), 1u);
+    const auto& series = scan->front();
+
+    auto decoded = builder.buildCTVolume(series);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().message;
+
+    auto key = VolumeCache::fingerprint(series.slices);
+    ASSERT_TRUE(key.has_value());
+    ASSERT_TRUE(fs::exists(VolumeCache(cacheDir_).cachePath(*key, "i16")));
+
+    auto reopened = builder.buildCTVolume(series);
+    ASSERT_TRUE(reopened.has_value()) << reopened.error().message;
+    EXPECT_NE(reopened.value().GetPointer(), decoded.value().GetPointer());
+    EXPECT_EQ(reopened.value()->GetLargestPossibleRegion(),
+              decoded.value()->GetLargestPossibleRegion());
+    const size_t count = decoded.value()->GetLargestPossibleRegion().GetNumberOfPixels();
+    EXPECT_TRUE(std::equal(decoded.value()->GetBufferPointer(),
+                           decoded.value()->GetBufferPointer() + count,
+                           reopened.value()->GetBufferPointer()));
+    EXPECT_EQ(builder.getMetadata().patientId, "SYN001");
+}
+
+TEST_F(VolumeCacheTest, SeriesBuilderWritesNoCacheByDefault)
+{
+    auto dir = tempDir_ / "series";
+    test_utils::writeSyntheticCTSeries(dir, 2);
+
+    SeriesBuilder builder;
+    auto scan = builder.scanForSeries(dir);
+    ASSERT_TRUE(scan.has_value());
+    ASSERT_TRUE(builder.buildCTVolume(scan->front()).has_value());
+    EXPECT_FALSE(fs::exists(cacheDir_));
+}
+
+} // namespace dicom_viewer::core::test